@@ -140,6 +140,9 @@ int deeper_cache_prefetch(const char* path, int deeper_prefetch_flags);
  *           create symbolic links when a symbolic link was found;
  * @param outChecksum The checksum of the file.
  * @return 0 on success, -1 and errno set in case of error.
+ *
+ * Note: This is always a synchronous operation, because the checksum is returned to the caller;
+ * large files are still copied in parallel chunks.
  */
 int deeper_cache_prefetch_crc(const char* path, int deeper_prefetch_flags,
    unsigned long* outChecksum);
@@ -165,7 +168,7 @@ int deeper_cache_prefetch_range(const char* path, off_t start_pos, size_t num_by
  * @param deeper_prefetch_flags zero or a combination of the following flags:
  *        DEEPER_PREFETCH_SUBDIRS to recursively wait contents of all subdirs, if given path leads
  *           to a directory.
- * @return 0 on success, -1 and errno set in case of error.
+ * @return 0 on success, -1 and errno set in case of error (e.g. errno of a failed prefetch).
  */
 int deeper_cache_prefetch_wait(const char* path, int deeper_prefetch_flags);
 
@@ -200,6 +203,9 @@ int deeper_cache_flush(const char* path, int deeper_flush_flags);
  *           symbolic links when a symbolic link was found;
  * @param outChecksum The checksum of the file.
  * @return 0 on success, -1 and errno set in case of error.
+ *
+ * Note: This is always a synchronous operation, because the checksum is returned to the caller;
+ * large files are still copied in parallel chunks.
  */
 int deeper_cache_flush_crc(const char* path, int deeper_flush_flags, unsigned long* outChecksum);
 
@@ -224,7 +230,7 @@ int deeper_cache_flush_range(const char* path, off_t start_pos, size_t num_bytes
  * @param deeper_flush_flags zero or a combination of the following flags:
  *        DEEPER_FLUSH_SUBDIRS to recursively wait contents of all subdirs, if given path leads
  *           to a directory.
- * @return 0 on success, -1 and errno set in case of error.
+ * @return 0 on success, -1 and errno set in case of error (e.g. errno of a failed flush).
  */
 int deeper_cache_flush_wait(const char* path, int deeper_flush_flags);
 
@@ -39,6 +39,9 @@ void Config::loadDefaults(bool addDashes)
    configMapRedefine("sysCacheID",                    "");
 
    configMapRedefine("connDeeperCachedNamedSocket",   "/var/run/beegfs-deeper-cached.sock");
+
+   configMapRedefine("tuneNumCopyWorkers",            "4");
+   configMapRedefine("tuneCopyChunkSize",             "64m");
 }
 
 /**
@@ -64,6 +67,12 @@ void Config::applyConfigMap(bool enableException, bool addDashes) throw(InvalidC
       if(iter->first == std::string("connDeeperCachedNamedSocket") )
          connDeeperCachedNamedSocket = iter->second;
       else
+      if(iter->first == std::string("tuneNumCopyWorkers") )
+         tuneNumCopyWorkers = StringTk::strToUInt(iter->second);
+      else
+      if(iter->first == std::string("tuneCopyChunkSize") )
+         tuneCopyChunkSize = UnitTk::strHumanToInt64(iter->second);
+      else
       { // unknown element occurred
          unknownElement = true;
          
@@ -105,4 +114,7 @@ void Config::initImplicitVals() throw(InvalidConfigException)
    cfgFile = createDefaultCfgFilename();
    CachePathTk::preparePaths(this->sysMountPointCache);
    CachePathTk::preparePaths(this->sysMountPointGlobal);
+
+   if(tuneCopyChunkSize < (1024*1024) )
+      tuneCopyChunkSize = 1024*1024; // chunks smaller than 1MiB make no sense
 }
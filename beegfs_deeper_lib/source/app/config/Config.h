@@ -21,6 +21,9 @@ class Config : public AbstractConfig
 
       std::string connDeeperCachedNamedSocket; // the path to the named socket of the DEEP-ER cached
 
+      unsigned tuneNumCopyWorkers;             // threads for async prefetch/flush (0 => sync)
+      int64_t tuneCopyChunkSize;               // size of parallel copy chunks of large files
+
 
       // internals
 
@@ -54,6 +57,16 @@ class Config : public AbstractConfig
       {
          return connDeeperCachedNamedSocket;
       }
+
+      unsigned getTuneNumCopyWorkers() const
+      {
+         return tuneNumCopyWorkers;
+      }
+
+      int64_t getTuneCopyChunkSize() const
+      {
+         return tuneCopyChunkSize;
+      }
 };
 
 #endif /*CONFIG_H_*/
@@ -0,0 +1,533 @@
+#include <common/threading/SafeMutexLock.h>
+#include <common/toolkit/StringTk.h>
+#include <deeper/deeper_cache.h>
+#include <filesystem/DeeperCache.h>
+#include <toolkit/FileCopyTk.h>
+#include "CopyWorkerPool.h"
+
+#include <signal.h>
+#include <zlib.h>
+
+
+/**
+ * Starts the worker threads.
+ *
+ * Note: Doesn't throw, because this lib is used from C code. If worker threads can't be created,
+ * the pool runs with less workers; check getNumWorkers().
+ *
+ * @param chunkSize files (or ranges) larger than this are copied in chunks of this size.
+ * @param bufSize size of the copy buffer of each worker.
+ */
+CopyWorkerPool::CopyWorkerPool(DeeperCache* cache, unsigned numWorkers, size_t chunkSize,
+   size_t bufSize, Logger* logger) :
+   cache(cache), logger(logger), chunkSize(chunkSize), bufSize(bufSize), shallTerminate(false)
+{
+   /* block all signals in the workers (inherited from the creating thread), so that signals of the
+      user application are not delivered to our threads */
+   sigset_t allSignals;
+   sigset_t oldSignalMask;
+
+   sigfillset(&allSignals);
+   pthread_sigmask(SIG_SETMASK, &allSignals, &oldSignalMask);
+
+   for(unsigned i=0; i < numWorkers; i++)
+   {
+      pthread_t threadID;
+
+      int createRes = pthread_create(&threadID, NULL, workerLoopStatic, this);
+      if(createRes)
+      {
+         logger->logErr(__FUNCTION__, "Unable to start copy worker thread. "
+            "Number of started workers: " + StringTk::uintToStr(i) + "; "
+            "Error: " + System::getErrString(createRes) );
+         break;
+      }
+
+      workerThreads.push_back(threadID);
+   }
+
+   pthread_sigmask(SIG_SETMASK, &oldSignalMask, NULL);
+}
+
+/**
+ * Processes all queued jobs and stops the worker threads afterwards, so that async flushes are
+ * not lost when the application exits.
+ */
+CopyWorkerPool::~CopyWorkerPool()
+{
+   SafeMutexLock lock(&mutex); // L O C K
+
+   shallTerminate = true;
+   newWorkCond.broadcast();
+
+   lock.unlock(); // U N L O C K
+
+   for(size_t i=0; i < workerThreads.size(); i++)
+      pthread_join(workerThreads[i], NULL);
+
+   // failed jobs, which were never waited for
+   for(CopyJobMapIter iter = jobMap.begin(); iter != jobMap.end(); iter++)
+      delete(iter->second);
+}
+
+/**
+ * Add a job to the queue. An identical job for the same path, which was not started yet, is
+ * reused instead.
+ *
+ * @param job will be owned by the pool.
+ */
+void CopyWorkerPool::addJob(CopyJob* job)
+{
+   // (so that waitForJobs() finds the job no matter how the user spelled the path)
+   job->path = normalizePath(job->path);
+
+   SafeMutexLock lock(&mutex); // L O C K
+
+   std::pair<CopyJobMapIter, CopyJobMapIter> range = jobMap.equal_range(job->path);
+
+   for(CopyJobMapIter iter = range.first; iter != range.second; )
+   {
+      CopyJob* existingJob = iter->second;
+
+      if(!existingJob->isRunning && !existingJob->isFinished &&
+         (existingJob->type == job->type) && (existingJob->flags == job->flags) &&
+         (existingJob->startPos == job->startPos) && (existingJob->numBytes == job->numBytes) )
+      { // same job is already queued
+         lock.unlock(); // U N L O C K
+
+         delete(job);
+         return;
+      }
+
+      if(existingJob->isFinished &&
+         (COPYJOBTYPE_IS_FLUSH(existingJob->type) == COPYJOBTYPE_IS_FLUSH(job->type) ) )
+      { // result of a failed job is superseded by the new job
+         delete(existingJob);
+         jobMap.erase(iter++);
+         continue;
+      }
+
+      iter++;
+   }
+
+   jobMap.insert(CopyJobMapVal(job->path, job) );
+   jobQueue.push_back(job);
+
+   newWorkCond.signal();
+
+   lock.unlock(); // U N L O C K
+}
+
+/**
+ * Wait until all queued and running jobs of the given kind for the given path are finished.
+ *
+ * Jobs with the subdirs flag for a parent dir of the given path also cover the path, so they are
+ * waited for as well. Their errors are reported, but they are only forgotten when the result is
+ * collected for their own path.
+ *
+ * @param isFlush true to wait for flush jobs, false to wait for prefetch jobs.
+ * @param includeSubdirs true to also wait for jobs of all paths below the given path.
+ * @return 0 on success, -1 and errno set if one of the jobs failed.
+ */
+int CopyWorkerPool::waitForJobs(std::string path, bool isFlush, bool includeSubdirs)
+{
+   int errorCode = 0;
+   std::vector<CopyJobMapIter> subtreeJobs;
+   CopyJobList enclosingJobs;
+
+   path = normalizePath(path);
+
+   SafeMutexLock lock(&mutex); // L O C K
+
+   for( ; ; )
+   {
+      bool allFinished = true;
+
+      subtreeJobs.clear();
+      enclosingJobs.clear();
+
+      findJobsUnlocked(path, isFlush, includeSubdirs, subtreeJobs, enclosingJobs);
+
+      for(std::vector<CopyJobMapIter>::iterator iter = subtreeJobs.begin();
+          allFinished && (iter != subtreeJobs.end() );
+          iter++)
+         allFinished = (*iter)->second->isFinished;
+
+      for(CopyJobListIter iter = enclosingJobs.begin();
+          allFinished && (iter != enclosingJobs.end() );
+          iter++)
+         allFinished = (*iter)->isFinished;
+
+      if(allFinished)
+         break;
+
+      jobFinishedCond.wait(&mutex);
+   }
+
+   // collect the results of failed jobs (succeeded jobs are not in the map anymore)
+
+   for(CopyJobListIter iter = enclosingJobs.begin(); iter != enclosingJobs.end(); iter++)
+   {
+      if(!errorCode)
+         errorCode = (*iter)->errorCode;
+   }
+
+   for(std::vector<CopyJobMapIter>::iterator iter = subtreeJobs.begin();
+       iter != subtreeJobs.end();
+       iter++)
+   {
+      CopyJob* job = (*iter)->second;
+
+      if(!errorCode)
+         errorCode = job->errorCode;
+
+      delete(job);
+      jobMap.erase(*iter);
+   }
+
+   lock.unlock(); // U N L O C K
+
+   if(errorCode)
+   {
+      errno = errorCode;
+      return DEEPER_RETVAL_ERROR;
+   }
+
+   return DEEPER_RETVAL_SUCCESS;
+}
+
+/**
+ * Find the jobs of the given kind that cover the given path.
+ *
+ * Note: Caller must hold the mutex.
+ *
+ * @param path must be normalized.
+ * @param outSubtreeJobs jobs for the path itself (and for paths below it if includeSubdirs).
+ * @param outEnclosingJobs jobs for parent dirs of the path, which include all subdirs.
+ */
+void CopyWorkerPool::findJobsUnlocked(const std::string& path, bool isFlush, bool includeSubdirs,
+   std::vector<CopyJobMapIter>& outSubtreeJobs, CopyJobList& outEnclosingJobs)
+{
+   const CopyJobType dirJobType = isFlush ? CopyJobType_FLUSH : CopyJobType_PREFETCH;
+   const int subdirsFlag = isFlush ? DEEPER_FLUSH_SUBDIRS : DEEPER_PREFETCH_SUBDIRS;
+
+   for(CopyJobMapIter iter = jobMap.lower_bound(path);
+       (iter != jobMap.end() ) && !iter->first.compare(0, path.length(), path);
+       iter++)
+   {
+      if(jobMatchesPath(iter->first, path, includeSubdirs) &&
+         (COPYJOBTYPE_IS_FLUSH(iter->second->type) == isFlush) )
+         outSubtreeJobs.push_back(iter);
+   }
+
+   // parent dirs, from the direct parent up to the root dir
+
+   for(size_t slashPos = path.rfind('/');
+       (slashPos != std::string::npos) && (path.length() > 1);
+       slashPos = slashPos ? path.rfind('/', slashPos - 1) : std::string::npos)
+   {
+      const std::string parentPath = slashPos ? path.substr(0, slashPos) : std::string("/");
+
+      std::pair<CopyJobMapIter, CopyJobMapIter> range = jobMap.equal_range(parentPath);
+
+      for(CopyJobMapIter iter = range.first; iter != range.second; iter++)
+      {
+         CopyJob* job = iter->second;
+
+         if( (job->type == dirJobType) && (job->flags & subdirsFlag) )
+            outEnclosingJobs.push_back(job);
+      }
+   }
+}
+
+/**
+ * Copy a range of a file. Ranges larger than the chunk size are split into chunks, which are
+ * copied in parallel by the workers and by the calling thread.
+ *
+ * @param buf copy buffer of the calling thread.
+ * @param outCRC CRC checksum of the copied data (only set if doCRC is true).
+ * @return 0 on success, -1 and errno set in case of error.
+ */
+int CopyWorkerPool::copyDataParallel(int sourceFD, int destFD, off_t offset, size_t numBytes,
+   char* buf, size_t bufLen, bool doCRC, unsigned long* outCRC)
+{
+   if( (numBytes <= chunkSize) || workerThreads.empty() )
+      return FileCopyTk::copyData(sourceFD, destFD, offset, numBytes, buf, bufLen, doCRC,
+         outCRC, NULL);
+
+   CopyChunkGroup group;
+
+   group.sourceFD = sourceFD;
+   group.destFD = destFD;
+   group.offset = offset;
+   group.numBytes = numBytes;
+   group.doCRC = doCRC;
+   group.numChunks = (numBytes + chunkSize - 1) / chunkSize;
+   group.numFinished = 0;
+   group.errorCode = 0;
+   group.chunkCRCs.resize(group.numChunks, 0);
+   group.chunkNumCopied.resize(group.numChunks, 0);
+
+   SafeMutexLock lock(&mutex); // L O C K
+
+   for(size_t i=1; i < group.numChunks; i++)
+      chunkQueue.push_back(CopyChunk(&group, i) );
+
+   newWorkCond.broadcast();
+
+   lock.unlock(); // U N L O C K
+
+   // the first chunk is always ours; afterwards we help with queued chunks until ours are done
+
+   CopyChunk firstChunk(&group, 0);
+   processChunk(firstChunk, buf, bufLen);
+
+   lock.relock(); // L O C K
+
+   while(group.numFinished < group.numChunks)
+   {
+      if(!chunkQueue.empty() )
+      {
+         CopyChunk chunk = chunkQueue.front();
+         chunkQueue.pop_front();
+
+         lock.unlock(); // U N L O C K
+
+         processChunk(chunk, buf, bufLen);
+
+         lock.relock(); // L O C K
+
+         continue;
+      }
+
+      chunkFinishedCond.wait(&mutex);
+   }
+
+   lock.unlock(); // U N L O C K
+
+   if(group.errorCode)
+   {
+      errno = group.errorCode;
+      return DEEPER_RETVAL_ERROR;
+   }
+
+   if(doCRC)
+   {
+      *outCRC = group.chunkCRCs[0];
+
+      for(size_t i=1; i < group.numChunks; i++)
+         *outCRC = crc32_combine(*outCRC, group.chunkCRCs[i], group.chunkNumCopied[i]);
+   }
+
+   return DEEPER_RETVAL_SUCCESS;
+}
+
+void* CopyWorkerPool::workerLoopStatic(void* pool)
+{
+   ( (CopyWorkerPool*)pool)->workerLoop();
+
+   return NULL;
+}
+
+void CopyWorkerPool::workerLoop()
+{
+   char* buf = (char*)malloc(bufSize);
+   if(!buf)
+   {
+      logger->logErr(__FUNCTION__, "Could not allocate memory for copy worker buffer. "
+         "Errno: " + System::getErrString(errno) );
+      return;
+   }
+
+   SafeMutexLock lock(&mutex); // L O C K
+
+   for( ; ; )
+   {
+      if(!chunkQueue.empty() )
+      {
+         CopyChunk chunk = chunkQueue.front();
+         chunkQueue.pop_front();
+
+         lock.unlock(); // U N L O C K
+
+         processChunk(chunk, buf, bufSize);
+
+         lock.relock(); // L O C K
+
+         continue;
+      }
+
+      CopyJob* job = takeNextRunnableJobUnlocked();
+      if(job)
+      {
+         lock.unlock(); // U N L O C K
+
+         int jobRes = cache->runCopyJob(job);
+         int jobErrno = errno;
+
+         lock.relock(); // L O C K
+
+         job->isRunning = false;
+         job->isFinished = true;
+
+         if(jobRes == DEEPER_RETVAL_SUCCESS)
+         { // nobody needs to know about this job anymore
+            for(CopyJobMapIter iter = jobMap.find(job->path); iter != jobMap.end(); iter++)
+            {
+               if(iter->second == job)
+               {
+                  jobMap.erase(iter);
+                  break;
+               }
+            }
+
+            delete(job);
+         }
+         else
+            job->errorCode = jobErrno ? jobErrno : EIO;
+
+         jobFinishedCond.broadcast();
+
+         // queued jobs for the same path might be runnable now
+         if(!jobQueue.empty() || shallTerminate)
+            newWorkCond.broadcast();
+
+         continue;
+      }
+
+      if(shallTerminate && jobQueue.empty() )
+         break;
+
+      newWorkCond.wait(&mutex);
+   }
+
+   lock.unlock(); // U N L O C K
+
+   SAFE_FREE(buf);
+}
+
+/**
+ * Removes the first queued job from the queue, for which no other job with the same path is
+ * running, and marks it as running.
+ *
+ * Note: Caller must hold the mutex.
+ *
+ * @return NULL if there is no runnable job.
+ */
+CopyJob* CopyWorkerPool::takeNextRunnableJobUnlocked()
+{
+   for(CopyJobListIter queueIter = jobQueue.begin(); queueIter != jobQueue.end(); queueIter++)
+   {
+      CopyJob* job = *queueIter;
+      bool pathIsBusy = false;
+
+      std::pair<CopyJobMapIter, CopyJobMapIter> range = jobMap.equal_range(job->path);
+
+      for(CopyJobMapIter mapIter = range.first; mapIter != range.second; mapIter++)
+      {
+         if(mapIter->second->isRunning)
+         {
+            pathIsBusy = true;
+            break;
+         }
+      }
+
+      if(pathIsBusy)
+         continue;
+
+      jobQueue.erase(queueIter);
+      job->isRunning = true;
+
+      return job;
+   }
+
+   return NULL;
+}
+
+/**
+ * Copy a single chunk and account the result in the chunk group.
+ */
+void CopyWorkerPool::processChunk(CopyChunk& chunk, char* buf, size_t bufLen)
+{
+   CopyChunkGroup* group = chunk.group;
+
+   off_t chunkOffset = chunk.chunkIndex * chunkSize;
+   size_t chunkLen = std::min(chunkSize, group->numBytes - chunkOffset);
+
+   unsigned long chunkCRC = 0;
+   size_t numCopied = 0;
+
+   int copyRes = FileCopyTk::copyData(group->sourceFD, group->destFD,
+      group->offset + chunkOffset, chunkLen, buf, bufLen, group->doCRC, &chunkCRC, &numCopied);
+   int copyErrno = errno;
+
+   SafeMutexLock lock(&mutex); // L O C K
+
+   if( (copyRes == DEEPER_RETVAL_ERROR) && !group->errorCode)
+      group->errorCode = copyErrno ? copyErrno : EIO;
+
+   group->chunkCRCs[chunk.chunkIndex] = chunkCRC;
+   group->chunkNumCopied[chunk.chunkIndex] = numCopied;
+   group->numFinished++;
+
+   chunkFinishedCond.broadcast(); // (group might be gone after unlock)
+
+   lock.unlock(); // U N L O C K
+}
+
+/**
+ * @param includeSubdirs true if paths below the given path also match.
+ */
+bool CopyWorkerPool::jobMatchesPath(const std::string& jobPath, const std::string& path,
+   bool includeSubdirs)
+{
+   if(jobPath.length() == path.length() )
+      return jobPath == path;
+
+   if(!includeSubdirs || jobPath.compare(0, path.length(), path) )
+      return false;
+
+   // path is a parent dir of jobPath (and not just a prefix of the name)
+   return (path[path.length() - 1] == '/') || (jobPath[path.length()] == '/');
+}
+
+/**
+ * Normalize a path for the comparison of job paths: duplicate slashes, "." elements and trailing
+ * slashes are removed.
+ *
+ * Note: ".." elements are kept, because they can't be resolved without looking at symlinks.
+ */
+std::string CopyWorkerPool::normalizePath(const std::string& path)
+{
+   std::string normalizedPath;
+   size_t elemStart = 0;
+
+   normalizedPath.reserve(path.length() );
+
+   if(!path.empty() && (path[0] == '/') )
+      normalizedPath = "/";
+
+   while(elemStart < path.length() )
+   {
+      size_t elemEnd = path.find('/', elemStart);
+      if(elemEnd == std::string::npos)
+         elemEnd = path.length();
+
+      const size_t elemLen = elemEnd - elemStart;
+
+      if(elemLen && !( (elemLen == 1) && (path[elemStart] == '.') ) )
+      {
+         if(!normalizedPath.empty() && (normalizedPath[normalizedPath.length() - 1] != '/') )
+            normalizedPath += '/';
+
+         normalizedPath.append(path, elemStart, elemLen);
+      }
+
+      elemStart = elemEnd + 1;
+   }
+
+   if(normalizedPath.empty() )
+      normalizedPath = path.empty() ? path : std::string(".");
+
+   return normalizedPath;
+}
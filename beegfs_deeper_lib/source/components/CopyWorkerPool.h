@@ -0,0 +1,158 @@
+#ifndef COMPONENTS_COPYWORKERPOOL_H_
+#define COMPONENTS_COPYWORKERPOOL_H_
+
+
+#include <common/app/log/Logger.h>
+#include <common/threading/Condition.h>
+#include <common/threading/Mutex.h>
+#include <common/Common.h>
+
+
+class DeeperCache; // forward declaration
+
+
+enum CopyJobType
+{
+   CopyJobType_PREFETCH = 0,
+   CopyJobType_PREFETCH_RANGE = 1,
+   CopyJobType_FLUSH = 2,
+   CopyJobType_FLUSH_RANGE = 3
+};
+
+#define COPYJOBTYPE_IS_FLUSH(type) \
+   ( ( (type) == CopyJobType_FLUSH) || ( (type) == CopyJobType_FLUSH_RANGE) )
+
+
+/**
+ * An asynchronous prefetch or flush request of the user.
+ */
+struct CopyJob
+{
+   CopyJob(CopyJobType type, std::string path, int flags, off_t startPos, size_t numBytes) :
+      type(type), path(path), flags(flags), startPos(startPos), numBytes(numBytes),
+      isRunning(false), isFinished(false), errorCode(0) {}
+
+   CopyJobType type;
+   std::string path;    // path on the global FS, as given by the user (normalized by the pool)
+   int flags;           // deeper_prefetch_flags or deeper_flush_flags
+   off_t startPos;      // only for range jobs
+   size_t numBytes;     // only for range jobs
+
+   bool isRunning;
+   bool isFinished;
+   int errorCode;       // errno of a failed job
+};
+
+typedef std::list<CopyJob*> CopyJobList;
+typedef CopyJobList::iterator CopyJobListIter;
+
+typedef std::multimap<std::string, CopyJob*> CopyJobMap; // key: path
+typedef CopyJobMap::iterator CopyJobMapIter;
+typedef CopyJobMap::value_type CopyJobMapVal;
+
+
+/**
+ * A range of a file that is copied in chunks by multiple threads.
+ */
+struct CopyChunkGroup
+{
+   int sourceFD;
+   int destFD;
+   off_t offset;
+   size_t numBytes;
+   bool doCRC;
+
+   size_t numChunks;
+   size_t numFinished;     // protected by the pool mutex
+   int errorCode;          // errno of the first failed chunk, protected by the pool mutex
+
+   std::vector<unsigned long> chunkCRCs;
+   std::vector<size_t> chunkNumCopied;
+};
+
+/**
+ * A single chunk of a CopyChunkGroup.
+ */
+struct CopyChunk
+{
+   CopyChunk(CopyChunkGroup* group, size_t chunkIndex) : group(group), chunkIndex(chunkIndex) {}
+
+   CopyChunkGroup* group;
+   size_t chunkIndex;
+};
+
+typedef std::list<CopyChunk> CopyChunkList;
+
+
+/**
+ * Worker threads for asynchronous prefetch and flush jobs and for parallel copies of large files.
+ *
+ * Jobs are keyed by their path. A job is not started while another job for the same path is
+ * running, so that e.g. a flush and a following prefetch of the same file don't overlap. Jobs that
+ * succeeded are forgotten immediately, failed jobs are kept until their result was collected by
+ * waitForJobs() or until a new job of the same kind for the same path is added.
+ *
+ * Large files are split into chunks, which are copied in parallel by the workers and by the thread
+ * that requested the copy. Chunks have priority over jobs, so that running jobs finish first. CRC
+ * checksums are calculated per chunk by the thread that copies the chunk and combined afterwards.
+ *
+ * Note: The worker threads don't use the PThread class of beegfs_common, because this lib runs in
+ * the user application and must neither register signal handlers nor rely on an App object.
+ */
+class CopyWorkerPool
+{
+   public:
+      CopyWorkerPool(DeeperCache* cache, unsigned numWorkers, size_t chunkSize, size_t bufSize,
+         Logger* logger);
+      ~CopyWorkerPool();
+
+      void addJob(CopyJob* job);
+      int waitForJobs(std::string path, bool isFlush, bool includeSubdirs);
+
+      int copyDataParallel(int sourceFD, int destFD, off_t offset, size_t numBytes, char* buf,
+         size_t bufLen, bool doCRC, unsigned long* outCRC);
+
+
+   private:
+      DeeperCache* cache;
+      Logger* logger;
+
+      size_t chunkSize;
+      size_t bufSize; // size of the copy buffer of each worker
+
+      std::vector<pthread_t> workerThreads;
+
+      Mutex mutex; // protects all of the following members and the chunk groups
+      Condition newWorkCond; // signaled when jobs or chunks were added or on termination
+      Condition jobFinishedCond;
+      Condition chunkFinishedCond;
+
+      CopyJobList jobQueue; // jobs that are not started yet
+      CopyJobMap jobMap; // all queued, running and failed jobs
+      CopyChunkList chunkQueue; // chunks that are not started yet
+      bool shallTerminate;
+
+      static void* workerLoopStatic(void* pool);
+      void workerLoop();
+
+      CopyJob* takeNextRunnableJobUnlocked();
+      void processChunk(CopyChunk& chunk, char* buf, size_t bufLen);
+
+      void findJobsUnlocked(const std::string& path, bool isFlush, bool includeSubdirs,
+         std::vector<CopyJobMapIter>& outSubtreeJobs, CopyJobList& outEnclosingJobs);
+
+      static bool jobMatchesPath(const std::string& jobPath, const std::string& path,
+         bool includeSubdirs);
+      static std::string normalizePath(const std::string& path);
+
+
+   public:
+      // getters & setters
+
+      size_t getNumWorkers() const
+      {
+         return workerThreads.size();
+      }
+};
+
+#endif /* COMPONENTS_COPYWORKERPOOL_H_ */
@@ -2,6 +2,7 @@
 #include <common/toolkit/StringTk.h>
 #include <deeper/deeper_cache.h>
 #include <toolkit/CachePathTk.h>
+#include <toolkit/FileCopyTk.h>
 #include "DeeperCache.h"
 
 
@@ -61,6 +62,17 @@ DeeperCache::DeeperCache()
       this->cfg->getSysCacheID() ) + " - cache FS path: " + this->cfg->getSysMountPointCache() +
       " - global FS Path: " + this->cfg->getSysMountPointGlobal() );
 
+   this->copyWorkers = NULL;
+
+   if(this->cfg->getTuneNumCopyWorkers() )
+   {
+      this->copyWorkers = new CopyWorkerPool(this, this->cfg->getTuneNumCopyWorkers(),
+         this->cfg->getTuneCopyChunkSize(), BUFFER_SIZE, this->logger);
+
+      if(!this->copyWorkers->getNumWorkers() )
+         SAFE_DELETE(this->copyWorkers); // fall back to synchronous operations
+   }
+
    free(argvLib[0]);
 }
 
@@ -69,6 +81,7 @@ DeeperCache::DeeperCache()
  */
 DeeperCache::~DeeperCache()
 {
+   SAFE_DELETE(copyWorkers); // finishes all queued async operations
    SAFE_DELETE(logger);
    SAFE_DELETE(cfg);
 }
@@ -300,6 +313,13 @@ int DeeperCache::cache_prefetch(const char* path, int deeper_prefetch_flags)
       return retVal;
    }
 
+   if(this->copyWorkers && !(deeper_prefetch_flags & DEEPER_PREFETCH_WAIT) )
+   { // asynchronous => a copy worker calls us again with the wait flag
+      this->copyWorkers->addJob(new CopyJob(CopyJobType_PREFETCH, path, deeper_prefetch_flags,
+         0, 0) );
+      return DEEPER_RETVAL_SUCCESS;
+   }
+
    if(deeper_prefetch_flags & DEEPER_PREFETCH_SUBDIRS)
       retVal = handleSubdirectoryFlag(path, cachePath.c_str(), true, false,
          deeper_prefetch_flags & DEEPER_PREFETCH_FOLLOWSYMLINKS);
@@ -368,6 +388,9 @@ int DeeperCache::cache_prefetch(const char* path, int deeper_prefetch_flags)
  *           create symbolic links when a symbolic link was found;
  * @param outChecksum The checksum of the file.
  * @return 0 on success, -1 and errno set in case of error.
+ *
+ * Note: This is always a synchronous operation, because the checksum is returned to the caller;
+ * large files are still copied in parallel chunks.
  */
 int DeeperCache::cache_prefetch_crc(const char* path, int deeper_prefetch_flags,
    unsigned long* outChecksum)
@@ -469,6 +492,13 @@ int DeeperCache::cache_prefetch_range(const char* path, off_t start_pos, size_t
       return retVal;
    }
 
+   if(this->copyWorkers && !(deeper_prefetch_flags & DEEPER_PREFETCH_WAIT) )
+   { // asynchronous => a copy worker calls us again with the wait flag
+      this->copyWorkers->addJob(new CopyJob(CopyJobType_PREFETCH_RANGE, path,
+         deeper_prefetch_flags, start_pos, num_bytes) );
+      return DEEPER_RETVAL_SUCCESS;
+   }
+
    if(!CachePathTk::createPath(cachePath, cfg->getSysMountPointGlobal(),
       cfg->getSysMountPointCache(), true, this->logger) )
          return DEEPER_RETVAL_ERROR;
@@ -485,12 +515,19 @@ int DeeperCache::cache_prefetch_range(const char* path, off_t start_pos, size_t
  * @param deeper_prefetch_flags zero or a combination of the following flags:
  *        DEEPER_PREFETCH_SUBDIRS to recursively wait contents of all subdirs, if given path leads
  *           to a directory.
- * @return 0 on success, -1 and errno set in case of error.
+ * @return 0 on success, -1 and errno set in case of error (e.g. errno of a failed prefetch).
  */
 int DeeperCache::cache_prefetch_wait(const char* path, int deeper_prefetch_flags)
 {
-   // not implemented in the synchronous implementation
-   return DEEPER_RETVAL_SUCCESS;
+#ifdef BEEGFS_DEBUG
+   this->logger->logErr(__FUNCTION__, "path: " + std::string(path) );
+#endif
+
+   if(!this->copyWorkers)
+      return DEEPER_RETVAL_SUCCESS; // all prefetches are synchronous
+
+   return this->copyWorkers->waitForJobs(path, false,
+      deeper_prefetch_flags & DEEPER_PREFETCH_SUBDIRS);
 }
 
 /**
@@ -524,6 +561,12 @@ int DeeperCache::cache_flush(const char* path, int deeper_flush_flags)
       return retVal;
    }
 
+   if(this->copyWorkers && !(deeper_flush_flags & DEEPER_FLUSH_WAIT) )
+   { // asynchronous => a copy worker calls us again with the wait flag
+      this->copyWorkers->addJob(new CopyJob(CopyJobType_FLUSH, path, deeper_flush_flags, 0, 0) );
+      return DEEPER_RETVAL_SUCCESS;
+   }
+
    if(deeper_flush_flags & DEEPER_FLUSH_SUBDIRS)
       retVal = handleSubdirectoryFlag(cachePath.c_str(), path, false,
          deeper_flush_flags & DEEPER_FLUSH_DISCARD,
@@ -597,6 +640,9 @@ int DeeperCache::cache_flush(const char* path, int deeper_flush_flags)
  *           symbolic links when a symbolic link was found;
  * @param outChecksum The checksum of the file.
  * @return 0 on success, -1 and errno set in case of error.
+ *
+ * Note: This is always a synchronous operation, because the checksum is returned to the caller;
+ * large files are still copied in parallel chunks.
  */
 int DeeperCache::cache_flush_crc(const char* path, int deeper_flush_flags,
    unsigned long* outChecksum)
@@ -699,6 +745,13 @@ int DeeperCache::cache_flush_range(const char* path, off_t start_pos, size_t num
       return retVal;
    }
 
+   if(this->copyWorkers && !(deeper_flush_flags & DEEPER_FLUSH_WAIT) )
+   { // asynchronous => a copy worker calls us again with the wait flag
+      this->copyWorkers->addJob(new CopyJob(CopyJobType_FLUSH_RANGE, path, deeper_flush_flags,
+         start_pos, num_bytes) );
+      return DEEPER_RETVAL_SUCCESS;
+   }
+
    if(!CachePathTk::createPath(path, cfg->getSysMountPointCache(), cfg->getSysMountPointGlobal(),
       true, this->logger) )
          return DEEPER_RETVAL_ERROR;
@@ -715,12 +768,18 @@ int DeeperCache::cache_flush_range(const char* path, off_t start_pos, size_t num
  * @param deeper_flush_flags zero or a combination of the following flags:
  *        DEEPER_FLUSH_SUBDIRS to recursively wait contents of all subdirs, if given path leads
  *           to a directory.
- * @return 0 on success, -1 and errno set in case of error.
+ * @return 0 on success, -1 and errno set in case of error (e.g. errno of a failed flush).
  */
 int DeeperCache::cache_flush_wait(const char* path, int deeper_flush_flags)
 {
-   // not implemented in the synchronous implementation
-   return DEEPER_RETVAL_SUCCESS;
+#ifdef BEEGFS_DEBUG
+   this->logger->logErr(__FUNCTION__, "path: " + std::string(path) );
+#endif
+
+   if(!this->copyWorkers)
+      return DEEPER_RETVAL_SUCCESS; // all flushes are synchronous
+
+   return this->copyWorkers->waitForJobs(path, true, deeper_flush_flags & DEEPER_FLUSH_SUBDIRS);
 }
 
 /**
@@ -783,6 +842,34 @@ int DeeperCache::cache_id(const char* path, uint64_t* out_cache_id)
    return DEEPER_RETVAL_SUCCESS;
 }
 
+/**
+ * Run an asynchronous prefetch or flush job. Called by the copy workers.
+ *
+ * @return 0 on success, -1 and errno set in case of error.
+ */
+int DeeperCache::runCopyJob(CopyJob* job)
+{
+   switch(job->type)
+   {
+      case CopyJobType_PREFETCH:
+         return cache_prefetch(job->path.c_str(), job->flags | DEEPER_PREFETCH_WAIT);
+
+      case CopyJobType_PREFETCH_RANGE:
+         return cache_prefetch_range(job->path.c_str(), job->startPos, job->numBytes,
+            job->flags | DEEPER_PREFETCH_WAIT);
+
+      case CopyJobType_FLUSH:
+         return cache_flush(job->path.c_str(), job->flags | DEEPER_FLUSH_WAIT);
+
+      case CopyJobType_FLUSH_RANGE:
+         return cache_flush_range(job->path.c_str(), job->startPos, job->numBytes,
+            job->flags | DEEPER_FLUSH_WAIT);
+   }
+
+   errno = EINVAL;
+   return DEEPER_RETVAL_ERROR;
+}
+
 
 
 /**
@@ -863,10 +950,7 @@ int DeeperCache::copyFile(const char* sourcePath, const char* destPath,
    int saveErrno = 0;
    int dest;
 
-   int readSize;
-   int writeSize;
-
-   Byte* buf = (Byte*)malloc(BUFFER_SIZE);
+   char* buf = (char*)malloc(BUFFER_SIZE);
    if(!buf)
    {
       this->logger->logErr(__FUNCTION__, "Could not allocate memory to copy the file: " +
@@ -917,26 +1001,19 @@ int DeeperCache::copyFile(const char* sourcePath, const char* destPath,
       goto close_source;
    }
 
-   if(doCRC && (crcOutValue != NULL) )
-      *crcOutValue = crc32(0L, Z_NULL, 0); // init checksum
+   retVal = copyData(source, dest, 0,
+      (statSource && S_ISREG(statSource->st_mode) ) ? statSource->st_size : newStatSource.st_size,
+      buf, doCRC && (crcOutValue != NULL), crcOutValue);
 
-   while ( (readSize = read(source, buf, BUFFER_SIZE) ) > 0)
+   if(retVal == DEEPER_RETVAL_ERROR)
    {
-      if(doCRC)
-         *crcOutValue = crc32(*crcOutValue, buf, readSize);
-
-      writeSize = write(dest, buf, readSize);
-
-      if(unlikely(writeSize != readSize) )
-      {
-         saveErrno = errno;
-         error = true;
+      saveErrno = errno;
+      error = true;
 
-         this->logger->logErr(__FUNCTION__, "Could not copy file: " + std::string(sourcePath)
-            + " to " + std::string(destPath) + " Errno: " + System::getErrString(saveErrno) );
+      this->logger->logErr(__FUNCTION__, "Could not copy file: " + std::string(sourcePath)
+         + " to " + std::string(destPath) + " Errno: " + System::getErrString(saveErrno) );
 
-         goto close_dest;
-      }
+      goto close_dest;
    }
 
 
@@ -1006,7 +1083,6 @@ int DeeperCache::copyFileRange(const char* sourcePath, const char* destPath,
    const struct stat* statSource, off_t* offset, size_t numBytes)
 {
    int retVal = DEEPER_RETVAL_ERROR;
-   off_t retOffset = 0;
 
 #ifdef BEEGFS_DEBUG
    this->logger->logErr(__FUNCTION__, "source path: " + std::string(sourcePath) +
@@ -1020,11 +1096,6 @@ int DeeperCache::copyFileRange(const char* sourcePath, const char* destPath,
    int saveErrno = 0;
    int dest;
 
-   int readSize;
-   int writeSize;
-   size_t nextReadSize;
-   size_t dataToRead = numBytes;
-
    char* buf = (char*)malloc(BUFFER_SIZE);
    if(!buf)
    {
@@ -1076,64 +1147,19 @@ int DeeperCache::copyFileRange(const char* sourcePath, const char* destPath,
      goto close_source;
    }
 
-   retOffset = lseek(source, *offset, SEEK_SET);
-   if(retOffset != *offset)
-   {
-      saveErrno = errno;
-      error = true;
-
-      this->logger->logErr(__FUNCTION__, "Could not seek in source file: " +
-         std::string(sourcePath) + " Errno: " + System::getErrString(saveErrno) );
-
-      goto close_dest;
-   }
-
-   retOffset = lseek(dest, *offset, SEEK_SET);
-   if(retOffset != *offset)
+   retVal = copyData(source, dest, *offset, numBytes, buf, false, NULL);
+   if(retVal == DEEPER_RETVAL_ERROR)
    {
       saveErrno = errno;
       error = true;
 
-      this->logger->logErr(__FUNCTION__, "Could not seek in destination file: " +
-         std::string(destPath) + " Errno: " + System::getErrString(saveErrno) );
+      this->logger->logErr(__FUNCTION__, "Could not copy file: " +
+         std::string(sourcePath) + " to " + std::string(destPath) + " Errno: " +
+         System::getErrString(saveErrno) );
 
       goto close_dest;
    }
 
-   nextReadSize = std::min(dataToRead, BUFFER_SIZE);
-   while(nextReadSize > 0)
-   {
-      readSize = read(source, buf, nextReadSize);
-
-      if(readSize == -1)
-      {
-         saveErrno = errno;
-         error = true;
-
-         this->logger->logErr(__FUNCTION__, "Could not copy file: " +
-            std::string(sourcePath) + " to " + std::string(destPath) + " Errno: " +
-            System::getErrString(saveErrno) );
-
-         goto close_dest;
-      }
-
-      writeSize = write(dest, buf, readSize);
-
-      if(unlikely(writeSize != readSize) )
-      {
-         saveErrno = errno;
-         error = true;
-
-         this->logger->logErr(__FUNCTION__, "Could not read data from file: " +
-            std::string(sourcePath) + " Errno: " + System::getErrString(saveErrno) );
-
-         goto close_dest;
-      }
-
-      dataToRead -= readSize;
-      nextReadSize = std::min(dataToRead, BUFFER_SIZE);
-   }
-
    if(!statSource)
       retVal = fchown(dest, newStatSource.st_uid, newStatSource.st_gid);
    else
@@ -1177,6 +1203,25 @@ free_buf:
    return retVal;
 }
 
+/**
+ * copy a range of a file, in parallel chunks by the copy workers if the range is large enough
+ *
+ * @param buf buffer of BUFFER_SIZE for the calling thread
+ * @param doCRC true if a CRC checksum should be calculated
+ * @param outCRC out value for the checksum if a checksum should be calculated
+ * @return 0 on success, -1 and errno set in case of error.
+ */
+int DeeperCache::copyData(int sourceFD, int destFD, off_t offset, size_t numBytes, char* buf,
+   bool doCRC, unsigned long* outCRC)
+{
+   if(this->copyWorkers)
+      return this->copyWorkers->copyDataParallel(sourceFD, destFD, offset, numBytes, buf,
+         BUFFER_SIZE, doCRC, outCRC);
+
+   return FileCopyTk::copyData(sourceFD, destFD, offset, numBytes, buf, BUFFER_SIZE, doCRC,
+      outCRC, NULL);
+}
+
 
 /**
  * copies a directory to an other directory using nftw()
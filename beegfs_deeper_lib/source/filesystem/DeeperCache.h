@@ -6,6 +6,7 @@
 #include <common/threading/Mutex.h>
 #include <common/Common.h>
 #include <common/app/log/Logger.h>
+#include <components/CopyWorkerPool.h>
 #include <session/DeeperCacheSession.h>
 
 #include <dirent.h>
@@ -45,6 +46,8 @@ class DeeperCache
 
       int cache_id(const char* path, uint64_t* out_cache_id);
 
+      int runCopyJob(CopyJob* job);
+
 
    private:
       DeeperCache();
@@ -58,11 +61,7 @@ class DeeperCache
       Mutex fdMapMutex;
       DeeperCacheSessionMap sessionMap;
 
-      Mutex prefetchMapMutex;
-      StringList prefetchList;
-
-      Mutex flushMapMutex;
-      StringList flushList;
+      CopyWorkerPool* copyWorkers; // NULL if all operations are synchronous
 
       static DeeperCache* cacheInstance;
 
@@ -115,6 +114,8 @@ class DeeperCache
          bool deleteSource, bool doCRC, unsigned long* crcOutValue);
       int copyFileRange(const char* sourcePath, const char* destPath, const struct stat* statSource,
          off_t* offset, size_t numBytes);
+      int copyData(int sourceFD, int destFD, off_t offset, size_t numBytes, char* buf,
+         bool doCRC, unsigned long* outCRC);
       int copyDir(const char* source, const char* dest, bool copyToCache, bool deleteSource,
          bool followSymlink);
       int createSymlink(const char* sourcePath, const char* destPath, const struct stat* statSource,
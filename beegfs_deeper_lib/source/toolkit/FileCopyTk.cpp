@@ -0,0 +1,132 @@
+#include <deeper/deeper_cache.h>
+#include "FileCopyTk.h"
+
+#include <sys/syscall.h>
+#include <zlib.h>
+
+
+// set when the kernel doesn't know the copy_file_range syscall, so that we don't try again
+static bool copyFileRangeUnsupported = false;
+
+
+/**
+ * Copy a range of a file to the same offset of another file. Data is copied in kernel space with
+ * copy_file_range() if possible and through the given buffer with pread()/pwrite() otherwise.
+ *
+ * Note: Uses only explicit file offsets, so multiple threads can copy different ranges of the same
+ * file descriptors in parallel.
+ *
+ * @param offset start offset in source and destination file.
+ * @param numBytes number of bytes to copy, copying also stops at the end of the source file.
+ * @param buf buffer for pread()/pwrite()
+ * @param doCRC true to calculate a CRC checksum of the copied data; requires to copy the data
+ *        through the buffer.
+ * @param outCRC CRC checksum of the copied data (only set if doCRC is true).
+ * @param outNumCopied number of bytes that were copied (may be NULL).
+ * @return 0 on success, -1 and errno set in case of error.
+ */
+int FileCopyTk::copyData(int sourceFD, int destFD, off_t offset, size_t numBytes, char* buf,
+   size_t bufLen, bool doCRC, unsigned long* outCRC, size_t* outNumCopied)
+{
+   size_t numCopied = 0;
+   int retVal = DEEPER_RETVAL_SUCCESS;
+
+   if(doCRC)
+      *outCRC = crc32(0L, Z_NULL, 0); // init checksum
+   else
+   { // try to copy in kernel space first
+      while(numCopied < numBytes)
+      {
+         ssize_t copyRes = copyFileRange(sourceFD, destFD, offset + numCopied,
+            numBytes - numCopied);
+
+         if(copyRes > 0)
+            numCopied += copyRes;
+         else
+         if(!copyRes)
+            goto done; // end of source file
+         else
+         if(!numCopied && ( (errno == ENOSYS) || (errno == EXDEV) || (errno == EINVAL) ||
+            (errno == EOPNOTSUPP) ) )
+            break; // not supported for these files => fall back to buffered copy
+         else
+            return DEEPER_RETVAL_ERROR;
+      }
+   }
+
+   while(numCopied < numBytes)
+   {
+      size_t readSize = std::min(bufLen, numBytes - numCopied);
+
+      ssize_t readRes = pread(sourceFD, buf, readSize, offset + numCopied);
+      if(readRes == -1)
+      {
+         if(errno == EINTR)
+            continue;
+
+         retVal = DEEPER_RETVAL_ERROR;
+         goto done;
+      }
+
+      if(!readRes)
+         break; // end of source file
+
+      if(doCRC)
+         *outCRC = crc32(*outCRC, (Bytef*)buf, readRes);
+
+      for(ssize_t numWritten = 0; numWritten < readRes; )
+      {
+         ssize_t writeRes = pwrite(destFD, buf + numWritten, readRes - numWritten,
+            offset + numCopied + numWritten);
+         if(writeRes == -1)
+         {
+            if(errno == EINTR)
+               continue;
+
+            retVal = DEEPER_RETVAL_ERROR;
+            goto done;
+         }
+
+         numWritten += writeRes;
+      }
+
+      numCopied += readRes;
+   }
+
+done:
+   if(outNumCopied)
+      *outNumCopied = numCopied;
+
+   return retVal;
+}
+
+/**
+ * Wrapper for the copy_file_range syscall, which doesn't have a glibc wrapper on older systems.
+ *
+ * @return number of copied bytes, 0 at end of source file, -1 and errno set in case of error
+ *         (ENOSYS if the syscall is not supported).
+ */
+ssize_t FileCopyTk::copyFileRange(int sourceFD, int destFD, off_t offset, size_t numBytes)
+{
+#ifdef __NR_copy_file_range
+   if(copyFileRangeUnsupported)
+   {
+      errno = ENOSYS;
+      return -1;
+   }
+
+   loff_t sourceOffset = offset;
+   loff_t destOffset = offset;
+
+   ssize_t copyRes = syscall(__NR_copy_file_range, sourceFD, &sourceOffset, destFD, &destOffset,
+      numBytes, 0);
+
+   if( (copyRes == -1) && (errno == ENOSYS) )
+      copyFileRangeUnsupported = true;
+
+   return copyRes;
+#else
+   errno = ENOSYS;
+   return -1;
+#endif // __NR_copy_file_range
+}
@@ -0,0 +1,21 @@
+#ifndef TOOLKIT_FILECOPYTK_H_
+#define TOOLKIT_FILECOPYTK_H_
+
+
+#include <common/Common.h>
+
+
+class FileCopyTk
+{
+   public:
+      static int copyData(int sourceFD, int destFD, off_t offset, size_t numBytes, char* buf,
+         size_t bufLen, bool doCRC, unsigned long* outCRC, size_t* outNumCopied);
+
+
+   private:
+      FileCopyTk();
+
+      static ssize_t copyFileRange(int sourceFD, int destFD, off_t offset, size_t numBytes);
+};
+
+#endif /* TOOLKIT_FILECOPYTK_H_ */
@@ -33,6 +33,7 @@ App::App(int argc, char** argv)
    this->clientNodes = NULL;
    this->targetMapper = NULL;
    this->webServer = NULL;
+   this->runtimeCfg = NULL;
    this->db = NULL;
    this->nodeListRequestor = NULL;
    this->clientStatsOperator = NULL;
@@ -63,6 +64,7 @@ App::~App()
    SAFE_DELETE(this->targetMapper);
    SAFE_DELETE(this->webServer);
    SAFE_DELETE(this->db);
+   SAFE_DELETE(this->runtimeCfg);
    SAFE_DELETE(this->nodeListRequestor);
    SAFE_DELETE(this->clientStatsOperator);
    SAFE_DELETE(this->dataRequestorIOStats);
@@ -204,6 +206,9 @@ void App::runUnitTests()
    else
       testRunnerOutputFormat = TestRunnerOutputFormat_TEXT;
 
+   // the database tests need the runtime config for the initial tables
+   this->runtimeCfg = new RuntimeConfig(cfg);
+
    this->testRunner = new TestRunner(cfg->getTestOutputFile(), testRunnerOutputFormat);
 
    this->testRunner->start();
@@ -57,6 +57,9 @@ void DataRequestorIOStats::requestLoop()
          this->t.setToNow();
       }
 
+      // write buffered stats of the previous round (in case the DB ingest limits aren't reached)
+      Program::getApp()->getDB()->flushPendingRows();
+
       // do nothing but wait for the time of queryInterval
       if (PThread::waitForSelfTerminateOrder(this->queryInterval))
          break;
@@ -26,6 +26,15 @@ Database::Database()
 
 Database::~Database()
 {
+   // write the remaining buffered stats
+   flushPendingRows();
+
+   for (int i = 0; i < TABLENAMES_NUM; i++)
+   {
+      if (insertStmts[i])
+         sqlite3_finalize(insertStmts[i]);
+   }
+
    // close the sqlite connection
    sqlite3_close(this->db);
 }
@@ -39,6 +48,9 @@ void Database::initDatabase(bool clearDatabase)
 {
    log.setContext("Database");
 
+   this->numPendingRows = 0;
+   memset(this->insertStmts, 0, sizeof(this->insertStmts) );
+
    if (this->dbFile.empty())
       throw InvalidConfigException("The config argument 'databaseFile' with a empty value is "
          "invalid.");
@@ -91,6 +103,10 @@ void Database::createOrCheckDBFile()
       if (sqlite3_open_v2(this->dbFile.c_str(), &(this->db),
          SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL) != SQLITE_OK)
          throw DatabaseException(DB_CONNECT_ERROR, "Could not open database file.");
+
+      // let cleanUp() give the space of deleted stats back to the file system (this can only be
+      // set before the first table is created)
+      WritingQuery("PRAGMA auto_vacuum = INCREMENTAL;");
    }
 
    // check if a connection with the DB is possible
@@ -447,6 +463,20 @@ void Database::createStatisticsTables(NodeType nodeType)
             throw;
       }
 
+      try
+      {
+         // for time range queries of a single node (see getMetaNodeSets(), getStorageNodeSets())
+         log.log(Log_DEBUG, "create index idx_" + type + "_nodeNumID_time");
+         query = "CREATE INDEX IF NOT EXISTS 'idx_" + type + "_nodeNumID_time' ON '" + type +
+            "' (nodeNumID, time)";
+         WritingQuery(query);
+      }
+      catch (DatabaseException &e)
+      {
+         if (!(std::string(e.what()).find("has no column named nodeNumID") != std::string::npos))
+            throw;
+      }
+
       log.log(Log_DEBUG, "create index idx_" + type + "_time");
       query = "CREATE INDEX IF NOT EXISTS 'idx_" + type + "_time' ON '" + type + "' (time)";
       WritingQuery(query);
@@ -467,6 +497,9 @@ void Database::insertMetaNodeData(std::string nodeID, uint16_t nodeNumID, MetaNo
 /*
  * insert a dataset for a specific meta node into a given table
  *
+ * note: the dataset is buffered and written together with other datasets in one transaction
+ * (see flushPendingRows())
+ *
  * @param nodeID the ID of the metadata node
  * @tabType table type (normal,hourly,daily) to write to
  * @data the MetaNodeDataContent to write
@@ -474,57 +507,33 @@ void Database::insertMetaNodeData(std::string nodeID, uint16_t nodeNumID, MetaNo
 void Database::insertMetaNodeData(std::string nodeID, uint16_t nodeNumID, TabType tabType,
    MetaNodeDataContent data)
 {
-   // choose the right table
-   std::string tab;
-   switch (tabType)
-   {
-      case TABTYPE_Normal:
-         tab = tableNames[TableNames_metaNormal];
-         break;
-      case TABTYPE_Hourly:
-         tab = tableNames[TableNames_metaHourly];
-         break;
-      case TABTYPE_Daily:
-         tab = tableNames[TableNames_metaDaily];
-         break;
-   }
-
    // check if nodeID is OK (i.e. in this case check for whitespaces in ID)
-   if (nodeID.find(" ") == std::string::npos)
-   {
-      // assemble the INSERT query and write it using WritingQuery
-      std::ostringstream query;
-      query << "INSERT INTO '" << tab << "' ('nodeID', 'nodeNumID', 'time', 'is_responding', "
-         "'indirectWorkListSize', 'directWorkListSize', 'queuedRequests', 'workRequests') "
-         "VALUES ('";
-      query << nodeID << "','";
-      query << nodeNumID << "','";
-      query << data.time << "','";
-      query << data.isResponding << "','";
-      query << data.indirectWorkListSize << "','";
-      query << data.directWorkListSize << "','";
-      query << data.queuedRequests << "','";
-      query << data.workRequests << "');";
-
-      try
-      {
-         WritingQuery(query.str());
-      }
-      catch (DatabaseException &e)
-      {
-         std::string errorMsg = e.what();
-         if (errorMsg.find("UNIQUE constraint failed") == std::string::npos)
-         {
-            log.log(Log_NOTICE, "Database error while inserting meta node data!");
-            log.log(Log_SPAM, "Exception text follows: " + errorMsg + ". Query: " +
-               query.str());
-         }
-      }
-   }
-   else
+   if (nodeID.find(" ") != std::string::npos)
    {
       log.log(Log_NOTICE, "Errors exist in parameter nodeID!");
+      return;
    }
+
+   SafeMutexLock mutexLock(&ingestMutex); // L O C K
+
+   if (!numPendingRows)
+      oldestPendingRowT.setToNow();
+
+   pendingMetaRows.push_back(DatabasePendingMetaRow() );
+
+   DatabasePendingMetaRow& row = pendingMetaRows.back();
+   row.tabType = tabType;
+   row.nodeID = nodeID;
+   row.nodeNumID = nodeNumID;
+   row.data = data;
+
+   numPendingRows++;
+
+   if ( (numPendingRows >= DB_INGEST_BATCH_MAX_ROWS) ||
+      (oldestPendingRowT.elapsedMS() >= DB_INGEST_FLUSH_INTERVAL_MS) )
+      flushPendingRowsUnlocked();
+
+   mutexLock.unlock(); // U N L O C K
 }
 
 /*
@@ -540,7 +549,10 @@ void Database::insertStorageNodeData(std::string nodeID, uint16_t nodeNumID,
 }
 
 /*
- * insert a dataset for a specific storage node into the normal table
+ * insert a dataset for a specific storage node into a given table
+ *
+ * note: the dataset is buffered and written together with other datasets in one transaction
+ * (see flushPendingRows())
  *
  * @param nodeID the ID of the storage node
  * @tabType table type (normal,hourly,daily) to write to
@@ -549,59 +561,217 @@ void Database::insertStorageNodeData(std::string nodeID, uint16_t nodeNumID,
 void Database::insertStorageNodeData(std::string nodeID, uint16_t nodeNumID, TabType tabType,
    StorageNodeDataContent data)
 {
-   // choose the right table
-   std::string tab;
-   switch (tabType)
+   // check if nodeID is OK (i.e. in this case check for whitespaces in ID)
+   if (nodeID.find(" ") != std::string::npos)
    {
-      case TABTYPE_Normal:
-         tab = tableNames[TableNames_storageNormal];
-         break;
-      case TABTYPE_Hourly:
-         tab = tableNames[TableNames_storageHourly];
-         break;
-      case TABTYPE_Daily:
-         tab = tableNames[TableNames_storageDaily];
-         break;
+      log.log(Log_NOTICE, "Errors exist in parameter nodeID!");
+      return;
    }
 
-   // check if nodeID is OK (i.e. in this case check for whitespaces in ID)
-   if ((nodeID.find(" ") == std::string::npos)) // && (node != NULL) )
-   {
-      // assemble the INSERT query and write it using WritingQuery
-      std::ostringstream nodeQuery;
-      nodeQuery << "INSERT INTO '" << tab << "' ('nodeID', 'nodeNumID', 'time', 'is_responding', "
-               "'indirectWorkListSize', 'directWorkListSize', 'diskSpaceTotal', 'diskSpaceFree',"
-               "'diskRead', 'diskWrite', 'diskReadPerSec', 'diskWritePerSec') VALUES ('";
-      nodeQuery << nodeID << "','";
-      nodeQuery << nodeNumID << "','";
-      nodeQuery << data.time << "','";
-      nodeQuery << data.isResponding << "','";
-      nodeQuery << data.indirectWorkListSize << "','";
-      nodeQuery << data.directWorkListSize << "','";
-      nodeQuery << data.diskSpaceTotal << "','";
-      nodeQuery << data.diskSpaceFree << "','";
-      nodeQuery << data.diskRead << "','";
-      nodeQuery << data.diskWrite << "','";
-      nodeQuery << data.diskReadPerSec << "','";
-      nodeQuery << data.diskWritePerSec << "');";
-      try
-      {
-         WritingQuery(nodeQuery.str());
-      }
-      catch (DatabaseException &e)
+   SafeMutexLock mutexLock(&ingestMutex); // L O C K
+
+   if (!numPendingRows)
+      oldestPendingRowT.setToNow();
+
+   pendingStorageRows.push_back(DatabasePendingStorageRow() );
+
+   DatabasePendingStorageRow& row = pendingStorageRows.back();
+   row.tabType = tabType;
+   row.nodeID = nodeID;
+   row.nodeNumID = nodeNumID;
+   row.data = data;
+   row.data.storageTargets.clear(); // not stored in the stats tables
+
+   numPendingRows++;
+
+   if ( (numPendingRows >= DB_INGEST_BATCH_MAX_ROWS) ||
+      (oldestPendingRowT.elapsedMS() >= DB_INGEST_FLUSH_INTERVAL_MS) )
+      flushPendingRowsUnlocked();
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/*
+ * write all buffered node stats to the DB
+ *
+ * note: called by the readers of the stats tables, so that they always see all datasets
+ */
+void Database::flushPendingRows()
+{
+   SafeMutexLock mutexLock(&ingestMutex); // L O C K
+
+   flushPendingRowsUnlocked();
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/*
+ * write all buffered node stats in a single transaction (instead of one transaction and thus one
+ * sync of the DB file per dataset)
+ *
+ * note: datasets that cannot be written are dropped (like they were before buffering was
+ * introduced), so that a broken DB doesn't let the buffer grow without limit
+ *
+ * note: caller must hold ingestMutex
+ */
+void Database::flushPendingRowsUnlocked()
+{
+   if (!numPendingRows)
+      return;
+
+   try
+   {
+      WritingQuery("BEGIN TRANSACTION;");
+
+      for (DatabasePendingMetaRowListIter iter = pendingMetaRows.begin();
+         iter != pendingMetaRows.end(); iter++)
+         insertMetaRowUnlocked(*iter);
+
+      for (DatabasePendingStorageRowListIter iter = pendingStorageRows.begin();
+         iter != pendingStorageRows.end(); iter++)
+         insertStorageRowUnlocked(*iter);
+
+      WritingQuery("COMMIT;");
+   }
+   catch (DatabaseException &e)
+   {
+      log.log(Log_NOTICE, "Database error while writing node data! Number of dropped datasets: " +
+         StringTk::uintToStr(numPendingRows) );
+      log.log(Log_SPAM, "Exception text follows: " + std::string(e.what() ) );
+
+      // make sure we don't leave an open transaction behind
+      sqlite3_exec(this->db, "ROLLBACK;", NULL, NULL, NULL);
+   }
+
+   pendingMetaRows.clear();
+   pendingStorageRows.clear();
+   numPendingRows = 0;
+}
+
+/*
+ * note: caller must hold ingestMutex and must have started a transaction
+ * @throw DatabaseException if the statement cannot be prepared
+ */
+void Database::insertMetaRowUnlocked(DatabasePendingMetaRow& row)
+{
+   sqlite3_stmt* stmt = getInsertStmtUnlocked(getStatsTable(NODETYPE_Meta, row.tabType) );
+
+   sqlite3_bind_text(stmt, 1, row.nodeID.c_str(), -1, SQLITE_TRANSIENT);
+   sqlite3_bind_int(stmt, 2, row.nodeNumID);
+   sqlite3_bind_int64(stmt, 3, row.data.time);
+   sqlite3_bind_int(stmt, 4, row.data.isResponding);
+   sqlite3_bind_int64(stmt, 5, row.data.indirectWorkListSize);
+   sqlite3_bind_int64(stmt, 6, row.data.directWorkListSize);
+   sqlite3_bind_int64(stmt, 7, row.data.queuedRequests);
+   sqlite3_bind_int64(stmt, 8, row.data.workRequests);
+
+   int stepRes = sqlite3_step(stmt);
+
+   // a dataset for this node and time might already exist (e.g. after a restart)
+   if ( (stepRes != SQLITE_DONE) && (stepRes != SQLITE_CONSTRAINT) )
+   {
+      log.log(Log_NOTICE, "Database error while inserting meta node data!");
+      log.log(Log_SPAM, "Error text follows: " + std::string(sqlite3_errmsg(db) ) +
+         ". NodeID: " + row.nodeID);
+   }
+
+   sqlite3_reset(stmt);
+}
+
+/*
+ * note: caller must hold ingestMutex and must have started a transaction
+ * @throw DatabaseException if the statement cannot be prepared
+ */
+void Database::insertStorageRowUnlocked(DatabasePendingStorageRow& row)
+{
+   sqlite3_stmt* stmt = getInsertStmtUnlocked(getStatsTable(NODETYPE_Storage, row.tabType) );
+
+   sqlite3_bind_text(stmt, 1, row.nodeID.c_str(), -1, SQLITE_TRANSIENT);
+   sqlite3_bind_int(stmt, 2, row.nodeNumID);
+   sqlite3_bind_int64(stmt, 3, row.data.time);
+   sqlite3_bind_int(stmt, 4, row.data.isResponding);
+   sqlite3_bind_int64(stmt, 5, row.data.indirectWorkListSize);
+   sqlite3_bind_int64(stmt, 6, row.data.directWorkListSize);
+   sqlite3_bind_int64(stmt, 7, row.data.diskSpaceTotal);
+   sqlite3_bind_int64(stmt, 8, row.data.diskSpaceFree);
+   sqlite3_bind_int64(stmt, 9, row.data.diskRead);
+   sqlite3_bind_int64(stmt, 10, row.data.diskWrite);
+   sqlite3_bind_int64(stmt, 11, row.data.diskReadPerSec);
+   sqlite3_bind_int64(stmt, 12, row.data.diskWritePerSec);
+
+   int stepRes = sqlite3_step(stmt);
+
+   // a dataset for this node and time might already exist (e.g. after a restart)
+   if ( (stepRes != SQLITE_DONE) && (stepRes != SQLITE_CONSTRAINT) )
+   {
+      log.log(Log_NOTICE, "Database error while inserting storage node data!");
+      log.log(Log_SPAM, "Error text follows: " + std::string(sqlite3_errmsg(db) ) +
+         ". NodeID: " + row.nodeID);
+   }
+
+   sqlite3_reset(stmt);
+}
+
+/*
+ * get the prepared INSERT statement for a stats table (prepare it if this is the first use)
+ *
+ * note: caller must hold ingestMutex
+ * @throw DatabaseException if the statement cannot be prepared
+ */
+sqlite3_stmt* Database::getInsertStmtUnlocked(TableNames table)
+{
+   if (insertStmts[table])
+      return insertStmts[table];
+
+   std::string queryStr;
+
+   if ( (table >= TableNames_metaNormal) && (table <= TableNames_metaDaily) )
+      queryStr = "INSERT INTO '" + tableNames[table] + "' ('nodeID', 'nodeNumID', 'time', "
+         "'is_responding', 'indirectWorkListSize', 'directWorkListSize', 'queuedRequests', "
+         "'workRequests') VALUES (?, ?, ?, ?, ?, ?, ?, ?);";
+   else
+      queryStr = "INSERT INTO '" + tableNames[table] + "' ('nodeID', 'nodeNumID', 'time', "
+         "'is_responding', 'indirectWorkListSize', 'directWorkListSize', 'diskSpaceTotal', "
+         "'diskSpaceFree', 'diskRead', 'diskWrite', 'diskReadPerSec', 'diskWritePerSec') "
+         "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+
+   if (sqlite3_prepare_v2(this->db, queryStr.c_str(), -1, &insertStmts[table], NULL) !=
+      SQLITE_OK)
+   {
+      sqlite3_finalize(insertStmts[table]);
+      insertStmts[table] = NULL;
+      throw DatabaseException(DB_QUERY_ERROR, sqlite3_errmsg(db), queryStr.c_str());
+   }
+
+   return insertStmts[table];
+}
+
+/*
+ * get the stats table for the given node type and aggregation level
+ */
+TableNames Database::getStatsTable(NodeType nodeType, TabType tabType)
+{
+   if (nodeType == NODETYPE_Meta)
+   {
+      switch (tabType)
       {
-         std::string errorMsg = e.what();
-         if (errorMsg.find("UNIQUE constraint failed") == std::string::npos)
-         {
-            log.log(Log_NOTICE, "Database error while inserting storage node data!");
-            log.log(Log_SPAM, "Exception text follows: " + errorMsg + ". Query: " +
-               nodeQuery.str());
-         }
+         case TABTYPE_Hourly:
+            return TableNames_metaHourly;
+         case TABTYPE_Daily:
+            return TableNames_metaDaily;
+         default:
+            return TableNames_metaNormal;
       }
    }
-   else
+
+   switch (tabType)
    {
-      log.log(Log_NOTICE, "Errors exist in parameter nodeID!");
+      case TABTYPE_Hourly:
+         return TableNames_storageHourly;
+      case TABTYPE_Daily:
+         return TableNames_storageDaily;
+      default:
+         return TableNames_storageNormal;
    }
 }
 
@@ -614,6 +784,9 @@ void Database::getStorageNodes(StringList *outList)
 {
    sqlite3_stmt *stmt;
 
+   // make sure buffered datasets are included
+   flushPendingRows();
+
    // assemble the query
    std::string queryStr = std::string("SELECT DISTINCT nodeID FROM '" +
       tableNames[TableNames_storageNormal] + "';");
@@ -655,6 +828,9 @@ void Database::getMetaNodes(StringList *outList)
 {
    sqlite3_stmt *stmt;
 
+   // make sure buffered datasets are included
+   flushPendingRows();
+
    // assemble the query
    std::string queryStr = std::string("SELECT DISTINCT nodeID FROM '" +
       tableNames[TableNames_metaNormal] + "';");
@@ -716,6 +892,9 @@ void Database::getMetaNodeSets(uint16_t nodeNumID, TabType tabType, long minTime
          break;
    }
 
+   // make sure buffered datasets are included
+   flushPendingRows();
+
    if (nodeNumID != 0)
    {
       // assemble the query
@@ -795,6 +974,9 @@ void Database::getStorageNodeSets(uint16_t nodeNumID, TabType tabType, long minT
          break;
    }
 
+   // make sure buffered datasets are included
+   flushPendingRows();
+
    if (nodeNumID != 0)
    {
       // assemble the query
@@ -823,12 +1005,12 @@ void Database::getStorageNodeSets(uint16_t nodeNumID, TabType tabType, long minT
          row.isResponding = sqlite3_column_int(stmt, 1);
          row.indirectWorkListSize = sqlite3_column_int(stmt, 2);
          row.directWorkListSize = sqlite3_column_int(stmt, 3);
-         row.diskSpaceTotal = sqlite3_column_int(stmt, 4);
-         row.diskSpaceFree = sqlite3_column_int(stmt, 5);
-         row.diskRead = sqlite3_column_int(stmt, 6);
-         row.diskWrite = sqlite3_column_int(stmt, 7);
-         row.diskReadPerSec = sqlite3_column_int(stmt, 8);
-         row.diskWritePerSec = sqlite3_column_int(stmt, 9);
+         row.diskSpaceTotal = sqlite3_column_int64(stmt, 4);
+         row.diskSpaceFree = sqlite3_column_int64(stmt, 5);
+         row.diskRead = sqlite3_column_int64(stmt, 6);
+         row.diskWrite = sqlite3_column_int64(stmt, 7);
+         row.diskReadPerSec = sqlite3_column_int64(stmt, 8);
+         row.diskWritePerSec = sqlite3_column_int64(stmt, 9);
          outList->push_back(row);
          stepResult = sqlite3_step(stmt);
       }
@@ -1935,32 +2117,90 @@ void Database::cleanUp()
    long timeNow = (t.getTimeval()->tv_sec);
    long minTime = 0;
 
-   minTime = timeNow - (keepNormalDays * secondsPerDay);
+   // (ingestMutex also prevents that a flush starts a transaction in the meantime)
+   SafeMutexLock mutexLock(&ingestMutex); // L O C K
 
-   std::string query = "DELETE FROM " + tableNames[TableNames_metaNormal] +
-      " WHERE time<" + StringTk::intToStr(minTime);
-   WritingQuery(query);
-   query = "DELETE FROM " + tableNames[TableNames_storageNormal] +
-      " WHERE time<" + StringTk::intToStr(minTime);
-   WritingQuery(query);
+   flushPendingRowsUnlocked();
 
-   minTime = timeNow - (keepHourlyDays * secondsPerDay);
+   try
+   {
+      // delete in a single transaction instead of one transaction per table
+      WritingQuery("BEGIN TRANSACTION;");
 
-   query = "DELETE FROM " + tableNames[TableNames_metaHourly] +
-      " WHERE time<" + StringTk::intToStr(minTime);
-   WritingQuery(query);
-   query = "DELETE FROM " + tableNames[TableNames_storageHourly] +
-      " WHERE time<" + StringTk::intToStr(minTime);
-   WritingQuery(query);
+      minTime = timeNow - (keepNormalDays * secondsPerDay);
+
+      std::string query = "DELETE FROM " + tableNames[TableNames_metaNormal] +
+         " WHERE time<" + StringTk::intToStr(minTime);
+      WritingQuery(query);
+      query = "DELETE FROM " + tableNames[TableNames_storageNormal] +
+         " WHERE time<" + StringTk::intToStr(minTime);
+      WritingQuery(query);
 
-   minTime = timeNow - (keepDailyDays * secondsPerDay);
+      minTime = timeNow - (keepHourlyDays * secondsPerDay);
 
-   query = "DELETE FROM " + tableNames[TableNames_metaDaily] +
-      " WHERE time<" + StringTk::intToStr(minTime);
-   WritingQuery(query);
-   query = "DELETE FROM " + tableNames[TableNames_storageDaily] +
-      " WHERE time<" + StringTk::intToStr(minTime);
-   WritingQuery(query);
+      query = "DELETE FROM " + tableNames[TableNames_metaHourly] +
+         " WHERE time<" + StringTk::intToStr(minTime);
+      WritingQuery(query);
+      query = "DELETE FROM " + tableNames[TableNames_storageHourly] +
+         " WHERE time<" + StringTk::intToStr(minTime);
+      WritingQuery(query);
+
+      minTime = timeNow - (keepDailyDays * secondsPerDay);
+
+      query = "DELETE FROM " + tableNames[TableNames_metaDaily] +
+         " WHERE time<" + StringTk::intToStr(minTime);
+      WritingQuery(query);
+      query = "DELETE FROM " + tableNames[TableNames_storageDaily] +
+         " WHERE time<" + StringTk::intToStr(minTime);
+      WritingQuery(query);
+
+      WritingQuery("COMMIT;");
+   }
+   catch (DatabaseException &e)
+   {
+      sqlite3_exec(this->db, "ROLLBACK;", NULL, NULL, NULL);
+
+      mutexLock.unlock(); // U N L O C K
+      throw;
+   }
+
+   mutexLock.unlock(); // U N L O C K
+
+   incrementalVacuum();
+}
+
+/*
+ * give the pages of deleted datasets back to the file system, so that the DB file doesn't keep its
+ * maximum size forever
+ *
+ * note: this only has an effect for DB files which were created with auto_vacuum enabled (i.e. by
+ * this version or later)
+ */
+void Database::incrementalVacuum()
+{
+   sqlite3_stmt *stmt;
+   std::string queryStr = "PRAGMA incremental_vacuum;";
+
+   if (sqlite3_prepare_v2(this->db, queryStr.c_str(), -1, &stmt, NULL) != SQLITE_OK)
+   {
+      sqlite3_finalize(stmt);
+      throw DatabaseException(DB_QUERY_ERROR, sqlite3_errmsg(db), queryStr.c_str());
+   }
+
+   // (each step frees some pages)
+   int stepResult = sqlite3_step(stmt);
+   while (stepResult == SQLITE_ROW)
+      stepResult = sqlite3_step(stmt);
+
+   if (stepResult != SQLITE_DONE)
+   {
+      sqlite3_finalize(stmt);
+      throw DatabaseException(DB_QUERY_ERROR, sqlite3_errmsg(db), queryStr.c_str());
+   }
+   if (sqlite3_finalize(stmt) != SQLITE_OK)
+   {
+      throw DatabaseException(DB_QUERY_ERROR, sqlite3_errmsg(db), queryStr.c_str());
+   }
 }
 
 /*
@@ -1972,6 +2212,9 @@ void Database::getStorageNodes(UInt16List *outList)
 {
    sqlite3_stmt *stmt;
 
+   // make sure buffered datasets are included
+   flushPendingRows();
+
    // assemble the query
    std::string queryStr = std::string("SELECT DISTINCT nodeNumID FROM '" +
       tableNames[TableNames_storageNormal] + "';");
@@ -2012,6 +2255,9 @@ void Database::getMetaNodes(UInt16List *outList)
 {
    sqlite3_stmt *stmt;
 
+   // make sure buffered datasets are included
+   flushPendingRows();
+
    // assemble the query
    std::string queryStr = std::string("SELECT DISTINCT nodeNumID FROM '" +
       tableNames[TableNames_metaNormal] + "';");
@@ -8,6 +8,8 @@
  */
 
 #include <common/app/log/LogContext.h>
+#include <common/threading/SafeMutexLock.h>
+#include <common/toolkit/Time.h>
 #include <common/toolkit/TimeAbs.h>
 #include <common/Common.h>
 #include <nodes/MetaNodeEx.h>
@@ -35,6 +37,10 @@
 // the ID of the default group fro nodes
 #define DEFAULT_GROUP_ID -255
 
+// node stats are buffered and written in one transaction when one of these limits is reached
+#define DB_INGEST_BATCH_MAX_ROWS        512
+#define DB_INGEST_FLUSH_INTERVAL_MS     10000
+
 // forward declarations
 struct MetaNodeDataContent;
 struct StorageNodeDataContent;
@@ -79,6 +85,8 @@ enum TableNames
    TableNames_storageDaily = 11
 };
 
+#define TABLENAMES_NUM  (TableNames_storageDaily + 1)
+
 // contains all table names, access the values by the enum TableNames
 // keep in sync with the enum TableNames and do not change the order of
 // the values
@@ -99,6 +107,31 @@ const std::string tableNames[] =
    };
 
 
+/*
+ * a node stats row that waits in the ingest buffer to be written to the DB
+ */
+struct DatabasePendingMetaRow
+{
+   TabType tabType;
+   std::string nodeID;
+   uint16_t nodeNumID;
+   MetaNodeDataContent data;
+};
+
+struct DatabasePendingStorageRow
+{
+   TabType tabType;
+   std::string nodeID;
+   uint16_t nodeNumID;
+   StorageNodeDataContent data;
+};
+
+typedef std::list<DatabasePendingMetaRow> DatabasePendingMetaRowList;
+typedef DatabasePendingMetaRowList::iterator DatabasePendingMetaRowListIter;
+typedef std::list<DatabasePendingStorageRow> DatabasePendingStorageRowList;
+typedef DatabasePendingStorageRowList::iterator DatabasePendingStorageRowListIter;
+
+
 class Database
 {
    public:
@@ -153,6 +186,7 @@ class Database
       void getStorageNodesInGroup(int groupID, UInt16List *outNodes);
       void getStorageNodesInGroup(std::string groupName, UInt16List *outNodes);
       void cleanUp();
+      void flushPendingRows();
       bool metaNodeIsInGroup(uint16_t nodeNumID, int group);
       bool metaNodeIsInGroup(uint16_t nodeNumID, std::string group);
       bool storageNodeIsInGroup(uint16_t nodeNumID, int group);
@@ -168,6 +202,14 @@ class Database
       sqlite3 *db;
       LogContext log;
       App *app;
+
+      Mutex ingestMutex; // protects the pending rows and the insert statements
+      DatabasePendingMetaRowList pendingMetaRows;
+      DatabasePendingStorageRowList pendingStorageRows;
+      unsigned numPendingRows;
+      Time oldestPendingRowT; // only valid if numPendingRows > 0
+      sqlite3_stmt* insertStmts[TABLENAMES_NUM]; // prepared on first use, NULL otherwise
+
       void initDatabase(bool clearDatabase);
       void WritingQuery(std::string queryStr);
       void createOrCheckDBFile();
@@ -178,6 +220,12 @@ class Database
       bool checkUsageOfGroupID(int groupID);
       bool checkAndFixDatabaseCompatibility();
       void addNumNodeIDColumnToTable(std::string tableName);
+      TableNames getStatsTable(NodeType nodeType, TabType tabType);
+      void flushPendingRowsUnlocked();
+      void insertMetaRowUnlocked(DatabasePendingMetaRow& row);
+      void insertStorageRowUnlocked(DatabasePendingStorageRow& row);
+      sqlite3_stmt* getInsertStmtUnlocked(TableNames table);
+      void incrementalVacuum();
 };
 
 #endif /*DATABASE_H_*/
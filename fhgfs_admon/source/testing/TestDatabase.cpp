@@ -97,3 +97,48 @@ void TestDatabase::testClearBrokenDBOpen()
 
    log.log(Log_DEBUG, "testClearBrokenDBOpen finished");
 }
+
+/*
+ * insert some storage node datasets (which are buffered by the DB) and check that they can be read
+ * back immediately; duplicates for the same node and time must be ignored
+ */
+void TestDatabase::testBufferedNodeDataInsert()
+{
+   log.log(Log_DEBUG, "testBufferedNodeDataInsert started");
+
+   const unsigned numSets = 10;
+   const uint16_t nodeNumID = 1;
+
+   Database db(this->testDbFile, true);
+
+   db.createStatisticsTables(NODETYPE_Storage);
+
+   StorageNodeDataContent data;
+   data.isResponding = true;
+   data.indirectWorkListSize = 0;
+   data.directWorkListSize = 0;
+   data.diskSpaceTotal = 1LL << 40; // (to check that large values are stored completely)
+   data.diskSpaceFree = 1LL << 39;
+   data.diskRead = 0;
+   data.diskWrite = 0;
+   data.diskReadPerSec = 0;
+   data.diskWritePerSec = 0;
+   data.sessionCount = 0;
+
+   for (unsigned i = 1; i <= numSets; i++)
+   {
+      data.time = i;
+      db.insertStorageNodeData("storage01", nodeNumID, data);
+   }
+
+   data.time = 1;
+   db.insertStorageNodeData("storage01", nodeNumID, data); // duplicate
+
+   StorageNodeDataContentList dataList;
+   db.getStorageNodeSets(nodeNumID, TABTYPE_Normal, 0, numSets, &dataList);
+
+   CPPUNIT_ASSERT(dataList.size() == numSets);
+   CPPUNIT_ASSERT(dataList.front().diskSpaceTotal == data.diskSpaceTotal);
+
+   log.log(Log_DEBUG, "testBufferedNodeDataInsert finished");
+}
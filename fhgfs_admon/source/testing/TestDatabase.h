@@ -15,6 +15,7 @@ class TestDatabase: public CppUnit::TestFixture
    CPPUNIT_TEST( testExistingDBOpen );
    CPPUNIT_TEST( testBrokenDBOpen );
    CPPUNIT_TEST( testClearBrokenDBOpen );
+   CPPUNIT_TEST( testBufferedNodeDataInsert );
    CPPUNIT_TEST_SUITE_END();
 
    public:
@@ -28,6 +29,7 @@ class TestDatabase: public CppUnit::TestFixture
       void testExistingDBOpen();
       void testBrokenDBOpen();
       void testClearBrokenDBOpen();
+      void testBufferedNodeDataInsert();
 
    private:
       LogContext log;
@@ -42,7 +42,7 @@ bool TestRunner::addTests()
 //      this->testRunner.addTest(TestAdmonCommunication::suite());
       this->testRunner.addTest(TestConfig::suite());
       this->testRunner.addTest(TestMsgSerialization::suite());
-  //    this->testRunner.addTest(TestAdmonDatabase::suite());
+      this->testRunner.addTest(TestDatabase::suite());
 //      this->testRunner.addTest(TestAdmonJobRunner::suite());
       this->testRunner.addTest(TestUnitTk::suite());
       return true;
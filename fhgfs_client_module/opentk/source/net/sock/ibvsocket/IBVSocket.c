@@ -17,6 +17,7 @@
 #define IBVSOCKET_FLOWCONTROL_MSG_LEN                 1
 #define IBVSOCKET_FLOWCONTROL_ONRECV_TIMEOUT_MS  180000
 #define IBVSOCKET_STALE_RETRIES_NUM                 128
+#define IBVSOCKET_MIN_CREDITS                         2 /* (acks after credits-1 msgs) */
 
 
 void IBVSocket_init(IBVSocket* _this)
@@ -674,10 +675,12 @@ fhgfs_bool __IBVSocket_createCommContext(IBVSocket* _this, struct rdma_cm_id* cm
 
    // init flow control v2 (to avoid long receiver-not-ready timeouts)
 
+   commContext->sendCredits = commCfg->bufNum; // (might be reduced by the server on connect)
+
    /* note: we use -1 because the last buf might not be read by the user (eg during
       nonblockingRecvCheck) and so it might not be immediately available again. */
    commContext->numReceivedBufsLeft = commCfg->bufNum - 1;
-   commContext->numSendBufsLeft = commCfg->bufNum - 1;
+   commContext->numSendBufsLeft = commContext->sendCredits - 1;
 
    // create completion queues...
 
@@ -1271,7 +1274,7 @@ int __IBVSocket_flowControlOnRecv(IBVSocket* _this, int timeoutMS)
    IBVCommContext* commContext = _this->commContext;
 
    // we received a packet, so peer has received all of our currently pending data => reset counter
-   commContext->numSendBufsLeft = commContext->commCfg.bufNum - 1; /* (see
+   commContext->numSendBufsLeft = commContext->sendCredits - 1; /* (see
       createCommContext() for "-1" reason) */
 
    // send control packet if recv counter expires...
@@ -2311,6 +2314,15 @@ int __IBVSocket_connectedHandler(IBVSocket* _this, struct rdma_cm_event* event)
       goto err_invalidateSock;
    }
 
+   /* the server might accept less unacked msgs than we have bufs (e.g. if it uses shared recv
+      bufs) */
+   if( (_this->remoteDest->recvBufNum >= IBVSOCKET_MIN_CREDITS) &&
+       (_this->remoteDest->recvBufNum < _this->commContext->sendCredits) )
+   {
+      _this->commContext->sendCredits = _this->remoteDest->recvBufNum;
+      _this->commContext->numSendBufsLeft = _this->commContext->sendCredits - 1;
+   }
+
 
    return retVal;
 
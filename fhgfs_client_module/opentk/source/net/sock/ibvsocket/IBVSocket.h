@@ -178,6 +178,7 @@ struct IBVCommContext
    uint64_t                  numUsedRecvBufs; // receiver's flow/flood control (reset) counter
    unsigned                  numReceivedBufsLeft; // flow control v2 to avoid IB rnr timeout
    unsigned                  numSendBufsLeft; // flow control v2 to avoid IB rnr timeout
+   unsigned                  sendCredits; // msgs we may send before the peer acks
 
    IBVIncompleteRecv         incompleteRecv;
    IBVIncompleteSend         incompleteSend;
@@ -266,6 +266,8 @@ void _Config_loadDefaults(Config* this)
    _Config_configMapRedefine(this, "tuneRemoteFSync",                  "true");
    _Config_configMapRedefine(this, "tuneUseGlobalFileLocks",           "false");
    _Config_configMapRedefine(this, "tuneRefreshOnGetAttr",             "false");
+   _Config_configMapRedefine(this, "tuneReaddirPlus",                  "false");
+   _Config_configMapRedefine(this, "tuneUseAttribLeases",              "false");
    _Config_configMapRedefine(this, "tuneInodeBlockBits",               "19");
    _Config_configMapRedefine(this, "tuneEarlyCloseResponse",           "false");
    _Config_configMapRedefine(this, "tuneUseGlobalAppendLocks",         "false");
@@ -549,6 +551,12 @@ fhgfs_bool _Config_applyConfigMap(Config* this, fhgfs_bool enableException)
       if(!os_strcmp(keyStr, "tuneRefreshOnGetAttr") )
          this->tuneRefreshOnGetAttr = StringTk_strToBool(valueStr);
       else
+      if(!os_strcmp(keyStr, "tuneReaddirPlus") )
+         this->tuneReaddirPlus = StringTk_strToBool(valueStr);
+      else
+      if(!os_strcmp(keyStr, "tuneUseAttribLeases") )
+         this->tuneUseAttribLeases = StringTk_strToBool(valueStr);
+      else
       if(!os_strcmp(keyStr, "tuneInodeBlockBits") )
          this->tuneInodeBlockBits = StringTk_strToUInt(valueStr);
       else
@@ -128,6 +128,8 @@ static inline fhgfs_bool Config_getTuneRemoteFSync(Config* this);
 static inline fhgfs_bool Config_getTuneUseGlobalFileLocks(Config* this);
 static inline fhgfs_bool Config_getTuneRefreshOnGetAttr(Config* this);
 static inline void Config_setTuneRefreshOnGetAttr(Config* this);
+static inline fhgfs_bool Config_getTuneReaddirPlus(Config* this);
+static inline fhgfs_bool Config_getTuneUseAttribLeases(Config* this);
 static inline unsigned Config_getTuneInodeBlockBits(Config* this);
 static inline unsigned Config_getTuneInodeBlockSize(Config* this);
 static inline fhgfs_bool Config_getTuneEarlyCloseResponse(Config* this);
@@ -252,6 +254,8 @@ struct Config
    fhgfs_bool     tuneRemoteFSync;
    fhgfs_bool     tuneUseGlobalFileLocks; // fhgfs_false means local flock/fcntl locks
    fhgfs_bool     tuneRefreshOnGetAttr; // fhgfs_false means don't refresh on getattr
+   fhgfs_bool     tuneReaddirPlus; // get stat data of all entries with the dir listing
+   fhgfs_bool     tuneUseAttribLeases; // request dentry/attrib leases from meta servers
    unsigned       tuneInodeBlockBits; // bitshift for optimal io size seen by stat() (2^n)
    unsigned       tuneInodeBlockSize; // auto-generated based on tuneInodeBlockBits
    fhgfs_bool     tuneEarlyCloseResponse; // don't wait for chunk files close result
@@ -630,6 +634,16 @@ fhgfs_bool Config_getTuneRefreshOnGetAttr(Config* this)
    return this->tuneRefreshOnGetAttr;
 }
 
+fhgfs_bool Config_getTuneReaddirPlus(Config* this)
+{
+   return this->tuneReaddirPlus;
+}
+
+fhgfs_bool Config_getTuneUseAttribLeases(Config* this)
+{
+   return this->tuneUseAttribLeases;
+}
+
 bool Config_getTuneCoherentBuffers(Config* this)
 {
    return this->tuneCoherentBuffers;
@@ -162,6 +162,8 @@
 #define NETMSGTYPE_GetDefaultQuotaResp             2110
 #define NETMSGTYPE_SetDefaultQuota                 2111
 #define NETMSGTYPE_SetDefaultQuotaResp             2112
+#define NETMSGTYPE_ListDirPlus                     2125
+#define NETMSGTYPE_ListDirPlusResp                 2126
 
 // session messages
 #define NETMSGTYPE_OpenFile                        3001
@@ -192,6 +194,8 @@
 #define NETMSGTYPE_FLockRangeResp                  3028
 #define NETMSGTYPE_FLockAppend                     3029
 #define NETMSGTYPE_FLockAppendResp                 3030
+#define NETMSGTYPE_LeaseRevoked                    3031
+#define NETMSGTYPE_LeaseRevokedResp                3032 // this msg only has an ack response
 
 // control messages
 #define NETMSGTYPE_SetChannelDirect                4001
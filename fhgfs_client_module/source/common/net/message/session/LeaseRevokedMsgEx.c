@@ -0,0 +1,116 @@
+#include <app/App.h>
+#include <common/toolkit/SocketTk.h>
+#include <common/net/msghelpers/MsgHelperAck.h>
+#include <filesystem/FhgfsInode.h>
+#include <filesystem/FhgfsOpsInode.h>
+#include <filesystem/FhgfsOpsSuper.h>
+#include "LeaseRevokedMsgEx.h"
+
+/**
+ * Serialization not implemented!
+ */
+void LeaseRevokedMsgEx_serializePayload(NetMessage* this, char* buf)
+{
+   BEEGFS_BUG_ON(1, "This method is not implemented and should never be called");
+}
+
+fhgfs_bool LeaseRevokedMsgEx_deserializePayload(NetMessage* this, const char* buf, size_t bufLen)
+{
+   LeaseRevokedMsgEx* thisCast = (LeaseRevokedMsgEx*)this;
+
+   size_t bufPos = 0;
+
+   unsigned entryIDBufLen;
+   unsigned ackIDBufLen;
+   unsigned revokerNodeIDBufLen;
+
+   // entryID
+
+   if(!Serialization_deserializeStrAlign4(&buf[bufPos], bufLen-bufPos,
+      &thisCast->entryIDLen, &thisCast->entryID, &entryIDBufLen) )
+      return fhgfs_false;
+
+   bufPos += entryIDBufLen;
+
+   // ackID
+
+   if(!Serialization_deserializeStrAlign4(&buf[bufPos], bufLen-bufPos,
+      &thisCast->ackIDLen, &thisCast->ackID, &ackIDBufLen) )
+      return fhgfs_false;
+
+   bufPos += ackIDBufLen;
+
+   // revokerNodeID
+
+   if(!Serialization_deserializeUShort(&buf[bufPos], bufLen-bufPos,
+      &thisCast->revokerNodeID, &revokerNodeIDBufLen) )
+      return fhgfs_false;
+
+   bufPos += revokerNodeIDBufLen;
+
+   return fhgfs_true;
+}
+
+unsigned LeaseRevokedMsgEx_calcMessageLength(NetMessage* this)
+{
+   LeaseRevokedMsgEx* thisCast = (LeaseRevokedMsgEx*)this;
+
+   return NETMSG_HEADER_LENGTH +
+      Serialization_serialLenStrAlign4(thisCast->entryIDLen) +
+      Serialization_serialLenStrAlign4(thisCast->ackIDLen) +
+      Serialization_serialLenUShort(); // revokerNodeID
+}
+
+fhgfs_bool __LeaseRevokedMsgEx_processIncoming(NetMessage* this, struct App* app,
+   fhgfs_sockaddr_in* fromAddr, struct Socket* sock, char* respBuf, size_t bufLen)
+{
+   const char* logContext = "LeaseRevoked incoming";
+   Logger* log = App_getLogger(app);
+
+   LeaseRevokedMsgEx* thisCast = (LeaseRevokedMsgEx*)this;
+
+   struct super_block* sb = FhgfsOps_getSuperBlock(app);
+   const char* entryID = LeaseRevokedMsgEx_getEntryID(thisCast);
+   FhgfsInodeComparisonInfo comparisonInfo;
+   struct inode* inode;
+
+   #ifdef LOG_DEBUG_MESSAGES
+      const char* peer;
+
+      peer = fromAddr ?
+         SocketTk_ipaddrToStr(&fromAddr->addr) : StringTk_strDup(Socket_getPeername(sock) );
+      LOG_DEBUG_FORMATTED(log, Log_DEBUG, logContext, "Received a LeaseRevokedMsg from: %s",
+         peer);
+
+      os_kfree(peer);
+   #endif // LOG_DEBUG_MESSAGES
+
+   IGNORE_UNUSED_VARIABLE(log);
+   IGNORE_UNUSED_VARIABLE(logContext);
+
+   // find the inode (if it is not cached anymore, there is nothing to be revoked)
+
+   if(!strcmp(entryID, META_ROOTDIR_ID_STR) )
+      comparisonInfo.inodeHash = BEEGFS_INODE_ROOT_INO;
+   else
+      comparisonInfo.inodeHash = FhgfsInode_generateInodeID(sb, entryID,
+         thisCast->entryIDLen);
+
+   comparisonInfo.entryID = entryID;
+
+   inode = ilookup5(sb, comparisonInfo.inodeHash, __FhgfsOps_compareInodeID,
+      &comparisonInfo); // (ilookup5 calls iget() on match)
+   if(inode)
+   {
+      FhgfsInode_invalidateCache(BEEGFS_INODE(inode) ); // (also drops the lease)
+
+      iput(inode);
+   }
+
+   // note: we ack even if the inode was not found, so that the server doesn't need to resend
+
+   MsgHelperAck_respondToAckRequest(app, LeaseRevokedMsgEx_getAckID(thisCast), fromAddr, sock,
+      respBuf, bufLen);
+
+   return fhgfs_true;
+}
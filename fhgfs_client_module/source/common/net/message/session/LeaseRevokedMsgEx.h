@@ -0,0 +1,100 @@
+#ifndef LEASEREVOKEDMSGEX_H_
+#define LEASEREVOKEDMSGEX_H_
+
+#include <common/net/message/NetMessage.h>
+
+
+/**
+ * Sent by the metadata server when the dentry or attribs of an entry changed, for which we hold a
+ * lease. (The lease will be dropped and the next access will ask the server again.)
+ *
+ * This message is for deserialization (incoming) only, serialization is not implemented!
+ */
+
+
+struct LeaseRevokedMsgEx;
+typedef struct LeaseRevokedMsgEx LeaseRevokedMsgEx;
+
+static inline void LeaseRevokedMsgEx_init(LeaseRevokedMsgEx* this);
+static inline LeaseRevokedMsgEx* LeaseRevokedMsgEx_construct(void);
+static inline void LeaseRevokedMsgEx_uninit(NetMessage* this);
+static inline void LeaseRevokedMsgEx_destruct(NetMessage* this);
+
+// virtual functions
+extern void LeaseRevokedMsgEx_serializePayload(NetMessage* this, char* buf);
+extern fhgfs_bool LeaseRevokedMsgEx_deserializePayload(NetMessage* this, const char* buf,
+   size_t bufLen);
+extern unsigned LeaseRevokedMsgEx_calcMessageLength(NetMessage* this);
+extern fhgfs_bool __LeaseRevokedMsgEx_processIncoming(NetMessage* this, struct App* app,
+   fhgfs_sockaddr_in* fromAddr, struct Socket* sock, char* respBuf, size_t bufLen);
+
+// getters & setters
+static inline const char* LeaseRevokedMsgEx_getEntryID(LeaseRevokedMsgEx* this);
+static inline const char* LeaseRevokedMsgEx_getAckID(LeaseRevokedMsgEx* this);
+static inline uint16_t LeaseRevokedMsgEx_getRevokerNodeID(LeaseRevokedMsgEx* this);
+
+
+struct LeaseRevokedMsgEx
+{
+   NetMessage netMessage;
+
+   unsigned entryIDLen;
+   const char* entryID;
+   unsigned ackIDLen;
+   const char* ackID;
+   uint16_t revokerNodeID;
+};
+
+
+void LeaseRevokedMsgEx_init(LeaseRevokedMsgEx* this)
+{
+   NetMessage_init( (NetMessage*)this, NETMSGTYPE_LeaseRevoked);
+
+   // assign virtual functions
+   ( (NetMessage*)this)->uninit = LeaseRevokedMsgEx_uninit;
+
+   ( (NetMessage*)this)->serializePayload = LeaseRevokedMsgEx_serializePayload;
+   ( (NetMessage*)this)->deserializePayload = LeaseRevokedMsgEx_deserializePayload;
+   ( (NetMessage*)this)->calcMessageLength = LeaseRevokedMsgEx_calcMessageLength;
+
+   ( (NetMessage*)this)->processIncoming = __LeaseRevokedMsgEx_processIncoming;
+}
+
+LeaseRevokedMsgEx* LeaseRevokedMsgEx_construct(void)
+{
+   struct LeaseRevokedMsgEx* this = os_kmalloc(sizeof(*this) );
+
+   LeaseRevokedMsgEx_init(this);
+
+   return this;
+}
+
+void LeaseRevokedMsgEx_uninit(NetMessage* this)
+{
+   NetMessage_uninit(this);
+}
+
+void LeaseRevokedMsgEx_destruct(NetMessage* this)
+{
+   LeaseRevokedMsgEx_uninit(this);
+
+   os_kfree(this);
+}
+
+const char* LeaseRevokedMsgEx_getEntryID(LeaseRevokedMsgEx* this)
+{
+   return this->entryID;
+}
+
+const char* LeaseRevokedMsgEx_getAckID(LeaseRevokedMsgEx* this)
+{
+   return this->ackID;
+}
+
+uint16_t LeaseRevokedMsgEx_getRevokerNodeID(LeaseRevokedMsgEx* this)
+{
+   return this->revokerNodeID;
+}
+
+
+#endif /* LEASEREVOKEDMSGEX_H_ */
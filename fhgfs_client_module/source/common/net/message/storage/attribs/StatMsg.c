@@ -9,14 +9,25 @@ void StatMsg_serializePayload(NetMessage* this, char* buf)
 
    // entryInfo
    bufPos += EntryInfo_serialize(thisCast->entryInfoPtr, &buf[bufPos]);
+
+   if(NetMessage_isMsgHeaderCompatFeatureFlagSet(this, STATMSG_COMPAT_FLAG_LEASE) )
+   { // clientID
+      bufPos += Serialization_serializeStrAlign4(&buf[bufPos], thisCast->clientIDLen,
+         thisCast->clientID);
+   }
 }
 
 unsigned StatMsg_calcMessageLength(NetMessage* this)
 {
    StatMsg* thisCast = (StatMsg*)this;
 
-   return NETMSG_HEADER_LENGTH +
+   unsigned msgLength = NETMSG_HEADER_LENGTH +
       EntryInfo_serialLen(thisCast->entryInfoPtr); // entryInfo
+
+   if(NetMessage_isMsgHeaderCompatFeatureFlagSet(this, STATMSG_COMPAT_FLAG_LEASE) )
+      msgLength += Serialization_serialLenStrAlign4(thisCast->clientIDLen); // clientID
+
+   return msgLength;
 }
 
 
@@ -8,6 +8,8 @@
 //#define STATMSG_COMPAT_FLAG_GET_PARENTOWNERNODEID     1 /* deprecated */
 #define STATMSG_COMPAT_FLAG_GET_PARENTINFO            2 /* caller wants to have parentOwnerNodeID
                                                          * and parentEntryID */
+#define STATMSG_COMPAT_FLAG_LEASE                     4 /* caller wants a lease on the attribs
+                                                         * (msg includes clientID) */
 
 
 struct StatMsg;
@@ -20,6 +22,7 @@ static inline StatMsg* StatMsg_constructFromEntryInfo(const EntryInfo* entryInfo
 static inline void StatMsg_uninit(NetMessage* this);
 static inline void StatMsg_destruct(NetMessage* this);
 static inline void StatMsg_addParentInfoRequest(StatMsg* this);
+static inline void StatMsg_addLeaseRequest(StatMsg* this, const char* clientID);
 
 // virtual functions
 extern void StatMsg_serializePayload(NetMessage* this, char* buf);
@@ -32,6 +35,9 @@ struct StatMsg
    NetMessage netMessage;
 
    const EntryInfo* entryInfoPtr; // not owed by this object
+
+   unsigned clientIDLen; // (lease data)
+   const char* clientID; // (lease data), not owned by this object
 };
 
 
@@ -97,5 +103,19 @@ void StatMsg_addParentInfoRequest(StatMsg* this)
    NetMessage_addMsgHeaderCompatFeatureFlag(netMsg, STATMSG_COMPAT_FLAG_GET_PARENTINFO);
 }
 
+/**
+ * @param clientID our local nodeID, so that the server can revoke the lease; just a reference, so
+ * do not free it as long as you use this object!
+ */
+void StatMsg_addLeaseRequest(StatMsg* this, const char* clientID)
+{
+   NetMessage* netMsg =  (NetMessage*) this;
+
+   this->clientID = clientID;
+   this->clientIDLen = os_strlen(clientID);
+
+   NetMessage_addMsgHeaderCompatFeatureFlag(netMsg, STATMSG_COMPAT_FLAG_LEASE);
+}
+
 
 #endif /*STATMSG_H_*/
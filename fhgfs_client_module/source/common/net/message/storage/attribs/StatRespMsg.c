@@ -51,11 +51,22 @@ fhgfs_bool StatRespMsg_deserializePayload(NetMessage* this, const char* buf, siz
       }
    }
 
+   if(NetMessage_isMsgHeaderFeatureFlagSet(this, STATRESPMSG_FLAG_HAS_LEASE) )
+   { // leaseMS
+      unsigned fieldLen;
+
+      if(!Serialization_deserializeUInt(&buf[bufPos], bufLen-bufPos,
+         &thisCast->leaseMS, &fieldLen) )
+         return fhgfs_false;
+
+      bufPos += fieldLen;
+   }
+
 
    return fhgfs_true;
 }
 
 unsigned StatRespMsg_getSupportedHeaderFeatureFlagsMask(NetMessage* this)
 {
-   return STATRESPMSG_FLAG_HAS_PARENTINFO;
+   return STATRESPMSG_FLAG_HAS_PARENTINFO | STATRESPMSG_FLAG_HAS_LEASE;
 }
@@ -10,6 +10,8 @@
 
 #define STATRESPMSG_FLAG_HAS_PARENTINFO                  1 /* msg includes parentOwnerNodeID and
                                                               parentEntryID */
+#define STATRESPMSG_FLAG_HAS_LEASE                       2 /* msg includes leaseMS (only set if
+                                                              the caller requested a lease) */
 
 
 struct StatRespMsg;
@@ -29,6 +31,7 @@ extern unsigned StatRespMsg_getSupportedHeaderFeatureFlagsMask(NetMessage* this)
 // getters & setters
 static inline int StatRespMsg_getResult(StatRespMsg* this);
 static inline StatData* StatRespMsg_getStatData(StatRespMsg* this);
+static inline unsigned StatRespMsg_getLeaseMS(StatRespMsg* this);
 
 struct StatRespMsg
 {
@@ -39,6 +42,8 @@ struct StatRespMsg
 
    const char* parentEntryID;
    uint16_t parentNodeID;
+
+   unsigned leaseMS; // 0 if no lease was granted
 };
 
 
@@ -58,6 +63,7 @@ void StatRespMsg_init(StatRespMsg* this)
 
    this->parentNodeID = 0;
    this->parentEntryID = NULL;
+   this->leaseMS = 0;
 }
    
 StatRespMsg* StatRespMsg_construct(void)
@@ -93,6 +99,11 @@ StatData* StatRespMsg_getStatData(StatRespMsg* this)
    return &this->statData;
 }
 
+unsigned StatRespMsg_getLeaseMS(StatRespMsg* this)
+{
+   return this->leaseMS;
+}
+
 /**
  * Get parentInfo
  *
@@ -0,0 +1,28 @@
+#include "ListDirPlusMsg.h"
+
+
+void ListDirPlusMsg_serializePayload(NetMessage* this, char* buf)
+{
+   ListDirPlusMsg* thisCast = (ListDirPlusMsg*)this;
+
+   size_t bufPos = 0;
+
+   // serverOffset
+   bufPos += Serialization_serializeInt64(&buf[bufPos], thisCast->serverOffset);
+
+   // maxOutNames
+   bufPos += Serialization_serializeUInt(&buf[bufPos], thisCast->maxOutNames);
+
+   // EntryInfo
+   bufPos += EntryInfo_serialize(thisCast->entryInfoPtr, &buf[bufPos]);
+}
+
+unsigned ListDirPlusMsg_calcMessageLength(NetMessage* this)
+{
+   ListDirPlusMsg* thisCast = (ListDirPlusMsg*)this;
+
+   return NETMSG_HEADER_LENGTH +
+      EntryInfo_serialLen(thisCast->entryInfoPtr) +
+      Serialization_serialLenInt64() + // serverOffset
+      Serialization_serialLenUInt(); // maxOutNames
+}
@@ -0,0 +1,108 @@
+#ifndef LISTDIRPLUSMSG_H_
+#define LISTDIRPLUSMSG_H_
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/Path.h>
+#include <common/storage/EntryInfo.h>
+
+/**
+ * Incremental dir listing with owner info and stat data of each entry ("readdir-plus").
+ * "." and ".." are included, but without owner info and stat data.
+ *
+ * This message supports only serialization. (deserialization not implemented)
+ */
+
+struct ListDirPlusMsg;
+typedef struct ListDirPlusMsg ListDirPlusMsg;
+
+static inline void ListDirPlusMsg_init(ListDirPlusMsg* this);
+static inline void ListDirPlusMsg_initFromEntryInfo(ListDirPlusMsg* this,
+   const EntryInfo* entryInfo, int64_t serverOffset, unsigned maxOutNames);
+static inline ListDirPlusMsg* ListDirPlusMsg_construct(void);
+static inline ListDirPlusMsg* ListDirPlusMsg_constructFromEntryInfo
+(EntryInfo *entryInfo, int64_t serverOffset, unsigned maxOutNames);
+static inline void ListDirPlusMsg_uninit(NetMessage* this);
+static inline void ListDirPlusMsg_destruct(NetMessage* this);
+
+// virtual functions
+extern void ListDirPlusMsg_serializePayload(NetMessage* this, char* buf);
+extern unsigned ListDirPlusMsg_calcMessageLength(NetMessage* this);
+
+
+
+struct ListDirPlusMsg
+{
+   NetMessage netMessage;
+
+   int64_t serverOffset;
+   unsigned maxOutNames;
+
+   // for serialization
+   const EntryInfo* entryInfoPtr; // not owned by this object!
+};
+
+
+void ListDirPlusMsg_init(ListDirPlusMsg* this)
+{
+   NetMessage_init( (NetMessage*)this, NETMSGTYPE_ListDirPlus);
+
+   // assign virtual functions
+   ( (NetMessage*)this)->uninit = ListDirPlusMsg_uninit;
+
+   ( (NetMessage*)this)->serializePayload = ListDirPlusMsg_serializePayload;
+   ( (NetMessage*)this)->deserializePayload = _NetMessage_deserializeDummy;
+   ( (NetMessage*)this)->calcMessageLength = ListDirPlusMsg_calcMessageLength;
+}
+
+/**
+ * @param entryInfo just a reference, so do not free it as long as you use this object!
+ */
+void ListDirPlusMsg_initFromEntryInfo(ListDirPlusMsg* this, const EntryInfo* entryInfo,
+   int64_t serverOffset, unsigned maxOutNames)
+{
+   ListDirPlusMsg_init(this);
+
+   this->entryInfoPtr = entryInfo;
+
+   this->serverOffset = serverOffset;
+
+   this->maxOutNames = maxOutNames;
+}
+
+ListDirPlusMsg* ListDirPlusMsg_construct(void)
+{
+   struct ListDirPlusMsg* this = os_kmalloc(sizeof(*this) );
+
+   if(likely(this) )
+      ListDirPlusMsg_init(this);
+
+   return this;
+}
+
+/**
+ * @param entryInfo just a reference, so do not free it as long as you use this object!
+ */
+ListDirPlusMsg* ListDirPlusMsg_constructFromEntryInfo(EntryInfo* entryInfo,
+   int64_t serverOffset, unsigned maxOutNames)
+{
+   struct ListDirPlusMsg* this = os_kmalloc(sizeof(*this) );
+
+   if(likely(this) )
+      ListDirPlusMsg_initFromEntryInfo(this, entryInfo, serverOffset, maxOutNames);
+
+   return this;
+}
+
+void ListDirPlusMsg_uninit(NetMessage* this)
+{
+   NetMessage_uninit( (NetMessage*)this);
+}
+
+void ListDirPlusMsg_destruct(NetMessage* this)
+{
+   ListDirPlusMsg_uninit( (NetMessage*)this);
+
+   os_kfree(this);
+}
+
+#endif /*LISTDIRPLUSMSG_H_*/
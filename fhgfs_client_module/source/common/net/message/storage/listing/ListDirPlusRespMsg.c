@@ -0,0 +1,187 @@
+#include "ListDirPlusRespMsg.h"
+
+
+static fhgfs_bool __ListDirPlusRespMsg_deserializeStatDatasPreprocess(const char* buf,
+   size_t bufLen, unsigned* outElemNum, const char** outListStart, unsigned* outLen);
+
+
+fhgfs_bool ListDirPlusRespMsg_deserializePayload(NetMessage* this, const char* buf,
+   size_t bufLen)
+{
+   const char* logContext = "ListDirPlusRespMsg deserialization";
+   ListDirPlusRespMsg* thisCast = (ListDirPlusRespMsg*)this;
+
+   size_t bufPos = 0;
+
+   unsigned resultFieldLen;
+   unsigned newServerOffsetBufLen;
+
+   {  // newServerOffset
+      if(!Serialization_deserializeInt64(&buf[bufPos], bufLen-bufPos,
+         &thisCast->newServerOffset, &newServerOffsetBufLen) )
+         return fhgfs_false;
+
+      bufPos += newServerOffsetBufLen;
+   }
+
+   {  // serverOffsets
+      if(!Serialization_deserializeInt64CpyVecPreprocess(&buf[bufPos], bufLen-bufPos,
+         &thisCast->serverOffsetsElemNum, &thisCast->serverOffsetsListStart,
+         &thisCast->serverOffsetsBufLen) )
+         return fhgfs_false;
+
+      bufPos += thisCast->serverOffsetsBufLen;
+   }
+
+   {  // result
+      if(!Serialization_deserializeInt(&buf[bufPos], bufLen-bufPos, &thisCast->result,
+         &resultFieldLen) )
+         return fhgfs_false;
+
+      bufPos += resultFieldLen;
+   }
+
+   {  // entryTypes
+      if(!Serialization_deserializeUInt8VecPreprocess(&buf[bufPos], bufLen-bufPos,
+         &thisCast->entryTypesElemNum, &thisCast->entryTypesListStart, &thisCast->entryTypesBufLen) )
+         return fhgfs_false;
+
+      bufPos += thisCast->entryTypesBufLen;
+   }
+
+   {  // entryIDs
+      if (!Serialization_deserializeStrCpyVecPreprocess(&buf[bufPos], bufLen-bufPos,
+         &thisCast->entryIDsElemNum, &thisCast->entryIDsListStart, &thisCast->entryIDsBufLen) )
+         return fhgfs_false;
+
+      bufPos += thisCast->entryIDsBufLen;
+   }
+
+   {  // names
+      if(!Serialization_deserializeStrCpyVecPreprocess(&buf[bufPos], bufLen-bufPos,
+         &thisCast->namesElemNum, &thisCast->namesListStart, &thisCast->namesBufLen) )
+         return fhgfs_false;
+
+      bufPos += thisCast->namesBufLen;
+   }
+
+   {  // ownerNodeIDs
+      if(!Serialization_deserializeUInt16VecPreprocess(&buf[bufPos], bufLen-bufPos,
+         &thisCast->ownerNodeIDsElemNum, &thisCast->ownerNodeIDsListStart,
+         &thisCast->ownerNodeIDsBufLen) )
+         return fhgfs_false;
+
+      bufPos += thisCast->ownerNodeIDsBufLen;
+   }
+
+   {  // entryFlags
+      if(!Serialization_deserializeIntCpyVecPreprocess(&buf[bufPos], bufLen-bufPos,
+         &thisCast->entryFlagsElemNum, &thisCast->entryFlagsListStart,
+         &thisCast->entryFlagsBufLen) )
+         return fhgfs_false;
+
+      bufPos += thisCast->entryFlagsBufLen;
+   }
+
+   {  // statResults
+      if(!Serialization_deserializeIntCpyVecPreprocess(&buf[bufPos], bufLen-bufPos,
+         &thisCast->statResultsElemNum, &thisCast->statResultsListStart,
+         &thisCast->statResultsBufLen) )
+         return fhgfs_false;
+
+      bufPos += thisCast->statResultsBufLen;
+   }
+
+   {  // statDatas
+      if(!__ListDirPlusRespMsg_deserializeStatDatasPreprocess(&buf[bufPos], bufLen-bufPos,
+         &thisCast->statDatasElemNum, &thisCast->statDatasListStart,
+         &thisCast->statDatasBufLen) )
+         return fhgfs_false;
+
+      bufPos += thisCast->statDatasBufLen;
+   }
+
+   // sanity check for equal list lengths
+   if(unlikely(
+      (thisCast->entryTypesElemNum != thisCast->namesElemNum) ||
+      (thisCast->entryTypesElemNum != thisCast->entryIDsElemNum) ||
+      (thisCast->entryTypesElemNum != thisCast->serverOffsetsElemNum) ||
+      (thisCast->entryTypesElemNum != thisCast->ownerNodeIDsElemNum) ||
+      (thisCast->entryTypesElemNum != thisCast->entryFlagsElemNum) ||
+      (thisCast->entryTypesElemNum != thisCast->statResultsElemNum) ||
+      (thisCast->entryTypesElemNum != thisCast->statDatasElemNum) ) )
+   {
+      printk_fhgfs(KERN_INFO, "%s: Sanity check failed (number of list elements does not match)!\n",
+         logContext);
+      return fhgfs_false;
+   }
+
+
+   return fhgfs_true;
+}
+
+/**
+ * The stat data list has the same bufLen and elemNum header as the fixed-size lists.
+ */
+fhgfs_bool __ListDirPlusRespMsg_deserializeStatDatasPreprocess(const char* buf, size_t bufLen,
+   unsigned* outElemNum, const char** outListStart, unsigned* outLen)
+{
+   const size_t headerLen = Serialization_serialLenUInt() + Serialization_serialLenUInt();
+
+   size_t bufPos = 0;
+   unsigned fieldLen;
+
+   // totalBufLen info field
+   if(!Serialization_deserializeUInt(&buf[bufPos], bufLen-bufPos, outLen, &fieldLen) )
+      return fhgfs_false;
+
+   bufPos += fieldLen;
+
+   // elem count info field
+   if(!Serialization_deserializeUInt(&buf[bufPos], bufLen-bufPos, outElemNum, &fieldLen) )
+      return fhgfs_false;
+
+   bufPos += fieldLen;
+
+   *outListStart = &buf[bufPos];
+
+   if(unlikely( (*outLen > bufLen) || (*outLen < headerLen) ) )
+      return fhgfs_false;
+
+   return fhgfs_true;
+}
+
+/**
+ * Deserialize the stat data of all entries and convert it to fhgfs_stat.
+ *
+ * @param outStats array with at least numStats elements
+ * @param numStats must be equal to ListDirPlusRespMsg_getNumEntries()
+ * @return fhgfs_false on inconsistency
+ */
+fhgfs_bool ListDirPlusRespMsg_parseStatDatas(ListDirPlusRespMsg* this, fhgfs_stat* outStats,
+   size_t numStats)
+{
+   const size_t headerLen = Serialization_serialLenUInt() + Serialization_serialLenUInt();
+   size_t bufLen = this->statDatasBufLen - headerLen;
+   size_t bufPos = 0;
+   size_t i;
+
+   if(unlikely(numStats != this->statDatasElemNum) )
+      return fhgfs_false;
+
+   for(i=0; i < numStats; i++)
+   {
+      StatData statData;
+      unsigned statDataLen;
+
+      if(unlikely(!StatData_deserialize(&this->statDatasListStart[bufPos], bufLen-bufPos,
+         &statData, &statDataLen) ) )
+         return fhgfs_false;
+
+      bufPos += statDataLen;
+
+      StatData_getOsStat(&statData, &outStats[i]);
+   }
+
+   return fhgfs_true;
+}
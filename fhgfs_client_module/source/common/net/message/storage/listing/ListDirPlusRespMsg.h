@@ -0,0 +1,193 @@
+#ifndef LISTDIRPLUSRESPMSG_H_
+#define LISTDIRPLUSRESPMSG_H_
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/StatData.h>
+#include <common/Common.h>
+
+
+struct ListDirPlusRespMsg;
+typedef struct ListDirPlusRespMsg ListDirPlusRespMsg;
+
+static inline void ListDirPlusRespMsg_init(ListDirPlusRespMsg* this);
+static inline ListDirPlusRespMsg* ListDirPlusRespMsg_construct(void);
+static inline void ListDirPlusRespMsg_uninit(NetMessage* this);
+static inline void ListDirPlusRespMsg_destruct(NetMessage* this);
+
+// virtual functions
+extern fhgfs_bool ListDirPlusRespMsg_deserializePayload(NetMessage* this, const char* buf,
+   size_t bufLen);
+
+// public
+extern fhgfs_bool ListDirPlusRespMsg_parseStatDatas(ListDirPlusRespMsg* this,
+   fhgfs_stat* outStats, size_t numStats);
+
+// inliners
+static inline void ListDirPlusRespMsg_parseNames(ListDirPlusRespMsg* this,
+   StrCpyVec* outNames);
+static inline void ListDirPlusRespMsg_parseEntryIDs(ListDirPlusRespMsg* this,
+   StrCpyVec* outEntryIDs);
+static inline void ListDirPlusRespMsg_parseEntryTypes(ListDirPlusRespMsg* this,
+   UInt8Vec* outEntryTypes);
+static inline void ListDirPlusRespMsg_parseServerOffsets(ListDirPlusRespMsg* this,
+   Int64CpyVec* outServerOffsets);
+static inline void ListDirPlusRespMsg_parseOwnerNodeIDs(ListDirPlusRespMsg* this,
+   UInt16Vec* outOwnerNodeIDs);
+static inline void ListDirPlusRespMsg_parseEntryFlags(ListDirPlusRespMsg* this,
+   IntCpyVec* outEntryFlags);
+static inline void ListDirPlusRespMsg_parseStatResults(ListDirPlusRespMsg* this,
+   IntCpyVec* outStatResults);
+
+// getters & setters
+static inline int ListDirPlusRespMsg_getResult(ListDirPlusRespMsg* this);
+static inline uint64_t ListDirPlusRespMsg_getNewServerOffset(ListDirPlusRespMsg* this);
+static inline unsigned ListDirPlusRespMsg_getNumEntries(ListDirPlusRespMsg* this);
+
+
+/**
+ * Note: Only deserialization supported, no serialization.
+ */
+struct ListDirPlusRespMsg
+{
+   NetMessage netMessage;
+
+   int result;
+
+   int64_t newServerOffset;
+
+   // for deserialization
+   unsigned namesElemNum;
+   const char* namesListStart;
+   unsigned namesBufLen;
+
+   unsigned entryTypesElemNum;
+   const char* entryTypesListStart;
+   unsigned entryTypesBufLen;
+
+   unsigned entryIDsElemNum;
+   const char* entryIDsListStart;
+   unsigned entryIDsBufLen;
+
+   unsigned serverOffsetsElemNum;
+   const char* serverOffsetsListStart;
+   unsigned serverOffsetsBufLen;
+
+   unsigned ownerNodeIDsElemNum;
+   const char* ownerNodeIDsListStart;
+   unsigned ownerNodeIDsBufLen;
+
+   unsigned entryFlagsElemNum;
+   const char* entryFlagsListStart;
+   unsigned entryFlagsBufLen;
+
+   unsigned statResultsElemNum;
+   const char* statResultsListStart;
+   unsigned statResultsBufLen;
+
+   unsigned statDatasElemNum;
+   const char* statDatasListStart;
+   unsigned statDatasBufLen;
+};
+
+
+void ListDirPlusRespMsg_init(ListDirPlusRespMsg* this)
+{
+   NetMessage_init( (NetMessage*)this, NETMSGTYPE_ListDirPlusResp);
+
+   // assign virtual functions
+   ( (NetMessage*)this)->uninit = ListDirPlusRespMsg_uninit;
+
+   ( (NetMessage*)this)->serializePayload = _NetMessage_serializeDummy;
+   ( (NetMessage*)this)->deserializePayload = ListDirPlusRespMsg_deserializePayload;
+   ( (NetMessage*)this)->calcMessageLength = _NetMessage_calcMessageLengthDummy;
+}
+
+ListDirPlusRespMsg* ListDirPlusRespMsg_construct(void)
+{
+   struct ListDirPlusRespMsg* this = os_kmalloc(sizeof(*this) );
+
+   if(likely(this) )
+      ListDirPlusRespMsg_init(this);
+
+   return this;
+}
+
+void ListDirPlusRespMsg_uninit(NetMessage* this)
+{
+   NetMessage_uninit( (NetMessage*)this);
+}
+
+void ListDirPlusRespMsg_destruct(NetMessage* this)
+{
+   ListDirPlusRespMsg_uninit( (NetMessage*)this);
+
+   os_kfree(this);
+}
+
+
+void ListDirPlusRespMsg_parseEntryIDs(ListDirPlusRespMsg* this, StrCpyVec* outEntryIDs)
+{
+   Serialization_deserializeStrCpyVec(
+      this->entryIDsBufLen, this->entryIDsElemNum, this->entryIDsListStart, outEntryIDs);
+}
+
+void ListDirPlusRespMsg_parseNames(ListDirPlusRespMsg* this, StrCpyVec* outNames)
+{
+   Serialization_deserializeStrCpyVec(
+      this->namesBufLen, this->namesElemNum, this->namesListStart, outNames);
+}
+
+void ListDirPlusRespMsg_parseEntryTypes(ListDirPlusRespMsg* this, UInt8Vec* outEntryTypes)
+{
+   Serialization_deserializeUInt8Vec(
+      this->entryTypesBufLen, this->entryTypesElemNum, this->entryTypesListStart, outEntryTypes);
+}
+
+void ListDirPlusRespMsg_parseServerOffsets(ListDirPlusRespMsg* this,
+   Int64CpyVec* outServerOffsets)
+{
+   Serialization_deserializeInt64CpyVec(
+      this->serverOffsetsBufLen, this->serverOffsetsElemNum, this->serverOffsetsListStart,
+      outServerOffsets);
+}
+
+void ListDirPlusRespMsg_parseOwnerNodeIDs(ListDirPlusRespMsg* this, UInt16Vec* outOwnerNodeIDs)
+{
+   Serialization_deserializeUInt16Vec(
+      this->ownerNodeIDsBufLen, this->ownerNodeIDsElemNum, this->ownerNodeIDsListStart,
+      outOwnerNodeIDs);
+}
+
+void ListDirPlusRespMsg_parseEntryFlags(ListDirPlusRespMsg* this, IntCpyVec* outEntryFlags)
+{
+   Serialization_deserializeIntCpyVec(
+      this->entryFlagsBufLen, this->entryFlagsElemNum, this->entryFlagsListStart, outEntryFlags);
+}
+
+void ListDirPlusRespMsg_parseStatResults(ListDirPlusRespMsg* this, IntCpyVec* outStatResults)
+{
+   Serialization_deserializeIntCpyVec(
+      this->statResultsBufLen, this->statResultsElemNum, this->statResultsListStart,
+      outStatResults);
+}
+
+int ListDirPlusRespMsg_getResult(ListDirPlusRespMsg* this)
+{
+   return this->result;
+}
+
+uint64_t ListDirPlusRespMsg_getNewServerOffset(ListDirPlusRespMsg* this)
+{
+   return this->newServerOffset;
+}
+
+/**
+ * @return number of entries in this response (all lists have the same length)
+ */
+unsigned ListDirPlusRespMsg_getNumEntries(ListDirPlusRespMsg* this)
+{
+   return this->namesElemNum;
+}
+
+
+#endif /*LISTDIRPLUSRESPMSG_H_*/
@@ -52,6 +52,13 @@ void LookupIntentMsg_serializePayload(NetMessage* this, char* buf)
       bufPos += Serialization_serializeUInt16List(&buf[bufPos], thisCast->preferredTargets);
    }
 
+   if(thisCast->intentFlags & LOOKUPINTENTMSG_FLAG_LEASE)
+   {
+      // clientID
+      bufPos += Serialization_serializeStrAlign4(&buf[bufPos], thisCast->clientIDLen,
+         thisCast->clientID);
+   }
+
 }
 
 unsigned LookupIntentMsg_calcMessageLength(NetMessage* this)
@@ -84,6 +91,9 @@ unsigned LookupIntentMsg_calcMessageLength(NetMessage* this)
       msgLength += Serialization_serialLenUInt16List(thisCast->preferredTargets); // preferredTargets
    }
 
+   if(thisCast->intentFlags & LOOKUPINTENTMSG_FLAG_LEASE)
+      msgLength += Serialization_serialLenStrAlign4(thisCast->clientIDLen); // clientID
+
    return msgLength;
 }
 
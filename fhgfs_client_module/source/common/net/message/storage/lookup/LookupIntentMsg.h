@@ -18,6 +18,7 @@
 #define LOOKUPINTENTMSG_FLAG_CREATEEXCLUSIVE    4 /* exclusive file creation */
 #define LOOKUPINTENTMSG_FLAG_OPEN               8 /* open file */
 #define LOOKUPINTENTMSG_FLAG_STAT              16 /* stat file */
+#define LOOKUPINTENTMSG_FLAG_LEASE             32 /* request lease on dentry and attribs */
 
 
 // feature flags as header flags
@@ -53,6 +54,7 @@ static inline void LookupIntentMsg_addIntentCreateExclusive(LookupIntentMsg* thi
 static inline void LookupIntentMsg_addIntentOpen(LookupIntentMsg* this, const char* sessionID,
    unsigned accessFlags);
 static inline void LookupIntentMsg_addIntentStat(LookupIntentMsg* this);
+static inline void LookupIntentMsg_addIntentLease(LookupIntentMsg* this, const char* clientID);
 
 
 struct LookupIntentMsg
@@ -75,6 +77,9 @@ struct LookupIntentMsg
    const char* sessionID; // (file open data)
    unsigned accessFlags; // OPENFILE_ACCESS_... flags (file open data)
 
+   unsigned clientIDLen; // (lease data)
+   const char* clientID; // (lease data)
+
    // for serialization
    const EntryInfo* parentInfoPtr; // not owned by this object (lookup/open/creation data)
    UInt16List* preferredTargets; // not owned by this object! (file creation data)
@@ -210,6 +215,20 @@ void LookupIntentMsg_addIntentStat(LookupIntentMsg* this)
    this->intentFlags |= LOOKUPINTENTMSG_FLAG_STAT;
 }
 
+/**
+ * Note: Only useful in combination with revalidate and stat intent.
+ *
+ * @param clientID our local nodeID, so that the server can revoke the lease; just a reference, so
+ * do not free it as long as you use this object!
+ */
+void LookupIntentMsg_addIntentLease(LookupIntentMsg* this, const char* clientID)
+{
+   this->intentFlags |= LOOKUPINTENTMSG_FLAG_LEASE;
+
+   this->clientID = clientID;
+   this->clientIDLen = os_strlen(clientID);
+}
+
 
 
 #endif /* LOOKUPINTENTMSG_H_ */
@@ -10,6 +10,7 @@ fhgfs_bool LookupIntentRespMsg_deserializePayload(NetMessage* this, const char*
    // pre-initialize
    thisCast->lookupResult = FhgfsOpsErr_INTERNAL;
    thisCast->createResult = FhgfsOpsErr_INTERNAL;
+   thisCast->leaseMS = 0;
 
    { // responseFlags
       unsigned responseFlagsBufLen;
@@ -161,6 +162,17 @@ fhgfs_bool LookupIntentRespMsg_deserializePayload(NetMessage* this, const char*
       bufPos += entryBufLen;
    }
 
+   if(thisCast->responseFlags & LOOKUPINTENTRESPMSG_FLAG_LEASE)
+   { // leaseMS
+      unsigned leaseMSFieldLen;
+
+      if(!Serialization_deserializeUInt(&buf[bufPos], bufLen-bufPos,
+         &thisCast->leaseMS, &leaseMSFieldLen) )
+         return fhgfs_false;
+
+      bufPos += leaseMSFieldLen;
+   }
+
 
    return fhgfs_true;
 }
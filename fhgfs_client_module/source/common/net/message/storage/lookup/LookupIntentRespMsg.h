@@ -21,6 +21,7 @@
 #define LOOKUPINTENTRESPMSG_FLAG_CREATE             2 /* create file response */
 #define LOOKUPINTENTRESPMSG_FLAG_OPEN               4 /* open file response */
 #define LOOKUPINTENTRESPMSG_FLAG_STAT               8 /* stat file response */
+#define LOOKUPINTENTRESPMSG_FLAG_LEASE             16 /* lease granted (only if entry was found) */
 
 
 struct LookupIntentRespMsg;
@@ -52,6 +53,8 @@ static inline FhgfsOpsErr LookupIntentRespMsg_getCreateResult(LookupIntentRespMs
 static inline FhgfsOpsErr LookupIntentRespMsg_getStatResult(LookupIntentRespMsg* this);
 static inline StatData* LookupIntentRespMsg_getStatData(LookupIntentRespMsg* this);
 
+static inline unsigned LookupIntentRespMsg_getLeaseMS(LookupIntentRespMsg* this);
+
 static inline void LookupIntentRespMsg_toEntryInfo(LookupIntentRespMsg* this, EntryInfo*
    outEntryInfo);
 static inline void LookupIntentRespMsg_toPathInfo(LookupIntentRespMsg* this, PathInfo* outPathInfo);
@@ -77,6 +80,8 @@ struct LookupIntentRespMsg
    unsigned fileHandleIDLen;
    const char* fileHandleID;
 
+   unsigned leaseMS; // duration of the granted lease
+
    // for deserialization
    struct StripePatternHeader patternHeader; // (open file data)
    const char* patternStart; // (open file data)
@@ -164,6 +169,11 @@ StatData* LookupIntentRespMsg_getStatData(LookupIntentRespMsg* this)
    return &this->statData;
 }
 
+unsigned LookupIntentRespMsg_getLeaseMS(LookupIntentRespMsg* this)
+{
+   return this->leaseMS;
+}
+
 
 /**
  * Initialize EntryInfo with values from LookupIntentRespMsg
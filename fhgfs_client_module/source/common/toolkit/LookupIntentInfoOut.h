@@ -60,6 +60,8 @@ struct LookupIntentInfoOut
    PathInfo pathInfo;
 
    StripePattern* stripePattern;
+
+   unsigned leaseMS; // 0 if no lease was granted
 };
 
 
@@ -79,6 +81,8 @@ static inline void LookupIntentInfoOut_prepare(LookupIntentInfoOut* this,
    this->openRes   = FhgfsOpsErr_INTERNAL;
 
    this->stripePattern = NULL;
+
+   this->leaseMS = 0;
 }
 
 void LookupIntentInfoOut_initFromRespMsg(LookupIntentInfoOut* this,
@@ -111,6 +115,9 @@ void LookupIntentInfoOut_initFromRespMsg(LookupIntentInfoOut* this,
    if (respMsg->lookupResult == FhgfsOpsErr_SUCCESS || respMsg->createResult == FhgfsOpsErr_SUCCESS)
       EntryInfo_dup(&respMsg->entryInfo, this->entryInfoPtr);
 
+   if (respMsg->responseFlags & LOOKUPINTENTRESPMSG_FLAG_LEASE)
+      this->leaseMS = respMsg->leaseMS;
+
 
    // only provided by the server on open
    if (respMsg->responseFlags & LOOKUPINTENTRESPMSG_FLAG_OPEN)
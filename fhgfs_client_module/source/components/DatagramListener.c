@@ -97,6 +97,7 @@ void _DatagramListener_handleIncomingMsg(DatagramListener* this,
       case NETMSGTYPE_MapTargets:
       case NETMSGTYPE_RemoveNode:
       case NETMSGTYPE_LockGranted:
+      case NETMSGTYPE_LeaseRevoked:
       case NETMSGTYPE_RefreshTargetStates:
       case NETMSGTYPE_SetMirrorBuddyGroup:
       {
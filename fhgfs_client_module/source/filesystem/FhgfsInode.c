@@ -43,6 +43,12 @@ void FhgfsInode_allocInit(FhgfsInode* fhgfsInode)
    memset(&fhgfsInode->pathInfo, 0, sizeof(fhgfsInode->pathInfo) );
 
    Time_init(&fhgfsInode->dataCacheTime);
+   Time_initZero(&fhgfsInode->attribCacheTime);
+
+   Time_initZero(&fhgfsInode->leaseTime);
+   fhgfsInode->leaseMS = 0;
+   fhgfsInode->leaseVersion = 0;
+   fhgfsInode->leaseCoversDentry = fhgfs_false;
 
    memset(&fhgfsInode->fileHandles, 0, sizeof(fhgfsInode->fileHandles) );
 
@@ -88,6 +94,8 @@ void FhgfsInode_destroyUninit(FhgfsInode* fhgfsInode)
    PathInfo_uninit(&fhgfsInode->pathInfo);
 
    Time_uninit(&fhgfsInode->dataCacheTime);
+   Time_uninit(&fhgfsInode->attribCacheTime);
+   Time_uninit(&fhgfsInode->leaseTime);
 
    SAFE_DESTRUCT_NOSET(fhgfsInode->pattern, StripePattern_virtualDestruct);
 
@@ -577,3 +585,103 @@ fhgfs_bool FhgfsInode_isCacheValid(FhgfsInode* this, umode_t i_mode, Config* cfg
 
    return cacheValid;
 }
+
+/**
+ * Check whether the attribs of this inode were recently primed by a readdir-plus, so that a
+ * revalidate does not need to ask the metadata server again.
+ */
+fhgfs_bool FhgfsInode_isAttribCacheValid(FhgfsInode* this, Config* cfg)
+{
+   unsigned cacheValidityMS = Config_getTuneAttribCacheValidityMS(cfg);
+
+   if(!cacheValidityMS || Time_getIsZero(&this->attribCacheTime) )
+      return fhgfs_false;
+
+   return cacheValidityMS > Time_elapsedMS(&this->attribCacheTime);
+}
+
+/**
+ * Get the lease version, which must be passed to FhgfsInode_setLease() for a lease that is
+ * requested after this call.
+ */
+unsigned FhgfsInode_getLeaseVersion(FhgfsInode* this)
+{
+   struct inode* inode = BEEGFS_VFSINODE(this);
+   unsigned leaseVersion;
+
+   spin_lock(&inode->i_lock); // L O C K
+
+   leaseVersion = this->leaseVersion;
+
+   spin_unlock(&inode->i_lock); // U N L O C K
+
+   return leaseVersion;
+}
+
+/**
+ * Remember a lease that was granted by the metadata server.
+ *
+ * Note: The lease is ignored if it was revoked while the request was in flight, because the
+ * server might have sent the revocation before it processed our request.
+ *
+ * @param leaseVersion value of FhgfsInode_getLeaseVersion() before the request was sent.
+ * @param requestTime time before the request was sent (the server counts the lease duration
+ *    from the time it received the request, so this is the safe side).
+ * @param leaseMS lease duration from the server response (0 if no lease was granted).
+ */
+void FhgfsInode_setLease(FhgfsInode* this, unsigned leaseVersion, Time* requestTime,
+   unsigned leaseMS, fhgfs_bool coversDentry)
+{
+   struct inode* inode = BEEGFS_VFSINODE(this);
+
+   if(!leaseMS)
+      return;
+
+   spin_lock(&inode->i_lock); // L O C K
+
+   if(leaseVersion == this->leaseVersion)
+   {
+      Time_setFromOther(&this->leaseTime, requestTime);
+      this->leaseMS = leaseMS;
+      this->leaseCoversDentry = coversDentry;
+   }
+
+   spin_unlock(&inode->i_lock); // U N L O C K
+}
+
+/**
+ * Forget the current lease (if any) and make sure that leases of requests that are currently in
+ * flight will be ignored.
+ */
+void FhgfsInode_revokeLease(FhgfsInode* this)
+{
+   struct inode* inode = BEEGFS_VFSINODE(this);
+
+   spin_lock(&inode->i_lock); // L O C K
+
+   this->leaseVersion++;
+   this->leaseMS = 0;
+
+   spin_unlock(&inode->i_lock); // U N L O C K
+}
+
+/**
+ * Check whether we hold a lease, so that cached attribs (and optionally the dentry) can be used
+ * without asking the metadata server.
+ *
+ * @param needDentry fhgfs_true if the lease must also cover the dentry (e.g. for revalidate).
+ */
+fhgfs_bool FhgfsInode_isLeaseValid(FhgfsInode* this, fhgfs_bool needDentry)
+{
+   struct inode* inode = BEEGFS_VFSINODE(this);
+   fhgfs_bool leaseValid = fhgfs_false;
+
+   spin_lock(&inode->i_lock); // L O C K
+
+   if(this->leaseMS && (this->leaseCoversDentry || !needDentry) )
+      leaseValid = this->leaseMS > Time_elapsedMS(&this->leaseTime);
+
+   spin_unlock(&inode->i_lock); // U N L O C K
+
+   return leaseValid;
+}
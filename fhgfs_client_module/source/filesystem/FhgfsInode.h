@@ -124,6 +124,13 @@ extern uint64_t FhgfsInode_generateInodeID(struct super_block* sb, const char* e
    int entryIDLen);
 
 extern fhgfs_bool FhgfsInode_isCacheValid(FhgfsInode* this, umode_t i_mode, Config* cfg);
+extern fhgfs_bool FhgfsInode_isAttribCacheValid(FhgfsInode* this, Config* cfg);
+
+extern unsigned FhgfsInode_getLeaseVersion(FhgfsInode* this);
+extern void FhgfsInode_setLease(FhgfsInode* this, unsigned leaseVersion, Time* requestTime,
+   unsigned leaseMS, fhgfs_bool coversDentry);
+extern void FhgfsInode_revokeLease(FhgfsInode* this);
+extern fhgfs_bool FhgfsInode_isLeaseValid(FhgfsInode* this, fhgfs_bool needDentry);
 
 
 // private extern
@@ -239,6 +246,15 @@ struct FhgfsInode
 
    Time dataCacheTime; /* last time we updated file contents (monotonic clock) or dir attribs;
                           protected by i_lock */
+   Time attribCacheTime; /* last time attribs were primed by a readdir-plus (monotonic clock), zero
+                            if not primed or invalidated; protected by i_lock */
+
+   Time leaseTime; /* send time of the request that got the current lease (monotonic clock);
+                      protected by i_lock */
+   unsigned leaseMS; // duration of the current lease, 0 if none; protected by i_lock
+   unsigned leaseVersion; // increased on each lease revocation; protected by i_lock
+   fhgfs_bool leaseCoversDentry; /* fhgfs_true if the lease also covers the dentry (not only the
+                                    attribs); protected by i_lock */
 
    Mutex fileHandlesMutex;
    FhgfsInodeFileHandle fileHandles[BEEGFS_INODE_FILEHANDLES_NUM]; // use FileHandleType as index
@@ -539,6 +555,9 @@ int FhgfsInode_handleTypeToOpenFlags(FileHandleType handleType)
 void FhgfsInode_invalidateCache(FhgfsInode* this)
 {
    Time_setZero(&this->dataCacheTime);
+   Time_setZero(&this->attribCacheTime);
+
+   FhgfsInode_revokeLease(this);
 }
 
 void FhgfsInode_incNumDirtyPages(FhgfsInode* this)
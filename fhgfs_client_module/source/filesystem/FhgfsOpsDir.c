@@ -137,12 +137,18 @@ int __FhgfsOps_revalidateIntent(struct dentry* parentDentry, struct dentry* dent
    struct inode* inode = dentry->d_inode;
    FhgfsInode* fhgfsInode = BEEGFS_INODE(inode);
 
-   fhgfs_bool cacheValid = FhgfsInode_isCacheValid(fhgfsInode, inode->i_mode, cfg);
+   fhgfs_bool cacheValid = FhgfsInode_isCacheValid(fhgfsInode, inode->i_mode, cfg) ||
+      FhgfsInode_isAttribCacheValid(fhgfsInode, cfg) ||
+      FhgfsInode_isLeaseValid(fhgfsInode, fhgfs_true);
    int isValid = 0; // quasi-boolean (return value)
    fhgfs_bool needDrop = fhgfs_false;
 
    FhgfsIsizeHints iSizeHints;
 
+   unsigned leaseVersion = 0;
+   unsigned leaseMS = 0;
+   Time leaseRequestTime;
+
 
    FhgfsOpsHelper_logOp(Log_SPAM, app, dentry, inode, logContext);
 
@@ -166,6 +172,10 @@ int __FhgfsOps_revalidateIntent(struct dentry* parentDentry, struct dentry* dent
 
       FhgfsInode_initIsizeHints(fhgfsInode, &iSizeHints);
 
+      // (version and time must be taken before the request is sent)
+      leaseVersion = FhgfsInode_getLeaseVersion(fhgfsInode);
+      Time_init(&leaseRequestTime);
+
       FhgfsInode_entryInfoReadLock(parentFhgfsInode); // LOCK parentInfo
       FhgfsInode_entryInfoReadLock(fhgfsInode);       // LOCK EntryInfo
 
@@ -203,7 +213,10 @@ int __FhgfsOps_revalidateIntent(struct dentry* parentDentry, struct dentry* dent
 
       // check the stat result here and set fhgfsStatPtr accordingly
       if(outInfo.statRes == FhgfsOpsErr_SUCCESS)
+      {
          fhgfsStatPtr = &fhgfsStat; // successful, so we can use existing stat values
+         leaseMS = outInfo.leaseMS;
+      }
       else
       if(outInfo.statRes == FhgfsOpsErr_NOTOWNER)
          fhgfsStatPtr = NULL; // stat values not available
@@ -220,7 +233,12 @@ int __FhgfsOps_revalidateIntent(struct dentry* parentDentry, struct dentry* dent
    }
 
    if (!__FhgfsOps_refreshInode(app, inode, fhgfsStatPtr, &iSizeHints) )
+   {
       isValid = 1;
+
+      if(leaseMS)
+         FhgfsInode_setLease(fhgfsInode, leaseVersion, &leaseRequestTime, leaseMS, fhgfs_true);
+   }
    else
       isValid = 0;
 
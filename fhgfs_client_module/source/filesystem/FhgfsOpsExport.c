@@ -446,7 +446,7 @@ struct dentry* __FhgfsOpsExport_lookupDentryFromNfsHandle(struct super_block *sb
       // communicate
 
       statRes = FhgfsOpsRemoting_statAndGetParentInfo(app, &entryInfo, &fhgfsStat,
-         &parentNodeID, &statParentEntryID);
+         &parentNodeID, &statParentEntryID, NULL);
 
       if(statRes != FhgfsOpsErr_SUCCESS)
          goto err_cleanup_entryinfo;
@@ -678,7 +678,7 @@ struct dentry* FhgfsOpsExport_getParentDentry(struct dentry* childDentry)
          FhgfsInode_initIsizeHints(NULL, &iSizeHints);
 
          statRes = FhgfsOpsRemoting_statAndGetParentInfo(app, &parentInfo, &fhgfsStat,
-            &parentNodeID, &parentEntryID);
+            &parentNodeID, &parentEntryID, NULL);
 
          if(statRes != FhgfsOpsErr_SUCCESS)
          {
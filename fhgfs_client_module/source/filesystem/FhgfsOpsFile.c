@@ -3,6 +3,7 @@
 #include <app/config/Config.h>
 #include <common/toolkit/vector/StrCpyVec.h>
 #include <common/toolkit/vector/IntCpyVec.h>
+#include <common/toolkit/vector/UInt16Vec.h>
 #include <common/toolkit/LockingTk.h>
 #include <common/storage/StorageErrors.h>
 #include <common/toolkit/StringTk.h>
@@ -49,6 +50,9 @@ static ssize_t FhgfsOps_buffered_write_iter(struct kiocb *iocb, struct iov_iter
 static ssize_t FhgfsOps_buffered_read_iter(struct kiocb *iocb, struct iov_iter *to);
 #endif // LINUX_VERSION_CODE
 
+static void __FhgfsOps_primeDentry(struct dentry* parentDentry, FsDirInfo* dirInfo,
+   size_t contentsPos);
+
 //fix for iov_for_each, overwrite Kernel Header
 #undef iov_for_each
 #define iov_for_each(iov, iter, start)                          \
@@ -476,6 +480,9 @@ int FhgfsOps_readdirIncremental(struct file* file, void* buf, filldir_t filldir)
 
       LOG_DEBUG_FORMATTED(log, Log_SPAM, logContext, "filled: %s", currentName);
 
+      // add entry to dcache if we got its stat data via readdir-plus (for subsequent stat calls)
+      __FhgfsOps_primeDentry(dentry, dirInfo, contentsPos);
+
       // advance dir position (yes, it's alright to use the old contentsPos for the next round here)
       (*pos) = Int64CpyVec_at(serverOffsets, contentsPos);
 
@@ -492,6 +499,117 @@ int FhgfsOps_readdirIncremental(struct file* file, void* buf, filldir_t filldir)
 }
 
 
+/**
+ * Prime the dcache with an entry of a readdir-plus result, so that a following stat() of the
+ * entry (e.g. "ls -l") can be answered from the inode instead of a separate lookup round-trip.
+ *
+ * Entries without stat data (e.g. "." and ".." or owned by another metadata node), dentries of
+ * open files and dentries that point to a different inode are left to the normal lookup and
+ * revalidate path.
+ *
+ * Note: Caller must hold the entryInfo read lock of the parent inode.
+ *
+ * @param contentsPos position of the entry in the dirInfo contents
+ */
+void __FhgfsOps_primeDentry(struct dentry* parentDentry, FsDirInfo* dirInfo,
+   size_t contentsPos)
+{
+   struct super_block* sb = parentDentry->d_sb;
+   FhgfsInode* parentFhgfsInode = BEEGFS_INODE(parentDentry->d_inode);
+   fhgfs_stat* entryStats = FsDirInfo_getEntryStats(dirInfo);
+   const char* entryName = StrCpyVec_at(FsDirInfo_getDirContents(dirInfo), contentsPos);
+   const char* entryID = StrCpyVec_at(FsDirInfo_getEntryIDs(dirInfo), contentsPos);
+
+   struct qstr name;
+   struct dentry* dentry;
+   struct dentry* aliasDentry;
+   struct inode* inode;
+   struct kstat kstat;
+   FhgfsIsizeHints iSizeHints;
+   EntryInfo entryInfo;
+
+   if(!entryStats ||
+      (IntCpyVec_at(FsDirInfo_getStatResults(dirInfo), contentsPos) != FhgfsOpsErr_SUCCESS) )
+      return; // no stat data for this entry
+
+   OsTypeConv_kstatFhgfsToOs(&entryStats[contentsPos], &kstat);
+   kstat.ino = FhgfsInode_generateInodeID(sb, entryID, strlen(entryID) );
+
+   name.name = entryName;
+   name.len = strlen(entryName);
+
+   dentry = d_hash_and_lookup(parentDentry, &name); // (also sets name.hash for d_alloc() below)
+   if(IS_ERR(dentry) )
+      return;
+
+   if(dentry)
+   { // existing dentry => refresh its inode attribs if it still refers to the same entry
+      inode = dentry->d_inode;
+
+      if(inode && !is_bad_inode(inode) &&
+         ( (inode->i_mode & S_IFMT) == (kstat.mode & S_IFMT) ) &&
+         FhgfsInode_compareEntryID(BEEGFS_INODE(inode), entryID) &&
+         !FhgfsInode_getIsFileOpen(BEEGFS_INODE(inode) ) )
+      {
+         FhgfsInode* fhgfsInode = BEEGFS_INODE(inode);
+
+         FhgfsInode_initIsizeHints(fhgfsInode, &iSizeHints);
+
+         spin_lock(&inode->i_lock);
+         __FhgfsOps_applyStatDataToInodeUnlocked(&kstat, &iSizeHints, inode);
+         Time_setToNow(&fhgfsInode->attribCacheTime);
+         spin_unlock(&inode->i_lock);
+      }
+
+      dput(dentry);
+      return;
+   }
+
+   if(S_ISDIR(kstat.mode) )
+      return; // new dir dentries are left to lookup, which takes care of dir aliases
+
+   // no dentry yet => create dentry and inode like FhgfsOps_lookupIntent() would
+
+   dentry = d_alloc(parentDentry, &name);
+   if(unlikely(!dentry) )
+      return;
+
+   EntryInfo_init(&entryInfo,
+      UInt16Vec_at(FsDirInfo_getOwnerNodeIDs(dirInfo), contentsPos),
+      StringTk_strDup(FhgfsInode_getEntryInfo(parentFhgfsInode)->entryID),
+      StringTk_strDup(entryID), StringTk_strDup(entryName),
+      (DirEntryType)UInt8Vec_at(FsDirInfo_getDirContentsTypes(dirInfo), contentsPos),
+      IntCpyVec_at(FsDirInfo_getEntryFlags(dirInfo), contentsPos) );
+
+   if(unlikely(!entryInfo.parentEntryID || !entryInfo.entryID || !entryInfo.fileName) )
+   { // out of memory
+      EntryInfo_uninit(&entryInfo);
+      goto cleanup_dentry;
+   }
+
+   FhgfsInode_initIsizeHints(NULL, &iSizeHints);
+
+   // (entryInfo now owned or freed by _newInode() )
+   inode = __FhgfsOps_newInode(sb, &kstat, 0, &entryInfo, &iSizeHints);
+   if(unlikely(!inode || IS_ERR(inode) ) )
+      goto cleanup_dentry;
+
+   spin_lock(&inode->i_lock);
+   Time_setToNow(&BEEGFS_INODE(inode)->attribCacheTime);
+   spin_unlock(&inode->i_lock);
+
+   #ifndef KERNEL_HAS_S_D_OP
+      dentry->d_op = &fhgfs_dentry_ops;
+   #endif // KERNEL_HAS_S_D_OP
+
+   aliasDentry = d_splice_alias(inode, dentry);
+   if(aliasDentry && !IS_ERR(aliasDentry) )
+      dput(aliasDentry);
+
+cleanup_dentry:
+   dput(dentry);
+}
+
 /**
  * Note: This works for _opendir() and for _opendirIncremental().
  */
@@ -1,5 +1,6 @@
 #include <app/log/Logger.h>
 #include <app/App.h>
+#include <app/config/Config.h>
 #include <common/threading/AtomicInt.h>
 #include <common/toolkit/StringTk.h>
 #include <common/toolkit/vector/StrCpyVec.h>
@@ -129,7 +130,10 @@ int FhgfsOpsHelper_refreshDirInfoIncremental(App* app, const EntryInfo* entryInf
    Logger* log = App_getLogger(app);
    const char* logContext = "FhgfsOpsHelper (refresh dir info incremental)";
 
+   Config* cfg = App_getConfig(app);
+
    const unsigned maxNames = 100; // max number of retrieved names
+   const fhgfs_bool readdirPlus = Config_getTuneReaddirPlus(cfg);
 
    int retVal = 0;
    FhgfsOpsErr listRes = FhgfsOpsErr_SUCCESS;
@@ -147,7 +151,9 @@ int FhgfsOpsHelper_refreshDirInfoIncremental(App* app, const EntryInfo* entryInf
    { // user seeked backwards (or something else makes an update necessary)
       LOG_DEBUG(log, Log_SPAM, logContext, "forced update of dir contents");
 
-      listRes = FhgfsOpsRemoting_listdirFromOffset(entryInfo, dirInfo, maxNames);
+      listRes = readdirPlus ?
+         FhgfsOpsRemoting_listdirPlusFromOffset(entryInfo, dirInfo, maxNames) :
+         FhgfsOpsRemoting_listdirFromOffset(entryInfo, dirInfo, maxNames);
    }
    else
    if(FsDirInfo_getEndOfDir(dirInfo) && (currentContentsPos >= dirContentsLen) )
@@ -167,7 +173,9 @@ int FhgfsOpsHelper_refreshDirInfoIncremental(App* app, const EntryInfo* entryInf
    { // initial retrieval or offset outside current local contents region
       LOG_DEBUG(log, Log_SPAM, logContext, "retrieving by offset");
 
-      listRes = FhgfsOpsRemoting_listdirFromOffset(entryInfo, dirInfo, maxNames);
+      listRes = readdirPlus ?
+         FhgfsOpsRemoting_listdirPlusFromOffset(entryInfo, dirInfo, maxNames) :
+         FhgfsOpsRemoting_listdirFromOffset(entryInfo, dirInfo, maxNames);
    }
 
 
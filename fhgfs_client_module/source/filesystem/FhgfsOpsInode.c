@@ -38,7 +38,8 @@ static __always_inline int maybeRefreshInode(struct inode* inode, bool whenCache
    Config* cfg = app->cfg;
 
    if(unlikely(!FhgfsOps_getIsRootInited(inode->i_sb) && inode->i_ino == BEEGFS_INODE_ROOT_INO)
-      || (!FhgfsInode_isCacheValid(BEEGFS_INODE(inode), inode->i_mode, cfg) && whenCacheInvalid) )
+      || (!FhgfsInode_isCacheValid(BEEGFS_INODE(inode), inode->i_mode, cfg) && whenCacheInvalid &&
+          !FhgfsInode_isLeaseValid(BEEGFS_INODE(inode), fhgfs_false) ) )
    {
       FhgfsIsizeHints iSizeHints;
       int refreshRes;
@@ -2341,6 +2342,10 @@ int __FhgfsOps_doRefreshInode(App* app, struct inode* inode, fhgfs_stat* fhgfsSt
    fhgfs_bool mtimeSizeInvalidate;
    fhgfs_bool timeoutInvalidate;
 
+   unsigned leaseVersion = 0;
+   unsigned leaseMS = 0;
+   Time leaseRequestTime;
+
    FhgfsOpsHelper_logOpDebug(app, NULL, inode, logContext, "(%s)",
       fhgfsStat ? "with stat info" : "without stat info");
 
@@ -2363,10 +2368,14 @@ int __FhgfsOps_doRefreshInode(App* app, struct inode* inode, fhgfs_stat* fhgfsSt
 
       FhgfsInode_initIsizeHints(fhgfsInode, iSizeHints);
 
+      // (version and time must be taken before the request is sent)
+      leaseVersion = FhgfsInode_getLeaseVersion(fhgfsInode);
+      Time_init(&leaseRequestTime);
+
       FhgfsInode_entryInfoReadLock(fhgfsInode); // LOCK EntryInfo
 
-      statRes = FhgfsOpsRemoting_statDirect(app, FhgfsInode_getEntryInfo(fhgfsInode),
-         &fhgfsStatInternal);
+      statRes = FhgfsOpsRemoting_statAndGetParentInfo(app, FhgfsInode_getEntryInfo(fhgfsInode),
+         &fhgfsStatInternal, NULL, NULL, &leaseMS);
 
       FhgfsInode_entryInfoReadUnlock(fhgfsInode); // UNLOCK EntryInfo
 
@@ -2446,6 +2455,10 @@ int __FhgfsOps_doRefreshInode(App* app, struct inode* inode, fhgfs_stat* fhgfsSt
 
    spin_unlock(&inode->i_lock); // I _ U N L O C K
 
+   // (a lease from a stat request only covers the attribs, not the dentry)
+   if(leaseMS)
+      FhgfsInode_setLease(fhgfsInode, leaseVersion, &leaseRequestTime, leaseMS, fhgfs_false);
+
 
    // clean up
 cleanup:
@@ -162,6 +162,7 @@ int __FhgfsOps_constructFsInfo(struct super_block* sb, void* rawMountOptions)
    }
 
    sb->s_fs_info = sbInfo;
+   sbInfo->sb = sb;
 
    appRes = __FhgfsOps_initApp(sb, rawMountOptions);
    if(appRes)
@@ -31,6 +31,7 @@ extern int  FhgfsOps_fillSuper(struct super_block* sb, void* rawMountOptions, in
 
 // getters & setters
 static inline App* FhgfsOps_getApp(struct super_block* sb);
+static inline struct super_block* FhgfsOps_getSuperBlock(App* app);
 static inline struct backing_dev_info* FhgfsOps_getBdi(struct super_block* sb);
 
 static inline fhgfs_bool FhgfsOps_getHasRootEntryInfo(struct super_block* sb);
@@ -43,6 +44,7 @@ struct FhgfsSuperBlockInfo
 {
    App app;
    struct backing_dev_info bdi;
+   struct super_block* sb; // the super block that this info belongs to
    fhgfs_bool haveRootEntryInfo; // fhgfs_false until the root EntryInfo is set in root-FhgfsInode
 
    fhgfs_bool isRootInited; /* fhgfs_false until root inode attrs have been fetched/initialized in
@@ -67,6 +69,17 @@ App* FhgfsOps_getApp(struct super_block* sb)
    return &(sbInfo->app);
 }
 
+/**
+ * Get the super block of the mount that the given app belongs to (e.g. for incoming messages
+ * that refer to inodes).
+ */
+struct super_block* FhgfsOps_getSuperBlock(App* app)
+{
+   FhgfsSuperBlockInfo* sbInfo = container_of(app, FhgfsSuperBlockInfo, app);
+
+   return sbInfo->sb;
+}
+
 /**
  * NOTE: Make sure sb->s_fs_info is initialized!
  */
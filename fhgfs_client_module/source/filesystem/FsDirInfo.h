@@ -3,7 +3,9 @@
 
 #include <common/storage/StorageDefinitions.h>
 #include <common/toolkit/vector/Int64CpyVec.h>
+#include <common/toolkit/vector/IntCpyVec.h>
 #include <common/toolkit/vector/StrCpyVec.h>
+#include <common/toolkit/vector/UInt16Vec.h>
 #include <common/toolkit/vector/UInt8Vec.h>
 #include <common/Common.h>
 #include "FsObjectInfo.h"
@@ -29,6 +31,13 @@ static inline struct UInt8Vec* FsDirInfo_getDirContentsTypes(FsDirInfo* this);
 static inline struct Int64CpyVec* FsDirInfo_getServerOffsets(FsDirInfo* this);
 static inline void FsDirInfo_setEndOfDir(FsDirInfo* this, fhgfs_bool endOfDir);
 static inline fhgfs_bool FsDirInfo_getEndOfDir(FsDirInfo* this);
+static inline struct UInt16Vec* FsDirInfo_getOwnerNodeIDs(FsDirInfo* this);
+static inline struct IntCpyVec* FsDirInfo_getEntryFlags(FsDirInfo* this);
+static inline struct IntCpyVec* FsDirInfo_getStatResults(FsDirInfo* this);
+static inline fhgfs_stat* FsDirInfo_getEntryStats(FsDirInfo* this);
+static inline size_t FsDirInfo_getEntryStatsLen(FsDirInfo* this);
+static inline void FsDirInfo_setEntryStats(FsDirInfo* this, fhgfs_stat* entryStats,
+   size_t entryStatsLen);
 
 
 struct FsDirInfo
@@ -43,6 +52,13 @@ struct FsDirInfo
                             (equals last element of serverOffsets vector) */
    size_t currentContentsPos; // current local pos in dirContents (>=0 && <dirContents_len)
    fhgfs_bool endOfDir; // fhgfs_true if server reached end of dir entries during last query
+
+   // readdir-plus results (only set if the last query was a readdir-plus, otherwise empty)
+   UInt16Vec ownerNodeIDs; // owner nodeID elements matching dirContents vector
+   IntCpyVec entryFlags; // EntryInfo flags matching dirContents vector
+   IntCpyVec statResults; // FhgfsOpsErr of the server-side stat matching dirContents vector
+   fhgfs_stat* entryStats; // array of stat data matching dirContents vector (owned by this)
+   size_t entryStatsLen; // number of elements in entryStats
 };
 
 
@@ -60,6 +76,12 @@ void FsDirInfo_init(FsDirInfo* this, App* app)
    this->currentContentsPos = 0;
    this->endOfDir = fhgfs_false;
 
+   UInt16Vec_init(&this->ownerNodeIDs);
+   IntCpyVec_init(&this->entryFlags);
+   IntCpyVec_init(&this->statResults);
+   this->entryStats = NULL;
+   this->entryStatsLen = 0;
+
    // assign virtual functions
    ( (FsObjectInfo*)this)->uninit = FsDirInfo_uninit;
 }
@@ -83,6 +105,11 @@ void FsDirInfo_uninit(FsObjectInfo* this)
    StrCpyVec_uninit(&thisCast->entryIDs);
    Int64CpyVec_uninit(&thisCast->serverOffsets);
 
+   UInt16Vec_uninit(&thisCast->ownerNodeIDs);
+   IntCpyVec_uninit(&thisCast->entryFlags);
+   IntCpyVec_uninit(&thisCast->statResults);
+   SAFE_KFREE(thisCast->entryStats);
+
    FsObjectInfo_uninit( (FsObjectInfo*)this);
 }
 
@@ -147,6 +174,50 @@ fhgfs_bool FsDirInfo_getEndOfDir(FsDirInfo* this)
    return this->endOfDir;
 }
 
+UInt16Vec* FsDirInfo_getOwnerNodeIDs(FsDirInfo* this)
+{
+   return &this->ownerNodeIDs;
+}
+
+IntCpyVec* FsDirInfo_getEntryFlags(FsDirInfo* this)
+{
+   return &this->entryFlags;
+}
+
+/**
+ * @return vector of FhgfsOpsErr elements, matching dirContents vector
+ */
+IntCpyVec* FsDirInfo_getStatResults(FsDirInfo* this)
+{
+   return &this->statResults;
+}
+
+/**
+ * @return NULL if the last query was not a readdir-plus
+ */
+fhgfs_stat* FsDirInfo_getEntryStats(FsDirInfo* this)
+{
+   return this->entryStats;
+}
+
+size_t FsDirInfo_getEntryStatsLen(FsDirInfo* this)
+{
+   return this->entryStatsLen;
+}
+
+/**
+ * Replace the stat data array (the old array will be freed).
+ *
+ * @param entryStats will be owned by this object; may be NULL.
+ */
+void FsDirInfo_setEntryStats(FsDirInfo* this, fhgfs_stat* entryStats, size_t entryStatsLen)
+{
+   SAFE_KFREE(this->entryStats);
+
+   this->entryStats = entryStats;
+   this->entryStatsLen = entryStats ? entryStatsLen : 0;
+}
+
 
 
 #endif /*FSDIRINFO_H_*/
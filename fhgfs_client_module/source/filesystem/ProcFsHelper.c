@@ -56,6 +56,8 @@ const char* const PROCFSHELPER_CONFIGKEYS[] =
    "tuneRemoteFSync",
    "tuneUseGlobalFileLocks",
    "tuneRefreshOnGetAttr",
+   "tuneReaddirPlus",
+   "tuneUseAttribLeases",
    "tuneInodeBlockBits",
    "tuneInodeBlockSize",
    "tuneEarlyCloseResponse",
@@ -128,6 +130,8 @@ int ProcFsHelper_readV2_config(struct seq_file* file, App* app)
    seq_printf(file, "tuneRemoteFSync = %d\n", (int)Config_getTuneRemoteFSync(cfg) );
    seq_printf(file, "tuneUseGlobalFileLocks = %d\n", (int)Config_getTuneUseGlobalFileLocks(cfg) );
    seq_printf(file, "tuneRefreshOnGetAttr = %d\n", (int)Config_getTuneRefreshOnGetAttr(cfg) );
+   seq_printf(file, "tuneReaddirPlus = %d\n", (int)Config_getTuneReaddirPlus(cfg) );
+   seq_printf(file, "tuneUseAttribLeases = %d\n", (int)Config_getTuneUseAttribLeases(cfg) );
    seq_printf(file, "tuneInodeBlockBits = %u\n", Config_getTuneInodeBlockBits(cfg) );
    seq_printf(file, "tuneInodeBlockSize = %u\n", Config_getTuneInodeBlockSize(cfg) );
    seq_printf(file, "tuneEarlyCloseResponse = %d\n", (int)Config_getTuneEarlyCloseResponse(cfg) );
@@ -313,6 +317,14 @@ int ProcFsHelper_read_config(char* buf, char** start, off_t offset, int size, in
       count = os_scnprintf(buf, size, "%s = %d\n", currentKey,
          Config_getTuneRefreshOnGetAttr(cfg) );
    else
+   if(!os_strcmp(currentKey, "tuneReaddirPlus") )
+      count = os_scnprintf(buf, size, "%s = %d\n", currentKey,
+         Config_getTuneReaddirPlus(cfg) );
+   else
+   if(!os_strcmp(currentKey, "tuneUseAttribLeases") )
+      count = os_scnprintf(buf, size, "%s = %d\n", currentKey,
+         Config_getTuneUseAttribLeases(cfg) );
+   else
    if(!os_strcmp(currentKey, "tuneInodeBlockBits") )
       count = os_scnprintf(buf, size, "%s = %u\n", currentKey,
          Config_getTuneInodeBlockBits(cfg) );
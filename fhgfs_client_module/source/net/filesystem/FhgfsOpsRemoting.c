@@ -17,6 +17,8 @@
 #include <common/net/message/storage/creating/UnlinkFileRespMsg.h>
 #include <common/net/message/storage/listing/ListDirFromOffsetMsg.h>
 #include <common/net/message/storage/listing/ListDirFromOffsetRespMsg.h>
+#include <common/net/message/storage/listing/ListDirPlusMsg.h>
+#include <common/net/message/storage/listing/ListDirPlusRespMsg.h>
 #include <common/net/message/storage/moving/RenameMsg.h>
 #include <common/net/message/storage/moving/RenameRespMsg.h>
 #include <common/net/message/storage/attribs/ListXAttrMsg.h>
@@ -257,6 +259,8 @@ FhgfsOpsErr FhgfsOpsRemoting_listdirFromOffset(const EntryInfo* entryInfo, FsDir
 
       endOfDirReached = (StrCpyVec_length(dirContents) < maxOutNames);
       FsDirInfo_setEndOfDir(dirInfo, endOfDirReached);
+
+      FsDirInfo_setEntryStats(dirInfo, NULL, 0); // no readdir-plus data for these contents
    }
    else
    {
@@ -277,6 +281,148 @@ cleanup_request:
    return retVal;
 }
 
+/**
+ * Readdir-plus version of _listdirFromOffset(), which additionally retrieves the owner info and
+ * stat data of each entry and stores them in the dirInfo.
+ *
+ * @param dirInfo used as input (offsets) and output (contents etc.) parameter
+ */
+FhgfsOpsErr FhgfsOpsRemoting_listdirPlusFromOffset(const EntryInfo* entryInfo, FsDirInfo* dirInfo,
+   unsigned maxOutNames)
+{
+   FsObjectInfo* fsObjectInfo = (FsObjectInfo*)dirInfo;
+   App* app = FsObjectInfo_getApp(fsObjectInfo);
+
+   Logger* log = App_getLogger(app);
+   const char* logContext = "Remoting (list dir plus from offset)";
+
+   int64_t serverOffset = FsDirInfo_getServerOffset(dirInfo);
+   ListDirPlusMsg requestMsg;
+   RequestResponseNode rrNode;
+   RequestResponseArgs rrArgs;
+   FhgfsOpsErr requestRes;
+   ListDirPlusRespMsg* listDirResp;
+   FhgfsOpsErr retVal;
+
+   // prepare request
+   ListDirPlusMsg_initFromEntryInfo(&requestMsg, entryInfo, serverOffset, maxOutNames);
+
+   RequestResponseNode_prepare(&rrNode, entryInfo->ownerNodeID, App_getMetaNodes(app) );
+   RequestResponseNode_setTargetStates(&rrNode, App_getMetaStateStore(app) );
+   RequestResponseArgs_prepare(&rrArgs, NULL, (NetMessage*)&requestMsg,
+      NETMSGTYPE_ListDirPlusResp);
+
+   // communicate
+   requestRes = MessagingTk_requestResponseNodeRetryAutoIntr(app, &rrNode, &rrArgs);
+
+   if(unlikely(requestRes != FhgfsOpsErr_SUCCESS) )
+   { // clean-up
+      retVal = requestRes;
+      goto cleanup_request;
+   }
+
+   // handle result
+   listDirResp = (ListDirPlusRespMsg*)rrArgs.outRespMsg;
+   retVal = (FhgfsOpsErr)ListDirPlusRespMsg_getResult(listDirResp);
+
+   if(likely(retVal == FhgfsOpsErr_SUCCESS) )
+   {
+      UInt8Vec* dirContentsTypes = FsDirInfo_getDirContentsTypes(dirInfo);
+      Int64CpyVec* serverOffsets = FsDirInfo_getServerOffsets(dirInfo);
+      StrCpyVec* dirContents = FsDirInfo_getDirContents(dirInfo);
+      StrCpyVec* dirContentIDs = FsDirInfo_getEntryIDs(dirInfo);
+      UInt16Vec* ownerNodeIDs = FsDirInfo_getOwnerNodeIDs(dirInfo);
+      IntCpyVec* entryFlags = FsDirInfo_getEntryFlags(dirInfo);
+      IntCpyVec* statResults = FsDirInfo_getStatResults(dirInfo);
+      size_t numEntries = ListDirPlusRespMsg_getNumEntries(listDirResp);
+      fhgfs_stat* entryStats = NULL;
+      fhgfs_bool endOfDirReached;
+
+      FsDirInfo_setCurrentContentsPos(dirInfo, 0);
+
+      Int64CpyVec_clear(serverOffsets);
+      UInt8Vec_clear(dirContentsTypes);
+      StrCpyVec_clear(dirContents);
+      StrCpyVec_clear(dirContentIDs);
+      UInt16Vec_clear(ownerNodeIDs);
+      IntCpyVec_clear(entryFlags);
+      IntCpyVec_clear(statResults);
+      FsDirInfo_setEntryStats(dirInfo, NULL, 0);
+
+      ListDirPlusRespMsg_parseEntryTypes(listDirResp, dirContentsTypes);
+      ListDirPlusRespMsg_parseNames(listDirResp, dirContents);
+      ListDirPlusRespMsg_parseEntryIDs(listDirResp, dirContentIDs);
+      ListDirPlusRespMsg_parseServerOffsets(listDirResp, serverOffsets);
+      ListDirPlusRespMsg_parseOwnerNodeIDs(listDirResp, ownerNodeIDs);
+      ListDirPlusRespMsg_parseEntryFlags(listDirResp, entryFlags);
+      ListDirPlusRespMsg_parseStatResults(listDirResp, statResults);
+
+      if(numEntries)
+      {
+         entryStats = os_kmalloc(numEntries * sizeof(fhgfs_stat) );
+
+         if(likely(entryStats) &&
+            unlikely(!ListDirPlusRespMsg_parseStatDatas(listDirResp, entryStats, numEntries) ) )
+         { // inconsistent stat data => just treat like a normal listing without stat data
+            Logger_logErr(log, logContext, "Unable to parse stat data of dir entries.");
+
+            SAFE_KFREE(entryStats);
+         }
+      }
+
+      // check for equal vector lengths
+      if(unlikely(
+         (UInt8Vec_length(dirContentsTypes) != StrCpyVec_length(dirContents) ) ||
+         (UInt8Vec_length(dirContentsTypes) != StrCpyVec_length(dirContentIDs) ) ||
+         (UInt8Vec_length(dirContentsTypes) != Int64CpyVec_length(serverOffsets) ) ||
+         (UInt8Vec_length(dirContentsTypes) != UInt16Vec_length(ownerNodeIDs) ) ||
+         (UInt8Vec_length(dirContentsTypes) != IntCpyVec_length(entryFlags) ) ||
+         (UInt8Vec_length(dirContentsTypes) != IntCpyVec_length(statResults) ) ) )
+      { // appearently, at least one of the vector allocations failed
+         printk_fhgfs(KERN_WARNING,
+            "Memory allocation for directory contents retrieval failed.\n");
+
+         Int64CpyVec_clear(serverOffsets);
+         UInt8Vec_clear(dirContentsTypes);
+         StrCpyVec_clear(dirContents);
+         StrCpyVec_clear(dirContentIDs);
+         UInt16Vec_clear(ownerNodeIDs);
+         IntCpyVec_clear(entryFlags);
+         IntCpyVec_clear(statResults);
+         SAFE_KFREE(entryStats);
+
+         retVal = FhgfsOpsErr_OUTOFMEM;
+
+         goto cleanup_resp_buffers;
+      }
+
+      // (entryStats may be NULL here, which is fine: readdir just doesn't prime the dcache then)
+      FsDirInfo_setEntryStats(dirInfo, entryStats, numEntries);
+
+      FsDirInfo_setServerOffset(dirInfo, ListDirPlusRespMsg_getNewServerOffset(listDirResp) );
+
+      endOfDirReached = (StrCpyVec_length(dirContents) < maxOutNames);
+      FsDirInfo_setEndOfDir(dirInfo, endOfDirReached);
+   }
+   else
+   {
+      int logLevel = (retVal == FhgfsOpsErr_PATHNOTEXISTS) ? Log_DEBUG : Log_NOTICE;
+
+      Logger_logFormatted(log, logLevel, logContext, "ListDirPlusResp error code: %s",
+         FhgfsOpsErr_toErrString(retVal) );
+   }
+
+   // clean-up
+
+cleanup_resp_buffers:
+   RequestResponseArgs_freeRespBuffers(&rrArgs, app);
+
+cleanup_request:
+   ListDirPlusMsg_uninit( (NetMessage*)&requestMsg);
+
+   return retVal;
+}
+
 /**
  * Resolve path to entry owner and stat the entry.
  * Note: This function should *only* be called to stat the root path, as it is the only dir
@@ -328,11 +474,16 @@ FhgfsOpsErr FhgfsOpsRemoting_statRoot(App* app, fhgfs_stat* outFhgfsStat)
  *
  * @param parentNodeID may be NULL if the caller is not interested (default)
  * @param parentEntryID may be NULL if the caller is not interested (default)
+ * @param outLeaseMS may be NULL if the caller is not interested (default); otherwise a lease on the
+ *    attribs is requested (if enabled in the config) and this is set to the granted lease duration
+ *    (0 if no lease was granted).
  */
 FhgfsOpsErr FhgfsOpsRemoting_statAndGetParentInfo(App* app, const EntryInfo* entryInfo,
-   fhgfs_stat* outFhgfsStat, uint16_t* outParentNodeID, char** outParentEntryID)
+   fhgfs_stat* outFhgfsStat, uint16_t* outParentNodeID, char** outParentEntryID,
+   unsigned* outLeaseMS)
 {
    Logger* log = App_getLogger(app);
+   Config* cfg = App_getConfig(app);
    const char* logContext = "Remoting (stat)";
 
    StatMsg requestMsg;
@@ -348,6 +499,15 @@ FhgfsOpsErr FhgfsOpsRemoting_statAndGetParentInfo(App* app, const EntryInfo* ent
    if (outParentNodeID)
       StatMsg_addParentInfoRequest(&requestMsg);
 
+   if (outLeaseMS && Config_getTuneUseAttribLeases(cfg) )
+   {
+      Node* localNode = App_getLocalNode(app);
+
+      StatMsg_addLeaseRequest(&requestMsg, Node_getID(localNode) );
+   }
+
+   SAFE_ASSIGN(outLeaseMS, 0);
+
    RequestResponseNode_prepare(&rrNode, entryInfo->ownerNodeID, App_getMetaNodes(app) );
    RequestResponseNode_setTargetStates(&rrNode, App_getMetaStateStore(app) );
    RequestResponseArgs_prepare(&rrArgs, NULL, (NetMessage*)&requestMsg, NETMSGTYPE_StatResp);
@@ -374,6 +534,8 @@ FhgfsOpsErr FhgfsOpsRemoting_statAndGetParentInfo(App* app, const EntryInfo* ent
       {
          StatRespMsg_getParentInfo(statResp, outParentNodeID, outParentEntryID);
       }
+
+      SAFE_ASSIGN(outLeaseMS, StatRespMsg_getLeaseMS(statResp) );
    }
    else
    {
@@ -2523,6 +2685,14 @@ FhgfsOpsErr FhgfsOpsRemoting_lookupIntent(App* app,
       LookupIntentMsg_addIntentOpen(&requestMsg, localNodeID, openInfo->accessFlags);
    }
 
+   if(inInfo->entryInfoPtr && !createInfo && !openInfo && Config_getTuneUseAttribLeases(cfg) )
+   { // plain revalidate => ask for a lease, so that we can skip the next revalidates
+      Node* localNode = App_getLocalNode(app);
+      char* localNodeID = Node_getID(localNode);
+
+      LookupIntentMsg_addIntentLease(&requestMsg, localNodeID);
+   }
+
    if(Config_getQuotaEnabled(cfg) )
       NetMessage_addMsgHeaderFeatureFlag((NetMessage*)&requestMsg, LOOKUPINTENTMSG_FLAG_USE_QUOTA);
 
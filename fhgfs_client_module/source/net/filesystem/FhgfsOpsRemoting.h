@@ -25,13 +25,16 @@ extern void FhgfsOpsRemoting_destroyMsgBufCache(void);
 
 extern FhgfsOpsErr FhgfsOpsRemoting_listdirFromOffset(const EntryInfo* entryInfo,
    FsDirInfo* dirInfo, unsigned maxOutNames);
+extern FhgfsOpsErr FhgfsOpsRemoting_listdirPlusFromOffset(const EntryInfo* entryInfo,
+   FsDirInfo* dirInfo, unsigned maxOutNames);
 extern FhgfsOpsErr FhgfsOpsRemoting_statRoot(App* app, fhgfs_stat* outFhgfsStat);
 static inline FhgfsOpsErr FhgfsOpsRemoting_statDirect(App* app, const EntryInfo* entryInfo,
    fhgfs_stat* outFhgfsStat);
 extern FhgfsOpsErr FhgfsOpsRemoting_statDirect(App* app, const EntryInfo* entryInfo,
    fhgfs_stat* outFhgfsStat);
 extern FhgfsOpsErr FhgfsOpsRemoting_statAndGetParentInfo(App* app, const EntryInfo* entryInfo,
-   fhgfs_stat* outFhgfsStat, uint16_t* outParentNodeID, char** outParentEntryID);
+   fhgfs_stat* outFhgfsStat, uint16_t* outParentNodeID, char** outParentEntryID,
+   unsigned* outLeaseMS);
 extern FhgfsOpsErr FhgfsOpsRemoting_setAttr(App* app, const EntryInfo* entryInfo,
    SettableFileAttribs* fhgfsAttr, int validAttribs);
 extern FhgfsOpsErr FhgfsOpsRemoting_mkdir(App* app, const EntryInfo* parentInfo,
@@ -126,7 +129,7 @@ enum Fhgfs_RWType
 FhgfsOpsErr FhgfsOpsRemoting_statDirect(App* app, const EntryInfo* entryInfo,
    fhgfs_stat* outFhgfsStat)
 {
-   return FhgfsOpsRemoting_statAndGetParentInfo(app, entryInfo, outFhgfsStat, NULL, NULL);
+   return FhgfsOpsRemoting_statAndGetParentInfo(app, entryInfo, outFhgfsStat, NULL, NULL, NULL);
 }
 
 
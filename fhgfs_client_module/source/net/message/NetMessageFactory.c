@@ -26,6 +26,7 @@
 #include <common/net/message/storage/creating/UnlinkFileRespMsg.h>
 #include <common/net/message/storage/creating/UnlinkLocalFileRespMsg.h>
 #include <common/net/message/storage/listing/ListDirFromOffsetRespMsg.h>
+#include <common/net/message/storage/listing/ListDirPlusRespMsg.h>
 #include <common/net/message/storage/attribs/ListXAttrRespMsg.h>
 #include <common/net/message/storage/attribs/GetXAttrRespMsg.h>
 #include <common/net/message/storage/attribs/RemoveXAttrRespMsg.h>
@@ -47,6 +48,7 @@
 #include <common/net/message/session/locking/FLockEntryRespMsg.h>
 #include <common/net/message/session/locking/FLockRangeRespMsg.h>
 #include <common/net/message/session/locking/LockGrantedMsgEx.h>
+#include <common/net/message/session/LeaseRevokedMsgEx.h>
 
 #include <common/net/message/SimpleMsg.h>
 #include "NetMessageFactory.h"
@@ -234,6 +236,7 @@ NetMessage* NetMessageFactory_createFromMsgType(unsigned short msgType)
       case NETMSGTYPE_MkLocalFileResp: { msg = (NetMessage*)MkLocalFileRespMsg_construct(); } break;
       case NETMSGTYPE_UnlinkLocalFileResp: { msg = (NetMessage*)UnlinkLocalFileRespMsg_construct(); } break;
       case NETMSGTYPE_ListDirFromOffsetResp: { msg = (NetMessage*)ListDirFromOffsetRespMsg_construct(); } break;
+      case NETMSGTYPE_ListDirPlusResp: { msg = (NetMessage*)ListDirPlusRespMsg_construct(); } break;
       case NETMSGTYPE_SetAttrResp: { msg = (NetMessage*)SetAttrRespMsg_construct(); } break;
       case NETMSGTYPE_StatResp: { msg = (NetMessage*)StatRespMsg_construct(); } break;
       case NETMSGTYPE_StatStoragePathResp: { msg = (NetMessage*)StatStoragePathRespMsg_construct(); } break;
@@ -251,6 +254,7 @@ NetMessage* NetMessageFactory_createFromMsgType(unsigned short msgType)
       case NETMSGTYPE_FLockEntryResp: { msg = (NetMessage*)FLockEntryRespMsg_construct(); } break;
       case NETMSGTYPE_FLockRangeResp: { msg = (NetMessage*)FLockRangeRespMsg_construct(); } break;
       case NETMSGTYPE_LockGranted: { msg = (NetMessage*)LockGrantedMsgEx_construct(); } break;
+      case NETMSGTYPE_LeaseRevoked: { msg = (NetMessage*)LeaseRevokedMsgEx_construct(); } break;
 
       default:
       {
@@ -68,6 +68,7 @@ void AbstractConfig::loadDefaults(bool addDashes)
    configMapRedefine("logErrFile",               "", addDashes);
    configMapRedefine("logNumLines",              "50000", addDashes);
    configMapRedefine("logNumRotatedFiles",       "2", addDashes);
+   configMapRedefine("logAsync",                 "false", addDashes);
 
    configMapRedefine("connPortShift",              "0", addDashes);
    configMapRedefine("connClientPortUDP",          "8004", addDashes);
@@ -84,9 +85,11 @@ void AbstractConfig::loadDefaults(bool addDashes)
    configMapRedefine("connBacklogTCP",             "64", addDashes);
    configMapRedefine("connMaxInternodeNum",        "6", addDashes);
    configMapRedefine("connFallbackExpirationSecs", "900", addDashes);
+   configMapRedefine("connMuxChannelsNum",         "0", addDashes);
    configMapRedefine("connRDMABufSize",            "8192", addDashes);
    configMapRedefine("connRDMABufNum",             "70", addDashes);
    configMapRedefine("connRDMATypeOfService",      "0", addDashes);
+   configMapRedefine("connRDMASharedRecvBufNum",   "0", addDashes);
    configMapRedefine("connNetFilterFile",          "", addDashes);
    configMapRedefine("connAuthFile",               "", addDashes);
    configMapRedefine("connTcpOnlyFilterFile",      "", addDashes);
@@ -137,6 +140,9 @@ void AbstractConfig::applyConfigMap(bool enableException, bool addDashes)
       if(testConfigMapKeyMatch(iter, "logNumRotatedFiles", addDashes) )
          logNumRotatedFiles = StringTk::strToInt(iter->second);
       else
+      if(testConfigMapKeyMatch(iter, "logAsync", addDashes) )
+         logAsync = StringTk::strToBool(iter->second);
+      else
       if(testConfigMapKeyMatch(iter, "connPortShift", addDashes) )
          connPortShift = StringTk::strToInt(iter->second);
       else
@@ -187,6 +193,9 @@ void AbstractConfig::applyConfigMap(bool enableException, bool addDashes)
       if(testConfigMapKeyMatch(iter, "connFallbackExpirationSecs", addDashes) )
          connFallbackExpirationSecs = StringTk::strToUInt(iter->second);
       else
+      if(testConfigMapKeyMatch(iter, "connMuxChannelsNum", addDashes) )
+         connMuxChannelsNum = StringTk::strToUInt(iter->second);
+      else
       if(testConfigMapKeyMatch(iter, "connRDMABufSize", addDashes) )
          connRDMABufSize = StringTk::strToUInt(iter->second);
       else
@@ -196,6 +205,9 @@ void AbstractConfig::applyConfigMap(bool enableException, bool addDashes)
       if(testConfigMapKeyMatch(iter, "connRDMATypeOfService", addDashes) )
          connRDMATypeOfService = (uint8_t)StringTk::strToUInt(iter->second);
       else
+      if(testConfigMapKeyMatch(iter, "connRDMASharedRecvBufNum", addDashes) )
+         connRDMASharedRecvBufNum = StringTk::strToUInt(iter->second);
+      else
       if(testConfigMapKeyMatch(iter, "connNetFilterFile", addDashes) )
          connNetFilterFile = iter->second;
       else
@@ -22,6 +22,7 @@ class ICommonConfig
       std::string logErrFile;
       unsigned    logNumLines;
       unsigned    logNumRotatedFiles;
+      bool        logAsync; // queue msgs in per-thread buffers for a separate writer thread
 
       int         connPortShift; // shifts all UDP and TCP ports
       int         connClientPortUDP;
@@ -38,9 +39,11 @@ class ICommonConfig
       unsigned    connBacklogTCP;
       unsigned    connMaxInternodeNum;
       unsigned    connFallbackExpirationSecs;
+      unsigned    connMuxChannelsNum; // multiplexed conns per node (0 to disable)
       unsigned    connRDMABufSize;
       unsigned    connRDMABufNum;
       uint8_t     connRDMATypeOfService;
+      unsigned    connRDMASharedRecvBufNum; // shared recv bufs of incoming conns (0 to disable)
       std::string connNetFilterFile; // for allowed IPs (empty means "allow all")
       std::string connAuthFile;
       uint64_t    connAuthHash; // implicitly set based on hash of connAuthFile contents
@@ -93,6 +96,11 @@ class ICommonConfig
          return logNumRotatedFiles;
       }
 
+      bool getLogAsync() const
+      {
+         return logAsync;
+      }
+
       int getConnClientPortUDP() const
       {
          return connClientPortUDP ? (connClientPortUDP + connPortShift) : 0;
@@ -162,6 +170,11 @@ class ICommonConfig
       {
          return connFallbackExpirationSecs;
       }
+
+      unsigned getConnMuxChannelsNum() const
+      {
+         return connMuxChannelsNum;
+      }
       
       unsigned getConnRDMABufSize() const
       {
@@ -178,6 +191,11 @@ class ICommonConfig
          return connRDMATypeOfService;
       }
 
+      unsigned getConnRDMASharedRecvBufNum() const
+      {
+         return connRDMASharedRecvBufNum;
+      }
+
       std::string getConnNetFilterFile() const
       {
          return connNetFilterFile;
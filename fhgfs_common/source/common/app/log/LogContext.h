@@ -11,13 +11,22 @@
 
 #define LOGCONTEXT_BACKTRACE_ARRAY_SIZE   32
 
+/**
+ * Log via the given LogContext, but only evaluate (i.e. build) msgStr if the level is enabled.
+ */
+#define LOG_CHECKED(logContext, level, msgStr) \
+   do { if( (logContext).isLevelEnabled(level) ) (logContext).log(level, msgStr); } while(0)
+
 #ifdef LOG_DEBUG_MESSAGES
 
    #define LOG_DEBUG(contextStr, level, msgStr) \
-      do { LogContext(contextStr).log(level, msgStr); } while(0)
+      do { \
+         if(LogContext::isLevelEnabledForThread(level) ) \
+            LogContext(contextStr).log(level, msgStr); \
+      } while(0)
 
    #define LOG_DEBUG_CONTEXT(logContext, level, msgStr) \
-      do { (logContext).log(level, msgStr); } while(0)
+      LOG_CHECKED(logContext, level, msgStr)
 
    #define LOG_DEBUG_BACKTRACE() \
       do { LogContext(__func__).logBacktrace(); } while(0)
@@ -39,7 +48,7 @@
 class LogContext
 {
    public:
-      LogContext(const std::string contextStr="<undefined>") : contextStr(contextStr)
+      LogContext(const std::string& contextStr="<undefined>") : contextStr(contextStr)
       {
          AbstractApp* app = PThread::getCurrentThreadApp();
          if(!app)
@@ -59,7 +68,7 @@ class LogContext
          logger->log(logTopic, level, contextStr.c_str(), msg);
       }
 
-      void log(LogTopic logTopic, int level, const std::string msg)
+      void log(LogTopic logTopic, int level, const std::string& msg)
       {
          log(logTopic, level, msg.c_str() );
       }
@@ -69,11 +78,35 @@ class LogContext
          log(LogTopic_GENERAL, level, msg);
       }
 
-      void log(int level, const std::string msg)
+      void log(int level, const std::string& msg)
       {
          log(level, msg.c_str());
       }
 
+      /**
+       * Cheap check to be used before building expensive log message strings.
+       *
+       * @return true if a message of the given level would be logged
+       */
+      bool isLevelEnabled(int level, LogTopic logTopic = LogTopic_GENERAL) const
+      {
+         return likely(logger) && logger->isLevelEnabled(level, logTopic);
+      }
+
+      /**
+       * Same as isLevelEnabled(), but without the need to construct a LogContext first.
+       */
+      static bool isLevelEnabledForThread(int level, LogTopic logTopic = LogTopic_GENERAL)
+      {
+         AbstractApp* app = PThread::getCurrentThreadApp();
+         if(unlikely(!app) )
+            return false;
+
+         Logger* logger = app->getLogger();
+
+         return likely(logger) && logger->isLevelEnabled(level, logTopic);
+      }
+
       void logErr(const char* msg)
       {
          if(unlikely(!logger) )
@@ -82,7 +115,7 @@ class LogContext
          logger->logErr(contextStr.c_str(), msg);
       }
 
-      void logErr(const std::string msg)
+      void logErr(const std::string& msg)
       {
          logErr(msg.c_str() );
       }
@@ -106,7 +139,7 @@ class LogContext
          SAFE_FREE(backtraceSymbols);
       }
 
-      void setContext(const std::string contextStr)
+      void setContext(const std::string& contextStr)
       {
          // note: mind the thread-safety
          // (e.g. don't change the name while multiple threads are accessing the context)
@@ -116,7 +149,7 @@ class LogContext
       
 
    protected:
-      LogContext(Logger* logger, const std::string context) : contextStr(context)
+      LogContext(Logger* logger, const std::string& context) : contextStr(context)
       {
          // for derived classes that have a different way of finding the logger
          // (other than via the thread-local storage)
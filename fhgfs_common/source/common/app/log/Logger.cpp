@@ -3,11 +3,17 @@
 #include <common/toolkit/TimeAbs.h>
 #include "Logger.h"
 
+#include <queue>
+#include <signal.h>
 #include <time.h>
 
 #define LOGGER_ROTATED_FILE_SUFFIX  ".old-"
 #define LOGGER_TIMESTR_SIZE         32
 
+#define LOGGER_ASYNC_FLUSHER_THREADNAME   "LogFlusher"
+#define LOGGER_ASYNC_BLOCKED_WAIT_MS      10 /* recheck interval for threads with full ring */
+#define LOGGER_ASYNC_DROPPED_REPORT_MS    5000 /* min interval between "dropped msgs" reports */
+
 // Note: Keep in sync with enum LogTopic
 const Logger::LogTopicElem Logger::LogTopics[] =
 {
@@ -31,7 +37,8 @@ Logger::Logger(ICommonConfig* cfg)
    this->logErrFile = cfg->getLogErrFile();
    this->logNumLines = cfg->getLogNumLines();
    this->logNumRotatedFiles = cfg->getLogNumRotatedFiles();
-   
+   this->logAsync = cfg->getLogAsync();
+
    this->stdFile = stdout;
    this->errFile = stderr;
    
@@ -50,10 +57,16 @@ Logger::Logger(ICommonConfig* cfg)
 
    // prepare file handles and rotate
    prepareLogFiles();
+
+   if(logAsync)
+      startAsyncFlusher();
 }
 
 Logger::~Logger()
 {
+   if(logAsync)
+      stopAsyncFlusher();
+
    // close files
    if(this->stdFile != stdout)
       fclose(this->stdFile);
@@ -70,19 +83,18 @@ Logger::~Logger()
  * Note: Doesn't lock the outputLock
  * 
  * @param level the level of relevance (should be greater than 0)
+ * @param time the time at which the message was logged
  * @param msg the actual log message
  */
-void Logger::logGrantedUnlocked(int level, const char* threadName, const char* context,
-   const char* msg)
+void Logger::logGrantedUnlocked(int level, TimeAbs& time, const char* threadName,
+   const char* context, const char* msg)
 {
    char timeStr[LOGGER_TIMESTR_SIZE];
 
-   TimeAbs nowTime;
-
-   getTimeStr(nowTime.getTimeS(), timeStr, LOGGER_TIMESTR_SIZE);
+   getTimeStr(time.getTimeS(), timeStr, LOGGER_TIMESTR_SIZE);
 
 #ifdef BEEGFS_DEBUG_PROFILING
-   uint64_t timeMicroS = nowTime.getTimeMicroSecPart(); // additional micro-s info for timestamp
+   uint64_t timeMicroS = time.getTimeMicroSecPart(); // additional micro-s info for timestamp
 
    fprintf(stdFile, "(%d) %s.%06ld %s [%s] >> %s\n", level, timeStr, (long) timeMicroS,
       threadName, context, msg);
@@ -96,13 +108,22 @@ void Logger::logGrantedUnlocked(int level, const char* threadName, const char* c
 }
 
 /**
- * Wrapper for logGrantedUnlocked that locks/unlocks the outputMutex.
+ * Wrapper for logGrantedUnlocked that locks/unlocks the outputMutex (or queues the message in
+ * async mode).
  */
 void Logger::logGranted(int level, const char* threadName, const char* context, const char* msg)
 {
+   if(logAsync)
+   {
+      logAsyncEnqueue(level, false, threadName, context, msg);
+      return;
+   }
+
+   TimeAbs nowTime;
+
    pthread_rwlock_rdlock(&this->rwLock);
 
-   logGrantedUnlocked(level, threadName, context, msg);
+   logGrantedUnlocked(level, nowTime, threadName, context, msg);
 
    pthread_rwlock_unlock(&this->rwLock);
 
@@ -111,20 +132,19 @@ void Logger::logGranted(int level, const char* threadName, const char* context,
 
 /**
  * Prints a message to the error log.
- * 
+ * Note: Doesn't lock the outputLock
+ *
+ * @param time the time at which the message was logged
  * @param msg the actual log message
  */
-void Logger::logErrGranted(const char* threadName, const char* context, const char* msg)
+void Logger::logErrGrantedUnlocked(TimeAbs& time, const char* threadName, const char* context,
+   const char* msg)
 {
-   pthread_rwlock_rdlock(&this->rwLock);
-   
-   TimeAbs nowTime;
-
    char timeStr[LOGGER_TIMESTR_SIZE];
-   getTimeStr(nowTime.getTimeS(), timeStr, LOGGER_TIMESTR_SIZE);
+   getTimeStr(time.getTimeS(), timeStr, LOGGER_TIMESTR_SIZE);
       
 #ifdef BEEGFS_DEBUG_PROFILING
-   uint64_t timeMicroS = nowTime.getTimeMicroSecPart(); // additional ms info for timestamp
+   uint64_t timeMicroS = time.getTimeMicroSecPart(); // additional ms info for timestamp
 
    fprintf(errFile, "(E) %s.%06ld %s [%s] >> %s\n", timeStr, (long) timeMicroS,
       threadName, context, msg);
@@ -135,10 +155,29 @@ void Logger::logErrGranted(const char* threadName, const char* context, const ch
    //fflush(errFile); // no longer needed => line buf 
    
    currentNumErrLines.increase();
+}
+
+/**
+ * Wrapper for logErrGrantedUnlocked that locks/unlocks the outputMutex (or queues the message in
+ * async mode).
+ */
+void Logger::logErrGranted(const char* threadName, const char* context, const char* msg)
+{
+   if(logAsync)
+   {
+      logAsyncEnqueue(Log_ERR, true, threadName, context, msg);
+      return;
+   }
+
+   TimeAbs nowTime;
+
+   pthread_rwlock_rdlock(&this->rwLock);
+
+   logErrGrantedUnlocked(nowTime, threadName, context, msg);
+
    pthread_rwlock_unlock(&this->rwLock);
 
    rotateErrLogChecked();
-   
 }
 
 /**
@@ -148,9 +187,22 @@ void Logger::logBacktraceGranted(const char* context, int backtraceLength, char*
 {
    std::string threadName = PThread::getCurrentThreadName();
 
+   if(logAsync)
+   { // queue as a single multi-line msg to keep the order relative to the other msgs of this thread
+      std::string backtraceStr("Backtrace:");
+
+      for(int i=0; i < backtraceLength; i++)
+         backtraceStr += "\n" + StringTk::intToStr(i+1) + ": " + backtraceSymbols[i];
+
+      logAsyncEnqueue(1, false, threadName.c_str(), context, backtraceStr.c_str() );
+      return;
+   }
+
+   TimeAbs nowTime;
+
    pthread_rwlock_rdlock(&this->rwLock);
    
-   logGrantedUnlocked(1, threadName.c_str(), context, "Backtrace:");
+   logGrantedUnlocked(1, nowTime, threadName.c_str(), context, "Backtrace:");
    
    for(int i=0; i < backtraceLength; i++)
    {
@@ -300,3 +352,350 @@ void Logger::rotateErrLogChecked()
 
    pthread_rwlock_unlock(&this->rwLock);
 }
+
+/**
+ * Position of the flusher in the pending msgs of one ring. Cursors are ordered by the time of
+ * their current entry, latest first, so that a std::priority_queue returns the oldest msg.
+ */
+struct Logger::AsyncRingCursor
+{
+   AsyncRingCursor(AsyncLogRing* ring, unsigned end) : ring(ring), end(end) {}
+
+   AsyncLogRing* ring;
+   unsigned end; // head of the ring at the time the flusher started its pass
+
+   AsyncLogEntry& getEntry() const
+   {
+      return ring->entries[ring->tail & (LOGGER_ASYNC_RING_SIZE - 1)];
+   }
+
+   bool operator<(const AsyncRingCursor& other) const
+   {
+      return other.getEntry().time < getEntry().time;
+   }
+};
+
+/**
+ * Queues a msg in the ring of the calling thread for the flusher thread (async mode).
+ *
+ * If the ring is full, msgs with a level above Log_WARNING are dropped; all others wait for the
+ * flusher to make room, so that important msgs are never lost.
+ */
+void Logger::logAsyncEnqueue(int level, bool isErr, const char* threadName, const char* context,
+   const char* msg)
+{
+   TimeAbs nowTime;
+   AsyncLogRing* ring = getThreadRing();
+   unsigned head = ring->head;
+   bool wasBlocked = false;
+
+   while(unlikely( (head - ring->tail) >= LOGGER_ASYNC_RING_SIZE) )
+   { // ring is full
+      if( (level > Log_WARNING) && !isErr)
+      {
+         numAsyncDropped.increase();
+         return;
+      }
+
+      if(!wasBlocked)
+      {
+         numAsyncBlocked.increase();
+         wasBlocked = true;
+      }
+
+      struct timespec timeout;
+      clock_gettime(CLOCK_REALTIME, &timeout);
+      timeout.tv_nsec += LOGGER_ASYNC_BLOCKED_WAIT_MS * 1000 * 1000;
+      timeout.tv_sec += timeout.tv_nsec / (1000*1000*1000);
+      timeout.tv_nsec %= (1000*1000*1000);
+
+      pthread_mutex_lock(&flusherMutex);
+
+      if(unlikely(flusherShallStop) )
+      { // we're shutting down, nobody will flush this ring anymore
+         pthread_mutex_unlock(&flusherMutex);
+         numAsyncDropped.increase();
+         return;
+      }
+
+      pthread_cond_signal(&flusherCond);
+      pthread_cond_timedwait(&spaceCond, &flusherMutex, &timeout);
+
+      pthread_mutex_unlock(&flusherMutex);
+   }
+
+   AsyncLogEntry& entry = ring->entries[head & (LOGGER_ASYNC_RING_SIZE - 1)];
+
+   entry.level = level;
+   entry.isErr = isErr;
+   entry.time = nowTime;
+   entry.threadName = threadName;
+   entry.context = context;
+   entry.msg = msg;
+
+   __sync_synchronize(); // entry must be complete before the flusher can see the new head
+
+   ring->head = head + 1;
+
+   /* wake up the flusher early when the ring is half full. (note: we don't take the mutex here,
+      so the signal might get lost if the flusher is not waiting yet, but then it will come back
+      after its interval anyways.) */
+   if( (head + 1 - ring->tail) == (LOGGER_ASYNC_RING_SIZE / 2) )
+      pthread_cond_signal(&flusherCond);
+}
+
+/**
+ * @return the ring of the calling thread (created on first use)
+ */
+Logger::AsyncLogRing* Logger::getThreadRing()
+{
+   AsyncLogRing* ring = (AsyncLogRing*)pthread_getspecific(ringKey);
+   if(likely(ring) )
+      return ring;
+
+   ring = new AsyncLogRing();
+
+   pthread_mutex_lock(&ringsMutex);
+
+   ring->next = rings;
+   rings = ring;
+
+   pthread_mutex_unlock(&ringsMutex);
+
+   pthread_setspecific(ringKey, ring);
+
+   return ring;
+}
+
+/**
+ * Thread-specific data destructor for the ring of an exiting thread. The ring is only marked here,
+ * because the flusher might still need to write its remaining msgs.
+ */
+void Logger::asyncRingOrphanStatic(void* ring)
+{
+   __sync_synchronize(); // the last head update must be visible before the orphan flag
+
+   ( (AsyncLogRing*)ring)->isOrphaned = true;
+}
+
+/**
+ * Init the async mode data structures and start the flusher thread. Falls back to synchronous
+ * logging if the thread cannot be created.
+ */
+void Logger::startAsyncFlusher()
+{
+   this->rings = NULL;
+   this->flusherShallStop = false;
+   this->numAsyncDroppedReported = 0;
+
+   pthread_key_create(&ringKey, asyncRingOrphanStatic);
+   pthread_mutex_init(&ringsMutex, NULL);
+   pthread_mutex_init(&flusherMutex, NULL);
+   pthread_cond_init(&flusherCond, NULL);
+   pthread_cond_init(&spaceCond, NULL);
+
+   int createRes = pthread_create(&flusherThread, NULL, asyncFlusherStatic, this);
+   if(createRes)
+   {
+      fprintf(stderr, "Logger: Unable to start flusher thread. Falling back to synchronous "
+         "logging. (SysErr: %s)\n", strerror(createRes) );
+
+      pthread_cond_destroy(&spaceCond);
+      pthread_cond_destroy(&flusherCond);
+      pthread_mutex_destroy(&flusherMutex);
+      pthread_mutex_destroy(&ringsMutex);
+      pthread_key_delete(ringKey);
+
+      this->logAsync = false;
+   }
+}
+
+/**
+ * Stop the flusher thread after it wrote all queued msgs and free the async mode data
+ * structures.
+ */
+void Logger::stopAsyncFlusher()
+{
+   pthread_mutex_lock(&flusherMutex);
+
+   flusherShallStop = true;
+   pthread_cond_signal(&flusherCond);
+   pthread_cond_broadcast(&spaceCond); // release threads waiting for a full ring
+
+   pthread_mutex_unlock(&flusherMutex);
+
+   pthread_join(flusherThread, NULL);
+
+   // (remaining threads would now log synchronously, but they shouldn't log at this point anyways)
+   this->logAsync = false;
+
+   pthread_key_delete(ringKey); // note: doesn't call the orphan destructor for live threads
+
+   while(rings)
+   {
+      AsyncLogRing* nextRing = rings->next;
+      delete(rings);
+      rings = nextRing;
+   }
+
+   pthread_cond_destroy(&spaceCond);
+   pthread_cond_destroy(&flusherCond);
+   pthread_mutex_destroy(&flusherMutex);
+   pthread_mutex_destroy(&ringsMutex);
+}
+
+void* Logger::asyncFlusherStatic(void* logger)
+{
+   // signals (e.g. SIGINT) shall be handled by the app threads
+   sigset_t signalMask;
+   sigfillset(&signalMask);
+   pthread_sigmask(SIG_BLOCK, &signalMask, NULL);
+
+   ( (Logger*)logger)->asyncFlusherLoop();
+
+   return NULL;
+}
+
+/**
+ * Main loop of the flusher thread: Periodically (or when woken up by a logging thread) writes
+ * the queued msgs of all rings. Does a final flush before it exits.
+ */
+void Logger::asyncFlusherLoop()
+{
+   pthread_mutex_lock(&flusherMutex);
+
+   while(!flusherShallStop)
+   {
+      struct timespec timeout;
+      clock_gettime(CLOCK_REALTIME, &timeout);
+      timeout.tv_nsec += LOGGER_ASYNC_FLUSH_INTERVAL_MS * 1000 * 1000;
+      timeout.tv_sec += timeout.tv_nsec / (1000*1000*1000);
+      timeout.tv_nsec %= (1000*1000*1000);
+
+      pthread_cond_timedwait(&flusherCond, &flusherMutex, &timeout);
+
+      pthread_mutex_unlock(&flusherMutex);
+
+      flushAsyncRings();
+      reportAsyncDropped(false);
+
+      pthread_mutex_lock(&flusherMutex);
+
+      pthread_cond_broadcast(&spaceCond);
+   }
+
+   pthread_mutex_unlock(&flusherMutex);
+
+   flushAsyncRings();
+   reportAsyncDropped(true);
+}
+
+/**
+ * Writes all msgs that are currently queued in the rings, merged by their timestamps. Also frees
+ * the rings of exited threads once they are empty.
+ *
+ * Note: Only called by the flusher thread.
+ */
+void Logger::flushAsyncRings()
+{
+   std::priority_queue<AsyncRingCursor> cursors;
+
+   pthread_mutex_lock(&ringsMutex);
+
+   for(AsyncLogRing** ringLink = &rings; *ringLink; )
+   {
+      AsyncLogRing* ring = *ringLink;
+
+      bool isOrphaned = ring->isOrphaned;
+
+      __sync_synchronize(); // for orphans, the head that we read below is final
+
+      unsigned head = ring->head;
+
+      if(ring->tail != head)
+         cursors.push(AsyncRingCursor(ring, head) );
+      else
+      if(isOrphaned)
+      { // owner thread exited and ring is empty => free it
+         *ringLink = ring->next;
+         delete(ring);
+         continue;
+      }
+
+      ringLink = &ring->next;
+   }
+
+   pthread_mutex_unlock(&ringsMutex);
+
+   if(cursors.empty() )
+      return;
+
+   __sync_synchronize(); // entries up to the heads that we read above are complete
+
+   pthread_rwlock_rdlock(&this->rwLock);
+
+   while(!cursors.empty() )
+   {
+      AsyncRingCursor cursor = cursors.top();
+      cursors.pop();
+
+      AsyncLogEntry& entry = cursor.getEntry();
+
+      if(entry.isErr)
+         logErrGrantedUnlocked(entry.time, entry.threadName.c_str(), entry.context.c_str(),
+            entry.msg.c_str() );
+      else
+         logGrantedUnlocked(entry.level, entry.time, entry.threadName.c_str(),
+            entry.context.c_str(), entry.msg.c_str() );
+
+      __sync_synchronize(); // done with the entry before the owner thread may reuse it
+
+      cursor.ring->tail = cursor.ring->tail + 1;
+
+      if(cursor.ring->tail != cursor.end)
+         cursors.push(cursor); // re-insert with the time of its next entry
+   }
+
+   pthread_rwlock_unlock(&this->rwLock);
+
+   rotateStdLogChecked();
+   rotateErrLogChecked();
+}
+
+/**
+ * Logs the number of msgs that were dropped since the last report (if any).
+ *
+ * Note: Only called by the flusher thread.
+ *
+ * @param force true to ignore the minimum interval between reports
+ */
+void Logger::reportAsyncDropped(bool force)
+{
+   uint64_t numDropped = numAsyncDropped.read();
+
+   if(numDropped == numAsyncDroppedReported)
+      return;
+
+   if(!force && (lastAsyncDroppedReportT.elapsedMS() < LOGGER_ASYNC_DROPPED_REPORT_MS) )
+      return;
+
+   lastAsyncDroppedReportT.setToNow();
+
+   std::string msg = "Dropped log messages because of full buffers: " +
+      StringTk::uint64ToStr(numDropped - numAsyncDroppedReported) + " "
+      "(total dropped: " + StringTk::uint64ToStr(numDropped) + "; "
+      "total blocked: " + StringTk::uint64ToStr(numAsyncBlocked.read() ) + ")";
+
+   numAsyncDroppedReported = numDropped;
+
+   TimeAbs nowTime;
+
+   pthread_rwlock_rdlock(&this->rwLock);
+
+   logGrantedUnlocked(Log_WARNING, nowTime, LOGGER_ASYNC_FLUSHER_THREADNAME, "Logger",
+      msg.c_str() );
+
+   pthread_rwlock_unlock(&this->rwLock);
+
+   rotateStdLogChecked();
+}
@@ -5,8 +5,13 @@
 #include <common/app/config/InvalidConfigException.h>
 #include <common/threading/Atomics.h>
 #include <common/threading/PThread.h>
+#include <common/toolkit/TimeAbs.h>
 #include <common/Common.h>
 
+
+#define LOGGER_ASYNC_RING_SIZE            1024 /* entries per thread (must be a power of 2) */
+#define LOGGER_ASYNC_FLUSH_INTERVAL_MS    100 /* max delay until flusher writes queued msgs */
+
 enum LogLevel
 {
    Log_ERR=0, /* system error */
@@ -37,6 +42,37 @@ class Logger
 
       static const LogTopicElem LogTopics[];
 
+      /**
+       * A queued log message of the async mode. The strings are reused by later messages of the
+       * same thread, so that steady state logging doesn't need to allocate memory.
+       */
+      struct AsyncLogEntry
+      {
+         int level;
+         bool isErr; // true for the error log
+         TimeAbs time;
+         std::string threadName;
+         std::string context;
+         std::string msg;
+      };
+
+      /**
+       * Single-producer/single-consumer ring of queued log messages. Each logging thread owns one
+       * ring (the producer), the flusher thread is the only consumer.
+       */
+      struct AsyncLogRing
+      {
+         AsyncLogRing() : head(0), tail(0), isOrphaned(false), next(NULL) {}
+
+         AsyncLogEntry entries[LOGGER_ASYNC_RING_SIZE];
+         volatile unsigned head; // next entry to write (only modified by the owner thread)
+         volatile unsigned tail; // next entry to flush (only modified by the flusher)
+         volatile bool isOrphaned; // owner thread exited => freed by flusher after draining
+         AsyncLogRing* next; // list of all rings (protected by ringsMutex)
+      };
+
+      struct AsyncRingCursor;
+
    public:
       Logger(ICommonConfig* cfg);
       ~Logger();
@@ -61,12 +97,40 @@ class Logger
       AtomicUInt64 currentNumErrLines;
       std::string rotatedFileSuffix;
 
-      void logGrantedUnlocked(int level, const char* threadName, const char* context,
+      // async mode (see logAsync config option)
+      bool logAsync;
+      pthread_key_t ringKey; // thread-specific AsyncLogRing of the calling thread
+      pthread_mutex_t ringsMutex; // protects the rings list
+      AsyncLogRing* rings; // list of all rings
+      pthread_t flusherThread;
+      pthread_mutex_t flusherMutex; // for flusherCond, spaceCond and flusherShallStop
+      pthread_cond_t flusherCond; // signaled to wake up the flusher before its interval ends
+      pthread_cond_t spaceCond; // broadcasted by the flusher after it emptied the rings
+      bool flusherShallStop;
+      AtomicUInt64 numAsyncDropped; // msgs dropped because their ring was full
+      AtomicUInt64 numAsyncBlocked; // times a thread had to wait for the flusher
+      uint64_t numAsyncDroppedReported; // only accessed by flusher
+      TimeAbs lastAsyncDroppedReportT; // only accessed by flusher
+
+      void logGrantedUnlocked(int level, TimeAbs& time, const char* threadName,
+         const char* context, const char* msg);
+      void logErrGrantedUnlocked(TimeAbs& time, const char* threadName, const char* context,
          const char* msg);
       void logGranted(int level, const char* threadName, const char* context, const char* msg);
       void logErrGranted(const char* threadName, const char* context, const char* msg);
       void logBacktraceGranted(const char* context, int backtraceLength, char** backtraceSymbols);
-      
+
+      void logAsyncEnqueue(int level, bool isErr, const char* threadName, const char* context,
+         const char* msg);
+      AsyncLogRing* getThreadRing();
+      void startAsyncFlusher();
+      void stopAsyncFlusher();
+      void asyncFlusherLoop();
+      void flushAsyncRings();
+      void reportAsyncDropped(bool force);
+      static void* asyncFlusherStatic(void* logger);
+      static void asyncRingOrphanStatic(void* ring);
+
       void prepareLogFiles() throw(InvalidConfigException);
       size_t getTimeStr(uint64_t seconds, char* buf, size_t bufLen);
       void rotateLogFile(std::string filename);
@@ -94,7 +158,7 @@ class Logger
       /**
        * Just a wrapper for the normal log() method which takes "const char*" arguments.
        */
-      void log(LogTopic logTopic, int level, const std::string context, const std::string msg)
+      void log(LogTopic logTopic, int level, const std::string& context, const std::string& msg)
       {
          if(level > logLevels[logTopic])
             return;
@@ -107,7 +171,7 @@ class Logger
          log(LogTopic_GENERAL, level, context, msg);
       }
 
-      void log(int level, const std::string context, const std::string msg)
+      void log(int level, const std::string& context, const std::string& msg)
       {
          log(level, context.c_str(), msg.c_str());
       }
@@ -145,7 +209,7 @@ class Logger
       /**
        * Just a wrapper for the normal logErr() method which takes "const char*" arguments.
        */
-      void logErr(const std::string context, const std::string msg)
+      void logErr(const std::string& context, const std::string& msg)
       {
          logErr(context.c_str(), msg.c_str() );
       }
@@ -178,8 +242,36 @@ class Logger
          logBacktraceGranted(context, backtraceLength, backtraceSymbols);
       }
       
+      /**
+       * Cheap check to be used before building expensive log message strings.
+       *
+       * @return true if a message of the given level would be logged
+       */
+      bool isLevelEnabled(int level, LogTopic logTopic = LogTopic_GENERAL) const
+      {
+         return level <= logLevels[logTopic];
+      }
+
       // getters & setters
-      
+
+      /**
+       * @return number of msgs that were dropped in async mode because the ring buffer of the
+       *    logging thread was full
+       */
+      uint64_t getNumAsyncDropped()
+      {
+         return numAsyncDropped.read();
+      }
+
+      /**
+       * @return number of times that a thread had to wait for free ring buffer space in async
+       *    mode (only for msgs that are too important to be dropped)
+       */
+      uint64_t getNumAsyncBlocked()
+      {
+         return numAsyncBlocked.read();
+      }
+
       /**
        * Note: This method is not thread-safe.
        */
@@ -24,13 +24,35 @@
 #define STORAGEBENCH_ERROR_RUNTIME_CLEANUP_JOB_ACTIVE 25
 
 
-// map for throughput results; key: targetID, value: throughput in kb/s
+#define STORAGEBENCH_DEFAULT_READ_PERCENT             50 // for StorageBenchType_RANDMIXED
+
+
+// map for throughput results; key: targetID, value: throughput in kb/s (files/s for CREATE)
 typedef std::map<uint16_t, int64_t> StorageBenchResultsMap;
 typedef StorageBenchResultsMap::iterator StorageBenchResultsMapIter;
 typedef StorageBenchResultsMap::const_iterator StorageBenchResultsMapCIter;
 typedef StorageBenchResultsMap::value_type StorageBenchResultsMapVal;
 
 
+/*
+ * latency percentiles of the single operations (one block or one file) of a target in microsecs
+ */
+struct StorageBenchLatencyResult
+{
+   StorageBenchLatencyResult() : p50(0), p99(0), p999(0) {}
+
+   int64_t p50;
+   int64_t p99;
+   int64_t p999;
+};
+
+// map for latency results; key: targetID
+typedef std::map<uint16_t, StorageBenchLatencyResult> StorageBenchLatencyResultsMap;
+typedef StorageBenchLatencyResultsMap::iterator StorageBenchLatencyResultsMapIter;
+typedef StorageBenchLatencyResultsMap::const_iterator StorageBenchLatencyResultsMapCIter;
+typedef StorageBenchLatencyResultsMap::value_type StorageBenchLatencyResultsMapVal;
+
+
 /*
  * enum for the action parameter of the storage benchmark
  */
@@ -45,14 +67,26 @@ enum StorageBenchAction
 
 /*
  * enum for the different benchmark types
+ * note: see STORAGEBENCHTYPE_IS_RANDOM and STORAGEBENCHTYPE_NEEDS_DATA
  */
 enum StorageBenchType
 {
    StorageBenchType_READ = 0,
    StorageBenchType_WRITE = 1,
-   StorageBenchType_NONE = 2
+   StorageBenchType_NONE = 2,
+   StorageBenchType_RANDREAD = 3, // read blocks at random offsets
+   StorageBenchType_RANDWRITE = 4, // write blocks at random offsets
+   StorageBenchType_RANDMIXED = 5, // random reads and writes with a given read percentage
+   StorageBenchType_CREATE = 6 // create, write and unlink small files (size of a block)
 };
 
+#define STORAGEBENCHTYPE_IS_RANDOM(type) ( (type == StorageBenchType_RANDREAD) || \
+   (type == StorageBenchType_RANDWRITE) || (type == StorageBenchType_RANDMIXED) )
+
+// types that read existing benchmark files (which are created by a previous write benchmark)
+#define STORAGEBENCHTYPE_NEEDS_DATA(type) ( (type == StorageBenchType_READ) || \
+   (type == StorageBenchType_RANDREAD) || (type == StorageBenchType_RANDMIXED) )
+
 /*
  * enum for the states of the state machine of the storage benchmark operator
  * note: see STORAGEBENCHSTATUS_IS_ACTIVE
@@ -92,6 +92,8 @@ bool StreamListener::initSocks(unsigned short listenPort, NicListCapabilities* l
       try
       {
          rdmaListenSock = new RDMASocket();
+         rdmaListenSock->setSharedRecvBuffers(
+            cfg->getConnRDMASharedRecvBufNum(), cfg->getConnRDMABufSize() );
          rdmaListenSock->bind(listenPort);
          rdmaListenSock->listen();
 
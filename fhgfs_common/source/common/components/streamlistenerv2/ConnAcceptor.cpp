@@ -60,6 +60,8 @@ bool ConnAcceptor::initSocks(unsigned short listenPort, NicListCapabilities* loc
       try
       {
          rdmaListenSock = new RDMASocket();
+         rdmaListenSock->setSharedRecvBuffers(
+            cfg->getConnRDMASharedRecvBufNum(), cfg->getConnRDMABufSize() );
          rdmaListenSock->bind(listenPort);
          rdmaListenSock->listen();
 
@@ -249,10 +251,7 @@ void ConnAcceptor::onIncomingStandardConnection(StandardSocket* sock)
       // hand the socket over to a stream listener
 
       StreamListenerV2* listener = app->getStreamListenerByFD(acceptedSock->getFD() );
-      StreamListenerV2::SockReturnPipeInfo returnInfo(
-         StreamListenerV2::SockPipeReturn_NEWCONN, acceptedSock);
-
-      listener->getSockReturnFD()->write(&returnInfo, sizeof(returnInfo) );
+      listener->returnSock(StreamListenerV2::SockPipeReturn_NEWCONN, acceptedSock);
 
    }
    catch(SocketException& se)
@@ -302,10 +301,7 @@ void ConnAcceptor::onIncomingRDMAConnection(RDMASocket* sock)
          // hand the socket over to a stream listener
 
          StreamListenerV2* listener = app->getStreamListenerByFD(acceptedSock->getFD() );
-         StreamListenerV2::SockReturnPipeInfo returnInfo(
-            StreamListenerV2::SockPipeReturn_NEWCONN, acceptedSock);
-
-         listener->getSockReturnFD()->write(&returnInfo, sizeof(returnInfo) );
+         listener->returnSock(StreamListenerV2::SockPipeReturn_NEWCONN, acceptedSock);
 
       }
       catch(SocketException& se)
@@ -3,6 +3,7 @@
 #include <common/components/streamlistenerv2/StreamListenerV2.h>
 #include <common/threading/PThread.h>
 #include <common/net/message/NetMessage.h>
+#include <common/net/sock/MuxReplySocket.h>
 #include "IncomingPreprocessedMsgWork.h"
 
 
@@ -67,6 +68,33 @@ void IncomingPreprocessedMsgWork::process(char* bufIn, unsigned bufInLen,
          return;
       }
 
+      // multiplexed conn => return the sock early, so that further requests can be processed in
+      //    parallel (responses are sent through the send channel of the conn)
+
+      if(msgHeader.msgMuxID || isMultiplexedConn(sock) )
+      {
+         if(unlikely(!msgHeader.msgMuxID || (sock->getSockType() == NICADDRTYPE_RDMA) ) )
+         { // peers must not mix classic and multiplexed msgs on a conn
+            LogContext(logContextStr).log(Log_NOTICE,
+               std::string("Received a msg with unexpected multiplexing mode. Disconnecting: ") +
+               sock->getPeername() );
+
+            sock->unsetStats();
+            invalidateConnection(sock);
+            delete(msg);
+
+            return;
+         }
+
+         MuxSendChannel* sendChannel = ( (StandardSocket*)sock)->initMuxSendChannel();
+         Socket* replySock = new MuxReplySocket(sock, sendChannel, msgHeader.msgMuxID);
+
+         releaseSocket(app, &sock, NULL);
+
+         sock = replySock;
+         sock->setStats(&stats);
+      }
+
       // process the received msg
 
       bool processRes = false;
@@ -157,6 +185,12 @@ void IncomingPreprocessedMsgWork::releaseSocket(AbstractApp* app, Socket** sock,
    if(msg)
       msg->setReleaseSockAfterProcessing(false);
 
+   if(dynamic_cast<MuxReplySocket*>(sockCopy) )
+   { // multiplexed request (the conn was already returned to the stream listener in process() )
+      delete(sockCopy);
+      return;
+   }
+
    sockCopy->unsetStats();
 
    // check for immediate data on rdma sockets
@@ -168,13 +202,19 @@ void IncomingPreprocessedMsgWork::releaseSocket(AbstractApp* app, Socket** sock,
       return;
    }
 
-   // no immediate data available => return the socket to a stream listener
-
    StreamListenerV2* listener = app->getStreamListenerByFD(sockCopy->getFD() );
-   StreamListenerV2::SockReturnPipeInfo returnInfo(
-      StreamListenerV2::SockPipeReturn_MSGDONE_NOIMMEDIATE, sockCopy);
 
-   listener->getSockReturnFD()->write(&returnInfo, sizeof(returnInfo) );
+   // check whether the peer already sent the next msg over this conn
+
+   if( (sockCopy->getSockType() != NICADDRTYPE_RDMA) && listener->getDrainPipelinedMsgs() &&
+      listener->dispatchPipelinedMsg( (StandardSocket*)sockCopy) )
+   { // (socket was handed over to a new work)
+      return;
+   }
+
+   // no immediate data available => return the socket to a stream listener
+
+   listener->returnSock(StreamListenerV2::SockPipeReturn_MSGDONE_NOIMMEDIATE, sockCopy);
 }
 
 void IncomingPreprocessedMsgWork::invalidateConnection(Socket* sock)
@@ -193,6 +233,17 @@ void IncomingPreprocessedMsgWork::invalidateConnection(Socket* sock)
    delete(sock);
 }
 
+/**
+ * Check whether a multiplexed msg was received over this conn before.
+ */
+bool IncomingPreprocessedMsgWork::isMultiplexedConn(Socket* sock)
+{
+   if(sock->getSockType() == NICADDRTYPE_RDMA)
+      return false;
+
+   return ( (StandardSocket*)sock)->getMuxSendChannel() != NULL;
+}
+
 /**
  * Checks whether there is more immediate data available on an RDMASocket.
  * 
@@ -231,10 +282,8 @@ bool IncomingPreprocessedMsgWork::checkRDMASocketImmediateData(AbstractApp* app,
          std::string("Got immediate data: ") + sock->getPeername() );
 
       StreamListenerV2* listener = app->getStreamListenerByFD(sock->getFD() );
-      StreamListenerV2::SockReturnPipeInfo returnInfo(
-         StreamListenerV2::SockPipeReturn_MSGDONE_WITHIMMEDIATE, sock);
 
-      listener->getSockReturnFD()->write(&returnInfo, sizeof(returnInfo) );
+      listener->returnSock(StreamListenerV2::SockPipeReturn_MSGDONE_WITHIMMEDIATE, sock);
 
       return true;
    }
@@ -29,6 +29,7 @@ class IncomingPreprocessedMsgWork : public Work
       static void releaseSocket(AbstractApp* app, Socket** sock, NetMessage* msg);
       static void invalidateConnection(Socket* sock);
       static bool checkRDMASocketImmediateData(AbstractApp* app, Socket* sock);
+      static bool isMultiplexedConn(Socket* sock);
 
 
    private:
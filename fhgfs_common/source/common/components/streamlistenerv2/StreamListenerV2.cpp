@@ -4,6 +4,7 @@
 #include "StreamListenerV2.h"
 
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 
 
 #define EPOLL_EVENTS_NUM             (512) /* make it big to avoid starvation of higher FDs */
@@ -11,7 +12,7 @@
 #define RDMA_CHECK_INTERVAL_MS       (150*60*1000) /* 150mins (must be more than double of the
                                      client-side idle disconnect interval to avoid cases where
                                      server disconnects first) */
-#define SOCKRETURN_SOCKS_NUM         (32)
+#define MSG_RECV_TIMEOUT_MS          (5000)
 
 
 StreamListenerV2::StreamListenerV2(std::string listenerID, AbstractApp* app,
@@ -26,6 +27,17 @@ StreamListenerV2::StreamListenerV2(std::string listenerID, AbstractApp* app,
    rdmaCheckForceCounter = 0;
 
    useAggressivePoll = false;
+   drainPipelinedMsgs = false;
+
+   // init sock return ring (slot sequence numbers start with the position of the slot)
+
+   sockReturnRing = new SockReturnRingSlot[STREAMLISTENERV2_SOCKRETURN_RING_SIZE];
+
+   for(size_t i=0; i < STREAMLISTENERV2_SOCKRETURN_RING_SIZE; i++)
+      sockReturnRing[i].seq.set(i);
+
+   sockReturnRingHead = 0;
+   sockReturnEventFD = NULL;
 
    int epollCreateSize = 10; // size "10" is just a hint (and is actually ignored since Linux 2.6.8)
 
@@ -36,13 +48,26 @@ StreamListenerV2::StreamListenerV2(std::string listenerID, AbstractApp* app,
          System::getErrString() );
    }
 
-   if(!initSockReturnPipe() )
-      throw ComponentInitException("Unable to initialize sock return pipe");
+   if(!initSockReturnEvent() )
+      throw ComponentInitException("Unable to initialize sock return eventfd");
 }
 
 StreamListenerV2::~StreamListenerV2()
 {
-   delete(sockReturnPipe);
+   // delete socks that were returned, but not handled anymore by the listener
+
+   SockReturnPipeInfo returnInfo;
+
+   while(popSockReturnInfo(&returnInfo) )
+      delete(returnInfo.sock);
+
+   delete[](sockReturnRing);
+
+   if(sockReturnEventFD)
+   {
+      close(sockReturnEventFD->getFD() );
+      delete(sockReturnEventFD);
+   }
 
    deleteAllConns();
 
@@ -50,16 +75,23 @@ StreamListenerV2::~StreamListenerV2()
       close(epollFD);
 }
 
-bool StreamListenerV2::initSockReturnPipe()
+bool StreamListenerV2::initSockReturnEvent()
 {
-   this->sockReturnPipe = new Pipe(false, true);
+   int eventFD = eventfd(0, EFD_NONBLOCK);
+   if(eventFD == -1)
+   {
+      log.logErr(std::string("Unable to create sock return eventfd: ") + System::getErrString() );
+      return false;
+   }
+
+   this->sockReturnEventFD = new FileDescriptor(eventFD, false);
 
    struct epoll_event epollEvent;
    epollEvent.events = EPOLLIN;
-   epollEvent.data.ptr = sockReturnPipe->getReadFD();
-   if(epoll_ctl(epollFD, EPOLL_CTL_ADD, sockReturnPipe->getReadFD()->getFD(), &epollEvent) == -1)
+   epollEvent.data.ptr = sockReturnEventFD;
+   if(epoll_ctl(epollFD, EPOLL_CTL_ADD, eventFD, &epollEvent) == -1)
    {
-      log.logErr(std::string("Unable to add sock return pipe (read side) to epoll set: ") +
+      log.logErr(std::string("Unable to add sock return eventfd to epoll set: ") +
          System::getErrString() );
       return false;
    }
@@ -91,7 +123,7 @@ void StreamListenerV2::listenLoop()
 
    // (just to have these values on the stack...)
    const int epollFD = this->epollFD;
-   FileDescriptor* sockReturnPipeReadEnd = this->sockReturnPipe->getReadFD();
+   FileDescriptor* sockReturnEventFD = this->sockReturnEventFD;
 
    bool runRDMAConnIdleCheck = false; // true just means we call the method (not enforce the check)
 
@@ -121,6 +153,8 @@ void StreamListenerV2::listenLoop()
          runRDMAConnIdleCheck = true;
       }
 
+      bool gotSockReturn = false;
+
       // handle incoming data & connection attempts
       for(size_t i=0; i < (size_t)epollRes; i++)
       {
@@ -130,12 +164,17 @@ void StreamListenerV2::listenLoop()
          //log.log(Log_DEBUG, std::string("Incoming data on FD: ") +
          //   StringTk::intToStr(pollArray[i].fd) ); // debug in
 
-         if(currentPollable == sockReturnPipeReadEnd)
-            onSockReturn();
+         if(currentPollable == sockReturnEventFD)
+            gotSockReturn = true;
          else
             onIncomingData( (Socket*)currentPollable);
       }
 
+      /* (note: returned socks are handled after the incoming data of this round, so that all socks
+         returned in the meantime are re-armed in a single batch) */
+      if(gotSockReturn)
+         onSockReturn();
+
       if(unlikely(runRDMAConnIdleCheck) )
       { // note: whether check actually happens depends on elapsed time since last check
          runRDMAConnIdleCheck = false;
@@ -160,55 +199,20 @@ void StreamListenerV2::onIncomingData(Socket* sock)
 
    try
    {
-      const int recvTimeoutMS = 5000;
-
       char msgHeaderBuf[NETMSG_HEADER_LENGTH];
       NetMessageHeader msgHeader;
 
       // receive & deserialize message header
 
-      sock->recvExactT(msgHeaderBuf, NETMSG_HEADER_LENGTH, 0, recvTimeoutMS);
+      sock->recvExactT(msgHeaderBuf, NETMSG_HEADER_LENGTH, 0, MSG_RECV_TIMEOUT_MS);
 
       NetMessage::deserializeHeader(msgHeaderBuf, NETMSG_HEADER_LENGTH, &msgHeader);
 
-      /* (note on header verification: we leave header verification work to the worker threads to
-         save CPU cycles in the stream listener and instead just take what we need to know here, no
-         matter whether the header is valid or not.) */
-
-      // create work and add it to queue
-
-      //log.log(Log_DEBUG, "Creating new work for to the queue");
-
-      IncomingPreprocessedMsgWork* work = new IncomingPreprocessedMsgWork(app, sock, &msgHeader);
-
       int sockFD = sock->getFD(); /* note: we store this here for delayed pollList removal, because
             worker thread might disconnect, so the sock gets deleted by the worker and thus "sock->"
             pointer becomes invalid */
 
-      sock->setHasActivity(); // mark sock as active (for idle disconnect check)
-
-      //log.log(Log_DEBUG, "Adding new work to the queue");
-
-      /* (note on mirror queue: if we ever have more than a single mirror msg, it would be more
-         efficient to set/introduce a generic msg header feature flag that is set by all mirror msgs
-         and can be tested here.) */
-
-      // (note: userID intToStr (not uint) because default userID (~0) looks better this way)
-      LOG_DEBUG("StreamListenerV2::onIncomingData", Log_DEBUG,
-         "Incoming message: " + NetMsgStrMapping().defineToStr(msgHeader.msgType) + "; "
-         "from: " + sock->getPeername() + "; "
-         "userID: " + StringTk::intToStr(msgHeader.msgUserID) + "; " +
-         (msgHeader.msgTargetID ? "targetID: " + StringTk::uintToStr(msgHeader.msgTargetID) : "") );
-
-      if(msgHeader.msgType == NETMSGTYPE_MirrorMetadata)
-         getWorkQueue(msgHeader.msgTargetID)->addMirrorWork(work, msgHeader.msgUserID);
-      else
-      if(sock->getIsDirect() )
-         getWorkQueue(msgHeader.msgTargetID)->addDirectWork(work, msgHeader.msgUserID);
-      else
-         getWorkQueue(msgHeader.msgTargetID)->addIndirectWork(work, msgHeader.msgUserID);
-
-      //log.log(Log_DEBUG, "Added new work to the queue");
+      addIncomingMsgWork(sock, &msgHeader);
 
       /* notes on sock handling:
          *) no need to remove sock from epoll set, because we use edge-triggered mode with
@@ -245,129 +249,319 @@ void StreamListenerV2::onIncomingData(Socket* sock)
 }
 
 /**
- * Receive pointer to returned socket through the sockReturnPipe and re-add it to the pollList.
+ * Create a work for a msg of which the header was already received and add it to the right queue.
+ *
+ * Note: The caller must not access the sock after calling this, because a worker might
+ * already be processing the msg.
  */
-void StreamListenerV2::onSockReturn()
+void StreamListenerV2::addIncomingMsgWork(Socket* sock, NetMessageHeader* msgHeader)
 {
-   SockReturnPipeInfo returnInfos[SOCKRETURN_SOCKS_NUM];
+   /* (note on header verification: we leave header verification work to the worker threads to
+      save CPU cycles in the stream listener and instead just take what we need to know here, no
+      matter whether the header is valid or not.) */
+
+   // create work and add it to queue
+
+   //log.log(Log_DEBUG, "Creating new work for to the queue");
+
+   IncomingPreprocessedMsgWork* work = new IncomingPreprocessedMsgWork(app, sock, msgHeader);
+
+   sock->setHasActivity(); // mark sock as active (for idle disconnect check)
+
+   //log.log(Log_DEBUG, "Adding new work to the queue");
+
+   /* (note on mirror queue: if we ever have more than a single mirror msg, it would be more
+      efficient to set/introduce a generic msg header feature flag that is set by all mirror msgs
+      and can be tested here.) */
+
+   // (note: userID intToStr (not uint) because default userID (~0) looks better this way)
+   LOG_DEBUG("StreamListenerV2::addIncomingMsgWork", Log_DEBUG,
+      "Incoming message: " + NetMsgStrMapping().defineToStr(msgHeader->msgType) + "; "
+      "from: " + sock->getPeername() + "; "
+      "userID: " + StringTk::intToStr(msgHeader->msgUserID) + "; " +
+      (msgHeader->msgTargetID ? "targetID: " + StringTk::uintToStr(msgHeader->msgTargetID) : "") );
+
+   if(msgHeader->msgType == NETMSGTYPE_MirrorMetadata)
+      getWorkQueue(msgHeader->msgTargetID)->addMirrorWork(work, msgHeader->msgUserID);
+   else
+   if(sock->getIsDirect() )
+      getWorkQueue(msgHeader->msgTargetID)->addDirectWork(work, msgHeader->msgUserID);
+   else
+      getWorkQueue(msgHeader->msgTargetID)->addIndirectWork(work, msgHeader->msgUserID);
+
+   //log.log(Log_DEBUG, "Added new work to the queue");
+}
+
+/**
+ * Called by a worker after it finished processing a msg to check whether the peer already sent the
+ * next msg over this connection (without waiting for the response to the previous msg).
+ *
+ * If so, the header of the next msg is received and the new work is queued directly, so that the
+ * sock doesn't take the detour through the return ring and the epoll set of the listener.
+ *
+ * Note: Can be called by any thread that currently owns the sock.
+ *
+ * @return true if the sock was handed over to a new work (or was disconnected due to an error),
+ * false if no data was immediately available (=> caller needs to return the sock).
+ */
+bool StreamListenerV2::dispatchPipelinedMsg(StandardSocket* sock)
+{
+   const char* logContext = "StreamListenerV2 (dispatch pipelined msg)";
+
+   try
+   {
+      char msgHeaderBuf[NETMSG_HEADER_LENGTH];
+      NetMessageHeader msgHeader;
+
+      ssize_t recvRes = sock->recvNonblocking(msgHeaderBuf, NETMSG_HEADER_LENGTH);
+      if(!recvRes)
+         return false; // nothing pipelined
+
+      if(recvRes < NETMSG_HEADER_LENGTH)
+      { // we got the beginning of a header => rest is on its way
+         sock->recvExactT(&msgHeaderBuf[recvRes], NETMSG_HEADER_LENGTH - recvRes, 0,
+            MSG_RECV_TIMEOUT_MS);
+      }
+
+      NetMessage::deserializeHeader(msgHeaderBuf, NETMSG_HEADER_LENGTH, &msgHeader);
+
+      addIncomingMsgWork(sock, &msgHeader);
+
+      return true;
+   }
+   catch(SocketTimeoutException& e)
+   {
+      LogContext(logContext).log(Log_NOTICE, "Connection timed out: " + sock->getPeername() );
+   }
+   catch(SocketDisconnectException& e)
+   {
+      // (note: level Log_DEBUG here to avoid spamming the log until we have log topics)
+      LogContext(logContext).log(Log_DEBUG, std::string(e.what() ) );
+   }
+   catch(SocketException& e)
+   {
+      LogContext(logContext).log(Log_NOTICE,
+         "Connection error: " + sock->getPeername() + ": " + std::string(e.what() ) );
+   }
 
-   // try to get multiple returnInfos at once (if available)
+   // socket exception occurred => cleanup
 
-   ssize_t readRes = sockReturnPipe->getReadFD()->read(&returnInfos, sizeof(SockReturnPipeInfo) );
+   IncomingPreprocessedMsgWork::invalidateConnection(sock); // also includes delete(sock)
 
-   // loop: walk over each info and handle the contained socket
+   return true;
+}
 
-   for(size_t i=0; ; i++)
+/**
+ * Hand a sock over to this listener (e.g. after a worker is done with a msg or for a new conn).
+ *
+ * This is lock-free for the common case. The listener only gets woken up through the eventfd if
+ * it was not notified already, so that many returns in a short time only cost a single syscall.
+ *
+ * Note: Can be called by any thread.
+ */
+void StreamListenerV2::returnSock(SockPipeReturnType returnType, Socket* sock)
+{
+   const size_t ringMask = STREAMLISTENERV2_SOCKRETURN_RING_SIZE - 1;
+
+   size_t pos = sockReturnRingTail.read();
+
+   for( ; ; )
    {
-      SockReturnPipeInfo& currentReturnInfo = returnInfos[i];
+      SockReturnRingSlot* slot = &sockReturnRing[pos & ringMask];
+      ssize_t seqDiff = (ssize_t)(slot->seq.read() - pos);
+
+      if(likely(!seqDiff) )
+      { // slot is free for this position => try to claim it
+         if(sockReturnRingTail.compareAndSet(pos+1, pos) )
+         {
+            slot->returnInfo = SockReturnPipeInfo(returnType, sock);
 
-      // make sure we have a complete SockReturnPipeInfo
+            __sync_synchronize(); // (returnInfo must be visible before the slot is marked filled)
 
-      if(unlikely(readRes < (ssize_t)sizeof(SockReturnPipeInfo) ) )
-      { // only got a partial SockReturnPipeInfo => recv the rest
-         char* currentReturnInfoChar = (char*)&currentReturnInfo;
+            slot->seq.set(pos+1);
+            break;
+         }
+      }
+      else
+      if(seqDiff < 0)
+      { // ring is full => use the overflow list
+         SafeMutexLock mutexLock(&sockReturnOverflowMutex);
 
-         sockReturnPipe->getReadFD()->readExact(
-            &currentReturnInfoChar[readRes], sizeof(SockReturnPipeInfo)-readRes);
+         sockReturnOverflowList.push_back(SockReturnPipeInfo(returnType, sock) );
+         numSockReturnOverflows.increase();
 
-         readRes = sizeof(SockReturnPipeInfo);
+         mutexLock.unlock();
+         break;
       }
 
-      // handle returnInfo depending on contained returnType...
+      // another producer was faster => retry with new position
+      pos = sockReturnRingTail.read();
+   }
 
-      Socket* currentSock = currentReturnInfo.sock;
-      SockPipeReturnType returnType = currentReturnInfo.returnType;
+   // wake up the listener (unless another thread already did that)
 
-      //LOG_DEBUG("StreamListenerV2::onSockReturn", Log_SPAM,
-      //   std::string("Socket returned (through pipe). SockFD: ") +
-      //   StringTk::intToStr(currentSock->getFD() ) );
+   if(sockReturnNotifyPending.compareAndSet(1, 0) )
+   {
+      uint64_t eventValue = 1;
+      sockReturnEventFD->write(&eventValue, sizeof(eventValue) );
+   }
+}
 
+/**
+ * Get the next returned sock from the ring (or from the overflow list).
+ *
+ * Note: Only for the listener thread (single consumer).
+ *
+ * @return false if no returned sock is available
+ */
+bool StreamListenerV2::popSockReturnInfo(SockReturnPipeInfo* outReturnInfo)
+{
+   const size_t ringMask = STREAMLISTENERV2_SOCKRETURN_RING_SIZE - 1;
 
-      switch(returnType)
+   SockReturnRingSlot* slot = &sockReturnRing[sockReturnRingHead & ringMask];
+
+   if(slot->seq.read() != (sockReturnRingHead + 1) )
+   { /* slot not filled (yet) => check overflow list. (note: a producer that claimed this slot, but
+        didn't fill it yet, will notify us afterwards.) */
+      if(likely(!numSockReturnOverflows.read() ) )
+         return false;
+
+      SafeMutexLock mutexLock(&sockReturnOverflowMutex);
+
+      bool listEmpty = sockReturnOverflowList.empty();
+      if(!listEmpty)
       {
-         case SockPipeReturn_MSGDONE_NOIMMEDIATE:
-         { // most likely case: worker is done with a msg and now returns the sock to the epoll set
+         *outReturnInfo = sockReturnOverflowList.front();
+         sockReturnOverflowList.pop_front();
+         numSockReturnOverflows.decrease();
+      }
 
-            struct epoll_event epollEvent;
-            epollEvent.events = EPOLLIN | EPOLLONESHOT | EPOLLET;
-            epollEvent.data.ptr = currentSock;
+      mutexLock.unlock();
 
-            int epollRes = epoll_ctl(epollFD, EPOLL_CTL_MOD, currentSock->getFD(), &epollEvent);
+      return !listEmpty;
+   }
 
-            if(likely(!epollRes) )
-            { // sock was successfully re-armed in epoll set
-               pollList.add(currentSock);
+   __sync_synchronize(); // (don't read returnInfo before the seq check)
 
-               break; // break out of switch
-            }
-            else
-            if(errno != ENOENT)
-            { // error
-               log.logErr("Unable to re-arm sock in epoll set. "
-                  "FD: " + StringTk::uintToStr(currentSock->getFD() ) + "; "
-                  "SockTypeNum: " + StringTk::uintToStr(currentSock->getSockType() ) + "; "
-                  "SysErr: " + System::getErrString() );
-               log.log(Log_NOTICE, "Disconnecting: " + currentSock->getPeername() );
+   *outReturnInfo = slot->returnInfo;
 
-               delete(currentSock);
+   __sync_synchronize(); // (returnInfo must be read before the slot is handed back to producers)
 
-               break; // break out of switch
-            }
+   slot->seq.set(sockReturnRingHead + STREAMLISTENERV2_SOCKRETURN_RING_SIZE);
+   sockReturnRingHead++;
 
-            /* for ENOENT, we fall through to NEWCONN, because this socket appearently wasn't
-               used with this stream listener yet, so we need to add it (instead of modify it) */
+   return true;
+}
 
-         } // might fall through here on ENOENT
+/**
+ * Take all returned socks from the return ring and re-add them to the pollList.
+ */
+void StreamListenerV2::onSockReturn()
+{
+   uint64_t eventValue;
 
-         case SockPipeReturn_NEWCONN:
-         { // new conn from ConnAcceptor (or wasn't used with this stream listener yet)
+   // reset the eventfd counter before we reset the notification flag
 
-            // add new socket file descriptor to epoll set
+   sockReturnEventFD->read(&eventValue, sizeof(eventValue) );
 
-            struct epoll_event epollEvent;
-            epollEvent.events = EPOLLIN | EPOLLONESHOT | EPOLLET;
-            epollEvent.data.ptr = currentSock;
+   /* (note: compareAndSet instead of set, because we need a full memory barrier here. producers
+      that return a sock after this point will notify us again, all others already filled their
+      slots, so we will see their socks below.) */
+   sockReturnNotifyPending.compareAndSet(0, 1);
 
-            int epollRes = epoll_ctl(epollFD, EPOLL_CTL_ADD, currentSock->getFD(), &epollEvent);
-            if(likely(!epollRes) )
-            { // socket was successfully added to epoll set
-               pollList.add(currentSock);
-            }
-            else
-            { // adding to epoll set failed => unrecoverable error
-               log.logErr("Unable to add sock to epoll set. "
-                  "FD: " + StringTk::uintToStr(currentSock->getFD() ) + " "
-                  "SockTypeNum: " + StringTk::uintToStr(currentSock->getSockType() ) + " "
-                  "SysErr: " + System::getErrString() );
-               log.log(Log_NOTICE, "Disconnecting: " + currentSock->getPeername() );
+   SockReturnPipeInfo returnInfo;
 
-               delete(currentSock);
-            }
+   while(popSockReturnInfo(&returnInfo) )
+      handleSockReturn(returnInfo);
+}
 
-         } break;
+/**
+ * Handle a single returned sock depending on the contained returnType.
+ */
+void StreamListenerV2::handleSockReturn(SockReturnPipeInfo& returnInfo)
+{
+   Socket* currentSock = returnInfo.sock;
+   SockPipeReturnType returnType = returnInfo.returnType;
+
+   //LOG_DEBUG("StreamListenerV2::handleSockReturn", Log_SPAM,
+   //   std::string("Socket returned. SockFD: ") + StringTk::intToStr(currentSock->getFD() ) );
+
+   switch(returnType)
+   {
+      case SockPipeReturn_MSGDONE_NOIMMEDIATE:
+      { // most likely case: worker is done with a msg and now returns the sock to the epoll set
 
-         case SockPipeReturn_MSGDONE_WITHIMMEDIATE:
-         { // special case: worker detected that immediate data is available after msg processing
-            // data immediately available => recv header and so on
-            onIncomingData(currentSock);
-         } break;
+         struct epoll_event epollEvent;
+         epollEvent.events = EPOLLIN | EPOLLONESHOT | EPOLLET;
+         epollEvent.data.ptr = currentSock;
 
-         default:
-         { // should never happen: unknown/unhandled returnType
-            log.logErr("Should never happen: "
-               "Unknown socket return type: " + StringTk::uintToStr(returnType) );
-         } break;
+         int epollRes = epoll_ctl(epollFD, EPOLL_CTL_MOD, currentSock->getFD(), &epollEvent);
 
-      } // end of switch(returnType)
+         if(likely(!epollRes) )
+         { // sock was successfully re-armed in epoll set
+            pollList.add(currentSock);
 
+            break; // break out of switch
+         }
+         else
+         if(errno != ENOENT)
+         { // error
+            log.logErr("Unable to re-arm sock in epoll set. "
+               "FD: " + StringTk::uintToStr(currentSock->getFD() ) + "; "
+               "SockTypeNum: " + StringTk::uintToStr(currentSock->getSockType() ) + "; "
+               "SysErr: " + System::getErrString() );
+            log.log(Log_NOTICE, "Disconnecting: " + currentSock->getPeername() );
+
+            delete(currentSock);
+
+            break; // break out of switch
+         }
+
+         /* for ENOENT, we fall through to NEWCONN, because this socket appearently wasn't
+            used with this stream listener yet, so we need to add it (instead of modify it) */
+
+      } // might fall through here on ENOENT
+
+      case SockPipeReturn_NEWCONN:
+      { // new conn from ConnAcceptor (or wasn't used with this stream listener yet)
+
+         // add new socket file descriptor to epoll set
+
+         struct epoll_event epollEvent;
+         epollEvent.events = EPOLLIN | EPOLLONESHOT | EPOLLET;
+         epollEvent.data.ptr = currentSock;
+
+         int epollRes = epoll_ctl(epollFD, EPOLL_CTL_ADD, currentSock->getFD(), &epollEvent);
+         if(likely(!epollRes) )
+         { // socket was successfully added to epoll set
+            pollList.add(currentSock);
+         }
+         else
+         { // adding to epoll set failed => unrecoverable error
+            log.logErr("Unable to add sock to epoll set. "
+               "FD: " + StringTk::uintToStr(currentSock->getFD() ) + " "
+               "SockTypeNum: " + StringTk::uintToStr(currentSock->getSockType() ) + " "
+               "SysErr: " + System::getErrString() );
+            log.log(Log_NOTICE, "Disconnecting: " + currentSock->getPeername() );
+
+            delete(currentSock);
+         }
 
+      } break;
 
-      readRes -= sizeof(SockReturnPipeInfo);
-      if(!readRes)
-         break; // all received returnInfos have been processed
+      case SockPipeReturn_MSGDONE_WITHIMMEDIATE:
+      { // special case: worker detected that immediate data is available after msg processing
+         // data immediately available => recv header and so on
+         onIncomingData(currentSock);
+      } break;
 
-   } // end of "for each received SockReturnPipeInfo" loop
+      default:
+      { // should never happen: unknown/unhandled returnType
+         log.logErr("Should never happen: "
+            "Unknown socket return type: " + StringTk::uintToStr(returnType) );
+      } break;
 
+   } // end of switch(returnType)
 }
 
 /**
@@ -8,12 +8,16 @@
 #include <common/net/sock/RDMASocket.h>
 #include <common/net/message/NetMessage.h>
 #include <common/nodes/Node.h>
+#include <common/threading/Atomics.h>
 #include <common/threading/PThread.h>
 #include <common/toolkit/poll/PollList.h>
-#include <common/toolkit/Pipe.h>
+#include <common/toolkit/FileDescriptor.h>
 #include <common/Common.h>
 
 
+#define STREAMLISTENERV2_SOCKRETURN_RING_SIZE   (1024) /* must be a power of two */
+
+
 class AbstractApp; // forward declaration
 
 
@@ -30,7 +34,7 @@ class StreamListenerV2 : public PThread
       };
 
       /**
-       * This is what we will send over the socket return pipe
+       * This is what we will put into the socket return ring
        */
       struct SockReturnPipeInfo
       {
@@ -49,6 +53,21 @@ class StreamListenerV2 : public PThread
          Socket* sock;
       };
 
+      /**
+       * A slot of the socket return ring.
+       *
+       * The sequence number tells the state of the slot: seq==pos means free for the producer that
+       * got position pos, seq==pos+1 means filled and ready for the consumer.
+       */
+      struct SockReturnRingSlot
+      {
+         AtomicSizeT seq;
+         SockReturnPipeInfo returnInfo;
+      };
+
+      typedef std::list<SockReturnPipeInfo> SockReturnPipeInfoList;
+      typedef SockReturnPipeInfoList::iterator SockReturnPipeInfoListIter;
+
 
    public:
       StreamListenerV2(std::string listenerID, AbstractApp* app, MultiWorkQueue* workQueue)
@@ -64,14 +83,26 @@ class StreamListenerV2 : public PThread
 
       int               epollFD;
       PollList          pollList;
-      Pipe*             sockReturnPipe;
+
+      /* returned sockets are put into a lock-free ring (multiple producers, the listener as single
+         consumer) and the listener is woken up through an eventfd, which is only written if the
+         listener was not notified already. the overflow list is only used if the ring is full. */
+      FileDescriptor*      sockReturnEventFD;
+      SockReturnRingSlot*  sockReturnRing;
+      AtomicSizeT          sockReturnRingTail; // next position for producers
+      size_t               sockReturnRingHead; // next position for the consumer (listener thread)
+      AtomicUInt32         sockReturnNotifyPending; // 1 if eventfd was written, but not handled yet
+      Mutex                sockReturnOverflowMutex;
+      SockReturnPipeInfoList sockReturnOverflowList; // (protected by sockReturnOverflowMutex)
+      AtomicSizeT          numSockReturnOverflows; // length of sockReturnOverflowList
       
       Time              rdmaCheckT;
       int               rdmaCheckForceCounter;
 
       bool              useAggressivePoll; // true to not sleep on epoll and burn CPU
+      bool              drainPipelinedMsgs; // true to let workers dispatch next msg of a sock
 
-      bool initSockReturnPipe();
+      bool initSockReturnEvent();
       bool initSocks(unsigned short listenPort, NicListCapabilities* localNicCaps);
 
       virtual void run();
@@ -79,6 +110,8 @@ class StreamListenerV2 : public PThread
       
       void onIncomingData(Socket* sock);
       void onSockReturn();
+      void handleSockReturn(SockReturnPipeInfo& returnInfo);
+      bool popSockReturnInfo(SockReturnPipeInfo* outReturnInfo);
       void rdmaConnIdleCheck();
       
       bool isFalseAlarm(RDMASocket* sock);
@@ -87,12 +120,13 @@ class StreamListenerV2 : public PThread
 
       
    public:
+      void returnSock(SockPipeReturnType returnType, Socket* sock);
+      void addIncomingMsgWork(Socket* sock, NetMessageHeader* msgHeader);
+      bool dispatchPipelinedMsg(StandardSocket* sock);
+
+
       // getters & setters
-      FileDescriptor* getSockReturnFD() const
-      {
-         return sockReturnPipe->getWriteFD();
-      }
-      
+
       /**
        * Only effective when set before running this component.
        */
@@ -101,6 +135,20 @@ class StreamListenerV2 : public PThread
          this->useAggressivePoll = true;
       }
 
+      /**
+       * Enable direct dispatching of further msgs that a client sent over the same connection
+       * without waiting for the previous response (see dispatchPipelinedMsg() ).
+       */
+      void setDrainPipelinedMsgs()
+      {
+         this->drainPipelinedMsgs = true;
+      }
+
+      bool getDrainPipelinedMsgs() const
+      {
+         return drainPipelinedMsgs;
+      }
+
 
    protected:
       // getters & setters
@@ -25,6 +25,11 @@ class AbstractWorkContainer
       virtual bool getIsEmpty() = 0;
 
       virtual void getStatsAsStr(std::string& outStats) = 0;
+
+      /**
+       * Create a new empty container of the same type (e.g. for the shards of a MultiWorkQueue).
+       */
+      virtual AbstractWorkContainer* createEmptyContainer() = 0;
 };
 
 
@@ -57,6 +57,11 @@ class ListWorkContainer : public AbstractWorkContainer
 
          outStats = statsStream.str();
       }
+
+      AbstractWorkContainer* createEmptyContainer()
+      {
+         return new ListWorkContainer();
+      }
 };
 
 
@@ -1,156 +1,377 @@
+#include <common/system/System.h>
 #include "MultiWorkQueue.h"
 #include "PersonalWorkQueue.h"
 
 
-MultiWorkQueue::MultiWorkQueue()
+/* the shard for the next non-user-assigned work of the current (producer) thread. we use a
+   thread-local round-robin counter here to avoid another shared cacheline in the hot path. */
+static __thread unsigned nextAddShardIdx = 0;
+
+
+/**
+ * @param numShards number of independently locked queue parts; 0 means number of online CPUs
+ * (limited to MULTIWORKQUEUE_MAX_AUTO_SHARDS). Only as many shards as there are workers will
+ * receive new work.
+ */
+MultiWorkQueue::MultiWorkQueue(unsigned numShards)
 {
-   numPendingWorks = 0;
-   lastWorkListVecIdx = 0;
+   if(!numShards)
+   {
+      try
+      {
+         numShards = BEEGFS_MIN(System::getNumOnlineCPUs(), MULTIWORKQUEUE_MAX_AUTO_SHARDS);
+      }
+      catch(InvalidConfigException& e)
+      {
+         numShards = 1;
+      }
+   }
 
-   directWorkList = new ListWorkContainer();
-   indirectWorkList = new ListWorkContainer();
-   mirrorWorkList = new ListWorkContainer();
+   this->numShards = numShards;
+   this->assignIndirectWorkByUser = false;
 
-   // we use QueueWorkType_... as vec index, so order must be same as in QueueWorkType
-   workListVec.push_back(directWorkList);
-   workListVec.push_back(indirectWorkList);
-   workListVec.push_back(mirrorWorkList);
+   for(unsigned i=0; i < numShards; i++)
+   {
+      MultiWorkQueueShard* shard = new MultiWorkQueueShard();
 
-   HighResolutionStatsTk::resetStats(&stats);
+      shard->numPendingWorks = 0;
+      shard->lastWorkListVecIdx = 0;
+
+      // we use QueueWorkType_... as vec index, so order must be same as in QueueWorkType
+      shard->workListVec.push_back(new ListWorkContainer() ); // direct
+      shard->workListVec.push_back(new ListWorkContainer() ); // indirect
+      shard->workListVec.push_back(new ListWorkContainer() ); // mirror
+
+      for(unsigned type=0; type < QueueWorkType_FINAL_DONTUSE; type++)
+      {
+         shard->numIdleWorkers[type] = 0;
+         shard->numWakeups[type] = 0;
+      }
+
+      HighResolutionStatsTk::resetStats(&shard->stats);
+
+      shardVec.push_back(shard);
+   }
 }
 
 MultiWorkQueue::~MultiWorkQueue()
 {
-   delete(directWorkList);
-   delete(indirectWorkList);
-   delete(mirrorWorkList);
+   for(MultiWorkQueueShardVec::iterator iter = shardVec.begin(); iter != shardVec.end(); iter++)
+   {
+      MultiWorkQueueShard* shard = *iter;
+
+      for(WorkListVecIter listIter = shard->workListVec.begin();
+          listIter != shard->workListVec.end();
+          listIter++)
+         delete(*listIter);
+
+      delete(shard);
+   }
 }
 
 /**
- * The common code base of waitForMirrorWork and waitForDirectWork.
+ * Get the next work for the given worker type from the given shard.
+ *
+ * Note: Caller must hold the shard mutex.
+ *
+ * @return NULL if the shard has no work for this worker type.
  */
-Work* MultiWorkQueue::waitForWorkByQueue(HighResolutionStats& newStats,
-   PersonalWorkQueue* personalWorkQueue, AbstractWorkContainer* waitWorkQ,
-   Condition& waitNewWorkCond)
+Work* MultiWorkQueue::getAndPopWorkUnlocked(MultiWorkQueueShard* shard, QueueWorkType workerType)
 {
-   Work* work;
+   if(workerType != QueueWorkType_INDIRECT)
+   { // specialized worker
+      AbstractWorkContainer* workList = shard->workListVec[workerType];
 
-   SafeMutexLock mutexLock(&mutex); // L O C K
+      if(workList->getIsEmpty() )
+         return NULL;
 
-   HighResolutionStatsTk::addHighResIncStats(newStats, stats);
-   stats.rawVals.busyWorkers--;
+      shard->numPendingWorks--;
 
-   while(waitWorkQ->getIsEmpty() && likely(personalWorkQueue->getIsWorkListEmpty() ) )
-      waitNewWorkCond.wait(&mutex);
+      return workList->getAndPopNextWork();
+   }
 
-   stats.rawVals.busyWorkers++;
+   // indirect worker
 
-   // personal is always first
-   if(unlikely(!personalWorkQueue->getIsWorkListEmpty() ) )
-   { // we got something in our personal queue
-      work = personalWorkQueue->getAndPopFirstWork();
-   }
-   else
+   if(!shard->numPendingWorks)
+      return NULL;
+
+   // sanity check: ensure numPendingWorks and actual number of works are equal
+   #ifdef BEEGFS_DEBUG
+      size_t numQueuedWorks = 0;
+
+      for(unsigned i=0; i < QueueWorkType_FINAL_DONTUSE; i++)
+         numQueuedWorks += shard->workListVec[i]->getSize();
+
+      if(unlikely(numQueuedWorks != shard->numPendingWorks) )
+         throw MultiWorkQueueException("numQueuedWorks != numPendingWorks: " +
+            StringTk::uint64ToStr(numQueuedWorks) + "!=" +
+            StringTk::uint64ToStr(shard->numPendingWorks) );
+   #endif // BEEGFS_DEBUG
+
+   // walk over all available queues
+   // (note: lastWorkListVecIdx ensures that all queue are checked in a fair way)
+
+   for(unsigned i=0; i < QueueWorkType_FINAL_DONTUSE; i++)
    {
-      work = waitWorkQ->getAndPopNextWork();
+      // switch to next work queue
+      shard->lastWorkListVecIdx++;
+      shard->lastWorkListVecIdx = shard->lastWorkListVecIdx % QueueWorkType_FINAL_DONTUSE;
 
-      numPendingWorks--;
-   }
+      AbstractWorkContainer* currentWorkList = shard->workListVec[shard->lastWorkListVecIdx];
 
-   mutexLock.unlock(); // U N L O C K
+      if(!currentWorkList->getIsEmpty() )
+      { // this queue contains work for us
+         shard->numPendingWorks--;
 
-   return work;
-}
+         return currentWorkList->getAndPopNextWork();
+      }
+   }
 
+   // we should never get here: all queues are empty
 
-Work* MultiWorkQueue::waitForMirrorWork(HighResolutionStats& newStats,
-   PersonalWorkQueue* personalWorkQueue)
-{
-   return waitForWorkByQueue(newStats, personalWorkQueue, mirrorWorkList, newMirrorWorkCond);
+   throw MultiWorkQueueException("Unexpected in " + std::string(__func__) + ": "
+      "All queues are empty. "
+      "numPendingWorks: " + StringTk::uint64ToStr(shard->numPendingWorks) );
 }
 
-Work* MultiWorkQueue::waitForDirectWork(HighResolutionStats& newStats,
-   PersonalWorkQueue* personalWorkQueue)
+/**
+ * Try to get work from the shards other than the home shard (locks each of them separately).
+ *
+ * @return NULL if no other shard has work for this worker type.
+ */
+Work* MultiWorkQueue::stealWork(unsigned homeShardIdx, QueueWorkType workerType)
 {
-   return waitForWorkByQueue(newStats, personalWorkQueue, directWorkList, newDirectWorkCond);
+   for(unsigned i=1; i < numShards; i++)
+   {
+      MultiWorkQueueShard* shard = shardVec[(homeShardIdx + i) % numShards];
+
+      SafeMutexLock mutexLock(&shard->mutex); // L O C K
+
+      Work* work = getAndPopWorkUnlocked(shard, workerType);
+
+      mutexLock.unlock(); // U N L O C K
+
+      if(work)
+         return work;
+   }
+
+   return NULL;
 }
 
 /**
- * Wait for work on any of the avialable queues. This is for indirect (non-specialized) workers.
+ * The common code base of all waitFor...Work() methods.
  *
- * @param newStats the updated stats from processing of the last work package.
- * @param personalWorkQueue the personal queue of the worker thread which called this method.
+ * Before a worker goes to sleep, it registers itself as idle in its home shard and then checks all
+ * other shards. Producers check for idle workers while holding the lock of the shard to which they
+ * added their work, so either the idle worker finds the new work or the producer finds the idle
+ * worker and wakes it up.
  */
-Work* MultiWorkQueue::waitForAnyWork(HighResolutionStats& newStats,
-   PersonalWorkQueue* personalWorkQueue)
+Work* MultiWorkQueue::waitForWorkByType(HighResolutionStats& newStats,
+   PersonalWorkQueue* personalWorkQueue, QueueWorkType workerType)
 {
    Work* work;
 
-   SafeMutexLock mutexLock(&mutex); // L O C K
+   const unsigned homeShardIdx = getHomeShardIdx(personalWorkQueue);
+   MultiWorkQueueShard* homeShard = shardVec[homeShardIdx];
 
-   HighResolutionStatsTk::addHighResIncStats(newStats, stats);
-   stats.rawVals.busyWorkers--;
+   SafeMutexLock mutexLock(&homeShard->mutex); // L O C K
 
-   while(!numPendingWorks && likely(personalWorkQueue->getIsWorkListEmpty() ) )
-   { // no work available right now
-      newWorkCond.wait(&mutex);
-   }
+   HighResolutionStatsTk::addHighResIncStats(newStats, homeShard->stats);
+   homeShard->stats.rawVals.busyWorkers--;
 
-   stats.rawVals.busyWorkers++;
+   for( ; ; )
+   {
+      // personal is always first
+      if(unlikely(!personalWorkQueue->getIsWorkListEmpty() ) )
+      { // we got something in our personal queue
+         work = personalWorkQueue->getAndPopFirstWork();
+         break;
+      }
 
-   // sanity check: ensure numPendingWorks and actual number of works are equal
-   #ifdef BEEGFS_DEBUG
-      size_t numQueuedWorks = 0;
+      work = getAndPopWorkUnlocked(homeShard, workerType);
+      if(work)
+         break;
 
-      for(unsigned i=0; i < QueueWorkType_FINAL_DONTUSE; i++)
-         numQueuedWorks += workListVec[i]->getSize();
+      // nothing in our home shard => register as idle and look into the other shards
 
-      if(unlikely(numQueuedWorks != numPendingWorks) )
-         throw MultiWorkQueueException("numQueuedWorks != numPendingWorks: " +
-            StringTk::uint64ToStr(numQueuedWorks) + "!=" + StringTk::uint64ToStr(numPendingWorks) );
-   #endif // BEEGFS_DEBUG
+      homeShard->numIdleWorkers[workerType]++;
+      numIdleWorkers[workerType].increase();
+
+      if(numShards > 1)
+      {
+         mutexLock.unlock(); // U N L O C K
 
+         work = stealWork(homeShardIdx, workerType);
 
-   // personal is always first
-   if(unlikely(!personalWorkQueue->getIsWorkListEmpty() ) )
-   { // we got something in our personal queue
-      work = personalWorkQueue->getAndPopFirstWork();
+         mutexLock.relock(); // R E L O C K
+
+         if(work)
+         {
+            leaveIdleUnlocked(homeShard, workerType, false);
+            break;
+         }
+      }
+
+      // no work available right now => wait for a wakeup
+
+      while(!homeShard->numWakeups[workerType] &&
+            likely(personalWorkQueue->getIsWorkListEmpty() ) &&
+            !(workerType == QueueWorkType_INDIRECT ?
+               homeShard->numPendingWorks : homeShard->workListVec[workerType]->getSize() ) )
+         homeShard->newWorkConds[workerType].wait(&homeShard->mutex);
+
+      leaveIdleUnlocked(homeShard, workerType, true);
+   }
+
+   homeShard->stats.rawVals.busyWorkers++;
+
+   mutexLock.unlock(); // U N L O C K
+
+   return work;
+}
+
+/**
+ * Unregister an idle worker of the given type from the given shard.
+ *
+ * Idle workers and pending wakeups of the same type in a shard are interchangeable, so a worker
+ * that leaves the idle state decrements one of them.
+ *
+ * Note: Caller must hold the shard mutex.
+ *
+ * @param consumeWakeup true if the worker was woken up (=> consume a pending wakeup if there is
+ * one); false if the worker found work on its own (=> leave pending wakeups for other idle
+ * workers, because they were meant for work that is still queued).
+ */
+void MultiWorkQueue::leaveIdleUnlocked(MultiWorkQueueShard* shard, QueueWorkType workerType,
+   bool consumeWakeup)
+{
+   if(consumeWakeup ?
+      !shard->numWakeups[workerType] : (shard->numIdleWorkers[workerType] != 0) )
+   {
+      shard->numIdleWorkers[workerType]--;
+      numIdleWorkers[workerType].decrease();
    }
    else
+      shard->numWakeups[workerType]--;
+}
+
+/**
+ * Wake up an idle worker that can handle the given type of work, preferably in the shard that the
+ * work was added to.
+ *
+ * Note: Does nothing if there is no idle worker anymore (e.g. because it found work on its own
+ * in the meantime).
+ */
+void MultiWorkQueue::wakeIdleWorker(unsigned startShardIdx, QueueWorkType workType)
+{
+   // direct and mirror work can also be done by indirect workers (but specialized come first)
+   const QueueWorkType workerTypes[] = { workType, QueueWorkType_INDIRECT };
+   const unsigned numWorkerTypes = (workType == QueueWorkType_INDIRECT) ? 1 : 2;
+
+   for(unsigned typeIdx=0; typeIdx < numWorkerTypes; typeIdx++)
    {
-      // walk over all available queues
-      // (note: lastWorkListVecIdx ensures that all queue are checked in a fair way)
+      QueueWorkType workerType = workerTypes[typeIdx];
 
-      for(unsigned i=0; i < QueueWorkType_FINAL_DONTUSE; i++)
+      if(!numIdleWorkers[workerType].read() )
+         continue;
+
+      for(unsigned i=0; i < numShards; i++)
       {
-         // switch to next work queue
-         lastWorkListVecIdx++;
-         lastWorkListVecIdx = lastWorkListVecIdx % QueueWorkType_FINAL_DONTUSE;
+         MultiWorkQueueShard* shard = shardVec[(startShardIdx + i) % numShards];
 
-         AbstractWorkContainer* currentWorkList = workListVec[lastWorkListVecIdx];
+         SafeMutexLock mutexLock(&shard->mutex); // L O C K
 
-         if(!currentWorkList->getIsEmpty() )
-         { // this queue contains work for us
-            work = currentWorkList->getAndPopNextWork();
+         bool foundIdleWorker = (shard->numIdleWorkers[workerType] != 0);
 
-            numPendingWorks--;
+         if(foundIdleWorker)
+         {
+            shard->numIdleWorkers[workerType]--;
+            numIdleWorkers[workerType].decrease();
 
-            goto unlock_and_exit;
+            shard->numWakeups[workerType]++;
+            shard->newWorkConds[workerType].signal();
          }
-      }
 
-      // we should never get here: all queues are empty
+         mutexLock.unlock(); // U N L O C K
 
-      throw MultiWorkQueueException("Unexpected in " + std::string(__func__) + ": "
-         "All queues are empty. "
-         "numPendingWorks: " + StringTk::uint64ToStr(numPendingWorks) );
+         if(foundIdleWorker)
+            return;
+      }
    }
+}
+
+void MultiWorkQueue::addWork(Work* work, unsigned userID, QueueWorkType workType)
+{
+   // only use the shards that have workers assigned (workers get assigned round-robin)
+   const unsigned numWorkersNow = numWorkers.read();
+   const unsigned numActiveShards = numWorkersNow ? BEEGFS_MIN(numWorkersNow, numShards) : 1;
+
+   unsigned shardIdx;
 
+   if( (workType == QueueWorkType_INDIRECT) && assignIndirectWorkByUser)
+      shardIdx = userID % numActiveShards; // keep requests of a user in the same per-user queue
+   else
+      shardIdx = (nextAddShardIdx++) % numActiveShards;
+
+   MultiWorkQueueShard* shard = shardVec[shardIdx];
+
+   SafeMutexLock mutexLock(&shard->mutex); // L O C K
+
+   shard->workListVec[workType]->addWork(work, userID);
+
+   shard->numPendingWorks++;
+
+   /* note: the idle counters must be checked while we hold the lock, see waitForWorkByType() */
+   bool wakeupNeeded = numIdleWorkers[QueueWorkType_INDIRECT].read() ||
+      ( (workType != QueueWorkType_INDIRECT) && numIdleWorkers[workType].read() );
 
-unlock_and_exit:
    mutexLock.unlock(); // U N L O C K
 
-   return work;
+   if(wakeupNeeded)
+      wakeIdleWorker(shardIdx, workType);
+}
+
+/**
+ * Get the home shard of the worker that owns the given personal queue (assigns a home shard on the
+ * first call for a personal queue).
+ */
+unsigned MultiWorkQueue::getHomeShardIdx(PersonalWorkQueue* personalQ)
+{
+   int homeShardIdx = *(volatile int*)&personalQ->homeShardIdx;
+   if(likely(homeShardIdx >= 0) )
+      return homeShardIdx;
+
+   int newHomeShardIdx = nextHomeShardIdx.increase() % numShards;
+
+   if(__sync_bool_compare_and_swap(&personalQ->homeShardIdx, -1, newHomeShardIdx) )
+      return newHomeShardIdx;
+
+   // someone else was faster
+   return *(volatile int*)&personalQ->homeShardIdx;
+}
+
+Work* MultiWorkQueue::waitForMirrorWork(HighResolutionStats& newStats,
+   PersonalWorkQueue* personalWorkQueue)
+{
+   return waitForWorkByType(newStats, personalWorkQueue, QueueWorkType_MIRROR);
+}
+
+Work* MultiWorkQueue::waitForDirectWork(HighResolutionStats& newStats,
+   PersonalWorkQueue* personalWorkQueue)
+{
+   return waitForWorkByType(newStats, personalWorkQueue, QueueWorkType_DIRECT);
+}
+
+/**
+ * Wait for work on any of the avialable queues. This is for indirect (non-specialized) workers.
+ *
+ * @param newStats the updated stats from processing of the last work package.
+ * @param personalWorkQueue the personal queue of the worker thread which called this method.
+ */
+Work* MultiWorkQueue::waitForAnyWork(HighResolutionStats& newStats,
+   PersonalWorkQueue* personalWorkQueue)
+{
+   return waitForWorkByType(newStats, personalWorkQueue, QueueWorkType_INDIRECT);
 }
 
 /**
@@ -161,17 +382,24 @@ unlock_and_exit:
  */
 void MultiWorkQueue::incNumWorkers()
 {
-   SafeMutexLock mutexLock(&mutex);
+   MultiWorkQueueShard* shard = shardVec[0];
+
+   SafeMutexLock mutexLock(&shard->mutex);
 
    /* note: we increase number of busy workers here, because this value will be decreased
-      by 1 when the worker calls waitFor...Work(). */
-   stats.rawVals.busyWorkers++;
+      by 1 when the worker calls waitFor...Work().
+      (the worker might decrease it in another shard, so the per-shard value can wrap around,
+      but the sum of all shards is always correct.) */
+   shard->stats.rawVals.busyWorkers++;
 
    mutexLock.unlock();
+
+   numWorkers.increase();
 }
 
 /**
- * Deletes the old list and replaces it with the new given one.
+ * Deletes the old lists and replaces them with the new given one (and empty containers of the same
+ * type for the other shards).
  *
  * Note: Unlocked, because this is intended to be called during queue preparation.
  *
@@ -180,33 +408,151 @@ void MultiWorkQueue::incNumWorkers()
  */
 void MultiWorkQueue::setIndirectWorkList(AbstractWorkContainer* newWorkList)
 {
-   #ifdef BEEGFS_DEBUG
-      // sanity check
-      if(!indirectWorkList->getIsEmpty() )
-         throw MultiWorkQueueException("Unexpected in " + std::string(__func__) + ": "
-            "Queue to be replaced is not empty.");
-   #endif // BEEGFS_DEBUG
+   for(unsigned i=0; i < numShards; i++)
+   {
+      MultiWorkQueueShard* shard = shardVec[i];
+      AbstractWorkContainer* oldWorkList = shard->workListVec[QueueWorkType_INDIRECT];
 
+      #ifdef BEEGFS_DEBUG
+         // sanity check
+         if(!oldWorkList->getIsEmpty() )
+            throw MultiWorkQueueException("Unexpected in " + std::string(__func__) + ": "
+               "Queue to be replaced is not empty.");
+      #endif // BEEGFS_DEBUG
 
-   delete(indirectWorkList);
+      delete(oldWorkList);
 
-   indirectWorkList = newWorkList;
+      shard->workListVec[QueueWorkType_INDIRECT] = i ?
+         newWorkList->createEmptyContainer() : newWorkList;
+   }
 
-   workListVec[QueueWorkType_INDIRECT] = indirectWorkList;
+   // (the default ListWorkContainer ignores userIDs, so anything else is assumed to be per-user)
+   this->assignIndirectWorkByUser = !dynamic_cast<ListWorkContainer*>(newWorkList);
+}
+
+void MultiWorkQueue::addPersonalWork(Work* work, PersonalWorkQueue* personalQ)
+{
+   /* note: this is in the here (instead of the PersonalWorkQueue) because the mutex of the home
+      shard also syncs the personal queue. */
+
+   MultiWorkQueueShard* shard = shardVec[getHomeShardIdx(personalQ)];
+
+   SafeMutexLock mutexLock(&shard->mutex);
+
+   personalQ->addWork(work);
+
+   // note: we do not increase numPendingWorks here (it is only for the other queues)
+
+   // we assume this method is rarely used, so we just wake up all wokers of the shard (inefficient)
+   for(unsigned type=0; type < QueueWorkType_FINAL_DONTUSE; type++)
+      shard->newWorkConds[type].broadcast();
+
+   mutexLock.unlock();
+}
+
+bool MultiWorkQueue::getIsPersonalQueueEmpty(PersonalWorkQueue* personalQ)
+{
+   MultiWorkQueueShard* shard = shardVec[getHomeShardIdx(personalQ)];
+
+   SafeMutexLock mutexLock(&shard->mutex);
+
+   bool retVal = personalQ->getIsWorkListEmpty();
+
+   mutexLock.unlock();
+
+   return retVal;
+}
+
+size_t MultiWorkQueue::getWorkListSize(QueueWorkType workType)
+{
+   size_t retVal = 0;
+
+   for(unsigned i=0; i < numShards; i++)
+   {
+      MultiWorkQueueShard* shard = shardVec[i];
+
+      SafeMutexLock mutexLock(&shard->mutex);
+
+      retVal += shard->workListVec[workType]->getSize();
+
+      mutexLock.unlock();
+   }
+
+   return retVal;
+}
+
+/**
+ * Returns current stats (merged from all shards) and _resets_ them.
+ */
+void MultiWorkQueue::getAndResetStats(HighResolutionStats* outStats)
+{
+   HighResolutionStatsTk::resetStats(outStats);
+
+   for(unsigned i=0; i < numShards; i++)
+   {
+      MultiWorkQueueShard* shard = shardVec[i];
+
+      SafeMutexLock mutexLock(&shard->mutex);
+
+      if(!i)
+         *outStats = shard->stats; // (to also get the non-summable values)
+      else
+      {
+         HighResolutionStatsTk::addHighResIncStats(shard->stats, *outStats);
+         HighResolutionStatsTk::addHighResRawStats(shard->stats, *outStats);
+      }
+
+      outStats->rawVals.queuedRequests += shard->numPendingWorks;
+
+      /* note: we only reset incremental stats vals, because otherwise we would lose info
+         like number of busyWorkers */
+      HighResolutionStatsTk::resetIncStats(&shard->stats);
+
+      mutexLock.unlock();
+   }
 }
 
 /**
- * Note: Holds lock while generating stats strings => slow => use carefully
+ * Note: Holds locks while generating stats strings => slow => use carefully
  */
 void MultiWorkQueue::getStatsAsStr(std::string& outIndirectQueueStats,
    std::string& outDirectQueueStats, std::string& outMirrorQueueStats, std::string& outBusyStats)
 {
-   SafeMutexLock mutexLock(&mutex); // L O C K
+   HighResolutionStats stats;
 
-   // get queue stats
-   indirectWorkList->getStatsAsStr(outIndirectQueueStats);
-   directWorkList->getStatsAsStr(outDirectQueueStats);
-   mirrorWorkList->getStatsAsStr(outMirrorQueueStats);
+   HighResolutionStatsTk::resetStats(&stats);
+
+   outIndirectQueueStats.clear();
+   outDirectQueueStats.clear();
+   outMirrorQueueStats.clear();
+
+   for(unsigned i=0; i < numShards; i++)
+   {
+      MultiWorkQueueShard* shard = shardVec[i];
+      std::string shardHeader;
+      std::string indirectQueueStats;
+      std::string directQueueStats;
+      std::string mirrorQueueStats;
+
+      if(numShards > 1)
+         shardHeader = "Shard " + StringTk::uintToStr(i) + ":\n";
+
+      SafeMutexLock mutexLock(&shard->mutex); // L O C K
+
+      // get queue stats
+      shard->workListVec[QueueWorkType_INDIRECT]->getStatsAsStr(indirectQueueStats);
+      shard->workListVec[QueueWorkType_DIRECT]->getStatsAsStr(directQueueStats);
+      shard->workListVec[QueueWorkType_MIRROR]->getStatsAsStr(mirrorQueueStats);
+
+      HighResolutionStatsTk::addHighResIncStats(shard->stats, stats);
+      HighResolutionStatsTk::addHighResRawStats(shard->stats, stats);
+
+      mutexLock.unlock(); // U N L O C K
+
+      outIndirectQueueStats += shardHeader + indirectQueueStats;
+      outDirectQueueStats += shardHeader + directQueueStats;
+      outMirrorQueueStats += shardHeader + mirrorQueueStats;
+   }
 
    // number of busy workers
    std::ostringstream busyStream;
@@ -220,6 +566,4 @@ void MultiWorkQueue::getStatsAsStr(std::string& outIndirectQueueStats,
       "(reset every second)" << std::endl;
 
    outBusyStats = busyStream.str();
-
-   mutexLock.unlock(); // U N L O C K
 }
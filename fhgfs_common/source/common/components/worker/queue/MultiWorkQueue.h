@@ -3,6 +3,7 @@
 
 #include <common/app/log/LogContext.h>
 #include <common/components/worker/Work.h>
+#include <common/threading/Atomics.h>
 #include <common/threading/Mutex.h>
 #include <common/threading/SafeMutexLock.h>
 #include <common/threading/Condition.h>
@@ -16,6 +17,8 @@
 
 #define MULTIWORKQUEUE_DEFAULT_USERID  (~0) // (usually similar to NETMESSAGE_DEFAULT_USERID)
 
+#define MULTIWORKQUEUE_MAX_AUTO_SHARDS  16 // max number of shards if not given explicitly
+
 
 DECLARE_NAMEDEXCEPTION(MultiWorkQueueException, "MultiWorkQueueException")
 
@@ -31,8 +34,11 @@ typedef MultiWorkQueueMap::value_type MultiWorkQueueMapVal;
 
 
 /**
- * Note: We also use these numbers as indices in the MultiWorkQueue::workListVec, so carefully
+ * Note: We also use these numbers as indices in the MultiWorkQueueShard::workListVec, so carefully
  * check all related cases when you add/change something here.
+ *
+ * For the per-shard worker counters, we use these numbers as the worker types, where INDIRECT means
+ * workers that wait for any type of work.
  */
 enum QueueWorkType
 {
@@ -44,17 +50,55 @@ enum QueueWorkType
 };
 
 
-class MultiWorkQueue
+typedef std::vector<AbstractWorkContainer*> WorkListVec;
+typedef WorkListVec::iterator WorkListVecIter;
+typedef WorkListVec::const_iterator WorkListVecCIter;
+
+
+/**
+ * A part of the MultiWorkQueue with its own lock, work lists and stats.
+ */
+struct MultiWorkQueueShard
 {
-   private:
-      // type definitions
-      typedef std::vector<AbstractWorkContainer*> WorkListVec;
-      typedef WorkListVec::iterator WorkListVecIter;
-      typedef WorkListVec::const_iterator WorkListVecCIter;
+   Mutex mutex;
+
+   WorkListVec workListVec; // work lists with QueueWorkType as index
 
+   size_t numPendingWorks; // length of direct+mirror+indirect list (not incl personal lists)
+   unsigned lastWorkListVecIdx; // toggles indirect workers types of work (% queue types)
 
+   // worker waiting (all arrays have the worker type as index, see QueueWorkType)
+   Condition newWorkConds[QueueWorkType_FINAL_DONTUSE]; // workers of this shard sleep here
+   unsigned numIdleWorkers[QueueWorkType_FINAL_DONTUSE]; // idle workers that can be woken up
+   unsigned numWakeups[QueueWorkType_FINAL_DONTUSE]; // wakeups for idle workers not consumed yet
+
+   HighResolutionStats stats; // (merged with the other shards when read)
+};
+
+typedef std::vector<MultiWorkQueueShard*> MultiWorkQueueShardVec;
+
+
+/**
+ * Work queue for different types of work (direct, indirect, mirror) with additional personal
+ * queues per worker.
+ *
+ * To avoid contention on a single lock with many workers and many incoming requests, the queue is
+ * split into shards. Each worker is assigned to a home shard and new work is spread across the
+ * shards. Workers take work from their home shard and steal from the other shards if their home
+ * shard has no work for them.
+ * Idle workers register in their home shard, so that new work only leads to a condition signal if
+ * there really is an idle worker (which is then woken up in whatever shard it is waiting).
+ *
+ * Priority rules are the same as for a single queue: Personal work comes first, direct workers only
+ * take direct work, mirror workers only mirror work and indirect workers take any type of work
+ * with a round-robin toggle between the work types.
+ * If the indirect work list is a per-user container (e.g. UserWorkContainer), indirect work is
+ * assigned to shards by userID, so that all requests of a user stay in one per-user queue.
+ */
+class MultiWorkQueue
+{
    public:
-      MultiWorkQueue();
+      MultiWorkQueue(unsigned numShards = 0);
       ~MultiWorkQueue();
 
       Work* waitForMirrorWork(HighResolutionStats& newStats, PersonalWorkQueue* personalWorkQueue);
@@ -68,158 +112,92 @@ class MultiWorkQueue
       void getStatsAsStr(std::string& outIndirectQueueStats, std::string& outDirectQueueStats,
          std::string& outMirrorQueueStats, std::string& outBusyStats);
 
+      void addPersonalWork(Work* work, PersonalWorkQueue* personalQ);
+      bool getIsPersonalQueueEmpty(PersonalWorkQueue* personalQ);
+
+      void getAndResetStats(HighResolutionStats* outStats);
+
 
    private:
-      AbstractWorkContainer* directWorkList;
-      AbstractWorkContainer* mirrorWorkList;
-      AbstractWorkContainer* indirectWorkList;
+      MultiWorkQueueShardVec shardVec;
+      unsigned numShards; // (just a copy of shardVec size for fast access)
 
-      Mutex mutex;
-      Condition newDirectWorkCond; // direct workers wait only on this condition
-      Condition newMirrorWorkCond; // mirror workers wait only on this condition
-      Condition newWorkCond; // for any type of work (indirect workers wait on this condition)
+      AtomicUInt32 numWorkers; // number of workers (=> only this many shards are used for new work)
+      AtomicUInt32 nextHomeShardIdx; // for round-robin assignment of workers to home shards
+      AtomicUInt32 numIdleWorkers[QueueWorkType_FINAL_DONTUSE]; // sum of all shards (index: type)
 
-      size_t numPendingWorks; // length of direct+mirror+indirect list (not incl personal list)
-      unsigned lastWorkListVecIdx; // toggles indirect workers types of work (% queue types)
-      WorkListVec workListVec; // used to toggle next work type with nextWorkType as index
+      bool assignIndirectWorkByUser; // true if the indirect lists are per-user containers
 
-      HighResolutionStats stats;
 
-      Work* waitForWorkByQueue(HighResolutionStats& newStats, PersonalWorkQueue* personalWorkQueue,
-         AbstractWorkContainer* waitWorkQ, Condition& waitNewWorkCond);
+      Work* waitForWorkByType(HighResolutionStats& newStats, PersonalWorkQueue* personalWorkQueue,
+         QueueWorkType workerType);
+      Work* getAndPopWorkUnlocked(MultiWorkQueueShard* shard, QueueWorkType workerType);
+      Work* stealWork(unsigned homeShardIdx, QueueWorkType workerType);
 
+      void leaveIdleUnlocked(MultiWorkQueueShard* shard, QueueWorkType workerType,
+         bool consumeWakeup);
+      void wakeIdleWorker(unsigned startShardIdx, QueueWorkType workType);
 
-   public:
-      void addDirectWork(Work* work, unsigned userID = MULTIWORKQUEUE_DEFAULT_USERID)
-      {
-         SafeMutexLock mutexLock(&mutex);
+      void addWork(Work* work, unsigned userID, QueueWorkType workType);
+      unsigned getHomeShardIdx(PersonalWorkQueue* personalQ);
 
-         directWorkList->addWork(work, userID);
+      size_t getWorkListSize(QueueWorkType workType);
 
-         numPendingWorks++;
 
-         newWorkCond.signal();
-         newDirectWorkCond.signal();
+   public:
+      // inliners
 
-         mutexLock.unlock();
+      void addDirectWork(Work* work, unsigned userID = MULTIWORKQUEUE_DEFAULT_USERID)
+      {
+         addWork(work, userID, QueueWorkType_DIRECT);
       }
 
       void addMirrorWork(Work* work, unsigned userID = MULTIWORKQUEUE_DEFAULT_USERID)
       {
-         SafeMutexLock mutexLock(&mutex);
-
-         mirrorWorkList->addWork(work, userID);
-
-         numPendingWorks++;
-
-         newWorkCond.signal();
-         newMirrorWorkCond.signal();
-
-         mutexLock.unlock();
+         addWork(work, userID, QueueWorkType_MIRROR);
       }
 
       void addIndirectWork(Work* work, unsigned userID = MULTIWORKQUEUE_DEFAULT_USERID)
       {
-         SafeMutexLock mutexLock(&mutex);
-
-         indirectWorkList->addWork(work, userID);
-
-         numPendingWorks++;
-
-         newWorkCond.signal();
-
-         mutexLock.unlock();
+         addWork(work, userID, QueueWorkType_INDIRECT);
       }
 
-      void addPersonalWork(Work* work, PersonalWorkQueue* personalQ)
-      {
-         /* note: this is in the here (instead of the PersonalWorkQueue) because the MultiWorkQueue
-            mutex also syncs the personal queue. */
-
-         SafeMutexLock mutexLock(&mutex);
-
-         personalQ->addWork(work);
-
-         // note: we do not increase numPendingWorks here (it is only for the other queues)
-
-         // we assume this method is rarely used, so we just wake up all wokers (inefficient)
-         newDirectWorkCond.broadcast();
-         newMirrorWorkCond.broadcast();
-         newWorkCond.broadcast();
-
-         mutexLock.unlock();
-      }
-      
       size_t getDirectWorkListSize()
       {
-         SafeMutexLock mutexLock(&mutex);
-
-         size_t retVal = directWorkList->getSize();
-
-         mutexLock.unlock();
-
-         return retVal;
+         return getWorkListSize(QueueWorkType_DIRECT);
       }
 
       size_t getMirrorWorkListSize()
       {
-         SafeMutexLock mutexLock(&mutex);
-
-         size_t retVal = mirrorWorkList->getSize();
-
-         mutexLock.unlock();
-
-         return retVal;
+         return getWorkListSize(QueueWorkType_MIRROR);
       }
-      
-      size_t getIndirectWorkListSize()
-      {
-         SafeMutexLock mutexLock(&mutex);
-
-         size_t retVal = indirectWorkList->getSize();
-
-         mutexLock.unlock(); 
 
-         return retVal;
-      }
-      
-      bool getIsPersonalQueueEmpty(PersonalWorkQueue* personalQ)
+      size_t getIndirectWorkListSize()
       {
-         SafeMutexLock mutexLock(&mutex);
-
-         bool retVal = personalQ->getIsWorkListEmpty();
-
-         mutexLock.unlock();
-
-         return retVal;
+         return getWorkListSize(QueueWorkType_INDIRECT);
       }
 
       size_t getNumPendingWorks()
       {
-         SafeMutexLock mutexLock(&mutex);
+         size_t retVal = 0;
+
+         for(unsigned i=0; i < numShards; i++)
+         {
+            MultiWorkQueueShard* shard = shardVec[i];
 
-         size_t retVal = numPendingWorks;
+            SafeMutexLock mutexLock(&shard->mutex);
 
-         mutexLock.unlock();
+            retVal += shard->numPendingWorks;
+
+            mutexLock.unlock();
+         }
 
          return retVal;
       }
 
-      /**
-       * Returns current stats and _resets_ them.
-       */
-      void getAndResetStats(HighResolutionStats* outStats)
+      unsigned getNumShards() const
       {
-         SafeMutexLock mutexLock(&mutex);
-
-         *outStats = stats;
-         outStats->rawVals.queuedRequests = numPendingWorks;
-
-         /* note: we only reset incremental stats vals, because otherwise we would lose info
-            like number of busyWorkers */
-         HighResolutionStatsTk::resetIncStats(&stats);
-
-         mutexLock.unlock();
+         return numShards;
       }
 
 
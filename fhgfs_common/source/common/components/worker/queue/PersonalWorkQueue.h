@@ -15,8 +15,9 @@ DECLARE_NAMEDEXCEPTION(PersonalWorkQueueException, "PersonalWorkQueueException")
  * This is useful when we need to make sure that each worker gets a certain work request at least
  * once, e.g. to synchronize workers for fsck modification logging.
  *
- * This class has no own mutex for thread-safety, it is sync'ed via the MultiWorkQueue mutex.
- * So adding work to it is done via MultiWorkQueue methods.
+ * This class has no own mutex for thread-safety, it is sync'ed via the mutex of the MultiWorkQueue
+ * shard that the owning worker is assigned to (see homeShardIdx). So adding work to it is done via
+ * MultiWorkQueue methods.
  *
  * Note: Workers always prefer requests in the personal queue over requests in the other queues,
  * so keep possible starvation of requests in other queues in mind when you use personal queues.
@@ -27,7 +28,7 @@ class PersonalWorkQueue
                                    MultiWorkQueue mutex being held. */
 
    public:
-      PersonalWorkQueue() {}
+      PersonalWorkQueue() : homeShardIdx(-1) {}
 
       ~PersonalWorkQueue()
       {
@@ -39,6 +40,7 @@ class PersonalWorkQueue
 
    private:
       WorkList workList;
+      int homeShardIdx; // MultiWorkQueue shard of the owning worker (-1 if not assigned yet)
 
 
    private:
@@ -172,6 +172,11 @@ class UserWorkContainer : public AbstractWorkContainer
          outStats = statsStream.str();
       }
 
+      AbstractWorkContainer* createEmptyContainer()
+      {
+         return new UserWorkContainer();
+      }
+
 };
 
 
@@ -87,7 +87,15 @@ void NetMessage::deserializeHeader(char* buf, size_t bufLen, NetMessageHeader* o
    // skip padding
 
    bufPos += Serialization::serialLenUInt16(); // paddingShort1
-   bufPos += Serialization::serialLenUInt(); // paddingInt1
+
+   { // muxID
+      unsigned msgMuxIDBufLen = 0;
+
+      Serialization::deserializeUInt(&buf[bufPos], bufLen-bufPos, &outHeader->msgMuxID,
+         &msgMuxIDBufLen);
+
+      bufPos += msgMuxIDBufLen;
+   }
 }
 
 
@@ -142,7 +150,10 @@ void NetMessage::serializeHeader(char* buf)
    // padding
 
    bufPos += Serialization::serializeUInt16(&buf[bufPos], 0); // paddingShort1
-   bufPos += Serialization::serializeUInt(&buf[bufPos], 0); // paddingInt1
+
+   // muxID
+
+   bufPos += Serialization::serializeUInt(&buf[bufPos], this->msgHeader.msgMuxID);
 }
 
 
@@ -21,6 +21,8 @@
 
 #define NETMSG_DEFAULT_USERID    (~0) // non-zero to avoid mixing up with root userID
 
+#define NETMSG_HEADER_MUXID_OFFSET  28 // byte position of msgMuxID in a serialized header
+
 
 struct NetMessageHeader
 {
@@ -35,7 +37,8 @@ struct NetMessageHeader
    unsigned       msgUserID; // system user ID for per-user msg queues, stats etc.
    uint16_t       msgTargetID; // targetID (not groupID) for per-target workers on storage server
 // uint16_t       msgPaddingShort1; // padding (available for future use)
-// unsigned       msgPaddingInt1; // padding (available for future use)
+   unsigned       msgMuxID; /* ID to match responses to requests on multiplexed conns (0 for
+                               classic conns, see MuxChannel); formerly msgPaddingInt1 */
 };
 
 /*
@@ -133,6 +136,7 @@ class NetMessage
          this->msgHeader.msgCompatFeatureFlags = 0;
          this->msgHeader.msgUserID = NETMSG_DEFAULT_USERID;
          this->msgHeader.msgTargetID = 0;
+         this->msgHeader.msgMuxID = 0;
 
          this->releaseSockAfterProcessing = true;
       }
@@ -175,6 +179,30 @@ class NetMessage
          return msgLength;
       }
 
+      /**
+       * recvBuf must be at least NETMSG_MIN_LENGTH long
+       */
+      static unsigned extractMsgMuxIDFromBuf(char* recvBuf)
+      {
+         unsigned muxID;
+         unsigned muxIDBufLen;
+         Serialization::deserializeUInt(&recvBuf[NETMSG_HEADER_MUXID_OFFSET], sizeof(muxID),
+            &muxID, &muxIDBufLen);
+
+         return muxID;
+      }
+
+      /**
+       * Overwrite the muxID in the header of an already serialized msg (e.g. to tag a response
+       * that was serialized by a msg handler which doesn't know about multiplexing).
+       *
+       * sendBuf must be at least NETMSG_MIN_LENGTH long
+       */
+      static void injectMsgMuxIDIntoBuf(char* sendBuf, unsigned muxID)
+      {
+         Serialization::serializeUInt(&sendBuf[NETMSG_HEADER_MUXID_OFFSET], muxID);
+      }
+
       bool serialize(char* buf, size_t bufLen)
       {
          if(unlikely(bufLen < getMsgLength() ) )
@@ -326,6 +354,19 @@ class NetMessage
          this->msgHeader.msgTargetID = targetID;
       }
 
+      unsigned getMsgHeaderMuxID() const
+      {
+         return msgHeader.msgMuxID;
+      }
+
+      /**
+       * @param muxID 0 for classic (non-multiplexed) conns.
+       */
+      void setMsgHeaderMuxID(unsigned muxID)
+      {
+         this->msgHeader.msgMuxID = muxID;
+      }
+
       bool getReleaseSockAfterProcessing() const
       {
          return releaseSockAfterProcessing;
@@ -85,6 +85,12 @@ class NetMsgStrMapping : public DefineToStrMapping
          this->defineToStrMap[NETMSGTYPE_StatResp] = "StatResp";
          this->defineToStrMap[NETMSGTYPE_GetChunkFileAttribs] = "GetChunkFileAttribs";
          this->defineToStrMap[NETMSGTYPE_GetChunkFileAttribsResp] = "GetChunkFileAttribsResp";
+         this->defineToStrMap[NETMSGTYPE_GetChunkFileAttribsMulti] = "GetChunkFileAttribsMulti";
+         this->defineToStrMap[NETMSGTYPE_GetChunkFileAttribsMultiResp] = "GetChunkFileAttribsMultiResp";
+         this->defineToStrMap[NETMSGTYPE_GetChunkBlockChecksums] = "GetChunkBlockChecksums";
+         this->defineToStrMap[NETMSGTYPE_GetChunkBlockChecksumsResp] = "GetChunkBlockChecksumsResp";
+         this->defineToStrMap[NETMSGTYPE_ListDirPlus] = "ListDirPlus";
+         this->defineToStrMap[NETMSGTYPE_ListDirPlusResp] = "ListDirPlusResp";
          this->defineToStrMap[NETMSGTYPE_TruncFile] = "TruncFile";
          this->defineToStrMap[NETMSGTYPE_TruncFileResp] = "TruncFileResp";
          this->defineToStrMap[NETMSGTYPE_TruncLocalFile] = "TruncLocalFile";
@@ -197,6 +203,8 @@ class NetMsgStrMapping : public DefineToStrMapping
          this->defineToStrMap[NETMSGTYPE_FLockRangeResp] = "FLockRangeResp";
          this->defineToStrMap[NETMSGTYPE_FLockAppend] = "FLockAppend";
          this->defineToStrMap[NETMSGTYPE_FLockAppendResp] = "FLockAppendResp";
+         this->defineToStrMap[NETMSGTYPE_LeaseRevoked] = "LeaseRevoked";
+         this->defineToStrMap[NETMSGTYPE_LeaseRevokedResp] = "LeaseRevokedResp";
          this->defineToStrMap[NETMSGTYPE_SetChannelDirect] = "SetChannelDirect";
          this->defineToStrMap[NETMSGTYPE_SetChannelDirectRespDummy] = "SetChannelDirectRespDummy";
          this->defineToStrMap[NETMSGTYPE_Ack] = "Ack";
@@ -171,6 +171,12 @@
 #define NETMSGTYPE_ResyncRawInodeResp              2118
 #define NETMSGTYPE_ResyncRawDentry                 2119
 #define NETMSGTYPE_ResyncRawDentryResp             2120
+#define NETMSGTYPE_GetChunkFileAttribsMulti        2121
+#define NETMSGTYPE_GetChunkFileAttribsMultiResp    2122
+#define NETMSGTYPE_GetChunkBlockChecksums          2123
+#define NETMSGTYPE_GetChunkBlockChecksumsResp      2124
+#define NETMSGTYPE_ListDirPlus                     2125
+#define NETMSGTYPE_ListDirPlusResp                 2126
 
 // session messages
 #define NETMSGTYPE_OpenFile                        3001
@@ -201,6 +207,8 @@
 #define NETMSGTYPE_FLockRangeResp                  3028
 #define NETMSGTYPE_FLockAppend                     3029
 #define NETMSGTYPE_FLockAppendResp                 3030
+#define NETMSGTYPE_LeaseRevoked                    3031
+#define NETMSGTYPE_LeaseRevokedResp                3032 // this msg only has an ack response
 
 // control messages
 #define NETMSGTYPE_SetChannelDirect                4001
@@ -62,8 +62,10 @@ bool RetrieveDirEntriesRespMsg::deserializePayload(const char* buf, size_t bufLe
 
    {
       // fsckContDirs
-      if ( !SerializationFsck::deserializeFsckContDirListPreprocess(&buf[bufPos], bufLen - bufPos,
-         &fsckContDirsStart, &fsckContDirsElemNum, &fsckContDirsBufLen) )
+      unsigned fsckContDirsBufLen;
+
+      if ( !SerializationFsck::deserializeFsckObjectList(&buf[bufPos], bufLen - bufPos,
+         &parsedContDirs, &fsckContDirsBufLen) )
          return false;
 
       bufPos += fsckContDirsBufLen;
@@ -71,8 +73,10 @@ bool RetrieveDirEntriesRespMsg::deserializePayload(const char* buf, size_t bufLe
 
    {
       // fsckDirEntries
-      if ( !SerializationFsck::deserializeFsckDirEntryListPreprocess(&buf[bufPos], bufLen - bufPos,
-         &fsckDirEntriesStart, &fsckDirEntriesElemNum, &fsckDirEntriesBufLen) )
+      unsigned fsckDirEntriesBufLen;
+
+      if ( !SerializationFsck::deserializeFsckObjectList(&buf[bufPos], bufLen - bufPos,
+         &parsedDirEntries, &fsckDirEntriesBufLen) )
          return false;
 
       bufPos += fsckDirEntriesBufLen;
@@ -80,8 +84,10 @@ bool RetrieveDirEntriesRespMsg::deserializePayload(const char* buf, size_t bufLe
 
    {
       // inlinedFileInodes
-      if ( !SerializationFsck::deserializeFsckFileInodeListPreprocess(&buf[bufPos], bufLen - bufPos,
-         &inlinedFileInodesStart, &inlinedFileInodesElemNum, &inlinedFileInodesBufLen) )
+      unsigned inlinedFileInodesBufLen;
+
+      if ( !SerializationFsck::deserializeFsckObjectList(&buf[bufPos], bufLen - bufPos,
+         &parsedInlinedFileInodes, &inlinedFileInodesBufLen) )
          return false;
 
       bufPos += inlinedFileInodesBufLen;
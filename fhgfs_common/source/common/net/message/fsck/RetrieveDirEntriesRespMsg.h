@@ -53,37 +53,31 @@ class RetrieveDirEntriesRespMsg : public NetMessage
       FsckDirEntryList* fsckDirEntries;
       FsckFileInodeList* inlinedFileInodes;
       
-      // for deserialization
-      unsigned fsckContDirsElemNum;
-      const char* fsckContDirsStart;
-      unsigned fsckContDirsBufLen;
-
-      unsigned fsckDirEntriesElemNum;
-      const char* fsckDirEntriesStart;
-      unsigned fsckDirEntriesBufLen;
-      
-      unsigned inlinedFileInodesElemNum;
-      const char* inlinedFileInodesStart;
-      unsigned inlinedFileInodesBufLen;
+      // for deserialization (deserialized in a single pass, see deserializePayload() )
+      FsckContDirList parsedContDirs;
+      FsckDirEntryList parsedDirEntries;
+      FsckFileInodeList parsedInlinedFileInodes;
 
    public:
       // inliners   
+      /*
+       * note: the parse...() methods move the elements to outList (i.e. each of them can only be
+       * called once).
+       */
+
       void parseContDirs(FsckContDirList* outList)
       {
-         SerializationFsck::deserializeFsckContDirList(fsckContDirsElemNum, fsckContDirsStart,
-            outList);
+         outList->splice(outList->end(), parsedContDirs);
       }
 
       void parseDirEntries(FsckDirEntryList* outList)
       {
-         SerializationFsck::deserializeFsckDirEntryList(fsckDirEntriesElemNum, fsckDirEntriesStart,
-            outList);
+         outList->splice(outList->end(), parsedDirEntries);
       }
 
       void parseInlinedFileInodes(FsckFileInodeList* outList)
       {
-         SerializationFsck::deserializeFsckFileInodeList(inlinedFileInodesElemNum,
-            inlinedFileInodesStart, outList);
+         outList->splice(outList->end(), parsedInlinedFileInodes);
       }
 
       // getters & setters
@@ -54,6 +54,21 @@ bool StorageBenchControlMsg::deserializePayload(const char* buf, size_t bufLen)
 
    bufPos += threadsBufLen;
 
+   // readPercent
+
+   if(isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSG_FLAG_HAS_READPERCENT) )
+   {
+      unsigned readPercentBufLen;
+
+      if(!Serialization::deserializeInt(&buf[bufPos], bufLen-bufPos,
+         &this->readPercent, &readPercentBufLen) )
+         return false;
+
+      bufPos += readPercentBufLen;
+   }
+   else
+      this->readPercent = STORAGEBENCH_DEFAULT_READ_PERCENT;
+
    // targetIDs
 
    if(!Serialization::deserializeUInt16ListPreprocess(&buf[bufPos], bufLen-bufPos,
@@ -84,6 +99,35 @@ void StorageBenchControlMsg::serializePayload(char* buf)
    // threads
    bufPos += Serialization::serializeInt(&buf[bufPos], this->threads);
 
+   // readPercent
+   if(isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSG_FLAG_HAS_READPERCENT) )
+      bufPos += Serialization::serializeInt(&buf[bufPos], this->readPercent);
+
    // targetIDs
    bufPos += Serialization::serializeUInt16List(&buf[bufPos], this->targetIDs);
 }
+
+TestingEqualsRes StorageBenchControlMsg::testingEquals(NetMessage* cloneMsg)
+{
+   StorageBenchControlMsg* cloneBenchMsg = (StorageBenchControlMsg*) cloneMsg;
+
+   if( (this->action != cloneBenchMsg->getAction() ) ||
+       (this->type != cloneBenchMsg->getType() ) ||
+       (this->blocksize != cloneBenchMsg->getBlocksize() ) ||
+       (this->size != cloneBenchMsg->getSize() ) ||
+       (this->threads != cloneBenchMsg->getThreads() ) )
+      return TestingEqualsRes_FALSE;
+
+   // (readPercent is only transferred for StorageBenchType_RANDMIXED)
+   if(isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSG_FLAG_HAS_READPERCENT) &&
+      (this->readPercent != cloneBenchMsg->getReadPercent() ) )
+      return TestingEqualsRes_FALSE;
+
+   UInt16List cloneTargetIDs;
+   cloneBenchMsg->parseTargetIDs(&cloneTargetIDs);
+
+   if(*this->targetIDs != cloneTargetIDs)
+      return TestingEqualsRes_FALSE;
+
+   return TestingEqualsRes_TRUE;
+}
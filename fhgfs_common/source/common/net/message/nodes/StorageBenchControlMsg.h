@@ -7,11 +7,22 @@
 #include <common/toolkit/serialization/Serialization.h>
 
 
+#define STORAGEBENCHCONTROLMSG_FLAG_HAS_READPERCENT     1 /* msg includes readPercent (only set
+                                                             for StorageBenchType_RANDMIXED) */
+
+#define STORAGEBENCHCONTROLMSG_COMPAT_FLAG_LATENCIES    1 /* caller wants latency percentiles in
+                                                             the response */
+
+
 class StorageBenchControlMsg: public NetMessage
 {
    public:
+      /**
+       * @param readPercent percentage of reads for StorageBenchType_RANDMIXED (ignored for other
+       *    types)
+       */
       StorageBenchControlMsg(StorageBenchAction action, StorageBenchType type, int64_t blocksize,
-         int64_t size, int threads, UInt16List* targetIDs)
+         int64_t size, int threads, int readPercent, UInt16List* targetIDs)
       : NetMessage(NETMSGTYPE_StorageBenchControlMsg)
       {
          this->action = action;
@@ -19,7 +30,11 @@ class StorageBenchControlMsg: public NetMessage
          this->blocksize = blocksize;
          this->size = size;
          this->threads = threads;
+         this->readPercent = readPercent;
          this->targetIDs = targetIDs;
+
+         if(type == StorageBenchType_RANDMIXED)
+            addMsgHeaderFeatureFlag(STORAGEBENCHCONTROLMSG_FLAG_HAS_READPERCENT);
       }
 
       /**
@@ -29,19 +44,31 @@ class StorageBenchControlMsg: public NetMessage
       {
       }
 
+      virtual TestingEqualsRes testingEquals(NetMessage* cloneMsg);
+
    protected:
       virtual void serializePayload(char* buf);
       virtual bool deserializePayload(const char* buf, size_t bufLen);
 
       unsigned calcMessageLength()
       {
-         return NETMSG_HEADER_LENGTH +
+         unsigned msgLen = NETMSG_HEADER_LENGTH +
             Serialization::serialLenInt() + // action
             Serialization::serialLenInt() + // type
             Serialization::serialLenInt64() + // blocksize
             Serialization::serialLenInt64() + // size
             Serialization::serialLenInt() + // threads
             Serialization::serialLenUInt16List(this->targetIDs); // targetIDs
+
+         if(isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSG_FLAG_HAS_READPERCENT) )
+            msgLen += Serialization::serialLenInt(); // readPercent
+
+         return msgLen;
+      }
+
+      unsigned getSupportedHeaderFeatureFlagsMask() const
+      {
+         return STORAGEBENCHCONTROLMSG_FLAG_HAS_READPERCENT;
       }
 
    private:
@@ -50,6 +77,7 @@ class StorageBenchControlMsg: public NetMessage
       int64_t blocksize;
       int64_t size;
       int threads;
+      int readPercent;
       UInt16List* targetIDs;
 
       // deserialization info
@@ -60,6 +88,15 @@ class StorageBenchControlMsg: public NetMessage
    public:
       //inliners
 
+      /**
+       * Ask for latency percentiles in the response (older servers ignore this and respond
+       * without them).
+       */
+      void addLatencyRequest()
+      {
+         addMsgHeaderCompatFeatureFlag(STORAGEBENCHCONTROLMSG_COMPAT_FLAG_LATENCIES);
+      }
+
       StorageBenchAction getAction()
       {
          return (StorageBenchAction)this->action;
@@ -85,6 +122,11 @@ class StorageBenchControlMsg: public NetMessage
          return this->threads;
       }
 
+      int getReadPercent()
+      {
+         return this->readPercent;
+      }
+
       void parseTargetIDs(UInt16List* outTargetIds)
       {
          Serialization::deserializeUInt16List(this->targetIDsBufLen, this->targetIDsElemNum,
@@ -61,6 +61,42 @@ bool StorageBenchControlMsgResp::deserializePayload(const char* buf, size_t bufL
 
    bufPos += this->resultValuesBufLen;
 
+   if(isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES) )
+   {
+      // resultLatenciesP50
+
+      if(!Serialization::deserializeInt64ListPreprocess(&buf[bufPos], bufLen-bufPos,
+            &this->resultLatenciesP50ElemNum, &this->resultLatenciesP50ListStart,
+            &this->resultLatenciesP50BufLen) )
+         return false;
+
+      bufPos += this->resultLatenciesP50BufLen;
+
+      // resultLatenciesP99
+
+      if(!Serialization::deserializeInt64ListPreprocess(&buf[bufPos], bufLen-bufPos,
+            &this->resultLatenciesP99ElemNum, &this->resultLatenciesP99ListStart,
+            &this->resultLatenciesP99BufLen) )
+         return false;
+
+      bufPos += this->resultLatenciesP99BufLen;
+
+      // resultLatenciesP999
+
+      if(!Serialization::deserializeInt64ListPreprocess(&buf[bufPos], bufLen-bufPos,
+            &this->resultLatenciesP999ElemNum, &this->resultLatenciesP999ListStart,
+            &this->resultLatenciesP999BufLen) )
+         return false;
+
+      bufPos += this->resultLatenciesP999BufLen;
+
+      // all latency lists must match the target list
+
+      if( (this->resultLatenciesP50ElemNum != this->resultTargetIDsElemNum) ||
+          (this->resultLatenciesP99ElemNum != this->resultTargetIDsElemNum) ||
+          (this->resultLatenciesP999ElemNum != this->resultTargetIDsElemNum) )
+         return false;
+   }
 
    return true;
 }
@@ -86,4 +122,69 @@ void StorageBenchControlMsgResp::serializePayload(char* buf)
 
    // resultInt64List
    bufPos += Serialization::serializeInt64List(&buf[bufPos], &this->resultValues);
+
+   if(isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES) )
+   {
+      // resultLatenciesP50
+      bufPos += Serialization::serializeInt64List(&buf[bufPos], &this->resultLatenciesP50);
+
+      // resultLatenciesP99
+      bufPos += Serialization::serializeInt64List(&buf[bufPos], &this->resultLatenciesP99);
+
+      // resultLatenciesP999
+      bufPos += Serialization::serializeInt64List(&buf[bufPos], &this->resultLatenciesP999);
+   }
+}
+
+TestingEqualsRes StorageBenchControlMsgResp::testingEquals(NetMessage* cloneMsg)
+{
+   StorageBenchControlMsgResp* cloneRespMsg = (StorageBenchControlMsgResp*) cloneMsg;
+
+   if( (this->status != cloneRespMsg->getStatus() ) ||
+       (this->action != cloneRespMsg->getAction() ) ||
+       (this->type != cloneRespMsg->getType() ) ||
+       (this->errorCode != cloneRespMsg->getErrorCode() ) )
+      return TestingEqualsRes_FALSE;
+
+   StorageBenchResultsMap cloneResults;
+   StorageBenchLatencyResultsMap cloneLatencyResults;
+
+   cloneRespMsg->parseResults(&cloneResults);
+   cloneRespMsg->parseLatencyResults(&cloneLatencyResults);
+
+   if(cloneResults.size() != this->resultTargetIDs.size() )
+      return TestingEqualsRes_FALSE;
+
+   bool hasLatencies = isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES);
+
+   if(cloneLatencyResults.size() != (hasLatencies ? this->resultTargetIDs.size() : 0) )
+      return TestingEqualsRes_FALSE;
+
+   Int64ListIter iterValues = this->resultValues.begin();
+   Int64ListIter iterP50 = this->resultLatenciesP50.begin();
+   Int64ListIter iterP99 = this->resultLatenciesP99.begin();
+   Int64ListIter iterP999 = this->resultLatenciesP999.begin();
+
+   for (UInt16ListIter iterTarget = this->resultTargetIDs.begin();
+      iterTarget != this->resultTargetIDs.end(); iterTarget++, iterValues++)
+   {
+      if(cloneResults[*iterTarget] != *iterValues)
+         return TestingEqualsRes_FALSE;
+
+      if(!hasLatencies)
+         continue;
+
+      StorageBenchLatencyResult& cloneLatencies = cloneLatencyResults[*iterTarget];
+
+      if( (cloneLatencies.p50 != *iterP50) ||
+          (cloneLatencies.p99 != *iterP99) ||
+          (cloneLatencies.p999 != *iterP999) )
+         return TestingEqualsRes_FALSE;
+
+      iterP50++;
+      iterP99++;
+      iterP999++;
+   }
+
+   return TestingEqualsRes_TRUE;
 }
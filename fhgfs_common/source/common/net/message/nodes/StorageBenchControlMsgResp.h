@@ -6,6 +6,10 @@
 #include <common/toolkit/serialization/Serialization.h>
 
 
+#define STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES   1 /* msg includes latency percentiles (only
+                                                             set if requested by the caller) */
+
+
 class StorageBenchControlMsgResp: public NetMessage
 {
    public:
@@ -35,19 +39,34 @@ class StorageBenchControlMsgResp: public NetMessage
       {
       }
 
+      virtual TestingEqualsRes testingEquals(NetMessage* cloneMsg);
+
    protected:
       virtual void serializePayload(char* buf);
       virtual bool deserializePayload(const char* buf, size_t bufLen);
 
       unsigned calcMessageLength()
       {
-         return NETMSG_HEADER_LENGTH +
+         unsigned msgLen = NETMSG_HEADER_LENGTH +
             Serialization::serialLenInt() + // status
             Serialization::serialLenInt() + // action
             Serialization::serialLenInt() + // type
             Serialization::serialLenInt() + // errorCode
             Serialization::serialLenUInt16List(&this->resultTargetIDs) + // resultTargetIDs
             Serialization::serialLenInt64List(&this->resultValues); // resultValues
+
+         if(isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES) )
+            msgLen +=
+               Serialization::serialLenInt64List(&this->resultLatenciesP50) + // P50
+               Serialization::serialLenInt64List(&this->resultLatenciesP99) + // P99
+               Serialization::serialLenInt64List(&this->resultLatenciesP999); // P999
+
+         return msgLen;
+      }
+
+      unsigned getSupportedHeaderFeatureFlagsMask() const
+      {
+         return STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES;
       }
 
    private:
@@ -57,6 +76,9 @@ class StorageBenchControlMsgResp: public NetMessage
       int errorCode;             // STORAGEBENCH_ERROR...
       UInt16List resultTargetIDs;
       Int64List resultValues;
+      Int64List resultLatenciesP50; // (same order as resultTargetIDs)
+      Int64List resultLatenciesP99;
+      Int64List resultLatenciesP999;
 
       // deserialization info
      unsigned resultTargetIDsElemNum;
@@ -67,9 +89,42 @@ class StorageBenchControlMsgResp: public NetMessage
      const char* resultValuesListStart;
      unsigned resultValuesBufLen;
 
+     unsigned resultLatenciesP50ElemNum;
+     const char* resultLatenciesP50ListStart;
+     unsigned resultLatenciesP50BufLen;
+
+     unsigned resultLatenciesP99ElemNum;
+     const char* resultLatenciesP99ListStart;
+     unsigned resultLatenciesP99BufLen;
+
+     unsigned resultLatenciesP999ElemNum;
+     const char* resultLatenciesP999ListStart;
+     unsigned resultLatenciesP999BufLen;
+
    public:
       //inliners
 
+      /**
+       * Add the latency percentiles of the result targets (only if the caller asked for them,
+       * see StorageBenchControlMsg::addLatencyRequest() ).
+       *
+       * @param latencyResults should contain the same targets as the results
+       */
+      void addLatencyResults(StorageBenchLatencyResultsMap& latencyResults)
+      {
+         for (UInt16ListIter iter = this->resultTargetIDs.begin();
+            iter != this->resultTargetIDs.end(); iter++)
+         {
+            StorageBenchLatencyResult& latencyResult = latencyResults[*iter];
+
+            this->resultLatenciesP50.push_back(latencyResult.p50);
+            this->resultLatenciesP99.push_back(latencyResult.p99);
+            this->resultLatenciesP999.push_back(latencyResult.p999);
+         }
+
+         addMsgHeaderFeatureFlag(STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES);
+      }
+
       StorageBenchStatus getStatus()
       {
          return (StorageBenchStatus)this->status;
@@ -107,6 +162,44 @@ class StorageBenchControlMsgResp: public NetMessage
             (*outResults)[(*iterTarget)] = (*iterValues);
          }
       }
+
+      /**
+       * @param outLatencyResults stays empty if the msg has no latencies (older servers)
+       */
+      void parseLatencyResults(StorageBenchLatencyResultsMap* outLatencyResults)
+      {
+         if(!isMsgHeaderFeatureFlagSet(STORAGEBENCHCONTROLMSGRESP_FLAG_HAS_LATENCIES) )
+            return;
+
+         UInt16List resultTargetIds;
+         Serialization::deserializeUInt16List(this->resultTargetIDsBufLen,
+            this->resultTargetIDsElemNum, this->resultTargetIDsListStart, &resultTargetIds);
+
+         Int64List latenciesP50;
+         Serialization::deserializeInt64List(this->resultLatenciesP50BufLen,
+            this->resultLatenciesP50ElemNum, this->resultLatenciesP50ListStart, &latenciesP50);
+
+         Int64List latenciesP99;
+         Serialization::deserializeInt64List(this->resultLatenciesP99BufLen,
+            this->resultLatenciesP99ElemNum, this->resultLatenciesP99ListStart, &latenciesP99);
+
+         Int64List latenciesP999;
+         Serialization::deserializeInt64List(this->resultLatenciesP999BufLen,
+            this->resultLatenciesP999ElemNum, this->resultLatenciesP999ListStart, &latenciesP999);
+
+         Int64ListIter iterP50 = latenciesP50.begin();
+         Int64ListIter iterP99 = latenciesP99.begin();
+         Int64ListIter iterP999 = latenciesP999.begin();
+         for (UInt16ListIter iterTarget = resultTargetIds.begin();
+            iterTarget != resultTargetIds.end(); iterTarget++, iterP50++, iterP99++, iterP999++)
+         {
+            StorageBenchLatencyResult& latencyResult = (*outLatencyResults)[(*iterTarget)];
+
+            latencyResult.p50 = *iterP50;
+            latencyResult.p99 = *iterP99;
+            latencyResult.p999 = *iterP999;
+         }
+      }
 };
 
 #endif /* STORAGEBENCHCONTROLMSGRESP_H_ */
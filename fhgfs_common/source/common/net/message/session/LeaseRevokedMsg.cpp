@@ -0,0 +1,70 @@
+#include "LeaseRevokedMsg.h"
+
+bool LeaseRevokedMsg::deserializePayload(const char* buf, size_t bufLen)
+{
+   size_t bufPos = 0;
+
+   // entryID
+
+   unsigned entryIDBufLen;
+
+   if(!Serialization::deserializeStrAlign4(&buf[bufPos], bufLen-bufPos,
+      &entryIDLen, &entryID, &entryIDBufLen) )
+      return false;
+
+   bufPos += entryIDBufLen;
+
+   // ackID
+
+   unsigned ackBufLen;
+
+   if(!Serialization::deserializeStrAlign4(&buf[bufPos], bufLen-bufPos,
+      &ackIDLen, &ackID, &ackBufLen) )
+      return false;
+
+   bufPos += ackBufLen;
+
+   // revokerNodeID
+
+   unsigned revokerNodeIDBufLen;
+
+   if(!Serialization::deserializeUShort(&buf[bufPos], bufLen-bufPos,
+      &revokerNodeID, &revokerNodeIDBufLen) )
+      return false;
+
+   bufPos += revokerNodeIDBufLen;
+
+   return true;
+}
+
+void LeaseRevokedMsg::serializePayload(char* buf)
+{
+   size_t bufPos = 0;
+
+   // entryID
+   bufPos += Serialization::serializeStrAlign4(&buf[bufPos], entryIDLen, entryID);
+
+   // ackID
+   bufPos += Serialization::serializeStrAlign4(&buf[bufPos], ackIDLen, ackID);
+
+   // revokerNodeID
+   bufPos += Serialization::serializeUShort(&buf[bufPos], revokerNodeID);
+}
+
+TestingEqualsRes LeaseRevokedMsg::testingEquals(NetMessage* cloneMsg)
+{
+   LeaseRevokedMsg* cloneRevokedMsg = (LeaseRevokedMsg*) cloneMsg;
+
+   if( (this->entryIDLen != cloneRevokedMsg->entryIDLen) ||
+       strcmp(this->entryID, cloneRevokedMsg->getEntryID() ) )
+      return TestingEqualsRes_FALSE;
+
+   if( (this->ackIDLen != cloneRevokedMsg->ackIDLen) ||
+       strcmp(this->ackID, cloneRevokedMsg->getAckID() ) )
+      return TestingEqualsRes_FALSE;
+
+   if(this->revokerNodeID != cloneRevokedMsg->getRevokerNodeID() )
+      return TestingEqualsRes_FALSE;
+
+   return TestingEqualsRes_TRUE;
+}
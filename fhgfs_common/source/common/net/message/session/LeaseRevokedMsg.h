@@ -0,0 +1,96 @@
+#ifndef LEASEREVOKEDMSG_H_
+#define LEASEREVOKEDMSG_H_
+
+#include <common/Common.h>
+#include <common/net/message/AcknowledgeableMsg.h>
+
+
+/**
+ * Tells a client that its lease on the dentry and attribs of an entry was revoked, because the
+ * entry was modified.
+ */
+class LeaseRevokedMsg : public AcknowledgeableMsg
+{
+   public:
+
+      /**
+       * @param entryID just a reference, so do not free it as long as you use this object!
+       * @param ackID reply ack; just a reference, so do not free it as long as you use this object!
+       * @param revokerNodeID nodeID of the sender of this msg (=> receiver of the ack)
+       */
+      LeaseRevokedMsg(const std::string& entryID, const std::string& ackID,
+         uint16_t revokerNodeID) :
+         AcknowledgeableMsg(NETMSGTYPE_LeaseRevoked)
+      {
+         this->entryID = entryID.c_str();
+         this->entryIDLen = entryID.length();
+
+         this->ackID = ackID.c_str();
+         this->ackIDLen = ackID.length();
+
+         this->revokerNodeID = revokerNodeID;
+      }
+
+      /**
+       * Constructor for deserialization only
+       */
+      LeaseRevokedMsg() : AcknowledgeableMsg(NETMSGTYPE_LeaseRevoked)
+      {
+      }
+
+      virtual TestingEqualsRes testingEquals(NetMessage* cloneMsg);
+
+
+   protected:
+      virtual void serializePayload(char* buf);
+      virtual bool deserializePayload(const char* buf, size_t bufLen);
+
+      unsigned calcMessageLength()
+      {
+         return NETMSG_HEADER_LENGTH +
+            Serialization::serialLenStrAlign4(entryIDLen) +
+            Serialization::serialLenStrAlign4(ackIDLen) +
+            Serialization::serialLenUShort(); // revokerNodeID
+      }
+
+
+      /**
+       * @param ackID just a reference
+       */
+      void setAckIDInternal(const char* ackID)
+      {
+         this->ackID = ackID;
+         this->ackIDLen = strlen(ackID);
+      }
+
+
+   private:
+      unsigned entryIDLen;
+      const char* entryID;
+      unsigned ackIDLen;
+      const char* ackID;
+      uint16_t revokerNodeID;
+
+
+   public:
+
+      // getters & setters
+      const char* getEntryID() const
+      {
+         return entryID;
+      }
+
+      const char* getAckID()
+      {
+         return ackID;
+      }
+
+      uint16_t getRevokerNodeID()
+      {
+         return revokerNodeID;
+      }
+
+};
+
+
+#endif /* LEASEREVOKEDMSG_H_ */
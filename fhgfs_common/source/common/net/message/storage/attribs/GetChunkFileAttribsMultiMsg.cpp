@@ -0,0 +1,75 @@
+#include "GetChunkFileAttribsMultiMsg.h"
+
+bool GetChunkFileAttribsMultiMsg::deserializePayload(const char* buf, size_t bufLen)
+{
+   size_t bufPos = 0;
+
+   { // targetID
+      unsigned targetBufLen;
+
+      if(!Serialization::deserializeUShort(&buf[bufPos], bufLen-bufPos,
+         &targetID, &targetBufLen) )
+         return false;
+
+      bufPos += targetBufLen;
+   }
+
+   { // entryIDs
+      if(!Serialization::deserializeStringListPreprocess(&buf[bufPos], bufLen-bufPos,
+         &entryIDsElemNum, &entryIDsListStart, &entryIDsBufLen) )
+         return false;
+
+      bufPos += entryIDsBufLen;
+   }
+
+   { // pathInfos
+      if(!Serialization::deserializePathInfoListPreprocess(&buf[bufPos], bufLen-bufPos,
+         &pathInfosElemNum, &pathInfosListStart, &pathInfosBufLen) )
+         return false;
+
+      bufPos += pathInfosBufLen;
+   }
+
+   if(unlikely(entryIDsElemNum != pathInfosElemNum) )
+      return false;
+
+   return true;
+}
+
+void GetChunkFileAttribsMultiMsg::serializePayload(char* buf)
+{
+   size_t bufPos = 0;
+
+   // targetID
+   bufPos += Serialization::serializeUShort(&buf[bufPos], targetID);
+
+   // entryIDs
+   bufPos += Serialization::serializeStringList(&buf[bufPos], entryIDs);
+
+   // pathInfos
+   bufPos += Serialization::serializePathInfoList(&buf[bufPos], pathInfos);
+}
+
+TestingEqualsRes GetChunkFileAttribsMultiMsg::testingEquals(NetMessage* cloneMsg)
+{
+   GetChunkFileAttribsMultiMsg* cloneAttribsMsg = (GetChunkFileAttribsMultiMsg*) cloneMsg;
+
+   if(this->targetID != cloneAttribsMsg->getTargetID() )
+      return TestingEqualsRes_FALSE;
+
+   StringList cloneEntryIDs;
+   PathInfoList clonePathInfos;
+
+   if(!cloneAttribsMsg->parseEntryIDs(&cloneEntryIDs) )
+      return TestingEqualsRes_FALSE;
+
+   cloneAttribsMsg->parsePathInfos(&clonePathInfos);
+
+   if(*this->entryIDs != cloneEntryIDs)
+      return TestingEqualsRes_FALSE;
+
+   if(*this->pathInfos != clonePathInfos)
+      return TestingEqualsRes_FALSE;
+
+   return TestingEqualsRes_TRUE;
+}
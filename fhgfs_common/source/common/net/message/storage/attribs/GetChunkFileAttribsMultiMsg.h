@@ -0,0 +1,106 @@
+#ifndef GETCHUNKFILEATTRIBSMULTIMSG_H_
+#define GETCHUNKFILEATTRIBSMULTIMSG_H_
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/PathInfo.h>
+#include "GetChunkFileAttribsMsg.h"
+
+
+#define GETCHUNKFILEATTRIBSMULTIMSG_MAX_ENTRIES  256 /* max number of chunks per msg */
+
+
+/**
+ * Get the attributes of multiple chunk files on the same target (batched version of
+ * GetChunkFileAttribsMsg).
+ *
+ * Header feature flags are the same as for GetChunkFileAttribsMsg (GETCHUNKFILEATTRSMSG_FLAG_...).
+ */
+class GetChunkFileAttribsMultiMsg : public NetMessage
+{
+   friend class AbstractNetMessageFactory;
+
+   public:
+
+      /**
+       * @param entryIDs just a reference, so do not free it as long as you use this object!
+       * @param pathInfos just a reference, so do not free it as long as you use this object!
+       *    (same order and number of elements as entryIDs)
+       */
+      GetChunkFileAttribsMultiMsg(uint16_t targetID, StringList* entryIDs,
+         PathInfoList* pathInfos) : NetMessage(NETMSGTYPE_GetChunkFileAttribsMulti)
+      {
+         this->targetID = targetID;
+         this->entryIDs = entryIDs;
+         this->pathInfos = pathInfos;
+      }
+
+      /**
+       * For deserialization only
+       */
+      GetChunkFileAttribsMultiMsg() : NetMessage(NETMSGTYPE_GetChunkFileAttribsMulti)
+      {
+      }
+
+      virtual TestingEqualsRes testingEquals(NetMessage* cloneMsg);
+
+
+   protected:
+      virtual void serializePayload(char* buf);
+      virtual bool deserializePayload(const char* buf, size_t bufLen);
+
+      unsigned calcMessageLength()
+      {
+         return NETMSG_HEADER_LENGTH                           +
+            Serialization::serialLenUShort()                   + // targetID
+            Serialization::serialLenStringList(entryIDs)       +
+            Serialization::serialLenPathInfoList(pathInfos);
+      }
+
+      unsigned getSupportedHeaderFeatureFlagsMask() const
+      {
+         return GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR |
+            GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR_SECOND;
+      }
+
+
+   private:
+      uint16_t targetID;
+
+      // for serialization
+      StringList* entryIDs; // not owned by this object!
+      PathInfoList* pathInfos; // not owned by this object!
+
+      // for deserialization
+      unsigned entryIDsElemNum;
+      const char* entryIDsListStart;
+      unsigned entryIDsBufLen;
+
+      unsigned pathInfosElemNum;
+      const char* pathInfosListStart;
+      unsigned pathInfosBufLen;
+
+
+   public:
+      // inliners
+
+      bool parseEntryIDs(StringList* outEntryIDs)
+      {
+         return Serialization::deserializeStringList(entryIDsBufLen, entryIDsElemNum,
+            entryIDsListStart, outEntryIDs);
+      }
+
+      void parsePathInfos(PathInfoList* outPathInfos)
+      {
+         Serialization::deserializePathInfoList(pathInfosBufLen, pathInfosElemNum,
+            pathInfosListStart, outPathInfos);
+      }
+
+      // getters & setters
+
+      uint16_t getTargetID() const
+      {
+         return targetID;
+      }
+};
+
+#endif /*GETCHUNKFILEATTRIBSMULTIMSG_H_*/
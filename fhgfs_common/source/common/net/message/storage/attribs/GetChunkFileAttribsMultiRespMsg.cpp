@@ -0,0 +1,78 @@
+#include "GetChunkFileAttribsMultiRespMsg.h"
+
+void GetChunkFileAttribsMultiRespMsg::serializePayload(char* buf)
+{
+   size_t bufPos = 0;
+
+   // results
+   bufPos += Serialization::serializeIntList(&buf[bufPos], results);
+
+   // dynAttribsVec
+   bufPos += Serialization::serializeUInt(&buf[bufPos], dynAttribsVec->size() );
+
+   for(DynamicFileAttribsVecCIter iter = dynAttribsVec->begin();
+       iter != dynAttribsVec->end();
+       iter++)
+      bufPos += iter->serialize(&buf[bufPos]);
+}
+
+bool GetChunkFileAttribsMultiRespMsg::deserializePayload(const char* buf, size_t bufLen)
+{
+   size_t bufPos = 0;
+
+   { // results
+      if(!Serialization::deserializeIntListPreprocess(&buf[bufPos], bufLen-bufPos,
+         &resultsElemNum, &resultsListStart, &resultsBufLen) )
+         return false;
+
+      bufPos += resultsBufLen;
+   }
+
+   { // dynAttribsVec
+      unsigned elemNum;
+      unsigned elemNumBufLen;
+
+      if(!Serialization::deserializeUInt(&buf[bufPos], bufLen-bufPos, &elemNum, &elemNumBufLen) )
+         return false;
+
+      bufPos += elemNumBufLen;
+
+      if( (elemNum != resultsElemNum) ||
+          ( (bufLen-bufPos) < (elemNum * DynamicFileAttribs::serialLen() ) ) )
+         return false;
+
+      dynAttribsStart = &buf[bufPos];
+
+      bufPos += elemNum * DynamicFileAttribs::serialLen();
+   }
+
+   return true;
+}
+
+TestingEqualsRes GetChunkFileAttribsMultiRespMsg::testingEquals(NetMessage* cloneMsg)
+{
+   GetChunkFileAttribsMultiRespMsg* cloneRespMsg = (GetChunkFileAttribsMultiRespMsg*) cloneMsg;
+
+   if(this->results->size() != cloneRespMsg->getNumEntries() )
+      return TestingEqualsRes_FALSE;
+
+   if(this->dynAttribsVec->size() != cloneRespMsg->getNumEntries() )
+      return TestingEqualsRes_FALSE;
+
+   unsigned index = 0;
+
+   for(IntListConstIter iter = this->results->begin(); iter != this->results->end();
+       iter++, index++)
+   {
+      if(*iter != cloneRespMsg->getResult(index) )
+         return TestingEqualsRes_FALSE;
+
+      DynamicFileAttribs cloneDynAttribs;
+      cloneRespMsg->parseDynAttribs(index, &cloneDynAttribs);
+
+      if(!dynamicFileAttribsEquals( (*this->dynAttribsVec)[index], cloneDynAttribs) )
+         return TestingEqualsRes_FALSE;
+   }
+
+   return TestingEqualsRes_TRUE;
+}
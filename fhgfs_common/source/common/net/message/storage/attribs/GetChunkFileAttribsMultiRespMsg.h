@@ -0,0 +1,111 @@
+#ifndef GETCHUNKFILEATTRIBSMULTIRESPMSG_H_
+#define GETCHUNKFILEATTRIBSMULTIRESPMSG_H_
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/striping/DynamicFileAttribs.h>
+#include <common/Common.h>
+
+
+/**
+ * Response to GetChunkFileAttribsMultiMsg with one result and one set of attribs per requested
+ * chunk (in request order).
+ *
+ * Note: As for GetChunkFileAttribsRespMsg, a non-existing chunk file is not an error, but has
+ * storageVersion 0.
+ */
+class GetChunkFileAttribsMultiRespMsg : public NetMessage
+{
+   public:
+      /**
+       * @param results just a reference, so do not free it as long as you use this object!
+       * @param dynAttribsVec just a reference, so do not free it as long as you use this object!
+       */
+      GetChunkFileAttribsMultiRespMsg(IntList* results, DynamicFileAttribsVec* dynAttribsVec) :
+         NetMessage(NETMSGTYPE_GetChunkFileAttribsMultiResp)
+      {
+         this->results = results;
+         this->dynAttribsVec = dynAttribsVec;
+      }
+
+      /**
+       * For deserialization only!
+       */
+      GetChunkFileAttribsMultiRespMsg() : NetMessage(NETMSGTYPE_GetChunkFileAttribsMultiResp)
+      {
+      }
+
+      virtual TestingEqualsRes testingEquals(NetMessage* cloneMsg);
+
+
+   protected:
+
+      virtual void serializePayload(char* buf);
+      virtual bool deserializePayload(const char* buf, size_t bufLen);
+
+      virtual unsigned calcMessageLength()
+      {
+         return NETMSG_HEADER_LENGTH +
+            Serialization::serialLenIntList(results) +
+            Serialization::serialLenUInt() + // dynAttribsVec size
+            dynAttribsVec->size() * DynamicFileAttribs::serialLen();
+      }
+
+
+   private:
+      // for serialization
+      IntList* results; // not owned by this object!
+      DynamicFileAttribsVec* dynAttribsVec; // not owned by this object!
+
+      // for deserialization
+      unsigned resultsElemNum;
+      const char* resultsListStart;
+      unsigned resultsBufLen;
+
+      const char* dynAttribsStart;
+
+
+   public:
+      // inliners
+
+      /*
+       * the results and attribs are read from the receive buffer of this message on demand, so
+       * these must not be used after it was freed.
+       */
+
+      /**
+       * @return number of entries in this response (same for results and attribs)
+       */
+      unsigned getNumEntries()
+      {
+         return resultsElemNum;
+      }
+
+      /**
+       * @param index must be smaller than getNumEntries()
+       */
+      FhgfsOpsErr getResult(unsigned index)
+      {
+         return (FhgfsOpsErr)Serialization::loadLE<int>(
+            &resultsListStart[index * Serialization::serialLenInt()]);
+      }
+
+      /**
+       * @param index must be smaller than getNumEntries()
+       */
+      void parseDynAttribs(unsigned index, DynamicFileAttribs* outDynAttribs)
+      {
+         unsigned attribsBufLen;
+
+         // (the length of all elements was verified during deserialization)
+         outDynAttribs->deserialize(&dynAttribsStart[index * DynamicFileAttribs::serialLen()],
+            DynamicFileAttribs::serialLen(), &attribsBufLen);
+      }
+
+      bool parseResults(IntList* outResults)
+      {
+         return Serialization::deserializeIntList(resultsBufLen, resultsElemNum,
+            resultsListStart, outResults);
+      }
+};
+
+#endif /*GETCHUNKFILEATTRIBSMULTIRESPMSG_H_*/
@@ -12,6 +12,17 @@ bool StatMsg::deserializePayload(const char* buf, size_t bufLen)
 
    bufPos += entryBufLen;
 
+   if(isMsgHeaderCompatFeatureFlagSet(STATMSG_COMPAT_FLAG_LEASE) )
+   { // clientID
+      unsigned clientIDBufLen;
+
+      if(!Serialization::deserializeStrAlign4(&buf[bufPos], bufLen-bufPos,
+         &this->clientID, &clientIDBufLen) )
+         return false;
+
+      bufPos += clientIDBufLen;
+   }
+
    return true;
 }
 
@@ -21,5 +32,11 @@ void StatMsg::serializePayload(char* buf)
    
    // entryInfo
    bufPos += this->entryInfoPtr->serialize(&buf[bufPos]);
+
+   if(isMsgHeaderCompatFeatureFlagSet(STATMSG_COMPAT_FLAG_LEASE) )
+   { // clientID
+      bufPos += Serialization::serializeStrAlign4(&buf[bufPos],
+         this->clientID.length(), this->clientID.c_str() );
+   }
 }
 
@@ -8,6 +8,8 @@
 // #define STATMSG_COMPAT_FLAG_GET_PARENTOWNERNODEID     1 /* deprecated */
 #define STATMSG_COMPAT_FLAG_GET_PARENTINFO            2 /* caller wants to have parentOwnerNodeID
                                                          * and parentEntryID */
+#define STATMSG_COMPAT_FLAG_LEASE                     4 /* caller wants a lease on the attribs
+                                                         * (msg includes clientID) */
 
 
 class StatMsg : public NetMessage
@@ -37,8 +39,13 @@ class StatMsg : public NetMessage
       
       unsigned calcMessageLength()
       {
-         return NETMSG_HEADER_LENGTH +
+         unsigned msgLen = NETMSG_HEADER_LENGTH +
             this->entryInfoPtr->serialLen();
+
+         if(isMsgHeaderCompatFeatureFlagSet(STATMSG_COMPAT_FLAG_LEASE) )
+            msgLen += Serialization::serialLenStrAlign4(this->clientID.length() );
+
+         return msgLen;
       }
 
 
@@ -50,14 +57,28 @@ class StatMsg : public NetMessage
       // for deserialization
       EntryInfo entryInfo;
 
+      std::string clientID; // only set if STATMSG_COMPAT_FLAG_LEASE is set
+
    public:
-   
+
+      void addLeaseRequest(const std::string& clientID)
+      {
+         this->clientID = clientID;
+
+         addMsgHeaderCompatFeatureFlag(STATMSG_COMPAT_FLAG_LEASE);
+      }
+
       // getters & setters
 
       EntryInfo* getEntryInfo(void)
       {
          return &this->entryInfo;
       }
+
+      const std::string& getClientID() const
+      {
+         return this->clientID;
+      }
 };
 
 #endif /*STATMSG_H_*/
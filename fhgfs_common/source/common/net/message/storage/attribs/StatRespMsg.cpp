@@ -21,6 +21,12 @@ void StatRespMsg::serializePayload(char* buf)
       // parentNodeID
       bufPos += Serialization::serializeUInt16(&buf[bufPos], this->parentNodeID);
    }
+
+   if(isMsgHeaderFeatureFlagSet(STATRESPMSG_FLAG_HAS_LEASE) )
+   {
+      // leaseMS
+      bufPos += Serialization::serializeUInt(&buf[bufPos], this->leaseMS);
+   }
 }
 
 bool StatRespMsg::deserializePayload(const char* buf, size_t bufLen)
@@ -70,6 +76,17 @@ bool StatRespMsg::deserializePayload(const char* buf, size_t bufLen)
 
    }
 
+   if(isMsgHeaderFeatureFlagSet(STATRESPMSG_FLAG_HAS_LEASE) )
+   {  // leaseMS
+      unsigned fieldLen;
+
+      if (!Serialization::deserializeUInt(&buf[bufPos], bufLen-bufPos,
+         &this->leaseMS, &fieldLen) )
+         return false;
+
+      bufPos += fieldLen;
+   }
+
    return true;
 }
 
@@ -12,6 +12,8 @@
 
 #define STATRESPMSG_FLAG_HAS_PARENTINFO                  1 /* msg includes parentOwnerNodeID and
                                                               parentEntryID */
+#define STATRESPMSG_FLAG_HAS_LEASE                       2 /* msg includes leaseMS (only set if
+                                                              the caller requested a lease) */
 
 
 class StatRespMsg : public NetMessage
@@ -30,6 +32,7 @@ class StatRespMsg : public NetMessage
       StatRespMsg() : NetMessage(NETMSGTYPE_StatResp)
       {
          this->parentNodeID = 0;
+         this->leaseMS = 0;
       }
    
    protected:
@@ -49,12 +52,15 @@ class StatRespMsg : public NetMessage
             msgLen += Serialization::serialLenUInt16(); // parentNodeID
          }
 
+         if(isMsgHeaderFeatureFlagSet(STATRESPMSG_FLAG_HAS_LEASE) )
+            msgLen += Serialization::serialLenUInt(); // leaseMS
+
          return msgLen;
       }
       
       virtual unsigned getSupportedHeaderFeatureFlagsMask() const
       {
-         return STATRESPMSG_FLAG_HAS_PARENTINFO;
+         return STATRESPMSG_FLAG_HAS_PARENTINFO | STATRESPMSG_FLAG_HAS_LEASE;
       }
 
 
@@ -65,6 +71,8 @@ class StatRespMsg : public NetMessage
       uint16_t parentNodeID;
       std::string parentEntryID;
 
+      unsigned leaseMS;
+
    public:
       // getters & setters
       int getResult()
@@ -89,6 +97,18 @@ class StatRespMsg : public NetMessage
       {
          return this->parentNodeID;
       }
+
+      void addLease(unsigned leaseMS)
+      {
+         this->leaseMS = leaseMS;
+
+         addMsgHeaderFeatureFlag(STATRESPMSG_FLAG_HAS_LEASE);
+      }
+
+      unsigned getLeaseMS()
+      {
+         return this->leaseMS;
+      }
 };
 
 #endif /*STATRESPMSG_H_*/
@@ -2,6 +2,7 @@
 #define LISTDIRFROMPFFSETRESPMSG_H_
 
 #include <common/net/message/NetMessage.h>
+#include <common/toolkit/serialization/SerializedStr.h>
 #include <common/Common.h>
 
 class ListDirFromOffsetRespMsg : public NetMessage
@@ -93,6 +94,47 @@ class ListDirFromOffsetRespMsg : public NetMessage
             this->serverOffsetsElemNum, this->serverOffsetsListStart, outServerOffsets);
       }
 
+      /*
+       * zero-copy alternatives to the parse...() methods above. the results point into the
+       * receive buffer of this message, so they must not be used after it was freed.
+       */
+
+      SerializedStrList getNamesView()
+      {
+         return SerializedStrList(this->namesBufLen, this->namesElemNum, this->namesListStart);
+      }
+
+      SerializedStrList getEntryIDsView()
+      {
+         return SerializedStrList(this->entryIDsBufLen, this->entryIDsElemNum,
+            this->entryIDsListStart);
+      }
+
+      /**
+       * @return number of entries in this response (all lists have the same length)
+       */
+      unsigned getNumEntries()
+      {
+         return this->namesElemNum;
+      }
+
+      /**
+       * @param index must be smaller than getNumEntries()
+       */
+      DirEntryType getEntryType(unsigned index)
+      {
+         return (DirEntryType)(uint8_t)this->entryTypesListStart[index];
+      }
+
+      /**
+       * @param index must be smaller than getNumEntries()
+       */
+      int64_t getServerOffset(unsigned index)
+      {
+         return Serialization::loadLE<int64_t>(
+            &this->serverOffsetsListStart[index * Serialization::serialLenInt64()]);
+      }
+
       // getters & setters
       FhgfsOpsErr getResult()
       {
@@ -0,0 +1,67 @@
+#include "ListDirPlusMsg.h"
+
+bool ListDirPlusMsg::deserializePayload(const char* buf, size_t bufLen)
+{
+   size_t bufPos = 0;
+
+   { // serverOffset
+      unsigned serverOffsetBufLen;
+
+      if(!Serialization::deserializeInt64(&buf[bufPos], bufLen-bufPos,
+         &serverOffset, &serverOffsetBufLen) )
+         return false;
+
+      bufPos += serverOffsetBufLen;
+   }
+
+   { // maxOutNames
+      unsigned maxOutNamesBufLen;
+
+      if(!Serialization::deserializeUInt(&buf[bufPos], bufLen-bufPos,
+         &maxOutNames, &maxOutNamesBufLen) )
+         return false;
+
+      bufPos += maxOutNamesBufLen;
+   }
+
+   { // entryInfo
+      unsigned entryInfoBufLen;
+
+      if(!this->entryInfo.deserialize(&buf[bufPos], bufLen-bufPos, &entryInfoBufLen) )
+         return false;
+
+      bufPos += entryInfoBufLen;
+   }
+
+   return true;
+}
+
+void ListDirPlusMsg::serializePayload(char* buf)
+{
+   size_t bufPos = 0;
+
+   // serverOffset
+   bufPos += Serialization::serializeInt64(&buf[bufPos], serverOffset);
+
+   // maxOutNames
+   bufPos += Serialization::serializeUInt(&buf[bufPos], maxOutNames);
+
+   // entryInfo
+   bufPos += this->entryInfoPtr->serialize(&buf[bufPos]);
+}
+
+TestingEqualsRes ListDirPlusMsg::testingEquals(NetMessage* cloneMsg)
+{
+   ListDirPlusMsg* cloneListMsg = (ListDirPlusMsg*) cloneMsg;
+
+   if(!this->entryInfoPtr->compare(cloneListMsg->getEntryInfo() ) )
+      return TestingEqualsRes_FALSE;
+
+   if(this->serverOffset != cloneListMsg->getServerOffset() )
+      return TestingEqualsRes_FALSE;
+
+   if(this->maxOutNames != cloneListMsg->getMaxOutNames() )
+      return TestingEqualsRes_FALSE;
+
+   return TestingEqualsRes_TRUE;
+}
@@ -0,0 +1,90 @@
+#ifndef LISTDIRPLUSMSG_H_
+#define LISTDIRPLUSMSG_H_
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/EntryInfo.h>
+
+
+/**
+ * Incremental directory listing like ListDirFromOffsetMsg, but the response also contains owner
+ * info and stat data of each returned entry ("readdir-plus"), so that clients don't need to send
+ * a separate stat request per entry (e.g. for "ls -l").
+ *
+ * Note: "." and ".." are included (as for readdir), but without owner info and stat data.
+ */
+class ListDirPlusMsg : public NetMessage
+{
+   friend class AbstractNetMessageFactory;
+
+   public:
+
+      /**
+       * @param entryInfo just a reference, so do not free it as long as you use this object!
+       * @param serverOffset zero-based, in incremental calls use only values returned via
+       * ListDirPlusResp here (because offset is not guaranteed to be 0, 1, 2, 3, ...).
+       */
+      ListDirPlusMsg(EntryInfo* entryInfo, int64_t serverOffset, unsigned maxOutNames) :
+         NetMessage(NETMSGTYPE_ListDirPlus)
+      {
+         this->entryInfoPtr = entryInfo;
+
+         this->serverOffset = serverOffset;
+
+         this->maxOutNames = maxOutNames;
+      }
+
+      /**
+       * For deserialization only
+       */
+      ListDirPlusMsg() : NetMessage(NETMSGTYPE_ListDirPlus)
+      {
+      }
+
+      virtual TestingEqualsRes testingEquals(NetMessage* cloneMsg);
+
+
+   protected:
+      virtual void serializePayload(char* buf);
+      virtual bool deserializePayload(const char* buf, size_t bufLen);
+
+      unsigned calcMessageLength()
+      {
+         return NETMSG_HEADER_LENGTH +
+            this->entryInfoPtr->serialLen() +
+            Serialization::serialLenInt64() + // serverOffset
+            Serialization::serialLenUInt();   // maxOutNames
+      }
+
+
+   private:
+      int64_t serverOffset;
+      unsigned maxOutNames;
+
+      // for serialization
+      EntryInfo* entryInfoPtr; // not owned by this object!
+
+      // for deserialization
+      EntryInfo entryInfo;
+
+
+   public:
+      // getters & setters
+
+      int64_t getServerOffset() const
+      {
+         return serverOffset;
+      }
+
+      unsigned getMaxOutNames() const
+      {
+         return maxOutNames;
+      }
+
+      EntryInfo* getEntryInfo(void)
+      {
+         return &this->entryInfo;
+      }
+};
+
+
+#endif /*LISTDIRPLUSMSG_H_*/
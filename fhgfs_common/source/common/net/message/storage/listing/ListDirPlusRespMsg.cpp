@@ -0,0 +1,291 @@
+#include <common/app/log/LogContext.h>
+#include "ListDirPlusRespMsg.h"
+
+void ListDirPlusRespMsg::serializePayload(char* buf)
+{
+   size_t bufPos = 0;
+
+   // newServerOffset
+   bufPos += Serialization::serializeInt64(&buf[bufPos], this->newServerOffset);
+
+   // serverOffsets
+   bufPos += Serialization::serializeInt64List(&buf[bufPos], this->serverOffsets);
+
+   // result
+   bufPos += Serialization::serializeInt(&buf[bufPos], this->result);
+
+   // entryTypes
+   bufPos += Serialization::serializeUInt8List(&buf[bufPos], this->entryTypes);
+
+   // entryIDs
+   bufPos += Serialization::serializeStringList(&buf[bufPos], this->entryIDs);
+
+   // names
+   bufPos += Serialization::serializeStringList(&buf[bufPos], this->names);
+
+   // ownerNodeIDs
+   bufPos += Serialization::serializeUInt16List(&buf[bufPos], this->ownerNodeIDs);
+
+   // entryFlags
+   bufPos += Serialization::serializeIntList(&buf[bufPos], this->entryFlags);
+
+   // statResults
+   bufPos += Serialization::serializeIntList(&buf[bufPos], this->statResults);
+
+   // statDatas
+   bufPos += serializeStatDataList(&buf[bufPos], this->statDatas);
+}
+
+bool ListDirPlusRespMsg::deserializePayload(const char* buf, size_t bufLen)
+{
+   size_t bufPos = 0;
+
+   {  // newServerOffset
+      unsigned newServerOffsetBufLen;
+
+      if(!Serialization::deserializeInt64(&buf[bufPos], bufLen-bufPos,
+         &this->newServerOffset, &newServerOffsetBufLen) )
+         return false;
+
+      bufPos += newServerOffsetBufLen;
+   }
+
+   {  // serverOffsets
+      if(!Serialization::deserializeInt64ListPreprocess(&buf[bufPos], bufLen-bufPos,
+         &this->serverOffsetsElemNum, &this->serverOffsetsListStart, &this->serverOffsetsBufLen) )
+         return false;
+
+      bufPos += this->serverOffsetsBufLen;
+   }
+
+   {  // result
+      unsigned fieldLen;
+      if(!Serialization::deserializeInt(&buf[bufPos], bufLen-bufPos, &this->result, &fieldLen) )
+         return false;
+
+      bufPos += fieldLen;
+   }
+
+   {  // entryTypes
+      if(!Serialization::deserializeUInt8ListPreprocess(&buf[bufPos], bufLen-bufPos,
+         &this->entryTypesElemNum, &this->entryTypesListStart, &this->entryTypesBufLen) )
+         return false;
+
+      bufPos += this->entryTypesBufLen;
+   }
+
+   {  // entryIDs
+      if (!Serialization::deserializeStringListPreprocess(&buf[bufPos], bufLen-bufPos,
+         &this->entryIDsElemNum, &this->entryIDsListStart, &this->entryIDsBufLen) )
+         return false;
+
+      bufPos += this->entryIDsBufLen;
+   }
+
+   {  // names
+      if(!Serialization::deserializeStringListPreprocess(&buf[bufPos], bufLen-bufPos,
+         &this->namesElemNum, &this->namesListStart, &this->namesBufLen) )
+         return false;
+
+      bufPos += this->namesBufLen;
+   }
+
+   {  // ownerNodeIDs
+      if(!Serialization::deserializeUInt16ListPreprocess(&buf[bufPos], bufLen-bufPos,
+         &this->ownerNodeIDsElemNum, &this->ownerNodeIDsListStart, &this->ownerNodeIDsBufLen) )
+         return false;
+
+      bufPos += this->ownerNodeIDsBufLen;
+   }
+
+   {  // entryFlags
+      if(!Serialization::deserializeIntListPreprocess(&buf[bufPos], bufLen-bufPos,
+         &this->entryFlagsElemNum, &this->entryFlagsListStart, &this->entryFlagsBufLen) )
+         return false;
+
+      bufPos += this->entryFlagsBufLen;
+   }
+
+   {  // statResults
+      if(!Serialization::deserializeIntListPreprocess(&buf[bufPos], bufLen-bufPos,
+         &this->statResultsElemNum, &this->statResultsListStart, &this->statResultsBufLen) )
+         return false;
+
+      bufPos += this->statResultsBufLen;
+   }
+
+   {  // statDatas
+      if(!deserializeStatDataListPreprocess(&buf[bufPos], bufLen-bufPos,
+         &this->statDatasElemNum, &this->statDatasListStart, &this->statDatasBufLen) )
+         return false;
+
+      bufPos += this->statDatasBufLen;
+   }
+
+   if(unlikely(
+      (this->entryTypesElemNum != this->namesElemNum) ||
+      (this->entryTypesElemNum != this->entryIDsElemNum) ||
+      (this->entryTypesElemNum != this->serverOffsetsElemNum) ||
+      (this->entryTypesElemNum != this->ownerNodeIDsElemNum) ||
+      (this->entryTypesElemNum != this->entryFlagsElemNum) ||
+      (this->entryTypesElemNum != this->statResultsElemNum) ||
+      (this->entryTypesElemNum != this->statDatasElemNum) ) ) // check for equal list lengths
+   {
+      LogContext(__func__).log(Log_WARNING,
+         "Sanity check failed (number of list elements does not match!");
+      LogContext(__func__).logBacktrace();
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * Serialize StatData elements in network format with the same bufLen and elemNum header as the
+ * fixed-size lists, so that the receiver can skip the whole list without parsing each element.
+ */
+unsigned ListDirPlusRespMsg::serializeStatDataList(char* buf, StatDataList* statDatas)
+{
+   size_t bufPos = 0;
+
+   // totalBufLen info field
+   bufPos += Serialization::serializeUInt(&buf[bufPos], serialLenStatDataList(statDatas) );
+
+   // elem count info field
+   bufPos += Serialization::serializeUInt(&buf[bufPos], statDatas->size() );
+
+   for(StatDataListIter iter = statDatas->begin(); iter != statDatas->end(); iter++)
+      bufPos += iter->serialize(false, true, true, &buf[bufPos]);
+
+   return bufPos;
+}
+
+/**
+ * @return false on error or inconsistency
+ */
+bool ListDirPlusRespMsg::deserializeStatDataListPreprocess(const char* buf, size_t bufLen,
+   unsigned* outElemNum, const char** outListStart, unsigned* outLen)
+{
+   const size_t headerLen = Serialization::serialLenUInt() + Serialization::serialLenUInt();
+
+   size_t bufPos = 0;
+   unsigned fieldLen;
+
+   // totalBufLen info field
+   if(!Serialization::deserializeUInt(&buf[bufPos], bufLen-bufPos, outLen, &fieldLen) )
+      return false;
+
+   bufPos += fieldLen;
+
+   // elem count info field
+   if(!Serialization::deserializeUInt(&buf[bufPos], bufLen-bufPos, outElemNum, &fieldLen) )
+      return false;
+
+   bufPos += fieldLen;
+
+   *outListStart = &buf[bufPos];
+
+   if(unlikely( (*outLen > bufLen) || (*outLen < headerLen) ) )
+      return false;
+
+   return true;
+}
+
+/**
+ * Appends the elements to outStatDatas.
+ * (requires pre-processing)
+ *
+ * @return false on error or inconsistency
+ */
+bool ListDirPlusRespMsg::deserializeStatDataList(unsigned listBufLen, unsigned elemNum,
+   const char* listStart, StatDataList* outStatDatas)
+{
+   const size_t headerLen = Serialization::serialLenUInt() + Serialization::serialLenUInt();
+   size_t bufLen = listBufLen - headerLen;
+   size_t bufPos = 0;
+
+   for(unsigned i=0; i < elemNum; i++)
+   {
+      StatData statData;
+      unsigned statDataLen;
+
+      if(unlikely(!statData.deserialize(false, true, true, &listStart[bufPos], bufLen-bufPos,
+         &statDataLen) ) )
+         return false;
+
+      bufPos += statDataLen;
+
+      outStatDatas->push_back(statData);
+   }
+
+   return true;
+}
+
+unsigned ListDirPlusRespMsg::serialLenStatDataList(StatDataList* statDatas)
+{
+   unsigned length = Serialization::serialLenUInt() + Serialization::serialLenUInt();
+
+   for(StatDataListIter iter = statDatas->begin(); iter != statDatas->end(); iter++)
+      length += iter->serialLen(false, true, true);
+
+   return length;
+}
+
+TestingEqualsRes ListDirPlusRespMsg::testingEquals(NetMessage* cloneMsg)
+{
+   ListDirPlusRespMsg* cloneRespMsg = (ListDirPlusRespMsg*) cloneMsg;
+
+   StringList cloneNames;
+   UInt8List cloneEntryTypes;
+   StringList cloneEntryIDs;
+   Int64List cloneServerOffsets;
+   UInt16List cloneOwnerNodeIDs;
+   IntList cloneEntryFlags;
+   IntList cloneStatResults;
+   StatDataList cloneStatDatas;
+
+   if(this->result != cloneRespMsg->getResult() )
+      return TestingEqualsRes_FALSE;
+
+   if(this->newServerOffset != cloneRespMsg->getNewServerOffset() )
+      return TestingEqualsRes_FALSE;
+
+   if(!cloneRespMsg->parseNames(&cloneNames) ||
+      !cloneRespMsg->parseEntryTypes(&cloneEntryTypes) ||
+      !cloneRespMsg->parseEntryIDs(&cloneEntryIDs) ||
+      !cloneRespMsg->parseServerOffsets(&cloneServerOffsets) ||
+      !cloneRespMsg->parseOwnerNodeIDs(&cloneOwnerNodeIDs) ||
+      !cloneRespMsg->parseEntryFlags(&cloneEntryFlags) ||
+      !cloneRespMsg->parseStatResults(&cloneStatResults) ||
+      !cloneRespMsg->parseStatDatas(&cloneStatDatas) )
+      return TestingEqualsRes_FALSE;
+
+   if( (*this->names != cloneNames) ||
+       (*this->entryTypes != cloneEntryTypes) ||
+       (*this->entryIDs != cloneEntryIDs) ||
+       (*this->serverOffsets != cloneServerOffsets) ||
+       (*this->ownerNodeIDs != cloneOwnerNodeIDs) ||
+       (*this->entryFlags != cloneEntryFlags) ||
+       (*this->statResults != cloneStatResults) ||
+       (this->statDatas->size() != cloneStatDatas.size() ) )
+      return TestingEqualsRes_FALSE;
+
+   StatDataListIter cloneIter = cloneStatDatas.begin();
+
+   for(StatDataListIter iter = this->statDatas->begin(); iter != this->statDatas->end();
+       iter++, cloneIter++)
+   {
+      // (only the fields that are sent over the network)
+      if( (iter->getFileSize() != cloneIter->getFileSize() ) ||
+          (iter->getMode() != cloneIter->getMode() ) ||
+          (iter->getUserID() != cloneIter->getUserID() ) ||
+          (iter->getGroupID() != cloneIter->getGroupID() ) ||
+          (iter->getNumHardlinks() != cloneIter->getNumHardlinks() ) ||
+          (iter->getModificationTimeSecs() != cloneIter->getModificationTimeSecs() ) ||
+          (iter->getLastAccessTimeSecs() != cloneIter->getLastAccessTimeSecs() ) ||
+          (iter->getAttribChangeTimeSecs() != cloneIter->getAttribChangeTimeSecs() ) )
+         return TestingEqualsRes_FALSE;
+   }
+
+   return TestingEqualsRes_TRUE;
+}
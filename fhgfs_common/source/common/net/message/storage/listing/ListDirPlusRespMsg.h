@@ -0,0 +1,186 @@
+#ifndef LISTDIRPLUSRESPMSG_H_
+#define LISTDIRPLUSRESPMSG_H_
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/StatData.h>
+#include <common/Common.h>
+
+
+/**
+ * Response to ListDirPlusMsg.
+ *
+ * Contains the same per-entry lists as ListDirFromOffsetRespMsg and additionally the owner node,
+ * the EntryInfo flags (e.g. ENTRYINFO_FEATURE_INLINED) and the stat result and stat data of each
+ * entry. The stat result is FhgfsOpsErr_NOTOWNER if the inode is owned by another metadata node;
+ * the stat data of an entry is only valid if its stat result is FhgfsOpsErr_SUCCESS.
+ */
+class ListDirPlusRespMsg : public NetMessage
+{
+   public:
+      /**
+       * @param all lists must have the same length and are just references, so do not free them
+       * as long as you use this object!
+       */
+      ListDirPlusRespMsg(FhgfsOpsErr result, StringList* names, UInt8List* entryTypes,
+         StringList* entryIDs, Int64List* serverOffsets, int64_t newServerOffset,
+         UInt16List* ownerNodeIDs, IntList* entryFlags, IntList* statResults,
+         StatDataList* statDatas) :
+         NetMessage(NETMSGTYPE_ListDirPlusResp)
+      {
+         this->result = result;
+         this->names = names;
+         this->entryIDs = entryIDs;
+         this->entryTypes = entryTypes;
+         this->serverOffsets = serverOffsets;
+         this->newServerOffset = newServerOffset;
+         this->ownerNodeIDs = ownerNodeIDs;
+         this->entryFlags = entryFlags;
+         this->statResults = statResults;
+         this->statDatas = statDatas;
+      }
+
+      ListDirPlusRespMsg() : NetMessage(NETMSGTYPE_ListDirPlusResp)
+      {
+      }
+
+      virtual TestingEqualsRes testingEquals(NetMessage* cloneMsg);
+
+   protected:
+
+      virtual void serializePayload(char* buf);
+      virtual bool deserializePayload(const char* buf, size_t bufLen);
+
+      virtual unsigned calcMessageLength()
+      {
+         return NETMSG_HEADER_LENGTH                                +
+            Serialization::serialLenInt()                           + // result
+            Serialization::serialLenUInt8List(this->entryTypes)     + // entryTypes
+            Serialization::serialLenStringList(this->entryIDs)      + // entryIDs
+            Serialization::serialLenStringList(this->names)         + // names
+            Serialization::serialLenInt64List(this->serverOffsets)  + // serverOffsets
+            Serialization::serialLenInt64()                         + // newServerOffset
+            Serialization::serialLenUInt16List(this->ownerNodeIDs)  + // ownerNodeIDs
+            Serialization::serialLenIntList(this->entryFlags)       + // entryFlags
+            Serialization::serialLenIntList(this->statResults)      + // statResults
+            serialLenStatDataList(this->statDatas);                   // statDatas
+      }
+
+   private:
+      int result;
+
+      int64_t newServerOffset;
+
+      // for serialization
+      StringList* names;    // not owned by this object!
+      UInt8List* entryTypes;  // not owned by this object!
+      StringList* entryIDs; // not owned by this object!
+      Int64List* serverOffsets; // not owned by this object!
+      UInt16List* ownerNodeIDs; // not owned by this object!
+      IntList* entryFlags; // not owned by this object!
+      IntList* statResults; // not owned by this object!
+      StatDataList* statDatas; // not owned by this object!
+
+      // for deserialization
+      unsigned namesElemNum;
+      const char* namesListStart;
+      unsigned namesBufLen;
+
+      unsigned entryTypesElemNum;
+      const char* entryTypesListStart;
+      unsigned entryTypesBufLen;
+
+      unsigned entryIDsElemNum;
+      const char* entryIDsListStart;
+      unsigned entryIDsBufLen;
+
+      unsigned serverOffsetsElemNum;
+      const char* serverOffsetsListStart;
+      unsigned serverOffsetsBufLen;
+
+      unsigned ownerNodeIDsElemNum;
+      const char* ownerNodeIDsListStart;
+      unsigned ownerNodeIDsBufLen;
+
+      unsigned entryFlagsElemNum;
+      const char* entryFlagsListStart;
+      unsigned entryFlagsBufLen;
+
+      unsigned statResultsElemNum;
+      const char* statResultsListStart;
+      unsigned statResultsBufLen;
+
+      unsigned statDatasElemNum;
+      const char* statDatasListStart;
+      unsigned statDatasBufLen;
+
+      static unsigned serializeStatDataList(char* buf, StatDataList* statDatas);
+      static bool deserializeStatDataListPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outListStart, unsigned* outLen);
+      static bool deserializeStatDataList(unsigned listBufLen, unsigned elemNum,
+         const char* listStart, StatDataList* outStatDatas);
+      static unsigned serialLenStatDataList(StatDataList* statDatas);
+
+   public:
+      // inliners
+      bool parseNames(StringList* outNames)
+      {
+         return Serialization::deserializeStringList(
+            this->namesBufLen, this->namesElemNum, this->namesListStart, outNames);
+      }
+
+      bool parseEntryTypes(UInt8List* outEntryTypes)
+      {
+         return Serialization::deserializeUInt8List(this->entryTypesBufLen, this->entryTypesElemNum,
+            this->entryTypesListStart, outEntryTypes);
+      }
+
+      bool parseEntryIDs(StringList* outEntryIDs)
+      {
+         return Serialization::deserializeStringList(this->entryIDsBufLen, this->entryIDsElemNum,
+            this->entryIDsListStart, outEntryIDs);
+      }
+
+      bool parseServerOffsets(Int64List* outServerOffsets)
+      {
+         return Serialization::deserializeInt64List(this->serverOffsetsBufLen,
+            this->serverOffsetsElemNum, this->serverOffsetsListStart, outServerOffsets);
+      }
+
+      bool parseOwnerNodeIDs(UInt16List* outOwnerNodeIDs)
+      {
+         return Serialization::deserializeUInt16List(this->ownerNodeIDsBufLen,
+            this->ownerNodeIDsElemNum, this->ownerNodeIDsListStart, outOwnerNodeIDs);
+      }
+
+      bool parseEntryFlags(IntList* outEntryFlags)
+      {
+         return Serialization::deserializeIntList(this->entryFlagsBufLen,
+            this->entryFlagsElemNum, this->entryFlagsListStart, outEntryFlags);
+      }
+
+      bool parseStatResults(IntList* outStatResults)
+      {
+         return Serialization::deserializeIntList(this->statResultsBufLen,
+            this->statResultsElemNum, this->statResultsListStart, outStatResults);
+      }
+
+      bool parseStatDatas(StatDataList* outStatDatas)
+      {
+         return deserializeStatDataList(this->statDatasBufLen, this->statDatasElemNum,
+            this->statDatasListStart, outStatDatas);
+      }
+
+      // getters & setters
+      FhgfsOpsErr getResult()
+      {
+         return (FhgfsOpsErr)this->result;
+      }
+
+      int64_t getNewServerOffset()
+      {
+         return this->newServerOffset;
+      }
+
+};
+
+#endif /*LISTDIRPLUSRESPMSG_H_*/
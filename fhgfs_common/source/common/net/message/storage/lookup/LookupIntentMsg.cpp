@@ -41,6 +41,8 @@ bool LookupIntentMsg::deserializePayload(const char* buf, size_t bufLen)
 
          if (!this->entryInfo.deserialize(&buf[bufPos], bufLen-bufPos, &entryBufLen) )
             return false;
+
+         bufPos += entryBufLen;
       }
    }
 
@@ -111,6 +113,18 @@ bool LookupIntentMsg::deserializePayload(const char* buf, size_t bufLen)
       }
    }
 
+   if(this->intentFlags & LOOKUPINTENTMSG_FLAG_LEASE)
+   {
+      { // clientID
+         unsigned clientBufLen;
+
+         if(!Serialization::deserializeStrAlign4(&buf[bufPos], bufLen-bufPos,
+            &clientIDLen, &clientID, &clientBufLen) )
+            return false;
+
+         bufPos += clientBufLen;
+      }
+   }
 
    return true;
 }
@@ -163,6 +177,12 @@ void LookupIntentMsg::serializePayload(char* buf)
       bufPos += Serialization::serializeUInt16List(&buf[bufPos], preferredTargets);
    }
 
+   if(this->intentFlags & LOOKUPINTENTMSG_FLAG_LEASE)
+   {
+      // clientID
+      bufPos += Serialization::serializeStrAlign4(&buf[bufPos], clientIDLen, clientID);
+   }
+
 }
 
 
@@ -13,6 +13,7 @@
 #define LOOKUPINTENTMSG_FLAG_CREATEEXCLUSIVE    4 /* exclusive file creation */
 #define LOOKUPINTENTMSG_FLAG_OPEN               8 /* open file */
 #define LOOKUPINTENTMSG_FLAG_STAT              16 /* stat file */
+#define LOOKUPINTENTMSG_FLAG_LEASE             32 /* request lease on dentry and attribs */
 
 
 // feature flags as header flags
@@ -94,6 +95,9 @@ class LookupIntentMsg : public NetMessage
                msgLength += Serialization::serialLenInt();              // umask
          }
 
+         if(this->intentFlags & LOOKUPINTENTMSG_FLAG_LEASE)
+            msgLength += Serialization::serialLenStrAlign4(clientIDLen); // clientID
+
          return msgLength;
       }
 
@@ -113,6 +117,9 @@ class LookupIntentMsg : public NetMessage
       const char* sessionID; // (file open data)
       unsigned accessFlags; // OPENFILE_ACCESS_... flags (file open data)
 
+      unsigned clientIDLen; // (lease data)
+      const char* clientID; // (lease data)
+
       // for serialization
       UInt16List* preferredTargets; // not owned by this object! (file creation data)
       EntryInfo* parentInfoPtr;
@@ -167,6 +174,18 @@ class LookupIntentMsg : public NetMessage
          this->intentFlags |= LOOKUPINTENTMSG_FLAG_STAT;
       }
 
+      /**
+       * @param clientID nodeID of the client, which will receive the lease revocation; just a
+       * reference, so do not free it as long as you use this object!
+       */
+      void addIntentLease(const char* clientID)
+      {
+         this->intentFlags |= LOOKUPINTENTMSG_FLAG_LEASE;
+
+         this->clientID = clientID;
+         this->clientIDLen = strlen(clientID);
+      }
+
       void parsePreferredTargets(UInt16List* outTargets)
       {
          Serialization::deserializeUInt16List(
@@ -226,6 +245,11 @@ class LookupIntentMsg : public NetMessage
          return accessFlags;
       }
 
+      const char* getClientID() const
+      {
+         return clientID;
+      }
+
       unsigned getSupportedHeaderFeatureFlagsMask() const
       {
          return LOOKUPINTENTMSG_FLAG_USE_QUOTA | LOOKUPINTENTMSG_FLAG_UMASK;
@@ -119,6 +119,17 @@ bool LookupIntentRespMsg::deserializePayload(const char* buf, size_t bufLen)
       bufPos += entryLen;
    }
 
+   if(this->responseFlags & LOOKUPINTENTRESPMSG_FLAG_LEASE)
+   {
+      // leaseMS
+      unsigned leaseMSFieldLen;
+      if(!Serialization::deserializeUInt(&buf[bufPos], bufLen-bufPos,
+         &leaseMS, &leaseMSFieldLen) )
+         return false;
+
+      bufPos += leaseMSFieldLen;
+   }
+
 
    return true;
 }
@@ -179,5 +190,11 @@ void LookupIntentRespMsg::serializePayload(char* buf)
       bufPos += this->entryInfoPtr->serialize(&buf[bufPos]);
    }
 
+   if(this->responseFlags & LOOKUPINTENTRESPMSG_FLAG_LEASE)
+   {
+      // leaseMS
+      bufPos += Serialization::serializeUInt(&buf[bufPos], leaseMS);
+   }
+
 }
 
@@ -17,6 +17,7 @@
 #define LOOKUPINTENTRESPMSG_FLAG_CREATE             2 /* create file response */
 #define LOOKUPINTENTRESPMSG_FLAG_OPEN               4 /* open file response */
 #define LOOKUPINTENTRESPMSG_FLAG_STAT               8 /* stat file response */
+#define LOOKUPINTENTRESPMSG_FLAG_LEASE             16 /* lease granted (only if entry was found) */
 
 
 class LookupIntentRespMsg : public NetMessage
@@ -102,6 +103,11 @@ class LookupIntentRespMsg : public NetMessage
             // this->createResult << std::endl;
          }
 
+         if(this->responseFlags & LOOKUPINTENTRESPMSG_FLAG_LEASE)
+         {
+            msgLength += Serialization::serialLenUInt(); // leaseMS
+         }
+
          return msgLength;
       }
 
@@ -121,6 +127,8 @@ class LookupIntentRespMsg : public NetMessage
       unsigned fileHandleIDLen;
       const char* fileHandleID;
 
+      unsigned leaseMS; // duration of the granted lease
+
       // for serialization
       EntryInfo* entryInfoPtr; // not owned by this object
       StripePattern* pattern;  // not owned by this object! (open file data)
@@ -178,6 +186,16 @@ class LookupIntentRespMsg : public NetMessage
          this->statData   = *statData;
       }
 
+      /**
+       * Note: Only valid if lookup was successful, as the lease is serialized after the entryInfo.
+       */
+      void addResponseLease(unsigned leaseMS)
+      {
+         this->responseFlags |= LOOKUPINTENTRESPMSG_FLAG_LEASE;
+
+         this->leaseMS = leaseMS;
+      }
+
       // getters & setters
 
       int getResponseFlags() const
@@ -0,0 +1,100 @@
+#include "GetChunkBlockChecksumsMsg.h"
+
+bool GetChunkBlockChecksumsMsg::deserializePayload(const char* buf, size_t bufLen)
+{
+   size_t bufPos = 0;
+
+   { // relativePathStr
+      unsigned relativePathStrBufLen;
+
+      if ( !Serialization::deserializeStrAlign4(&buf[bufPos], bufLen - bufPos, &relativePathStr,
+         &relativePathStrBufLen) )
+         return false;
+
+      bufPos += relativePathStrBufLen;
+   }
+
+   { // targetID
+      unsigned targetIDBufLen;
+
+      if ( !Serialization::deserializeUShort(&buf[bufPos], bufLen - bufPos, &targetID,
+         &targetIDBufLen) )
+         return false;
+
+      bufPos += targetIDBufLen;
+   }
+
+   { // offset
+      unsigned offsetLen;
+
+      if ( !Serialization::deserializeInt64(&buf[bufPos], bufLen - bufPos, &offset, &offsetLen) )
+         return false;
+
+      bufPos += offsetLen;
+   }
+
+   { // blockSize
+      unsigned blockSizeLen;
+
+      if ( !Serialization::deserializeUInt(&buf[bufPos], bufLen - bufPos, &blockSize,
+         &blockSizeLen) )
+         return false;
+
+      bufPos += blockSizeLen;
+   }
+
+   { // numBlocks
+      unsigned numBlocksLen;
+
+      if ( !Serialization::deserializeUInt(&buf[bufPos], bufLen - bufPos, &numBlocks,
+         &numBlocksLen) )
+         return false;
+
+      bufPos += numBlocksLen;
+   }
+
+   return true;
+}
+
+void GetChunkBlockChecksumsMsg::serializePayload(char* buf)
+{
+   size_t bufPos = 0;
+
+   // relativePathStr
+   bufPos += Serialization::serializeStrAlign4(&buf[bufPos], relativePathStr.length(),
+      relativePathStr.c_str() );
+
+   // targetID
+   bufPos += Serialization::serializeUInt16(&buf[bufPos], targetID);
+
+   // offset
+   bufPos += Serialization::serializeInt64(&buf[bufPos], offset);
+
+   // blockSize
+   bufPos += Serialization::serializeUInt(&buf[bufPos], blockSize);
+
+   // numBlocks
+   bufPos += Serialization::serializeUInt(&buf[bufPos], numBlocks);
+}
+
+TestingEqualsRes GetChunkBlockChecksumsMsg::testingEquals(NetMessage* cloneMsg)
+{
+   GetChunkBlockChecksumsMsg* cloneChecksumsMsg = (GetChunkBlockChecksumsMsg*) cloneMsg;
+
+   if(this->relativePathStr != cloneChecksumsMsg->getRelativePathStr() )
+      return TestingEqualsRes_FALSE;
+
+   if(this->targetID != cloneChecksumsMsg->getTargetID() )
+      return TestingEqualsRes_FALSE;
+
+   if(this->offset != cloneChecksumsMsg->getOffset() )
+      return TestingEqualsRes_FALSE;
+
+   if(this->blockSize != cloneChecksumsMsg->getBlockSize() )
+      return TestingEqualsRes_FALSE;
+
+   if(this->numBlocks != cloneChecksumsMsg->getNumBlocks() )
+      return TestingEqualsRes_FALSE;
+
+   return TestingEqualsRes_TRUE;
+}
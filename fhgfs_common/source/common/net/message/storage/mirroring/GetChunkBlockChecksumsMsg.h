@@ -0,0 +1,96 @@
+#ifndef GETCHUNKBLOCKCHECKSUMSMSG_H_
+#define GETCHUNKBLOCKCHECKSUMSMSG_H_
+
+#include <common/net/message/NetMessage.h>
+
+
+#define GETCHUNKBLOCKCHECKSUMSMSG_MAX_BLOCKS     256         /* max number of blocks per msg */
+#define GETCHUNKBLOCKCHECKSUMSMSG_MAX_BLOCKSIZE  (1024*1024) /* max size of a single block */
+
+#define RESYNCER_DELTA_BLOCK_SIZE  (64*1024) // 64K, checksum block size of delta resync
+
+
+/**
+ * Request weak and strong checksums of consecutive blocks of a chunk file on a buddy mirror
+ * target. Used by the buddy resyncer to transfer only blocks that differ on the secondary
+ * (delta resync).
+ */
+class GetChunkBlockChecksumsMsg : public NetMessage
+{
+   public:
+      /*
+       * @param relativePathStr path to chunk, relative to buddy mirror directory
+       * @param targetID the buddy mirror target which stores the chunk
+       * @param offset file offset of the first block
+       * @param blockSize size of each block
+       * @param numBlocks number of blocks (at most GETCHUNKBLOCKCHECKSUMSMSG_MAX_BLOCKS)
+       */
+      GetChunkBlockChecksumsMsg(std::string& relativePathStr, uint16_t targetID, int64_t offset,
+         unsigned blockSize, unsigned numBlocks) :
+         NetMessage(NETMSGTYPE_GetChunkBlockChecksums)
+      {
+         this->relativePathStr = relativePathStr;
+         this->targetID = targetID;
+         this->offset = offset;
+         this->blockSize = blockSize;
+         this->numBlocks = numBlocks;
+      }
+
+      /**
+       * For deserialization only!
+       */
+      GetChunkBlockChecksumsMsg() : NetMessage(NETMSGTYPE_GetChunkBlockChecksums) {}
+
+      virtual TestingEqualsRes testingEquals(NetMessage* cloneMsg);
+
+   protected:
+      virtual void serializePayload(char* buf);
+      virtual bool deserializePayload(const char* buf, size_t bufLen);
+
+      unsigned calcMessageLength()
+      {
+         return NETMSG_HEADER_LENGTH                                       +
+            Serialization::serialLenStrAlign4(relativePathStr.length() ) + // relativePathStr
+            Serialization::serialLenUInt16()                             + // targetID
+            Serialization::serialLenInt64()                              + // offset
+            Serialization::serialLenUInt()                               + // blockSize
+            Serialization::serialLenUInt();                                // numBlocks
+      }
+
+   private:
+      std::string relativePathStr;
+      uint16_t targetID;
+      int64_t offset;
+      unsigned blockSize;
+      unsigned numBlocks;
+
+   public:
+      // getters & setters
+
+      std::string getRelativePathStr() const
+      {
+         return relativePathStr;
+      }
+
+      uint16_t getTargetID() const
+      {
+         return targetID;
+      }
+
+      int64_t getOffset() const
+      {
+         return offset;
+      }
+
+      unsigned getBlockSize() const
+      {
+         return blockSize;
+      }
+
+      unsigned getNumBlocks() const
+      {
+         return numBlocks;
+      }
+};
+
+#endif /*GETCHUNKBLOCKCHECKSUMSMSG_H_*/
@@ -0,0 +1,91 @@
+#include "GetChunkBlockChecksumsRespMsg.h"
+
+void GetChunkBlockChecksumsRespMsg::serializePayload(char* buf)
+{
+   size_t bufPos = 0;
+
+   // result
+   bufPos += Serialization::serializeInt(&buf[bufPos], result);
+
+   // fileSize
+   bufPos += Serialization::serializeInt64(&buf[bufPos], fileSize);
+
+   // weakChecksums
+   bufPos += Serialization::serializeUIntVector(&buf[bufPos], weakChecksums);
+
+   // strongChecksums
+   bufPos += Serialization::serializeUInt64Vector(&buf[bufPos], strongChecksums);
+}
+
+bool GetChunkBlockChecksumsRespMsg::deserializePayload(const char* buf, size_t bufLen)
+{
+   size_t bufPos = 0;
+
+   { // result
+      unsigned resultBufLen;
+
+      if(!Serialization::deserializeInt(&buf[bufPos], bufLen-bufPos, &result, &resultBufLen) )
+         return false;
+
+      bufPos += resultBufLen;
+   }
+
+   { // fileSize
+      unsigned fileSizeBufLen;
+
+      if(!Serialization::deserializeInt64(&buf[bufPos], bufLen-bufPos, &fileSize,
+         &fileSizeBufLen) )
+         return false;
+
+      bufPos += fileSizeBufLen;
+   }
+
+   { // weakChecksums
+      if(!Serialization::deserializeUIntVectorPreprocess(&buf[bufPos], bufLen-bufPos,
+         &weakChecksumsElemNum, &weakChecksumsVecStart, &weakChecksumsBufLen) )
+         return false;
+
+      bufPos += weakChecksumsBufLen;
+   }
+
+   { // strongChecksums
+      if(!Serialization::deserializeUInt64VectorPreprocess(&buf[bufPos], bufLen-bufPos,
+         &strongChecksumsElemNum, &strongChecksumsVecStart, &strongChecksumsBufLen) )
+         return false;
+
+      bufPos += strongChecksumsBufLen;
+   }
+
+   if(weakChecksumsElemNum != strongChecksumsElemNum)
+      return false;
+
+   return true;
+}
+
+TestingEqualsRes GetChunkBlockChecksumsRespMsg::testingEquals(NetMessage* cloneMsg)
+{
+   GetChunkBlockChecksumsRespMsg* cloneRespMsg = (GetChunkBlockChecksumsRespMsg*) cloneMsg;
+
+   if(this->result != cloneRespMsg->getResult() )
+      return TestingEqualsRes_FALSE;
+
+   if(this->fileSize != cloneRespMsg->getFileSize() )
+      return TestingEqualsRes_FALSE;
+
+   UIntVector cloneWeakChecksums;
+   UInt64Vector cloneStrongChecksums;
+
+   if(!cloneRespMsg->parseWeakChecksums(&cloneWeakChecksums) )
+      return TestingEqualsRes_FALSE;
+
+   if(!cloneRespMsg->parseStrongChecksums(&cloneStrongChecksums) )
+      return TestingEqualsRes_FALSE;
+
+   if(*this->weakChecksums != cloneWeakChecksums)
+      return TestingEqualsRes_FALSE;
+
+   if(*this->strongChecksums != cloneStrongChecksums)
+      return TestingEqualsRes_FALSE;
+
+   return TestingEqualsRes_TRUE;
+}
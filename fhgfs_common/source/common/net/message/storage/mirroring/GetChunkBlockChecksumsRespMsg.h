@@ -0,0 +1,104 @@
+#ifndef GETCHUNKBLOCKCHECKSUMSRESPMSG_H_
+#define GETCHUNKBLOCKCHECKSUMSRESPMSG_H_
+
+#include <common/net/message/NetMessage.h>
+#include <common/storage/StorageErrors.h>
+
+
+/**
+ * Response to GetChunkBlockChecksumsMsg with one weak (BufferTk::hash32) and one strong
+ * (BufferTk::hash64) checksum per block.
+ *
+ * The vectors contain only the blocks that exist in the chunk file, so they might be shorter than
+ * requested if the file ends within the requested range (the last block might also be shorter
+ * than the block size, in which case its checksums are calculated over the existing bytes only).
+ */
+class GetChunkBlockChecksumsRespMsg : public NetMessage
+{
+   public:
+      /**
+       * @param fileSize current size of the chunk file
+       * @param weakChecksums just a reference, so do not free it as long as you use this object!
+       * @param strongChecksums just a reference, so do not free it as long as you use this object!
+       */
+      GetChunkBlockChecksumsRespMsg(FhgfsOpsErr result, int64_t fileSize,
+         UIntVector* weakChecksums, UInt64Vector* strongChecksums) :
+         NetMessage(NETMSGTYPE_GetChunkBlockChecksumsResp)
+      {
+         this->result = result;
+         this->fileSize = fileSize;
+         this->weakChecksums = weakChecksums;
+         this->strongChecksums = strongChecksums;
+      }
+
+      /**
+       * For deserialization only!
+       */
+      GetChunkBlockChecksumsRespMsg() : NetMessage(NETMSGTYPE_GetChunkBlockChecksumsResp)
+      {
+      }
+
+      virtual TestingEqualsRes testingEquals(NetMessage* cloneMsg);
+
+
+   protected:
+      virtual void serializePayload(char* buf);
+      virtual bool deserializePayload(const char* buf, size_t bufLen);
+
+      virtual unsigned calcMessageLength()
+      {
+         return NETMSG_HEADER_LENGTH +
+            Serialization::serialLenInt() + // result
+            Serialization::serialLenInt64() + // fileSize
+            Serialization::serialLenUIntVector(weakChecksums) +
+            Serialization::serialLenUInt64Vector(strongChecksums);
+      }
+
+
+   private:
+      int result;
+      int64_t fileSize;
+
+      // for serialization
+      UIntVector* weakChecksums; // not owned by this object!
+      UInt64Vector* strongChecksums; // not owned by this object!
+
+      // for deserialization
+      unsigned weakChecksumsElemNum;
+      const char* weakChecksumsVecStart;
+      unsigned weakChecksumsBufLen;
+
+      unsigned strongChecksumsElemNum;
+      const char* strongChecksumsVecStart;
+      unsigned strongChecksumsBufLen;
+
+
+   public:
+      // inliners
+
+      bool parseWeakChecksums(UIntVector* outWeakChecksums)
+      {
+         return Serialization::deserializeUIntVector(weakChecksumsBufLen, weakChecksumsElemNum,
+            weakChecksumsVecStart, outWeakChecksums);
+      }
+
+      bool parseStrongChecksums(UInt64Vector* outStrongChecksums)
+      {
+         return Serialization::deserializeUInt64Vector(strongChecksumsBufLen,
+            strongChecksumsElemNum, strongChecksumsVecStart, outStrongChecksums);
+      }
+
+      // getters & setters
+
+      FhgfsOpsErr getResult() const
+      {
+         return (FhgfsOpsErr)result;
+      }
+
+      int64_t getFileSize() const
+      {
+         return fileSize;
+      }
+};
+
+#endif /*GETCHUNKBLOCKCHECKSUMSRESPMSG_H_*/
@@ -74,7 +74,13 @@ bool ResyncLocalFileMsg::deserializePayload(const char* buf, size_t bufLen)
       }
    }
 
+   if ( this->isMsgHeaderFeatureFlagSet(RESYNCLOCALFILEMSG_FLAG_STREAM) )
+      dataBuf = NULL; // data follows the msg and must be received from the socket
+   else
    { // dataBuf
+      if ( (count < 0) || ( (size_t)count > (bufLen - bufPos) ) )
+         return false;
+
       dataBuf = &buf[bufPos];
       bufPos += count;
    }
@@ -112,7 +118,7 @@ void ResyncLocalFileMsg::serializePayload(char* buf)
    }
 
    // dataBuf
-   if (dataBuf)
+   if (dataBuf && !this->isMsgHeaderFeatureFlagSet(RESYNCLOCALFILEMSG_FLAG_STREAM) )
    {
       memcpy(&buf[bufPos], dataBuf, count);
       bufPos += count;
@@ -11,6 +11,10 @@
 #define RESYNCLOCALFILEMSG_FLAG_TRUNC      4 /* truncate after write; cannot be used together with
                                                 RESYNCLOCALFILEMSG_FLAG_NODATA */
 #define RESYNCLOCALFILEMSG_CHECK_SPARSE    8 /* check if incoming data has sparse areas */
+#define RESYNCLOCALFILEMSG_FLAG_DELTA     16 /* data is a changed range of an existing chunk (delta
+                                                resync), i.e. don't truncate at offset 0 */
+#define RESYNCLOCALFILEMSG_FLAG_STREAM    32 /* data is not part of the msg; count bytes of raw data
+                                                follow the msg on the stream (dataBuf is ignored) */
 
 #define RESYNCER_SPARSE_BLOCK_SIZE 4096 //4K
 
@@ -19,6 +23,7 @@ class ResyncLocalFileMsg : public NetMessage
    public:
       /*
        * @param dataBuf the actual data to be written;may be NULL if RESYNCLOCALFILEMSG_FLAG_NODATA
+       *    or RESYNCLOCALFILEMSG_FLAG_STREAM
        * @param relativePathStr path to chunk, relative to buddy mirror directory
        * @param resyncToTargetID
        * @param offset
@@ -66,7 +71,8 @@ class ResyncLocalFileMsg : public NetMessage
                Serialization::serialLenUInt();                            // groupID
          }
 
-         retVal += count;                                                 // dataBuf
+         if ( !this->isMsgHeaderFeatureFlagSet(RESYNCLOCALFILEMSG_FLAG_STREAM) )
+            retVal += count;                                              // dataBuf
 
          return retVal;
       }
@@ -74,7 +80,8 @@ class ResyncLocalFileMsg : public NetMessage
       unsigned getSupportedHeaderFeatureFlagsMask() const
       {
          return RESYNCLOCALFILEMSG_FLAG_SETATTRIBS | RESYNCLOCALFILEMSG_FLAG_NODATA |
-            RESYNCLOCALFILEMSG_FLAG_TRUNC | RESYNCLOCALFILEMSG_CHECK_SPARSE;
+            RESYNCLOCALFILEMSG_FLAG_TRUNC | RESYNCLOCALFILEMSG_CHECK_SPARSE |
+            RESYNCLOCALFILEMSG_FLAG_DELTA | RESYNCLOCALFILEMSG_FLAG_STREAM;
       }
 
    private:
@@ -0,0 +1,184 @@
+#include <common/net/message/NetMessage.h>
+#include "MuxReplySocket.h"
+
+
+/**
+ * @param origSock the socket over which the request was received; peer name and channel flags
+ *    are copied, the socket itself is not accessed afterwards.
+ * @param channel a reference will be taken.
+ * @param muxID muxID of the request, which will be set in the headers of all responses.
+ */
+MuxReplySocket::MuxReplySocket(Socket* origSock, MuxSendChannel* channel, unsigned muxID)
+{
+   this->sockType = origSock->getSockType();
+   this->peerIP.s_addr = origSock->getPeerIP();
+   this->peername = origSock->getPeername();
+
+   setIsDirect(origSock->getIsDirect() );
+
+   if(origSock->getIsAuthenticated() )
+      setIsAuthenticated();
+
+   channel->reference();
+
+   this->channel = channel;
+   this->muxID = muxID;
+   this->msgBytesLeft = 0;
+}
+
+MuxReplySocket::~MuxReplySocket()
+{
+   if(unlikely(msgBytesLeft) )
+      abortResponse(); // processing was aborted in the middle of a response
+
+   channel->release();
+}
+
+/**
+ * Shut down the conn and give up the send lock after an incomplete response, because the byte
+ * stream is corrupt for the peer.
+ */
+void MuxReplySocket::abortResponse()
+{
+   channel->shutdown();
+
+   msgBytesLeft = 0;
+   channel->unlockSend();
+}
+
+/**
+ * @throw SocketException
+ */
+ssize_t MuxReplySocket::send(const void *buf, size_t len, int flags)
+{
+   const char* bufChar = (const char*)buf;
+   char header[NETMSG_HEADER_LENGTH];
+   size_t headerLen = 0;
+
+   if(!msgBytesLeft)
+   { // start of a new response => tag with our muxID
+      if(unlikely(len < NETMSG_HEADER_LENGTH) )
+         throw SocketException("Incomplete msg header for multiplexed conn: " + peername);
+
+      memcpy(header, buf, NETMSG_HEADER_LENGTH);
+
+      unsigned msgLength = NetMessage::extractMsgLengthFromBuf(header);
+      if(unlikely( (msgLength < NETMSG_HEADER_LENGTH) || (msgLength < len) ) )
+         throw SocketException("Unexpected data beyond msg length on multiplexed conn: " +
+            peername);
+
+      NetMessage::injectMsgMuxIDIntoBuf(header, muxID);
+
+      headerLen = NETMSG_HEADER_LENGTH;
+
+      channel->lockSend(); // L O C K (until last byte of this response)
+
+      msgBytesLeft = msgLength;
+   }
+   else
+   if(unlikely(len > msgBytesLeft) )
+   {
+      abortResponse(); // U N L O C K
+
+      throw SocketException("Unexpected data beyond msg length on multiplexed conn: " +
+         peername);
+   }
+
+   try
+   {
+      channel->sendLocked(header, headerLen, &bufChar[headerLen], len - headerLen);
+   }
+   catch(SocketException& e)
+   {
+      abortResponse(); // U N L O C K
+      throw;
+   }
+
+   stats->incVals.netSendBytes += len;
+
+   msgBytesLeft -= len;
+
+   if(!msgBytesLeft)
+      channel->unlockSend(); // U N L O C K
+
+   return len;
+}
+
+void MuxReplySocket::shutdown()
+{
+   channel->shutdown();
+}
+
+void MuxReplySocket::shutdownAndRecvDisconnect(int timeoutMS)
+{
+   channel->shutdown();
+}
+
+/**
+ * Not supported: The stream listener might already be receiving the next request of the peer.
+ *
+ * @throw SocketException always
+ */
+ssize_t MuxReplySocket::recv(void *buf, size_t len, int flags)
+{
+   throw SocketException("Receiving is not supported for multiplexed requests: " + peername);
+}
+
+/**
+ * Not supported (see recv() ).
+ *
+ * @throw SocketException always
+ */
+ssize_t MuxReplySocket::recvT(void *buf, size_t len, int flags, int timeoutMS)
+{
+   throw SocketException("Receiving is not supported for multiplexed requests: " + peername);
+}
+
+/**
+ * @throw SocketException always
+ */
+void MuxReplySocket::connect(const char* hostname, unsigned short port)
+{
+   throw SocketException("Not supported for multiplexed conns: connect");
+}
+
+/**
+ * @throw SocketException always
+ */
+void MuxReplySocket::connect(const struct sockaddr* serv_addr, socklen_t addrlen)
+{
+   throw SocketException("Not supported for multiplexed conns: connect");
+}
+
+/**
+ * @throw SocketException always
+ */
+void MuxReplySocket::bindToAddr(in_addr_t ipAddr, unsigned short port)
+{
+   throw SocketException("Not supported for multiplexed conns: bind");
+}
+
+/**
+ * @throw SocketException always
+ */
+void MuxReplySocket::listen()
+{
+   throw SocketException("Not supported for multiplexed conns: listen");
+}
+
+/**
+ * @throw SocketException always
+ */
+Socket* MuxReplySocket::accept(struct sockaddr* addr, socklen_t* addrlen)
+{
+   throw SocketException("Not supported for multiplexed conns: accept");
+}
+
+/**
+ * @throw SocketException always
+ */
+ssize_t MuxReplySocket::sendto(const void *buf, size_t len, int flags,
+   const struct sockaddr *to, socklen_t tolen)
+{
+   throw SocketException("Not supported for multiplexed conns: sendto");
+}
@@ -0,0 +1,63 @@
+#ifndef MUXREPLYSOCKET_H_
+#define MUXREPLYSOCKET_H_
+
+#include <common/Common.h>
+#include "MuxSendChannel.h"
+#include "Socket.h"
+
+
+/**
+ * The socket that a worker passes to msg->processIncoming() for a request that was received over
+ * a multiplexed conn.
+ *
+ * The original socket was already handed back to the stream listener at this point to receive
+ * further requests of the peer, so this socket can only send. Each response gets tagged with the
+ * muxID of the request and the send lock of the channel is held from the first to the last byte
+ * of a response, so that responses of parallel workers don't get interleaved.
+ *
+ * Note: Each send() must either start a new response with at least the complete msg header or
+ * continue the current response; raw data beyond the msg length (like the data phase of file
+ * reads) is not supported over multiplexed conns.
+ *
+ * Note: Requests from kernel clients never have a muxID (see MuxChannel), so this is only used
+ * for requests of other servers and userspace tools.
+ */
+class MuxReplySocket : public Socket
+{
+   public:
+      MuxReplySocket(Socket* origSock, MuxSendChannel* channel, unsigned muxID);
+      virtual ~MuxReplySocket();
+
+      virtual void connect(const char* hostname, unsigned short port);
+      virtual void connect(const struct sockaddr* serv_addr, socklen_t addrlen);
+      virtual void bindToAddr(in_addr_t ipAddr, unsigned short port);
+      virtual void listen();
+      virtual Socket* accept(struct sockaddr* addr, socklen_t* addrlen);
+      virtual void shutdown();
+      virtual void shutdownAndRecvDisconnect(int timeoutMS);
+
+      virtual ssize_t send(const void *buf, size_t len, int flags);
+      virtual ssize_t sendto(const void *buf, size_t len, int flags,
+         const struct sockaddr *to, socklen_t tolen);
+
+      virtual ssize_t recv(void *buf, size_t len, int flags);
+      virtual ssize_t recvT(void *buf, size_t len, int flags, int timeoutMS);
+
+
+   private:
+      MuxSendChannel* channel; // we hold a reference
+      unsigned muxID;
+      size_t msgBytesLeft; // remaining bytes of the current response (send lock held while >0)
+
+      void abortResponse();
+
+
+   public:
+      // getters & setters
+      virtual int getFD() const
+      {
+         return channel->getFD();
+      }
+};
+
+#endif /*MUXREPLYSOCKET_H_*/
@@ -0,0 +1,141 @@
+#ifndef MUXSENDCHANNEL_H_
+#define MUXSENDCHANNEL_H_
+
+#include <common/system/System.h>
+#include <common/threading/Atomics.h>
+#include <common/threading/Mutex.h>
+#include <common/toolkit/StringTk.h>
+#include <common/Common.h>
+#include "SocketDisconnectException.h"
+#include "SocketException.h"
+
+#include <sys/uio.h>
+
+
+/**
+ * Send side of a multiplexed stream conn on the server side.
+ *
+ * Requests that a peer sends over a multiplexed conn (see MuxChannel) are processed in parallel
+ * by different workers, so the responses are sent through this channel to avoid interleaving of
+ * their bytes on the wire.
+ *
+ * The channel uses a duplicate of the conn's file descriptor, which stays valid if the original
+ * socket gets closed and deleted (e.g. because the peer disconnected) while a worker still has a
+ * response to send.
+ *
+ * Reference counted: The StandardSocket of the conn holds a reference and each MuxReplySocket
+ * holds one. The channel deletes itself when the last reference is released.
+ */
+class MuxSendChannel
+{
+   public:
+      /**
+       * @param sockFD will be duplicated, the caller keeps ownership of the original fd.
+       * @throw SocketException if the fd cannot be duplicated.
+       */
+      MuxSendChannel(int sockFD, std::string peername) : refCount(1), peername(peername)
+      {
+         this->fd = dup(sockFD);
+         if(fd == -1)
+            throw SocketException("Unable to duplicate fd for multiplexed conn: " + peername +
+               "; SysErr: " + System::getErrString() );
+      }
+
+
+   private:
+      /**
+       * Note: Use release() instead of delete.
+       */
+      ~MuxSendChannel()
+      {
+         close(fd);
+      }
+
+      int fd;
+      AtomicUInt32 refCount;
+      std::string peername;
+
+      Mutex sendMutex; // serializes responses
+
+
+   public:
+      // inliners
+
+      void reference()
+      {
+         refCount.increase();
+      }
+
+      /**
+       * Drop a reference and delete the channel if it was the last one.
+       */
+      void release()
+      {
+         if(refCount.decrease() == 1)
+            delete(this);
+      }
+
+      void lockSend()
+      {
+         sendMutex.lock();
+      }
+
+      void unlockSend()
+      {
+         sendMutex.unlock();
+      }
+
+      /**
+       * Send a header and the rest of a msg with a single syscall.
+       *
+       * Note: Caller must hold the send lock.
+       *
+       * @param header may be NULL if headerLen is 0.
+       * @throw SocketDisconnectException
+       */
+      void sendLocked(const void* header, size_t headerLen, const void* buf, size_t len)
+      {
+         struct iovec iov[2];
+         struct msghdr msg;
+
+         iov[0].iov_base = (void*)header;
+         iov[0].iov_len = headerLen;
+         iov[1].iov_base = (void*)buf;
+         iov[1].iov_len = len;
+
+         memset(&msg, 0, sizeof(msg) );
+         msg.msg_iov = headerLen ? iov : &iov[1];
+         msg.msg_iovlen = headerLen ? 2 : 1;
+
+         ssize_t sendRes = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+         if(sendRes == (ssize_t)(headerLen + len) )
+            return;
+
+         if(sendRes != -1)
+            throw SocketDisconnectException("send(): Sent only " + StringTk::int64ToStr(sendRes) +
+               " bytes of the requested " + StringTk::int64ToStr(headerLen + len) + " bytes of "
+               "data to: " + peername);
+
+         throw SocketDisconnectException("Disconnect during send() to: " + peername + "; "
+            "SysErr: " + System::getErrString() );
+      }
+
+      /**
+       * Shut down both directions of the conn, e.g. if a response could only be sent partially
+       * and the byte stream is thus corrupt.
+       *
+       * Note: Affects the original socket as well, so that the peer and the stream listener
+       * notice the disconnect.
+       */
+      void shutdown()
+      {
+         ::shutdown(fd, SHUT_RDWR);
+      }
+
+      int getFD() const
+      {
+         return fd;
+      }
+};
+
+#endif /*MUXSENDCHANNEL_H_*/
@@ -317,3 +317,53 @@ bool RDMASocket::checkDelayedEvents()
 {
    return IBVSocket_checkDelayedEvents(ibvsock);
 }
+
+/**
+ * Register a buffer for one-sided RDMA transfers over this conn (see rdmaWrite()/rdmaRead() ).
+ *
+ * @return must be deregistered via deregisterBuf() before this socket is deleted.
+ * @throw SocketException
+ */
+IBVBufRegion* RDMASocket::registerBuf(void* buf, size_t bufLen)
+{
+   IBVBufRegion* region = IBVSocket_registerBuf(ibvsock, buf, bufLen);
+   if(!region)
+      throw SocketException("RDMA buffer registration failed. Peer: " + peername);
+
+   return region;
+}
+
+void RDMASocket::deregisterBuf(IBVBufRegion* region)
+{
+   IBVSocket_deregisterBuf(region);
+}
+
+/**
+ * Write local data directly into remote memory that was registered by the peer.
+ *
+ * @param localBuf must be inside localRegion.
+ * @throw SocketException
+ */
+void RDMASocket::rdmaWrite(IBVBufRegion* localRegion, const char* localBuf, size_t bufLen,
+   uint64_t remoteVAddr, unsigned remoteRKey)
+{
+   if(!IBVSocket_rdmaWrite(ibvsock, localRegion, localBuf, bufLen, remoteVAddr, remoteRKey) )
+      throw SocketException("RDMA write failed. Peer: " + peername);
+
+   stats->incVals.netSendBytes += bufLen;
+}
+
+/**
+ * Read remote memory that was registered by the peer directly into a local buffer.
+ *
+ * @param localBuf must be inside localRegion.
+ * @throw SocketException
+ */
+void RDMASocket::rdmaRead(IBVBufRegion* localRegion, char* localBuf, size_t bufLen,
+   uint64_t remoteVAddr, unsigned remoteRKey)
+{
+   if(!IBVSocket_rdmaRead(ibvsock, localRegion, localBuf, bufLen, remoteVAddr, remoteRKey) )
+      throw SocketException("RDMA read failed. Peer: " + peername);
+
+   stats->incVals.netRecvBytes += bufLen;
+}
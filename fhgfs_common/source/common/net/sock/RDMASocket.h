@@ -33,6 +33,13 @@ class RDMASocket : public PooledSocket
       void checkConnection();
       ssize_t nonblockingRecvCheck();
       bool checkDelayedEvents();
+
+      IBVBufRegion* registerBuf(void* buf, size_t bufLen);
+      void deregisterBuf(IBVBufRegion* region);
+      void rdmaWrite(IBVBufRegion* localRegion, const char* localBuf, size_t bufLen,
+         uint64_t remoteVAddr, unsigned remoteRKey);
+      void rdmaRead(IBVBufRegion* localRegion, char* localBuf, size_t bufLen,
+         uint64_t remoteVAddr, unsigned remoteRKey);
       
       
    protected:
@@ -71,6 +78,29 @@ class RDMASocket : public PooledSocket
          IBVSocket_setTypeOfService(ibvsock, typeOfService);
       }
 
+      /**
+       * Let accepted conns receive into bufs that are shared by all conns of this listen socket
+       * (per device) instead of having their own recv bufs.
+       *
+       * Note: Only has an effect for listen sockets before listen() is called.
+       *
+       * @param bufNum 0 to disable.
+       */
+      void setSharedRecvBuffers(unsigned bufNum, unsigned bufSize)
+      {
+         IBVSocket_setSharedRecvConfig(ibvsock, bufNum, bufSize);
+      }
+
+      bool getUsesSharedRecvBuffers()
+      {
+         return IBVSocket_getUsesSharedRecv(ibvsock);
+      }
+
+      unsigned getBufRegionRKey(IBVBufRegion* region)
+      {
+         return IBVBufRegion_getRKey(region);
+      }
+
 };
 
 
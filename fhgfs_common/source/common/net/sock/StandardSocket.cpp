@@ -6,6 +6,7 @@
 #include "StandardSocket.h"
 
 #include <sys/epoll.h>
+#include <sys/sendfile.h>
 
 
 #define STANDARDSOCKET_CONNECT_TIMEOUT_MS    5000
@@ -17,6 +18,7 @@
 StandardSocket::StandardSocket(int domain, int type, int protocol)
 {
    this->sockDomain = domain;
+   this->muxSendChannel = NULL;
 
    if(domain == PF_SDP)
       this->sockType = NICADDRTYPE_SDP;
@@ -66,6 +68,7 @@ StandardSocket::StandardSocket(int fd, unsigned short sockDomain, struct in_addr
 {
    this->sock = fd;
    this->sockDomain = sockDomain;
+   this->muxSendChannel = NULL;
    this->peerIP = peerIP;
    this->peername = peername;
 
@@ -96,6 +99,9 @@ StandardSocket::StandardSocket(int fd, unsigned short sockDomain, struct in_addr
 
 StandardSocket::~StandardSocket()
 {
+   if(muxSendChannel)
+      muxSendChannel->release(); // (channel has its own fd, so workers can still send responses)
+
    if(this->epollFD != -1)
       close(this->epollFD);
 
@@ -374,6 +380,47 @@ ssize_t StandardSocket::send(const void *buf, size_t len, int flags)
       "SysErr: " + System::getErrString() );
 }
 
+/**
+ * Zero-copy transfer of file data to this socket via sendfile(), i.e. without copying the data
+ * through a user-space buffer.
+ *
+ * Note: Returns less than len only if the end of the file was reached before len bytes were sent.
+ * The caller has to take into account that the peer might already have received the data that was
+ * sent before the end of file was detected.
+ *
+ * @param inFD file descriptor of the file to be sent (typically a regular file)
+ * @param offset file offset where to start reading; the file offset of inFD is not modified
+ * @return number of bytes sent
+ * @throw SocketException
+ */
+ssize_t StandardSocket::sendfile(int inFD, off_t offset, size_t len)
+{
+   size_t numSent = 0;
+
+   while(numSent < len)
+   {
+      ssize_t sendRes = ::sendfile(sock, inFD, &offset, len - numSent);
+      if(sendRes > 0)
+      {
+         numSent += sendRes;
+         stats->incVals.netSendBytes += sendRes;
+         continue;
+      }
+      else
+      if(!sendRes)
+         break; // end of file
+
+      if(errno == EINTR)
+         continue;
+
+      throw SocketDisconnectException(
+         "Disconnect during sendfile() to: " + peername + "; "
+         "SysErr: " + System::getErrString() );
+   }
+
+   return numSent;
+}
+
 // asynchronous version (with synchronous behavior)
 //StandardSocket::ssize_t send(const void *buf, size_t len, int flags)
 //      {
@@ -516,6 +563,31 @@ ssize_t StandardSocket::recv(void *buf, size_t len, int flags)
 }
 
 
+/**
+ * Receive only what is immediately available, without waiting for data to arrive.
+ *
+ * @return number of received bytes; 0 if no data was available
+ * @throw SocketException
+ */
+ssize_t StandardSocket::recvNonblocking(void *buf, size_t len)
+{
+   ssize_t recvRes = ::recv(sock, buf, len, MSG_DONTWAIT);
+   if(recvRes > 0)
+   {
+      stats->incVals.netRecvBytes += recvRes;
+      return recvRes;
+   }
+
+   if(recvRes == 0)
+      throw SocketDisconnectException(std::string("Soft disconnect from ") + peername);
+
+   if( (errno == EAGAIN) || (errno == EWOULDBLOCK) )
+      return 0;
+
+   throw SocketDisconnectException(std::string("Recv(): Hard disconnect from ") +
+      peername + ". SysErr: " + System::getErrString() );
+}
+
 // version with MSG_DONTWAIT flag (without poll)
 //ssize_t StandardSocket::recvT(void *buf, size_t len, int flags, int timeoutMS)
 //       {
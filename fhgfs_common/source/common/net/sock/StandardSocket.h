@@ -2,6 +2,7 @@
 #define STANDARDSOCKET_H_
 
 #include <common/Common.h>
+#include "MuxSendChannel.h"
 #include "PooledSocket.h"
 
 class StandardSocket : public PooledSocket
@@ -27,6 +28,7 @@ class StandardSocket : public PooledSocket
       
       virtual ssize_t recv(void *buf, size_t len, int flags);
       virtual ssize_t recvT(void *buf, size_t len, int flags, int timeoutMS);
+      ssize_t recvNonblocking(void *buf, size_t len);
 
       ssize_t recvfrom(void *buf, size_t len, int flags, struct sockaddr *from, socklen_t *fromlen);
       ssize_t recvfromT(void *buf, size_t len, int flags,
@@ -35,6 +37,8 @@ class StandardSocket : public PooledSocket
       ssize_t broadcast(const void *buf, size_t len, int flags,
          struct in_addr* broadcastIP, unsigned short port);
 
+      ssize_t sendfile(int inFD, off_t offset, size_t len);
+
       
       void setSoKeepAlive(bool enable);
       void setSoBroadcast(bool enable);
@@ -55,6 +59,8 @@ class StandardSocket : public PooledSocket
       int sock;
       int epollFD; // only valid for connected sockets, not valid (-1) for listening sockets
       unsigned short sockDomain; // socket domain (aka protocol family) e.g. PF_INET
+
+      MuxSendChannel* muxSendChannel; // for responses on multiplexed conns (NULL if not used)
    
       
    public:
@@ -68,10 +74,34 @@ class StandardSocket : public PooledSocket
       {
          return sockDomain;
       }
+
+      /**
+       * @return NULL if no multiplexed msg was received over this conn so far.
+       */
+      MuxSendChannel* getMuxSendChannel() const
+      {
+         return muxSendChannel;
+      }
       
       
       // inliners
 
+      /**
+       * Get the send channel for multiplexed responses, create it on first use.
+       *
+       * Note: Not thread-safe, to be called only by the thread that currently owns this sock
+       * (i.e. the worker that received a msg over it).
+       *
+       * @throw SocketException if the channel cannot be created
+       */
+      MuxSendChannel* initMuxSendChannel()
+      {
+         if(!muxSendChannel)
+            muxSendChannel = new MuxSendChannel(sock, peername);
+
+         return muxSendChannel;
+      }
+
       /**
        * @throw SocketException
        */
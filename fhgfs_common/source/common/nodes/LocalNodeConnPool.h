@@ -27,6 +27,14 @@ class LocalNodeConnPool : public NodeConnPool
       Socket* acquireStreamSocketEx(bool allowWaiting);
       void releaseStreamSocket(Socket* sock);
       void invalidateStreamSocket(Socket* sock);
+
+      /**
+       * Local conns are handled by LocalConnWorkers, which don't support multiplexing.
+       */
+      MuxChannel* getMuxChannel()
+      {
+         return NULL;
+      }
       
    private:
       NicAddressList nicList;
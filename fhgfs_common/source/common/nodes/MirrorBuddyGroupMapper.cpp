@@ -69,8 +69,16 @@ FhgfsOpsErr MirrorBuddyGroupMapper::mapMirrorBuddyGroup(uint16_t buddyGroupID,
 
    MirrorBuddyGroup mbg(primaryTargetID, secondaryTargetID);
 
+   MirrorBuddyGroupMap oldGroups; // (only contains the updated group, if it existed before)
+
+   MirrorBuddyGroupMapCIter oldIter = mirrorBuddyGroups.find(buddyGroupID);
+   if(oldIter != mirrorBuddyGroups.end() )
+      oldGroups.insert(*oldIter);
+
    mirrorBuddyGroups[buddyGroupID] = mbg;
 
+   publishGroupsUnlocked(oldGroups);
+
    if (capacityPools)
       capacityPools->addIfNotExists(buddyGroupID, CapacityPool_LOW);
 
@@ -88,10 +96,18 @@ bool MirrorBuddyGroupMapper::unmapMirrorBuddyGroup(uint16_t buddyGroupID)
 {
    SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
 
+   MirrorBuddyGroupMap oldGroups;
+
+   MirrorBuddyGroupMapCIter oldIter = mirrorBuddyGroups.find(buddyGroupID);
+   if(oldIter != mirrorBuddyGroups.end() )
+      oldGroups.insert(*oldIter);
+
    size_t numErased = mirrorBuddyGroups.erase(buddyGroupID);
 
    if(numErased)
    {
+      publishGroupsUnlocked(oldGroups);
+
       mappingsDirty = true;
       if (capacityPools)
          capacityPools->remove(buddyGroupID);
@@ -122,6 +138,8 @@ void MirrorBuddyGroupMapper::syncGroupsFromLists(UInt16List& buddyGroupIDs,
 
    mirrorBuddyGroups.swap(newGroups);
 
+   publishGroupsUnlocked(newGroups); // (newGroups contains the old groups now)
+
    mappingsDirty = true;
 
    safeWriteLock.unlock(); // U N L O C K (write)
@@ -230,9 +248,13 @@ bool MirrorBuddyGroupMapper::loadFromFile()
       MapTk::loadStringMapFromFile(storePath.c_str(), &newGroupsStrMap);
 
       // apply loaded targets
-      mirrorBuddyGroups.clear();
+      MirrorBuddyGroupMap oldGroups;
+
+      mirrorBuddyGroups.swap(oldGroups);
       importFromStringMap(newGroupsStrMap);
 
+      publishGroupsUnlocked(oldGroups);
+
       mappingsDirty = true;
 
       loaded = true;
@@ -352,33 +374,20 @@ uint16_t MirrorBuddyGroupMapper::generateID()
 }
 
 /*
+ * Note: Lock-free.
+ *
  * @param targetID the targetID to look for
  *
  * @return the ID of the buddy group this target is mapped to, 0 if unmapped
  */
 uint16_t MirrorBuddyGroupMapper::getBuddyGroupID(uint16_t targetID)
 {
-   uint16_t buddyGroupID = 0;
-
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
-
-   for ( MirrorBuddyGroupMapIter iter = mirrorBuddyGroups.begin(); iter != mirrorBuddyGroups.end();
-      iter++ )
-   {
-      MirrorBuddyGroup mbg = iter->second;
-      if ( (mbg.firstTargetID == targetID) || (mbg.secondTargetID == targetID) )
-      {
-         buddyGroupID = iter->first;
-         break;
-      }
-   }
-
-   safeLock.unlock();
-
-   return buddyGroupID;
+   return (uint16_t)targetsLookupTable.get(targetID);
 }
 
 /*
+ * Note: Lock-free.
+ *
  * @param targetID the targetID to look for
  * @param outTargetIsPrimary true if the given targetID is the primary target, false otherwise
  *
@@ -386,13 +395,11 @@ uint16_t MirrorBuddyGroupMapper::getBuddyGroupID(uint16_t targetID)
  */
 uint16_t MirrorBuddyGroupMapper::getBuddyGroupID(uint16_t targetID, bool* outTargetIsPrimary)
 {
-   uint16_t buddyGroupID;
-
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   MirrorBuddyGroup mbg;
 
-   buddyGroupID = getBuddyGroupIDUnlocked(targetID, outTargetIsPrimary);
+   uint16_t buddyGroupID = lookupBuddyGroupOfTarget(targetID, mbg);
 
-   safeLock.unlock(); // U N L O C K
+   *outTargetIsPrimary = buddyGroupID && (mbg.firstTargetID == targetID);
 
    return buddyGroupID;
 }
@@ -427,7 +434,47 @@ uint16_t MirrorBuddyGroupMapper::getBuddyGroupIDUnlocked(uint16_t targetID,
    return buddyGroupID;
 }
 
+/**
+ * Lock-free lookup of the buddy group to which a target belongs.
+ *
+ * The group of the target and the members of the group are read from two different lookup
+ * tables, so a concurrent update might have changed the group in between. That case is detected
+ * (target no longer member of the group) and resolved by a locked lookup.
+ *
+ * @param outMBG the group to which the target belongs; only valid if return value is not 0.
+ * @return the ID of the buddy group this target is mapped to, 0 if unmapped
+ */
+uint16_t MirrorBuddyGroupMapper::lookupBuddyGroupOfTarget(uint16_t targetID,
+   MirrorBuddyGroup& outMBG)
+{
+   uint16_t buddyGroupID = (uint16_t)targetsLookupTable.get(targetID);
+   if(!buddyGroupID)
+      return 0; // target not mapped
+
+   outMBG = getMirrorBuddyGroup(buddyGroupID);
+
+   if(likely( (outMBG.firstTargetID == targetID) || (outMBG.secondTargetID == targetID) ) )
+      return buddyGroupID;
+
+   // group was updated between our two lookups => take the slow path
+
+   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+
+   bool isPrimary;
+
+   buddyGroupID = getBuddyGroupIDUnlocked(targetID, &isPrimary);
+
+   if(buddyGroupID)
+      outMBG = mirrorBuddyGroups[buddyGroupID];
+
+   safeLock.unlock(); // U N L O C K
+
+   return buddyGroupID;
+}
+
 /*
+ * Note: Lock-free.
+ *
  * @param targetID the targetID to get the buddy for
  * @param outTargetIsPrimary true if the given target is a primary target (may be NULL if not
  * interested in)
@@ -441,68 +488,47 @@ uint16_t MirrorBuddyGroupMapper::getBuddyTargetID(uint16_t targetID, bool* outTa
    if (outTargetIsPrimary)
       *outTargetIsPrimary = false; // false per default
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   MirrorBuddyGroup mbg;
 
-   for ( MirrorBuddyGroupMapIter iter = mirrorBuddyGroups.begin(); iter != mirrorBuddyGroups.end();
-      iter++ )
+   if (!lookupBuddyGroupOfTarget(targetID, mbg) )
+      return 0;
+
+   if (mbg.firstTargetID == targetID)
    {
-      MirrorBuddyGroup mbg = iter->second;
-      if (mbg.firstTargetID == targetID)
-      {
-         buddyTargetID = mbg.secondTargetID;
-         if (outTargetIsPrimary)
-            *outTargetIsPrimary = true;
-         break;
-      }
-      else
-      if (mbg.secondTargetID == targetID)
-      {
-         buddyTargetID = mbg.firstTargetID;
-         break;
-      }
+      buddyTargetID = mbg.secondTargetID;
+      if (outTargetIsPrimary)
+         *outTargetIsPrimary = true;
    }
-
-   safeLock.unlock();
+   else
+      buddyTargetID = mbg.firstTargetID;
 
    return buddyTargetID;
 }
 
 /*
+ * Note: Lock-free.
+ *
  * @param targetID the target ID to get the property for.
  *
  * @return MirrorBuddyState value indicating whether the target is primary, secondary or unmapped.
  */
 MirrorBuddyState MirrorBuddyGroupMapper::getBuddyState(uint16_t targetID)
 {
-   MirrorBuddyState result = BuddyState_UNMAPPED;
+   MirrorBuddyGroup mbg;
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   if (!lookupBuddyGroupOfTarget(targetID, mbg) )
+      return BuddyState_UNMAPPED;
 
-   for(MirrorBuddyGroupMapCIter iter = mirrorBuddyGroups.begin(); iter != mirrorBuddyGroups.end();
-       ++iter)
-   {
-      const MirrorBuddyGroup& mbg = iter->second;
-      if (mbg.firstTargetID == targetID)
-      {
-         result = BuddyState_PRIMARY;
-         break;
-      }
-      else
-      if (mbg.secondTargetID == targetID)
-      {
-         result = BuddyState_SECONDARY;
-         break;
-      }
-   }
-
-   safeLock.unlock(); // U N L O C K
+   if (mbg.firstTargetID == targetID)
+      return BuddyState_PRIMARY;
 
-   return result;
+   return BuddyState_SECONDARY;
 }
 
 /**
- * Find out whether a target is primary or secondary of a given buddy group. Since only one buddy
- * group is checked, this is faster than getBuddyState(uint16_t targetID).
+ * Find out whether a target is primary or secondary of a given buddy group.
+ *
+ * Note: Lock-free.
  *
  * @param targetID the target ID to get the property for.
  * @param buddyGroupID the ID of the buddy group to which the target belongs.
@@ -513,13 +539,11 @@ MirrorBuddyState MirrorBuddyGroupMapper::getBuddyState(uint16_t targetID, uint16
 {
    MirrorBuddyState result = BuddyState_UNMAPPED;
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   uint32_t lookupValue = groupsLookupTable.get(buddyGroupID);
 
-   MirrorBuddyGroupMapCIter mbgIter = mirrorBuddyGroups.find(buddyGroupID);
-
-   if (mbgIter != mirrorBuddyGroups.end() )
+   if (lookupValue) // (0 means group doesn't exist)
    {
-      const MirrorBuddyGroup& mbg = mbgIter->second;
+      MirrorBuddyGroup mbg = MIRRORBUDDYGROUPMAPPER_LOOKUP_UNPACK(lookupValue);
 
       if (targetID == mbg.firstTargetID)
          result = BuddyState_PRIMARY;
@@ -528,8 +552,6 @@ MirrorBuddyState MirrorBuddyGroupMapper::getBuddyState(uint16_t targetID, uint16
          result = BuddyState_SECONDARY;
    }
 
-   safeLock.unlock(); // U N L O C K
-
    return result;
 }
 
@@ -572,6 +594,59 @@ void MirrorBuddyGroupMapper::switchover(uint16_t buddyGroupID)
          "Mirror group ID: "+ StringTk::uintToStr(iter->first) );
 
    std::swap(mbg.firstTargetID, mbg.secondTargetID);
+
+   // (members didn't change, so only the group itself needs to be published)
+   groupsLookupTable.set(buddyGroupID, MIRRORBUDDYGROUPMAPPER_LOOKUP_PACK(mbg) );
+
    mappingsDirty = true;
 }
 
+/**
+ * Update the lookup tables after groups were added, updated or removed.
+ *
+ * New values are set before vanished groups and targets are removed, so that lock-free readers
+ * never see a group or target as unmapped that exists before and after the update.
+ *
+ * Note: unlocked, caller must hold write lock.
+ *
+ * @param oldGroups the groups (at least the changed or removed ones) before the update.
+ */
+void MirrorBuddyGroupMapper::publishGroupsUnlocked(const MirrorBuddyGroupMap& oldGroups)
+{
+   // (the first group of a target wins, same as in getBuddyGroupIDUnlocked() )
+   std::map<uint16_t, uint16_t> newTargetGroups; // keys: targetIDs, values: buddyGroupIDs
+
+   for(MirrorBuddyGroupMapCIter iter = mirrorBuddyGroups.begin();
+       iter != mirrorBuddyGroups.end();
+       iter++)
+   {
+      const MirrorBuddyGroup& mbg = iter->second;
+
+      groupsLookupTable.set(iter->first, MIRRORBUDDYGROUPMAPPER_LOOKUP_PACK(mbg) );
+
+      newTargetGroups.insert(std::pair<uint16_t, uint16_t>(mbg.firstTargetID, iter->first) );
+      newTargetGroups.insert(std::pair<uint16_t, uint16_t>(mbg.secondTargetID, iter->first) );
+   }
+
+   for(std::map<uint16_t, uint16_t>::const_iterator iter = newTargetGroups.begin();
+       iter != newTargetGroups.end();
+       iter++)
+      targetsLookupTable.set(iter->first, iter->second);
+
+   // remove vanished groups and targets
+
+   for(MirrorBuddyGroupMapCIter iter = oldGroups.begin(); iter != oldGroups.end(); iter++)
+   {
+      const MirrorBuddyGroup& mbg = iter->second;
+
+      if(mirrorBuddyGroups.find(iter->first) == mirrorBuddyGroups.end() )
+         groupsLookupTable.clear(iter->first);
+
+      if(newTargetGroups.find(mbg.firstTargetID) == newTargetGroups.end() )
+         targetsLookupTable.clear(mbg.firstTargetID);
+
+      if(newTargetGroups.find(mbg.secondTargetID) == newTargetGroups.end() )
+         targetsLookupTable.clear(mbg.secondTargetID);
+   }
+}
+
@@ -3,6 +3,7 @@
 
 #include <common/nodes/NodeCapacityPools.h>
 #include <common/nodes/TargetMapper.h>
+#include <common/threading/AtomicIDTable.h>
 #include <common/threading/SafeRWLock.h>
 #include <common/threading/SafeMutexLock.h>
 #include <common/Common.h>
@@ -13,6 +14,12 @@
 
 #define MIRRORBUDDYGROUPMAPPER_MAX_GROUPIDS (USHRT_MAX-1) /* -1 for reserved value "0" */
 
+/* lookup table values for groups: (firstTargetID << 16) | secondTargetID */
+#define MIRRORBUDDYGROUPMAPPER_LOOKUP_PACK(mbg) \
+   ( ( (uint32_t)(mbg).firstTargetID << 16) | (mbg).secondTargetID)
+#define MIRRORBUDDYGROUPMAPPER_LOOKUP_UNPACK(value) \
+   MirrorBuddyGroup( (uint16_t)( (value) >> 16), (uint16_t)(value) )
+
 
 struct MirrorBuddyGroup
 {
@@ -50,6 +57,13 @@ enum MirrorBuddyState
 };
 
 
+/**
+ * Map buddy group IDs to pairs of primary and secondary targetIDs.
+ *
+ * Note: The point lookups by group ID or targetID (getMirrorBuddyGroup(), getBuddyGroupID(),
+ * getBuddyState() etc.) are lock-free; they read from lookup tables, which mirror the groups map
+ * and are updated by all writers under the write lock.
+ */
 class MirrorBuddyGroupMapper
 {
    friend class TargetStateStore; // for atomic update of state change plus mirror group switch
@@ -90,6 +104,8 @@ class MirrorBuddyGroupMapper
 
       RWLock rwlock;
       MirrorBuddyGroupMap mirrorBuddyGroups;
+      AtomicIDTable groupsLookupTable; // lock-free view of mirrorBuddyGroups (by groupID)
+      AtomicIDTable targetsLookupTable; // reverse view (values: groupID of each targetID)
 
       bool mappingsDirty; // true if saved mappings file needs to be updated
       std::string storePath; // set to enable load/save methods (setting is not thread-safe)
@@ -97,9 +113,12 @@ class MirrorBuddyGroupMapper
       void exportToStringMap(StringMap& outExportMap);
       void importFromStringMap(StringMap& importMap);
 
+      void publishGroupsUnlocked(const MirrorBuddyGroupMap& oldGroups);
+
       uint16_t generateID();
 
       uint16_t getBuddyGroupIDUnlocked(uint16_t targetID, bool* outTargetIsPrimary);
+      uint16_t lookupBuddyGroupOfTarget(uint16_t targetID, MirrorBuddyGroup& outMBG);
 
       void getMappingAsListsUnlocked(UInt16List& outBuddyGroupIDs,
          MirrorBuddyGroupList& outBuddyGroups);
@@ -112,21 +131,15 @@ class MirrorBuddyGroupMapper
       // getters & setters
 
       /**
+       * Note: Lock-free.
+       *
        * @return a group with targets [0,0] if ID not found
        */
       MirrorBuddyGroup getMirrorBuddyGroup(uint16_t mirrorBuddyGroupID)
       {
-         MirrorBuddyGroup mbg(0,0);
-
-         SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
-
-         MirrorBuddyGroupMapCIter iter = mirrorBuddyGroups.find(mirrorBuddyGroupID);
-         if(likely(iter != mirrorBuddyGroups.end() ) )
-            mbg = iter->second;
-
-         safeLock.unlock(); // U N L O C K
+         uint32_t lookupValue = groupsLookupTable.get(mirrorBuddyGroupID);
 
-         return mbg;
+         return MIRRORBUDDYGROUPMAPPER_LOOKUP_UNPACK(lookupValue);
       }
 
       /**
@@ -0,0 +1,381 @@
+#include <common/app/log/LogContext.h>
+#include <common/app/AbstractApp.h>
+#include <common/net/message/NetMessage.h>
+#include <common/threading/SafeMutexLock.h>
+#include <common/toolkit/Time.h>
+#include "NodeConnPool.h"
+#include "MuxChannel.h"
+
+
+/**
+ * Note: The thread needs to be started by the caller.
+ *
+ * @param connPool the pool from which the conn of this channel will be acquired.
+ */
+MuxChannel::MuxChannel(NodeConnPool* connPool, std::string threadName) : PThread(threadName)
+{
+   this->connPool = connPool;
+   this->sock = NULL;
+   this->nextMuxID = 1; // (0 is reserved for classic conns)
+}
+
+/**
+ * Note: The thread must be stopped before deletion. The conn is not closed here, because it is
+ * still owned by the conn pool.
+ */
+MuxChannel::~MuxChannel()
+{
+   // nothing to be done here
+}
+
+/**
+ * Send a request over the multiplexed conn and wait for the response.
+ *
+ * @param outRespBuf the received response msg; needs to be freed by the caller if
+ *    FhgfsOpsErr_SUCCESS is returned.
+ * @return FhgfsOpsErr_NOTSUPP if the conn to this node doesn't support multiplexing (in which case
+ *    the caller should use a classic conn), FhgfsOpsErr_COMMUNICATION on communication error.
+ * @throw SocketException if the conn cannot be established
+ */
+FhgfsOpsErr MuxChannel::requestResponse(NetMessage* requestMsg, char** outRespBuf,
+   unsigned* outRespLen)
+{
+   const char* logContext = "MuxChannel (request)";
+
+   MuxPendingRequest pendingRequest;
+   unsigned muxID;
+   Socket* currentSock;
+   FhgfsOpsErr connRes;
+
+   *outRespBuf = NULL;
+   *outRespLen = 0;
+
+   // prepare sendBuf
+
+   size_t sendBufLen = requestMsg->getMsgLength();
+   char* sendBuf = (char*)malloc(sendBufLen);
+
+   if(unlikely(!sendBuf) )
+   { // malloc failed
+      LogContext(logContext).logErr(
+         "Memory allocation for send buffer failed. "
+         "Alloc size: " + StringTk::uintToStr(sendBufLen) );
+
+      return FhgfsOpsErr_OUTOFMEM;
+   }
+
+   requestMsg->serialize(sendBuf, sendBufLen);
+
+   SafeMutexLock sendLock(&sendMutex); // L O C K (send)
+
+   try
+   {
+      connRes = connectUnlocked();
+   }
+   catch(SocketException& e)
+   {
+      sendLock.unlock(); // U N L O C K (send)
+      free(sendBuf);
+
+      throw;
+   }
+
+   if(connRes != FhgfsOpsErr_SUCCESS)
+   {
+      sendLock.unlock(); // U N L O C K (send)
+      free(sendBuf);
+
+      return connRes;
+   }
+
+   // register as pending request before sending, because the response might be faster than us
+
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   muxID = nextMuxID++;
+   if(unlikely(!nextMuxID) )
+      nextMuxID = 1; // wrap around
+
+   pendingRequests.insert(MuxPendingRequestMapVal(muxID, &pendingRequest) );
+
+   currentSock = sock;
+
+   mutexLock.unlock(); // U N L O C K
+
+   NetMessage::injectMsgMuxIDIntoBuf(sendBuf, muxID);
+
+   try
+   {
+      currentSock->send(sendBuf, sendBufLen, 0);
+   }
+   catch(SocketException& e)
+   {
+      LogContext(logContext).log(Log_WARNING, "Communication error: " + std::string(e.what() ) );
+
+      // (the receiver will notice the broken conn and fail all pending requests, including ours)
+
+      try
+      {
+         currentSock->shutdown();
+      }
+      catch(SocketException& e)
+      {
+         // don't care, because the conn is broken anyway
+      }
+   }
+
+   sendLock.unlock(); // U N L O C K (send)
+
+   free(sendBuf);
+
+   // wait for the response
+
+   Time waitStartT;
+
+   mutexLock.relock(); // R E L O C K
+
+   while(!pendingRequest.isDone)
+   {
+      unsigned elapsedMS = waitStartT.elapsedMS();
+      if(elapsedMS >= CONN_LONG_TIMEOUT)
+         break;
+
+      pendingRequest.doneCond.timedwait(&mutex, CONN_LONG_TIMEOUT - elapsedMS);
+   }
+
+   if(unlikely(!pendingRequest.isDone) )
+   { // timeout (a late response will just be dropped by the receiver)
+      pendingRequests.erase(muxID);
+
+      mutexLock.unlock(); // U N L O C K
+
+      LogContext(logContext).log(Log_WARNING, "Response timed out. "
+         "Message type: " + requestMsg->getMsgTypeStr() );
+
+      return FhgfsOpsErr_COMMUNICATION;
+   }
+
+   mutexLock.unlock(); // U N L O C K
+
+   *outRespBuf = pendingRequest.respBuf;
+   *outRespLen = pendingRequest.respLen;
+
+   return pendingRequest.result;
+}
+
+/**
+ * Establish the conn if we don't have one yet.
+ *
+ * Note: Caller must hold sendMutex.
+ *
+ * @return FhgfsOpsErr_NOTSUPP if the conn pool gave us a conn type that doesn't support
+ *    multiplexing.
+ * @throw SocketException if the conn cannot be established
+ */
+FhgfsOpsErr MuxChannel::connectUnlocked()
+{
+   if(sock)
+      return FhgfsOpsErr_SUCCESS; // we're already connected
+
+   Socket* newSock = connPool->acquireStreamSocket();
+
+   if(newSock->getSockType() == NICADDRTYPE_RDMA)
+   { // RDMA sockets can't be used by different threads for sending and receiving at the same time
+      connPool->releaseStreamSocket(newSock);
+
+      return FhgfsOpsErr_NOTSUPP;
+   }
+
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   sock = newSock;
+
+   connChangeCond.signal();
+
+   mutexLock.unlock(); // U N L O C K
+
+   return FhgfsOpsErr_SUCCESS;
+}
+
+void MuxChannel::run()
+{
+   try
+   {
+      registerSignalHandler();
+
+      while(!getSelfTerminate() )
+      {
+         // wait for a conn
+
+         SafeMutexLock mutexLock(&mutex); // L O C K
+
+         if(!sock)
+            connChangeCond.timedwait(&mutex, MUXCHANNEL_RECV_POLL_MS);
+
+         Socket* currentSock = sock;
+
+         mutexLock.unlock(); // U N L O C K
+
+         if(!currentSock)
+            continue;
+
+         // receive responses
+
+         if(!recvResponse(currentSock) )
+            invalidateConn(currentSock);
+      }
+
+      LogContext("MuxChannel").log(Log_DEBUG, "Component stopped.");
+   }
+   catch(std::exception& e)
+   {
+      PThread::getCurrentThreadApp()->handleComponentException(e);
+   }
+}
+
+/**
+ * Receive the next response (if any arrives within MUXCHANNEL_RECV_POLL_MS) and hand it over to
+ * the waiting request.
+ *
+ * @return false if the conn is broken and needs to be invalidated.
+ */
+bool MuxChannel::recvResponse(Socket* currentSock)
+{
+   const char* logContext = "MuxChannel (recv)";
+
+   char* respBuf = NULL;
+
+   try
+   {
+      char headerBuf[NETMSG_HEADER_LENGTH];
+      ssize_t recvRes;
+
+      try
+      {
+         recvRes = currentSock->recvT(headerBuf, NETMSG_HEADER_LENGTH, 0,
+            MUXCHANNEL_RECV_POLL_MS);
+      }
+      catch(SocketTimeoutException& e)
+      {
+         return true; // no response within timeout => give caller a chance to check termination
+      }
+
+      if(recvRes < NETMSG_HEADER_LENGTH)
+         currentSock->recvExactT(&headerBuf[recvRes], NETMSG_HEADER_LENGTH - recvRes, 0,
+            CONN_LONG_TIMEOUT);
+
+      unsigned msgLength = NetMessage::extractMsgLengthFromBuf(headerBuf);
+      unsigned muxID = NetMessage::extractMsgMuxIDFromBuf(headerBuf);
+
+      if(unlikely( (msgLength < NETMSG_HEADER_LENGTH) || (msgLength > NETMSG_MAX_MSG_SIZE) ) )
+      {
+         LogContext(logContext).log(Log_NOTICE, "Received a message with invalid length from: " +
+            currentSock->getPeername() );
+
+         return false;
+      }
+
+      if(unlikely(!muxID) )
+      {
+         LogContext(logContext).logErr("Received a response without muxID. "
+            "Peer probably doesn't support multiplexed conns: " + currentSock->getPeername() );
+
+         return false;
+      }
+
+      respBuf = (char*)malloc(msgLength);
+      if(unlikely(!respBuf) )
+      {
+         LogContext(logContext).logErr("Memory allocation for response buffer failed. "
+            "Alloc size: " + StringTk::uintToStr(msgLength) );
+
+         return false;
+      }
+
+      memcpy(respBuf, headerBuf, NETMSG_HEADER_LENGTH);
+
+      if(msgLength > NETMSG_HEADER_LENGTH)
+         currentSock->recvExactT(&respBuf[NETMSG_HEADER_LENGTH], msgLength - NETMSG_HEADER_LENGTH,
+            0, CONN_LONG_TIMEOUT);
+
+      // hand the response over to the waiting request
+
+      SafeMutexLock mutexLock(&mutex); // L O C K
+
+      MuxPendingRequestMapIter iter = pendingRequests.find(muxID);
+      if(likely(iter != pendingRequests.end() ) )
+      {
+         completeRequestUnlocked(iter->second, FhgfsOpsErr_SUCCESS, respBuf, msgLength);
+         pendingRequests.erase(iter);
+
+         respBuf = NULL; // now owned by the request
+      }
+
+      mutexLock.unlock(); // U N L O C K
+
+      if(unlikely(respBuf) )
+      { // request gave up already (e.g. timeout)
+         LOG_DEBUG(logContext, Log_DEBUG, "Dropping response for unknown muxID: " +
+            StringTk::uintToStr(muxID) + "; peer: " + currentSock->getPeername() );
+
+         free(respBuf);
+      }
+
+      return true;
+   }
+   catch(SocketDisconnectException& e)
+   {
+      // (note: level Log_DEBUG here to avoid spamming the log until we have log topics)
+      LogContext(logContext).log(Log_DEBUG, std::string(e.what() ) );
+   }
+   catch(SocketException& e)
+   {
+      LogContext(logContext).log(Log_NOTICE,
+         "Connection error: " + currentSock->getPeername() + ": " + std::string(e.what() ) );
+   }
+
+   SAFE_FREE(respBuf);
+
+   return false;
+}
+
+/**
+ * Give the broken conn back to the pool and fail all pending requests.
+ *
+ * Note: Only the receiver thread calls this, so nobody else can be inside recv on the conn; and
+ * we take the sendMutex, so nobody can be inside send.
+ */
+void MuxChannel::invalidateConn(Socket* currentSock)
+{
+   SafeMutexLock sendLock(&sendMutex); // L O C K (send)
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   sock = NULL;
+
+   for(MuxPendingRequestMapIter iter = pendingRequests.begin();
+       iter != pendingRequests.end();
+       iter++)
+      completeRequestUnlocked(iter->second, FhgfsOpsErr_COMMUNICATION, NULL, 0);
+
+   pendingRequests.clear();
+
+   mutexLock.unlock(); // U N L O C K
+
+   connPool->invalidateStreamSocket(currentSock);
+
+   sendLock.unlock(); // U N L O C K (send)
+}
+
+/**
+ * Note: Caller must hold mutex.
+ */
+void MuxChannel::completeRequestUnlocked(MuxPendingRequest* request, FhgfsOpsErr result,
+   char* respBuf, unsigned respLen)
+{
+   request->respBuf = respBuf;
+   request->respLen = respLen;
+   request->result = result;
+   request->isDone = true;
+
+   request->doneCond.signal();
+}
@@ -0,0 +1,90 @@
+#ifndef MUXCHANNEL_H_
+#define MUXCHANNEL_H_
+
+#include <common/net/sock/Socket.h>
+#include <common/threading/Condition.h>
+#include <common/threading/Mutex.h>
+#include <common/threading/PThread.h>
+#include <common/storage/StorageErrors.h>
+#include <common/Common.h>
+
+
+#define MUXCHANNEL_RECV_POLL_MS  1000 // recv timeout of the receiver to check for termination
+
+
+// forward declarations
+class NetMessage;
+class NodeConnPool;
+
+
+/**
+ * A request that waits for its response on a MuxChannel.
+ */
+struct MuxPendingRequest
+{
+   MuxPendingRequest() : respBuf(NULL), respLen(0), isDone(false),
+      result(FhgfsOpsErr_COMMUNICATION) {}
+
+   char* respBuf; // set by the receiver, to be freed by the requester
+   unsigned respLen;
+   bool isDone; // true if response was received or the conn broke
+   FhgfsOpsErr result;
+
+   Condition doneCond; // signaled when isDone is set
+};
+
+typedef std::map<unsigned, MuxPendingRequest*> MuxPendingRequestMap; // key: muxID
+typedef MuxPendingRequestMap::iterator MuxPendingRequestMapIter;
+typedef MuxPendingRequestMap::value_type MuxPendingRequestMapVal;
+
+
+/**
+ * A multiplexed conn to a node, which is shared by many concurrent small request/response
+ * exchanges (e.g. stat, lookup, GetChunkFileAttribs) instead of blocking a conn of the pool for
+ * each of them.
+ *
+ * Each request gets a muxID in its msg header. The requesting thread only sends the request and
+ * then waits, while this channel's thread receives all responses of the conn and hands them over
+ * to the waiting requests by their muxID. The server processes the requests of a multiplexed conn
+ * in parallel, so responses can arrive in any order.
+ *
+ * The conn is acquired from the NodeConnPool on first use (it counts against the max number of
+ * conns of the pool) and is given back to the pool via invalidation if it breaks, in which case
+ * all pending requests fail with a communication error and the next request reconnects.
+ *
+ * Note: Only for requests without extra data before or after the msg (i.e. no file contents)
+ * and only over TCP; see MessagingTk::requestResponseComm().
+ *
+ * Note: Only the userspace daemons and tools use this class, so in practice it covers server to
+ * server traffic. The kernel client has its own messaging code and always uses classic conns.
+ */
+class MuxChannel : public PThread
+{
+   public:
+      MuxChannel(NodeConnPool* connPool, std::string threadName);
+      virtual ~MuxChannel();
+
+      FhgfsOpsErr requestResponse(NetMessage* requestMsg, char** outRespBuf,
+         unsigned* outRespLen);
+
+
+   private:
+      NodeConnPool* connPool;
+
+      Mutex sendMutex; // held while a request is sent or while the conn is (dis)connected
+      Mutex mutex; // protects all following members (lock order: sendMutex before mutex)
+      Condition connChangeCond; // signaled when the conn was established
+
+      Socket* sock; // NULL if not connected
+      unsigned nextMuxID;
+      MuxPendingRequestMap pendingRequests;
+
+      virtual void run();
+      bool recvResponse(Socket* currentSock);
+      void invalidateConn(Socket* currentSock);
+      FhgfsOpsErr connectUnlocked();
+      void completeRequestUnlocked(MuxPendingRequest* request, FhgfsOpsErr result,
+         char* respBuf, unsigned respLen);
+};
+
+#endif /*MUXCHANNEL_H_*/
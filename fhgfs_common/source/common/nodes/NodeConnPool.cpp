@@ -36,6 +36,10 @@ NodeConnPool::NodeConnPool(Node* parentNode, unsigned short streamPort, NicAddre
    this->fallbackExpirationSecs = cfg->getConnFallbackExpirationSecs();
    this->isChannelDirect = true;
 
+   // (multiplexed conns may take at most half of the conns to leave enough for classic requests)
+   this->muxChannelsNum = std::min(cfg->getConnMuxChannelsNum(), maxConns / 2);
+   this->nextMuxChannelIndex = 0;
+
    this->app = app;
    this->parentNode = parentNode;
    this->streamPort = streamPort;
@@ -48,6 +52,17 @@ NodeConnPool::~NodeConnPool()
 {
    const char* logContext = "NodeConn (destruct)";
 
+   // stop the receivers of multiplexed conns (their conns are closed below with all others)
+
+   for(MuxChannelVecIter iter = muxChannels.begin(); iter != muxChannels.end(); iter++)
+      (*iter)->selfTerminate();
+
+   for(MuxChannelVecIter iter = muxChannels.begin(); iter != muxChannels.end(); iter++)
+   {
+      (*iter)->join();
+      delete(*iter);
+   }
+
    if(!connList.empty() )
    {
       LogContext(logContext).log(Log_DEBUG,
@@ -64,6 +79,69 @@ NodeConnPool::~NodeConnPool()
 }
 
 
+/**
+ * Get a multiplexed conn for small request/response exchanges (see MuxChannel).
+ *
+ * Channels are created on demand up to the configured number and then assigned round-robin.
+ *
+ * @return NULL if multiplexed conns are disabled.
+ * @throw PThreadCreateException if the receiver thread of a new channel cannot be started
+ */
+MuxChannel* NodeConnPool::getMuxChannel()
+{
+   MuxChannel* channel;
+
+   if(likely(!muxChannelsNum) )
+      return NULL; // (unlocked check for the common case)
+
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   if(!muxChannelsNum)
+   { // disabled in the meantime
+      mutexLock.unlock(); // U N L O C K
+      return NULL;
+   }
+
+   if(muxChannels.size() < muxChannelsNum)
+   { // create another channel
+      channel = new MuxChannel(this, "MuxChannel");
+
+      try
+      {
+         channel->start();
+      }
+      catch(PThreadCreateException& e)
+      {
+         mutexLock.unlock(); // U N L O C K
+         delete(channel);
+
+         throw;
+      }
+
+      muxChannels.push_back(channel);
+   }
+   else
+      channel = muxChannels[nextMuxChannelIndex++ % muxChannels.size()];
+
+   mutexLock.unlock(); // U N L O C K
+
+   return channel;
+}
+
+/**
+ * Stop using multiplexed conns for this node, e.g. because we only have RDMA conns to it.
+ *
+ * Note: Existing channels stay idle until the pool is destroyed.
+ */
+void NodeConnPool::disableMuxChannels()
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   muxChannelsNum = 0;
+
+   mutexLock.unlock(); // U N L O C K
+}
+
 /**
  * Note: Will block if no stream socket is immediately available.
  *
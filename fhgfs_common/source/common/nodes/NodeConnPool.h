@@ -9,11 +9,15 @@
 #include <common/threading/Mutex.h>
 #include <common/threading/Condition.h>
 #include <common/Common.h>
+#include "MuxChannel.h"
 
 
 typedef std::list<PooledSocket*> ConnectionList;
 typedef ConnectionList::iterator ConnListIter;
 
+typedef std::vector<MuxChannel*> MuxChannelVec;
+typedef MuxChannelVec::iterator MuxChannelVecIter;
+
 // forward declaration
 class AbstractApp;
 class Node;
@@ -102,6 +106,9 @@ class NodeConnPool
       virtual Socket* acquireStreamSocketEx(bool allowWaiting);
       virtual void releaseStreamSocket(Socket* sock);
       virtual void invalidateStreamSocket(Socket* sock);
+
+      virtual MuxChannel* getMuxChannel();
+      void disableMuxChannels();
       
       unsigned disconnectAndResetIdleStreams();
 
@@ -128,6 +135,10 @@ class NodeConnPool
       NodeConnPoolStats stats;
       NodeConnPoolErrorState errState;
 
+      MuxChannelVec muxChannels; // created on demand, up to muxChannelsNum
+      unsigned muxChannelsNum; // 0 if multiplexed conns are disabled
+      unsigned nextMuxChannelIndex; // for round-robin selection
+
       Mutex mutex;
       Condition changeCond;
       
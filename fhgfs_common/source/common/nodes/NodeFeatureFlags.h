@@ -36,6 +36,7 @@
 
 #define STORAGE_FEATURE_DUMMY       0
 #define STORAGE_FEATURE_REMOVEBUDDYGROUP 1
+#define STORAGE_FEATURE_CHUNKATTRIBSMULTI 2
 
 
 // client feature flags
@@ -23,6 +23,7 @@ bool TargetMapper::mapTarget(uint16_t targetID, uint16_t nodeID)
    size_t oldSize = targets.size();
 
    targets[targetID] = nodeID;
+   lookupTable.set(targetID, nodeID | TARGETMAPPER_LOOKUP_MAPPED_FLAG);
 
    size_t newSize = targets.size();
 
@@ -54,6 +55,7 @@ bool TargetMapper::unmapTarget(uint16_t targetID)
    { // targetID found
 
       targets.erase(iter);
+      lookupTable.clear(targetID);
 
       if(capacityPools)
          capacityPools->remove(targetID);
@@ -89,6 +91,7 @@ bool TargetMapper::unmapByNodeID(uint16_t nodeID)
          iter++; // move iter to next elem
 
          targets.erase(eraseIter);
+         lookupTable.clear(targetID);
 
          if(capacityPools)
             capacityPools->remove(targetID);
@@ -168,9 +171,10 @@ void TargetMapper::syncTargetsFromLists(UInt16List& targetIDs, UInt16List& nodeI
 
    SafeRWLock safeWriteLock(&rwlock, SafeRWLock_WRITE); // L O C K (write)
 
-   targets.clear();
    targets.swap(newTargets);
 
+   publishTargetsUnlocked(newTargets); // (newTargets contains the old targets now)
+
    mappingsDirty = true;
 
    safeWriteLock.unlock(); // U N L O C K (write)
@@ -295,9 +299,13 @@ bool TargetMapper::loadFromFile()
       MapTk::loadStringMapFromFile(storePath.c_str(), &newTargetsStrMap);
 
       // apply loaded targets
-      targets.clear();
+      TargetMap oldTargets;
+
+      targets.swap(oldTargets);
       importFromStringMap(newTargetsStrMap);
 
+      publishTargetsUnlocked(oldTargets);
+
       // add to attached capacity pools
       if(capacityPools)
       {
@@ -397,3 +405,25 @@ void TargetMapper::importFromStringMap(StringMap& importMap)
    }
 }
 
+
+/**
+ * Update lookupTable after the targets map was replaced as a whole.
+ *
+ * New values are set before vanished targets are removed, so that lock-free readers never see a
+ * target as unmapped that exists in the old and in the new map.
+ *
+ * Note: unlocked, caller must hold write lock.
+ *
+ * @param oldTargets the targets map before the update.
+ */
+void TargetMapper::publishTargetsUnlocked(const TargetMap& oldTargets)
+{
+   for(TargetMapCIter iter = targets.begin(); iter != targets.end(); iter++)
+      lookupTable.set(iter->first, iter->second | TARGETMAPPER_LOOKUP_MAPPED_FLAG);
+
+   for(TargetMapCIter iter = oldTargets.begin(); iter != oldTargets.end(); iter++)
+   {
+      if(targets.find(iter->first) == targets.end() )
+         lookupTable.clear(iter->first);
+   }
+}
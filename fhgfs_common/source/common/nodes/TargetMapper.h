@@ -3,13 +3,20 @@
 
 #include <common/nodes/TargetCapacityPools.h>
 #include <common/nodes/TargetStateStore.h>
+#include <common/threading/AtomicIDTable.h>
 #include <common/threading/SafeRWLock.h>
 #include <common/threading/SafeMutexLock.h>
 #include <common/Common.h>
 
 
+#define TARGETMAPPER_LOOKUP_MAPPED_FLAG   (1 << 16) /* marks targetIDs as mapped in lookupTable */
+
+
 /**
  * Map targetIDs to nodeIDs.
+ *
+ * Note: getNodeID() and targetExists() are lock-free; they read from lookupTable, which mirrors
+ * the targets map and is updated by all writers under the write lock.
  */
 class TargetMapper
 {
@@ -35,6 +42,7 @@ class TargetMapper
    private:
       RWLock rwlock;
       TargetMap targets; // keys: targetIDs, values: nodeNumIDs
+      AtomicIDTable lookupTable; // lock-free view of targets (nodeID | MAPPED_FLAG)
 
       TargetCapacityPools* capacityPools; // for auto add/remove on map/unmap (may be NULL)
       TargetStateStore* states; // optional for auto add/remove on map/unmap (may be NULL)
@@ -45,28 +53,20 @@ class TargetMapper
       void exportToStringMap(StringMap& outExportMap);
       void importFromStringMap(StringMap& importMap);
 
+      void publishTargetsUnlocked(const TargetMap& oldTargets);
+
 
    public:
       // getters & setters
 
       /**
+       * Note: Lock-free.
+       *
        * @return 0 if target not found
        */
       uint16_t getNodeID(uint16_t targetID)
       {
-         uint16_t nodeID = 0;
-
-         SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
-
-         TargetMapCIter iter = targets.find(targetID);
-         if(iter != targets.end() )
-         {
-            nodeID = iter->second;
-         }
-
-         safeLock.unlock(); // U N L O C K
-
-         return nodeID;
+         return (uint16_t)lookupTable.get(targetID); // (flag is cut off by the cast)
       }
 
       size_t getSize()
@@ -96,24 +96,12 @@ class TargetMapper
          return retVal;
       }
 
+      /**
+       * Note: Lock-free.
+       */
       bool targetExists(uint16_t targetID)
       {
-         bool retVal = false;
-
-         SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
-
-         for (TargetMapIter iter = targets.begin(); iter != targets.end(); iter++)
-         {
-            if (iter->first == targetID)
-            {
-               retVal = true;
-               break;
-            }
-         }
-
-         safeLock.unlock();
-
-         return retVal;
+         return (lookupTable.get(targetID) & TARGETMAPPER_LOOKUP_MAPPED_FLAG) != 0;
       }
 };
 
@@ -33,6 +33,9 @@ bool TargetStateStore::addOrUpdate(uint16_t targetID, CombinedTargetState state)
       iter->second = state; // Note: Also updates the lastChangedTime.
    }
 
+   if (hasChanged)
+      publishStateUnlocked(targetID);
+
    lock.unlock(); // U N L O C K
 
    return hasChanged;
@@ -48,7 +51,10 @@ void TargetStateStore::addIfNotExists(uint16_t targetID, CombinedTargetState sta
    TargetStateInfoMapIter iter = statesMap.find(targetID);
 
    if (iter == statesMap.end())
+   {
       statesMap[targetID] = state;
+      publishStateUnlocked(targetID);
+   }
 
    lock.unlock();
 }
@@ -58,6 +64,7 @@ void TargetStateStore::removeTarget(uint16_t targetID)
    SafeRWLock lock(&rwlock, SafeRWLock_WRITE);
 
    statesMap.erase(targetID);
+   publishStateUnlocked(targetID);
 
    lock.unlock();
 }
@@ -107,8 +114,10 @@ void TargetStateStore::syncStatesAndGroupsFromLists(MirrorBuddyGroupMapper* budd
    SafeRWLock buddyGroupsLock(&buddyGroups->rwlock, SafeRWLock_WRITE); // L O C K buddyGroups
 
    statesMapNewTmp.swap(statesMap);
+   publishStatesUnlocked(statesMapNewTmp); // (statesMapNewTmp contains the old states now)
 
    buddyGroups->mirrorBuddyGroups.swap(newGroups);
+   buddyGroups->publishGroupsUnlocked(newGroups); // (newGroups contains the old groups now)
 
    buddyGroups->mappingsDirty = true;
 
@@ -142,6 +151,7 @@ void TargetStateStore::syncStatesFromLists(const UInt16List& targetIDs,
    SafeRWLock lock(&rwlock, SafeRWLock_WRITE);
 
    statesMapNewTmp.swap(statesMap);
+   publishStatesUnlocked(statesMapNewTmp); // (statesMapNewTmp contains the old states now)
 
    lock.unlock();
 }
@@ -196,6 +206,29 @@ void TargetStateStore::getStatesAsListsUnlocked(UInt16List& outTargetIDs,
    }
 }
 
+/**
+ * Update lookupTable after statesMap was replaced as a whole.
+ *
+ * New values are set before vanished targets are removed, so that lock-free readers never see a
+ * target as unknown that exists in the old and in the new map.
+ *
+ * Note: Caller must hold write lock.
+ *
+ * @param oldStatesMap the states map before the update.
+ */
+void TargetStateStore::publishStatesUnlocked(const TargetStateInfoMap& oldStatesMap)
+{
+   for (TargetStateInfoMapConstIter iter = statesMap.begin(); iter != statesMap.end(); iter++)
+      publishStateUnlocked(iter->first);
+
+   for (TargetStateInfoMapConstIter iter = oldStatesMap.begin(); iter != oldStatesMap.end();
+        iter++)
+   {
+      if (statesMap.find(iter->first) == statesMap.end() )
+         publishStateUnlocked(iter->first); // (clears the entry)
+   }
+}
+
 const char* TargetStateStore::stateToStr(TargetReachabilityState state)
 {
    switch(state)
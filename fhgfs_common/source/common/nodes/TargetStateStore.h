@@ -2,12 +2,23 @@
 #define TARGETSTATESTORE_H_
 
 #include <common/nodes/TargetStateInfo.h>
+#include <common/threading/AtomicIDTable.h>
 #include <common/threading/SafeRWLock.h>
 
 
+/* lookup table values: VALID_FLAG | (reachabilityState << 8) | consistencyState */
+#define TARGETSTATESTORE_LOOKUP_VALID_FLAG   (1 << 16)
+
+
 class MirrorBuddyGroupMapper; // forward declaration
 
 
+/**
+ * Note: getState() is lock-free; it reads from lookupTable, which mirrors the reachability and
+ * consistency states of statesMap. Writers (including subclasses) need to call
+ * publishStateUnlocked() or publishStatesUnlocked() for each change of statesMap under the write
+ * lock.
+ */
 class TargetStateStore
 {
    public:
@@ -40,7 +51,11 @@ class TargetStateStore
 
       TargetStateInfoMap statesMap;
 
+      void publishStatesUnlocked(const TargetStateInfoMap& oldStatesMap);
+
    private:
+      AtomicIDTable lookupTable; // lock-free view of statesMap (see publishStateUnlocked() )
+
       void getStatesAsListsUnlocked(UInt16List& outTargetIDs,
          UInt8List& outReachabilityStates, UInt8List& outConsistencyStates);
 
@@ -59,17 +74,22 @@ class TargetStateStore
          return res;
       }
 
+      /**
+       * Note: Lock-free.
+       *
+       * @return false if target not found
+       */
       bool getState(uint16_t targetID, CombinedTargetState& outState)
       {
-         bool res;
+         uint32_t lookupValue = lookupTable.get(targetID);
 
-         SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+         if(unlikely(!(lookupValue & TARGETSTATESTORE_LOOKUP_VALID_FLAG) ) )
+            return false;
 
-         res = getStateUnlocked(targetID, outState);
+         outState.reachabilityState = (TargetReachabilityState)( (lookupValue >> 8) & 0xFF);
+         outState.consistencyState = (TargetConsistencyState)(lookupValue & 0xFF);
 
-         safeLock.unlock(); // U N L O C K
-
-         return res;
+         return true;
       }
 
       void setAllStates(TargetReachabilityState state)
@@ -102,10 +122,31 @@ class TargetStateStore
             {
                currentState.reachabilityState = state;
                currentState.lastChangedTime.setToNow();
+
+               publishStateUnlocked(iter->first);
             }
          }
       }
 
+      /**
+       * Update lookupTable after the state of a single target was added, changed or removed.
+       *
+       * Note: Caller must hold write lock.
+       */
+      void publishStateUnlocked(uint16_t targetID)
+      {
+         TargetStateInfoMapConstIter iter = this->statesMap.find(targetID);
+         if(iter == statesMap.end() )
+         {
+            lookupTable.clear(targetID);
+            return;
+         }
+
+         lookupTable.set(targetID, TARGETSTATESTORE_LOOKUP_VALID_FLAG |
+            ( (uint32_t)iter->second.reachabilityState << 8) |
+            (uint32_t)iter->second.consistencyState);
+      }
+
    private:
       bool getStateInfoUnlocked(uint16_t targetID, TargetStateInfo& outStateInfo)
       {
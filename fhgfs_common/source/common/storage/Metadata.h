@@ -19,6 +19,8 @@
                                                      * this is a bit dangerous, at it might
                                                      * conflict with user file names, so we need
                                                      * to chose a good name */
+#define META_DENTRYINDEX_FILENAME      "#dIdx#" /* packed index of all dentries of a dir (in the
+                                                   dentries dir, same name conflict as above) */
 
 #define META_LOSTANDFOUND_PATH         "lost+found"
 
@@ -22,6 +22,10 @@
 
 class StatData;
 
+typedef std::list<StatData> StatDataList;
+typedef StatDataList::iterator StatDataListIter;
+typedef StatDataList::const_iterator StatDataListConstIter;
+
 
 class StatData
 {
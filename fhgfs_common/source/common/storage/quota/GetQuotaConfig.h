@@ -16,6 +16,8 @@ struct GetQuotaInfoConfig : public QuotaConfig
 {
    unsigned cfgTargetSelection;  // the kind to collect the quota data/limits: GETQUOTACONFIG_...
    uint16_t cfgTargetNumID;      // targetNumID if a single target is selected
+   UInt16Set cfgTargetNumIDs;    /* if not empty, only these targets are queried (only for
+                                    GETQUOTACONFIG_ALL_TARGETS_ONE_REQUEST_PER_TARGET) */
    bool cfgPrintUnused;          // print users/groups that have no space used
    bool cfgWithSystemUsersGroups;// if system users/groups should be used be considered
 };
@@ -131,6 +131,9 @@ bool GetQuotaInfo::requestQuotaDataAndCollectResponses(Node* mgmtNode,
             // request the quota data for the targets in a separate message
             for(UInt16ListIter iter = targetIDs.begin(); iter != targetIDs.end(); iter++)
             {
+               if(!this->cfg.cfgTargetNumIDs.empty() && !this->cfg.cfgTargetNumIDs.count(*iter) )
+                  continue; // target not selected
+
                GetQuotaInfoConfig requestCfg = this->cfg;
                requestCfg.cfgTargetNumID = *iter;
 
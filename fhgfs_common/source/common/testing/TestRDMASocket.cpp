@@ -0,0 +1,317 @@
+#include <common/net/sock/NetworkInterfaceCard.h>
+#include <common/toolkit/StringTk.h>
+
+#include <sys/poll.h>
+#include "TestRDMASocket.h"
+
+
+/**
+ * @return byte of msg msgIndex of conn connIndex (so that mixed up msgs are noticed).
+ */
+static char testRDMASocketMsgByte(unsigned connIndex, unsigned msgIndex)
+{
+   return (char)(connIndex * TESTRDMASOCKET_MSG_NUM + msgIndex);
+}
+
+/**
+ * @param forRead true for the data that the client reads back from the server (which differs
+ *    from the data that the client writes).
+ */
+static char testRDMASocketBufByte(unsigned connIndex, size_t offset, bool forRead)
+{
+   char val = (char)(offset + connIndex);
+
+   return forRead ? ~val : val;
+}
+
+
+TestRDMASocket::TestRDMASocket()
+{
+   log.setContext("TestRDMASocket");
+}
+
+TestRDMASocket::~TestRDMASocket()
+{
+}
+
+void TestRDMASocket::setUp()
+{
+}
+
+void TestRDMASocket::tearDown()
+{
+}
+
+/**
+ * Several clients connect to a listener with shared recv bufs and send more msgs than they have
+ * credits, while the listener serves one conn after the other. Then each client writes into and
+ * reads from a registered buf of the listener via one-sided RDMA.
+ */
+void TestRDMASocket::testSharedRecvLoopback()
+{
+   log.log(Log_DEBUG, "testSharedRecvLoopback started");
+
+   struct in_addr ipAddr;
+
+   if(!findRDMAInterface(&ipAddr) )
+   {
+      log.log(Log_WARNING, "No RDMA device found. Skipping test.");
+      return;
+   }
+
+   RDMASocket listenSock;
+   TestClientThread clients[TESTRDMASOCKET_CONN_NUM];
+   RDMASocket* acceptedSocks[TESTRDMASOCKET_CONN_NUM] = { NULL };
+   unsigned numAccepted = 0;
+   std::string serverErrMsg; // (we can't fail before the client threads are stopped)
+
+   listenSock.setSharedRecvBuffers(TESTRDMASOCKET_SHARED_BUF_NUM, TESTRDMASOCKET_BUF_SIZE);
+   listenSock.bindToAddr(ipAddr.s_addr, TESTRDMASOCKET_PORT);
+   listenSock.listen();
+
+   for(unsigned i=0; i < TESTRDMASOCKET_CONN_NUM; i++)
+   {
+      clients[i].init(ipAddr, i);
+      clients[i].start();
+   }
+
+   try
+   {
+      // accept all conns (accept() handles one conn manager event per call)
+
+      while(numAccepted < TESTRDMASOCKET_CONN_NUM)
+      {
+         struct pollfd pollFD;
+         struct sockaddr_in peerAddr;
+         socklen_t peerAddrLen = sizeof(peerAddr);
+
+         pollFD.fd = listenSock.getFD();
+         pollFD.events = POLLIN;
+         pollFD.revents = 0;
+
+         if(poll(&pollFD, 1, TESTRDMASOCKET_TIMEOUT_MS) <= 0)
+         {
+            serverErrMsg = "Waiting for incoming connections failed or timed out";
+            break;
+         }
+
+         Socket* sock = listenSock.accept( (struct sockaddr*)&peerAddr, &peerAddrLen);
+         if(sock)
+            acceptedSocks[numAccepted++] = (RDMASocket*)sock;
+      }
+
+      // serve conns one after the other (so that the other clients run out of credits)
+
+      for(unsigned i=0; (i < numAccepted) && serverErrMsg.empty(); i++)
+      {
+         unsigned connIndex;
+
+         if(!acceptedSocks[i]->getUsesSharedRecvBuffers() )
+         {
+            serverErrMsg = "Accepted connection doesn't use shared recv buffers";
+            break;
+         }
+
+         acceptedSocks[i]->recvExactT(&connIndex, sizeof(connIndex), 0, TESTRDMASOCKET_TIMEOUT_MS);
+
+         if( (connIndex >= TESTRDMASOCKET_CONN_NUM) || !serveConn(acceptedSocks[i], connIndex) )
+            serverErrMsg = "Received data mismatch";
+      }
+   }
+   catch(SocketException& e)
+   {
+      serverErrMsg = std::string("Socket error: ") + e.what();
+   }
+
+   // (deleting the accepted socks disconnects clients that are still waiting for us)
+   for(unsigned i=0; i < numAccepted; i++)
+      delete(acceptedSocks[i]);
+
+   for(unsigned i=0; i < TESTRDMASOCKET_CONN_NUM; i++)
+      clients[i].join(); // (client recvs time out if the server side failed)
+
+   CPPUNIT_ASSERT_MESSAGE(serverErrMsg, serverErrMsg.empty() );
+
+   for(unsigned i=0; i < TESTRDMASOCKET_CONN_NUM; i++)
+      CPPUNIT_ASSERT_MESSAGE(clients[i].getErrMsg(), clients[i].getSuccess() );
+
+   log.log(Log_DEBUG, "testSharedRecvLoopback finished");
+}
+
+/**
+ * @return false if there is no usable RDMA device (in which case the tests should be skipped).
+ */
+bool TestRDMASocket::findRDMAInterface(struct in_addr* outIPAddr)
+{
+   StringList allowedInterfaces; // (empty => all interfaces)
+   NicAddressList nicList;
+
+   if(!RDMASocket::rdmaDevicesExist() )
+      return false;
+
+   NetworkInterfaceCard::findAll(&allowedInterfaces, false, true, &nicList);
+
+   for(NicAddressListIter iter = nicList.begin(); iter != nicList.end(); iter++)
+   {
+      if(iter->nicType == NICADDRTYPE_RDMA)
+      {
+         *outIPAddr = iter->ipAddr;
+         return true;
+      }
+   }
+
+   return false;
+}
+
+/**
+ * Server side of a conn, see TestClientThread.
+ *
+ * @return false on received data mismatch
+ * @throw SocketException
+ */
+bool TestRDMASocket::serveConn(RDMASocket* sock, unsigned connIndex)
+{
+   char msgBuf[TESTRDMASOCKET_BUF_SIZE];
+   char ack = 0;
+   bool dataOk = true;
+
+   for(unsigned msgIndex=0; msgIndex < TESTRDMASOCKET_MSG_NUM; msgIndex++)
+   {
+      sock->recvExactT(msgBuf, sizeof(msgBuf), 0, TESTRDMASOCKET_TIMEOUT_MS);
+
+      for(size_t i=0; i < sizeof(msgBuf); i++)
+      {
+         if(msgBuf[i] != testRDMASocketMsgByte(connIndex, msgIndex) )
+            dataOk = false;
+      }
+   }
+
+   // one-sided transfers (client writes into our buf, then reads it back after we changed it)
+
+   char* rdmaBuf = (char*)calloc(1, TESTRDMASOCKET_RDMA_BUF_SIZE);
+   IBVBufRegion* region = sock->registerBuf(rdmaBuf, TESTRDMASOCKET_RDMA_BUF_SIZE);
+   TestRDMASocketRemoteBuf remoteBuf;
+
+   remoteBuf.vaddr = (uintptr_t)rdmaBuf;
+   remoteBuf.rkey = sock->getBufRegionRKey(region);
+
+   try
+   {
+      sock->send(&remoteBuf, sizeof(remoteBuf), 0);
+
+      sock->recvExactT(&ack, sizeof(ack), 0, TESTRDMASOCKET_TIMEOUT_MS); // write done
+
+      for(size_t i=0; i < TESTRDMASOCKET_RDMA_BUF_SIZE; i++)
+      {
+         if(rdmaBuf[i] != testRDMASocketBufByte(connIndex, i, false) )
+            dataOk = false;
+
+         rdmaBuf[i] = testRDMASocketBufByte(connIndex, i, true);
+      }
+
+      sock->send(&ack, sizeof(ack), 0); // ready for read
+
+      sock->recvExactT(&ack, sizeof(ack), 0, TESTRDMASOCKET_TIMEOUT_MS); // read done
+   }
+   catch(...)
+   {
+      sock->deregisterBuf(region);
+      free(rdmaBuf);
+      throw;
+   }
+
+   sock->deregisterBuf(region);
+   free(rdmaBuf);
+
+   return dataOk;
+}
+
+
+void TestRDMASocket::TestClientThread::run()
+{
+   try
+   {
+      RDMASocket sock;
+      struct sockaddr_in serverAddr;
+
+      memset(&serverAddr, 0, sizeof(serverAddr) );
+
+      serverAddr.sin_family = AF_INET;
+      serverAddr.sin_addr = serverIP;
+      serverAddr.sin_port = htons(TESTRDMASOCKET_PORT);
+
+      sock.setBuffers(TESTRDMASOCKET_BUF_NUM, TESTRDMASOCKET_BUF_SIZE);
+      sock.connect( (struct sockaddr*)&serverAddr, sizeof(serverAddr) );
+
+      runClient(&sock);
+
+      success = errMsg.empty();
+   }
+   catch(SocketException& e)
+   {
+      errMsg = "Client " + StringTk::uintToStr(connIndex) + ": " + e.what();
+   }
+}
+
+/**
+ * Note: Sets errMsg on data mismatch.
+ *
+ * @throw SocketException
+ */
+void TestRDMASocket::TestClientThread::runClient(RDMASocket* sock)
+{
+   char msgBuf[TESTRDMASOCKET_BUF_SIZE];
+   char ack = 0;
+   TestRDMASocketRemoteBuf remoteBuf;
+
+   sock->send(&connIndex, sizeof(connIndex), 0);
+
+   for(unsigned msgIndex=0; msgIndex < TESTRDMASOCKET_MSG_NUM; msgIndex++)
+   {
+      memset(msgBuf, testRDMASocketMsgByte(connIndex, msgIndex), sizeof(msgBuf) );
+
+      sock->send(msgBuf, sizeof(msgBuf), 0);
+   }
+
+   sock->recvExactT(&remoteBuf, sizeof(remoteBuf), 0, TESTRDMASOCKET_TIMEOUT_MS);
+
+   char* rdmaBuf = (char*)malloc(TESTRDMASOCKET_RDMA_BUF_SIZE);
+   IBVBufRegion* region = sock->registerBuf(rdmaBuf, TESTRDMASOCKET_RDMA_BUF_SIZE);
+
+   try
+   {
+      for(size_t i=0; i < TESTRDMASOCKET_RDMA_BUF_SIZE; i++)
+         rdmaBuf[i] = testRDMASocketBufByte(connIndex, i, false);
+
+      sock->rdmaWrite(region, rdmaBuf, TESTRDMASOCKET_RDMA_BUF_SIZE,
+         remoteBuf.vaddr, remoteBuf.rkey);
+
+      sock->send(&ack, sizeof(ack), 0); // write done
+
+      sock->recvExactT(&ack, sizeof(ack), 0, TESTRDMASOCKET_TIMEOUT_MS); // ready for read
+
+      sock->rdmaRead(region, rdmaBuf, TESTRDMASOCKET_RDMA_BUF_SIZE,
+         remoteBuf.vaddr, remoteBuf.rkey);
+
+      sock->send(&ack, sizeof(ack), 0); // read done
+
+      for(size_t i=0; i < TESTRDMASOCKET_RDMA_BUF_SIZE; i++)
+      {
+         if(rdmaBuf[i] != testRDMASocketBufByte(connIndex, i, true) )
+         {
+            errMsg = "Client " + StringTk::uintToStr(connIndex) + ": RDMA read data mismatch "
+               "at offset " + StringTk::uint64ToStr(i);
+            break;
+         }
+      }
+   }
+   catch(...)
+   {
+      sock->deregisterBuf(region);
+      free(rdmaBuf);
+      throw;
+   }
+
+   sock->deregisterBuf(region);
+   free(rdmaBuf);
+}
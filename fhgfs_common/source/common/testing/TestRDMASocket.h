@@ -0,0 +1,104 @@
+#ifndef TESTRDMASOCKET_H_
+#define TESTRDMASOCKET_H_
+
+#include <common/app/log/LogContext.h>
+#include <common/net/sock/RDMASocket.h>
+#include <common/threading/PThread.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+
+
+/* note: the conns get the shared bufs split between them, so later conns get less credits than
+   they have bufs (CONN_NUM * BUF_NUM > SHARED_BUF_NUM). */
+#define TESTRDMASOCKET_PORT                  8799
+#define TESTRDMASOCKET_CONN_NUM              4
+#define TESTRDMASOCKET_BUF_NUM               8
+#define TESTRDMASOCKET_SHARED_BUF_NUM        16
+#define TESTRDMASOCKET_BUF_SIZE              8192
+#define TESTRDMASOCKET_MSG_NUM               256
+#define TESTRDMASOCKET_RDMA_BUF_SIZE         (1024*1024)
+#define TESTRDMASOCKET_TIMEOUT_MS            30000
+
+/**
+ * Registered buf of the server for one-sided transfers (sent from server to client).
+ */
+struct TestRDMASocketRemoteBuf
+{
+   uint64_t vaddr;
+   unsigned rkey;
+};
+
+
+/**
+ * Tests RDMA conns with shared recv bufs and one-sided RDMA read/write over a local RDMA device
+ * (e.g. Soft-RoCE: "rdma link add rxe0 type rxe netdev eth0").
+ *
+ * Note: Tests are skipped if there is no RDMA device.
+ */
+class TestRDMASocket: public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE( TestRDMASocket );
+   CPPUNIT_TEST( testSharedRecvLoopback );
+   CPPUNIT_TEST_SUITE_END();
+
+   public:
+      TestRDMASocket();
+      virtual ~TestRDMASocket();
+
+      void setUp();
+      void tearDown();
+
+      void testSharedRecvLoopback();
+
+   private:
+      LogContext log;
+
+      bool findRDMAInterface(struct in_addr* outIPAddr);
+      bool serveConn(RDMASocket* sock, unsigned connIndex);
+
+   protected:
+      /**
+       * Client side of a conn: sends msgs to the server, then writes to and reads from a buf of
+       * the server via one-sided RDMA.
+       */
+      class TestClientThread: public PThread
+      {
+         public:
+            TestClientThread() : PThread("RDMASockTester")
+            {
+               this->connIndex = 0;
+               this->success = false;
+            }
+
+            void init(struct in_addr serverIP, unsigned connIndex)
+            {
+               this->serverIP = serverIP;
+               this->connIndex = connIndex;
+            }
+
+         private:
+            struct in_addr serverIP;
+            unsigned connIndex;
+
+            bool success;
+            std::string errMsg;
+
+            void run();
+            void runClient(RDMASocket* sock);
+
+         public:
+            bool getSuccess()
+            {
+               return success;
+            }
+
+            std::string getErrMsg()
+            {
+               return errMsg;
+            }
+      };
+};
+
+#endif /* TESTRDMASOCKET_H_ */
@@ -0,0 +1,84 @@
+#ifndef ATOMICIDTABLE_H_
+#define ATOMICIDTABLE_H_
+
+#include <common/Common.h>
+
+#include <limits.h>
+#include <new>
+
+
+#define ATOMICIDTABLE_NUM_ENTRIES   (USHRT_MAX+1) /* one entry for each possible 16bit ID */
+
+
+/*
+ * Direct-index table of 32bit values for lock-free lookups by 16bit numeric IDs (like targetIDs
+ * or buddy group IDs).
+ *
+ * This is meant as a read-only view next to a lock-protected std::map: The owner keeps using its
+ * map for iteration and modification, but publishes each value change to this table while it
+ * holds its write lock, so that hot point lookups (e.g. getNodeID() on each chunk file access)
+ * don't need to take the read lock.
+ *
+ * Each value is read and written as a single aligned word, so a reader always sees either the
+ * old or the new value of an entry. The table is allocated once and never resized or freed while
+ * its owner lives, so readers don't need to care about reclamation of old versions. Values must
+ * be self-contained (no pointers), with 0 meaning "not set".
+ *
+ * Note: Writers need to be serialized by the owner.
+ * Note: Allocated via calloc, so pages of unused ID ranges won't consume physical memory.
+ */
+class AtomicIDTable
+{
+   public:
+      /**
+       * @throw std::bad_alloc if table cannot be allocated.
+       */
+      AtomicIDTable()
+      {
+         entries = (uint32_t*)calloc(ATOMICIDTABLE_NUM_ENTRIES, sizeof(uint32_t) );
+         if(unlikely(!entries) )
+            throw std::bad_alloc();
+      }
+
+      ~AtomicIDTable()
+      {
+         free(entries);
+      }
+
+
+   private:
+      uint32_t* entries;
+
+      AtomicIDTable(const AtomicIDTable& other); // not copyable
+      AtomicIDTable& operator=(const AtomicIDTable& other); // not assignable
+
+
+   public:
+      // inliners
+
+      /**
+       * @return 0 if no value was set for this ID
+       */
+      uint32_t get(uint16_t id) const
+      {
+         return *(volatile const uint32_t*)&entries[id];
+      }
+
+      /**
+       * Note: Caller must be the only writer (e.g. by holding the owner's write lock).
+       */
+      void set(uint16_t id, uint32_t value)
+      {
+         __sync_lock_test_and_set(&entries[id], value); // gcc extension (see Atomic::set() )
+      }
+
+      /**
+       * Note: Caller must be the only writer (e.g. by holding the owner's write lock).
+       */
+      void clear(uint16_t id)
+      {
+         set(id, 0);
+      }
+};
+
+#endif /* ATOMICIDTABLE_H_ */
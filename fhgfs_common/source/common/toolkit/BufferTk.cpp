@@ -61,3 +61,89 @@ uint32_t BufferTk::hash32(const char* data, int len)
 
    return hash;
 }
+
+/**
+ * Note: This is the 64bit MurmurHash2 (MurmurHash64A) by Austin Appleby, which is in the public
+ * domain. It's considerably stronger than hash32() and fast on 64bit archs.
+ *
+ * @data the buffer for which you want the hash value to be computed (arbitrary length)
+ * @len length of the data buffer
+ */
+uint64_t BufferTk::hash64(const char* data, size_t len)
+{
+   const uint64_t seed = 0x5bd1e995;
+   const uint64_t m = 0xc6a4a7935bd1e995ULL;
+   const int r = 47;
+
+   uint64_t hash = seed ^ (len * m);
+
+   const char* end = data + (len & ~(size_t)7);
+
+   /* Main loop */
+   for( ; data != end; data += sizeof(uint64_t) )
+   {
+      uint64_t k;
+      memcpy(&k, data, sizeof(k) ); // (unaligned-safe load, compiled to a plain mov on x86)
+
+      k *= m;
+      k ^= k >> r;
+      k *= m;
+
+      hash ^= k;
+      hash *= m;
+   }
+
+   /* Handle end cases (same as the fall-through switch of the reference implementation) */
+   const size_t rem = len & 7;
+
+   if(rem)
+   {
+      for(size_t i = 0; i < rem; i++)
+         hash ^= uint64_t( (unsigned char)data[i]) << (8 * i);
+
+      hash *= m;
+   }
+
+   hash ^= hash >> r;
+   hash *= m;
+   hash ^= hash >> r;
+
+   return hash;
+}
+
+/**
+ * Check whether a buffer contains only zeros.
+ *
+ * The main loop ORs 64 bytes at once without any early exit inside a block, so that the compiler
+ * can vectorize it; this is much faster than memcmp() against a zero buffer.
+ *
+ * @return true if all len bytes of data are zero.
+ */
+bool BufferTk::isZero(const char* data, size_t len)
+{
+   const size_t blockLen = 8 * sizeof(uint64_t);
+
+   // handle unaligned start bytewise
+   for( ; len && ( (uintptr_t)data & (sizeof(uint64_t)-1) ); data++, len--)
+      if(*data)
+         return false;
+
+   const uint64_t* words = (const uint64_t*)data;
+
+   for( ; len >= blockLen; words += 8, len -= blockLen)
+   {
+      uint64_t orSum = words[0] | words[1] | words[2] | words[3] |
+         words[4] | words[5] | words[6] | words[7];
+
+      if(orSum)
+         return false;
+   }
+
+   data = (const char*)words;
+
+   for( ; len; data++, len--)
+      if(*data)
+         return false;
+
+   return true;
+}
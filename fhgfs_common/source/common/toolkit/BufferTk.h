@@ -9,6 +9,8 @@ class BufferTk
 {
    public:
       static uint32_t hash32(const char* data, int len);
+      static uint64_t hash64(const char* data, size_t len);
+      static bool isZero(const char* data, size_t len);
 
 
    private:
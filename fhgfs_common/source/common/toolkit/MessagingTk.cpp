@@ -495,6 +495,24 @@ FhgfsOpsErr MessagingTk::requestResponseComm(RequestResponseArgs* rrArgs)
    char* sendBuf = NULL;
    rrArgs->outRespBuf = NULL;
    rrArgs->outRespMsg = NULL;
+
+   if(!rrArgs->sendExtraData)
+   { // small request/response exchange => use a multiplexed conn if enabled
+      MuxChannel* muxChannel = connPool->getMuxChannel();
+      if(muxChannel)
+      {
+         retVal = requestResponseCommMux(rrArgs, muxChannel);
+         if(likely(retVal != FhgfsOpsErr_NOTSUPP) )
+            return retVal;
+
+         // conn type doesn't support multiplexing => fall back to classic conns
+
+         LogContext(logContext).log(Log_DEBUG, "Disabling multiplexed conns to: " +
+            node->getNodeIDWithTypeStr() );
+
+         connPool->disableMuxChannels();
+      }
+   }
    
    try
    {
@@ -607,6 +625,93 @@ err_cleanup:
    return retVal;
 }
 
+/**
+ * Sends a message over a multiplexed conn and receives the response (see MuxChannel).
+ *
+ * Note: This is the equivalent of requestResponseComm() for requests without extra data.
+ *
+ * @return FhgfsOpsErr_NOTSUPP if the conn doesn't support multiplexing (=> use classic conns).
+ */
+FhgfsOpsErr MessagingTk::requestResponseCommMux(RequestResponseArgs* rrArgs,
+   MuxChannel* muxChannel)
+{
+   const char* logContext = "Messaging (RPC mux)";
+
+   Node* node = rrArgs->node;
+   AbstractNetMessageFactory* netMessageFactory =
+      PThread::getCurrentThreadApp()->getNetMessageFactory();
+
+   FhgfsOpsErr retVal = FhgfsOpsErr_INTERNAL;
+   unsigned respLength = 0;
+
+   try
+   {
+      retVal = muxChannel->requestResponse(rrArgs->requestMsg, &rrArgs->outRespBuf, &respLength);
+   }
+   catch(SocketConnectException& e)
+   {
+      if ( !(rrArgs->logFlags & REQUESTRESPONSEARGS_LOGFLAG_CONNESTABLISHFAILED) )
+      {
+         LogContext(logContext).log(Log_WARNING,
+            "Unable to connect to: " + node->getNodeIDWithTypeStr() + ". " +
+            "(Message type: " + rrArgs->requestMsg->getMsgTypeStr() + ")");
+      }
+
+      return FhgfsOpsErr_COMMUNICATION;
+   }
+   catch(SocketException& e)
+   {
+      LogContext(logContext).logErr("Communication error: " + std::string(e.what() ) + "; " +
+         "Peer: " + node->getNodeIDWithTypeStr() + ". "
+         "(Message type: " + rrArgs->requestMsg->getMsgTypeStr() + ")");
+
+      return FhgfsOpsErr_COMMUNICATION;
+   }
+
+   if(unlikely(retVal != FhgfsOpsErr_SUCCESS) )
+   {
+      if(retVal == FhgfsOpsErr_COMMUNICATION)
+         LogContext(logContext).log(Log_WARNING,
+            "Failed to receive response from: " + node->getNodeIDWithTypeStr() + ". " +
+            "(Message type: " + rrArgs->requestMsg->getMsgTypeStr() + ")");
+
+      return retVal;
+   }
+
+   // got response => deserialize it
+   rrArgs->outRespMsg = netMessageFactory->createFromBuf(rrArgs->outRespBuf, respLength);
+
+   if(unlikely(rrArgs->outRespMsg->getMsgType() == NETMSGTYPE_GenericResponse) )
+   { // special control msg received
+      // (note: conn doesn't need to be invalidated here, it's not exclusively ours anyway)
+      retVal = handleGenericResponse(rrArgs);
+      goto err_cleanup;
+   }
+
+   if(unlikely(rrArgs->outRespMsg->getMsgType() != rrArgs->respMsgType) )
+   { // response invalid (wrong msgType)
+      LogContext(logContext).logErr(
+         "Received invalid response type: " + rrArgs->outRespMsg->getMsgTypeStr() + "; "
+         "expected: " + NetMsgStrMapping().defineToStr(rrArgs->respMsgType) + ". "
+         "Peer: " + node->getNodeIDWithTypeStr() );
+
+      retVal = FhgfsOpsErr_INTERNAL;
+      goto err_cleanup;
+   }
+
+   // got correct response
+
+   return FhgfsOpsErr_SUCCESS;
+
+
+err_cleanup:
+
+   SAFE_DELETE(rrArgs->outRespMsg);
+   SAFE_FREE(rrArgs->outRespBuf);
+
+   return retVal;
+}
+
 /**
  * Creates a message buffer of the required size and serializes the message to it.
  * 
@@ -38,6 +38,8 @@ class MessagingTk
       MessagingTk() {}
       
       static FhgfsOpsErr requestResponseComm(RequestResponseArgs* rrArgs);
+      static FhgfsOpsErr requestResponseCommMux(RequestResponseArgs* rrArgs,
+         MuxChannel* muxChannel);
       static FhgfsOpsErr handleGenericResponse(RequestResponseArgs* rrArgs);
 
    public:
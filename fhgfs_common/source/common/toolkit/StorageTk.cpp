@@ -939,7 +939,8 @@ struct dirent* StorageTk::readdirFiltered(DIR* dirp)
  * Calls system readdir() and optionally skips certain entries.
  *
  * @param filterDots true if you want to filter "." and "..".
- * @param filterFSIDsDir true if you want to filter META_DIRENTRYID_SUB_STR ("#fSiDs#").
+ * @param filterFSIDsDir true if you want to filter META_DIRENTRYID_SUB_STR ("#fSiDs#") and
+ * META_DENTRYINDEX_FILENAME ("#dIdx#").
  * @return same as system readdir() except that this will never return the filtered entries.
  */
 struct dirent* StorageTk::readdirFilteredEx(DIR* dirp, bool filterDots,
@@ -957,7 +958,8 @@ struct dirent* StorageTk::readdirFilteredEx(DIR* dirp, bool filterDots,
 
          if( (!filterDots || strcmp(dirEntry->d_name, ".") ) &&
              (!filterDots || strcmp(dirEntry->d_name, "..") ) &&
-             (!filterFSIDsDir || strcmp(dirEntry->d_name, META_DIRENTRYID_SUB_STR) ) )
+             (!filterFSIDsDir || strcmp(dirEntry->d_name, META_DIRENTRYID_SUB_STR) ) &&
+             (!filterFSIDsDir || strcmp(dirEntry->d_name, META_DENTRYINDEX_FILENAME) ) )
          {
             return dirEntry;
          }
@@ -43,6 +43,12 @@ class TimeAbs
          return (now.tv_usec != t.now.tv_usec) || (now.tv_sec != t.now.tv_sec);
       }
 
+      bool operator < (const TimeAbs& t) const
+      {
+         return (now.tv_sec < t.now.tv_sec) ||
+            ( (now.tv_sec == t.now.tv_sec) && (now.tv_usec < t.now.tv_usec) );
+      }
+
       TimeAbs& operator = (const TimeAbs& t)
       {
           if(this != &t)
@@ -35,22 +35,6 @@ class Path;
 class Serialization
 {
    public:
-      // string (de)serialization
-      static unsigned serializeStr(char* buf, unsigned strLen, const char* strStart);
-      static bool deserializeStr(const char* buf, size_t bufLen,
-         unsigned* outStrLen, const char** outStrStart, unsigned* outBufLen);
-      static bool deserializeStr(const char* buf, size_t bufLen,
-         std::string* outStr, unsigned* outBufLen);
-      static unsigned serialLenStr(unsigned strLen);
-
-      // string aligned (de)serialization
-      static unsigned serializeStrAlign4(char* buf, unsigned strLen, const char* strStart);
-      static bool deserializeStrAlign4(const char* buf, size_t bufLen,
-         unsigned* outStrLen, const char** outStrStart, unsigned* outBufLen);
-      static bool deserializeStrAlign4(const char* buf, size_t bufLen,
-         std::string* outStr, unsigned* outBufLen);
-      static unsigned serialLenStrAlign4(unsigned strLen);
-
       // nicList (de)serialization
       static unsigned serializeNicList(char* buf, NicAddressList* nicList);
       static bool deserializeNicListPreprocess(const char* buf, size_t bufLen,
@@ -107,40 +91,6 @@ class Serialization
          const char* setStart, StringSet* outSet);
       static unsigned serialLenStringSet(const StringSet* set);
 
-      // UIntList (de)serialization
-      static unsigned serializeUIntList(char* buf, UIntList* list);
-      static bool deserializeUIntListPreprocess(const char* buf, size_t bufLen,
-         unsigned* outElemNum, const char** outListStart, unsigned* outListBufLen);
-      static bool deserializeUIntList(unsigned listBufLen, unsigned elemNum,
-         const char* listStart, UIntList* outList);
-      static unsigned serialLenUIntList(UIntList* list);
-      static unsigned serialLenUIntList(size_t size);
-
-      // UInt8List (/ushort) (de)serialization
-      static unsigned serializeUInt8List(char* buf, UInt8List* list);
-      static bool deserializeUInt8ListPreprocess(const char* buf, size_t bufLen,
-         unsigned* outElemNum, const char** outListStart, unsigned* outListBufLen);
-      static bool deserializeUInt8List(unsigned listBufLen, unsigned elemNum,
-         const char* listStart, UInt8List* outList);
-      static unsigned serialLenUInt8List(UInt8List* list);
-      static unsigned serialLenUInt8List(size_t size);
-
-      // UInt16List (/ushort) (de)serialization
-      static unsigned serializeUInt16List(char* buf, UInt16List* list);
-      static bool deserializeUInt16ListPreprocess(const char* buf, size_t bufLen,
-         unsigned* outElemNum, const char** outListStart, unsigned* outListBufLen);
-      static bool deserializeUInt16List(unsigned listBufLen, unsigned elemNum,
-         const char* listStart, UInt16List* outList);
-      static unsigned serialLenUInt16List(UInt16List* list);
-      static unsigned serialLenUInt16List(size_t size);
-      // UShortVector (de)serialization
-      static unsigned serializeUShortVector(char* buf, UShortVector* vec);
-      static bool deserializeUShortVectorPreprocess(const char* buf, size_t bufLen,
-         unsigned* outElemNum, const char** outVecStart, unsigned* outVecBufLen);
-      static bool deserializeUShortVector(unsigned vecBufLen, unsigned elemNum,
-         const char* outVecStart, UShortVector* outVec);
-      static unsigned serialLenUShortVector(UShortVector* vec);
-
       // CharVector (de)serialization
       static unsigned serializeCharVector(char* buf, CharVector* vec);
       static bool deserializeCharVectorPreprocess(const char* buf, size_t bufLen,
@@ -149,77 +99,6 @@ class Serialization
          const char* outVecStart, CharVector* outVec);
       static unsigned serialLenCharVector(CharVector* vec);
 
-
-
-      // UIntVector (de)serialization
-      static unsigned serializeUIntVector(char* buf, UIntVector* vec);
-      static bool deserializeUIntVectorPreprocess(const char* buf, size_t bufLen,
-         unsigned* outElemNum, const char** outListStart, unsigned* outVecBufLen);
-      static bool deserializeUIntVector(unsigned vecBufLen, unsigned elemNum,
-         const char* outVecStart, UIntVector* outVec);
-      static unsigned serialLenUIntVector(UIntVector* vec);
-      static unsigned serialLenUIntVector(size_t size);
-
-      // UInt16Vector (/ushort) (de)serialization
-      static unsigned serializeUInt16Vector(char* buf, UInt16Vector* vec);
-      static bool deserializeUInt16VectorPreprocess(const char* buf, size_t bufLen,
-         unsigned* outElemNum, const char** outListStart, unsigned* outVecBufLen);
-      static bool deserializeUInt16Vector(unsigned vecBufLen, unsigned elemNum,
-         const char* outVecStart, UInt16Vector* outVec);
-      static unsigned serialLenUInt16Vector(UInt16Vector* vec);
-      static unsigned serialLenUInt16Vector(size_t size);
-
-      // IntList (de)serialization
-      static unsigned serializeIntList(char* buf, IntList* list);
-      static bool deserializeIntListPreprocess(const char* buf, size_t bufLen,
-         unsigned* outElemNum, const char** outListStart, unsigned* outListBufLen);
-      static bool deserializeIntList(unsigned listBufLen, unsigned elemNum,
-         const char* listStart, IntList* outList);
-      static unsigned serialLenIntList(IntList* list);
-
-      // IntVector (de)serialization
-      static unsigned serializeIntVector(char* buf, IntVector* vec);
-      static bool deserializeIntVectorPreprocess(const char* buf, size_t bufLen,
-         unsigned* outElemNum, const char** outVecStart, unsigned* outVecBufLen);
-      static bool deserializeIntVector(unsigned vecBufLen, unsigned elemNum,
-         const char* outVecStart, IntVector* outVec);
-      static unsigned serialLenIntVector(IntVector* vec);
-
-      // Int64List (de)serialization
-      static unsigned serializeInt64List(char* buf, Int64List* list);
-      static bool deserializeInt64ListPreprocess(const char* buf, size_t bufLen,
-         unsigned* outElemNum, const char** outListStart, unsigned* outListBufLen);
-      static bool deserializeInt64List(unsigned listBufLen, unsigned elemNum,
-         const char* listStart, Int64List* outList);
-      static unsigned serialLenInt64List(Int64List* list);
-      static unsigned serialLenInt64List(size_t size);
-
-      // Int64Vector (de)serialization
-      static unsigned serializeInt64Vector(char* buf, Int64Vector* vec);
-      static bool deserializeInt64VectorPreprocess(const char* buf, size_t bufLen,
-         unsigned* outElemNum, const char** outVecStart, unsigned* outVecBufLen);
-      static bool deserializeInt64Vector(unsigned vecBufLen, unsigned elemNum,
-         const char* outVecStart, Int64Vector* outVec);
-      static unsigned serialLenInt64Vector(Int64Vector* vec);
-
-      // UInt64List (de)serialization
-      static unsigned serializeUInt64List(char* buf, const UInt64List* list);
-      static bool deserializeUInt64ListPreprocess(const char* buf, size_t bufLen,
-         unsigned* outElemNum, const char** outListStart, unsigned* outListBufLen);
-      static bool deserializeUInt64List(unsigned listBufLen, unsigned elemNum,
-         const char* listStart, UInt64List* outList);
-      static unsigned serialLenUInt64List(const UInt64List* list);
-      static unsigned serialLenUInt64List(size_t size);
-
-      // UInt64Vector (de)serialization
-      static unsigned serializeUInt64Vector(char* buf, const UInt64Vector* vec);
-      static bool deserializeUInt64VectorPreprocess(const char* buf, size_t bufLen,
-         unsigned* outElemNum, const char** outListStart, unsigned* outVecBufLen);
-      static bool deserializeUInt64Vector(unsigned vecBufLen, unsigned elemNum,
-         const char* outVecStart, UInt64Vector* outVec);
-      static unsigned serialLenUInt64Vector(const UInt64Vector* vec);
-      static unsigned serialLenUInt64Vector(size_t size);
-
       // BoolList (de)serialization
       static unsigned serializeBoolList(char* buf, BoolList* list);
       static bool deserializeBoolListPreprocess(const char* buf, size_t bufLen,
@@ -306,6 +185,8 @@ class Serialization
    private:
       Serialization() {}
 
+      static void logDeserializeStrAlign4Error(const char* buf, size_t bufLen);
+
 
    public:
       // inliners
@@ -521,6 +402,700 @@ class Serialization
          return sizeof(uint64_t);
       }
 
+      // string (de)serialization
+      static inline unsigned serializeStr(char* buf, unsigned strLen, const char* strStart)
+      {
+         size_t bufPos = 0;
+
+         // write length field
+         bufPos += serializeUInt(&buf[bufPos], strLen);
+
+         // write raw string
+         memcpy(&buf[bufPos], strStart, strLen);
+         bufPos += strLen;
+
+         // write termination char
+         buf[bufPos] = 0;
+
+         return serialLenStr(strLen);
+      }
+
+      /**
+       * Note: This doesn't copy the string, outStrStart points into buf and is zero-terminated.
+       *
+       * @return false on error (e.g. strLen is greater than bufLen)
+       */
+      static inline bool deserializeStr(const char* buf, size_t bufLen,
+         unsigned* outStrLen, const char** outStrStart, unsigned* outLen)
+      {
+         // check min length
+         if(unlikely(bufLen < serialLenStr(0) ) )
+            return false;
+
+         // length field
+         LITTLE_ENDIAN_TO_HOST_32(*(const unsigned*)buf, *outStrLen);
+
+         // string start
+         *outStrStart = &buf[serialLenUInt()];
+
+         // required outLen
+         *outLen = serialLenStr(*outStrLen);
+
+         // check length (also catches overflow of huge length fields) and terminating zero
+         if(unlikely( (*outLen < *outStrLen) || (bufLen < *outLen) ||
+            ( (*outStrStart)[*outStrLen] != 0) ) )
+            return false;
+
+         return true;
+      }
+
+      /**
+       * This version deserializes into a std::string.
+       */
+      static inline bool deserializeStr(const char* buf, size_t bufLen,
+         std::string* outStr, unsigned* outBufLen)
+      {
+         unsigned strLen;
+         const char* strStart;
+
+         if(unlikely(!deserializeStr(buf, bufLen, &strLen, &strStart, outBufLen) ) )
+            return false;
+
+         outStr->assign(strStart, strLen);
+
+         return true;
+      }
+
+      static inline unsigned serialLenStr(unsigned strLen)
+      {
+         // strLenField + str + terminating zero
+         return serialLenUInt() + strLen + 1;
+      }
+
+      // string with 4-byte aligned padding (de)serialization
+
+      /**
+       * Note: Adds padding to achieve 4-byte alignment. Requires calling deserializeStrAlign4 for
+       * deserialization.
+       */
+      static inline unsigned serializeStrAlign4(char* buf, unsigned strLen, const char* strStart)
+      {
+         size_t bufPos = 0;
+
+         // write length field
+         bufPos += serializeUInt(&buf[bufPos], strLen);
+
+         // write raw string
+         memcpy(&buf[bufPos], strStart, strLen);
+         bufPos += strLen;
+
+         // write termination char
+         buf[bufPos] = 0;
+         bufPos++;
+
+         unsigned alignedLen = serialLenStrAlign4(strLen);
+
+         #ifdef BEEGFS_DEBUG
+            memset(&buf[bufPos], 0, alignedLen - bufPos); // bufPos == rawLen of serialLenStrAlign4()
+         #endif
+
+         return alignedLen;
+      }
+
+      /**
+       * Note: This doesn't copy the string, outStrStart points into buf and is zero-terminated.
+       *
+       * @return false on error (e.g. strLen is greater than bufLen)
+       */
+      static inline bool deserializeStrAlign4(const char* buf, size_t bufLen,
+         unsigned* outStrLen, const char** outStrStart, unsigned* outLen)
+      {
+         if(unlikely(bufLen < serialLenStrAlign4(0) ) )
+            goto err_log;
+
+         // length field
+         LITTLE_ENDIAN_TO_HOST_32(*(const unsigned*)buf, *outStrLen);
+
+         // string start
+         *outStrStart = &buf[serialLenUInt()];
+
+         // required outLen (incl alignment padding)
+         *outLen = serialLenStrAlign4(*outStrLen);
+
+         // check length (also catches overflow of huge length fields) and terminating zero
+         if(unlikely( (*outLen < *outStrLen) || (bufLen < *outLen) ||
+            ( (*outStrStart)[*outStrLen] != 0) ) )
+            goto err_log;
+
+         return true;
+
+      err_log:
+         logDeserializeStrAlign4Error(buf, bufLen);
+         return false;
+      }
+
+      /**
+       * This version deserializes into a std::string.
+       */
+      static inline bool deserializeStrAlign4(const char* buf, size_t bufLen,
+         std::string* outStr, unsigned* outBufLen)
+      {
+         unsigned strLen;
+         const char* strStart;
+
+         if(unlikely(!deserializeStrAlign4(buf, bufLen, &strLen, &strStart, outBufLen) ) )
+            return false;
+
+         outStr->assign(strStart, strLen);
+
+         return true;
+      }
+
+      static inline unsigned serialLenStrAlign4(unsigned strLen)
+      {
+         // strLenField + str + terminating zero, rounded up to the next multiple of 4
+         return (serialLenUInt() + strLen + 1 + 3) & ~3U;
+      }
+
+      // bulk (de)serialization of arrays of fixed-size integers
+
+      /**
+       * Serializes numValues integers in little-endian byte order. This is a plain memcpy on
+       * little-endian hosts, so that large arrays are copied with the vectorized memcpy of the libc
+       * instead of element by element.
+       *
+       * @return used buffer length
+       */
+      template<typename T>
+      static inline unsigned serializeArrayLE(char* buf, const T* values, size_t numValues)
+      {
+         #if BYTE_ORDER == BIG_ENDIAN
+            for(size_t i=0; i < numValues; i++)
+               storeLE(&buf[i * sizeof(T)], values[i]);
+         #else
+            if(numValues)
+               memcpy(buf, values, numValues * sizeof(T) );
+         #endif
+
+         return numValues * sizeof(T);
+      }
+
+      /**
+       * Counterpart of serializeArrayLE(). The caller must make sure that buf contains at least
+       * numValues elements.
+       */
+      template<typename T>
+      static inline void deserializeArrayLE(const char* buf, size_t numValues, T* outValues)
+      {
+         #if BYTE_ORDER == BIG_ENDIAN
+            for(size_t i=0; i < numValues; i++)
+               outValues[i] = loadLE<T>(&buf[i * sizeof(T)]);
+         #else
+            if(numValues)
+               memcpy(outValues, buf, numValues * sizeof(T) );
+         #endif
+      }
+
+      /**
+       * Store a single integer in little-endian byte order; buf doesn't need to be aligned.
+       */
+      template<typename T>
+      static inline void storeLE(char* buf, T value)
+      {
+         #if BYTE_ORDER == BIG_ENDIAN
+            value = byteswap(value);
+         #endif
+
+         memcpy(buf, &value, sizeof(T) );
+      }
+
+      /**
+       * Load a single little-endian integer; buf doesn't need to be aligned.
+       */
+      template<typename T>
+      static inline T loadLE(const char* buf)
+      {
+         T value;
+
+         memcpy(&value, buf, sizeof(T) );
+
+         #if BYTE_ORDER == BIG_ENDIAN
+            value = byteswap(value);
+         #endif
+
+         return value;
+      }
+
+      template<typename T>
+      static inline T byteswap(T value)
+      {
+         switch(sizeof(T) )
+         {
+            case 2: return (T)byteswap16(value);
+            case 4: return (T)byteswap32(value);
+            case 8: return (T)byteswap64(value);
+            default: return value;
+         }
+      }
+
+
+      /* lists and vectors of integers. the serialized format is:
+         <totalBufLen (uint)> <elemNum (uint)> <elements in little-endian byte order> */
+
+      template<typename T, typename Container>
+      static inline unsigned serializeFixedSizeContainer(char* buf, const Container* container)
+      {
+         unsigned elemNum = container->size();
+         unsigned requiredLen = serialLenFixedSizeContainer<T>(elemNum);
+
+         size_t bufPos = 0;
+
+         // totalBufLen info field
+         bufPos += serializeUInt(&buf[bufPos], requiredLen);
+
+         // elem count info field
+         bufPos += serializeUInt(&buf[bufPos], elemNum);
+
+         // store each element
+         for(typename Container::const_iterator iter = container->begin();
+             iter != container->end();
+             iter++, bufPos += sizeof(T) )
+            storeLE<T>(&buf[bufPos], *iter);
+
+         return requiredLen;
+      }
+
+      /**
+       * Vector version, copies all elements at once.
+       */
+      template<typename T, typename V>
+      static inline unsigned serializeFixedSizeContainer(char* buf, const std::vector<V>* vec)
+      {
+         unsigned elemNum = vec->size();
+         unsigned requiredLen = serialLenFixedSizeContainer<T>(elemNum);
+
+         size_t bufPos = 0;
+
+         // totalBufLen info field
+         bufPos += serializeUInt(&buf[bufPos], requiredLen);
+
+         // elem count info field
+         bufPos += serializeUInt(&buf[bufPos], elemNum);
+
+         if(elemNum)
+            serializeArrayLE<T>(&buf[bufPos], (const T*)&(*vec)[0], elemNum);
+
+         return requiredLen;
+      }
+
+      /**
+       * @return false on error or inconsistency
+       */
+      template<typename T>
+      static inline bool deserializeFixedSizeContainerPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outStart, unsigned* outLen)
+      {
+         const size_t headerLen = serialLenUInt() + serialLenUInt(); // bufLenField & numElemsField
+
+         if(unlikely(bufLen < headerLen) )
+            return false;
+
+         // totalBufLen info field
+         LITTLE_ENDIAN_TO_HOST_32(*(const unsigned*)buf, *outLen);
+
+         // elem count field
+         LITTLE_ENDIAN_TO_HOST_32(*(const unsigned*)&buf[serialLenUInt()], *outElemNum);
+
+         *outStart = &buf[headerLen];
+
+         if(unlikely(
+            (*outLen > bufLen) ||
+            (*outLen < headerLen) ||
+            ( (*outLen - headerLen) != ( (uint64_t)*outElemNum * sizeof(T) ) ) ) )
+            return false;
+
+         return true;
+      }
+
+      /**
+       * Appends the elements to outList.
+       * (requires pre-processing)
+       *
+       * @return false on error or inconsistency
+       */
+      template<typename T, typename V>
+      static inline bool deserializeFixedSizeContainer(unsigned bufLen, unsigned elemNum,
+         const char* start, std::list<V>* outList)
+      {
+         if(unlikely(bufLen < serialLenFixedSizeContainer<T>(elemNum) ) )
+            return false;
+
+         for(unsigned i=0; i < elemNum; i++)
+            outList->push_back(loadLE<T>(&start[i * sizeof(T)]) );
+
+         return true;
+      }
+
+      /**
+       * Appends the elements to outVec, copies all elements at once.
+       * (requires pre-processing)
+       *
+       * @return false on error or inconsistency
+       */
+      template<typename T, typename V>
+      static inline bool deserializeFixedSizeContainer(unsigned bufLen, unsigned elemNum,
+         const char* start, std::vector<V>* outVec)
+      {
+         if(unlikely(bufLen < serialLenFixedSizeContainer<T>(elemNum) ) )
+            return false;
+
+         if(!elemNum)
+            return true;
+
+         size_t oldSize = outVec->size();
+
+         outVec->resize(oldSize + elemNum);
+
+         deserializeArrayLE<T>(start, elemNum, (T*)&(*outVec)[oldSize]);
+
+         return true;
+      }
+
+      template<typename T>
+      static inline unsigned serialLenFixedSizeContainer(size_t elemNum)
+      {
+         // bufLen-field + numElems-field + numElems*elemSize
+         return serialLenUInt() + serialLenUInt() + elemNum * sizeof(T);
+      }
+
+      // UInt8List (de)serialization
+      static inline unsigned serializeUInt8List(char* buf, UInt8List* list)
+      {
+         return serializeFixedSizeContainer<uint8_t>(buf, list);
+      }
+
+      static inline bool deserializeUInt8ListPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outListStart, unsigned* outLen)
+      {
+         return deserializeFixedSizeContainerPreprocess<uint8_t>(buf, bufLen, outElemNum,
+            outListStart, outLen);
+      }
+
+      static inline bool deserializeUInt8List(unsigned listBufLen, unsigned elemNum,
+         const char* listStart, UInt8List* outList)
+      {
+         return deserializeFixedSizeContainer<uint8_t>(listBufLen, elemNum, listStart, outList);
+      }
+
+      static inline unsigned serialLenUInt8List(UInt8List* list)
+      {
+         return serialLenFixedSizeContainer<uint8_t>(list->size() );
+      }
+
+      static inline unsigned serialLenUInt8List(size_t size)
+      {
+         return serialLenFixedSizeContainer<uint8_t>(size);
+      }
+
+      // UInt16List (de)serialization
+      static inline unsigned serializeUInt16List(char* buf, UInt16List* list)
+      {
+         return serializeFixedSizeContainer<uint16_t>(buf, list);
+      }
+
+      static inline bool deserializeUInt16ListPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outListStart, unsigned* outLen)
+      {
+         return deserializeFixedSizeContainerPreprocess<uint16_t>(buf, bufLen, outElemNum,
+            outListStart, outLen);
+      }
+
+      static inline bool deserializeUInt16List(unsigned listBufLen, unsigned elemNum,
+         const char* listStart, UInt16List* outList)
+      {
+         return deserializeFixedSizeContainer<uint16_t>(listBufLen, elemNum, listStart, outList);
+      }
+
+      static inline unsigned serialLenUInt16List(UInt16List* list)
+      {
+         return serialLenFixedSizeContainer<uint16_t>(list->size() );
+      }
+
+      static inline unsigned serialLenUInt16List(size_t size)
+      {
+         return serialLenFixedSizeContainer<uint16_t>(size);
+      }
+
+      // UInt16Vector (de)serialization
+      static inline unsigned serializeUInt16Vector(char* buf, UInt16Vector* vec)
+      {
+         return serializeFixedSizeContainer<uint16_t>(buf, vec);
+      }
+
+      static inline bool deserializeUInt16VectorPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outVecStart, unsigned* outLen)
+      {
+         return deserializeFixedSizeContainerPreprocess<uint16_t>(buf, bufLen, outElemNum,
+            outVecStart, outLen);
+      }
+
+      static inline bool deserializeUInt16Vector(unsigned vecBufLen, unsigned elemNum,
+         const char* vecStart, UInt16Vector* outVec)
+      {
+         return deserializeFixedSizeContainer<uint16_t>(vecBufLen, elemNum, vecStart, outVec);
+      }
+
+      static inline unsigned serialLenUInt16Vector(UInt16Vector* vec)
+      {
+         return serialLenFixedSizeContainer<uint16_t>(vec->size() );
+      }
+
+      static inline unsigned serialLenUInt16Vector(size_t size)
+      {
+         return serialLenFixedSizeContainer<uint16_t>(size);
+      }
+
+      // UShortVector (de)serialization
+      static inline unsigned serializeUShortVector(char* buf, UShortVector* vec)
+      {
+         return serializeFixedSizeContainer<uint16_t>(buf, vec);
+      }
+
+      static inline bool deserializeUShortVectorPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outVecStart, unsigned* outLen)
+      {
+         return deserializeFixedSizeContainerPreprocess<uint16_t>(buf, bufLen, outElemNum,
+            outVecStart, outLen);
+      }
+
+      static inline bool deserializeUShortVector(unsigned vecBufLen, unsigned elemNum,
+         const char* vecStart, UShortVector* outVec)
+      {
+         return deserializeFixedSizeContainer<uint16_t>(vecBufLen, elemNum, vecStart, outVec);
+      }
+
+      static inline unsigned serialLenUShortVector(UShortVector* vec)
+      {
+         return serialLenFixedSizeContainer<uint16_t>(vec->size() );
+      }
+
+      // IntList (de)serialization
+      static inline unsigned serializeIntList(char* buf, IntList* list)
+      {
+         return serializeFixedSizeContainer<int>(buf, list);
+      }
+
+      static inline bool deserializeIntListPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outListStart, unsigned* outLen)
+      {
+         return deserializeFixedSizeContainerPreprocess<int>(buf, bufLen, outElemNum,
+            outListStart, outLen);
+      }
+
+      static inline bool deserializeIntList(unsigned listBufLen, unsigned elemNum,
+         const char* listStart, IntList* outList)
+      {
+         return deserializeFixedSizeContainer<int>(listBufLen, elemNum, listStart, outList);
+      }
+
+      static inline unsigned serialLenIntList(IntList* list)
+      {
+         return serialLenFixedSizeContainer<int>(list->size() );
+      }
+
+      // IntVector (de)serialization
+      static inline unsigned serializeIntVector(char* buf, IntVector* vec)
+      {
+         return serializeFixedSizeContainer<int>(buf, vec);
+      }
+
+      static inline bool deserializeIntVectorPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outVecStart, unsigned* outLen)
+      {
+         return deserializeFixedSizeContainerPreprocess<int>(buf, bufLen, outElemNum,
+            outVecStart, outLen);
+      }
+
+      static inline bool deserializeIntVector(unsigned vecBufLen, unsigned elemNum,
+         const char* vecStart, IntVector* outVec)
+      {
+         return deserializeFixedSizeContainer<int>(vecBufLen, elemNum, vecStart, outVec);
+      }
+
+      static inline unsigned serialLenIntVector(IntVector* vec)
+      {
+         return serialLenFixedSizeContainer<int>(vec->size() );
+      }
+
+      // UIntList (de)serialization
+      static inline unsigned serializeUIntList(char* buf, UIntList* list)
+      {
+         return serializeFixedSizeContainer<unsigned>(buf, list);
+      }
+
+      static inline bool deserializeUIntListPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outListStart, unsigned* outLen)
+      {
+         return deserializeFixedSizeContainerPreprocess<unsigned>(buf, bufLen, outElemNum,
+            outListStart, outLen);
+      }
+
+      static inline bool deserializeUIntList(unsigned listBufLen, unsigned elemNum,
+         const char* listStart, UIntList* outList)
+      {
+         return deserializeFixedSizeContainer<unsigned>(listBufLen, elemNum, listStart, outList);
+      }
+
+      static inline unsigned serialLenUIntList(UIntList* list)
+      {
+         return serialLenFixedSizeContainer<unsigned>(list->size() );
+      }
+
+      static inline unsigned serialLenUIntList(size_t size)
+      {
+         return serialLenFixedSizeContainer<unsigned>(size);
+      }
+
+      // UIntVector (de)serialization
+      static inline unsigned serializeUIntVector(char* buf, UIntVector* vec)
+      {
+         return serializeFixedSizeContainer<unsigned>(buf, vec);
+      }
+
+      static inline bool deserializeUIntVectorPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outVecStart, unsigned* outLen)
+      {
+         return deserializeFixedSizeContainerPreprocess<unsigned>(buf, bufLen, outElemNum,
+            outVecStart, outLen);
+      }
+
+      static inline bool deserializeUIntVector(unsigned vecBufLen, unsigned elemNum,
+         const char* vecStart, UIntVector* outVec)
+      {
+         return deserializeFixedSizeContainer<unsigned>(vecBufLen, elemNum, vecStart, outVec);
+      }
+
+      static inline unsigned serialLenUIntVector(UIntVector* vec)
+      {
+         return serialLenFixedSizeContainer<unsigned>(vec->size() );
+      }
+
+      static inline unsigned serialLenUIntVector(size_t size)
+      {
+         return serialLenFixedSizeContainer<unsigned>(size);
+      }
+
+      // Int64List (de)serialization
+      static inline unsigned serializeInt64List(char* buf, Int64List* list)
+      {
+         return serializeFixedSizeContainer<int64_t>(buf, list);
+      }
+
+      static inline bool deserializeInt64ListPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outListStart, unsigned* outLen)
+      {
+         return deserializeFixedSizeContainerPreprocess<int64_t>(buf, bufLen, outElemNum,
+            outListStart, outLen);
+      }
+
+      static inline bool deserializeInt64List(unsigned listBufLen, unsigned elemNum,
+         const char* listStart, Int64List* outList)
+      {
+         return deserializeFixedSizeContainer<int64_t>(listBufLen, elemNum, listStart, outList);
+      }
+
+      static inline unsigned serialLenInt64List(Int64List* list)
+      {
+         return serialLenFixedSizeContainer<int64_t>(list->size() );
+      }
+
+      static inline unsigned serialLenInt64List(size_t size)
+      {
+         return serialLenFixedSizeContainer<int64_t>(size);
+      }
+
+      // Int64Vector (de)serialization
+      static inline unsigned serializeInt64Vector(char* buf, Int64Vector* vec)
+      {
+         return serializeFixedSizeContainer<int64_t>(buf, vec);
+      }
+
+      static inline bool deserializeInt64VectorPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outVecStart, unsigned* outLen)
+      {
+         return deserializeFixedSizeContainerPreprocess<int64_t>(buf, bufLen, outElemNum,
+            outVecStart, outLen);
+      }
+
+      static inline bool deserializeInt64Vector(unsigned vecBufLen, unsigned elemNum,
+         const char* vecStart, Int64Vector* outVec)
+      {
+         return deserializeFixedSizeContainer<int64_t>(vecBufLen, elemNum, vecStart, outVec);
+      }
+
+      static inline unsigned serialLenInt64Vector(Int64Vector* vec)
+      {
+         return serialLenFixedSizeContainer<int64_t>(vec->size() );
+      }
+
+      // UInt64List (de)serialization
+      static inline unsigned serializeUInt64List(char* buf, const UInt64List* list)
+      {
+         return serializeFixedSizeContainer<uint64_t>(buf, list);
+      }
+
+      static inline bool deserializeUInt64ListPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outListStart, unsigned* outLen)
+      {
+         return deserializeFixedSizeContainerPreprocess<uint64_t>(buf, bufLen, outElemNum,
+            outListStart, outLen);
+      }
+
+      static inline bool deserializeUInt64List(unsigned listBufLen, unsigned elemNum,
+         const char* listStart, UInt64List* outList)
+      {
+         return deserializeFixedSizeContainer<uint64_t>(listBufLen, elemNum, listStart, outList);
+      }
+
+      static inline unsigned serialLenUInt64List(const UInt64List* list)
+      {
+         return serialLenFixedSizeContainer<uint64_t>(list->size() );
+      }
+
+      static inline unsigned serialLenUInt64List(size_t size)
+      {
+         return serialLenFixedSizeContainer<uint64_t>(size);
+      }
+
+      // UInt64Vector (de)serialization
+      static inline unsigned serializeUInt64Vector(char* buf, const UInt64Vector* vec)
+      {
+         return serializeFixedSizeContainer<uint64_t>(buf, vec);
+      }
+
+      static inline bool deserializeUInt64VectorPreprocess(const char* buf, size_t bufLen,
+         unsigned* outElemNum, const char** outVecStart, unsigned* outLen)
+      {
+         return deserializeFixedSizeContainerPreprocess<uint64_t>(buf, bufLen, outElemNum,
+            outVecStart, outLen);
+      }
+
+      static inline bool deserializeUInt64Vector(unsigned vecBufLen, unsigned elemNum,
+         const char* vecStart, UInt64Vector* outVec)
+      {
+         return deserializeFixedSizeContainer<uint64_t>(vecBufLen, elemNum, vecStart, outVec);
+      }
+
+      static inline unsigned serialLenUInt64Vector(const UInt64Vector* vec)
+      {
+         return serialLenFixedSizeContainer<uint64_t>(vec->size() );
+      }
+
+      static inline unsigned serialLenUInt64Vector(size_t size)
+      {
+         return serialLenFixedSizeContainer<uint64_t>(size);
+      }
+
       static inline uint32_t htonlTrans(uint32_t value)
       {
          return htonl(value);
@@ -90,7 +90,7 @@ class SerializationFsck
 
          for ( unsigned i = 0; i < listSize; i++, iter++ )
          {
-            FsckObject element = *iter;
+            FsckObject& element = *iter;
 
             bufPos += element.serialize(&buf[bufPos]);
          }
@@ -117,7 +117,7 @@ class SerializationFsck
 
          for ( unsigned i = 0; i < listSize; i++, iter++ )
          {
-            FsckObject element = *iter;
+            FsckObject& element = *iter;
 
             bufPos += element.serialLen();
          }
@@ -180,15 +180,57 @@ class SerializationFsck
 
          for(unsigned i=0; i < listElemNum; i++)
          {
-            FsckObject element;
+            // (deserialize in place to avoid copying all the strings of the object)
+            outList->push_back(FsckObject() );
+
+            FsckObject& element = outList->back();
             unsigned elementLen;
 
             element.deserialize(&buf[bufPos], bufLen-bufPos, &elementLen);
 
             bufPos += elementLen;
+         }
+      }
+
+      /**
+       * Deserializes a Fsck...-object list in a single pass, i.e. without the pre-processing,
+       * which has to deserialize every element once just to find the end of the list.
+       *
+       * @param outList elements are appended (in place)
+       * @return false on error or inconsistency
+       */
+      template <typename FsckObject>
+      static bool deserializeFsckObjectList(const char* buf, size_t bufLen,
+         std::list<FsckObject>* outList, unsigned* outLen)
+      {
+         size_t bufPos = 0;
 
-            outList->push_back(element);
+         // elem count info field
+         unsigned elemNum;
+         unsigned elemNumFieldLen;
+
+         if ( unlikely(!Serialization::deserializeUInt(&buf[bufPos], bufLen-bufPos, &elemNum,
+               &elemNumFieldLen) ) )
+            return false;
+
+         bufPos += elemNumFieldLen;
+
+         for(unsigned i=0; i < elemNum; i++)
+         {
+            outList->push_back(FsckObject() );
+
+            FsckObject& element = outList->back();
+            unsigned elementLen;
+
+            if (unlikely(!element.deserialize(&buf[bufPos], bufLen-bufPos, &elementLen) ) )
+               return false;
+
+            bufPos += elementLen;
          }
+
+         *outLen = bufPos;
+
+         return true;
       }
 };
 
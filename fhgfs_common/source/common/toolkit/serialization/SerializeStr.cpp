@@ -7,205 +7,36 @@
 #include "Serialization.h"
 
 
-// =========== strings ===========
-
-/**
- * @return 0 on error (e.g. strLen is greater than bufLen), used buffer size otherwise
- */
-unsigned Serialization::serializeStr(char* buf, unsigned strLen, const char* strStart)
-{
-   size_t bufPos = 0;
-
-   // write length field
-   bufPos += serializeUInt(&buf[bufPos], strLen);
-
-   // write raw string
-   memcpy(&buf[bufPos], strStart, strLen);
-   bufPos += strLen;
-
-   // write termination char
-   buf[bufPos] = 0;
-
-   return serialLenStr(strLen);
-}
-
-/**
- * @return false on error (e.g. strLen is greater than bufLen)
- */
-bool Serialization::deserializeStr(const char* buf, size_t bufLen,
-   unsigned* outStrLen, const char** outStrStart, unsigned* outLen)
-{
-   // check min length
-   if(unlikely(bufLen < serialLenStr(0) ) )
-      return false;
-
-   size_t bufPos = 0;
-
-   // length field
-   unsigned strLenFieldLen = 0;
-   deserializeUInt(&buf[bufPos], bufLen-bufPos, outStrLen, &strLenFieldLen);
-   bufPos += strLenFieldLen;
-
-   // string start
-   *outStrStart = &buf[bufPos];
-   bufPos += *outStrLen;
-
-   // required outLen
-   *outLen = serialLenStr(*outStrLen);
-
-   // check length and terminating zero
-   if(unlikely( (bufLen < (*outLen) ) || ( (*outStrStart)[*outStrLen] != 0) ) )
-      return false;
-
-   return true;
-}
-
-/**
- * This version deserializes into a std::string.
- */
-bool Serialization::deserializeStr(const char* buf, size_t bufLen,
-   std::string* outStr, unsigned* outBufLen)
-{
-   unsigned strLen = 0; // just mute compiler warnings on sl5
-   const char* strStart = buf; // just mute compiler warnings on sl5;
-
-   bool deserRes = Serialization::deserializeStr(buf, bufLen,
-         &strLen, &strStart, outBufLen);
-   if(unlikely(!deserRes) )
-      return false;
-
-   outStr->reserve(strLen);
-   outStr->assign(strStart, strLen);
-
-   return true;
-}
-
-unsigned Serialization::serialLenStr(unsigned strLen)
-{
-   // strLenField + str + terminating zero
-   return serialLenUInt() + strLen + 1;
-}
-
-
-
 // =========== strings with 4-byte aligned padding ===========
 
-
 /**
- * Note: Adds padding to achieve 4-byte alignment. Requires calling deserializeStrAlign4 for
- * deserialization.
- *
- * @return 0 on error (e.g. strLen is greater than bufLen), used buffer size otherwise
+ * Logs why deserializeStrAlign4() failed (out of line, because it's only needed for broken
+ * messages).
  */
-unsigned Serialization::serializeStrAlign4(char* buf, unsigned strLen, const char* strStart)
-{
-   size_t bufPos = 0;
-
-   // write length field
-   bufPos += serializeUInt(&buf[bufPos], strLen);
-
-   // write raw string
-   memcpy(&buf[bufPos], strStart, strLen);
-   bufPos += strLen;
-
-   // write termination char
-   buf[bufPos] = 0;
-   bufPos++;
-
-   unsigned alignedLen = serialLenStrAlign4(strLen);
-
-   #ifdef BEEGFS_DEBUG
-      unsigned zeroLen = alignedLen - bufPos; // bufPos == rawLen of serialLenStrAlign4()
-      if (zeroLen)
-      {
-         memset(&buf[bufPos], 0, zeroLen);
-         bufPos += zeroLen;
-      }
-   #endif
-
-   return alignedLen;
-
-}
-
-/**
- * @return false on error (e.g. strLen is greater than bufLen)
- */
-bool Serialization::deserializeStrAlign4(const char* buf, size_t bufLen,
-   unsigned* outStrLen, const char** outStrStart, unsigned* outLen)
+void Serialization::logDeserializeStrAlign4Error(const char* buf, size_t bufLen)
 {
    const char* logContext = "Deserialize String (align4)";
 
-   // check min length
-   if(unlikely(bufLen < serialLenStrAlign4(0) ) )
+   if(bufLen < serialLenStrAlign4(0) )
    {
       LogContext(logContext).logErr("Error: bufLen smaller than minimum");
-      return false;
-   }
-
-   size_t bufPos = 0;
-
-   { // length field
-      unsigned strLenFieldLen = 0;
-      deserializeUInt(&buf[bufPos], bufLen-bufPos, outStrLen, &strLenFieldLen);
-      bufPos += strLenFieldLen;
+      return;
    }
 
-   { // string start
-      *outStrStart = &buf[bufPos];
-      bufPos += *outStrLen;
-   }
+   unsigned strLen;
+   LITTLE_ENDIAN_TO_HOST_32(*(const unsigned*)buf, strLen);
 
-   { // required outLen (incl alignment padding)
-      *outLen = serialLenStrAlign4(*outStrLen);
-   }
+   unsigned outLen = serialLenStrAlign4(strLen);
 
-   // check length
-   if(unlikely(bufLen < (*outLen) ) )
+   if( (outLen < strLen) || (bufLen < outLen) )
    {
       LogContext(logContext).logErr("Error: bufLen smaller than serialization length. " +
          std::string("bufLen: ")  + StringTk::uintToStr((unsigned) bufLen) +
-         std::string(" outLen: ") + StringTk::uintToStr(*outLen) );
-      return false;
-   }
-
-   // check terminating zero
-   if (unlikely( (*outStrStart)[*outStrLen] != 0 ) )
-   {
-      LogContext(logContext).logErr("Error: String not terminated");
-      return false;
+         std::string(" outLen: ") + StringTk::uintToStr(outLen) );
+      return;
    }
 
-   return true;
-}
-
-/**
- * This version deserializes into a std::string.
- */
-bool Serialization::deserializeStrAlign4(const char* buf, size_t bufLen,
-   std::string* outStr, unsigned* outBufLen)
-{
-   unsigned strLen;
-   const char* strStart;
-
-   bool deserRes = Serialization::deserializeStrAlign4(buf, bufLen,
-         &strLen, &strStart, outBufLen);
-   if(unlikely(!deserRes) )
-      return false;
-
-   outStr->reserve(strLen);
-   outStr->assign(strStart, strLen);
-
-   return true;
-}
-
-unsigned Serialization::serialLenStrAlign4(unsigned strLen)
-{
-   // strLenField + str + terminating zero
-   unsigned rawLen = serialLenUInt() + strLen + 1;
-   unsigned remainder = rawLen % 4;
-   unsigned alignedLen = remainder ? (rawLen + 4 - remainder) : rawLen;
-
-   return alignedLen;
+   LogContext(logContext).logErr("Error: String not terminated");
 }
 
 
@@ -309,11 +140,13 @@ bool Serialization::deserializeStringList(unsigned listBufLen, unsigned elemNum,
    unsigned i=0;
    for( ; (i < elemNum) && (currentPos <= listEndPos); i++, currentPos += lastElemLen)
    {
-      std::string currentElem(currentPos);
+      unsigned currentElemLen = strlen(currentPos);
 
-      outList->push_back(currentElem);
+      // (construct the element in place to avoid a temporary copy of the string)
+      outList->push_back(std::string() );
+      outList->back().assign(currentPos, currentElemLen);
 
-      lastElemLen = currentElem.size() + 1; // +1 for the terminating zero
+      lastElemLen = currentElemLen + 1; // +1 for the terminating zero
    }
 
    // check whether all of the elements were read (=consistency)
@@ -422,11 +255,13 @@ bool Serialization::deserializeStringVec(unsigned listBufLen, unsigned elemNum,
    unsigned i=0;
    for( ; (i < elemNum) && (currentPos <= listEndPos); i++, currentPos += lastElemLen)
    {
-      std::string currentElem(currentPos);
+      unsigned currentElemLen = strlen(currentPos);
 
-      outVec->push_back(currentElem);
+      // (construct the element in place to avoid a temporary copy of the string)
+      outVec->push_back(std::string() );
+      outVec->back().assign(currentPos, currentElemLen);
 
-      lastElemLen = currentElem.size() + 1; // +1 for the terminating zero
+      lastElemLen = currentElemLen + 1; // +1 for the terminating zero
    }
 
    // check whether all of the elements were read (=consistency)
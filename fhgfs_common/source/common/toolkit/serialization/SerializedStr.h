@@ -0,0 +1,174 @@
+/*
+ * Zero-copy access to serialized strings and string lists.
+ *
+ * The classes in here only point into the buffer that a message was deserialized from, so they
+ * must not be used after that buffer was freed.
+ */
+
+#ifndef SERIALIZEDSTR_H_
+#define SERIALIZEDSTR_H_
+
+#include <common/Common.h>
+
+#include <string.h>
+
+
+/**
+ * A zero-terminated string inside a (receive) buffer, i.e. a lightweight replacement for a
+ * std::string copy if the string is only compared or handed on.
+ */
+class SerializedStr
+{
+   public:
+      SerializedStr() : start(""), len(0)
+      {
+      }
+
+      /**
+       * @param start must be zero-terminated at start[len]
+       */
+      SerializedStr(const char* start, unsigned len) : start(start), len(len)
+      {
+      }
+
+
+   private:
+      const char* start;
+      unsigned len;
+
+
+   public:
+      // getters & setters
+
+      /**
+       * @return zero-terminated string
+       */
+      const char* c_str() const
+      {
+         return start;
+      }
+
+      unsigned length() const
+      {
+         return len;
+      }
+
+      bool empty() const
+      {
+         return !len;
+      }
+
+      /**
+       * Create an owned copy of the string.
+       */
+      std::string str() const
+      {
+         return std::string(start, len);
+      }
+
+      void assignTo(std::string* outStr) const
+      {
+         outStr->assign(start, len);
+      }
+
+      bool operator==(const std::string& other) const
+      {
+         return (other.length() == len) && !memcmp(other.data(), start, len);
+      }
+
+      bool operator!=(const std::string& other) const
+      {
+         return !(*this == other);
+      }
+};
+
+
+/**
+ * Iterates over the elements of a serialized StringList/StringVector/StringSet (i.e. a sequence
+ * of zero-terminated strings) without copying them.
+ *
+ * Note: Requires the list to be pre-processed (see Serialization::deserializeStringListPreprocess
+ * and friends).
+ */
+class SerializedStrList
+{
+   public:
+      SerializedStrList() : elemNum(0), listStart(NULL), listEnd(NULL)
+      {
+      }
+
+      /**
+       * @param listBufLen total serialized length, as returned by the preprocessing
+       * @param elemNum number of elements, as returned by the preprocessing
+       * @param listStart start of first element, as returned by the preprocessing
+       */
+      SerializedStrList(unsigned listBufLen, unsigned elemNum, const char* listStart) :
+         elemNum(elemNum), listStart(listStart),
+         listEnd(listStart + listBufLen - 2*sizeof(unsigned) ) // bufLenField & numElemsField
+      {
+      }
+
+
+      class Iter
+      {
+         friend class SerializedStrList;
+
+         public:
+            Iter() : pos(NULL), end(NULL), remaining(0)
+            {
+            }
+
+         private:
+            Iter(const char* pos, const char* end, unsigned remaining) :
+               pos(pos), end(end), remaining(remaining)
+            {
+            }
+
+            const char* pos;
+            const char* end;
+            unsigned remaining;
+
+         public:
+            /**
+             * @param outStr the next element
+             * @return false if there are no more elements or if the list is inconsistent
+             */
+            bool next(SerializedStr* outStr)
+            {
+               if(unlikely(!remaining || (pos >= end) ) )
+                  return false;
+
+               // the preprocessing made sure that the last element is zero-terminated
+               unsigned len = strlen(pos);
+
+               *outStr = SerializedStr(pos, len);
+
+               pos += len + 1; // +1 for the terminating zero
+               remaining--;
+
+               return true;
+            }
+      };
+
+
+   private:
+      unsigned elemNum;
+      const char* listStart;
+      const char* listEnd;
+
+
+   public:
+      // getters & setters
+
+      Iter begin() const
+      {
+         return Iter(listStart, listEnd, elemNum);
+      }
+
+      unsigned size() const
+      {
+         return elemNum;
+      }
+};
+
+#endif /* SERIALIZEDSTR_H_ */
@@ -82,6 +82,8 @@ void Config::loadDefaults(bool addDashes)
    configMapRedefine("tunePreferredNodesFile", "", addDashes);
    configMapRedefine("tuneDbFragmentSize", "0", addDashes);
    configMapRedefine("tuneDentryCacheSize", "0", addDashes);
+   configMapRedefine("tuneDbSortThreads", "0", addDashes);
+   configMapRedefine("tuneDbSortMemory", "0", addDashes);
 
    configMapRedefine("sysForcedRoot", "0", addDashes);
 
@@ -168,6 +170,12 @@ void Config::applyConfigMap(bool enableException, bool addDashes) throw (Invalid
       if(testConfigMapKeyMatch(iter, "tuneDentryCacheSize", addDashes) )
          tuneDentryCacheSize = StringTk::strToUInt64(iter->second.c_str() );
       else
+      if(testConfigMapKeyMatch(iter, "tuneDbSortThreads", addDashes) )
+         tuneDbSortThreads = StringTk::strToUInt(iter->second);
+      else
+      if(testConfigMapKeyMatch(iter, "tuneDbSortMemory", addDashes) )
+         tuneDbSortMemory = StringTk::strToUInt64(iter->second.c_str() );
+      else
       IGNORE_CONFIG_CLIENT_VALUE("tuneFileCacheType")
       IGNORE_CONFIG_CLIENT_VALUE("tunePagedIOBufSize")
       IGNORE_CONFIG_CLIENT_VALUE("tunePagedIOBufNum")
@@ -292,6 +300,13 @@ void Config::initImplicitVals() throw (InvalidConfigException)
    if (!tuneDentryCacheSize)
       tuneDentryCacheSize = tuneDbFragmentSize / 384;
 
+   if (!tuneDbSortThreads)
+      tuneDbSortThreads = System::getNumOnlineCPUs();
+
+   // (one fragment fits by default, larger fragments are sorted in runs, see SetFragment::sort() )
+   if (!tuneDbSortMemory)
+      tuneDbSortMemory = tuneDbFragmentSize;
+
    // connAuthHash
    AbstractConfig::initConnAuthHash(connAuthFile, &connAuthHash);
 }
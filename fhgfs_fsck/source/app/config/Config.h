@@ -56,6 +56,8 @@ class Config : public AbstractConfig
       std::string tunePreferredNodesFile;
       size_t      tuneDbFragmentSize;
       size_t      tuneDentryCacheSize;
+      unsigned    tuneDbSortThreads;
+      size_t      tuneDbSortMemory;
 
       uint16_t    sysForcedRoot;
 
@@ -147,6 +149,16 @@ class Config : public AbstractConfig
          return tuneDentryCacheSize;
       }
 
+      unsigned getTuneDbSortThreads() const
+      {
+         return tuneDbSortThreads;
+      }
+
+      size_t getTuneDbSortMemory() const
+      {
+         return tuneDbSortMemory;
+      }
+
       std::string getTunePreferredNodesFile() const
       {
          return tunePreferredNodesFile;
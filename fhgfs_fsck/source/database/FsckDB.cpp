@@ -5,6 +5,7 @@
 #include <common/toolkit/StringTk.h>
 #include <database/FsckDBException.h>
 #include <database/FsckDBTable.h>
+#include <database/Parallel.h>
 #include <toolkit/FsckTkEx.h>
 
 #include <cstdio>
@@ -38,3 +39,50 @@ void FsckDB::clear()
    this->modificationEventsTable->clear();
    this->malformedChunks.clear();
 }
+
+namespace {
+
+template<typename TableT>
+class CommitTableJob : public db::JobGroup::Job
+{
+   public:
+      CommitTableJob(TableT* table)
+         : table(table)
+      {}
+
+      void run()
+      {
+         table->commitChanges();
+      }
+
+   private:
+      TableT* table;
+};
+
+template<typename TableT>
+db::JobGroup::Job* commitTableJob(TableT* table)
+{
+   return new CommitTableJob<TableT>(table);
+}
+
+}
+
+/*
+ * commits pending changes of all tables and sorts them. the tables are independent of each other,
+ * so this is done concurrently; the checks will afterwards only stream over sorted sets.
+ */
+void FsckDB::commitChanges()
+{
+   db::JobGroup jobs(db::SortResources::get().getNumThreads() );
+
+   jobs.add(commitTableJob(this->dentryTable.get() ) );
+   jobs.add(commitTableJob(this->fileInodesTable.get() ) );
+   jobs.add(commitTableJob(this->dirInodesTable.get() ) );
+   jobs.add(commitTableJob(this->chunksTable.get() ) );
+   jobs.add(commitTableJob(this->contDirsTable.get() ) );
+   jobs.add(commitTableJob(this->fsIDsTable.get() ) );
+   jobs.add(commitTableJob(this->usedTargetIDsTable.get() ) );
+   jobs.add(commitTableJob(this->modificationEventsTable.get() ) );
+
+   jobs.run();
+}
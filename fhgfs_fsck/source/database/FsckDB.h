@@ -65,6 +65,7 @@ class FsckDB
          bool allowCreate);
 
       void clear();
+      void commitChanges();
 
       // FsckDBChecks.cpp
       Cursor<std::pair<db::EntryID, std::set<uint32_t> > > findDuplicateInodeIDs();
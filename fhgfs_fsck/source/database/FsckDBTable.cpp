@@ -144,6 +144,12 @@ std::string FsckDBDentryTable::getPathOf(const db::DirEntry& dentry)
    return getNameOf(parent) + "/" + result;
 }
 
+void FsckDBDentryTable::commitChanges()
+{
+   this->table.commitChanges();
+   this->byParent.commitChanges();
+}
+
 
 
 void FsckDBFileInodesTable::insert(FsckFileInodeList& fileInodes, const BulkHandle* handle)
@@ -264,6 +270,12 @@ std::pair<bool, db::FileInode> FsckDBFileInodesTable::get(std::string id)
    return this->inodes.getByKey(db::EntryID::fromStr(id) );
 }
 
+void FsckDBFileInodesTable::commitChanges()
+{
+   this->inodes.commitChanges();
+   this->targets.commitChanges();
+}
+
 
 
 void FsckDBDirInodesTable::insert(FsckDirInodeList& dirInodes, const BulkHandle* handle)
@@ -321,6 +333,11 @@ std::pair<bool, FsckDirInode> FsckDBDirInodesTable::get(std::string id)
    return this->table.getByKey(db::EntryID::fromStr(id) );
 }
 
+void FsckDBDirInodesTable::commitChanges()
+{
+   this->table.commitChanges();
+}
+
 
 
 static db::Chunk fsckChunkToDbChunk(FsckChunk& chunk)
@@ -372,6 +389,11 @@ Table<db::Chunk>::QueryType FsckDBChunksTable::get()
    return this->table.cursor();
 }
 
+void FsckDBChunksTable::commitChanges()
+{
+   this->table.commitChanges();
+}
+
 
 
 static db::ContDir fsckContDirToDbContDir(FsckContDir& contDir)
@@ -397,6 +419,11 @@ Table<db::ContDir>::QueryType FsckDBContDirsTable::get()
    return this->table.cursor();
 }
 
+void FsckDBContDirsTable::commitChanges()
+{
+   this->table.commitChanges();
+}
+
 
 
 static db::FsID fsckFsIDToDbFsID(FsckFsID& id)
@@ -433,6 +460,11 @@ Table<db::FsID>::QueryType FsckDBFsIDsTable::get()
    return this->table.cursor();
 }
 
+void FsckDBFsIDsTable::commitChanges()
+{
+   this->table.commitChanges();
+}
+
 
 
 void FsckDBUsedTargetIDsTable::insert(FsckTargetIDList& targetIDs, const BulkHandle& handle)
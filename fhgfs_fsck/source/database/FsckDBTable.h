@@ -152,6 +152,8 @@ class FsckDBDentryTable
       std::string getNameOf(const db::DirEntry& dentry);
       std::string getPathOf(const db::DirEntry& dentry);
 
+      void commitChanges();
+
    private:
       std::string dbPath;
       Table<db::DirEntry> table;
@@ -327,6 +329,8 @@ class FsckDBFileInodesTable
 
       std::pair<bool, db::FileInode> get(std::string id);
 
+      void commitChanges();
+
    private:
       Table<db::FileInode> inodes;
       Table<db::StripeTargets, true> targets;
@@ -379,6 +383,8 @@ class FsckDBDirInodesTable
       Table<db::DirInode>::QueryType get();
       std::pair<bool, FsckDirInode> get(std::string id);
 
+      void commitChanges();
+
    private:
       Table<db::DirInode> table;
 
@@ -421,6 +427,8 @@ class FsckDBChunksTable
 
       Table<db::Chunk>::QueryType get();
 
+      void commitChanges();
+
    private:
       Table<db::Chunk> table;
 
@@ -461,6 +469,8 @@ class FsckDBContDirsTable
 
       Table<db::ContDir>::QueryType get();
 
+      void commitChanges();
+
    private:
       Table<db::ContDir> table;
 
@@ -502,6 +512,8 @@ class FsckDBFsIDsTable
 
       Table<db::FsID>::QueryType get();
 
+      void commitChanges();
+
    private:
       Table<db::FsID> table;
 
@@ -563,6 +575,12 @@ class FsckUniqueTable
       }
 
       SetFragmentCursor<Data> get()
+      {
+         commitChanges();
+         return set.cursor();
+      }
+
+      void commitChanges()
       {
          if(!bulkHandles.empty() )
          {
@@ -576,7 +594,7 @@ class FsckUniqueTable
             set.makeUnique();
          }
 
-         return set.cursor();
+         set.sort();
       }
 };
 
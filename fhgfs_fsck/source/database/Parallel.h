@@ -0,0 +1,269 @@
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <common/threading/Condition.h>
+#include <common/threading/Mutex.h>
+#include <common/threading/PThread.h>
+#include <common/threading/SafeMutexLock.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace db {
+
+/*
+ * process-wide limits for sorting database sets. all in-memory fragment sorts draw from the same
+ * memory budget and the same number of sort threads, so sorting several sets (or several fragments
+ * of one set) concurrently does not multiply the memory footprint or the number of busy cores.
+ */
+class SortResources
+{
+   public:
+      static SortResources& get()
+      {
+         static SortResources instance;
+         return instance;
+      }
+
+      /**
+       * @param numThreads max number of threads that sort in memory at the same time
+       * @param memoryBudget max number of bytes held in memory by sorts, 0 for unlimited
+       */
+      void configure(unsigned numThreads, size_t memoryBudget)
+      {
+         SafeMutexLock lock(&mutex); // L O C K
+
+         this->numThreads = numThreads ? numThreads : 1;
+         this->memoryBudget = memoryBudget;
+
+         lock.unlock(); // U N L O C K
+      }
+
+      unsigned getNumThreads()
+      {
+         SafeMutexLock lock(&mutex); // L O C K
+
+         unsigned result = numThreads;
+
+         lock.unlock(); // U N L O C K
+
+         return result;
+      }
+
+      size_t getMemoryBudget()
+      {
+         SafeMutexLock lock(&mutex); // L O C K
+
+         size_t result = memoryBudget;
+
+         lock.unlock(); // U N L O C K
+
+         return result;
+      }
+
+      /**
+       * waits until the given amount of memory fits into the budget and reserves up to maxThreads
+       * sort threads. a request larger than the whole budget is granted once no other sort holds
+       * memory (fragment sorts split their data so that this does not happen, see
+       * SetFragment::sort() ).
+       *
+       * @return number of threads the caller may use (always at least 1); must be passed back to
+       * release() together with the same number of bytes.
+       */
+      unsigned acquire(size_t bytes, unsigned maxThreads)
+      {
+         SafeMutexLock lock(&mutex); // L O C K
+
+         while(memoryUsed && memoryBudget && memoryUsed + bytes > memoryBudget)
+            changedCond.wait(&mutex);
+
+         unsigned threads = 1;
+
+         if(maxThreads > 1 && threadsUsed + 1 < numThreads)
+            threads = std::min(maxThreads, numThreads - threadsUsed);
+
+         memoryUsed += bytes;
+         threadsUsed += threads;
+
+         lock.unlock(); // U N L O C K
+
+         return threads;
+      }
+
+      void release(size_t bytes, unsigned threads)
+      {
+         SafeMutexLock lock(&mutex); // L O C K
+
+         memoryUsed -= bytes;
+         threadsUsed -= threads;
+         changedCond.broadcast();
+
+         lock.unlock(); // U N L O C K
+      }
+
+   private:
+      SortResources()
+         : numThreads(1), memoryBudget(0), memoryUsed(0), threadsUsed(0)
+      {}
+
+      SortResources(const SortResources&);
+      SortResources& operator=(const SortResources&);
+
+      Mutex mutex;
+      Condition changedCond;
+
+      unsigned numThreads;
+      size_t memoryBudget;
+      size_t memoryUsed;
+      unsigned threadsUsed;
+};
+
+/*
+ * runs a number of independent jobs on a bounded number of threads. the calling thread takes part
+ * in the work, run() returns once all jobs are done. if a job throws, no further jobs are started
+ * and run() throws a runtime_error with the message of the first failure.
+ */
+class JobGroup
+{
+   public:
+      class Job
+      {
+         public:
+            virtual ~Job() {}
+
+            virtual void run() = 0;
+      };
+
+   private:
+      class Worker : public PThread
+      {
+         public:
+            Worker(JobGroup* group)
+               : PThread("DBJob"), group(group)
+            {}
+
+         private:
+            JobGroup* group;
+
+            void run()
+            {
+               group->work();
+            }
+      };
+
+   public:
+      JobGroup(unsigned maxThreads)
+         : maxThreads(maxThreads ? maxThreads : 1), nextJob(0), failed(false)
+      {}
+
+      ~JobGroup()
+      {
+         for(size_t i = 0; i < jobs.size(); i++)
+            delete jobs[i];
+      }
+
+      /**
+       * @param job will be owned by the group
+       */
+      void add(Job* job)
+      {
+         jobs.push_back(job);
+      }
+
+      void run()
+      {
+         std::vector<Worker*> workers;
+
+         const size_t numWorkers = std::min<size_t>(maxThreads, jobs.size() );
+
+         for(size_t i = 1; i < numWorkers; i++)
+         {
+            Worker* worker = new Worker(this);
+
+            try
+            {
+               worker->start();
+            }
+            catch(PThreadCreateException& e)
+            { // the remaining jobs are done by the threads we already have
+               delete worker;
+               break;
+            }
+
+            workers.push_back(worker);
+         }
+
+         work();
+
+         for(size_t i = 0; i < workers.size(); i++)
+         {
+            workers[i]->join();
+            delete workers[i];
+         }
+
+         if(failed)
+            throw std::runtime_error(failure);
+      }
+
+   private:
+      JobGroup(const JobGroup&);
+      JobGroup& operator=(const JobGroup&);
+
+      unsigned maxThreads;
+      std::vector<Job*> jobs;
+
+      Mutex mutex; // protects nextJob and the failure fields
+      size_t nextJob;
+      bool failed;
+      std::string failure;
+
+      void work()
+      {
+         while(true)
+         {
+            SafeMutexLock lock(&mutex); // L O C K
+
+            if(failed || nextJob == jobs.size() )
+            {
+               lock.unlock(); // U N L O C K
+               return;
+            }
+
+            Job* job = jobs[nextJob++];
+
+            lock.unlock(); // U N L O C K
+
+            try
+            {
+               job->run();
+            }
+            catch(std::exception& e)
+            {
+               setFailed(e.what() );
+            }
+            catch(...)
+            {
+               setFailed("unknown error in database job");
+            }
+         }
+      }
+
+      void setFailed(const std::string& what)
+      {
+         SafeMutexLock lock(&mutex); // L O C K
+
+         if(!failed)
+         {
+            failed = true;
+            failure = what;
+         }
+
+         lock.unlock(); // U N L O C K
+      }
+};
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <common/threading/Mutex.h>
 #include <common/threading/SafeMutexLock.h>
+#include <database/Parallel.h>
 #include <database/SetFragment.h>
 #include <database/SetFragmentCursor.h>
 #include <database/Union.h>
@@ -12,6 +13,7 @@
 #include <limits>
 #include <map>
 #include <sstream>
+#include <vector>
 
 #include <limits.h>
 
@@ -146,6 +148,87 @@ class Set {
          return cwd + ('/' + path);
       }
 
+      static const unsigned MERGE_WIDTH = 4;
+
+      class SortFragmentJob : public db::JobGroup::Job
+      {
+         public:
+            SortFragmentJob(Fragment* fragment, unsigned maxThreads)
+               : fragment(fragment), maxThreads(maxThreads)
+            {}
+
+            void run()
+            {
+               fragment->sort(maxThreads);
+            }
+
+         private:
+            Fragment* fragment;
+            unsigned maxThreads;
+      };
+
+      class MergeFragmentsJob : public db::JobGroup::Job
+      {
+         public:
+            MergeFragmentsJob(const std::vector<Fragment*>& inputs, Fragment* merged)
+               : inputs(inputs), merged(merged)
+            {}
+
+            void run()
+            {
+               mergeFragments(inputs, merged);
+            }
+
+         private:
+            std::vector<Fragment*> inputs;
+            Fragment* merged;
+      };
+
+      static void mergeFragments(const std::vector<Fragment*>& inputs, Fragment* merged)
+      {
+         struct op
+         {
+            static typename Data::KeyType key(const Data& d) { return d.pkey(); }
+         };
+         typedef typename Data::KeyType (*key_t)(const Data&);
+         typedef Union<Cursor, Cursor, key_t> L1Union;
+
+         switch(inputs.size() )
+         {
+         case 2: {
+            L1Union u(Cursor(*inputs[0]), (Cursor(*inputs[1]) ), op::key);
+            while(u.step() )
+               merged->append(*u.get() );
+            break;
+         }
+
+         case 3: {
+            Union<L1Union, SetFragmentCursor<Data>, key_t> u(
+               L1Union(Cursor(*inputs[0]), (Cursor(*inputs[1]) ), op::key),
+               Cursor(*inputs[2]),
+               op::key);
+            while(u.step() )
+               merged->append(*u.get() );
+            break;
+         }
+
+         case 4: {
+            Union<L1Union, L1Union, key_t> u(
+               L1Union(Cursor(*inputs[0]), (Cursor(*inputs[1]) ), op::key),
+               L1Union(Cursor(*inputs[2]), (Cursor(*inputs[3]) ), op::key),
+               op::key);
+            while(u.step() )
+               merged->append(*u.get() );
+            break;
+         }
+
+         default:
+            throw std::runtime_error("");
+         }
+
+         merged->flush();
+      }
+
    public:
       Set(const std::string& basename, bool allowCreate = true)
          : basename(makeAbsolute(basename) ), nextID(0), dropped(false)
@@ -192,86 +275,88 @@ class Set {
             newFragment();
 
          std::multimap<size_t, Fragment*> sortedFragments;
+         std::vector<Fragment*> unsortedFragments;
 
          for(FragmentIter it = openFragments.begin(), end = openFragments.end(); it != end; ++it)
             it->second->flush();
 
          for(FragmentIter it = openFragments.begin(), end = openFragments.end(); it != end; ++it)
          {
-            it->second->sort();
+            if(!it->second->isSorted() )
+               unsortedFragments.push_back(it->second);
+
             sortedFragments.insert(std::make_pair(it->second->size(), it->second) );
          }
 
-         static const unsigned MERGE_WIDTH = 4;
+         const unsigned numThreads = db::SortResources::get().getNumThreads();
+
+         if(!unsortedFragments.empty() )
+         {
+            // fragments are sorted concurrently. each sort may use more than one thread itself if
+            // there are fewer fragments than threads, db::SortResources keeps the total in check
+            const unsigned threadsPerSort = std::max<size_t>(1,
+               numThreads / std::min<size_t>(numThreads, unsortedFragments.size() ) );
+            db::JobGroup sortJobs(numThreads);
+
+            for(size_t i = 0; i < unsortedFragments.size(); i++)
+               sortJobs.add(new SortFragmentJob(unsortedFragments[i], threadsPerSort) );
+
+            sortJobs.run();
+         }
 
          if(sortedFragments.size() == 1)
             return;
 
          saveConfig();
 
+         // merge in rounds. in each round, the fragments are grouped by size into groups of up to
+         // MERGE_WIDTH, and all groups of a round are merged concurrently.
          while(sortedFragments.size() > 1)
          {
-            Fragment* inputs[MERGE_WIDTH] = {};
-            unsigned inputCount = 0;
+            std::vector<std::vector<Fragment*> > groups;
+            std::vector<Fragment*> outputs;
 
-            for(inputCount = 0; inputCount < MERGE_WIDTH; inputCount++)
+            while(!sortedFragments.empty() )
             {
-               if(sortedFragments.empty() )
+               std::vector<Fragment*> group;
+
+               for(unsigned i = 0; i < MERGE_WIDTH && !sortedFragments.empty(); i++)
+               {
+                  group.push_back(sortedFragments.begin()->second);
+                  sortedFragments.erase(sortedFragments.begin() );
+               }
+
+               // a single leftover fragment is merged in a later round
+               if(group.size() == 1)
+               {
+                  outputs.push_back(group[0]);
                   break;
+               }
 
-               inputs[inputCount] = sortedFragments.begin()->second;
-               sortedFragments.erase(sortedFragments.begin());
+               groups.push_back(group);
             }
 
-            SetFragment<Data>* merged = getFragment(fragmentName(nextID++), true);
+            db::JobGroup mergeJobs(numThreads);
 
-            struct op
+            for(size_t i = 0; i < groups.size(); i++)
             {
-               static typename Data::KeyType key(const Data& d) { return d.pkey(); }
-            };
-            typedef typename Data::KeyType (*key_t)(const Data&);
-            typedef Union<Cursor, Cursor, key_t> L1Union;
+               Fragment* merged = getFragment(fragmentName(nextID++), true);
 
-            switch(inputCount)
-            {
-            case 2: {
-               L1Union u(Cursor(*inputs[0]), (Cursor(*inputs[1]) ), op::key);
-               while(u.step() )
-                  merged->append(*u.get() );
-               break;
+               mergeJobs.add(new MergeFragmentsJob(groups[i], merged) );
+               outputs.push_back(merged);
             }
 
-            case 3: {
-               Union<L1Union, SetFragmentCursor<Data>, key_t> u(
-                  L1Union(Cursor(*inputs[0]), (Cursor(*inputs[1]) ), op::key),
-                  Cursor(*inputs[2]),
-                  op::key);
-               while(u.step() )
-                  merged->append(*u.get() );
-               break;
-            }
+            mergeJobs.run();
 
-            case 4: {
-               Union<L1Union, L1Union, key_t> u(
-                  L1Union(Cursor(*inputs[0]), (Cursor(*inputs[1]) ), op::key),
-                  L1Union(Cursor(*inputs[2]), (Cursor(*inputs[3]) ), op::key),
-                  op::key);
-               while(u.step() )
-                  merged->append(*u.get() );
-               break;
-            }
+            for(size_t i = 0; i < outputs.size(); i++)
+               sortedFragments.insert(std::make_pair(outputs[i]->size(), outputs[i]) );
 
-            default:
-               throw std::runtime_error("");
+            for(size_t i = 0; i < groups.size(); i++)
+            {
+               for(size_t j = 0; j < groups[i].size(); j++)
+                  removeFragment(groups[i][j]->filename() );
             }
 
-            merged->flush();
-
-            sortedFragments.insert(std::make_pair(merged->size(), merged) );
-
-            for (unsigned i = 0; i < inputCount; i++)
-               removeFragment(inputs[i]->filename() );
-
             saveConfig();
          }
       }
@@ -1,8 +1,11 @@
 #ifndef SETFRAGMENT_H_
 #define SETFRAGMENT_H_
 
+#include <database/Parallel.h>
+
 #include <algorithm>
 #include <cerrno>
+#include <queue>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -24,6 +27,8 @@ class SetFragment {
    public:
       static const unsigned CONFIG_AREA_SIZE = 4096;
       static const size_t BUFFER_SIZE = 4ULL * 1024 * 1024;
+      // fragments are only split into runs for parallel sorting if each run gets at least this much
+      static const size_t MIN_SORT_RUN_SIZE = 1ULL * 1024 * 1024;
 
    private:
       std::string file;
@@ -67,6 +72,11 @@ class SetFragment {
       }
 
       size_t writeBlock(const Data* source, size_t count, size_t from)
+      {
+         return writeBlockTo(fd, source, count, from);
+      }
+
+      static size_t writeBlockTo(int targetFD, const Data* source, size_t count, size_t from)
       {
          size_t total = 0;
          count *= sizeof(Data);
@@ -78,7 +88,7 @@ class SetFragment {
 
          while(total < count)
          {
-            ssize_t current = ::pwrite(fd, buf + total, count - total, from + total);
+            ssize_t current = ::pwrite(targetFD, buf + total, count - total, from + total);
             total += current;
 
             if (current < 0)
@@ -174,6 +184,7 @@ class SetFragment {
 
       const std::string filename() const { return file; }
       size_t size() const { return itemCount; }
+      bool isSorted() const { return sorted; }
 
       void append(const Data& data)
       {
@@ -223,35 +234,299 @@ class SetFragment {
             throw std::runtime_error("error in flush");
       }
 
-      void sort()
+      /**
+       * reads items directly from the file, without going through the buffer of the fragment. this
+       * allows several threads to read the same fragment concurrently, as long as it is not
+       * modified at the same time.
+       */
+      void readItems(Data* into, size_t count, size_t from)
+      {
+         if(readBlock(into, count, from) < count)
+            throw std::runtime_error("could not read from fragment file");
+      }
+
+      /**
+       * sorts the fragment. if the fragment does not fit into the memory budget of
+       * db::SortResources, it is sorted in runs that do fit, and the sorted runs are merged from
+       * disk into a new file (an external sort).
+       *
+       * runs are sorted in memory. with more than one thread, a run is split into parts that are
+       * sorted concurrently and then merged while being written back to the file.
+       *
+       * @param maxThreads number of threads to use at most; the actual number is limited by
+       * db::SortResources, which also limits the amount of memory all sorts may use at once.
+       */
+      void sort(unsigned maxThreads = 1)
       {
          flush();
 
          if(sorted)
             return;
 
-         boost::scoped_array<Data> data(new Data[size()]);
+         const size_t memoryBudget = db::SortResources::get().getMemoryBudget();
+         const size_t runSize = memoryBudget
+            ? std::max<size_t>(1, memoryBudget / sizeof(Data) )
+            : size();
 
-         if(readBlock(data.get(), size(), 0) < size() )
-            throw 42;
+         for(size_t first = 0; first < size(); first += runSize)
+            sortRun(first, std::min(runSize, size() - first), maxThreads);
 
-         struct ops
+         if(runSize < size() )
+            mergeRuns(runSize, memoryBudget);
+
+         sorted = true;
+
+         flush();
+      }
+
+   private:
+      struct ops
+      {
+         static bool compare(const Data& l, const Data& r)
          {
-            static bool compare(const Data& l, const Data& r)
+            return l.pkey() < r.pkey();
+         }
+      };
+
+      class SortRunJob : public db::JobGroup::Job
+      {
+         public:
+            SortRunJob(Data* begin, Data* end)
+               : begin(begin), end(end)
+            {}
+
+            void run()
             {
-               return l.pkey() < r.pkey();
+               std::sort(begin, end, ops::compare);
             }
-         };
 
-         std::sort(data.get(), data.get() + size(), ops::compare);
+         private:
+            Data* begin;
+            Data* end;
+      };
 
-         writeBlock(data.get(), size(), 0);
+      // heap entry for merging sorted runs, orders by the key of the current item of the run
+      struct RunHead
+      {
+         const Data* current;
+         const Data* end;
+         size_t run; // index of the run (only used when merging runs from disk)
 
-         sorted = true;
+         bool operator<(const RunHead& other) const
+         {
+            // std::priority_queue is a max-heap, so the comparison is reversed
+            return other.current->pkey() < current->pkey();
+         }
+      };
 
-         flush();
+      // a sorted run of the fragment file, read through a buffer while the runs are merged
+      struct FileRun
+      {
+         size_t next; // first item of the run that was not read yet
+         size_t end;
+         std::vector<Data> buffer;
+      };
+
+      /**
+       * sorts count items starting at first in memory and writes them back to the same place.
+       */
+      void sortRun(size_t first, size_t count, unsigned maxThreads)
+      {
+         const size_t bytes = count * sizeof(Data);
+
+         maxThreads = std::max<size_t>(1, std::min<size_t>(maxThreads, bytes / MIN_SORT_RUN_SIZE) );
+
+         db::SortResources& resources = db::SortResources::get();
+         const unsigned numThreads = resources.acquire(bytes, maxThreads);
+
+         try
+         {
+            sortInMemory(first, count, numThreads);
+         }
+         catch(...)
+         {
+            resources.release(bytes, numThreads);
+            throw;
+         }
+
+         resources.release(bytes, numThreads);
+      }
+
+      void sortInMemory(size_t first, size_t count, unsigned numThreads)
+      {
+         boost::scoped_array<Data> data(new Data[count]);
+
+         if(readBlock(data.get(), count, first) < count)
+            throw std::runtime_error("could not read fragment for sorting");
+
+         if(numThreads <= 1)
+         {
+            std::sort(data.get(), data.get() + count, ops::compare);
+            writeBlock(data.get(), count, first);
+            return;
+         }
+
+         std::vector<size_t> runStarts;
+         db::JobGroup sortJobs(numThreads);
+
+         for(unsigned i = 0; i < numThreads; i++)
+         {
+            runStarts.push_back(count * i / numThreads);
+
+            Data* runEnd = data.get() + count * (i + 1) / numThreads;
+            sortJobs.add(new SortRunJob(data.get() + runStarts.back(), runEnd) );
+         }
+
+         sortJobs.run();
+
+         std::priority_queue<RunHead> heads;
+
+         for(unsigned i = 0; i < numThreads; i++)
+         {
+            const size_t runEnd = i + 1 < numThreads ? runStarts[i + 1] : count;
+
+            if(runStarts[i] == runEnd)
+               continue;
+
+            RunHead head = { data.get() + runStarts[i], data.get() + runEnd, i };
+            heads.push(head);
+         }
+
+         // the merged sequence goes to disk through a bounded buffer, so merging needs no second
+         // copy of the fragment in memory
+         std::vector<Data> out;
+         const size_t outCapacity = std::max<size_t>(1, BUFFER_SIZE / sizeof(Data) );
+         size_t written = 0;
+
+         out.reserve(outCapacity);
+
+         while(!heads.empty() )
+         {
+            RunHead head = heads.top();
+            heads.pop();
+
+            out.push_back(*head.current);
+
+            if(++head.current != head.end)
+               heads.push(head);
+
+            if(out.size() == outCapacity || heads.empty() )
+            {
+               writeBlock(&out[0], out.size(), first + written);
+               written += out.size();
+               out.clear();
+            }
+         }
+      }
+
+      /**
+       * merges the sorted runs of runSize items each (the last one may be shorter) into a new file,
+       * which then replaces the fragment file. the runs are read and the output is written through
+       * buffers that together fit into the memory budget.
+       */
+      void mergeRuns(size_t runSize, size_t memoryBudget)
+      {
+         const size_t numRuns = (size() + runSize - 1) / runSize;
+         const size_t bufferItems = std::max<size_t>(1,
+            std::min<size_t>(BUFFER_SIZE, memoryBudget / (numRuns + 1) ) / sizeof(Data) );
+         const size_t bytes = (numRuns + 1) * bufferItems * sizeof(Data);
+
+         const std::string mergedFile = file + ".merge";
+
+         int mergedFD = ::open(mergedFile.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0660);
+         if(mergedFD < 0)
+            throw std::runtime_error("could not create file for merging fragment");
+
+         db::SortResources& resources = db::SortResources::get();
+         const unsigned numThreads = resources.acquire(bytes, 1);
+
+         try
+         {
+            mergeRunsInto(mergedFD, runSize, numRuns, bufferItems);
+
+            if(::rename(mergedFile.c_str(), file.c_str() ) < 0)
+               throw std::runtime_error("could not replace fragment file with merged runs");
+         }
+         catch(...)
+         {
+            resources.release(bytes, numThreads);
+
+            ::close(mergedFD);
+            ::unlink(mergedFile.c_str() );
+            throw;
+         }
+
+         resources.release(bytes, numThreads);
+
+         ::close(fd);
+         fd = mergedFD;
       }
 
+      void mergeRunsInto(int mergedFD, size_t runSize, size_t numRuns, size_t bufferItems)
+      {
+         std::vector<FileRun> runs(numRuns);
+         std::priority_queue<RunHead> heads;
+
+         for(size_t i = 0; i < numRuns; i++)
+         {
+            runs[i].next = i * runSize;
+            runs[i].end = std::min(runs[i].next + runSize, size() );
+
+            RunHead head = { NULL, NULL, i };
+
+            if(readRun(runs[i], head, bufferItems) )
+               heads.push(head);
+         }
+
+         std::vector<Data> out;
+         size_t written = 0;
+
+         out.reserve(bufferItems);
+
+         while(!heads.empty() )
+         {
+            RunHead head = heads.top();
+            heads.pop();
+
+            out.push_back(*head.current);
+
+            if(++head.current != head.end || readRun(runs[head.run], head, bufferItems) )
+               heads.push(head);
+
+            if(out.size() == bufferItems || heads.empty() )
+            {
+               if(writeBlockTo(mergedFD, &out[0], out.size(), written) < out.size() )
+                  throw std::runtime_error("could not write merged fragment");
+
+               written += out.size();
+               out.clear();
+            }
+         }
+      }
+
+      /**
+       * reads the next items of a run into its buffer and points head to them.
+       *
+       * @return false if the run has no more items.
+       */
+      bool readRun(FileRun& run, RunHead& head, size_t bufferItems)
+      {
+         if(run.next == run.end)
+            return false;
+
+         const size_t count = std::min(bufferItems, run.end - run.next);
+
+         run.buffer.resize(count);
+         readItems(&run.buffer[0], count, run.next);
+         run.next += count;
+
+         head.current = &run.buffer[0];
+         head.end = head.current + count;
+
+         return true;
+      }
+
+   public:
       void drop()
       {
          flush();
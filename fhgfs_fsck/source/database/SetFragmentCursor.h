@@ -3,20 +3,32 @@
 
 #include <database/SetFragment.h>
 
+/*
+ * cursors read the fragment file through their own buffer instead of the buffer of the fragment, so
+ * several cursors (possibly in different threads) can read the same fragment at the same time.
+ */
 template<typename Data>
 class SetFragmentCursor {
    public:
       typedef Data ElementType;
       typedef size_t MarkerType;
 
+      static const size_t BUFFER_SIZE = 256 * 1024;
+
    private:
       SetFragment<Data>* fragment;
       size_t currentGetIndex;
 
+      std::vector<Data> buffer;
+      size_t firstBufferedItem;
+
    public:
       explicit SetFragmentCursor(SetFragment<Data>& fragment)
-         : fragment(&fragment), currentGetIndex(-1)
-      {}
+         : fragment(&fragment), currentGetIndex(-1), firstBufferedItem(0)
+      {
+         // (we read from the file, so buffered appends must be written out first)
+         fragment.flush();
+      }
 
       bool step()
       {
@@ -29,7 +41,18 @@ class SetFragmentCursor {
 
       Data* get()
       {
-         return &(*fragment)[currentGetIndex];
+         if(currentGetIndex < firstBufferedItem ||
+            currentGetIndex >= firstBufferedItem + buffer.size() )
+         {
+            const size_t count = std::min<size_t>(fragment->size() - currentGetIndex,
+               std::max<size_t>(1, BUFFER_SIZE / sizeof(Data) ) );
+
+            buffer.resize(count);
+            fragment->readItems(&buffer[0], count, currentGetIndex);
+            firstBufferedItem = currentGetIndex;
+         }
+
+         return &buffer[currentGetIndex - firstBufferedItem];
       }
 
       MarkerType mark() const
@@ -4,6 +4,8 @@
 #include <common/toolkit/UnitTk.h>
 #include <components/DataFetcher.h>
 #include <components/worker/RetrieveChunksWork.h>
+#include <database/Parallel.h>
+#include <database/VectorSource.h>
 #include <net/msghelpers/MsgHelperRepair.h>
 #include <toolkit/DatabaseTk.h>
 #include <toolkit/FsckTkEx.h>
@@ -84,7 +86,8 @@ FsckRepairAction UserPrompter::chooseAction(const std::string& prompt)
 
 ModeCheckFS::ModeCheckFS()
  : log("ModeCheckFS"),
-   lostAndFoundNode(NULL)
+   lostAndFoundNode(NULL),
+   databaseRepaired(false)
 {
 }
 
@@ -165,6 +168,8 @@ int ModeCheckFS::execute()
    if ( !FsckTkEx::checkReachability() )
       return APPCODE_COMMUNICATION_ERROR;
 
+   db::SortResources::get().configure(cfg->getTuneDbSortThreads(), cfg->getTuneDbSortMemory() );
+
    if(cfg->getNoFetch() )
    {
       try {
@@ -411,6 +416,161 @@ FhgfsOpsErr ModeCheckFS::gatherData(bool forceRestart)
    return retVal;
 }
 
+namespace {
+
+/*
+ * runs a database check and keeps its results until the repairs are done.
+ */
+template<typename Obj>
+class FindErrorsJob : public db::JobGroup::Job
+{
+   public:
+      FindErrorsJob(Cursor<Obj> query, std::vector<Obj>* found)
+         : query(query), found(found)
+      {}
+
+      void run()
+      {
+         found->clear();
+
+         while(query.step() )
+            found->push_back(*query.get() );
+      }
+
+   private:
+      Cursor<Obj> query;
+      std::vector<Obj>* found;
+};
+
+template<typename Obj>
+db::JobGroup::Job* findErrorsJob(Cursor<Obj> query, std::vector<Obj>& found)
+{
+   return new FindErrorsJob<Obj>(query, &found);
+}
+
+/*
+ * @param found will be empty afterwards
+ */
+template<typename Obj>
+Cursor<Obj> foundErrors(std::vector<Obj>& found)
+{
+   return Cursor<Obj>(VectorSource<Obj>(found) );
+}
+
+}
+
+/*
+ * runs the database checks from first to last (inclusive) concurrently.
+ *
+ * note: the queries are set up here (which commits pending changes of the tables), the jobs only
+ * step through them and read the sorted tables.
+ */
+void ModeCheckFS::findErrors(FsckDB* database, FsckFoundErrors& found, FsckCheck first,
+   FsckCheck last)
+{
+   App* app = Program::getApp();
+   Config* cfg = app->getConfig();
+
+   db::JobGroup jobs(db::SortResources::get().getNumThreads() );
+
+   for(int check = first; check <= last; check++)
+   {
+      switch(check)
+      {
+         case FsckCheck_DUPLICATEINODEIDS:
+            jobs.add(findErrorsJob(database->findDuplicateInodeIDs(), found.duplicateInodeIDs) );
+            break;
+
+         case FsckCheck_DUPLICATECHUNKS:
+            jobs.add(findErrorsJob(database->findDuplicateChunks(), found.duplicateChunks) );
+            break;
+
+         case FsckCheck_FILESWITHMISSINGTARGETS:
+            jobs.add(findErrorsJob(
+               database->findFilesWithMissingStripeTargets(app->getTargetMapper(),
+                  app->getMirrorBuddyGroupMapper() ),
+               found.filesWithMissingTargets) );
+            break;
+
+         case FsckCheck_ORPHANEDDENTRYBYIDFILES:
+            jobs.add(findErrorsJob(database->findOrphanedFsIDFiles(),
+               found.orphanedDentryByIDFiles) );
+            break;
+
+         case FsckCheck_DIRENTRIESWITHBROKENBYIDFILE:
+            jobs.add(findErrorsJob(database->findDirEntriesWithBrokenByIDFile(),
+               found.dirEntriesWithBrokenByIDFile) );
+            break;
+
+         case FsckCheck_CHUNKSINWRONGPATH:
+            jobs.add(findErrorsJob(database->findChunksInWrongPath(), found.chunksInWrongPath) );
+            break;
+
+         case FsckCheck_WRONGINODEOWNERS:
+            jobs.add(findErrorsJob(database->findInodesWithWrongOwner(), found.wrongInodeOwners) );
+            break;
+
+         case FsckCheck_WRONGOWNERSINDENTRY:
+            jobs.add(findErrorsJob(database->findDirEntriesWithWrongOwner(),
+               found.wrongOwnersInDentry) );
+            break;
+
+         case FsckCheck_ORPHANEDCONTDIRS:
+            jobs.add(findErrorsJob(database->findOrphanedContDirs(), found.orphanedContDirs) );
+            break;
+
+         case FsckCheck_ORPHANEDDIRINODES:
+            jobs.add(findErrorsJob(database->findOrphanedDirInodes(), found.orphanedDirInodes) );
+            break;
+
+         case FsckCheck_ORPHANEDFILEINODES:
+            jobs.add(findErrorsJob(database->findOrphanedFileInodes(),
+               found.orphanedFileInodes) );
+            break;
+
+         case FsckCheck_DANGLINGDENTRIES:
+            jobs.add(findErrorsJob(database->findDanglingDirEntries(), found.danglingDentries) );
+            break;
+
+         case FsckCheck_ORPHANEDCHUNKS:
+            jobs.add(findErrorsJob(database->findOrphanedChunks(), found.orphanedChunks) );
+            break;
+
+         case FsckCheck_MISSINGCONTDIRS:
+            jobs.add(findErrorsJob(database->findInodesWithoutContDir(), found.missingContDirs) );
+            break;
+
+         case FsckCheck_WRONGFILEATTRIBS:
+            jobs.add(findErrorsJob(database->findWrongInodeFileAttribs(),
+               found.wrongFileAttribs) );
+            break;
+
+         case FsckCheck_WRONGDIRATTRIBS:
+            jobs.add(findErrorsJob(database->findWrongInodeDirAttribs(), found.wrongDirAttribs) );
+            break;
+
+         case FsckCheck_CHUNKSWITHWRONGPERMISSIONS:
+            if(cfg->getQuotaEnabled() )
+               jobs.add(findErrorsJob(database->findChunksWithWrongPermissions(),
+                  found.chunksWithWrongPermissions) );
+            break;
+      }
+   }
+
+   jobs.run();
+}
+
+/*
+ * once a repair may have modified the database, the results that findErrors() computed up front
+ * are outdated. from then on, each check is run again right before its repairs (just like the
+ * checks were run without the concurrent search).
+ */
+void ModeCheckFS::updateFoundErrors(FsckFoundErrors& found, FsckCheck nextCheck)
+{
+   if(databaseRepaired)
+      findErrors(database.get(), found, nextCheck, nextCheck);
+}
+
 template<typename Obj, typename State>
 int64_t ModeCheckFS::checkAndRepairGeneric(Cursor<Obj> cursor,
    void (ModeCheckFS::*repair)(Obj&, State&), State& state)
@@ -425,6 +585,10 @@ int64_t ModeCheckFS::checkAndRepairGeneric(Cursor<Obj> cursor,
       errorCount++;
    }
 
+   // (conservatively also set if the user chose to skip the repairs)
+   if(errorCount && !Program::getApp()->getConfig()->getReadOnly() )
+      databaseRepaired = true;
+
    if(errorCount)
       FsckTkEx::fsckOutput(">>> Found " + StringTk::int64ToStr(errorCount)
          + " errors. Detailed information can also be found in "
@@ -434,7 +598,7 @@ int64_t ModeCheckFS::checkAndRepairGeneric(Cursor<Obj> cursor,
    return errorCount;
 }
 
-int64_t ModeCheckFS::checkAndRepairDanglingDentry()
+int64_t ModeCheckFS::checkAndRepairDanglingDentry(std::vector<db::DirEntry>& found)
 {
    FsckRepairAction fileActions[] = {
       FsckRepairAction_NOTHING,
@@ -455,11 +619,11 @@ int64_t ModeCheckFS::checkAndRepairDanglingDentry()
    FsckTkEx::fsckOutput("* Dangling directory entry ...",
       OutputOptions_FLUSH |OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findDanglingDirEntries(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairDanglingDirEntry, prompt);
 }
 
-int64_t ModeCheckFS::checkAndRepairWrongInodeOwner()
+int64_t ModeCheckFS::checkAndRepairWrongInodeOwner(std::vector<FsckDirInode>& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -471,11 +635,12 @@ int64_t ModeCheckFS::checkAndRepairWrongInodeOwner()
    FsckTkEx::fsckOutput("* Wrong owner node saved in inode ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findInodesWithWrongOwner(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairWrongInodeOwner, prompt);
 }
 
-int64_t ModeCheckFS::checkAndRepairWrongOwnerInDentry()
+int64_t ModeCheckFS::checkAndRepairWrongOwnerInDentry(
+   std::vector<std::pair<db::DirEntry, uint16_t> >& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -487,11 +652,11 @@ int64_t ModeCheckFS::checkAndRepairWrongOwnerInDentry()
    FsckTkEx::fsckOutput("* Dentry points to inode on wrong node ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findDirEntriesWithWrongOwner(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairWrongInodeOwnerInDentry, prompt);
 }
 
-int64_t ModeCheckFS::checkAndRepairOrphanedContDir()
+int64_t ModeCheckFS::checkAndRepairOrphanedContDir(std::vector<FsckContDir>& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -503,11 +668,11 @@ int64_t ModeCheckFS::checkAndRepairOrphanedContDir()
    FsckTkEx::fsckOutput("* Content directory without an inode ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findOrphanedContDirs(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairOrphanedContDir, prompt);
 }
 
-int64_t ModeCheckFS::checkAndRepairOrphanedDirInode()
+int64_t ModeCheckFS::checkAndRepairOrphanedDirInode(std::vector<FsckDirInode>& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -519,14 +684,14 @@ int64_t ModeCheckFS::checkAndRepairOrphanedDirInode()
    FsckTkEx::fsckOutput("* Dir inode without a dentry pointing to it (orphaned inode) ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   bool result = checkAndRepairGeneric(this->database->findOrphanedDirInodes(),
+   bool result = checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairOrphanedDirInode, prompt);
 
    releaseLostAndFound();
    return result;
 }
 
-int64_t ModeCheckFS::checkAndRepairOrphanedFileInode()
+int64_t ModeCheckFS::checkAndRepairOrphanedFileInode(std::vector<FsckFileInode>& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -539,11 +704,11 @@ int64_t ModeCheckFS::checkAndRepairOrphanedFileInode()
    FsckTkEx::fsckOutput("* File inode without a dentry pointing to it (orphaned inode) ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findOrphanedFileInodes(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairOrphanedFileInode, prompt);
 }
 
-int64_t ModeCheckFS::checkAndRepairOrphanedChunk()
+int64_t ModeCheckFS::checkAndRepairOrphanedChunk(std::vector<FsckChunk>& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -556,11 +721,11 @@ int64_t ModeCheckFS::checkAndRepairOrphanedChunk()
    FsckTkEx::fsckOutput("* Chunk without an inode pointing to it (orphaned chunk) ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findOrphanedChunks(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairOrphanedChunk, state);
 }
 
-int64_t ModeCheckFS::checkAndRepairMissingContDir()
+int64_t ModeCheckFS::checkAndRepairMissingContDir(std::vector<FsckDirInode>& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -572,11 +737,12 @@ int64_t ModeCheckFS::checkAndRepairMissingContDir()
    FsckTkEx::fsckOutput("* Directory inode without a content directory ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findInodesWithoutContDir(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairMissingContDir, prompt);
 }
 
-int64_t ModeCheckFS::checkAndRepairWrongFileAttribs()
+int64_t ModeCheckFS::checkAndRepairWrongFileAttribs(
+   std::vector<std::pair<FsckFileInode, checks::InodeAttribs> >& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -588,11 +754,12 @@ int64_t ModeCheckFS::checkAndRepairWrongFileAttribs()
    FsckTkEx::fsckOutput("* Attributes of file inode are wrong ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findWrongInodeFileAttribs(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairWrongFileAttribs, prompt);
 }
 
-int64_t ModeCheckFS::checkAndRepairWrongDirAttribs()
+int64_t ModeCheckFS::checkAndRepairWrongDirAttribs(
+   std::vector<std::pair<FsckDirInode, checks::InodeAttribs> >& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -604,11 +771,11 @@ int64_t ModeCheckFS::checkAndRepairWrongDirAttribs()
    FsckTkEx::fsckOutput("* Attributes of dir inode are wrong ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findWrongInodeDirAttribs(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairWrongDirAttribs, prompt);
 }
 
-int64_t ModeCheckFS::checkAndRepairFilesWithMissingTargets()
+int64_t ModeCheckFS::checkAndRepairFilesWithMissingTargets(std::vector<db::DirEntry>& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -620,13 +787,11 @@ int64_t ModeCheckFS::checkAndRepairFilesWithMissingTargets()
    FsckTkEx::fsckOutput("* File has a missing target in stripe pattern ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(
-      this->database->findFilesWithMissingStripeTargets(
-         Program::getApp()->getTargetMapper(), Program::getApp()->getMirrorBuddyGroupMapper() ),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairFileWithMissingTargets, prompt);
 }
 
-int64_t ModeCheckFS::checkAndRepairDirEntriesWithBrokeByIDFile()
+int64_t ModeCheckFS::checkAndRepairDirEntriesWithBrokeByIDFile(std::vector<db::DirEntry>& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -638,11 +803,11 @@ int64_t ModeCheckFS::checkAndRepairDirEntriesWithBrokeByIDFile()
    FsckTkEx::fsckOutput("* Dentry-by-ID file is broken or missing ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findDirEntriesWithBrokenByIDFile(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairDirEntryWithBrokenByIDFile, prompt);
 }
 
-int64_t ModeCheckFS::checkAndRepairOrphanedDentryByIDFiles()
+int64_t ModeCheckFS::checkAndRepairOrphanedDentryByIDFiles(std::vector<FsckFsID>& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -654,11 +819,12 @@ int64_t ModeCheckFS::checkAndRepairOrphanedDentryByIDFiles()
    FsckTkEx::fsckOutput("* Dentry-by-ID file is present, but no corresponding dentry ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findOrphanedFsIDFiles(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairOrphanedDentryByIDFile, prompt);
 }
 
-int64_t ModeCheckFS::checkAndRepairChunksWithWrongPermissions()
+int64_t ModeCheckFS::checkAndRepairChunksWithWrongPermissions(
+   std::vector<std::pair<FsckChunk, FsckFileInode> >& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -670,12 +836,13 @@ int64_t ModeCheckFS::checkAndRepairChunksWithWrongPermissions()
    FsckTkEx::fsckOutput("* Chunk has wrong permissions ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findChunksWithWrongPermissions(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairChunkWithWrongPermissions, prompt);
 }
 
 // no repair at the moment
-int64_t ModeCheckFS::checkAndRepairChunksInWrongPath()
+int64_t ModeCheckFS::checkAndRepairChunksInWrongPath(
+   std::vector<std::pair<FsckChunk, FsckFileInode> >& found)
 {
    FsckRepairAction possibleActions[] = {
       FsckRepairAction_NOTHING,
@@ -687,17 +854,18 @@ int64_t ModeCheckFS::checkAndRepairChunksInWrongPath()
    FsckTkEx::fsckOutput("* Chunk is saved in wrong path ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
-   return checkAndRepairGeneric(this->database->findChunksInWrongPath(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::repairWrongChunkPath, prompt);
 }
 
-int64_t ModeCheckFS::checkDuplicateInodeIDs()
+int64_t ModeCheckFS::checkDuplicateInodeIDs(
+   std::vector<std::pair<db::EntryID, std::set<uint32_t> > >& found)
 {
    FsckTkEx::fsckOutput("* Duplicated inode IDs ...",
       OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
    int dummy = 0;
-   return checkAndRepairGeneric(this->database->findDuplicateInodeIDs(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::logDuplicateInodeID, dummy);
 }
 
@@ -713,12 +881,12 @@ void ModeCheckFS::logDuplicateInodeID(std::pair<db::EntryID, std::set<uint32_t>
    }
 }
 
-int64_t ModeCheckFS::checkDuplicateChunks()
+int64_t ModeCheckFS::checkDuplicateChunks(std::vector<std::list<FsckChunk> >& found)
 {
    FsckTkEx::fsckOutput("* Duplicated chunks ...", OutputOptions_FLUSH | OutputOptions_LINEBREAK);
 
    int dummy = 0;
-   return checkAndRepairGeneric(this->database->findDuplicateChunks(),
+   return checkAndRepairGeneric(foundErrors(found),
       &ModeCheckFS::logDuplicateChunk, dummy);
 }
 
@@ -800,10 +968,20 @@ void ModeCheckFS::checkAndRepair()
 
    Config* cfg = Program::getApp()->getConfig();
 
+   // sort all tables up front (and concurrently), the checks below only stream over the results
+   this->database->commitChanges();
+
+   /* the checks only read the database, so they all run concurrently. the repairs modify the
+      database and may prompt the user, so they are applied afterwards, one check after the other.
+      the results of a check depend on the repairs before it, so they are updated after the first
+      repair (see updateFoundErrors() ). */
+   FsckFoundErrors found;
+   findErrors(database.get(), found, FsckCheck_DUPLICATEINODEIDS, FsckCheck_LAST);
+
    int64_t errorCount = 0;
 
-   errorCount += checkDuplicateInodeIDs();
-   errorCount += checkDuplicateChunks();
+   errorCount += checkDuplicateInodeIDs(found.duplicateInodeIDs);
+   errorCount += checkDuplicateChunks(found.duplicateChunks);
 
    if(errorCount)
    {
@@ -813,24 +991,39 @@ void ModeCheckFS::checkAndRepair()
    }
 
    errorCount += checkAndRepairMalformedChunk();
-   errorCount += checkAndRepairFilesWithMissingTargets();
-   errorCount += checkAndRepairOrphanedDentryByIDFiles();
-   errorCount += checkAndRepairDirEntriesWithBrokeByIDFile();
-   errorCount += checkAndRepairChunksInWrongPath();
-   errorCount += checkAndRepairWrongInodeOwner();
-   errorCount += checkAndRepairWrongOwnerInDentry();
-   errorCount += checkAndRepairOrphanedContDir();
-   errorCount += checkAndRepairOrphanedDirInode();
-   errorCount += checkAndRepairOrphanedFileInode();
-   errorCount += checkAndRepairDanglingDentry();
-   errorCount += checkAndRepairOrphanedChunk();
-   errorCount += checkAndRepairMissingContDir();
-   errorCount += checkAndRepairWrongFileAttribs();
-   errorCount += checkAndRepairWrongDirAttribs();
+   updateFoundErrors(found, FsckCheck_FILESWITHMISSINGTARGETS);
+   errorCount += checkAndRepairFilesWithMissingTargets(found.filesWithMissingTargets);
+   updateFoundErrors(found, FsckCheck_ORPHANEDDENTRYBYIDFILES);
+   errorCount += checkAndRepairOrphanedDentryByIDFiles(found.orphanedDentryByIDFiles);
+   updateFoundErrors(found, FsckCheck_DIRENTRIESWITHBROKENBYIDFILE);
+   errorCount += checkAndRepairDirEntriesWithBrokeByIDFile(found.dirEntriesWithBrokenByIDFile);
+   updateFoundErrors(found, FsckCheck_CHUNKSINWRONGPATH);
+   errorCount += checkAndRepairChunksInWrongPath(found.chunksInWrongPath);
+   updateFoundErrors(found, FsckCheck_WRONGINODEOWNERS);
+   errorCount += checkAndRepairWrongInodeOwner(found.wrongInodeOwners);
+   updateFoundErrors(found, FsckCheck_WRONGOWNERSINDENTRY);
+   errorCount += checkAndRepairWrongOwnerInDentry(found.wrongOwnersInDentry);
+   updateFoundErrors(found, FsckCheck_ORPHANEDCONTDIRS);
+   errorCount += checkAndRepairOrphanedContDir(found.orphanedContDirs);
+   updateFoundErrors(found, FsckCheck_ORPHANEDDIRINODES);
+   errorCount += checkAndRepairOrphanedDirInode(found.orphanedDirInodes);
+   updateFoundErrors(found, FsckCheck_ORPHANEDFILEINODES);
+   errorCount += checkAndRepairOrphanedFileInode(found.orphanedFileInodes);
+   updateFoundErrors(found, FsckCheck_DANGLINGDENTRIES);
+   errorCount += checkAndRepairDanglingDentry(found.danglingDentries);
+   updateFoundErrors(found, FsckCheck_ORPHANEDCHUNKS);
+   errorCount += checkAndRepairOrphanedChunk(found.orphanedChunks);
+   updateFoundErrors(found, FsckCheck_MISSINGCONTDIRS);
+   errorCount += checkAndRepairMissingContDir(found.missingContDirs);
+   updateFoundErrors(found, FsckCheck_WRONGFILEATTRIBS);
+   errorCount += checkAndRepairWrongFileAttribs(found.wrongFileAttribs);
+   updateFoundErrors(found, FsckCheck_WRONGDIRATTRIBS);
+   errorCount += checkAndRepairWrongDirAttribs(found.wrongDirAttribs);
 
    if ( cfg->getQuotaEnabled())
    {
-      errorCount += checkAndRepairChunksWithWrongPermissions();
+      updateFoundErrors(found, FsckCheck_CHUNKSWITHWRONGPERMISSIONS);
+      errorCount += checkAndRepairChunksWithWrongPermissions(found.chunksWithWrongPermissions);
    }
 
    if ( cfg->getReadOnly() )
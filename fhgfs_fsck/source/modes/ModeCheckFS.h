@@ -30,6 +30,60 @@ struct RepairChunkState
    FsckRepairAction lastChunkAction;
 };
 
+/*
+ * the database checks in the order in which their errors are repaired. the repairs modify the
+ * database, so the results of a check depend on the repairs of all checks before it (e.g. a
+ * recreated dir inode of an orphaned content dir is an orphaned dir inode itself).
+ */
+enum FsckCheck
+{
+   FsckCheck_DUPLICATEINODEIDS = 0,
+   FsckCheck_DUPLICATECHUNKS,
+   FsckCheck_FILESWITHMISSINGTARGETS,
+   FsckCheck_ORPHANEDDENTRYBYIDFILES,
+   FsckCheck_DIRENTRIESWITHBROKENBYIDFILE,
+   FsckCheck_CHUNKSINWRONGPATH,
+   FsckCheck_WRONGINODEOWNERS,
+   FsckCheck_WRONGOWNERSINDENTRY,
+   FsckCheck_ORPHANEDCONTDIRS,
+   FsckCheck_ORPHANEDDIRINODES,
+   FsckCheck_ORPHANEDFILEINODES,
+   FsckCheck_DANGLINGDENTRIES,
+   FsckCheck_ORPHANEDCHUNKS,
+   FsckCheck_MISSINGCONTDIRS,
+   FsckCheck_WRONGFILEATTRIBS,
+   FsckCheck_WRONGDIRATTRIBS,
+   FsckCheck_CHUNKSWITHWRONGPERMISSIONS,
+
+   FsckCheck_LAST = FsckCheck_CHUNKSWITHWRONGPERMISSIONS
+};
+
+/*
+ * results of the database checks. the checks only read the database, so they are all run
+ * concurrently before the first repair modifies it (see ModeCheckFS::findErrors() ). after that,
+ * each remaining check is run again right before its repairs.
+ */
+struct FsckFoundErrors
+{
+   std::vector<std::pair<db::EntryID, std::set<uint32_t> > > duplicateInodeIDs;
+   std::vector<std::list<FsckChunk> > duplicateChunks;
+   std::vector<db::DirEntry> filesWithMissingTargets;
+   std::vector<FsckFsID> orphanedDentryByIDFiles;
+   std::vector<db::DirEntry> dirEntriesWithBrokenByIDFile;
+   std::vector<std::pair<FsckChunk, FsckFileInode> > chunksInWrongPath;
+   std::vector<FsckDirInode> wrongInodeOwners;
+   std::vector<std::pair<db::DirEntry, uint16_t> > wrongOwnersInDentry;
+   std::vector<FsckContDir> orphanedContDirs;
+   std::vector<FsckDirInode> orphanedDirInodes;
+   std::vector<FsckFileInode> orphanedFileInodes;
+   std::vector<db::DirEntry> danglingDentries;
+   std::vector<FsckChunk> orphanedChunks;
+   std::vector<FsckDirInode> missingContDirs;
+   std::vector<std::pair<FsckFileInode, checks::InodeAttribs> > wrongFileAttribs;
+   std::vector<std::pair<FsckDirInode, checks::InodeAttribs> > wrongDirAttribs;
+   std::vector<std::pair<FsckChunk, FsckFileInode> > chunksWithWrongPermissions;
+};
+
 class ModeCheckFS : public Mode
 {
    public:
@@ -40,6 +94,9 @@ class ModeCheckFS : public Mode
 
       virtual int execute();
 
+      static void findErrors(FsckDB* database, FsckFoundErrors& found, FsckCheck first,
+         FsckCheck last);
+
    private:
       boost::scoped_ptr<FsckDB> database;
 
@@ -49,6 +106,8 @@ class ModeCheckFS : public Mode
       EntryInfo lostAndFoundInfo;
       boost::shared_ptr<FsckDirInode> lostAndFoundInode;
 
+      bool databaseRepaired; // true if a repair may have modified the database after findErrors()
+
       int initDatabase();
       void printHeaderInformation();
       FhgfsOpsErr gatherData(bool forceRestart);
@@ -57,29 +116,37 @@ class ModeCheckFS : public Mode
       int64_t checkAndRepairGeneric(Cursor<Obj> cursor,
          void (ModeCheckFS::*repair)(Obj&, State&), State& state);
 
-      int64_t checkAndRepairDanglingDentry();
-      int64_t checkAndRepairWrongInodeOwner();
-      int64_t checkAndRepairWrongOwnerInDentry();
-      int64_t checkAndRepairOrphanedContDir();
-      int64_t checkAndRepairOrphanedDirInode();
-      int64_t checkAndRepairOrphanedFileInode();
-      int64_t checkAndRepairOrphanedChunk();
-      int64_t checkAndRepairMissingContDir();
-      int64_t checkAndRepairWrongFileAttribs();
-      int64_t checkAndRepairWrongDirAttribs();
-      int64_t checkAndRepairFilesWithMissingTargets();
-      int64_t checkAndRepairDirEntriesWithBrokeByIDFile();
-      int64_t checkAndRepairOrphanedDentryByIDFiles();
-      int64_t checkAndRepairChunksWithWrongPermissions();
+      void updateFoundErrors(FsckFoundErrors& found, FsckCheck nextCheck);
+
+      int64_t checkAndRepairDanglingDentry(std::vector<db::DirEntry>& found);
+      int64_t checkAndRepairWrongInodeOwner(std::vector<FsckDirInode>& found);
+      int64_t checkAndRepairWrongOwnerInDentry(
+         std::vector<std::pair<db::DirEntry, uint16_t> >& found);
+      int64_t checkAndRepairOrphanedContDir(std::vector<FsckContDir>& found);
+      int64_t checkAndRepairOrphanedDirInode(std::vector<FsckDirInode>& found);
+      int64_t checkAndRepairOrphanedFileInode(std::vector<FsckFileInode>& found);
+      int64_t checkAndRepairOrphanedChunk(std::vector<FsckChunk>& found);
+      int64_t checkAndRepairMissingContDir(std::vector<FsckDirInode>& found);
+      int64_t checkAndRepairWrongFileAttribs(
+         std::vector<std::pair<FsckFileInode, checks::InodeAttribs> >& found);
+      int64_t checkAndRepairWrongDirAttribs(
+         std::vector<std::pair<FsckDirInode, checks::InodeAttribs> >& found);
+      int64_t checkAndRepairFilesWithMissingTargets(std::vector<db::DirEntry>& found);
+      int64_t checkAndRepairDirEntriesWithBrokeByIDFile(std::vector<db::DirEntry>& found);
+      int64_t checkAndRepairOrphanedDentryByIDFiles(std::vector<FsckFsID>& found);
+      int64_t checkAndRepairChunksWithWrongPermissions(
+         std::vector<std::pair<FsckChunk, FsckFileInode> >& found);
       int64_t checkMissingMirrorChunks();
       int64_t checkMissingPrimaryChunks();
       int64_t checkDifferingChunkAttribs();
-      int64_t checkAndRepairChunksInWrongPath();
+      int64_t checkAndRepairChunksInWrongPath(
+         std::vector<std::pair<FsckChunk, FsckFileInode> >& found);
 
-      int64_t checkDuplicateInodeIDs();
+      int64_t checkDuplicateInodeIDs(
+         std::vector<std::pair<db::EntryID, std::set<uint32_t> > >& found);
       void logDuplicateInodeID(std::pair<db::EntryID, std::set<uint32_t> >& dups, int&);
 
-      int64_t checkDuplicateChunks();
+      int64_t checkDuplicateChunks(std::vector<std::list<FsckChunk> >& found);
       void logDuplicateChunk(std::list<FsckChunk>& dups, int&);
 
       int64_t checkAndRepairMalformedChunk();
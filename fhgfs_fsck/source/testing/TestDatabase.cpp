@@ -6,6 +6,7 @@
 #include <common/toolkit/ListTk.h>
 #include <database/FsckDBException.h>
 #include <database/FsckDBTable.h>
+#include <modes/ModeCheckFS.h>
 #include <net/message/NetMessageFactory.h>
 #include <program/Program.h>
 #include <toolkit/DatabaseTk.h>
@@ -1374,6 +1375,41 @@ void TestDatabase::testCheckForAndInsertChunksInWrongPath()
    CPPUNIT_ASSERT(countCursor(this->db->findChunksInWrongPath() ) == NUM_WRONG_PATHS);
 }
 
+/*
+ * the repair of an orphaned content dir creates a dir inode without a dentry, which must be found
+ * by the orphaned dir inode check that follows it.
+ */
+void TestDatabase::testFindErrorsAfterRepair()
+{
+   FsckContDirList contDirs;
+   DatabaseTk::createDummyFsckContDirs(1, &contDirs);
+
+   this->db->getContDirsTable()->insert(contDirs);
+
+   FsckFoundErrors found;
+   ModeCheckFS::findErrors(this->db.get(), found, FsckCheck_DUPLICATEINODEIDS,
+      FsckCheck_WRONGDIRATTRIBS);
+
+   CPPUNIT_ASSERT(found.orphanedContDirs.size() == 1);
+   CPPUNIT_ASSERT(found.orphanedDirInodes.empty() );
+
+   // what the CREATEDEFAULTDIRINODE repair inserts into the database
+   FsckDirInodeList createdInodes;
+   DatabaseTk::createDummyFsckDirInodes(1, &createdInodes);
+   CPPUNIT_ASSERT(createdInodes.front().getID() == contDirs.front().getID() );
+
+   this->db->getDirInodesTable()->insert(createdInodes);
+
+   ModeCheckFS::findErrors(this->db.get(), found, FsckCheck_ORPHANEDDIRINODES,
+      FsckCheck_ORPHANEDDIRINODES);
+
+   CPPUNIT_ASSERT(found.orphanedDirInodes.size() == 1);
+   CPPUNIT_ASSERT(found.orphanedDirInodes.front().getID() == contDirs.front().getID() );
+
+   // only the requested checks were run again
+   CPPUNIT_ASSERT(found.orphanedContDirs.size() == 1);
+}
+
 void TestDatabase::testDeleteDentries()
 {
    unsigned NUM_ELEMENTS = 10;
@@ -52,6 +52,7 @@ class TestDatabase: public CppUnit::TestFixture
    CPPUNIT_TEST(testCheckForAndInsertFilesWithMissingStripeTargets);
    CPPUNIT_TEST(testCheckForAndInsertChunksWithWrongPermissions);
    CPPUNIT_TEST(testCheckForAndInsertChunksInWrongPath);
+   CPPUNIT_TEST(testFindErrorsAfterRepair);
 
    CPPUNIT_TEST(testDeleteDentries);
    CPPUNIT_TEST(testDeleteChunks);
@@ -112,6 +113,7 @@ class TestDatabase: public CppUnit::TestFixture
       void testCheckForAndInsertFilesWithMissingStripeTargets();
       void testCheckForAndInsertChunksWithWrongPermissions();
       void testCheckForAndInsertChunksInWrongPath();
+      void testFindErrorsAfterRepair();
 
       void testDeleteDentries();
       void testDeleteChunks();
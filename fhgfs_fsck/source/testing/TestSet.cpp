@@ -158,3 +158,36 @@ void TestSet::testDataOps()
    CPPUNIT_ASSERT(set.getByKeyProjection(7, ops::key).first);
    CPPUNIT_ASSERT(set.getByKeyProjection(7, ops::key).second.id == 1);
 }
+
+void TestSet::testParallelSort()
+{
+   // enough fragments for more than one round of merges
+   static const unsigned FRAG_COUNT = 4 * 4 + 1;
+   static const unsigned ITEMS_PER_FRAG = 64;
+
+   Set<Data> set(this->fileName);
+
+   for(unsigned i = 0; i < FRAG_COUNT; i++)
+   {
+      SetFragment<Data>* frag = set.newFragment();
+
+      // unsorted within the fragment, interleaved with all other fragments
+      for(unsigned j = ITEMS_PER_FRAG; j > 0; j--)
+      {
+         Data d = { (j - 1) * FRAG_COUNT + i, {} };
+         frag->append(d);
+      }
+   }
+
+   db::SortResources::get().configure(4, 0);
+   Set<Data>::Cursor cursor = set.cursor();
+   db::SortResources::get().configure(1, 0);
+
+   for(unsigned i = 0; i < FRAG_COUNT * ITEMS_PER_FRAG; i++)
+   {
+      CPPUNIT_ASSERT(cursor.step() );
+      CPPUNIT_ASSERT(cursor.get()->id == i);
+   }
+
+   CPPUNIT_ASSERT(!cursor.step() );
+}
@@ -16,6 +16,7 @@ class TestSet : public CppUnit::TestFixture, protected FlatTest
    CPPUNIT_TEST(testClear);
    CPPUNIT_TEST(testMerge);
    CPPUNIT_TEST(testDataOps);
+   CPPUNIT_TEST(testParallelSort);
 
    CPPUNIT_TEST_SUITE_END();
 
@@ -29,6 +30,7 @@ class TestSet : public CppUnit::TestFixture, protected FlatTest
       void testClear();
       void testMerge();
       void testDataOps();
+      void testParallelSort();
 };
 
 #endif
@@ -187,6 +187,54 @@ void TestSetFragment::testSortAndGet()
    CPPUNIT_ASSERT(frag.getByKeyProjection(23, ops::key).second.id == 17);
 }
 
+void TestSetFragment::testParallelSort()
+{
+   SetFragment<Data> frag(this->fileName);
+
+   // same sequence as above, large enough to be split into several sort runs
+   for (unsigned i = 0; i < 4003; i++)
+   {
+      Data d = { i * 4001 % 4003, {} };
+      frag.append(d);
+   }
+
+   db::SortResources::get().configure(4, 0);
+   frag.sort(4);
+   db::SortResources::get().configure(1, 0);
+
+   CPPUNIT_ASSERT(frag.size() == 4003);
+
+   for (unsigned i = 0; i < 4003; i++)
+      CPPUNIT_ASSERT(frag[i].id == i);
+}
+
+void TestSetFragment::testExternalSort()
+{
+   SetFragment<Data> frag(this->fileName);
+
+   // same sequence as above, but with a memory budget that holds only 64 items per run
+   for (unsigned i = 0; i < 4003; i++)
+   {
+      Data d = { i * 4001 % 4003, {} };
+      frag.append(d);
+   }
+
+   db::SortResources::get().configure(2, 64 * sizeof(Data) );
+   frag.sort(2);
+   db::SortResources::get().configure(1, 0);
+
+   CPPUNIT_ASSERT(frag.size() == 4003);
+
+   for (unsigned i = 0; i < 4003; i++)
+      CPPUNIT_ASSERT(frag[i].id == i);
+
+   // the merged file must replace the original one
+   SetFragment<Data> reopened(this->fileName);
+
+   CPPUNIT_ASSERT(reopened.size() == 4003);
+   CPPUNIT_ASSERT(reopened[4002].id == 4002);
+}
+
 void TestSetFragment::testRename()
 {
    SetFragment<Data> frag(this->fileName);
@@ -16,6 +16,8 @@ class TestSetFragment : public CppUnit::TestFixture, protected FlatTest
    CPPUNIT_TEST(testFlush);
    CPPUNIT_TEST(testAppendAndAccess);
    CPPUNIT_TEST(testSortAndGet);
+   CPPUNIT_TEST(testParallelSort);
+   CPPUNIT_TEST(testExternalSort);
    CPPUNIT_TEST(testRename);
 
    CPPUNIT_TEST_SUITE_END();
@@ -30,6 +32,8 @@ class TestSetFragment : public CppUnit::TestFixture, protected FlatTest
       void testFlush();
       void testAppendAndAccess();
       void testSortAndGet();
+      void testParallelSort();
+      void testExternalSort();
       void testRename();
 };
 
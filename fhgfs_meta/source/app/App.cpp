@@ -76,7 +76,9 @@ App::App(int argc, char** argv)
    this->rootDir = NULL;
    this->metaStore = NULL;
    this->ackStore = NULL;
+   this->chunkAttribsBatcher = NULL;
    this->sessions = NULL;
+   this->leaseStore = NULL;
    this->nodeOperationStats = NULL;
    this->netMessageFactory = NULL;
    this->inodesPath = NULL;
@@ -91,6 +93,7 @@ App::App(int argc, char** argv)
    this->fullRefresher = NULL;
    this->modificationEventFlusher = NULL;
    this->metadataMirrorer = NULL;
+   this->metaJournal = NULL;
 
    this->exceededQuotaStore = NULL;
 
@@ -123,13 +126,16 @@ App::~App()
    SAFE_DELETE(this->inodesPath);
    SAFE_DELETE(this->netMessageFactory);
    SAFE_DELETE(this->nodeOperationStats);
+   SAFE_DELETE(this->leaseStore);
    SAFE_DELETE(this->sessions);
+   SAFE_DELETE(this->chunkAttribsBatcher);
    SAFE_DELETE(this->ackStore);
    if(this->disposalDir && this->metaStore)
       this->metaStore->releaseDir(this->disposalDir->getID() );
    if(this->rootDir && this->metaStore)
       this->metaStore->releaseDir(this->rootDir->getID() );
    SAFE_DELETE(this->metaStore);
+   SAFE_DELETE(this->metaJournal);
    SAFE_DELETE(this->commSlaveQueue);
    SAFE_DELETE(this->workQueue);
    SAFE_DELETE(this->clientNodes);
@@ -347,6 +353,10 @@ void App::runNormal()
    NodeList emptyClientsList;
    clientSyncer->syncClients(&emptyClientsList, false);
 
+   // apply remaining journaled metadata updates (so that no replay is needed on next startup)
+   if(metaJournal)
+      metaJournal->stopApplying();
+
 
    log->log(Log_CRITICAL, "All components stopped. Exiting now!");
 }
@@ -501,8 +511,12 @@ void App::initDataObjects() throw(InvalidConfigException)
 
    this->ackStore = new AcknowledgmentStore();
 
+   this->chunkAttribsBatcher = new ChunkAttribsBatcher();
+
    this->sessions = new SessionStore();
 
+   this->leaseStore = new LeaseStore(cfg->getTuneAttribLeaseMS() );
+
    this->nodeOperationStats = new MetaNodeOpStats();
 
    this->exceededQuotaStore = new ExceededQuotaStore();
@@ -689,6 +703,23 @@ void App::initStorage() throw(InvalidConfigException)
             "(SysErr: " + System::getErrString() + ")");
    }
 
+   // metadata journal (replays the existing journal, so must be ready before metadata is read)
+   if(cfg->getStoreUseMetaJournal() )
+   {
+      if(!cfg->getStoreUseExtendedAttribs() )
+         throw InvalidConfigException("Metadata journal requires storeUseExtendedAttribs");
+
+      try
+      {
+         this->metaJournal = new MetaJournal(cfg->getTuneMetaJournalMaxPending() );
+      }
+      catch(ComponentInitException& e)
+      {
+         throw InvalidConfigException(std::string("Unable to initialize metadata journal: ") +
+            e.what() );
+      }
+   }
+
 }
 
 
@@ -834,6 +865,9 @@ void App::startComponents()
    // should not accept requests before the lists are downloaded
    InternodeSyncer::downloadAllExceededQuotaLists();
 
+   if(this->metaJournal)
+      this->metaJournal->startApplying();
+
    streamListenersStart();
 
    this->connAcceptor->start();
@@ -965,6 +999,9 @@ void App::streamListenersInit() throw(ComponentInitException)
       if(cfg->getTuneUseAggressiveStreamPoll() )
          listener->setUseAggressivePoll();
 
+      if(cfg->getTuneDrainPipelinedMsgs() )
+         listener->setDrainPipelinedMsgs();
+
       streamLisVec.push_back(listener);
    }
 }
@@ -19,6 +19,8 @@
 #include <common/toolkit/AcknowledgmentStore.h>
 #include <common/toolkit/NetFilter.h>
 #include <components/fullrefresher/FullRefresher.h>
+#include <components/ChunkAttribsBatcher.h>
+#include <components/metajournal/MetaJournal.h>
 #include <components/metadatamirrorer/MetadataMirrorer.h>
 #include <components/ClientSyncer.h>
 #include <components/DatagramListener.h>
@@ -29,6 +31,7 @@
 #include <nodes/NodeStoreEx.h>
 #include <nodes/NodeStoreClientsEx.h>
 #include <nodes/NodeStoreServersEx.h>
+#include <session/LeaseStore.h>
 #include <session/SessionStore.h>
 #include <storage/DirInode.h>
 #include <storage/MetaStore.h>
@@ -118,7 +121,9 @@ class App : public AbstractApp
       DirInode* disposalDir;
 
       SessionStore* sessions;
+      LeaseStore* leaseStore;
       AcknowledgmentStore* ackStore;
+      ChunkAttribsBatcher* chunkAttribsBatcher;
       MetaNodeOpStats* nodeOperationStats; // file system operation statistics
 
       std::string metaPathStr; // the general parent directory for all saved data
@@ -134,6 +139,7 @@ class App : public AbstractApp
       FullRefresher* fullRefresher;
       ModificationEventFlusher* modificationEventFlusher;
       MetadataMirrorer* metadataMirrorer;
+      MetaJournal* metaJournal; // NULL if disabled
 
       unsigned numStreamListeners; // value copied from cfg (for performance)
       StreamLisVec streamLisVec;
@@ -296,6 +302,11 @@ class App : public AbstractApp
          return ackStore;
       }
 
+      ChunkAttribsBatcher* getChunkAttribsBatcher() const
+      {
+         return chunkAttribsBatcher;
+      }
+
       Config* getConfig() const
       {
          return cfg;
@@ -401,6 +412,11 @@ class App : public AbstractApp
          return sessions;
       }
 
+      LeaseStore* getLeaseStore() const
+      {
+         return leaseStore;
+      }
+
       std::string getMetaPath() const
       {
          return metaPathStr;
@@ -466,6 +482,11 @@ class App : public AbstractApp
          return metadataMirrorer;
       }
 
+      MetaJournal* getMetaJournal() const
+      {
+         return metaJournal;
+      }
+
       WorkerList* getWorkers()
       {
          return &workerList;
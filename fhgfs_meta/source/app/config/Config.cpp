@@ -51,6 +51,8 @@ void Config::loadDefaults(bool addDashes)
    configMapRedefine("storeAllowFirstRunInit",     "true");
    configMapRedefine("storeUseExtendedAttribs",    "true");
    configMapRedefine("storeSelfHealEmptyFiles",    "true");
+   configMapRedefine("storeUseMetaJournal",        "false");
+   configMapRedefine("storeUseDentryIndex",        "false");
 
    configMapRedefine("storeClientXAttrs",          "false");
    configMapRedefine("storeClientACLs",            "false");
@@ -81,6 +83,11 @@ void Config::loadDefaults(bool addDashes)
    configMapRedefine("tuneEarlyUnlinkResponse",    "true");
    configMapRedefine("tuneUsePerUserMsgQueues",    "false");
    configMapRedefine("tuneUseAggressiveStreamPoll","false");
+   configMapRedefine("tuneDrainPipelinedMsgs",     "false");
+   configMapRedefine("tuneMetaJournalMaxPending",  "4096");
+   configMapRedefine("tuneDynAttribsCacheMS",      "0");
+   configMapRedefine("tuneDirEntryCacheLimit",     "0");
+   configMapRedefine("tuneAttribLeaseMS",          "0");
 
    configMapRedefine("quotaEarlyChownResponse",    "true");
    configMapRedefine("quotaEnableEnforcement",     "false");
@@ -132,6 +139,12 @@ void Config::applyConfigMap(bool enableException, bool addDashes) throw(InvalidC
       if(iter->first == std::string("storeSelfHealEmptyFiles") )
          storeSelfHealEmptyFiles = StringTk::strToBool(iter->second);
       else
+      if(iter->first == std::string("storeUseMetaJournal") )
+         storeUseMetaJournal = StringTk::strToBool(iter->second);
+      else
+      if(iter->first == std::string("storeUseDentryIndex") )
+         storeUseDentryIndex = StringTk::strToBool(iter->second);
+      else
       if(iter->first == std::string("storeClientXAttrs") )
          storeClientXAttrs = StringTk::strToBool(iter->second);
       else
@@ -209,6 +222,21 @@ void Config::applyConfigMap(bool enableException, bool addDashes) throw(InvalidC
       if(iter->first == std::string("tuneUseAggressiveStreamPoll") )
          tuneUseAggressiveStreamPoll = StringTk::strToBool(iter->second);
       else
+      if(iter->first == std::string("tuneDrainPipelinedMsgs") )
+         tuneDrainPipelinedMsgs = StringTk::strToBool(iter->second);
+      else
+      if(iter->first == std::string("tuneMetaJournalMaxPending") )
+         tuneMetaJournalMaxPending = StringTk::strToUInt(iter->second);
+      else
+      if(iter->first == std::string("tuneDynAttribsCacheMS") )
+         tuneDynAttribsCacheMS = StringTk::strToUInt(iter->second);
+      else
+      if(iter->first == std::string("tuneDirEntryCacheLimit") )
+         tuneDirEntryCacheLimit = StringTk::strToUInt(iter->second);
+      else
+      if(iter->first == std::string("tuneAttribLeaseMS") )
+         tuneAttribLeaseMS = StringTk::strToUInt(iter->second);
+      else
       if(iter->first == std::string("quotaEarlyChownResponse") )
          quotaEarlyChownResponse = StringTk::strToBool(iter->second);
       else
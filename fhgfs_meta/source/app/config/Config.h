@@ -37,6 +37,8 @@ class Config : public AbstractConfig
       bool              storeAllowFirstRunInit;
       bool              storeUseExtendedAttribs;
       bool              storeSelfHealEmptyFiles;
+      bool              storeUseMetaJournal; // true to log xattr metadata updates to a journal
+      bool              storeUseDentryIndex; // true to keep a packed dentry index per directory
 
       bool              storeClientXAttrs;
       bool              storeClientACLs;
@@ -68,6 +70,11 @@ class Config : public AbstractConfig
       bool              tuneEarlyUnlinkResponse; // true to send response before chunk files unlink
       bool              tuneUsePerUserMsgQueues; // true to use UserWorkContainer for MultiWorkQueue
       bool              tuneUseAggressiveStreamPoll; // true to not sleep on epoll in streamlisv2
+      bool              tuneDrainPipelinedMsgs; // true to dispatch pipelined msgs of a conn directly
+      unsigned          tuneMetaJournalMaxPending; // max journaled updates not applied yet
+      unsigned          tuneDynAttribsCacheMS; // reuse refreshed chunk attribs this long (0=off)
+      unsigned          tuneDirEntryCacheLimit; // max cached dentries per cached dir (0=off)
+      unsigned          tuneAttribLeaseMS; // client dentry/attrib lease duration (0=off)
 
       bool              quotaEarlyChownResponse; // true to send response before chunk files chown
       bool              quotaEnableEnforcement;
@@ -139,6 +146,16 @@ class Config : public AbstractConfig
          return storeSelfHealEmptyFiles;
       }
 
+      bool getStoreUseMetaJournal() const
+      {
+         return storeUseMetaJournal;
+      }
+
+      bool getStoreUseDentryIndex() const
+      {
+         return storeUseDentryIndex;
+      }
+
       bool getStoreBacklinksEnabled() const
       {
          return storeBacklinksEnabled;
@@ -264,6 +281,31 @@ class Config : public AbstractConfig
          return tuneUseAggressiveStreamPoll;
       }
 
+      bool getTuneDrainPipelinedMsgs() const
+      {
+         return tuneDrainPipelinedMsgs;
+      }
+
+      unsigned getTuneMetaJournalMaxPending() const
+      {
+         return tuneMetaJournalMaxPending;
+      }
+
+      unsigned getTuneDynAttribsCacheMS() const
+      {
+         return tuneDynAttribsCacheMS;
+      }
+
+      unsigned getTuneDirEntryCacheLimit() const
+      {
+         return tuneDirEntryCacheLimit;
+      }
+
+      unsigned getTuneAttribLeaseMS() const
+      {
+         return tuneAttribLeaseMS;
+      }
+
       bool getQuotaEarlyChownResponse() const
       {
          return quotaEarlyChownResponse;
@@ -0,0 +1,416 @@
+#include <common/net/message/storage/attribs/GetChunkFileAttribsMsg.h>
+#include <common/net/message/storage/attribs/GetChunkFileAttribsMultiMsg.h>
+#include <common/net/message/storage/attribs/GetChunkFileAttribsMultiRespMsg.h>
+#include <common/net/message/storage/attribs/GetChunkFileAttribsRespMsg.h>
+#include <common/nodes/NodeFeatureFlags.h>
+#include <common/toolkit/MessagingTk.h>
+#include <components/worker/GetChunkFileAttribsMultiWork.h>
+#include <program/Program.h>
+#include <storage/FileInode.h>
+#include "ChunkAttribsBatcher.h"
+
+
+typedef std::pair<uint32_t, ChunkAttribsBatch*> ChunkAttribsBatchToSend; // key and batch
+typedef std::list<ChunkAttribsBatchToSend> ChunkAttribsBatchToSendList;
+typedef ChunkAttribsBatchToSendList::iterator ChunkAttribsBatchToSendListIter;
+
+
+/**
+ * Get fresh dynamic attribs of all chunks of a file.
+ *
+ * Note: For buddymirrored files, only group's primary is used.
+ *
+ * @param msgUserID only used for msg header info.
+ * @param outDynAttribsVec will be resized to the number of stripe targets; entries of failed
+ *    targets are left with storageVersion 0 (i.e. invalid).
+ * @return error of a failed target if any, FhgfsOpsErr_SUCCESS otherwise.
+ */
+FhgfsOpsErr ChunkAttribsBatcher::refreshDynAttribs(FileInode* inode, std::string& entryID,
+   unsigned msgUserID, DynamicFileAttribsVec& outDynAttribsVec)
+{
+   const char* logContext = "Chunk attribs batcher (refresh)";
+
+   FhgfsOpsErr retVal = FhgfsOpsErr_SUCCESS;
+
+   StripePattern* pattern = inode->getStripePattern();
+   const UInt16Vector* targetIDs = pattern->getStripeTargetIDs();
+   bool isBuddyMirror = (pattern->getPatternType() == STRIPEPATTERN_BuddyMirror);
+
+   size_t numTargets = targetIDs->size();
+
+   outDynAttribsVec.resize(numTargets);
+
+   FhgfsOpsErrVec nodeResults(numTargets, FhgfsOpsErr_SUCCESS);
+   SynchronizedCounter counter;
+
+   PathInfo pathInfo;
+   inode->getPathInfo(&pathInfo);
+
+   ChunkAttribsBatchToSendList batchesToSend; // targets for which we are the sender
+
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   for(size_t i=0; i < numTargets; i++)
+   {
+      uint32_t key = getKey( (*targetIDs)[i], isBuddyMirror);
+
+      ChunkAttribsTargetQueue& queue = targetQueues[key];
+      ChunkAttribsBatchEntry& entry = queue.pendingBatch[entryID]; // (merges concurrent requests)
+
+      entry.pathInfo = pathInfo;
+
+      ChunkAttribsWaiter waiter = { &outDynAttribsVec[i], &nodeResults[i], &counter };
+      entry.waiters.push_back(waiter);
+
+      if(!queue.sendInProgress)
+      { // nobody is sending to this target right now => send pending batch (incl. our entry)
+         ChunkAttribsBatch* batch = new ChunkAttribsBatch();
+         batch->swap(queue.pendingBatch);
+
+         queue.sendInProgress = true;
+
+         batchesToSend.push_back(ChunkAttribsBatchToSend(key, batch) );
+      }
+
+      // (otherwise the current sender of this target will send our entry when it's done)
+   }
+
+   mutexLock.unlock(); // U N L O C K
+
+   if(!batchesToSend.empty() )
+   {
+      // we send the first batch ourselves and the others in parallel through comm slaves
+
+      MultiWorkQueue* slaveQ = Program::getApp()->getCommSlaveQueue();
+
+      ChunkAttribsBatchToSendListIter iter = batchesToSend.begin();
+
+      for(iter++; iter != batchesToSend.end(); iter++)
+      {
+         GetChunkFileAttribsMultiWork* work = new GetChunkFileAttribsMultiWork(
+            iter->first, iter->second, msgUserID);
+
+         slaveQ->addDirectWork(work);
+      }
+
+      ChunkAttribsBatchToSend& ownBatch = batchesToSend.front();
+
+      sendBatch(ownBatch.first, ownBatch.second, msgUserID);
+      delete(ownBatch.second);
+
+      finishBatch(ownBatch.first, msgUserID);
+   }
+
+   counter.waitForCount(numTargets);
+
+   for(size_t i=0; i < numTargets; i++)
+   {
+      if(nodeResults[i] != FhgfsOpsErr_SUCCESS)
+      {
+         LogContext(logContext).log(Log_WARNING,
+            "Problems occurred during file attribs refresh. entryID: " + entryID);
+
+         retVal = nodeResults[i];
+         break;
+      }
+   }
+
+   return retVal;
+}
+
+/**
+ * Send the batch (in multiple msgs if necessary) and hand the results to the waiters.
+ *
+ * Note: Caller must call finishBatch() afterwards.
+ *
+ * @param batch will not be freed by this method.
+ */
+void ChunkAttribsBatcher::sendBatch(uint32_t key, ChunkAttribsBatch* batch, unsigned msgUserID)
+{
+   uint16_t targetID = getTargetIDFromKey(key);
+   bool isBuddyMirror = getIsBuddyMirrorFromKey(key);
+
+   ChunkAttribsBatchIter partStart = batch->begin();
+
+   while(partStart != batch->end() )
+   {
+      ChunkAttribsBatchIter partEnd = partStart;
+
+      for(size_t numEntries = 0;
+          (partEnd != batch->end() ) && (numEntries < GETCHUNKFILEATTRIBSMULTIMSG_MAX_ENTRIES);
+          numEntries++)
+         partEnd++;
+
+      sendBatchPart(targetID, isBuddyMirror, partStart, partEnd, msgUserID);
+
+      partStart = partEnd;
+   }
+}
+
+/**
+ * Called by the sender of a target after sendBatch() to send the next pending batch of this
+ * target (through a comm slave) or to mark the target as idle if there is nothing pending.
+ */
+void ChunkAttribsBatcher::finishBatch(uint32_t key, unsigned msgUserID)
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   ChunkAttribsTargetQueue& queue = targetQueues[key];
+
+   if(queue.pendingBatch.empty() )
+   { // nothing to do
+      queue.sendInProgress = false;
+
+      mutexLock.unlock(); // U N L O C K
+
+      return;
+   }
+
+   ChunkAttribsBatch* batch = new ChunkAttribsBatch();
+   batch->swap(queue.pendingBatch);
+
+   mutexLock.unlock(); // U N L O C K
+
+   GetChunkFileAttribsMultiWork* work = new GetChunkFileAttribsMultiWork(key, batch, msgUserID);
+
+   Program::getApp()->getCommSlaveQueue()->addDirectWork(work);
+}
+
+/**
+ * Send a single GetChunkFileAttribsMultiMsg for the entries from partStart to partEnd (exclusive)
+ * and hand the results to the waiters.
+ *
+ * The results are handed over directly from the receive buffer of the response, so they are not
+ * copied into intermediate lists.
+ *
+ * Storage servers that don't support GetChunkFileAttribsMultiMsg (older versions) are queried
+ * through sendBatchPartSingle() instead.
+ */
+void ChunkAttribsBatcher::sendBatchPart(uint16_t targetID, bool isBuddyMirror,
+   ChunkAttribsBatchIter partStart, ChunkAttribsBatchIter partEnd, unsigned msgUserID)
+{
+   const char* logContext = "Chunk attribs batcher (send msg)";
+
+   App* app = Program::getApp();
+
+   if(!getTargetSupportsMultiMsg(targetID, isBuddyMirror) )
+   {
+      sendBatchPartSingle(targetID, isBuddyMirror, partStart, partEnd, msgUserID);
+      return;
+   }
+
+   StringList entryIDs;
+   PathInfoList pathInfos;
+
+   for(ChunkAttribsBatchIter entryIter = partStart; entryIter != partEnd; entryIter++)
+   {
+      entryIDs.push_back(entryIter->first);
+      pathInfos.push_back(entryIter->second.pathInfo);
+   }
+
+   GetChunkFileAttribsMultiMsg getAttribsMsg(targetID, &entryIDs, &pathInfos);
+
+   if(isBuddyMirror)
+      getAttribsMsg.addMsgHeaderFeatureFlag(GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR);
+
+   getAttribsMsg.setMsgHeaderUserID(msgUserID);
+
+   // prepare communication
+
+   RequestResponseTarget rrTarget(targetID, app->getTargetMapper(), app->getStorageNodes() );
+
+   rrTarget.setTargetStates(app->getTargetStateStore() );
+
+   if(isBuddyMirror)
+      rrTarget.setMirrorInfo(app->getMirrorBuddyGroupMapper(), false);
+
+   RequestResponseArgs rrArgs(NULL, &getAttribsMsg, NETMSGTYPE_GetChunkFileAttribsMultiResp);
+
+   // communicate
+
+   FhgfsOpsErr requestRes = MessagingTk::requestResponseTarget(&rrTarget, &rrArgs);
+
+   if(unlikely(requestRes == FhgfsOpsErr_INTERNAL) )
+   { /* unexpected response type or generic response (e.g. from a storage server of another
+        version than announced in its last heartbeat) => try single msgs */
+      LogContext(logContext).log(Log_DEBUG,
+         "Unexpected response to batched chunk attribs request, falling back to single msgs. " +
+         std::string(isBuddyMirror ? "Mirror " : "") +
+         "TargetID: " + StringTk::uintToStr(targetID) );
+
+      sendBatchPartSingle(targetID, isBuddyMirror, partStart, partEnd, msgUserID);
+      return;
+   }
+
+   if(unlikely(requestRes != FhgfsOpsErr_SUCCESS) )
+   { // communication error
+      LogContext(logContext).log(Log_WARNING,
+         "Communication with storage target failed. " +
+         std::string(isBuddyMirror ? "Mirror " : "") +
+         "TargetID: " + StringTk::uintToStr(targetID) + "; "
+         "Number of entries: " + StringTk::uintToStr(entryIDs.size() ) );
+
+      notifyWaiters(partStart, partEnd, requestRes);
+      return;
+   }
+
+   // correct response type received
+   GetChunkFileAttribsMultiRespMsg* respMsg =
+      (GetChunkFileAttribsMultiRespMsg*)rrArgs.outRespMsg;
+
+   if(unlikely(respMsg->getNumEntries() != entryIDs.size() ) )
+   {
+      LogContext(logContext).logErr("Received invalid response from storage target. " +
+         std::string(isBuddyMirror ? "Mirror " : "") +
+         "TargetID: " + StringTk::uintToStr(targetID) );
+
+      notifyWaiters(partStart, partEnd, FhgfsOpsErr_COMMUNICATION);
+      return;
+   }
+
+   // hand results to waiters
+
+   unsigned entryIndex = 0;
+
+   for(ChunkAttribsBatchIter entryIter = partStart;
+       entryIter != partEnd;
+       entryIter++, entryIndex++)
+   {
+      FhgfsOpsErr entryRes = respMsg->getResult(entryIndex);
+      DynamicFileAttribs entryDynAttribs; // (storageVersion 0 => invalid)
+
+      if(entryRes == FhgfsOpsErr_SUCCESS)
+         respMsg->parseDynAttribs(entryIndex, &entryDynAttribs);
+      else
+         LogContext(logContext).log(Log_WARNING,
+            "Getting chunk file attributes from target failed. " +
+            std::string(isBuddyMirror ? "Mirror " : "") +
+            "TargetID: " + StringTk::uintToStr(targetID) + "; "
+            "EntryID: " + entryIter->first);
+
+      notifyWaiters(entryIter->second.waiters, entryRes, entryDynAttribs);
+   }
+}
+
+/**
+ * Fallback for storage servers without GetChunkFileAttribsMultiMsg support: Send one
+ * GetChunkFileAttribsMsg per entry from partStart to partEnd (exclusive) and hand the results to
+ * the waiters.
+ */
+void ChunkAttribsBatcher::sendBatchPartSingle(uint16_t targetID, bool isBuddyMirror,
+   ChunkAttribsBatchIter partStart, ChunkAttribsBatchIter partEnd, unsigned msgUserID)
+{
+   const char* logContext = "Chunk attribs batcher (send single msgs)";
+
+   App* app = Program::getApp();
+
+   for(ChunkAttribsBatchIter entryIter = partStart; entryIter != partEnd; entryIter++)
+   {
+      std::string entryID = entryIter->first;
+      DynamicFileAttribs entryDynAttribs; // (storageVersion 0 => invalid)
+
+      GetChunkFileAttribsMsg getAttribsMsg(entryID, targetID, &entryIter->second.pathInfo);
+
+      if(isBuddyMirror)
+         getAttribsMsg.addMsgHeaderFeatureFlag(GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR);
+
+      getAttribsMsg.setMsgHeaderUserID(msgUserID);
+
+      // prepare communication
+
+      RequestResponseTarget rrTarget(targetID, app->getTargetMapper(), app->getStorageNodes() );
+
+      rrTarget.setTargetStates(app->getTargetStateStore() );
+
+      if(isBuddyMirror)
+         rrTarget.setMirrorInfo(app->getMirrorBuddyGroupMapper(), false);
+
+      RequestResponseArgs rrArgs(NULL, &getAttribsMsg, NETMSGTYPE_GetChunkFileAttribsResp);
+
+      // communicate
+
+      FhgfsOpsErr entryRes = MessagingTk::requestResponseTarget(&rrTarget, &rrArgs);
+
+      if(unlikely(entryRes != FhgfsOpsErr_SUCCESS) )
+      { // communication error
+         LogContext(logContext).log(Log_WARNING,
+            "Communication with storage target failed. " +
+            std::string(isBuddyMirror ? "Mirror " : "") +
+            "TargetID: " + StringTk::uintToStr(targetID) + "; "
+            "EntryID: " + entryID);
+
+         notifyWaiters(entryIter->second.waiters, entryRes, entryDynAttribs);
+         continue;
+      }
+
+      // correct response type received
+      GetChunkFileAttribsRespMsg* respMsg = (GetChunkFileAttribsRespMsg*)rrArgs.outRespMsg;
+
+      entryRes = respMsg->getResult();
+
+      if(entryRes == FhgfsOpsErr_SUCCESS)
+         entryDynAttribs = DynamicFileAttribs(respMsg->getStorageVersion(), respMsg->getSize(),
+            respMsg->getAllocedBlocks(), respMsg->getModificationTimeSecs(),
+            respMsg->getLastAccessTimeSecs() );
+      else
+         LogContext(logContext).log(Log_WARNING,
+            "Getting chunk file attributes from target failed. " +
+            std::string(isBuddyMirror ? "Mirror " : "") +
+            "TargetID: " + StringTk::uintToStr(targetID) + "; "
+            "EntryID: " + entryID);
+
+      notifyWaiters(entryIter->second.waiters, entryRes, entryDynAttribs);
+   }
+}
+
+/**
+ * Check if the storage server of the given target (or of the primary of the given buddy group)
+ * supports GetChunkFileAttribsMultiMsg.
+ *
+ * @return true if supported or if the server is unknown (so that the usual error handling of the
+ *    multi msg request applies).
+ */
+bool ChunkAttribsBatcher::getTargetSupportsMultiMsg(uint16_t targetID, bool isBuddyMirror)
+{
+   App* app = Program::getApp();
+   NodeStoreServersEx* storageNodes = app->getStorageNodes();
+
+   if(isBuddyMirror)
+      targetID = app->getMirrorBuddyGroupMapper()->getPrimaryTargetID(targetID);
+
+   Node* node = storageNodes->referenceNodeByTargetID(targetID, app->getTargetMapper() );
+   if(!node)
+      return true;
+
+   bool supportsMultiMsg = node->hasFeature(STORAGE_FEATURE_CHUNKATTRIBSMULTI);
+
+   storageNodes->releaseNode(&node);
+
+   return supportsMultiMsg;
+}
+
+/**
+ * Hand the same error to the waiters of all entries from partStart to partEnd (exclusive).
+ */
+void ChunkAttribsBatcher::notifyWaiters(ChunkAttribsBatchIter partStart,
+   ChunkAttribsBatchIter partEnd, FhgfsOpsErr result)
+{
+   DynamicFileAttribs invalidDynAttribs; // (storageVersion 0 => invalid)
+
+   for(ChunkAttribsBatchIter entryIter = partStart; entryIter != partEnd; entryIter++)
+      notifyWaiters(entryIter->second.waiters, result, invalidDynAttribs);
+}
+
+void ChunkAttribsBatcher::notifyWaiters(ChunkAttribsWaiterList& waiters, FhgfsOpsErr result,
+   DynamicFileAttribs& dynAttribs)
+{
+   for(ChunkAttribsWaiterListIter waiterIter = waiters.begin();
+       waiterIter != waiters.end();
+       waiterIter++)
+   {
+      *waiterIter->outDynAttribs = dynAttribs;
+      *waiterIter->outResult = result;
+
+      waiterIter->counter->incCount(); // (waiter might be gone after this)
+   }
+}
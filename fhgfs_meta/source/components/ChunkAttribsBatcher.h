@@ -0,0 +1,119 @@
+#ifndef CHUNKATTRIBSBATCHER_H_
+#define CHUNKATTRIBSBATCHER_H_
+
+#include <common/storage/striping/DynamicFileAttribs.h>
+#include <common/storage/PathInfo.h>
+#include <common/storage/StorageErrors.h>
+#include <common/threading/Mutex.h>
+#include <common/threading/SafeMutexLock.h>
+#include <common/toolkit/SynchronizedCounter.h>
+#include <common/Common.h>
+
+
+class FileInode; // forward declaration
+
+
+/**
+ * A caller waiting for the attribs of a chunk file.
+ */
+struct ChunkAttribsWaiter
+{
+   DynamicFileAttribs* outDynAttribs;
+   FhgfsOpsErr* outResult;
+   SynchronizedCounter* counter; // incremented after outDynAttribs and outResult have been set
+};
+
+typedef std::list<ChunkAttribsWaiter> ChunkAttribsWaiterList;
+typedef ChunkAttribsWaiterList::iterator ChunkAttribsWaiterListIter;
+
+
+/**
+ * A chunk file in a batch with all callers that are waiting for its attribs.
+ */
+struct ChunkAttribsBatchEntry
+{
+   PathInfo pathInfo;
+   ChunkAttribsWaiterList waiters;
+};
+
+typedef std::map<std::string, ChunkAttribsBatchEntry> ChunkAttribsBatch; // key: entryID
+typedef ChunkAttribsBatch::iterator ChunkAttribsBatchIter;
+
+
+/**
+ * Batches of a single storage target (or buddy group).
+ */
+struct ChunkAttribsTargetQueue
+{
+   ChunkAttribsTargetQueue() : sendInProgress(false) {}
+
+   bool sendInProgress; // true while a batch of this target is being sent
+   ChunkAttribsBatch pendingBatch; // to be sent when the current send is done
+};
+
+typedef std::map<uint32_t, ChunkAttribsTargetQueue> ChunkAttribsTargetQueueMap; // key: see getKey()
+typedef ChunkAttribsTargetQueueMap::iterator ChunkAttribsTargetQueueMapIter;
+
+
+/**
+ * Retrieves the dynamic attribs (size etc.) of chunk files from the storage targets in batches.
+ *
+ * Each target has at most one GetChunkFileAttribsMulti request in flight. Chunks that are
+ * requested while a request to their target is in flight are collected and sent together in the
+ * next request as soon as the current one is done. Requests for the same chunk in a pending batch
+ * are merged into a single entry.
+ * So stats of many open files (e.g. "ls -l") result in few round-trips per target, while a single
+ * stat is sent right away without any delay.
+ */
+class ChunkAttribsBatcher
+{
+   public:
+      ChunkAttribsBatcher() {}
+
+      FhgfsOpsErr refreshDynAttribs(FileInode* inode, std::string& entryID, unsigned msgUserID,
+         DynamicFileAttribsVec& outDynAttribsVec);
+
+      void sendBatch(uint32_t key, ChunkAttribsBatch* batch, unsigned msgUserID);
+      void finishBatch(uint32_t key, unsigned msgUserID);
+
+
+   private:
+      Mutex mutex; // protects targetQueues
+      ChunkAttribsTargetQueueMap targetQueues;
+
+      void sendBatchPart(uint16_t targetID, bool isBuddyMirror, ChunkAttribsBatchIter partStart,
+         ChunkAttribsBatchIter partEnd, unsigned msgUserID);
+      void sendBatchPartSingle(uint16_t targetID, bool isBuddyMirror,
+         ChunkAttribsBatchIter partStart, ChunkAttribsBatchIter partEnd, unsigned msgUserID);
+
+      static bool getTargetSupportsMultiMsg(uint16_t targetID, bool isBuddyMirror);
+
+      static void notifyWaiters(ChunkAttribsBatchIter partStart, ChunkAttribsBatchIter partEnd,
+         FhgfsOpsErr result);
+      static void notifyWaiters(ChunkAttribsWaiterList& waiters, FhgfsOpsErr result,
+         DynamicFileAttribs& dynAttribs);
+
+
+   public:
+      // inliners
+
+      /**
+       * @return key for targetQueues (buddy group IDs and target IDs may overlap)
+       */
+      static uint32_t getKey(uint16_t targetID, bool isBuddyMirror)
+      {
+         return isBuddyMirror ? (targetID | (1 << 16) ) : targetID;
+      }
+
+      static uint16_t getTargetIDFromKey(uint32_t key)
+      {
+         return (uint16_t)key;
+      }
+
+      static bool getIsBuddyMirrorFromKey(uint32_t key)
+      {
+         return (key >> 16) != 0;
+      }
+};
+
+#endif /* CHUNKATTRIBSBATCHER_H_ */
@@ -62,12 +62,14 @@ void InternodeSyncer::syncLoop()
    const unsigned idleDisconnectIntervalMS = 70*60*1000; /* 70 minutes (must be less than half the
       streamlis idle disconnect interval to avoid cases where streamlis disconnects first) */
    const unsigned updateIDTimeMS = 60 * 1000; // 1 min
+   const unsigned leasePruneMS = 60 * 1000; // 1 min
 
    Time lastCapacityUpdateT;
    Time lastMetaCacheSweepT;
    Time lastIdleDisconnectT;
    Time lastTimeIDSet;
    Time lastTargetStatesUpdateT;
+   Time lastLeasePruneT;
 
    unsigned currentCacheSweepMS = metaCacheSweepNormalMS; // (adapted inside the loop below)
 
@@ -111,6 +113,12 @@ void InternodeSyncer::syncLoop()
          lastTimeIDSet.setToNow();
       }
 
+      if(lastLeasePruneT.elapsedMS() > leasePruneMS)
+      {
+         app->getLeaseStore()->pruneExpired();
+         lastLeasePruneT.setToNow();
+      }
+
       if(doTargetStatesUpdate)
       {
          publishNodeState();
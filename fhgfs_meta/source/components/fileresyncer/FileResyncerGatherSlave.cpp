@@ -124,7 +124,8 @@ int FileResyncerGatherSlave::handleDiscoveredDentriesSubentry(const char* path,
 
    if( (ftwEntryType == FTW_D) && (ftwBuf->level >= FILERESYNCGATHER_DENTRY_DEPTH) )
    { // directory too deep to be interesting for us
-      LogContext(logContext).log(Log_SPAM, std::string("Skipping subtree: ") + path);
+      if(LogContext::isLevelEnabledForThread(Log_SPAM) ) // (called for each hash dir)
+         LogContext(logContext).log(Log_SPAM, std::string("Skipping subtree: ") + path);
 
       return FTW_SKIP_SUBTREE;
    }
@@ -133,7 +134,8 @@ int FileResyncerGatherSlave::handleDiscoveredDentriesSubentry(const char* path,
 
    if( (ftwEntryType != FTW_F) || (ftwBuf->level != FILERESYNCGATHER_DENTRY_DEPTH) )
    { // not a file or a file at the wrong depth level
-      if(ftwEntryType != FTW_D) // don't spam log with all hash dirs (only print other entry types)
+      if( (ftwEntryType != FTW_D) && // don't spam log with all hash dirs (only print other types)
+          LogContext::isLevelEnabledForThread(Log_SPAM) )
          LogContext(logContext).log(
             Log_SPAM, std::string("Skipping entry: ") + path + "; "
             "type: " + getFtwEntryTypeStr(ftwEntryType) );
@@ -245,7 +247,8 @@ int FileResyncerGatherSlave::handleDiscoveredInodesSubentry(const char* path,
 
    if( (ftwEntryType == FTW_D) && (ftwBuf->level >= FILERESYNCGATHER_DENTRY_DEPTH) )
    { // directory too deep to be interesting for us
-      LogContext(logContext).log(Log_SPAM, std::string("Skipping subtree: ") + path);
+      if(LogContext::isLevelEnabledForThread(Log_SPAM) ) // (called for each hash dir)
+         LogContext(logContext).log(Log_SPAM, std::string("Skipping subtree: ") + path);
 
       return FTW_SKIP_SUBTREE;
    }
@@ -254,7 +257,8 @@ int FileResyncerGatherSlave::handleDiscoveredInodesSubentry(const char* path,
 
    if( (ftwEntryType != FTW_F) || (ftwBuf->level != FILERESYNCGATHER_DENTRY_DEPTH) )
    { // not a file or a file at the wrong depth level
-      if(ftwEntryType != FTW_D) // don't spam log with all hash dirs (only print other entry types)
+      if( (ftwEntryType != FTW_D) && // don't spam log with all hash dirs (only print other types)
+          LogContext::isLevelEnabledForThread(Log_SPAM) )
          LogContext(logContext).log(
             Log_SPAM, std::string("Skipping entry: ") + path + "; "
             "type: " + getFtwEntryTypeStr(ftwEntryType) );
@@ -1,6 +1,7 @@
 #include <common/app/log/LogContext.h>
 #include <common/toolkit/serialization/Serialization.h>
 #include <common/toolkit/MetaStorageTk.h>
+#include <components/metajournal/MetaJournal.h>
 #include <program/Program.h>
 #include <storage/MetadataEx.h>
 #include "MirrorerTask.h"
@@ -587,6 +588,8 @@ bool MirrorerTask::loadFileBufFromXattr(std::string path, const char* xattrName)
 
    this->fileBuf = (char*)malloc(META_SERBUF_SIZE);
 
+   MetaJournal::flushFileStatic(path);
+
    ssize_t getRes = getxattr(path.c_str(), META_XATTR_NAME, fileBuf, META_SERBUF_SIZE);
    if(getRes > 0)
    { // we got something
@@ -865,6 +868,8 @@ FhgfsOpsErr MirrorerTask::saveRecvFileBuf(std::string path)
 
    if(useXAttrs)
    { // extended attribute
+      MetaJournal::flushFileStatic(path); // (older journaled updates must not overwrite this)
+
       int setRes = fsetxattr(fd, META_XATTR_NAME, recvFileBuf, recvFileBufLen, 0);
 
       if(unlikely(setRes == -1) )
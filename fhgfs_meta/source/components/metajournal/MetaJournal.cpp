@@ -0,0 +1,959 @@
+#include <common/toolkit/serialization/Serialization.h>
+#include <common/toolkit/BufferTk.h>
+#include <common/toolkit/StorageTk.h>
+#include <common/toolkit/StringTk.h>
+#include <program/Program.h>
+#include <storage/MetadataEx.h>
+#include "MetaJournal.h"
+
+#include <attr/xattr.h>
+
+
+#define METAJOURNAL_RECORD_MAGIC          (0x4D4A524E) /* "MJRN" */
+#define METAJOURNAL_RECORD_HEADER_LEN     (12) /* magic, total len, checksum */
+#define METAJOURNAL_APPLY_BATCH_MAX       (1024) /* max records per applier batch */
+#define METAJOURNAL_APPLY_WAIT_MS         (1000) /* applier wait for new records (to check stop) */
+
+
+/**
+ * Replays the existing journal segments (if any) and opens a new segment.
+ *
+ * Note: Must be constructed after the working dir has been changed to the meta directory, and
+ * before any metadata is read.
+ *
+ * @param maxPending max number of logged, but not yet applied updates (writers will wait when
+ * this is reached)
+ * @throw ComponentInitException if the journal segments could not be read or created
+ */
+MetaJournal::MetaJournal(unsigned maxPending) throw(ComponentInitException) :
+   PThread("MetaJournal"), log("MetaJournal"), maxPending(maxPending ? maxPending : 1),
+   isActive(false), isBroken(false), commitInProgress(false), lastSeqNo(0), committedSeqNo(0),
+   appliedSeqNo(0), numPending(0), segmentFD(-1), segmentNum(0), segmentSize(0)
+{
+   replay();
+}
+
+MetaJournal::~MetaJournal()
+{
+   closeSegmentUnlocked();
+
+   // (records that were not applied are still in the journal segments for the next replay)
+
+   for(MetaJournalRecordListIter iter = uncommittedRecords.begin();
+       iter != uncommittedRecords.end();
+       iter++)
+   {
+      if( (*iter)->fd != -1)
+         close( (*iter)->fd);
+
+      delete(*iter);
+   }
+
+   for(MetaJournalRecordListIter iter = applyQueue.begin(); iter != applyQueue.end(); iter++)
+   {
+      if( (*iter)->fd != -1)
+         close( (*iter)->fd);
+
+      delete(*iter);
+   }
+}
+
+void MetaJournal::run()
+{
+   try
+   {
+      registerSignalHandler();
+
+      applyLoop();
+
+      log.log(Log_DEBUG, "Component stopped.");
+   }
+   catch(std::exception& e)
+   {
+      PThread::getCurrentThreadApp()->handleComponentException(e);
+   }
+}
+
+void MetaJournal::applyLoop()
+{
+   while(!getSelfTerminate() )
+   {
+      SafeMutexLock mutexLock(&mutex); // L O C K
+
+      if(applyQueue.empty() )
+         newRecordsCond.timedwait(&mutex, METAJOURNAL_APPLY_WAIT_MS);
+
+      bool haveRecords = !applyQueue.empty();
+
+      mutexLock.unlock(); // U N L O C K
+
+      if(!haveRecords)
+         continue;
+
+      applyQueued(~0ULL, METAJOURNAL_APPLY_BATCH_MAX);
+
+      deleteAppliedSegments();
+   }
+}
+
+/**
+ * Start logging updates to the journal (instead of writing them directly) and start the applier
+ * thread.
+ */
+void MetaJournal::startApplying()
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   isActive = true;
+
+   mutexLock.unlock(); // U N L O C K
+
+   start();
+}
+
+/**
+ * Stop logging updates to the journal, stop the applier thread and apply everything that is left
+ * in the journal, so that no replay is necessary on next startup.
+ *
+ * Note: Updates that come in after this are written directly.
+ */
+void MetaJournal::stopApplying()
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   isActive = false;
+
+   // (updates that have been logged before need to be committed by their writers)
+   while(commitInProgress || !uncommittedRecords.empty() )
+      commitCond.wait(&mutex);
+
+   mutexLock.unlock(); // U N L O C K
+
+   selfTerminate();
+
+   SafeMutexLock wakeLock(&mutex); // L O C K
+   newRecordsCond.broadcast();
+   wakeLock.unlock(); // U N L O C K
+
+   join();
+
+   applyQueued(~0ULL, ~(size_t)0);
+
+   // the current segment is complete now => let it be deleted together with the others
+
+   SafeMutexLock closeLock(&mutex); // L O C K
+
+   if(segmentFD != -1)
+   {
+      closedSegments[segmentNum] = lastSeqNo;
+      closeSegmentUnlocked();
+   }
+
+   closeLock.unlock(); // U N L O C K
+
+   deleteAppliedSegments();
+
+   log.log(Log_DEBUG, "All journaled updates applied.");
+}
+
+/**
+ * Replacement for setxattr() of META_XATTR_NAME for updates of existing metadata files.
+ *
+ * @return 0 on success, -1 and errno set otherwise (like setxattr() )
+ */
+int MetaJournal::setMetaXAttr(const std::string& path, const char* value, size_t valueLen)
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   bool useJournal = isActive && !isBroken;
+
+   mutexLock.unlock(); // U N L O C K
+
+   if(!useJournal)
+      return directSetMetaXAttr(path, value, valueLen);
+
+   // open the file now, so that the update gets applied to the right file even if it is renamed
+
+   int fd = open(path.c_str(), O_RDONLY | O_NOATIME);
+   if(fd == -1)
+      return -1;
+
+   struct stat statBuf;
+
+   int statRes = fstat(fd, &statBuf);
+   if(unlikely(statRes == -1) )
+   {
+      int errCode = errno;
+      close(fd);
+      errno = errCode;
+      return -1;
+   }
+
+   MetaJournalRecord* record = new MetaJournalRecord();
+   record->type = MetaJournalRecordType_XATTR;
+   record->inodeNum = statBuf.st_ino;
+   record->path = path;
+   record->value.assign(value, value + valueLen);
+   record->fd = fd;
+
+   mutexLock.relock(); // L O C K
+
+   while( (numPending >= maxPending) && isActive && !isBroken)
+      appliedCond.wait(&mutex);
+
+   if(unlikely(!isActive || isBroken) )
+   { // journal was stopped while we were waiting
+      mutexLock.unlock(); // U N L O C K
+
+      close(fd);
+      delete(record);
+
+      return directSetMetaXAttr(path, value, valueLen);
+   }
+
+   int retVal = logRecordAndWait(record, &mutexLock);
+
+   mutexLock.unlock(); // U N L O C K
+
+   return retVal;
+}
+
+/**
+ * Apply pending updates of the given file, so that it can be read from disk.
+ *
+ * Note: Updates that have not been committed yet are not applied (the caller should hold a lock
+ * on the inode or dentry to avoid that kind of race).
+ */
+void MetaJournal::flushFile(const std::string& path)
+{
+   if(!numPendingInodes.read() )
+      return; // nothing pending at all
+
+   struct stat statBuf;
+
+   int statRes = stat(path.c_str(), &statBuf);
+   if(statRes == -1)
+      return; // (the caller will get the error when reading)
+
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   MetaJournalInodeMapIter iter = pendingInodes.find(statBuf.st_ino);
+   if(iter == pendingInodes.end() )
+   {
+      mutexLock.unlock(); // U N L O C K
+      return;
+   }
+
+   uint64_t seqNo = iter->second;
+
+   mutexLock.unlock(); // U N L O C K
+
+   applyQueued(seqNo, ~(size_t)0);
+}
+
+/**
+ * Tell the journal that the given metadata file is about to be removed. If this is the last link
+ * of the file, a FORGET record is logged, so that a replay doesn't apply older updates to another
+ * file that gets the same inode number later.
+ *
+ * Note: Call this before the file is actually removed.
+ */
+void MetaJournal::forgetFile(const std::string& path)
+{
+   if(!numLoggedInodes.read() )
+      return; // no records in the journal
+
+   struct stat statBuf;
+
+   int statRes = stat(path.c_str(), &statBuf);
+   if( (statRes == -1) || (statBuf.st_nlink > 1) )
+      return; // not the last link
+
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   if(!isActive || isBroken ||
+      (loggedInodes.find(statBuf.st_ino) == loggedInodes.end() ) )
+   {
+      mutexLock.unlock(); // U N L O C K
+      return;
+   }
+
+   MetaJournalRecord* record = new MetaJournalRecord();
+   record->type = MetaJournalRecordType_FORGET;
+   record->inodeNum = statBuf.st_ino;
+   record->path = path;
+   record->fd = -1;
+
+   logRecordAndWait(record, &mutexLock);
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/**
+ * Static version of setMetaXAttr(), which falls back to a direct setxattr() if the journal is
+ * disabled. This just exists to avoid inclusion of Program.h in the storage classes.
+ */
+int MetaJournal::setMetaXAttrStatic(const std::string& path, const char* value, size_t valueLen)
+{
+   MetaJournal* journal = Program::getApp()->getMetaJournal();
+
+   if(!journal)
+      return setxattr(path.c_str(), META_XATTR_NAME, value, valueLen, 0);
+
+   return journal->setMetaXAttr(path, value, valueLen);
+}
+
+/**
+ * Static version of flushFile() (no-op if the journal is disabled).
+ */
+void MetaJournal::flushFileStatic(const std::string& path)
+{
+   MetaJournal* journal = Program::getApp()->getMetaJournal();
+
+   if(journal)
+      journal->flushFile(path);
+}
+
+/**
+ * Static version of forgetFile() (no-op if the journal is disabled).
+ */
+void MetaJournal::forgetFileStatic(const std::string& path)
+{
+   MetaJournal* journal = Program::getApp()->getMetaJournal();
+
+   if(journal)
+      journal->forgetFile(path);
+}
+
+/**
+ * Add the record to the commit buffer and wait until it has been committed (or commit it
+ * ourselves together with everything else that is in the buffer).
+ *
+ * Note: mutex must be locked.
+ *
+ * @param record will be owned by the journal afterwards
+ * @return 0 (failed segment writes are handled by switching to direct updates)
+ */
+int MetaJournal::logRecordAndWait(MetaJournalRecord* record, SafeMutexLock* mutexLock)
+{
+   uint64_t seqNo = ++lastSeqNo;
+
+   record->seqNo = seqNo;
+
+   serializeRecord(record, commitBuf);
+   uncommittedRecords.push_back(record);
+   numPending++;
+
+   while(committedSeqNo < seqNo)
+   {
+      if(!commitInProgress)
+         commitUnlocked(mutexLock); // (commits our record)
+      else
+         commitCond.wait(&mutex);
+   }
+
+   return 0;
+}
+
+/**
+ * Write and sync all records that are in the commit buffer and hand them over to the applier.
+ *
+ * If writing to the journal fails, we switch to direct updates and the records in the buffer
+ * are just handed over to the applier (so they are not lost, but not protected by the journal).
+ *
+ * Note: mutex must be locked; will be unlocked while writing.
+ */
+void MetaJournal::commitUnlocked(SafeMutexLock* mutexLock)
+{
+   commitInProgress = true;
+
+   std::vector<char> buf;
+   buf.swap(commitBuf);
+
+   MetaJournalRecordList records;
+   records.splice(records.end(), uncommittedRecords);
+
+   uint64_t commitSeqNo = lastSeqNo;
+
+   if(segmentSize >= METAJOURNAL_SEGMENT_MAX_SIZE)
+   { // segment full => start a new one
+      closedSegments[segmentNum] = committedSeqNo;
+      closeSegmentUnlocked();
+   }
+
+   bool openRes = (segmentFD != -1) || openSegment(segmentNum + 1);
+
+   mutexLock->unlock(); // U N L O C K
+
+   bool writeRes = openRes && writeSegment(buf);
+
+   mutexLock->relock(); // L O C K
+
+   if(unlikely(!writeRes) && !isBroken)
+   {
+      log.logErr("Writing to metadata journal failed. Switching to direct metadata updates. "
+         "SysErr: " + System::getErrString() );
+
+      isBroken = true;
+   }
+
+   for(MetaJournalRecordListIter iter = records.begin(); iter != records.end(); iter++)
+   {
+      MetaJournalRecord* record = *iter;
+
+      if(record->type == MetaJournalRecordType_XATTR)
+         pendingInodes[record->inodeNum] = record->seqNo;
+
+      if(writeRes)
+         loggedInodes[record->inodeNum] = record->seqNo;
+   }
+
+   numPendingInodes.set(pendingInodes.size() );
+   numLoggedInodes.set(loggedInodes.size() );
+
+   applyQueue.splice(applyQueue.end(), records);
+   newRecordsCond.signal();
+
+   committedSeqNo = commitSeqNo;
+   commitInProgress = false;
+   commitCond.broadcast();
+}
+
+/**
+ * Append the buffer to the current segment and sync it.
+ *
+ * Note: Only called by the committing thread.
+ */
+bool MetaJournal::writeSegment(const std::vector<char>& buf)
+{
+   size_t numWritten = 0;
+
+   while(numWritten < buf.size() )
+   {
+      ssize_t writeRes = write(segmentFD, &buf[numWritten], buf.size() - numWritten);
+      if(writeRes == -1)
+      {
+         if(errno == EINTR)
+            continue;
+
+         return false;
+      }
+
+      numWritten += writeRes;
+   }
+
+   segmentSize += numWritten;
+
+   int syncRes = fdatasync(segmentFD);
+   if(syncRes == -1)
+      return false;
+
+   return true;
+}
+
+/**
+ * Create a new segment file and make it the current segment.
+ */
+bool MetaJournal::openSegment(unsigned newSegmentNum)
+{
+   std::string segmentPath = getSegmentPath(newSegmentNum);
+
+   int fd = open(segmentPath.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_APPEND, 0600);
+   if(fd == -1)
+   {
+      log.logErr("Unable to create journal segment: " + segmentPath + ". "
+         "SysErr: " + System::getErrString() );
+      return false;
+   }
+
+   segmentFD = fd;
+   segmentNum = newSegmentNum;
+   segmentSize = 0;
+
+   return true;
+}
+
+void MetaJournal::closeSegmentUnlocked()
+{
+   if(segmentFD == -1)
+      return;
+
+   close(segmentFD);
+   segmentFD = -1;
+}
+
+/**
+ * Apply queued records (in log order) up to the given seqNo.
+ *
+ * @param maxSeqNo only apply records up to this seqNo.
+ * @param maxNumRecords max number of records to apply in this call.
+ */
+void MetaJournal::applyQueued(uint64_t maxSeqNo, size_t maxNumRecords)
+{
+   SafeMutexLock applyLock(&applyMutex); // L O C K (apply)
+
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   MetaJournalRecordList records;
+
+   while(!applyQueue.empty() && (applyQueue.front()->seqNo <= maxSeqNo) &&
+      (records.size() < maxNumRecords) )
+      records.splice(records.end(), applyQueue, applyQueue.begin() );
+
+   mutexLock.unlock(); // U N L O C K
+
+   if(!records.empty() )
+   {
+      applyRecords(records);
+      finishAppliedRecords(records);
+   }
+
+   applyLock.unlock(); // U N L O C K (apply)
+}
+
+/**
+ * Apply the given records to the underlying files. Only the last record of each file is applied,
+ * because each record contains the complete new value and FORGET records invalidate all older
+ * records of the file.
+ */
+void MetaJournal::applyRecords(MetaJournalRecordList& records)
+{
+   MetaJournalInodeMap lastRecords; // inodeNum => seqNo of last record in this batch
+
+   for(MetaJournalRecordListIter iter = records.begin(); iter != records.end(); iter++)
+      lastRecords[(*iter)->inodeNum] = (*iter)->seqNo;
+
+   for(MetaJournalRecordListIter iter = records.begin(); iter != records.end(); iter++)
+   {
+      MetaJournalRecord* record = *iter;
+
+      if( (record->type == MetaJournalRecordType_XATTR) &&
+          (lastRecords[record->inodeNum] == record->seqNo) )
+         applyRecord(record);
+   }
+}
+
+void MetaJournal::applyRecord(MetaJournalRecord* record)
+{
+   int fd = record->fd;
+
+   if(fd == -1)
+   { // replayed record => find the file by path and check that it is still the same file
+      fd = open(record->path.c_str(), O_RDONLY | O_NOATIME);
+      if(fd == -1)
+      {
+         LOG_DEBUG_CONTEXT(log, Log_DEBUG, "Skipping update of removed file: " + record->path);
+         return;
+      }
+
+      struct stat statBuf;
+
+      int statRes = fstat(fd, &statBuf);
+      if( (statRes == -1) || (statBuf.st_ino != record->inodeNum) )
+      {
+         LOG_DEBUG_CONTEXT(log, Log_DEBUG, "Skipping update of replaced file: " + record->path);
+         close(fd);
+         return;
+      }
+   }
+
+   int setRes = fsetxattr(fd, META_XATTR_NAME, &record->value[0], record->value.size(), 0);
+   if(unlikely(setRes == -1) )
+      log.logErr("Unable to apply journaled metadata update: " + record->path + ". "
+         "SysErr: " + System::getErrString() );
+
+   if(record->fd == -1)
+      close(fd);
+}
+
+/**
+ * Remove the applied records from the pending lists and free them.
+ */
+void MetaJournal::finishAppliedRecords(MetaJournalRecordList& records)
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   for(MetaJournalRecordListIter iter = records.begin(); iter != records.end(); iter++)
+   {
+      MetaJournalRecord* record = *iter;
+
+      MetaJournalInodeMapIter inodeIter = pendingInodes.find(record->inodeNum);
+      if( (inodeIter != pendingInodes.end() ) && (inodeIter->second <= record->seqNo) )
+         pendingInodes.erase(inodeIter);
+
+      appliedSeqNo = record->seqNo;
+
+      if(record->fd != -1)
+         close(record->fd);
+
+      delete(record);
+   }
+
+   numPending -= records.size();
+   numPendingInodes.set(pendingInodes.size() );
+
+   appliedCond.broadcast();
+
+   mutexLock.unlock(); // U N L O C K
+
+   records.clear();
+}
+
+/**
+ * Delete closed segments of which all records have been applied. The applied updates are synced
+ * to disk first.
+ */
+void MetaJournal::deleteAppliedSegments()
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   MetaJournalSegmentMap deletableSegments;
+
+   for(MetaJournalSegmentMapIter iter = closedSegments.begin();
+       (iter != closedSegments.end() ) && (iter->second <= appliedSeqNo);
+       iter++)
+      deletableSegments.insert(*iter);
+
+   mutexLock.unlock(); // U N L O C K
+
+   if(deletableSegments.empty() )
+      return;
+
+   // make sure the applied updates are on disk before we delete their journal records
+
+   int dirFD = open(".", O_RDONLY | O_DIRECTORY);
+   if( (dirFD == -1) || (syncfs(dirFD) == -1) )
+      sync();
+
+   if(dirFD != -1)
+      close(dirFD);
+
+   uint64_t deletedSeqNo = 0;
+
+   for(MetaJournalSegmentMapIter iter = deletableSegments.begin();
+       iter != deletableSegments.end();
+       iter++)
+   {
+      std::string segmentPath = getSegmentPath(iter->first);
+
+      int unlinkRes = unlink(segmentPath.c_str() );
+      if(unlinkRes == -1)
+         log.log(Log_WARNING, "Unable to delete journal segment: " + segmentPath + ". "
+            "SysErr: " + System::getErrString() );
+
+      deletedSeqNo = iter->second;
+   }
+
+   // inodes that only had records in the deleted segments don't need FORGET records anymore
+
+   mutexLock.relock(); // L O C K
+
+   for(MetaJournalSegmentMapIter iter = deletableSegments.begin();
+       iter != deletableSegments.end();
+       iter++)
+      closedSegments.erase(iter->first);
+
+   for(MetaJournalInodeMapIter iter = loggedInodes.begin(); iter != loggedInodes.end(); )
+   {
+      if(iter->second <= deletedSeqNo)
+         loggedInodes.erase(iter++);
+      else
+         iter++;
+   }
+
+   numLoggedInodes.set(loggedInodes.size() );
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/**
+ * Write the update directly (used when the journal is inactive or broken).
+ */
+int MetaJournal::directSetMetaXAttr(const std::string& path, const char* value, size_t valueLen)
+{
+   flushFile(path); // (make sure no older update of this file is applied after ours)
+
+   return setxattr(path.c_str(), META_XATTR_NAME, value, valueLen, 0);
+}
+
+/**
+ * Apply all records of the existing journal segments, sync them to disk and delete the segments.
+ * Afterwards a new segment is opened.
+ */
+void MetaJournal::replay() throw(ComponentInitException)
+{
+   StringList dirEntries;
+
+   try
+   {
+      StorageTk::readCompleteDir(".", &dirEntries);
+   }
+   catch(InvalidConfigException& e)
+   {
+      throw ComponentInitException(std::string("Unable to read meta directory: ") + e.what() );
+   }
+
+   std::set<unsigned> segmentNums;
+   size_t prefixLen = strlen(METAJOURNAL_SEGMENT_FILENAME_PREFIX);
+
+   for(StringListIter iter = dirEntries.begin(); iter != dirEntries.end(); iter++)
+   {
+      if(!iter->compare(0, prefixLen, METAJOURNAL_SEGMENT_FILENAME_PREFIX) &&
+         (iter->length() > prefixLen) )
+         segmentNums.insert(StringTk::strHexToUInt(iter->substr(prefixLen) ) );
+   }
+
+   unsigned nextSegmentNum = 0;
+
+   if(!segmentNums.empty() )
+   {
+      MetaJournalRecordList records;
+
+      for(std::set<unsigned>::iterator iter = segmentNums.begin();
+          iter != segmentNums.end();
+          iter++)
+      {
+         bool readRes = readSegment(*iter, records);
+         if(!readRes)
+         {
+            for(MetaJournalRecordListIter recIter = records.begin();
+                recIter != records.end();
+                recIter++)
+               delete(*recIter);
+
+            throw ComponentInitException("Unable to read journal segment: " +
+               getSegmentPath(*iter) );
+         }
+      }
+
+      log.log(Log_NOTICE, "Replaying metadata journal. "
+         "Segments: " + StringTk::uintToStr(segmentNums.size() ) + "; "
+         "records: " + StringTk::uintToStr(records.size() ) );
+
+      applyRecords(records);
+
+      for(MetaJournalRecordListIter iter = records.begin(); iter != records.end(); iter++)
+         delete(*iter);
+
+      // make the replayed updates persistent before deleting the segments
+
+      sync();
+
+      for(std::set<unsigned>::iterator iter = segmentNums.begin();
+          iter != segmentNums.end();
+          iter++)
+      {
+         std::string segmentPath = getSegmentPath(*iter);
+
+         int unlinkRes = unlink(segmentPath.c_str() );
+         if(unlinkRes == -1)
+            throw ComponentInitException("Unable to delete replayed journal segment: " +
+               segmentPath + ". SysErr: " + System::getErrString() );
+      }
+
+      nextSegmentNum = *segmentNums.rbegin() + 1;
+   }
+
+   if(!openSegment(nextSegmentNum) )
+      throw ComponentInitException("Unable to create metadata journal segment");
+}
+
+/**
+ * Read all valid records of a segment. A torn record at the end of the segment (from a crash
+ * during a commit) ends the segment, because it has never been acknowledged.
+ *
+ * @param outRecords the records will be appended to this list
+ * @return false on read error
+ */
+bool MetaJournal::readSegment(unsigned segmentNum, MetaJournalRecordList& outRecords)
+{
+   std::string segmentPath = getSegmentPath(segmentNum);
+
+   int fd = open(segmentPath.c_str(), O_RDONLY);
+   if(fd == -1)
+   {
+      log.logErr("Unable to open journal segment: " + segmentPath + ". "
+         "SysErr: " + System::getErrString() );
+      return false;
+   }
+
+   struct stat statBuf;
+
+   int statRes = fstat(fd, &statBuf);
+   if(statRes == -1)
+   {
+      log.logErr("Unable to stat journal segment: " + segmentPath + ". "
+         "SysErr: " + System::getErrString() );
+      close(fd);
+      return false;
+   }
+
+   std::vector<char> buf(statBuf.st_size);
+   size_t numRead = 0;
+
+   while(numRead < buf.size() )
+   {
+      ssize_t readRes = read(fd, &buf[numRead], buf.size() - numRead);
+      if(readRes <= 0)
+      {
+         if( (readRes == -1) && (errno == EINTR) )
+            continue;
+
+         log.logErr("Unable to read journal segment: " + segmentPath + ". "
+            "SysErr: " + System::getErrString() );
+         close(fd);
+         return false;
+      }
+
+      numRead += readRes;
+   }
+
+   close(fd);
+
+   size_t bufPos = 0;
+
+   while(bufPos < buf.size() )
+   {
+      unsigned recordLen;
+
+      MetaJournalRecord* record = deserializeRecord(&buf[bufPos], buf.size() - bufPos,
+         &recordLen);
+      if(!record)
+      {
+         log.log(Log_WARNING, "Ignoring incomplete record at end of journal segment: " +
+            segmentPath + "; offset: " + StringTk::uint64ToStr(bufPos) );
+         break;
+      }
+
+      outRecords.push_back(record);
+      bufPos += recordLen;
+   }
+
+   return true;
+}
+
+std::string MetaJournal::getSegmentPath(unsigned segmentNum)
+{
+   return METAJOURNAL_SEGMENT_FILENAME_PREFIX + StringTk::uintToHexStr(segmentNum);
+}
+
+/**
+ * Record format: magic, total len, checksum (of everything behind the checksum), seqNo, type,
+ * inodeNum, path (as string), value (len + raw bytes).
+ *
+ * @param outBuf the serialized record will be appended to this buffer
+ */
+void MetaJournal::serializeRecord(MetaJournalRecord* record, std::vector<char>& outBuf)
+{
+   size_t recordLen = METAJOURNAL_RECORD_HEADER_LEN +
+      Serialization::serialLenUInt64() + // seqNo
+      Serialization::serialLenUInt() + // type
+      Serialization::serialLenUInt64() + // inodeNum
+      Serialization::serialLenStr(record->path.length() ) +
+      Serialization::serialLenUInt() + record->value.size(); // value
+
+   size_t recordStart = outBuf.size();
+
+   outBuf.resize(recordStart + recordLen);
+
+   char* buf = &outBuf[recordStart];
+   size_t bufPos = METAJOURNAL_RECORD_HEADER_LEN;
+
+   bufPos += Serialization::serializeUInt64(&buf[bufPos], record->seqNo);
+   bufPos += Serialization::serializeUInt(&buf[bufPos], record->type);
+   bufPos += Serialization::serializeUInt64(&buf[bufPos], record->inodeNum);
+   bufPos += Serialization::serializeStr(&buf[bufPos], record->path.length(),
+      record->path.c_str() );
+   bufPos += Serialization::serializeUInt(&buf[bufPos], record->value.size() );
+
+   if(!record->value.empty() )
+      memcpy(&buf[bufPos], &record->value[0], record->value.size() );
+
+   uint32_t checksum = BufferTk::hash32(&buf[METAJOURNAL_RECORD_HEADER_LEN],
+      recordLen - METAJOURNAL_RECORD_HEADER_LEN);
+
+   bufPos = 0;
+   bufPos += Serialization::serializeUInt(&buf[bufPos], METAJOURNAL_RECORD_MAGIC);
+   bufPos += Serialization::serializeUInt(&buf[bufPos], recordLen);
+   bufPos += Serialization::serializeUInt(&buf[bufPos], checksum);
+}
+
+/**
+ * @return NULL if the buffer doesn't start with a complete and valid record.
+ */
+MetaJournalRecord* MetaJournal::deserializeRecord(const char* buf, size_t bufLen,
+   unsigned* outLen)
+{
+   unsigned magic;
+   unsigned recordLen;
+   unsigned checksum;
+   unsigned fieldLen;
+   size_t bufPos = 0;
+
+   if(!Serialization::deserializeUInt(&buf[bufPos], bufLen - bufPos, &magic, &fieldLen) ||
+      (magic != METAJOURNAL_RECORD_MAGIC) )
+      return NULL;
+
+   bufPos += fieldLen;
+
+   if(!Serialization::deserializeUInt(&buf[bufPos], bufLen - bufPos, &recordLen, &fieldLen) ||
+      (recordLen > bufLen) || (recordLen < METAJOURNAL_RECORD_HEADER_LEN) )
+      return NULL;
+
+   bufPos += fieldLen;
+
+   if(!Serialization::deserializeUInt(&buf[bufPos], bufLen - bufPos, &checksum, &fieldLen) ||
+      (checksum != BufferTk::hash32(&buf[METAJOURNAL_RECORD_HEADER_LEN],
+         recordLen - METAJOURNAL_RECORD_HEADER_LEN) ) )
+      return NULL;
+
+   bufPos += fieldLen;
+
+   // checksum is fine => the rest is expected to be valid (but check lengths anyways)
+
+   uint64_t seqNo;
+   unsigned type;
+   uint64_t inodeNum;
+   unsigned pathLen;
+   const char* pathStart;
+   unsigned valueLen;
+
+   if(!Serialization::deserializeUInt64(&buf[bufPos], recordLen - bufPos, &seqNo, &fieldLen) )
+      return NULL;
+
+   bufPos += fieldLen;
+
+   if(!Serialization::deserializeUInt(&buf[bufPos], recordLen - bufPos, &type, &fieldLen) )
+      return NULL;
+
+   bufPos += fieldLen;
+
+   if(!Serialization::deserializeUInt64(&buf[bufPos], recordLen - bufPos, &inodeNum, &fieldLen) )
+      return NULL;
+
+   bufPos += fieldLen;
+
+   if(!Serialization::deserializeStr(&buf[bufPos], recordLen - bufPos, &pathLen, &pathStart,
+      &fieldLen) )
+      return NULL;
+
+   bufPos += fieldLen;
+
+   if(!Serialization::deserializeUInt(&buf[bufPos], recordLen - bufPos, &valueLen, &fieldLen) ||
+      (valueLen > recordLen - bufPos - fieldLen) )
+      return NULL;
+
+   bufPos += fieldLen;
+
+   MetaJournalRecord* record = new MetaJournalRecord();
+   record->seqNo = seqNo;
+   record->type = (MetaJournalRecordType)type;
+   record->inodeNum = inodeNum;
+   record->path.assign(pathStart, pathLen);
+   record->value.assign(&buf[bufPos], &buf[bufPos] + valueLen);
+   record->fd = -1;
+
+   *outLen = recordLen;
+
+   return record;
+}
@@ -0,0 +1,152 @@
+#ifndef METAJOURNAL_H_
+#define METAJOURNAL_H_
+
+#include <common/app/log/LogContext.h>
+#include <common/components/ComponentInitException.h>
+#include <common/threading/Atomics.h>
+#include <common/threading/Condition.h>
+#include <common/threading/Mutex.h>
+#include <common/threading/PThread.h>
+#include <common/threading/SafeMutexLock.h>
+#include <common/Common.h>
+
+
+#define METAJOURNAL_SEGMENT_FILENAME_PREFIX  "journal." /* followed by the segment number (hex) */
+#define METAJOURNAL_SEGMENT_MAX_SIZE         (64*1024*1024) /* start a new segment after this */
+
+
+enum MetaJournalRecordType
+{
+   MetaJournalRecordType_XATTR   = 1, // new value of the metadata xattr of a file
+   MetaJournalRecordType_FORGET  = 2, // last link of a file removed (invalidates older records)
+};
+
+
+/**
+ * A logged metadata update (kept in memory until it has been applied to the underlying file).
+ */
+struct MetaJournalRecord
+{
+   uint64_t seqNo;
+   MetaJournalRecordType type;
+   uint64_t inodeNum; // inode number of the underlying file
+   std::string path; // relative to the meta directory
+   std::vector<char> value; // (empty for FORGET records)
+   int fd; // the underlying file (-1 for FORGET records and for replayed records)
+};
+
+typedef std::list<MetaJournalRecord*> MetaJournalRecordList;
+typedef MetaJournalRecordList::iterator MetaJournalRecordListIter;
+
+typedef std::map<uint64_t, uint64_t> MetaJournalInodeMap; // inodeNum => seqNo of latest record
+typedef MetaJournalInodeMap::iterator MetaJournalInodeMapIter;
+typedef MetaJournalInodeMap::value_type MetaJournalInodeMapVal;
+
+typedef std::map<unsigned, uint64_t> MetaJournalSegmentMap; // segmentNum => seqNo of last record
+typedef MetaJournalSegmentMap::iterator MetaJournalSegmentMapIter;
+typedef MetaJournalSegmentMap::value_type MetaJournalSegmentMapVal;
+
+
+/**
+ * Write-ahead journal for the metadata xattr updates of inodes and dentries, which would otherwise
+ * cost a synchronous setxattr() for each operation.
+ *
+ * Updates are appended to the current journal segment and acknowledged as soon as the segment has
+ * been synced. Concurrent updates are group-committed: Whoever finds no commit in progress writes
+ * and syncs all updates that have been logged in the meantime.
+ * The applier thread applies committed updates to the underlying files in the background in
+ * batches, where multiple updates of the same file within a batch are merged into the last one.
+ * A segment is deleted when all of its updates have been applied and synced to disk, so that only
+ * the remaining segments need to be replayed at startup.
+ *
+ * Updates are identified by the inode number of the underlying file (and by an open file
+ * descriptor while they are in memory), so dentry-by-name/by-id hardlinks and renames don't
+ * matter. Code that reads metadata files needs to call flushFileStatic() first to apply pending
+ * updates of the file and code that removes the last link of a metadata file needs to call
+ * forgetFileStatic() first, so that a replay doesn't apply old updates to a new file that reuses
+ * the inode number.
+ *
+ * Note: Only for storeUseExtendedAttribs=true, because updates in file contents mode replace the
+ * file.
+ */
+class MetaJournal : public PThread
+{
+   public:
+      MetaJournal(unsigned maxPending) throw(ComponentInitException);
+      virtual ~MetaJournal();
+
+      void startApplying();
+      void stopApplying();
+
+      int setMetaXAttr(const std::string& path, const char* value, size_t valueLen);
+      void flushFile(const std::string& path);
+      void forgetFile(const std::string& path);
+
+      static int setMetaXAttrStatic(const std::string& path, const char* value,
+         size_t valueLen);
+      static void flushFileStatic(const std::string& path);
+      static void forgetFileStatic(const std::string& path);
+
+
+   private:
+      LogContext log;
+
+      unsigned maxPending; // max number of logged, but not yet applied records
+
+      Mutex mutex; // protects the fields below
+      Condition commitCond; // signaled when a commit has finished
+      Condition newRecordsCond; // signaled when committed records are waiting for the applier
+      Condition appliedCond; // signaled when records have been applied
+      bool isActive; // false before startApplying() and after stopApplying() => direct updates
+      bool isBroken; // set after a failed segment write => direct updates
+      bool commitInProgress;
+      uint64_t lastSeqNo; // last assigned seqNo
+      uint64_t committedSeqNo;
+      uint64_t appliedSeqNo;
+      std::vector<char> commitBuf; // serialized records that have not been written yet
+      MetaJournalRecordList uncommittedRecords; // (the records in commitBuf)
+      MetaJournalRecordList applyQueue; // committed records that have not been applied yet
+      size_t numPending; // number of uncommittedRecords + applyQueue
+      MetaJournalInodeMap pendingInodes; // inodes with XATTR records in the applyQueue
+      MetaJournalInodeMap loggedInodes; // inodes with records in the existing segments
+      MetaJournalSegmentMap closedSegments; // segments that are not written anymore
+
+      AtomicSizeT numPendingInodes; // (size of pendingInodes for checks without the mutex)
+      AtomicSizeT numLoggedInodes; // (size of loggedInodes for checks without the mutex)
+
+      Mutex applyMutex; // serializes applying of records (applier thread vs. flushFile() )
+
+      // only used by the committing thread (i.e. the thread that set commitInProgress)
+      int segmentFD;
+      unsigned segmentNum;
+      size_t segmentSize;
+
+
+      virtual void run();
+      void applyLoop();
+
+      void replay() throw(ComponentInitException);
+      bool readSegment(unsigned segmentNum, MetaJournalRecordList& outRecords);
+
+      int logRecordAndWait(MetaJournalRecord* record, SafeMutexLock* mutexLock);
+      void commitUnlocked(SafeMutexLock* mutexLock);
+      bool writeSegment(const std::vector<char>& buf);
+      bool openSegment(unsigned newSegmentNum);
+      void closeSegmentUnlocked();
+
+      void applyQueued(uint64_t maxSeqNo, size_t maxNumRecords);
+      void applyRecords(MetaJournalRecordList& records);
+      void applyRecord(MetaJournalRecord* record);
+      void finishAppliedRecords(MetaJournalRecordList& records);
+      void deleteAppliedSegments();
+
+      int directSetMetaXAttr(const std::string& path, const char* value, size_t valueLen);
+
+      std::string getSegmentPath(unsigned segmentNum);
+
+      static void serializeRecord(MetaJournalRecord* record, std::vector<char>& outBuf);
+      static MetaJournalRecord* deserializeRecord(const char* buf, size_t bufLen,
+         unsigned* outLen);
+};
+
+#endif /* METAJOURNAL_H_ */
@@ -0,0 +1,15 @@
+#include <program/Program.h>
+#include "GetChunkFileAttribsMultiWork.h"
+
+
+void GetChunkFileAttribsMultiWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
+   unsigned bufOutLen)
+{
+   ChunkAttribsBatcher* batcher = Program::getApp()->getChunkAttribsBatcher();
+
+   batcher->sendBatch(key, batch, msgUserID);
+
+   SAFE_DELETE(batch);
+
+   batcher->finishBatch(key, msgUserID);
+}
@@ -0,0 +1,42 @@
+#ifndef GETCHUNKFILEATTRIBSMULTIWORK_H_
+#define GETCHUNKFILEATTRIBSMULTIWORK_H_
+
+#include <common/components/worker/Work.h>
+#include <common/Common.h>
+#include <components/ChunkAttribsBatcher.h>
+
+
+/**
+ * Sends a batch of the ChunkAttribsBatcher to its storage target (so that batches of different
+ * targets are sent in parallel).
+ */
+class GetChunkFileAttribsMultiWork : public Work
+{
+   public:
+      /**
+       * @param key target key of the batch (see ChunkAttribsBatcher::getKey() )
+       * @param batch will be owned and freed by this object
+       */
+      GetChunkFileAttribsMultiWork(uint32_t key, ChunkAttribsBatch* batch, unsigned msgUserID) :
+         key(key), batch(batch), msgUserID(msgUserID)
+      {
+         // all assignments done in initializer list
+      }
+
+      virtual ~GetChunkFileAttribsMultiWork()
+      {
+         SAFE_DELETE(batch);
+      }
+
+
+      virtual void process(char* bufIn, unsigned bufInLen, char* bufOut, unsigned bufOutLen);
+
+
+   private:
+      uint32_t key;
+      ChunkAttribsBatch* batch;
+
+      unsigned msgUserID; // only used for msg header info
+};
+
+#endif /* GETCHUNKFILEATTRIBSMULTIWORK_H_ */
@@ -0,0 +1,152 @@
+#include <common/app/log/LogContext.h>
+#include <common/net/message/session/LeaseRevokedMsg.h>
+#include <common/threading/SafeMutexLock.h>
+#include <program/Program.h>
+#include "LeaseRevokeNotificationWork.h"
+
+
+Mutex LeaseRevokeNotificationWork::ackCounterMutex;
+unsigned LeaseRevokeNotificationWork::ackCounter = 0;
+
+
+void LeaseRevokeNotificationWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
+   unsigned bufOutLen)
+{
+   /* note: this code is very similar to LockEntryNotificationWork, so if you change something
+      there, you probably want to change it here, too. */
+
+   const char* logContext = "LeaseRevokeNotificationWork::process";
+   App* app = Program::getApp();
+   Logger* logger = app->getLogger();
+
+   Config* cfg = app->getConfig();
+   AcknowledgmentStore* ackStore = app->getAckStore();
+   DatagramListener* dgramLis = app->getDatagramListener();
+   NodeStoreClientsEx* clients = app->getClientNodes();
+   uint16_t localNodeID = app->getLocalNode()->getNumID();
+
+   // (we reuse the lock grant settings, as these are also sent to clients as datagrams)
+   int ackWaitSleepMS = cfg->getTuneLockGrantWaitMS();
+   int numRetriesLeft = cfg->getTuneLockGrantNumRetries();
+
+   WaitAckMap waitAcks;
+   WaitAckMap receivedAcks;
+   WaitAckNotification notifier;
+
+   // note: we use uint for tv_sec (not uint64) because 32 bits are enough here
+   // gives string like this: "time-counter-lrev-"
+   std::string ackIDPrefix =
+      StringTk::uintToHexStr(TimeAbs().getTimeval()->tv_sec) + "-" +
+      StringTk::uintToHexStr(incAckCounter() ) + "-" "lrev" "-";
+
+
+   if(unlikely(notifyList->empty() ) )
+      return; // nothing to be done
+
+
+   // create and register waitAcks
+
+   /* note: waitAcks store pointers to notifyList items, so make sure to not remove anything from
+      the list while we're still using the waitAcks pointers */
+
+   for(StringListIter iter = notifyList->begin(); iter != notifyList->end(); iter++)
+   {
+      std::string ackID = ackIDPrefix + *iter; // (clientIDs are unique in the notifyList)
+
+      WaitAck waitAck(ackID, &(*iter) );
+
+      waitAcks.insert(WaitAckMapVal(ackID, waitAck) );
+   }
+
+   ackStore->registerWaitAcks(&waitAcks, &receivedAcks, &notifier);
+
+
+   // loop: send requests -> waitforcompletion -> resend
+
+   while(numRetriesLeft && !app->getSelfTerminate() )
+   {
+      // create waitAcks copy
+
+      SafeMutexLock waitAcksLock(&notifier.waitAcksMutex);
+
+      WaitAckMap currentWaitAcks(waitAcks);
+
+      waitAcksLock.unlock();
+
+      // send messages
+
+      for(WaitAckMapIter iter = currentWaitAcks.begin(); iter != currentWaitAcks.end(); iter++)
+      {
+         std::string* clientID = (std::string*)iter->second.privateData;
+
+         LeaseRevokedMsg msg(entryID, iter->first, localNodeID);
+
+         bool serializeRes = msg.serialize(bufOut, bufOutLen);
+         if(unlikely(!serializeRes) )
+         { // buffer too small - should never happen
+            logger->log(Log_CRITICAL, logContext, "BUG(?): Buffer too small for message "
+               "serialization: " + StringTk::intToStr(bufOutLen) + "/" +
+               StringTk::intToStr(msg.getMsgLength() ) );
+            continue;
+         }
+
+         Node* node = clients->referenceNode(*clientID);
+         if(unlikely(!node) )
+         { // node not exists (its leases are gone with it)
+            LOG_DEBUG(logContext, Log_DEBUG, "Cannot revoke lease of unknown client: " +
+               *clientID);
+            continue;
+         }
+
+         dgramLis->sendBufToNode(node, bufOut, msg.getMsgLength() );
+
+         clients->releaseNode(&node);
+      }
+
+      // wait for acks
+
+      bool allAcksReceived = ackStore->waitForAckCompletion(
+         &currentWaitAcks, &notifier, ackWaitSleepMS);
+      if(allAcksReceived)
+         break; // all acks received
+
+      // some waitAcks left => prepare next loop
+
+      numRetriesLeft--;
+   }
+
+   // waiting for acks is over
+
+   ackStore->unregisterWaitAcks(&waitAcks);
+
+   // check results (waitAcks now contains all unreceived acks)
+
+   if(waitAcks.empty() )
+   {
+      LOG_DEBUG(logContext, 4, "Stats: received all acks: " +
+         StringTk::intToStr(receivedAcks.size() ) + "/" + StringTk::intToStr(notifyList->size() ) );
+
+      return; // perfect, all acks received
+   }
+
+   /* some acks were missing. nothing else we can do here, the leases of these clients will expire
+      on their own. */
+
+   logger->log(Log_DEBUG, logContext, "Some replies to lease revocations missing. "
+      "EntryID: " + entryID + "; "
+      "Received: " + StringTk::intToStr(receivedAcks.size() ) + "/" +
+      StringTk::intToStr(receivedAcks.size() + waitAcks.size() ) );
+}
+
+unsigned LeaseRevokeNotificationWork::incAckCounter()
+{
+   unsigned currentAckCounter;
+
+   SafeMutexLock mutexLock(&ackCounterMutex);
+
+   currentAckCounter = ackCounter++;
+
+   mutexLock.unlock();
+
+   return currentAckCounter;
+}
@@ -0,0 +1,49 @@
+#ifndef LEASEREVOKENOTIFICATIONWORK_H_
+#define LEASEREVOKENOTIFICATIONWORK_H_
+
+#include <common/Common.h>
+#include <common/components/worker/Work.h>
+#include <common/threading/Mutex.h>
+
+
+/**
+ * Tells clients that their leases on an entry were revoked (see LeaseStore).
+ */
+class LeaseRevokeNotificationWork : public Work
+{
+   public:
+      /**
+       * @param notifyList clientIDs of the lease holders; will be owned and freed by this object,
+       * so do not use or free it after calling this.
+       */
+      LeaseRevokeNotificationWork(std::string entryID, StringList* notifyList) :
+         entryID(entryID), notifyList(notifyList)
+      {
+         /* all assignments done in initializer list */
+      }
+
+      virtual ~LeaseRevokeNotificationWork()
+      {
+         delete notifyList;
+      }
+
+
+      virtual void process(char* bufIn, unsigned bufInLen, char* bufOut, unsigned bufOutLen);
+
+
+   private:
+      // static attributes & methods
+
+      static Mutex ackCounterMutex;
+      static unsigned ackCounter;
+
+      static unsigned incAckCounter();
+
+      // instance attributes & methods
+
+      std::string entryID;
+      StringList* notifyList;
+};
+
+
+#endif /* LEASEREVOKENOTIFICATIONWORK_H_ */
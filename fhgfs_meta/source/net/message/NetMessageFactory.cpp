@@ -31,7 +31,9 @@
 // storage messages
 #include <common/net/message/storage/lookup/FindOwnerRespMsg.h>
 #include <common/net/message/storage/attribs/GetChunkFileAttribsRespMsg.h>
+#include <common/net/message/storage/attribs/GetChunkFileAttribsMultiRespMsg.h>
 #include <common/net/message/storage/listing/ListDirFromOffsetRespMsg.h>
+#include <common/net/message/storage/listing/ListDirPlusRespMsg.h>
 #include <common/net/message/storage/creating/MkDirRespMsg.h>
 #include <common/net/message/storage/creating/MkFileRespMsg.h>
 #include <common/net/message/storage/creating/MkFileWithPatternRespMsg.h>
@@ -60,6 +62,7 @@
 #include <net/message/storage/lookup/FindOwnerMsgEx.h>
 #include <net/message/storage/GetStorageTargetInfoMsgEx.h>
 #include <net/message/storage/listing/ListDirFromOffsetMsgEx.h>
+#include <net/message/storage/listing/ListDirPlusMsgEx.h>
 #include <net/message/storage/creating/MkDirMsgEx.h>
 #include <net/message/storage/creating/MkFileMsgEx.h>
 #include <net/message/storage/creating/MkFileWithPatternMsgEx.h>
@@ -184,6 +187,7 @@ NetMessage* NetMessageFactory::createFromMsgType(unsigned short msgType)
       case NETMSGTYPE_FindOwner: { msg = new FindOwnerMsgEx(); } break;
       case NETMSGTYPE_FindOwnerResp: { msg = new FindOwnerRespMsg(); } break;
       case NETMSGTYPE_GetChunkFileAttribsResp: { msg = new GetChunkFileAttribsRespMsg(); } break;
+      case NETMSGTYPE_GetChunkFileAttribsMultiResp: { msg = new GetChunkFileAttribsMultiRespMsg(); } break;
       case NETMSGTYPE_GetStorageTargetInfo: { msg = new GetStorageTargetInfoMsgEx(); } break;
       case NETMSGTYPE_GetEntryInfo: { msg = new GetEntryInfoMsgEx(); } break;
       case NETMSGTYPE_GetEntryInfoResp: { msg = new GetEntryInfoRespMsg(); } break;
@@ -195,6 +199,8 @@ NetMessage* NetMessageFactory::createFromMsgType(unsigned short msgType)
       case NETMSGTYPE_HardlinkResp: { msg = new HardlinkRespMsg(); } break;
       case NETMSGTYPE_ListDirFromOffset: { msg = new ListDirFromOffsetMsgEx(); } break;
       case NETMSGTYPE_ListDirFromOffsetResp: { msg = new ListDirFromOffsetRespMsg(); } break;
+      case NETMSGTYPE_ListDirPlus: { msg = new ListDirPlusMsgEx(); } break;
+      case NETMSGTYPE_ListDirPlusResp: { msg = new ListDirPlusRespMsg(); } break;
       case NETMSGTYPE_ListXAttr: { msg = new ListXAttrMsgEx(); } break;
       case NETMSGTYPE_LookupIntent: { msg = new LookupIntentMsgEx(); } break;
       case NETMSGTYPE_MirrorMetadata: { msg = new MirrorMetadataMsgEx(); } break;
@@ -62,6 +62,9 @@ bool RecreateDentriesMsgEx::processIncoming(struct sockaddr_in* fromAddr, Socket
          continue;
       }
 
+      // (the new name might be cached as non-existing)
+      parentDirInode->invalidateCachedDentry(iter->getID() );
+
       // linking was OK => gather dentry (and inode) data, so fsck can add it
 
       DirEntry dirEntry(iter->getID());
@@ -335,10 +335,18 @@ std::string GenericDebugMsgEx::processOpCacheStatistics(std::istringstream& comm
 
    std::ostringstream responseStream;
    size_t numDirs;
+   size_t numDentries;
+   uint64_t numDentryHits;
+   uint64_t numDentryMisses;
 
-   metaStore->getCacheStats(&numDirs);
+   metaStore->getCacheStats(&numDirs, &numDentries);
+   DentryCache::getStats(&numDentryHits, &numDentryMisses);
 
-   responseStream << "Dirs: " << numDirs;
+   responseStream << "Dirs: " << numDirs << std::endl;
+   responseStream << "Dentries: " << numDentries << std::endl;
+   responseStream << "Dentry hits: " << numDentryHits << std::endl;
+   responseStream << "Dentry misses: " << numDentryMisses << std::endl;
+   responseStream << "Leased entries: " << Program::getApp()->getLeaseStore()->getSize();
 
    return responseStream.str();
 }
@@ -514,14 +522,21 @@ std::string GenericDebugMsgEx::processOpWriteDirDentry(std::istringstream& comma
    DirEntry dentry(entryName);
    bool getDentryRes = parentDirInode->getDentry(entryName, dentry);
 
-   metaStore->releaseDir(parentDirID);
-
    if (!getDentryRes)
+   {
+      metaStore->releaseDir(parentDirID);
       return "Unable to get dentry from parent directory.";
+   }
 
    bool setOwnerRes = dentry.setOwnerNodeID(
       MetaStorageTk::getMetaDirEntryPath(dentriesPath, parentDirID), ownerNodeID);
 
+   parentDirInode->invalidateCachedDentry(entryName);
+
+   metaStore->releaseDir(parentDirID);
+
+   Program::getApp()->getLeaseStore()->revokeLeases(dentry.getEntryID() );
+
    if (!setOwnerRes)
       return "Unable to set new owner node ID in dentry.";
 
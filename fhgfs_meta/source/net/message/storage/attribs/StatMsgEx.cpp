@@ -2,6 +2,7 @@
 #include <common/net/message/storage/attribs/StatRespMsg.h>
 #include <common/toolkit/MessagingTk.h>
 #include <net/msghelpers/MsgHelperStat.h>
+#include <session/LeaseStore.h>
 #include "StatMsgEx.h"
 
 
@@ -28,6 +29,13 @@ bool StatMsgEx::processIncoming(struct sockaddr_in* fromAddr, Socket* sock,
 
    uint16_t parentNodeID = 0;
    std::string parentEntryID;
+   bool isOpenForWrite = false;
+
+   // (the version must be taken before we read anything that is covered by the lease)
+   LeaseStore* leaseStore = app->getLeaseStore();
+   bool leaseRequested = isMsgHeaderCompatFeatureFlagSet(STATMSG_COMPAT_FLAG_LEASE) &&
+      leaseStore->isEnabled();
+   uint64_t leaseVersion = leaseRequested ? leaseStore->getVersion(entryInfo->getEntryID() ) : 0;
    
    if(entryInfo->getParentEntryID().empty() || (entryInfo->getEntryID() == META_ROOTDIR_ID_STR) )
    { // special case: stat for root directory
@@ -38,7 +46,7 @@ bool StatMsgEx::processIncoming(struct sockaddr_in* fromAddr, Socket* sock,
    else
    {
       statRes = MsgHelperStat::stat(entryInfo, true, getMsgHeaderUserID(), statData, &parentNodeID,
-         &parentEntryID);
+         &parentEntryID, &isOpenForWrite);
    }
 
    LOG_DEBUG(logContext, 4, std::string("statRes: ") + FhgfsOpsErrTk::toErrString(statRes) );
@@ -48,6 +56,11 @@ bool StatMsgEx::processIncoming(struct sockaddr_in* fromAddr, Socket* sock,
    if(isMsgHeaderCompatFeatureFlagSet(STATMSG_COMPAT_FLAG_GET_PARENTINFO) && parentNodeID)
       respMsg.addParentInfo(parentNodeID, parentEntryID);
 
+   // no lease for files that are open for writing, as their size and times change all the time
+   if(leaseRequested && (statRes == FhgfsOpsErr_SUCCESS) && !isOpenForWrite &&
+      leaseStore->grantLease(entryInfo->getEntryID(), getClientID(), leaseVersion) )
+      respMsg.addLease(leaseStore->getLeaseMS() );
+
    respMsg.serialize(respBuf, bufLen);
    sock->sendto(respBuf, respMsg.getMsgLength(), 0,
       (struct sockaddr*)fromAddr, sizeof(struct sockaddr_in) );
@@ -0,0 +1,160 @@
+#include <program/Program.h>
+#include <common/net/message/storage/listing/ListDirPlusRespMsg.h>
+#include <net/msghelpers/MsgHelperStat.h>
+#include "ListDirPlusMsgEx.h"
+
+
+bool ListDirPlusMsgEx::processIncoming(struct sockaddr_in* fromAddr, Socket* sock,
+   char* respBuf, size_t bufLen, HighResolutionStats* stats)
+{
+   #ifdef BEEGFS_DEBUG
+      const char* logContext = "ListDirPlusMsgEx incoming";
+
+      std::string peer = fromAddr ? Socket::ipaddrToStr(&fromAddr->sin_addr) : sock->getPeername();
+      LOG_DEBUG(logContext, Log_DEBUG, "Received a ListDirPlusMsg from: " + peer);
+   #endif // BEEGFS_DEBUG
+
+   EntryInfo* entryInfo = this->getEntryInfo();
+
+   LOG_DEBUG(logContext, Log_SPAM,
+      std::string("serverOffset: ")  + StringTk::int64ToStr(getServerOffset() )  + "; " +
+      std::string("maxOutNames: ")   + StringTk::int64ToStr(getMaxOutNames() )   + "; " +
+      std::string("parentEntryID: ") + entryInfo->getParentEntryID()             + "; " +
+      std::string("entryID: ")       + entryInfo->getEntryID() );
+
+   StringList names;
+   UInt8List entryTypes;
+   StringList entryIDs;
+   Int64List serverOffsets;
+   UInt16List ownerNodeIDs;
+   IntList entryFlags;
+   StatDataList statDatas;
+   IntList statResults;
+   int64_t newServerOffset = getServerOffset(); // init to something useful
+
+   ListIncExOutArgs outArgs(&names, &entryTypes, &entryIDs, &serverOffsets, &newServerOffset);
+   outArgs.outOwnerNodeIDs = &ownerNodeIDs;
+   outArgs.outEntryFlags = &entryFlags;
+   outArgs.outInlinedStatData = &statDatas;
+
+   FhgfsOpsErr listRes = listDirIncremental(entryInfo, outArgs);
+
+   if(listRes == FhgfsOpsErr_SUCCESS)
+      statEntries(entryInfo, names, entryTypes, entryIDs, ownerNodeIDs, entryFlags, statDatas,
+         &statResults);
+   else
+   { // send a consistent (empty) response
+      names.clear();
+      entryTypes.clear();
+      entryIDs.clear();
+      serverOffsets.clear();
+      ownerNodeIDs.clear();
+      entryFlags.clear();
+      statDatas.clear();
+   }
+
+   LOG_DEBUG(logContext, Log_SPAM,
+      std::string("newServerOffset: ") + StringTk::int64ToStr(newServerOffset) + "; " +
+      std::string("names.size: ") + StringTk::int64ToStr(names.size() ) + "; " +
+      std::string("listRes: ") + FhgfsOpsErrTk::toErrString(listRes) );
+
+   ListDirPlusRespMsg respMsg(listRes, &names, &entryTypes, &entryIDs, &serverOffsets,
+      newServerOffset, &ownerNodeIDs, &entryFlags, &statResults, &statDatas);
+   respMsg.serialize(respBuf, bufLen);
+   sock->sendto(respBuf, respMsg.getMsgLength(), 0,
+      (struct sockaddr*)fromAddr, sizeof(struct sockaddr_in) );
+
+   Program::getApp()->getNodeOpStats()->updateNodeOp(sock->getPeerIP(), MetaOpCounter_READDIR,
+      getMsgHeaderUserID() );
+
+   return true;
+}
+
+FhgfsOpsErr ListDirPlusMsgEx::listDirIncremental(EntryInfo* entryInfo, ListIncExOutArgs& outArgs)
+{
+   MetaStore* metaStore = Program::getApp()->getMetaStore();
+
+   // reference dir
+   DirInode* dir = metaStore->referenceDir(entryInfo->getEntryID(), true);
+   if(!dir)
+      return FhgfsOpsErr_PATHNOTEXISTS;
+
+   // query contents (including "." and "..", like ListDirFromOffsetMsg for readdir)
+   FhgfsOpsErr listRes = dir->listIncrementalEx(
+      getServerOffset(), getMaxOutNames(), false, outArgs);
+
+   // clean-up
+   metaStore->releaseDir(entryInfo->getEntryID() );
+
+   return listRes;
+}
+
+/**
+ * Get the stat data of all listed entries, similar to what a separate LookupIntentMsg with stat
+ * flag would return for each entry.
+ *
+ * Inlined inodes that are not currently loaded (e.g. not opened) are not read again, because the
+ * listing already returned their stat data from the dentry.
+ *
+ * @param inOutStatDatas contains the inlined stat data from the listing and will be updated with
+ * the actual stat data of each entry (or fake values if the stat failed).
+ * @param outStatResults the stat result for each entry; FhgfsOpsErr_NOTOWNER if the inode is owned
+ * by another metadata node.
+ */
+void ListDirPlusMsgEx::statEntries(EntryInfo* dirInfo, StringList& names, UInt8List& entryTypes,
+   StringList& entryIDs, UInt16List& ownerNodeIDs, IntList& entryFlags,
+   StatDataList& inOutStatDatas, IntList* outStatResults)
+{
+   App* app = Program::getApp();
+   MetaStore* metaStore = app->getMetaStore();
+   uint16_t localNodeID = app->getLocalNode()->getNumID();
+   unsigned msgUserID = getMsgHeaderUserID();
+
+   StringListIter namesIter = names.begin();
+   UInt8ListIter typesIter = entryTypes.begin();
+   StringListIter idsIter = entryIDs.begin();
+   UInt16ListIter ownersIter = ownerNodeIDs.begin();
+   IntListIter flagsIter = entryFlags.begin();
+   StatDataListIter statIter = inOutStatDatas.begin();
+
+   for( ; namesIter != names.end();
+      namesIter++, typesIter++, idsIter++, ownersIter++, flagsIter++, statIter++)
+   {
+      DirEntryType entryType = (DirEntryType)*typesIter;
+      FhgfsOpsErr statRes;
+
+      if(entryType == DirEntryType_INVALID)
+         statRes = FhgfsOpsErr_PATHNOTEXISTS; // dentry could not be loaded
+      else
+      if(*ownersIter != localNodeID)
+         statRes = FhgfsOpsErr_NOTOWNER; // client needs to stat on the owner node (or "."/"..")
+      else
+      {
+         EntryInfo entryInfo(*ownersIter, dirInfo->getEntryID(), *idsIter, *namesIter,
+            entryType, *flagsIter);
+
+         if( (*flagsIter & ENTRYINFO_FEATURE_INLINED) && !DirEntryType_ISDIR(entryType) )
+         { // inlined inode => only need to check whether there is a loaded version of it
+            StatData loadedStatData;
+
+            statRes = metaStore->stat(&entryInfo, false, loadedStatData);
+
+            if(statRes == FhgfsOpsErr_PATHNOTEXISTS)
+               statRes = FhgfsOpsErr_SUCCESS; // not loaded => dentry stat data is up-to-date
+            else
+            if(statRes == FhgfsOpsErr_SUCCESS)
+               *statIter = loadedStatData;
+            else
+            if(statRes == FhgfsOpsErr_DYNAMICATTRIBSOUTDATED)
+               statRes = MsgHelperStat::stat(&entryInfo, true, msgUserID, *statIter);
+         }
+         else
+            statRes = MsgHelperStat::stat(&entryInfo, true, msgUserID, *statIter);
+      }
+
+      if(statRes != FhgfsOpsErr_SUCCESS)
+         statIter->setAllFake(); // (values are not used by the receiver)
+
+      outStatResults->push_back(statRes);
+   }
+}
@@ -0,0 +1,31 @@
+#ifndef LISTDIRPLUSMSGEX_H_
+#define LISTDIRPLUSMSGEX_H_
+
+#include <storage/DirEntryStore.h>
+#include <storage/MetaStore.h>
+#include <common/storage/EntryInfo.h>
+#include <common/storage/StorageErrors.h>
+#include <common/net/message/storage/listing/ListDirPlusMsg.h>
+
+
+class ListDirPlusMsgEx : public ListDirPlusMsg
+{
+   public:
+      ListDirPlusMsgEx() : ListDirPlusMsg()
+      {
+      }
+
+      virtual bool processIncoming(struct sockaddr_in* fromAddr, Socket* sock,
+         char* respBuf, size_t bufLen, HighResolutionStats* stats);
+
+   protected:
+
+   private:
+      FhgfsOpsErr listDirIncremental(EntryInfo* entryInfo, ListIncExOutArgs& outArgs);
+      void statEntries(EntryInfo* dirInfo, StringList& names, UInt8List& entryTypes,
+         StringList& entryIDs, UInt16List& ownerNodeIDs, IntList& entryFlags,
+         StatDataList& inOutStatDatas, IntList* outStatResults);
+};
+
+
+#endif /*LISTDIRPLUSMSGEX_H_*/
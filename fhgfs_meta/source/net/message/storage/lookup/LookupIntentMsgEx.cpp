@@ -5,6 +5,7 @@
 #include <net/msghelpers/MsgHelperMkFile.h>
 #include <net/msghelpers/MsgHelperOpen.h>
 #include <net/msghelpers/MsgHelperStat.h>
+#include <session/LeaseStore.h>
 #include <session/SessionStore.h>
 #include <storage/DentryStoreData.h>
 #include "LookupIntentMsgEx.h"
@@ -48,6 +49,15 @@ bool LookupIntentMsgEx::processIncoming(struct sockaddr_in* fromAddr, Socket* so
    PathInfo pathInfo; /* Added to NetMessage as ref-pointer, so object needs to exist until
                        * the NetMessage got serialized! */
 
+   /* a lease can only be granted to a revalidating client (which already has the dentry) and the
+      version must be taken before we read anything that is covered by the lease */
+   LeaseStore* leaseStore = app->getLeaseStore();
+   bool leaseRequested = (getIntentFlags() & LOOKUPINTENTMSG_FLAG_LEASE) &&
+      (getIntentFlags() & LOOKUPINTENTMSG_FLAG_REVALIDATE) && leaseStore->isEnabled();
+   uint64_t leaseVersion = leaseRequested ?
+      leaseStore->getVersion(getEntryInfo()->getEntryID() ) : 0;
+   bool statLeasable = false; // true if stat data is local and not changing (file not open)
+
    // sanity checks
    if (unlikely (parentEntryID.empty() || entryName.empty() ) )
    {
@@ -162,20 +172,35 @@ bool LookupIntentMsgEx::processIncoming(struct sockaddr_in* fromAddr, Socket* so
          StatData* dentryStatData = inodeData.getInodeStatData();
 
          respMsg.addResponseStat(FhgfsOpsErr_SUCCESS, dentryStatData);
+
+         statLeasable = true;
       }
       else
       {  // read stat data separately
          StatData statData;
-         FhgfsOpsErr statRes = stat(&diskEntryInfo, true, statData);
+         bool isOpenForWrite = false;
+         FhgfsOpsErr statRes = stat(&diskEntryInfo, true, statData, &isOpenForWrite);
 
          respMsg.addResponseStat(statRes, &statData);
 
          if(statRes != FhgfsOpsErr_SUCCESS)
             goto send_response;
+
+         statLeasable = !isOpenForWrite;
       }
 
    }
 
+   // lookup-lease (only if revalidate and stat succeeded, see above)
+   if(leaseRequested && statLeasable && !createFlag &&
+      !(getIntentFlags() & LOOKUPINTENTMSG_FLAG_OPEN) )
+   {
+      LOG_DEBUG(logContext, Log_SPAM, "Lookup: lease");
+
+      if(leaseStore->grantLease(diskEntryInfo.getEntryID(), getClientID(), leaseVersion) )
+         respMsg.addResponseLease(leaseStore->getLeaseMS() );
+   }
+
    // lookup-open
    if(getIntentFlags() & LOOKUPINTENTMSG_FLAG_OPEN)
    {
@@ -277,7 +302,11 @@ FhgfsOpsErr LookupIntentMsgEx::create(EntryInfo* parentInfo,
       outEntryInfo, outInodeData);
 }
 
-FhgfsOpsErr LookupIntentMsgEx::stat(EntryInfo* entryInfo, bool loadFromDisk, StatData& outStatData)
+/**
+ * @param outIsOpenForWrite see MsgHelperStat::stat()
+ */
+FhgfsOpsErr LookupIntentMsgEx::stat(EntryInfo* entryInfo, bool loadFromDisk, StatData& outStatData,
+   bool* outIsOpenForWrite)
 {
    Node* localNode = Program::getApp()->getLocalNode();
 
@@ -285,7 +314,8 @@ FhgfsOpsErr LookupIntentMsgEx::stat(EntryInfo* entryInfo, bool loadFromDisk, Sta
 
    // check if we can stat on this machine or if entry is owned by another server
    if(entryInfo->getOwnerNodeID() == localNode->getNumID() )
-      statRes = MsgHelperStat::stat(entryInfo, loadFromDisk, getMsgHeaderUserID(), outStatData);
+      statRes = MsgHelperStat::stat(entryInfo, loadFromDisk, getMsgHeaderUserID(), outStatData,
+         NULL, NULL, outIsOpenForWrite);
 
    return statRes;
 }
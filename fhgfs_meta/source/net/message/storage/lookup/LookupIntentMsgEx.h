@@ -34,7 +34,8 @@ class LookupIntentMsgEx : public LookupIntentMsg
       FhgfsOpsErr revalidate(EntryInfo* entryInfo);
       FhgfsOpsErr create(EntryInfo* parentInfo, std::string& entryName, EntryInfo* outEntryInfo,
          FileInodeStoreData* outInodeData);
-      FhgfsOpsErr stat(EntryInfo* entryInfo, bool loadFromDisk, StatData& outStatData);
+      FhgfsOpsErr stat(EntryInfo* entryInfo, bool loadFromDisk, StatData& outStatData,
+         bool* outIsOpenForWrite);
       FhgfsOpsErr open(EntryInfo* entryInfo, std::string* outFileHandleID,
          StripePattern** outPattern, PathInfo* outPathInfo);
 
@@ -74,6 +74,14 @@ FhgfsOpsErr MsgHelperOpen::openMetaFile(EntryInfo* entryInfo, unsigned accessFla
 
    FhgfsOpsErr openRes = metaStore->openFile(entryInfo, accessFlags, outOpenInode);
 
+   /* size and timestamps of files that are open for writing change on the storage servers, so
+      clients must not keep using leased attribs (new leases are not granted while open).
+      note: must be done after the open, so that a concurrent stat either sees the file as open for
+      writing or gets its lease revoked here. */
+   if( (openRes == FhgfsOpsErr_SUCCESS) &&
+       (accessFlags & (OPENFILE_ACCESS_WRITE | OPENFILE_ACCESS_READWRITE) ) )
+      Program::getApp()->getLeaseStore()->revokeLeases(entryInfo->getEntryID() );
+
    return openRes;
 }
 
@@ -1,8 +1,3 @@
-#include <common/net/message/storage/attribs/GetChunkFileAttribsMsg.h>
-#include <common/net/message/storage/attribs/GetChunkFileAttribsRespMsg.h>
-#include <common/toolkit/MessagingTk.h>
-#include <common/toolkit/SynchronizedCounter.h>
-#include <components/worker/GetChunkFileAttribsWork.h>
 #include <program/Program.h>
 #include "MsgHelperStat.h"
 
@@ -15,9 +10,12 @@
  * @param msgUserID will only be used in msg header info.
  * @param outParentNodeID may be NULL (default) if the caller is not interested
  * @param outParentEntryID may NULL (if outParentNodeID is NULL)
+ * @param outIsOpenForWrite may be NULL if the caller is not interested; true if the entry is a file
+ *    that is currently open for writing (so the returned size and times will probably change soon)
  */
 FhgfsOpsErr MsgHelperStat::stat(EntryInfo* entryInfo, bool loadFromDisk, unsigned msgUserID,
-   StatData& outStatData, uint16_t* outParentNodeID, std::string* outParentEntryID)
+   StatData& outStatData, uint16_t* outParentNodeID, std::string* outParentEntryID,
+   bool* outIsOpenForWrite)
 {
    const char* logContext = "Stat Helper (stat entry)";
 
@@ -28,6 +26,8 @@ FhgfsOpsErr MsgHelperStat::stat(EntryInfo* entryInfo, bool loadFromDisk, unsigne
    retVal = metaStore->stat(entryInfo, loadFromDisk, outStatData, outParentNodeID,
       outParentEntryID);
 
+   SAFE_ASSIGN(outIsOpenForWrite, retVal == FhgfsOpsErr_DYNAMICATTRIBSOUTDATED);
+
    if(retVal == FhgfsOpsErr_DYNAMICATTRIBSOUTDATED)
    { // dynamic attribs outdated => get fresh dynamic attribs from storage servers and stat again
       MsgHelperStat::refreshDynAttribs(entryInfo, false, msgUserID);
@@ -46,10 +46,11 @@ FhgfsOpsErr MsgHelperStat::stat(EntryInfo* entryInfo, bool loadFromDisk, unsigne
    { /* metadata not found: it is hard to tell whether this is an error (e.g. metadata was never
         created) or just a normal case (e.g. someone removed a file during an "ls -l") */
 
-      LogContext(logContext).log(Log_DEBUG, "Missing metadata for entryID: " +
-         entryInfo->getEntryID() + ". "
-         "(Possibly a valid race of two processes or a cached entry that is now being "
-         "checked by a client revalidate() method.)");
+      if(LogContext::isLevelEnabledForThread(Log_DEBUG) )
+         LogContext(logContext).log(Log_DEBUG, "Missing metadata for entryID: " +
+            entryInfo->getEntryID() + ". "
+            "(Possibly a valid race of two processes or a cached entry that is now being "
+            "checked by a client revalidate() method.)");
    }
 
    return retVal;
@@ -59,13 +60,18 @@ FhgfsOpsErr MsgHelperStat::stat(EntryInfo* entryInfo, bool loadFromDisk, unsigne
 /**
  * Refresh current file size and other dynamic attribs from storage servers.
  *
+ * Note: If tuneDynAttribsCacheMS is set, a refresh that is not made persistent will be skipped if
+ * the attribs have been refreshed within that time and have not been updated since then.
+ *
  * @makePersistent whether or not this method should also update persistent metadata.
  * @param msgUserID only used for msg header info.
  */
 FhgfsOpsErr MsgHelperStat::refreshDynAttribs(EntryInfo* entryInfo, bool makePersistent,
    unsigned msgUserID)
 {
-   MetaStore* metaStore = Program::getApp()->getMetaStore();
+   App* app = Program::getApp();
+   MetaStore* metaStore = app->getMetaStore();
+   unsigned cacheMS = app->getConfig()->getTuneDynAttribsCacheMS();
    FhgfsOpsErr retVal;
 
    std::string parentEntryID = entryInfo->getParentEntryID();
@@ -81,178 +87,28 @@ FhgfsOpsErr MsgHelperStat::refreshDynAttribs(EntryInfo* entryInfo, bool makePers
       return FhgfsOpsErr_PATHNOTEXISTS;
    }
 
-   if(inode->getStripePattern()->getAssignedNumTargets() == 1)
-      retVal = refreshDynAttribsSequential(inode, entryID, msgUserID);
-   else
-      retVal = refreshDynAttribsParallel(inode, entryID, msgUserID);
+   if(!makePersistent && cacheMS && inode->getDynAttribsRefreshValid(cacheMS) )
+   { // recently refreshed => nothing to do
+      metaStore->releaseFile(entryInfo->getParentEntryID(), inode);
 
-   if( (retVal == FhgfsOpsErr_SUCCESS) && makePersistent)
-   {
-      bool persistenceRes = inode->updateInodeOnDisk(entryInfo);
-      if(!persistenceRes)
-         retVal = FhgfsOpsErr_INTERNAL;
+      return FhgfsOpsErr_SUCCESS;
    }
 
-   metaStore->releaseFile(entryInfo->getParentEntryID(), inode);
-
-   return retVal;
-}
-
-/**
- * Note: This method does support getting attrs from buddymirrors, but only from group's primary.
- *
- * @param msgUserID only used for msg header info.
- */
-FhgfsOpsErr MsgHelperStat::refreshDynAttribsSequential(FileInode* inode, std::string entryID,
-   unsigned msgUserID)
-{
-   const char* logContext = "Stat Helper (refresh chunk files S)";
-
-   FhgfsOpsErr retVal = FhgfsOpsErr_SUCCESS; // will be set to node error, if any
-
-   App* app = Program::getApp();
-
-   StripePattern* pattern = inode->getStripePattern();
-   const UInt16Vector* targetIDs = pattern->getStripeTargetIDs();
-
-   DynamicFileAttribsVec dynAttribsVec(targetIDs->size() );
-
-   PathInfo pathInfo;
-   inode->getPathInfo(&pathInfo);
-
-   // send request to each node and receive the response message
-   unsigned currentStripeNodeIndex = 0;
-   for(UInt16VectorConstIter iter = targetIDs->begin();
-      iter != targetIDs->end();
-      iter++, currentStripeNodeIndex++)
-   {
-      uint16_t targetID = *iter;
-
-      // prepare request message
-
-      GetChunkFileAttribsMsg getSizeMsg(entryID, *iter, &pathInfo);
-
-      if(pattern->getPatternType() == STRIPEPATTERN_BuddyMirror)
-         getSizeMsg.addMsgHeaderFeatureFlag(GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR);
-
-      getSizeMsg.setMsgHeaderUserID(msgUserID);
-
-      // prepare communication
-
-      RequestResponseTarget rrTarget(targetID, app->getTargetMapper(), app->getStorageNodes() );
-
-      rrTarget.setTargetStates(app->getTargetStateStore() );
-
-      if(pattern->getPatternType() == STRIPEPATTERN_BuddyMirror)
-         rrTarget.setMirrorInfo(app->getMirrorBuddyGroupMapper(), false);
-
-      RequestResponseArgs rrArgs(NULL, &getSizeMsg, NETMSGTYPE_GetChunkFileAttribsResp);
-
-      // communicate
-
-      FhgfsOpsErr requestRes = MessagingTk::requestResponseTarget(&rrTarget, &rrArgs);
+   DynamicFileAttribsVec dynAttribsVec;
 
-      if(unlikely(requestRes != FhgfsOpsErr_SUCCESS) )
-      { // communication error
-         LogContext(logContext).log(Log_WARNING,
-            "Communication with storage target failed. " +
-            std::string( (pattern->getPatternType() == STRIPEPATTERN_BuddyMirror) ? "Mirror " : "")+
-            "TargetID: " + StringTk::uintToStr(targetID) + "; "
-            "EntryID: " + entryID);
+   retVal = app->getChunkAttribsBatcher()->refreshDynAttribs(inode, entryID, msgUserID,
+      dynAttribsVec);
 
-         retVal = requestRes;
-         continue;
-      }
+   inode->setDynAttribs(dynAttribsVec, retVal == FhgfsOpsErr_SUCCESS); // the actual update
 
-      // correct response type received
-      GetChunkFileAttribsRespMsg* getSizeRespMsg = (GetChunkFileAttribsRespMsg*)rrArgs.outRespMsg;
-
-      FhgfsOpsErr getSizeResult = getSizeRespMsg->getResult();
-      if(getSizeResult != FhgfsOpsErr_SUCCESS)
-      { // error: got no fresh attributes
-         LogContext(logContext).log(Log_WARNING,
-            "Getting fresh chunk file attributes from target failed. " +
-            std::string( (pattern->getPatternType() == STRIPEPATTERN_BuddyMirror) ? "Mirror " : "")+
-            "TargetID: " + StringTk::uintToStr(targetID) + "; "
-            "EntryID: " + entryID);
-
-         retVal = getSizeResult;
-         continue;
-      }
-
-      // success: got fresh chunk file attributes
-      //log.log(3, std::string("Got fresh filesize from node: ") + nodeID);
-
-      DynamicFileAttribs currentDynAttribs(getSizeRespMsg->getStorageVersion(),
-         getSizeRespMsg->getSize(), getSizeRespMsg->getAllocedBlocks(),
-         getSizeRespMsg->getModificationTimeSecs(), getSizeRespMsg->getLastAccessTimeSecs() );
-
-      dynAttribsVec[currentStripeNodeIndex] = currentDynAttribs;
-   }
-
-
-   inode->setDynAttribs(dynAttribsVec); // the actual update
-
-   if(retVal != FhgfsOpsErr_SUCCESS)
-   {
-      LogContext(logContext).log(Log_WARNING,
-         "Problems occurred during chunk file attributes refresh. "
-         "EntryID: " + entryID);
-   }
-
-   return retVal;
-}
-
-/**
- * Note: For buddymirrored files, only group's primary is used.
- */
-FhgfsOpsErr MsgHelperStat::refreshDynAttribsParallel(FileInode* inode, std::string entryID,
-   unsigned msgUserID)
-{
-   const char* logContext = "Stat Helper (refresh chunk files)";
-
-   FhgfsOpsErr retVal = FhgfsOpsErr_SUCCESS; // will be set to node error, if any
-
-   App* app = Program::getApp();
-   MultiWorkQueue* slaveQ = app->getCommSlaveQueue();
-   StripePattern* pattern = inode->getStripePattern();
-   const UInt16Vector* targetIDs = pattern->getStripeTargetIDs();
-
-   DynamicFileAttribsVec dynAttribsVec(targetIDs->size() );
-
-   size_t numWorks = targetIDs->size();
-
-   FhgfsOpsErrVec nodeResults(numWorks);
-   SynchronizedCounter counter;
-
-   PathInfo pathInfo;
-   inode->getPathInfo(&pathInfo);
-
-   for(size_t i=0; i < numWorks; i++)
-   {
-      GetChunkFileAttribsWork* work = new GetChunkFileAttribsWork(entryID, pattern, (*targetIDs)[i],
-         &pathInfo, &(dynAttribsVec[i]), &(nodeResults[i]), &counter);
-
-      work->setMsgUserID(msgUserID);
-
-      slaveQ->addDirectWork(work);
-   }
-
-   counter.waitForCount(numWorks);
-
-   for(size_t i=0; i < numWorks; i++)
+   if( (retVal == FhgfsOpsErr_SUCCESS) && makePersistent)
    {
-      if(nodeResults[i] != FhgfsOpsErr_SUCCESS)
-      {
-         LogContext(logContext).log(Log_WARNING,
-            "Problems occurred during file attribs refresh. entryID: " + entryID);
-
-         retVal = nodeResults[i];
-         break;
-      }
+      bool persistenceRes = inode->updateInodeOnDisk(entryInfo);
+      if(!persistenceRes)
+         retVal = FhgfsOpsErr_INTERNAL;
    }
 
-   inode->setDynAttribs(dynAttribsVec); // the actual update
+   metaStore->releaseFile(entryInfo->getParentEntryID(), inode);
 
    return retVal;
 }
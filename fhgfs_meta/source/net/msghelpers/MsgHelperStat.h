@@ -11,7 +11,7 @@ class MsgHelperStat
    public:
       static FhgfsOpsErr stat(EntryInfo* entryInfo, bool loadFromDisk, unsigned msgUserID,
          StatData& outStatData, uint16_t* outParentNodeId = NULL,
-         std::string* outParentEntryID = NULL);
+         std::string* outParentEntryID = NULL, bool* outIsOpenForWrite = NULL);
       static FhgfsOpsErr refreshDynAttribs(EntryInfo* entryInfo, bool makePersistent,
          unsigned msgUserID);
 
@@ -19,11 +19,6 @@ class MsgHelperStat
    private:
       MsgHelperStat() {}
 
-      static FhgfsOpsErr refreshDynAttribsSequential(FileInode* file, std::string entryID,
-         unsigned msgUserID);
-      static FhgfsOpsErr refreshDynAttribsParallel(FileInode* file, std::string entryID,
-         unsigned msgUserID);
-
 
    public:
       // inliners
@@ -0,0 +1,163 @@
+#include <common/threading/SafeMutexLock.h>
+#include <components/worker/LeaseRevokeNotificationWork.h>
+#include <program/Program.h>
+#include "LeaseStore.h"
+
+
+/**
+ * Get the version that needs to be passed to grantLease() for data that is read after this call.
+ */
+uint64_t LeaseStore::getVersion(const std::string& entryID)
+{
+   LeaseStoreShard* shard = getShard(entryID);
+
+   SafeMutexLock mutexLock(&shard->mutex); // L O C K
+
+   uint64_t currentVersion = shard->version;
+
+   mutexLock.unlock(); // U N L O C K
+
+   return currentVersion;
+}
+
+/**
+ * Record a lease of the given client on the given entry (or renew an existing lease).
+ *
+ * @param version value of getVersion() before the data that is covered by the lease was read.
+ * @return false if the lease was not granted, because leases are disabled or because there might
+ * have been a concurrent modification of the entry.
+ */
+bool LeaseStore::grantLease(const std::string& entryID, const std::string& clientID,
+   uint64_t version)
+{
+   if(!isEnabled() )
+      return false;
+
+   LeaseStoreShard* shard = getShard(entryID);
+   bool retVal = false;
+
+   SafeMutexLock mutexLock(&shard->mutex); // L O C K
+
+   if(version == shard->version)
+   {
+      shard->leases[entryID][clientID] = Time();
+      retVal = true;
+   }
+
+   mutexLock.unlock(); // U N L O C K
+
+   return retVal;
+}
+
+/**
+ * Revoke all leases on the given entry and notify the holders of leases that didn't expire yet.
+ *
+ * Note: Must be called after the modification of the entry was written, so that a client that
+ * asks again after the notification gets the new data.
+ */
+void LeaseStore::revokeLeases(const std::string& entryID)
+{
+   if(!isEnabled() )
+      return;
+
+   LeaseStoreShard* shard = getShard(entryID);
+   StringList* notifyList = NULL;
+
+   SafeMutexLock mutexLock(&shard->mutex); // L O C K
+
+   shard->version++;
+
+   LeaseMapIter iter = shard->leases.find(entryID);
+   if(iter != shard->leases.end() )
+   {
+      LeaseHolderMap& holders = iter->second;
+
+      for(LeaseHolderMapIter holderIter = holders.begin(); holderIter != holders.end();
+          holderIter++)
+      {
+         if(holderIter->second.elapsedMS() >= leaseMS)
+            continue; // lease expired already
+
+         if(!notifyList)
+            notifyList = new StringList();
+
+         notifyList->push_back(holderIter->first);
+      }
+
+      shard->leases.erase(iter);
+   }
+
+   mutexLock.unlock(); // U N L O C K
+
+   if(!notifyList)
+      return; // nobody to notify
+
+   // just delegate to comm slaves
+
+   MultiWorkQueue* slaveQ = Program::getApp()->getCommSlaveQueue();
+
+   Work* work = new LeaseRevokeNotificationWork(entryID, notifyList);
+
+   slaveQ->addDirectWork(work);
+}
+
+/**
+ * Remove expired leases (to keep memory usage low for entries that are never modified).
+ */
+void LeaseStore::pruneExpired()
+{
+   if(!isEnabled() )
+      return;
+
+   for(unsigned i = 0; i < LEASESTORE_NUM_SHARDS; i++)
+   {
+      LeaseStoreShard* shard = &shards[i];
+
+      SafeMutexLock mutexLock(&shard->mutex); // L O C K
+
+      LeaseMapIter iter = shard->leases.begin();
+
+      while(iter != shard->leases.end() )
+      {
+         LeaseHolderMap& holders = iter->second;
+
+         LeaseHolderMapIter holderIter = holders.begin();
+
+         while(holderIter != holders.end() )
+         {
+            if(holderIter->second.elapsedMS() >= leaseMS)
+               holders.erase(holderIter++);
+            else
+               holderIter++;
+         }
+
+         if(holders.empty() )
+            shard->leases.erase(iter++);
+         else
+            iter++;
+      }
+
+      mutexLock.unlock(); // U N L O C K
+   }
+}
+
+/**
+ * @return number of entries with leases (including expired leases that were not pruned yet).
+ */
+size_t LeaseStore::getSize()
+{
+   size_t numEntries = 0;
+
+   for(unsigned i = 0; i < LEASESTORE_NUM_SHARDS; i++)
+   {
+      LeaseStoreShard* shard = &shards[i];
+
+      SafeMutexLock mutexLock(&shard->mutex); // L O C K
+
+      numEntries += shard->leases.size();
+
+      mutexLock.unlock(); // U N L O C K
+   }
+
+   return numEntries;
+}
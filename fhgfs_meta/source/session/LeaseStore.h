@@ -0,0 +1,95 @@
+#ifndef LEASESTORE_H_
+#define LEASESTORE_H_
+
+#include <common/threading/Mutex.h>
+#include <common/toolkit/BufferTk.h>
+#include <common/toolkit/Time.h>
+#include <common/Common.h>
+
+
+#define LEASESTORE_NUM_SHARDS    64 /* number of independently locked parts of the store */
+
+
+typedef std::map<std::string, Time> LeaseHolderMap; // keys are clientIDs, values are grant times
+typedef LeaseHolderMap::iterator LeaseHolderMapIter;
+typedef LeaseHolderMap::value_type LeaseHolderMapVal;
+
+typedef std::map<std::string, LeaseHolderMap> LeaseMap; // keys are entryIDs
+typedef LeaseMap::iterator LeaseMapIter;
+typedef LeaseMap::value_type LeaseMapVal;
+
+
+/**
+ * Independently locked part of the LeaseStore.
+ */
+struct LeaseStoreShard
+{
+   LeaseStoreShard() : version(0) {}
+
+   Mutex mutex; // protects the fields below
+
+   uint64_t version; // increased on each revocation of an entry in this shard
+   LeaseMap leases;
+};
+
+
+/**
+ * Keeps track of the clients that hold a lease on the dentry and attribs of an entry, so that the
+ * leases can be revoked when the entry is modified.
+ *
+ * Clients use their cached dentry and attribs without asking the server again while they hold a
+ * lease. Leases expire after tuneAttribLeaseMS (measured by the client from the time it sent the
+ * request), so a client that doesn't get the revocation notification will still see the change
+ * after that time.
+ *
+ * To avoid that a lease is granted for data that was read before a concurrent modification,
+ * the grant is only accepted if the version of the shard did not change since getVersion() was
+ * called before reading the data (similar to DentryCache).
+ */
+class LeaseStore
+{
+   public:
+      LeaseStore(unsigned leaseMS) : leaseMS(leaseMS) {}
+
+      uint64_t getVersion(const std::string& entryID);
+      bool grantLease(const std::string& entryID, const std::string& clientID, uint64_t version);
+      void revokeLeases(const std::string& entryID);
+      void pruneExpired();
+
+      size_t getSize();
+
+
+   private:
+      unsigned leaseMS; // 0 means leases are disabled
+
+      LeaseStoreShard shards[LEASESTORE_NUM_SHARDS];
+
+
+      // inliners
+
+      /**
+       * Get the shard that is responsible for the given entryID.
+       */
+      LeaseStoreShard* getShard(const std::string& entryID)
+      {
+         unsigned hash = BufferTk::hash32(entryID.c_str(), entryID.length() );
+
+         return &shards[hash % LEASESTORE_NUM_SHARDS];
+      }
+
+
+   public:
+      // getters & setters
+
+      bool isEnabled() const
+      {
+         return (leaseMS != 0);
+      }
+
+      unsigned getLeaseMS() const
+      {
+         return leaseMS;
+      }
+};
+
+#endif /* LEASESTORE_H_ */
@@ -0,0 +1,263 @@
+#include <common/app/log/LogContext.h>
+#include <common/threading/SafeMutexLock.h>
+#include "DentryCache.h"
+#include "DirEntry.h"
+
+
+AtomicUInt64 DentryCache::numHits;
+AtomicUInt64 DentryCache::numMisses;
+
+
+/**
+ * @param maxEntries max number of cached dentries (including negative entries).
+ */
+DentryCache::DentryCache(unsigned maxEntries) :
+   maxEntries(maxEntries), version(0)
+{
+   clockHand = entries.end();
+}
+
+/**
+ * @param outEntry only valid if DentryCacheLookupRes_HIT is returned; must be a fresh DirEntry
+ * object that was not loaded yet.
+ */
+DentryCacheLookupRes DentryCache::lookup(const std::string& entryName, DirEntry& outEntry)
+{
+   DentryCacheLookupRes retVal = DentryCacheLookupRes_MISS;
+
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   DentryCacheMapIter iter = entries.find(entryName);
+   if(iter != entries.end() )
+   {
+      DentryCacheEntry& cacheEntry = iter->second;
+
+      if(cacheEntry.serialDentry.empty() )
+         retVal = DentryCacheLookupRes_NOTEXISTS;
+      else
+      if(likely(outEntry.deserializeDentry(cacheEntry.serialDentry.data() ) ) )
+         retVal = DentryCacheLookupRes_HIT;
+      else
+      { // should never happen, as we only cache dentries that were deserialized before
+         LogContext("DentryCache (lookup)").logErr(
+            "Unable to deserialize cached dentry: " + entryName);
+         removeUnlocked(iter);
+      }
+
+      if(retVal != DentryCacheLookupRes_MISS)
+         cacheEntry.accessed = true;
+   }
+
+   mutexLock.unlock(); // U N L O C K
+
+   if(retVal == DentryCacheLookupRes_MISS)
+      numMisses.increase();
+   else
+      numHits.increase();
+
+   return retVal;
+}
+
+/**
+ * Cache a dentry that was successfully loaded from disk.
+ *
+ * @param version value of getVersion() before the dentry was loaded.
+ */
+void DentryCache::insert(const std::string& entryName, DirEntry& entry, uint64_t version)
+{
+   char buf[DIRENTRY_SERBUF_SIZE];
+
+   DentryCacheEntry cacheEntry;
+
+   unsigned bufLen = entry.serializeDentry(buf);
+
+   cacheEntry.entryID = entry.getEntryID();
+   cacheEntry.serialDentry.assign(buf, bufLen);
+   cacheEntry.accessed = false;
+
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   if(version == this->version)
+      insertUnlocked(entryName, cacheEntry);
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/**
+ * Cache that a dentry does not exist.
+ *
+ * @param version value of getVersion() before the dentry was looked up on disk.
+ */
+void DentryCache::insertNegative(const std::string& entryName, uint64_t version)
+{
+   DentryCacheEntry cacheEntry;
+
+   cacheEntry.accessed = false;
+
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   if(version == this->version)
+      insertUnlocked(entryName, cacheEntry);
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/**
+ * Forget everything about the given name (e.g. because it is about to be created, removed or
+ * updated).
+ */
+void DentryCache::invalidate(const std::string& entryName)
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   version++;
+
+   DentryCacheMapIter iter = entries.find(entryName);
+   if(iter != entries.end() )
+      removeUnlocked(iter);
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/**
+ * Forget all names that refer to the given entryID (e.g. because the inlined inode was updated).
+ */
+void DentryCache::invalidateByID(const std::string& entryID)
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   version++;
+
+   std::pair<DentryCacheIDMapIter, DentryCacheIDMapIter> range = entryIDs.equal_range(entryID);
+
+   StringList entryNames; // (removeUnlocked() modifies entryIDs, so we collect names first)
+
+   for(DentryCacheIDMapIter iter = range.first; iter != range.second; iter++)
+      entryNames.push_back(iter->second);
+
+   for(StringListIter nameIter = entryNames.begin(); nameIter != entryNames.end(); nameIter++)
+   {
+      DentryCacheMapIter iter = entries.find(*nameIter);
+      if(iter != entries.end() )
+         removeUnlocked(iter);
+   }
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+void DentryCache::clear()
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   version++;
+
+   entries.clear();
+   entryIDs.clear();
+   clockHand = entries.end();
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/**
+ * Get the version that needs to be passed to insert() for data that is loaded from disk after
+ * this call.
+ */
+uint64_t DentryCache::getVersion()
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   uint64_t currentVersion = this->version;
+
+   mutexLock.unlock(); // U N L O C K
+
+   return currentVersion;
+}
+
+size_t DentryCache::getSize()
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   size_t numEntries = entries.size();
+
+   mutexLock.unlock(); // U N L O C K
+
+   return numEntries;
+}
+
+/**
+ * Get hit and miss counters of all dentry caches.
+ */
+void DentryCache::getStats(uint64_t* outNumHits, uint64_t* outNumMisses)
+{
+   *outNumHits = numHits.read();
+   *outNumMisses = numMisses.read();
+}
+
+/**
+ * Note: Replaces an existing entry with the same name.
+ */
+void DentryCache::insertUnlocked(const std::string& entryName,
+   const DentryCacheEntry& cacheEntry)
+{
+   DentryCacheMapIter iter = entries.find(entryName);
+   if(iter != entries.end() )
+      removeUnlocked(iter);
+   else
+   if(entries.size() >= maxEntries)
+      evictUnlocked();
+
+   entries.insert(DentryCacheMapVal(entryName, cacheEntry) );
+
+   if(!cacheEntry.entryID.empty() )
+      entryIDs.insert(DentryCacheIDMapVal(cacheEntry.entryID, entryName) );
+}
+
+void DentryCache::removeUnlocked(DentryCacheMapIter iter)
+{
+   const std::string& entryID = iter->second.entryID;
+
+   if(!entryID.empty() )
+   {
+      std::pair<DentryCacheIDMapIter, DentryCacheIDMapIter> range =
+         entryIDs.equal_range(entryID);
+
+      for(DentryCacheIDMapIter idIter = range.first; idIter != range.second; idIter++)
+      {
+         if(idIter->second == iter->first)
+         {
+            entryIDs.erase(idIter);
+            break;
+         }
+      }
+   }
+
+   if(clockHand == iter)
+      clockHand++;
+
+   entries.erase(iter);
+}
+
+/**
+ * Remove one entry that was not accessed since the last time the clock hand passed it.
+ *
+ * Note: Terminates after at most two rounds of the hand, because accessed flags are only set with
+ * the mutex held.
+ */
+void DentryCache::evictUnlocked()
+{
+   while(!entries.empty() )
+   {
+      if(clockHand == entries.end() )
+         clockHand = entries.begin();
+
+      if(clockHand->second.accessed)
+      { // second chance
+         clockHand->second.accessed = false;
+         clockHand++;
+         continue;
+      }
+
+      removeUnlocked(clockHand);
+      return;
+   }
+}
@@ -0,0 +1,94 @@
+#ifndef DENTRYCACHE_H_
+#define DENTRYCACHE_H_
+
+#include <common/threading/Atomics.h>
+#include <common/threading/Mutex.h>
+#include <common/Common.h>
+
+
+class DirEntry;
+
+
+enum DentryCacheLookupRes
+{
+   DentryCacheLookupRes_MISS = 0, // nothing known about this name
+   DentryCacheLookupRes_HIT = 1, // dentry was deserialized from the cache
+   DentryCacheLookupRes_NOTEXISTS = 2 // dentry is known to not exist
+};
+
+
+/**
+ * A cached dentry.
+ */
+struct DentryCacheEntry
+{
+   std::string entryID; // empty for negative entries
+   std::string serialDentry; // dentry as stored on disk, empty for negative entries
+   bool accessed; // for CLOCK replacement (set on each hit)
+};
+
+typedef std::map<std::string, DentryCacheEntry> DentryCacheMap; // keys are entry names
+typedef DentryCacheMap::iterator DentryCacheMapIter;
+typedef DentryCacheMap::value_type DentryCacheMapVal;
+
+typedef std::multimap<std::string, std::string> DentryCacheIDMap; // entryID => entry name
+typedef DentryCacheIDMap::iterator DentryCacheIDMapIter;
+typedef DentryCacheIDMap::value_type DentryCacheIDMapVal;
+
+
+/**
+ * Bounded in-memory cache of the parsed dentries of a single directory (owned by the
+ * DirEntryStore of a cached DirInode), so that repeated lookups, stats and listings of hot
+ * directories don't need to read the dentry files again.
+ *
+ * Dentries are cached in their serialized on-disk form, so that every reader gets its own
+ * DirEntry copy (as with loading from disk). Names that don't exist are cached as negative entries.
+ * Replacement uses CLOCK, similar to the dir cache in InodeDirStore.
+ *
+ * Invalidation: The DirEntryStore invalidates names that it modifies. Updates of inlined inodes
+ * don't go through the DirEntryStore, so they invalidate by entryID (which also covers hardlinks
+ * in the same dir). To avoid that a reader inserts data that it loaded before a concurrent
+ * invalidation, readers get the version before loading from disk and insert() ignores the data
+ * if the version changed in the meantime.
+ *
+ * Note: Has its own mutex, which is never held while calling out to other objects, so it can be
+ * used with or without the DirEntryStore lock.
+ */
+class DentryCache
+{
+   public:
+      DentryCache(unsigned maxEntries);
+
+      DentryCacheLookupRes lookup(const std::string& entryName, DirEntry& outEntry);
+      void insert(const std::string& entryName, DirEntry& entry, uint64_t version);
+      void insertNegative(const std::string& entryName, uint64_t version);
+
+      void invalidate(const std::string& entryName);
+      void invalidateByID(const std::string& entryID);
+      void clear();
+
+      uint64_t getVersion();
+      size_t getSize();
+
+      static void getStats(uint64_t* outNumHits, uint64_t* outNumMisses);
+
+
+   private:
+      Mutex mutex; // protects the fields below
+
+      unsigned maxEntries;
+      uint64_t version; // increased on each invalidation
+
+      DentryCacheMap entries;
+      DentryCacheIDMap entryIDs; // positive entries only
+      DentryCacheMapIter clockHand; // next replacement candidate (or entries.end() )
+
+      static AtomicUInt64 numHits; // for all dirs (including negative hits)
+      static AtomicUInt64 numMisses; // for all dirs
+
+      void insertUnlocked(const std::string& entryName, const DentryCacheEntry& cacheEntry);
+      void removeUnlocked(DentryCacheMapIter iter);
+      void evictUnlocked();
+};
+
+#endif /* DENTRYCACHE_H_ */
@@ -0,0 +1,1054 @@
+#include <common/app/log/LogContext.h>
+#include <common/threading/SafeMutexLock.h>
+#include <common/toolkit/serialization/Serialization.h>
+#include <common/toolkit/BufferTk.h>
+#include <common/toolkit/StorageTk.h>
+#include "DirEntry.h"
+#include "DentryIndex.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+
+/**
+ * @param dentriesPath path to the dentries dir of the directory, which will also contain the
+ * index file.
+ */
+DentryIndex::DentryIndex(const std::string& dentriesPath) :
+   dentriesPath(dentriesPath), indexPath(dentriesPath + "/" META_DENTRYINDEX_FILENAME),
+   fd(-1), generation(0), fileSize(0), numLiveRecords(0), numDeadRecords(0)
+{
+   dirMTime.tv_sec = 0;
+   dirMTime.tv_nsec = 0;
+}
+
+DentryIndex::~DentryIndex()
+{
+   unloadUnlocked();
+}
+
+/**
+ * Make sure that the index is loaded and consistent with the dentries dir before the caller
+ * modifies the dentries dir and calls one of the update methods.
+ *
+ * If the index cannot be loaded, the following update methods will be ignored and the index will
+ * be rebuilt on next use.
+ */
+void DentryIndex::prepareUpdate()
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   checkLoadedUnlocked();
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/**
+ * Incremental listing based on the index (similar to telldir/seekdir for the dentries dir).
+ *
+ * Note: Cookies from before a rebuild of the index (e.g. after a server crash) restart the
+ * listing at the first record, so the caller might see some entries twice in that case.
+ *
+ * @param cookie 0 to start at the beginning or nextCookie of the last entry from a previous call.
+ * @param filterDots true if "." and ".." should not be returned.
+ * @param outEntries entries will be appended to this list.
+ * @return false if the index could not be loaded or read, so that the caller needs to fall back
+ * to reading the dentries dir.
+ */
+bool DentryIndex::list(int64_t cookie, unsigned maxOutEntries, bool filterDots,
+   DentryIndexEntryList& outEntries)
+{
+   const char* logContext = "DentryIndex (list)";
+
+   bool retVal = false;
+   unsigned numEntries = 0;
+   int64_t offset;
+   char* buf = NULL;
+
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   if(!checkLoadedUnlocked() )
+      goto unlock_and_exit;
+
+   if(!cookie)
+      offset = 0;
+   else
+   if(getCookieGeneration(cookie) != generation)
+   { // cookie from before a rebuild => restart at the first record
+      LOG_DEBUG(logContext, Log_DEBUG, "Restarting listing after index rebuild: " + indexPath);
+      offset = DENTRYINDEX_HEADER_LEN;
+   }
+   else
+      offset = getCookieOffset(cookie);
+
+   // the dots are not stored in the index, so they get their own offsets before the first record
+
+   if(!filterDots && (offset == 0) && (numEntries < maxOutEntries) )
+   {
+      DentryIndexEntry dotEntry = {".", "<.>", DirEntryType_DIRECTORY, 0,
+         makeCookie(generation, DENTRYINDEX_COOKIE_DOT) };
+
+      outEntries.push_back(dotEntry);
+      numEntries++;
+      offset = DENTRYINDEX_COOKIE_DOT;
+   }
+
+   if(!filterDots && (offset == DENTRYINDEX_COOKIE_DOT) && (numEntries < maxOutEntries) )
+   {
+      DentryIndexEntry dotDotEntry = {"..", "<..>", DirEntryType_DIRECTORY, 0,
+         makeCookie(generation, DENTRYINDEX_COOKIE_DOTDOT) };
+
+      outEntries.push_back(dotDotEntry);
+      numEntries++;
+      offset = DENTRYINDEX_COOKIE_DOTDOT;
+   }
+
+   if(numEntries == maxOutEntries)
+   {
+      retVal = true;
+      goto unlock_and_exit;
+   }
+
+   if(offset < DENTRYINDEX_HEADER_LEN)
+      offset = DENTRYINDEX_HEADER_LEN;
+
+   buf = (char*)malloc(DENTRYINDEX_READ_BUFLEN);
+   if(!buf)
+      goto unlock_and_exit;
+
+   while( (numEntries < maxOutEntries) && (offset < fileSize) )
+   {
+      ssize_t readRes = pread(fd, buf, DENTRYINDEX_READ_BUFLEN, offset);
+      if(readRes <= 0)
+      {
+         LogContext(logContext).logErr("Unable to read dentry index: " + indexPath + ". " +
+            "SysErr: " + System::getErrString() );
+         unloadUnlocked();
+         goto unlock_and_exit;
+      }
+
+      size_t bufPos = 0;
+
+      while( (numEntries < maxOutEntries) && (bufPos < (size_t)readRes) )
+      {
+         DentryIndexEntry entry;
+         bool isLive;
+         unsigned recLen;
+
+         if(!deserializeRecord(&buf[bufPos], readRes - bufPos, &entry, &isLive, &recLen) )
+            break; // incomplete record => read again from its beginning
+
+         bufPos += recLen;
+
+         if(!isLive)
+            continue;
+
+         entry.nextCookie = makeCookie(generation, offset + bufPos);
+         outEntries.push_back(entry);
+         numEntries++;
+      }
+
+      if(!bufPos)
+      { // a single record can never be larger than the buffer
+         LogContext(logContext).logErr("Found invalid record in dentry index: " + indexPath + "; "
+            "offset: " + StringTk::int64ToStr(offset) );
+         unloadUnlocked();
+         goto unlock_and_exit;
+      }
+
+      offset += bufPos;
+   }
+
+   retVal = true;
+
+unlock_and_exit:
+   mutexLock.unlock(); // U N L O C K
+
+   SAFE_FREE(buf);
+
+   return retVal;
+}
+
+/**
+ * Add a record for a new dentry.
+ *
+ * Note: Call prepareUpdate() before creating the dentry file.
+ */
+void DentryIndex::addEntry(const std::string& name, const std::string& entryID,
+   DirEntryType entryType, uint16_t ownerNodeID)
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   if(fd != -1)
+      finishUpdateUnlocked(appendRecordUnlocked(name, entryID, entryType, ownerNodeID) );
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/**
+ * Add a record for a new hardlink to an existing dentry in this dir.
+ *
+ * Note: Call prepareUpdate() before creating the link.
+ */
+void DentryIndex::addLink(const std::string& fromName, const std::string& toName)
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   if(fd != -1)
+   {
+      int64_t fromOffset;
+      DentryIndexEntry fromEntry;
+
+      bool updateRes = findRecordUnlocked(fromName, &fromOffset, &fromEntry) &&
+         appendRecordUnlocked(toName, fromEntry.entryID, fromEntry.entryType,
+            fromEntry.ownerNodeID);
+
+      finishUpdateUnlocked(updateRes);
+   }
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/**
+ * Mark the record of a removed dentry as deleted.
+ *
+ * Note: Call prepareUpdate() before removing the dentry file.
+ */
+void DentryIndex::removeEntry(const std::string& name)
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   if(fd != -1)
+   {
+      int64_t offset;
+
+      bool updateRes = findRecordUnlocked(name, &offset, NULL) &&
+         removeRecordUnlocked(name, offset);
+
+      finishUpdateUnlocked(updateRes);
+   }
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/**
+ * Update the index after a rename within the dentries dir (including an overwritten toName).
+ *
+ * Note: Call prepareUpdate() before the rename.
+ */
+void DentryIndex::renameEntry(const std::string& fromName, const std::string& toName)
+{
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   if(fd != -1)
+   {
+      int64_t fromOffset;
+      int64_t toOffset;
+      DentryIndexEntry fromEntry;
+
+      bool updateRes = findRecordUnlocked(fromName, &fromOffset, &fromEntry);
+
+      if(updateRes && findRecordUnlocked(toName, &toOffset, NULL) )
+         updateRes = removeRecordUnlocked(toName, toOffset); // overwritten entry
+
+      updateRes = updateRes &&
+         removeRecordUnlocked(fromName, fromOffset) &&
+         appendRecordUnlocked(toName, fromEntry.entryID, fromEntry.entryType,
+            fromEntry.ownerNodeID);
+
+      finishUpdateUnlocked(updateRes);
+   }
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/**
+ * Update the owner of a dentry in place.
+ *
+ * Note: Call prepareUpdate() before updating the dentry file.
+ */
+void DentryIndex::setOwnerNodeID(const std::string& name, uint16_t ownerNodeID)
+{
+   const char* logContext = "DentryIndex (set owner)";
+
+   SafeMutexLock mutexLock(&mutex); // L O C K
+
+   if(fd != -1)
+   {
+      int64_t offset;
+
+      bool updateRes = findRecordUnlocked(name, &offset, NULL);
+      if(updateRes)
+      {
+         char ownerBuf[sizeof(uint16_t)];
+         Serialization::serializeUInt16(ownerBuf, ownerNodeID);
+
+         ssize_t writeRes = pwrite(fd, ownerBuf, sizeof(ownerBuf),
+            offset + Serialization::serialLenUInt() + 2 * Serialization::serialLenUInt8() );
+         if(writeRes != (ssize_t)sizeof(ownerBuf) )
+         {
+            LogContext(logContext).logErr("Unable to update dentry index: " + indexPath + ". " +
+               "SysErr: " + System::getErrString() );
+            updateRes = false;
+         }
+      }
+
+      finishUpdateUnlocked(updateRes);
+   }
+
+   mutexLock.unlock(); // U N L O C K
+}
+
+/**
+ * Remove the index file of a dentries dir (e.g. before the dentries dir itself is removed).
+ */
+void DentryIndex::removeIndexFile(const std::string& dentriesPath)
+{
+   const char* logContext = "DentryIndex (remove)";
+
+   std::string indexPath = dentriesPath + "/" META_DENTRYINDEX_FILENAME;
+
+   int unlinkRes = unlink(indexPath.c_str() );
+   if(unlinkRes && (errno != ENOENT) )
+      LogContext(logContext).logErr("Unable to remove dentry index: " + indexPath + ". " +
+         "SysErr: " + System::getErrString() );
+}
+
+/**
+ * Load the index if it is not loaded yet and rebuild it if it is not consistent with the dentries
+ * dir (i.e. the dentries dir was modified without updating the index).
+ *
+ * @return false if the index is not usable
+ */
+bool DentryIndex::checkLoadedUnlocked()
+{
+   if(fd == -1)
+      return loadUnlocked();
+
+   struct timespec currentDirMTime;
+
+   if(!getDirMTime(&currentDirMTime) )
+      return false;
+
+   if( (currentDirMTime.tv_sec == dirMTime.tv_sec) &&
+       (currentDirMTime.tv_nsec == dirMTime.tv_nsec) )
+      return true;
+
+   LOG_DEBUG("DentryIndex (check)", Log_DEBUG, "Dentries dir was modified, rebuilding index: " +
+      indexPath);
+
+   return rebuildUnlocked();
+}
+
+/**
+ * Open and validate the existing index file and fill the hash map. Rebuilds the index if the file
+ * does not exist or is not consistent with the dentries dir.
+ *
+ * @return false if the index is not usable
+ */
+bool DentryIndex::loadUnlocked()
+{
+   const char* logContext = "DentryIndex (load)";
+
+   char headerBuf[DENTRYINDEX_HEADER_LEN];
+   unsigned magic;
+   unsigned version;
+   unsigned headerGeneration;
+   uint64_t headerNumLiveRecords;
+   int64_t headerFileSize;
+   int64_t headerMTimeSecs;
+   int64_t headerMTimeNSecs;
+   struct timespec currentDirMTime;
+   struct stat statBuf;
+   char* buf = NULL;
+   int64_t offset;
+
+   fd = open(indexPath.c_str(), O_RDWR);
+   if(fd == -1)
+   {
+      if(errno == ENOENT)
+         return rebuildUnlocked();
+
+      LogContext(logContext).logErr("Unable to open dentry index: " + indexPath + ". " +
+         "SysErr: " + System::getErrString() );
+      return false;
+   }
+
+   ssize_t readRes = pread(fd, headerBuf, DENTRYINDEX_HEADER_LEN, 0);
+   if(readRes != DENTRYINDEX_HEADER_LEN)
+      goto rebuild;
+
+   { // deserialize header
+      size_t bufPos = 0;
+      unsigned fieldLen;
+
+      Serialization::deserializeUInt(&headerBuf[bufPos], DENTRYINDEX_HEADER_LEN - bufPos,
+         &magic, &fieldLen);
+      bufPos += fieldLen;
+
+      Serialization::deserializeUInt(&headerBuf[bufPos], DENTRYINDEX_HEADER_LEN - bufPos,
+         &version, &fieldLen);
+      bufPos += fieldLen;
+
+      Serialization::deserializeUInt(&headerBuf[bufPos], DENTRYINDEX_HEADER_LEN - bufPos,
+         &headerGeneration, &fieldLen);
+      bufPos += 2 * fieldLen; // (skip reserved field)
+
+      Serialization::deserializeUInt64(&headerBuf[bufPos], DENTRYINDEX_HEADER_LEN - bufPos,
+         &headerNumLiveRecords, &fieldLen);
+      bufPos += fieldLen;
+
+      Serialization::deserializeInt64(&headerBuf[bufPos], DENTRYINDEX_HEADER_LEN - bufPos,
+         &headerFileSize, &fieldLen);
+      bufPos += fieldLen;
+
+      Serialization::deserializeInt64(&headerBuf[bufPos], DENTRYINDEX_HEADER_LEN - bufPos,
+         &headerMTimeSecs, &fieldLen);
+      bufPos += fieldLen;
+
+      Serialization::deserializeInt64(&headerBuf[bufPos], DENTRYINDEX_HEADER_LEN - bufPos,
+         &headerMTimeNSecs, &fieldLen);
+      bufPos += fieldLen;
+   }
+
+   if( (magic != DENTRYINDEX_MAGIC) || (version != DENTRYINDEX_VERSION) )
+      goto rebuild;
+
+   generation = headerGeneration; // (so that a rebuild will not reuse this generation)
+
+   if(fstat(fd, &statBuf) || (statBuf.st_size != headerFileSize) ||
+      (headerFileSize < DENTRYINDEX_HEADER_LEN) )
+      goto rebuild; // incomplete update
+
+   if(!getDirMTime(&currentDirMTime) ||
+      (currentDirMTime.tv_sec != headerMTimeSecs) || (currentDirMTime.tv_nsec != headerMTimeNSecs) )
+      goto rebuild; // dentries dir was modified without updating the index
+
+   // read all records to fill the hash map
+
+   buf = (char*)malloc(DENTRYINDEX_READ_BUFLEN);
+   if(!buf)
+      goto rebuild;
+
+   fileSize = headerFileSize;
+   numLiveRecords = 0;
+   numDeadRecords = 0;
+   offset = DENTRYINDEX_HEADER_LEN;
+
+   while(offset < fileSize)
+   {
+      readRes = pread(fd, buf, DENTRYINDEX_READ_BUFLEN, offset);
+      if(readRes <= 0)
+         goto rebuild;
+
+      size_t bufPos = 0;
+
+      for( ; ; )
+      {
+         DentryIndexEntry entry;
+         bool isLive;
+         unsigned recLen;
+
+         if(!deserializeRecord(&buf[bufPos], readRes - bufPos, &entry, &isLive, &recLen) )
+            break;
+
+         if(isLive)
+         {
+            liveRecords.insert(DentryIndexHashMapVal(hashName(entry.name), offset + bufPos) );
+            numLiveRecords++;
+         }
+         else
+            numDeadRecords++;
+
+         bufPos += recLen;
+      }
+
+      if(!bufPos)
+         goto rebuild; // invalid record
+
+      offset += bufPos;
+   }
+
+   if( (offset != fileSize) || (numLiveRecords != headerNumLiveRecords) )
+      goto rebuild;
+
+   dirMTime = currentDirMTime;
+
+   SAFE_FREE(buf);
+
+   return true;
+
+
+rebuild:
+   LOG_DEBUG(logContext, Log_DEBUG, "Dentry index is not consistent, rebuilding: " + indexPath);
+
+   SAFE_FREE(buf);
+
+   return rebuildUnlocked();
+}
+
+/**
+ * Recreate the index file from the dentry files in the dentries dir.
+ *
+ * @return false if the index is not usable
+ */
+bool DentryIndex::rebuildUnlocked()
+{
+   const char* logContext = "DentryIndex (rebuild)";
+
+   DIR* dirHandle;
+   struct dirent* dirEntry;
+   char* buf = NULL;
+   size_t bufPos = 0;
+
+   unloadUnlocked();
+
+   // new generation, so that old cookies are not interpreted as offsets in the new file
+   generation = (generation + 1) & DENTRYINDEX_COOKIE_GEN_MASK;
+   if(!generation)
+      generation = 1;
+
+   // note: we create the file before we read the dir, because creation modifies the dir mtime
+
+   fd = open(indexPath.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+   if(fd == -1)
+   {
+      LogContext(logContext).logErr("Unable to create dentry index: " + indexPath + ". " +
+         "SysErr: " + System::getErrString() );
+      return false;
+   }
+
+   fileSize = DENTRYINDEX_HEADER_LEN;
+   numLiveRecords = 0;
+   dirMTime.tv_sec = 0; // (invalid header until the rebuild is complete)
+   dirMTime.tv_nsec = 0;
+
+   if(!writeHeaderUnlocked() )
+      goto err_unload;
+
+   buf = (char*)malloc(DENTRYINDEX_READ_BUFLEN);
+   if(!buf)
+      goto err_unload;
+
+   dirHandle = opendir(dentriesPath.c_str() );
+   if(!dirHandle)
+   {
+      LogContext(logContext).logErr("Unable to open dentries dir: " + dentriesPath + ". " +
+         "SysErr: " + System::getErrString() );
+      goto err_unload;
+   }
+
+   while( (dirEntry = StorageTk::readdirFiltered(dirHandle) ) )
+   {
+      DirEntry entry(dirEntry->d_name);
+
+      if(!entry.loadFromFileName(dentriesPath, dirEntry->d_name) )
+      {
+         errno = 0;
+         continue; // (already logged)
+      }
+
+      if(bufPos + DENTRYINDEX_RECORD_HEADER_LEN + strlen(dirEntry->d_name) +
+         entry.getEntryID().length() > DENTRYINDEX_READ_BUFLEN)
+      { // buffer full => flush
+         if(pwrite(fd, buf, bufPos, fileSize) != (ssize_t)bufPos)
+         {
+            LogContext(logContext).logErr("Unable to write dentry index: " + indexPath + ". " +
+               "SysErr: " + System::getErrString() );
+
+            closedir(dirHandle);
+            goto err_unload;
+         }
+
+         fileSize += bufPos;
+         bufPos = 0;
+      }
+
+      int64_t recordOffset = fileSize + bufPos;
+
+      bufPos += serializeRecord(&buf[bufPos], dirEntry->d_name, entry.getEntryID(),
+         entry.getEntryType(), entry.getOwnerNodeID() );
+
+      liveRecords.insert(DentryIndexHashMapVal(hashName(dirEntry->d_name), recordOffset) );
+      numLiveRecords++;
+   }
+
+   if(errno)
+   {
+      LogContext(logContext).logErr("Unable to read dentries dir: " + dentriesPath + ". " +
+         "SysErr: " + System::getErrString() );
+
+      closedir(dirHandle);
+      goto err_unload;
+   }
+
+   closedir(dirHandle);
+
+   if(bufPos)
+   {
+      if(pwrite(fd, buf, bufPos, fileSize) != (ssize_t)bufPos)
+      {
+         LogContext(logContext).logErr("Unable to write dentry index: " + indexPath + ". " +
+            "SysErr: " + System::getErrString() );
+         goto err_unload;
+      }
+
+      fileSize += bufPos;
+   }
+
+   if(!getDirMTime(&dirMTime) || !writeHeaderUnlocked() )
+      goto err_unload;
+
+   SAFE_FREE(buf);
+
+   LOG_DEBUG(logContext, Log_DEBUG, "Rebuilt dentry index: " + indexPath + "; "
+      "entries: " + StringTk::uint64ToStr(numLiveRecords) );
+
+   return true;
+
+
+err_unload:
+   SAFE_FREE(buf);
+
+   unloadUnlocked();
+   unlink(indexPath.c_str() );
+
+   return false;
+}
+
+/**
+ * Move all live records to the beginning of the file (in place, because records are only moved
+ * towards lower offsets) and truncate the file after the last live record.
+ *
+ * Offsets of records change, so this uses a new generation (like a rebuild). The header is
+ * invalidated first, so that an interrupted compaction leads to a rebuild on next load; the caller
+ * writes the new header afterwards.
+ *
+ * @return false if the index is not usable anymore
+ */
+bool DentryIndex::compactUnlocked()
+{
+   const char* logContext = "DentryIndex (compact)";
+
+   uint64_t oldNumLiveRecords = numLiveRecords;
+   uint64_t oldNumDeadRecords = numDeadRecords;
+   int64_t readOffset = DENTRYINDEX_HEADER_LEN;
+   int64_t writeOffset = DENTRYINDEX_HEADER_LEN;
+
+   char* buf = (char*)malloc(DENTRYINDEX_READ_BUFLEN);
+   if(!buf)
+      return false;
+
+   dirMTime.tv_sec = 0; // (invalid header until the compaction is complete)
+   dirMTime.tv_nsec = 0;
+
+   if(!writeHeaderUnlocked() )
+      goto err_free;
+
+   liveRecords.clear();
+   numLiveRecords = 0;
+
+   while(readOffset < fileSize)
+   {
+      ssize_t readRes = pread(fd, buf, DENTRYINDEX_READ_BUFLEN, readOffset);
+      if(readRes <= 0)
+         goto err_io;
+
+      size_t bufPos = 0;
+      size_t liveBufPos = 0; // live records are moved together at the beginning of buf
+
+      for( ; ; )
+      {
+         DentryIndexEntry entry;
+         bool isLive;
+         unsigned recLen;
+
+         if(!deserializeRecord(&buf[bufPos], readRes - bufPos, &entry, &isLive, &recLen) )
+            break;
+
+         if(isLive)
+         {
+            memmove(&buf[liveBufPos], &buf[bufPos], recLen);
+
+            liveRecords.insert(
+               DentryIndexHashMapVal(hashName(entry.name), writeOffset + liveBufPos) );
+            numLiveRecords++;
+
+            liveBufPos += recLen;
+         }
+
+         bufPos += recLen;
+      }
+
+      if(!bufPos)
+      {
+         LogContext(logContext).logErr("Invalid record in dentry index: " + indexPath + "; "
+            "offset: " + StringTk::int64ToStr(readOffset) );
+         goto err_free;
+      }
+
+      // note: writeOffset <= readOffset, so we only overwrite records that were read already
+
+      if(liveBufPos &&
+         (pwrite(fd, buf, liveBufPos, writeOffset) != (ssize_t)liveBufPos) )
+         goto err_io;
+
+      readOffset += bufPos;
+      writeOffset += liveBufPos;
+   }
+
+   if(numLiveRecords != oldNumLiveRecords)
+   {
+      LogContext(logContext).logErr("Unexpected number of live records in dentry index: " +
+         indexPath);
+      goto err_free;
+   }
+
+   if(ftruncate(fd, writeOffset) )
+      goto err_io;
+
+   SAFE_FREE(buf);
+
+   fileSize = writeOffset;
+   numDeadRecords = 0;
+
+   generation = (generation + 1) & DENTRYINDEX_COOKIE_GEN_MASK;
+   if(!generation)
+      generation = 1;
+
+   LOG_DEBUG(logContext, Log_DEBUG, "Compacted dentry index: " + indexPath + "; "
+      "removed records: " + StringTk::uint64ToStr(oldNumDeadRecords) );
+   IGNORE_UNUSED_DEBUG_VARIABLE(oldNumDeadRecords);
+
+   return true;
+
+
+err_io:
+   LogContext(logContext).logErr("Unable to compact dentry index: " + indexPath + ". " +
+      "SysErr: " + System::getErrString() );
+
+err_free:
+   SAFE_FREE(buf);
+
+   return false;
+}
+
+void DentryIndex::unloadUnlocked()
+{
+   if(fd != -1)
+   {
+      close(fd);
+      fd = -1;
+   }
+
+   liveRecords.clear();
+   numLiveRecords = 0;
+   numDeadRecords = 0;
+   fileSize = 0;
+}
+
+bool DentryIndex::writeHeaderUnlocked()
+{
+   const char* logContext = "DentryIndex (write header)";
+
+   char headerBuf[DENTRYINDEX_HEADER_LEN];
+
+   serializeHeader(headerBuf, generation, numLiveRecords, fileSize, &dirMTime);
+
+   ssize_t writeRes = pwrite(fd, headerBuf, DENTRYINDEX_HEADER_LEN, 0);
+   if(writeRes != DENTRYINDEX_HEADER_LEN)
+   {
+      LogContext(logContext).logErr("Unable to write dentry index header: " + indexPath + ". " +
+         "SysErr: " + System::getErrString() );
+      return false;
+   }
+
+   return true;
+}
+
+bool DentryIndex::appendRecordUnlocked(const std::string& name, const std::string& entryID,
+   DirEntryType entryType, uint16_t ownerNodeID)
+{
+   const char* logContext = "DentryIndex (append)";
+
+   size_t recLen = DENTRYINDEX_RECORD_HEADER_LEN + name.length() + entryID.length();
+   char* buf = (char*)malloc(recLen);
+   if(!buf)
+      return false;
+
+   serializeRecord(buf, name, entryID, entryType, ownerNodeID);
+
+   ssize_t writeRes = pwrite(fd, buf, recLen, fileSize);
+
+   free(buf);
+
+   if(writeRes != (ssize_t)recLen)
+   {
+      LogContext(logContext).logErr("Unable to write dentry index: " + indexPath + ". " +
+         "SysErr: " + System::getErrString() );
+      return false;
+   }
+
+   liveRecords.insert(DentryIndexHashMapVal(hashName(name), fileSize) );
+   numLiveRecords++;
+   fileSize += recLen;
+
+   return true;
+}
+
+/**
+ * Mark the record at the given offset as deleted. If this was the last live record, the file is
+ * truncated (with a new generation, because offsets will be reused).
+ */
+bool DentryIndex::removeRecordUnlocked(const std::string& name, int64_t offset)
+{
+   const char* logContext = "DentryIndex (remove record)";
+
+   char flagsBuf[1];
+   Serialization::serializeUInt8(flagsBuf, 0);
+
+   ssize_t writeRes = pwrite(fd, flagsBuf, sizeof(flagsBuf),
+      offset + Serialization::serialLenUInt() );
+   if(writeRes != (ssize_t)sizeof(flagsBuf) )
+   {
+      LogContext(logContext).logErr("Unable to update dentry index: " + indexPath + ". " +
+         "SysErr: " + System::getErrString() );
+      return false;
+   }
+
+   std::pair<DentryIndexHashMapIter, DentryIndexHashMapIter> range =
+      liveRecords.equal_range(hashName(name) );
+
+   for(DentryIndexHashMapIter iter = range.first; iter != range.second; iter++)
+   {
+      if(iter->second == offset)
+      {
+         liveRecords.erase(iter);
+         break;
+      }
+   }
+
+   numLiveRecords--;
+   numDeadRecords++;
+
+   if(!numLiveRecords && (fileSize > DENTRYINDEX_HEADER_LEN) )
+   { // no live records left => reclaim space
+      if(ftruncate(fd, DENTRYINDEX_HEADER_LEN) )
+      {
+         LogContext(logContext).logErr("Unable to truncate dentry index: " + indexPath + ". " +
+            "SysErr: " + System::getErrString() );
+         return false;
+      }
+
+      fileSize = DENTRYINDEX_HEADER_LEN;
+      numDeadRecords = 0;
+
+      generation = (generation + 1) & DENTRYINDEX_COOKIE_GEN_MASK;
+      if(!generation)
+         generation = 1;
+   }
+
+   return true;
+}
+
+/**
+ * @param outEntry may be NULL if the caller is only interested in the offset.
+ * @return false if no live record with the given name exists or on error.
+ */
+bool DentryIndex::findRecordUnlocked(const std::string& name, int64_t* outOffset,
+   DentryIndexEntry* outEntry)
+{
+   const char* logContext = "DentryIndex (find)";
+
+   // note: names are limited to NAME_MAX and entryIDs are short, so one record fits in the buffer
+   char buf[DENTRYINDEX_RECORD_HEADER_LEN + 2 * (NAME_MAX + 1)];
+
+   std::pair<DentryIndexHashMapIter, DentryIndexHashMapIter> range =
+      liveRecords.equal_range(hashName(name) );
+
+   for(DentryIndexHashMapIter iter = range.first; iter != range.second; iter++)
+   {
+      DentryIndexEntry entry;
+      bool isLive;
+      unsigned recLen;
+
+      ssize_t readRes = pread(fd, buf, sizeof(buf), iter->second);
+      if( (readRes <= 0) ||
+          !deserializeRecord(buf, readRes, &entry, &isLive, &recLen) )
+      {
+         LogContext(logContext).logErr("Unable to read dentry index: " + indexPath + "; "
+            "offset: " + StringTk::int64ToStr(iter->second) );
+         return false;
+      }
+
+      if(isLive && (entry.name == name) )
+      {
+         *outOffset = iter->second;
+         SAFE_ASSIGN(outEntry, entry);
+         return true;
+      }
+   }
+
+   return false;
+}
+
+/**
+ * Store the current dir mtime in the header after an update or drop the index if the update
+ * failed (so that it will be rebuilt on next use). Compacts the index file if the update left too
+ * many records of removed dentries in it.
+ *
+ * @param updateRes result of the preceding update.
+ */
+void DentryIndex::finishUpdateUnlocked(bool updateRes)
+{
+   if(updateRes &&
+      (numDeadRecords >= DENTRYINDEX_COMPACT_MIN_DEAD) && (numDeadRecords > numLiveRecords) )
+      updateRes = compactUnlocked();
+
+   if(updateRes && getDirMTime(&dirMTime) && writeHeaderUnlocked() )
+      return;
+
+   LogContext("DentryIndex (update)").log(Log_WARNING,
+      "Dropping inconsistent dentry index: " + indexPath);
+
+   unloadUnlocked();
+   unlink(indexPath.c_str() );
+}
+
+bool DentryIndex::getDirMTime(struct timespec* outMTime)
+{
+   struct stat statBuf;
+
+   int statRes = stat(dentriesPath.c_str(), &statBuf);
+   if(statRes)
+   {
+      LogContext("DentryIndex (stat)").logErr("Unable to stat dentries dir: " + dentriesPath +
+         ". " + "SysErr: " + System::getErrString() );
+      return false;
+   }
+
+   *outMTime = statBuf.st_mtim;
+
+   return true;
+}
+
+/**
+ * Record format: recLen (including this header), flags, entryType, ownerNodeID, nameLen, idLen,
+ * name, entryID (strings without terminating zero).
+ *
+ * @param buf must be at least DENTRYINDEX_RECORD_HEADER_LEN + name.length() + entryID.length()
+ * @return number of bytes written to buf
+ */
+unsigned DentryIndex::serializeRecord(char* buf, const std::string& name,
+   const std::string& entryID, DirEntryType entryType, uint16_t ownerNodeID)
+{
+   unsigned recLen = DENTRYINDEX_RECORD_HEADER_LEN + name.length() + entryID.length();
+   size_t bufPos = 0;
+
+   bufPos += Serialization::serializeUInt(&buf[bufPos], recLen);
+   bufPos += Serialization::serializeUInt8(&buf[bufPos], DENTRYINDEX_RECORD_FLAG_LIVE);
+   bufPos += Serialization::serializeUInt8(&buf[bufPos], (uint8_t)entryType);
+   bufPos += Serialization::serializeUInt16(&buf[bufPos], ownerNodeID);
+   bufPos += Serialization::serializeUInt16(&buf[bufPos], name.length() );
+   bufPos += Serialization::serializeUInt16(&buf[bufPos], entryID.length() );
+
+   memcpy(&buf[bufPos], name.c_str(), name.length() );
+   bufPos += name.length();
+
+   memcpy(&buf[bufPos], entryID.c_str(), entryID.length() );
+   bufPos += entryID.length();
+
+   return bufPos;
+}
+
+/**
+ * @param outEntry nextCookie will not be set.
+ * @return false if buf does not contain a complete and valid record.
+ */
+bool DentryIndex::deserializeRecord(const char* buf, size_t bufLen, DentryIndexEntry* outEntry,
+   bool* outIsLive, unsigned* outRecLen)
+{
+   unsigned recLen;
+   uint8_t flags;
+   uint8_t entryType;
+   uint16_t ownerNodeID;
+   uint16_t nameLen;
+   uint16_t idLen;
+   size_t bufPos = 0;
+   unsigned fieldLen;
+
+   if(bufLen < DENTRYINDEX_RECORD_HEADER_LEN)
+      return false;
+
+   Serialization::deserializeUInt(&buf[bufPos], bufLen - bufPos, &recLen, &fieldLen);
+   bufPos += fieldLen;
+
+   Serialization::deserializeUInt8(&buf[bufPos], bufLen - bufPos, &flags, &fieldLen);
+   bufPos += fieldLen;
+
+   Serialization::deserializeUInt8(&buf[bufPos], bufLen - bufPos, &entryType, &fieldLen);
+   bufPos += fieldLen;
+
+   Serialization::deserializeUInt16(&buf[bufPos], bufLen - bufPos, &ownerNodeID, &fieldLen);
+   bufPos += fieldLen;
+
+   Serialization::deserializeUInt16(&buf[bufPos], bufLen - bufPos, &nameLen, &fieldLen);
+   bufPos += fieldLen;
+
+   Serialization::deserializeUInt16(&buf[bufPos], bufLen - bufPos, &idLen, &fieldLen);
+   bufPos += fieldLen;
+
+   if(unlikely( (recLen != DENTRYINDEX_RECORD_HEADER_LEN + (unsigned)nameLen + idLen) || !nameLen) )
+      return false; // invalid record
+
+   if(recLen > bufLen)
+      return false; // incomplete
+
+   outEntry->name.assign(&buf[bufPos], nameLen);
+   bufPos += nameLen;
+
+   outEntry->entryID.assign(&buf[bufPos], idLen);
+   bufPos += idLen;
+
+   outEntry->entryType = (DirEntryType)entryType;
+   outEntry->ownerNodeID = ownerNodeID;
+
+   *outIsLive = (flags & DENTRYINDEX_RECORD_FLAG_LIVE) != 0;
+   *outRecLen = recLen;
+
+   return true;
+}
+
+/**
+ * Header format: magic, version, generation, reserved, numLiveRecords, fileSize, dir mtime secs,
+ * dir mtime nsecs (padded to DENTRYINDEX_HEADER_LEN).
+ *
+ * @param buf must be at least DENTRYINDEX_HEADER_LEN
+ */
+unsigned DentryIndex::serializeHeader(char* buf, unsigned generation, uint64_t numLiveRecords,
+   int64_t fileSize, const struct timespec* dirMTime)
+{
+   size_t bufPos = 0;
+
+   memset(buf, 0, DENTRYINDEX_HEADER_LEN);
+
+   bufPos += Serialization::serializeUInt(&buf[bufPos], DENTRYINDEX_MAGIC);
+   bufPos += Serialization::serializeUInt(&buf[bufPos], DENTRYINDEX_VERSION);
+   bufPos += Serialization::serializeUInt(&buf[bufPos], generation);
+   bufPos += Serialization::serializeUInt(&buf[bufPos], 0); // reserved
+   bufPos += Serialization::serializeUInt64(&buf[bufPos], numLiveRecords);
+   bufPos += Serialization::serializeInt64(&buf[bufPos], fileSize);
+   bufPos += Serialization::serializeInt64(&buf[bufPos], dirMTime->tv_sec);
+   bufPos += Serialization::serializeInt64(&buf[bufPos], dirMTime->tv_nsec);
+
+   return DENTRYINDEX_HEADER_LEN;
+}
+
+uint32_t DentryIndex::hashName(const std::string& name)
+{
+   return BufferTk::hash32(name.c_str(), name.length() );
+}
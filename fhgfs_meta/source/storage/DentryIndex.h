@@ -0,0 +1,159 @@
+#ifndef DENTRYINDEX_H_
+#define DENTRYINDEX_H_
+
+#include <common/storage/Metadata.h>
+#include <common/storage/StorageDefinitions.h>
+#include <common/threading/Mutex.h>
+#include <common/Common.h>
+
+
+#define DENTRYINDEX_MAGIC              0x58644964 /* "dIdX" */
+#define DENTRYINDEX_VERSION            1
+#define DENTRYINDEX_HEADER_LEN         64 /* records start at this file offset */
+#define DENTRYINDEX_RECORD_HEADER_LEN  12 /* recLen, flags, entryType, owner, nameLen, idLen */
+#define DENTRYINDEX_RECORD_FLAG_LIVE   1  /* not set for records of removed dentries */
+#define DENTRYINDEX_READ_BUFLEN        (64*1024) /* for sequential reads of records */
+
+/* the file is compacted when it contains at least this many records of removed dentries and more
+   of them than live records */
+#define DENTRYINDEX_COMPACT_MIN_DEAD   128
+
+/* listing cookies are "(generation << DENTRYINDEX_COOKIE_GEN_SHIFT) | fileOffset", so that cookies
+   from before a rebuild of the index are not interpreted as offsets in the new file */
+#define DENTRYINDEX_COOKIE_GEN_SHIFT   40
+#define DENTRYINDEX_COOKIE_OFFSET_MASK ( (1LL << DENTRYINDEX_COOKIE_GEN_SHIFT) - 1)
+#define DENTRYINDEX_COOKIE_GEN_MASK    ( (1LL << 22) - 1)
+
+#define DENTRYINDEX_COOKIE_DOT         1 /* offset within a generation after returning "." */
+#define DENTRYINDEX_COOKIE_DOTDOT      2 /* offset within a generation after returning ".." */
+
+
+/**
+ * A dentry as stored in the index.
+ */
+struct DentryIndexEntry
+{
+   std::string name;
+   std::string entryID;
+   DirEntryType entryType;
+   uint16_t ownerNodeID;
+   int64_t nextCookie; // listing cookie to continue after this entry
+};
+
+typedef std::list<DentryIndexEntry> DentryIndexEntryList;
+typedef DentryIndexEntryList::iterator DentryIndexEntryListIter;
+
+typedef std::multimap<uint32_t, int64_t> DentryIndexHashMap; // name hash => record file offset
+typedef DentryIndexHashMap::iterator DentryIndexHashMapIter;
+typedef DentryIndexHashMap::value_type DentryIndexHashMapVal;
+
+
+/**
+ * Packed index of all dentries of a directory in a single sorted-log file (named
+ * META_DENTRYINDEX_FILENAME in the dentries dir), so that incremental listings don't need to
+ * seekdir() in the dentries dir and load every single dentry file to get entryIDs and types.
+ *
+ * The dentry files remain the authoritative metadata; the index is just an additional copy of
+ * name, entryID, type and owner of each dentry. It is only used for listings; lookups by name
+ * (and everything that needs more than these fields) still load the dentry file, so the hash map
+ * below only serves to find the record to update. New dentries are appended to the log as records,
+ * removed dentries are marked as deleted in place. That way, the file offsets of records are stable
+ * and can be used as listing cookies (as in telldir()). When most records are deleted, the live
+ * records are moved together (with a new generation for the cookies, as in a rebuild).
+ *
+ * The header contains the mtime of the dentries dir after the last index update and the number of
+ * live records. If the dentries dir was modified without updating the index (e.g. by an older
+ * version, by fsck or after a crash), the index is rebuilt from the dentry files. The index file is
+ * not synced for that reason.
+ *
+ * Note: Methods are thread-safe, but the caller needs to make sure that updates of the dentries dir
+ * and the corresponding index update are not interleaved with other updates (i.e. the write lock of
+ * the DirEntryStore needs to be held).
+ */
+class DentryIndex
+{
+   friend class TestDentryIndex;
+
+   public:
+      DentryIndex(const std::string& dentriesPath);
+      ~DentryIndex();
+
+      void prepareUpdate();
+      bool list(int64_t cookie, unsigned maxOutEntries, bool filterDots,
+         DentryIndexEntryList& outEntries);
+
+      void addEntry(const std::string& name, const std::string& entryID,
+         DirEntryType entryType, uint16_t ownerNodeID);
+      void addLink(const std::string& fromName, const std::string& toName);
+      void removeEntry(const std::string& name);
+      void renameEntry(const std::string& fromName, const std::string& toName);
+      void setOwnerNodeID(const std::string& name, uint16_t ownerNodeID);
+
+      static void removeIndexFile(const std::string& dentriesPath);
+
+
+   private:
+      Mutex mutex; // protects the fields below
+
+      std::string dentriesPath;
+      std::string indexPath;
+
+      int fd; // -1 if not loaded
+      unsigned generation; // part of the listing cookies, increased on each rebuild
+      int64_t fileSize; // end of the last record
+      uint64_t numLiveRecords;
+      uint64_t numDeadRecords; // records of removed dentries (space to be reclaimed by compaction)
+      struct timespec dirMTime; // mtime of the dentries dir after the last index update
+      DentryIndexHashMap liveRecords; // live records by name hash
+
+      bool checkLoadedUnlocked();
+      bool loadUnlocked();
+      bool rebuildUnlocked();
+      bool compactUnlocked();
+      void unloadUnlocked();
+
+      bool writeHeaderUnlocked();
+      bool appendRecordUnlocked(const std::string& name, const std::string& entryID,
+         DirEntryType entryType, uint16_t ownerNodeID);
+      bool removeRecordUnlocked(const std::string& name, int64_t offset);
+      bool findRecordUnlocked(const std::string& name, int64_t* outOffset,
+         DentryIndexEntry* outEntry);
+      void finishUpdateUnlocked(bool updateRes);
+
+      bool getDirMTime(struct timespec* outMTime);
+
+      static unsigned serializeRecord(char* buf, const std::string& name,
+         const std::string& entryID, DirEntryType entryType, uint16_t ownerNodeID);
+      static bool deserializeRecord(const char* buf, size_t bufLen, DentryIndexEntry* outEntry,
+         bool* outIsLive, unsigned* outRecLen);
+      static unsigned serializeHeader(char* buf, unsigned generation, uint64_t numLiveRecords,
+         int64_t fileSize, const struct timespec* dirMTime);
+      static uint32_t hashName(const std::string& name);
+
+
+   public:
+      // inliners
+
+      /**
+       * @return generation part of the given listing cookie
+       */
+      static unsigned getCookieGeneration(int64_t cookie)
+      {
+         return (cookie >> DENTRYINDEX_COOKIE_GEN_SHIFT) & DENTRYINDEX_COOKIE_GEN_MASK;
+      }
+
+      /**
+       * @return file offset part of the given listing cookie
+       */
+      static int64_t getCookieOffset(int64_t cookie)
+      {
+         return cookie & DENTRYINDEX_COOKIE_OFFSET_MASK;
+      }
+
+      static int64_t makeCookie(unsigned generation, int64_t offset)
+      {
+         return ( (int64_t)generation << DENTRYINDEX_COOKIE_GEN_SHIFT) | offset;
+      }
+};
+
+#endif /* DENTRYINDEX_H_ */
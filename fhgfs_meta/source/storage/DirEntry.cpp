@@ -1,4 +1,5 @@
 #include <common/toolkit/serialization/Serialization.h>
+#include <components/metajournal/MetaJournal.h>
 #include <program/Program.h>
 #include "MetadataEx.h"
 #include "DirEntry.h"
@@ -194,7 +195,7 @@ bool DirEntry::storeUpdatedDirEntryBufAsXAttr(std::string idStorePath, char* buf
 
    // write data to file
 
-   int setRes = setxattr(idStorePath.c_str(), META_XATTR_NAME, buf, bufLen, 0);
+   int setRes = MetaJournal::setMetaXAttrStatic(idStorePath, buf, bufLen);
 
    if(unlikely(setRes == -1) )
    { // error
@@ -370,6 +371,8 @@ FhgfsOpsErr DirEntry::removeDirEntryName(const char* logContext, std::string fil
 
    FhgfsOpsErr retVal = FhgfsOpsErr_SUCCESS;
 
+   MetaJournal::forgetFileStatic(filePath);
+
    // delete metadata file
    int unlinkRes = unlink(filePath.c_str() );
    if(unlinkRes == -1)
@@ -440,6 +443,9 @@ FhgfsOpsErr DirEntry::removeBusyFile(std::string dirEntryBasePath, std::string e
    {
       // Rename the ID to the inode directory
 
+      // (journal replay finds files by path => pending updates must be applied before the move)
+      MetaJournal::flushFileStatic(idPath);
+
       int renameRes = rename(idPath.c_str(), inodePath.c_str() );
       if (!renameRes)
       {
@@ -541,6 +547,8 @@ bool DirEntry::loadFromFileXAttr(std::string path)
 
    char buf[DIRENTRY_SERBUF_SIZE];
 
+   MetaJournal::flushFileStatic(path);
+
    ssize_t getRes = getxattr(path.c_str(), META_XATTR_NAME, buf, DIRENTRY_SERBUF_SIZE);
    if(getRes > 0)
    { // we got something => deserialize it
@@ -563,7 +571,8 @@ bool DirEntry::loadFromFileXAttr(std::string path)
    if( ( (getRes == 0) || ( (getRes == -1) && (errno == ENOATTR) ) ) &&
        (cfg->getStoreSelfHealEmptyFiles() ) )
    { // empty link file probably due to server crash => self-heal through removal
-      if (likely(this->name != META_DIRENTRYID_SUB_STR))
+      if (likely( (this->name != META_DIRENTRYID_SUB_STR) &&
+                  (this->name != META_DENTRYINDEX_FILENAME) ) )
       {
          LogContext(logContext).logErr("Found an empty dir-entry file. "
             "(Self-healing through file removal): " + path);
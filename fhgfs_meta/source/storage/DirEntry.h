@@ -31,9 +31,11 @@ class DirEntry
 {
    friend class MetaStore;
    friend class DirEntryStore;
+   friend class DentryIndex;
    friend class FileInode;
    friend class GenericDebugMsgEx;
    friend class RecreateDentriesMsgEx;
+   friend class TestDentryIndex;
 
    public:
 
@@ -20,13 +20,38 @@ static inline std::string getDirEntryStoreDynamicEntryPath(std::string& parentID
    return  MetaStorageTk::getMetaDirEntryPath(dentryPath, parentID);
 }
 
+/**
+ * Create the dentry index object for the given dentries dir (no file access yet).
+ *
+ * @return NULL if the dentry index is disabled in the config
+ */
+static inline DentryIndex* createDentryIndex(const std::string& dirEntryPath)
+{
+   if(!Program::getApp()->getConfig()->getStoreUseDentryIndex() )
+      return NULL;
+
+   return new DentryIndex(dirEntryPath);
+}
+
+/**
+ * @return NULL if the dentry cache is disabled in the config
+ */
+static inline DentryCache* createDentryCache()
+{
+   unsigned cacheLimit = Program::getApp()->getConfig()->getTuneDirEntryCacheLimit();
+   if(!cacheLimit)
+      return NULL;
+
+   return new DentryCache(cacheLimit);
+}
+
 
 /**
  * Note: Sets the parentID to an invalid value, so do not forget to set the parentID before
  * adding any elements.
  */
 DirEntryStore::DirEntryStore() :
-   parentID("<undef>")
+   parentID("<undef>"), dentryIndex(NULL), dentryCache(NULL)
 {
 }
 
@@ -34,8 +59,15 @@ DirEntryStore::DirEntryStore() :
  * @param parentID ID of the directory to which this store belongs
  */
 DirEntryStore::DirEntryStore(std::string parentID) :
-   parentID(parentID), dirEntryPath(getDirEntryStoreDynamicEntryPath(parentID) )
+   parentID(parentID), dirEntryPath(getDirEntryStoreDynamicEntryPath(parentID) ),
+   dentryIndex(createDentryIndex(dirEntryPath) ), dentryCache(createDentryCache() )
+{
+}
+
+DirEntryStore::~DirEntryStore()
 {
+   SAFE_DELETE(dentryIndex);
+   SAFE_DELETE(dentryCache);
 }
 
 /*
@@ -112,6 +144,9 @@ bool DirEntryStore::rmDirEntryStoreDir(std::string& id)
 
    std::string contentsDirIDStr = MetaStorageTk::getMetaDirEntryIDPath(contentsDirStr);
 
+   // remove the dentry index (might exist even if storeUseDentryIndex is disabled now)
+   DentryIndex::removeIndexFile(contentsDirStr);
+
    // remove the dirEntryID directory
    int rmdirIdRes = rmdir(contentsDirIDStr.c_str() );
    if(rmdirIdRes)
@@ -167,12 +202,22 @@ FhgfsOpsErr DirEntryStore::makeEntryUnlocked(DirEntry* entry)
    std::string dirEntryPath = getDirEntryPathUnlocked();
    const char* logContext = "make meta dir-entry";
 
+   if(dentryIndex)
+      dentryIndex->prepareUpdate();
+
    FhgfsOpsErr mkRes = entry->storeInitialDirEntry(dirEntryPath);
 
    if (unlikely(mkRes != FhgfsOpsErr_SUCCESS) && mkRes != FhgfsOpsErr_EXISTS)
       LogContext(logContext).logErr(std::string("Failed to create: name: ") + entry->getName() +
          std::string(" entryID: ") + entry->getID() + " in path: " + dirEntryPath);
 
+   if(dentryIndex && (mkRes == FhgfsOpsErr_SUCCESS) )
+      dentryIndex->addEntry(entry->getName(), entry->getID(), entry->getEntryType(),
+         entry->getOwnerNodeID() );
+
+   if(dentryCache)
+      dentryCache->invalidate(entry->getName() ); // (might be cached as non-existing)
+
    return mkRes;
 }
 
@@ -199,6 +244,9 @@ FhgfsOpsErr DirEntryStore::linkInodeToDirUnlocked(std::string& inodePath, std::s
 
    std::string dirEntryPath = getDirEntryPathUnlocked() + '/' + fileName;
 
+   if(dentryIndex)
+      dentryIndex->prepareUpdate();
+
    int linkRes = link(inodePath.c_str(), dirEntryPath.c_str() );
    if (linkRes)
    {
@@ -206,6 +254,18 @@ FhgfsOpsErr DirEntryStore::linkInodeToDirUnlocked(std::string& inodePath, std::s
          " To: " + dirEntryPath + " SysErr: " + System::getErrString() );
       retVal = FhgfsOpsErr_INTERNAL;
    }
+   else
+   if(dentryIndex)
+   { // the index needs the dentry data of the linked inode
+      DirEntry entry(fileName);
+
+      if(entry.loadFromFileName(getDirEntryPathUnlocked(), fileName) )
+         dentryIndex->addEntry(fileName, entry.getID(), entry.getEntryType(),
+            entry.getOwnerNodeID() );
+   }
+
+   if(dentryCache)
+      dentryCache->invalidate(fileName);
 
    return retVal;
 }
@@ -267,8 +327,19 @@ FhgfsOpsErr DirEntryStore::removeDirUnlocked(std::string entryName, DirEntry** o
    }
 
 
+   if(dentryIndex)
+      dentryIndex->prepareUpdate();
+
    FhgfsOpsErr retVal = DirEntry::removeDirDentry(getDirEntryPathUnlocked(), entryName);
 
+   if(dentryIndex && (retVal == FhgfsOpsErr_SUCCESS) )
+      dentryIndex->removeEntry(entryName);
+
+   if(dentryCache)
+      dentryCache->invalidate(entryName);
+
+   Program::getApp()->getLeaseStore()->revokeLeases(entry->getID() );
+
    if (outDirEntry)
       *outDirEntry = entry;
    else
@@ -293,9 +364,24 @@ FhgfsOpsErr DirEntryStore::removeDirUnlocked(std::string entryName, DirEntry** o
 FhgfsOpsErr DirEntryStore::unlinkDirEntryUnlocked(std::string entryName, DirEntry* entry,
    unsigned unlinkTypeFlags)
 {
+   if(dentryIndex)
+      dentryIndex->prepareUpdate();
+
    FhgfsOpsErr delErr = DirEntry::removeFileDentry(getDirEntryPathUnlocked(), entry->getID(),
       entryName, unlinkTypeFlags);
 
+   if(dentryIndex && (delErr == FhgfsOpsErr_SUCCESS) &&
+      (unlinkTypeFlags & DirEntry_UNLINK_FILENAME) )
+      dentryIndex->removeEntry(entryName);
+
+   if(dentryCache)
+   { // (the inlined inode might still be referenced by other names)
+      dentryCache->invalidate(entryName);
+      dentryCache->invalidateByID(entry->getID() );
+   }
+
+   Program::getApp()->getLeaseStore()->revokeLeases(entry->getID() );
+
    return delErr;
 }
 
@@ -318,6 +404,9 @@ FhgfsOpsErr DirEntryStore::linkEntryInDir(std::string fromEntryName, std::string
    std::string fromPath = getDirEntryPathUnlocked() + '/' + fromEntryName;
    std::string toPath   = getDirEntryPathUnlocked() + '/' + toEntryName;
 
+   if(dentryIndex)
+      dentryIndex->prepareUpdate();
+
    int linkRes = link(fromPath.c_str(), toPath.c_str() );
    if (linkRes)
    {
@@ -331,6 +420,12 @@ FhgfsOpsErr DirEntryStore::linkEntryInDir(std::string fromEntryName, std::string
          retVal = FhgfsOpsErr_INTERNAL;
       }
    }
+   else
+   if(dentryIndex)
+      dentryIndex->addLink(fromEntryName, toEntryName);
+
+   if(dentryCache)
+      dentryCache->invalidate(toEntryName);
 
    safeLock.unlock();
 
@@ -356,6 +451,13 @@ FhgfsOpsErr DirEntryStore::renameEntry(std::string fromEntryName, std::string to
    std::string fromPath = getDirEntryPathUnlocked() + '/' + fromEntryName;
    std::string toPath   = getDirEntryPathUnlocked() + '/' + toEntryName;
 
+   // (the renamed entry and an overwritten entry are identified by ID on the client side)
+   std::string fromEntryID = getLeasedEntryIDUnlocked(fromEntryName);
+   std::string toEntryID = getLeasedEntryIDUnlocked(toEntryName);
+
+   if(dentryIndex)
+      dentryIndex->prepareUpdate();
+
    int renameRes = rename(fromPath.c_str(), toPath.c_str() );
 
    if (renameRes)
@@ -366,6 +468,21 @@ FhgfsOpsErr DirEntryStore::renameEntry(std::string fromEntryName, std::string to
 
       retVal = FhgfsOpsErr_INTERNAL;
    }
+   else
+   if(dentryIndex)
+      dentryIndex->renameEntry(fromEntryName, toEntryName);
+
+   if(dentryCache)
+   {
+      dentryCache->invalidate(fromEntryName);
+      dentryCache->invalidate(toEntryName);
+   }
+
+   if(!fromEntryID.empty() )
+      Program::getApp()->getLeaseStore()->revokeLeases(fromEntryID);
+
+   if(!toEntryID.empty() )
+      Program::getApp()->getLeaseStore()->revokeLeases(toEntryID);
 
    safeLock.unlock();
 
@@ -431,10 +548,12 @@ FhgfsOpsErr DirEntryStore::listIncremental(int64_t serverOffset,
  * Note: You have reached the end of the directory when success is returned and
  * "outNames.size() != maxOutNames".
  *
- * @param serverOffset zero-based offset; represents the native local fs offset (as in telldir() ).
+ * @param serverOffset zero-based offset; represents the native local fs offset (as in telldir() )
+ * or a dentry index cookie if storeUseDentryIndex is enabled.
  * @param filterDots true if "." and ".." should not be returned.
  * @param outArgs outNewOffset is only valid if return value indicates success,
- *    outEntryTypes and outEntryIDs may be NULL, the rest is required.
+ *    outEntryTypes, outEntryIDs, outOwnerNodeIDs, outEntryFlags and outInlinedStatData may be
+ *    NULL, the rest is required.
  */
 FhgfsOpsErr DirEntryStore::listIncrementalEx(int64_t serverOffset,
    unsigned maxOutNames, bool filterDots, ListIncExOutArgs& outArgs)
@@ -450,9 +569,22 @@ FhgfsOpsErr DirEntryStore::listIncrementalEx(int64_t serverOffset,
    uint64_t numEntries = 0;
    struct dirent* dirEntry = NULL;
 
+   DIR* dirHandle;
+
    SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
 
-   DIR* dirHandle = opendir(getDirEntryPathUnlocked().c_str() );
+   /* note: if the index is not usable, we fall back to the dentries dir (old index cookies are
+      meaningless as dir offsets then, but that's the same as for a seekdir after a rebuild of the
+      underlying dir). */
+
+   if(dentryIndex &&
+      listIncrementalIndexedUnlocked(serverOffset, maxOutNames, filterDots, outArgs) )
+   {
+      retVal = FhgfsOpsErr_SUCCESS;
+      goto err_unlock;
+   }
+
+   dirHandle = opendir(getDirEntryPathUnlocked().c_str() );
    if(!dirHandle)
    {
       LogContext(logContext).logErr(std::string("Unable to open dentry directory: ") +
@@ -486,36 +618,52 @@ FhgfsOpsErr DirEntryStore::listIncrementalEx(int64_t serverOffset,
       //LOG_DEBUG(logContext, Log_SPAM, "filled: " + std::string(dirEntry->d_name) + "; "
       //   "offset: " + StringTk::uint64ToStr(dirEntry->d_off) );
 
-      if(outArgs.outEntryTypes || outArgs.outEntryIDs)
+      if(outArgs.outEntryTypes || outArgs.outEntryIDs || outArgs.outOwnerNodeIDs ||
+         outArgs.outEntryFlags || outArgs.outInlinedStatData)
       {
          DirEntryType entryType;
          std::string entryID;
+         uint16_t ownerNodeID = 0;
+         int entryFlags = 0;
+         StatData inlinedStatData;
 
          if(!filterDots && !strcmp(dirEntry->d_name, ".") )
          {
             entryType = DirEntryType_DIRECTORY;
             entryID = "<.>";
+            inlinedStatData.setAllFake();
          }
          else
          if(!filterDots && !strcmp(dirEntry->d_name, "..") )
          {
             entryType = DirEntryType_DIRECTORY;
             entryID = "<..>";
+            inlinedStatData.setAllFake();
          }
          else
          { // load dentry metadata
             DirEntry entry(dirEntry->d_name);
 
-            bool loadSuccess = entry.loadFromFileName(getDirEntryPathUnlocked(), dirEntry->d_name);
+            bool loadSuccess = loadDentryUnlocked(dirEntry->d_name, entry);
             if (likely(loadSuccess) )
             {
                entryType = entry.getEntryType();
                entryID   = entry.getEntryID();
+               ownerNodeID = entry.getOwnerNodeID();
+
+               if(entry.getIsInodeInlined() )
+               {
+                  entryFlags |= ENTRYINFO_FEATURE_INLINED;
+                  inlinedStatData = *entry.getInodeStoreData()->getInodeStatData();
+               }
+               else
+                  inlinedStatData.setAllFake();
             }
             else
             { // loading failed
                entryType = DirEntryType_INVALID;
                entryID   = "<invalid>";
+               inlinedStatData.setAllFake();
 
                errno = 0;
             }
@@ -526,6 +674,15 @@ FhgfsOpsErr DirEntryStore::listIncrementalEx(int64_t serverOffset,
 
          if (outArgs.outEntryIDs)
             outArgs.outEntryIDs->push_back(entryID);
+
+         if(outArgs.outOwnerNodeIDs)
+            outArgs.outOwnerNodeIDs->push_back(ownerNodeID);
+
+         if(outArgs.outEntryFlags)
+            outArgs.outEntryFlags->push_back(entryFlags);
+
+         if(outArgs.outInlinedStatData)
+            outArgs.outInlinedStatData->push_back(inlinedStatData);
       }
 
    }
@@ -549,6 +706,67 @@ err_unlock:
    return retVal;
 }
 
+/**
+ * Variant of listIncrementalEx based on the dentry index, which avoids loading the dentry files
+ * unless the caller wants entry flags or inlined stat data.
+ *
+ * Note: Caller must hold the read lock.
+ *
+ * @return false if the index is not usable (nothing was added to outArgs in that case).
+ */
+bool DirEntryStore::listIncrementalIndexedUnlocked(int64_t serverOffset, unsigned maxOutNames,
+   bool filterDots, ListIncExOutArgs& outArgs)
+{
+   DentryIndexEntryList indexEntries;
+
+   if(!dentryIndex->list(serverOffset, maxOutNames, filterDots, indexEntries) )
+      return false;
+
+   for(DentryIndexEntryListIter iter = indexEntries.begin(); iter != indexEntries.end(); iter++)
+   {
+      outArgs.outNames->push_back(iter->name);
+
+      if(outArgs.outServerOffsets)
+         outArgs.outServerOffsets->push_back(iter->nextCookie);
+
+      SAFE_ASSIGN(outArgs.outNewServerOffset, iter->nextCookie);
+
+      if(outArgs.outEntryTypes)
+         outArgs.outEntryTypes->push_back( (int)iter->entryType);
+
+      if(outArgs.outEntryIDs)
+         outArgs.outEntryIDs->push_back(iter->entryID);
+
+      if(outArgs.outOwnerNodeIDs)
+         outArgs.outOwnerNodeIDs->push_back(iter->ownerNodeID);
+
+      if(outArgs.outEntryFlags || outArgs.outInlinedStatData)
+      { // only the dentry file knows about inlined inodes
+         int entryFlags = 0;
+         StatData inlinedStatData;
+         DirEntry entry(iter->name);
+
+         inlinedStatData.setAllFake();
+
+         if( (iter->name != ".") && (iter->name != "..") &&
+             loadDentryUnlocked(iter->name, entry) &&
+             entry.getIsInodeInlined() )
+         {
+            entryFlags |= ENTRYINFO_FEATURE_INLINED;
+            inlinedStatData = *entry.getInodeStoreData()->getInodeStatData();
+         }
+
+         if(outArgs.outEntryFlags)
+            outArgs.outEntryFlags->push_back(entryFlags);
+
+         if(outArgs.outInlinedStatData)
+            outArgs.outInlinedStatData->push_back(inlinedStatData);
+      }
+   }
+
+   return true;
+}
+
 /**
  * Note: serverOffset is an internal value and should not be assumed to be just 0, 1, 2, 3, ...;
  * so make sure you use either 0 (at the beginning) or something that has been returned by this
@@ -680,7 +898,7 @@ FhgfsOpsErr DirEntryStore::getEntryData(std::string entryName, EntryInfo* outInf
 
    DirEntry entry(entryName);
 
-   bool loadRes = entry.loadFromFileName(getDirEntryPathUnlocked(), entryName);
+   bool loadRes = loadDentryUnlocked(entryName, entry);
    if(loadRes)
    {
       /* copy FileInodeStoreData from entry to outInodeMetaData. We also do not want to allocate
@@ -711,6 +929,62 @@ FhgfsOpsErr DirEntryStore::getEntryData(std::string entryName, EntryInfo* outInf
    return retVal;
 }
 
+/**
+ * Load a dentry through the dentry cache (if enabled). Dentries that were loaded from disk are
+ * added to the cache, names that don't exist are cached as negative entries.
+ *
+ * Note: Caller must hold the read lock.
+ *
+ * @param outEntry a fresh DirEntry object that was not loaded yet.
+ * @return false if no such dentry exists or it could not be loaded.
+ */
+bool DirEntryStore::loadDentryUnlocked(const std::string& entryName, DirEntry& outEntry)
+{
+   if(!dentryCache)
+      return outEntry.loadFromFileName(getDirEntryPathUnlocked(), entryName);
+
+   DentryCacheLookupRes lookupRes = dentryCache->lookup(entryName, outEntry);
+   if(lookupRes == DentryCacheLookupRes_HIT)
+      return true;
+
+   if(lookupRes == DentryCacheLookupRes_NOTEXISTS)
+      return false;
+
+   uint64_t cacheVersion = dentryCache->getVersion();
+
+   errno = 0; // (to distinguish "not exists" from other load errors)
+
+   bool loadRes = outEntry.loadFromFileName(getDirEntryPathUnlocked(), entryName);
+   if(loadRes)
+      dentryCache->insert(entryName, outEntry, cacheVersion);
+   else
+   if(errno == ENOENT)
+      dentryCache->insertNegative(entryName, cacheVersion);
+
+   return loadRes;
+}
+
+/**
+ * Get the entryID of a dentry that is about to be modified, so that the leases on it can be
+ * revoked afterwards.
+ *
+ * Note: Caller must hold the lock.
+ *
+ * @return empty string if leases are disabled or no such dentry exists.
+ */
+std::string DirEntryStore::getLeasedEntryIDUnlocked(const std::string& entryName)
+{
+   if(!Program::getApp()->getLeaseStore()->isEnabled() )
+      return "";
+
+   DirEntry entry(entryName);
+
+   if(!loadDentryUnlocked(entryName, entry) )
+      return "";
+
+   return entry.getID();
+}
+
 /**
  * Load and return the dir-entry of the given entry-/fileName
  */
@@ -755,10 +1029,21 @@ FhgfsOpsErr DirEntryStore::setOwnerNodeID(std::string entryName, uint16_t ownerN
    }
    else
    {
+      if(dentryIndex)
+         dentryIndex->prepareUpdate();
+
       if ( entry.setOwnerNodeID(getDirEntryPathUnlocked(), ownerNode) )
       {
          retVal = FhgfsOpsErr_SUCCESS;
+
+         if(dentryIndex)
+            dentryIndex->setOwnerNodeID(entryName, ownerNode);
       }
+
+      if(dentryCache)
+         dentryCache->invalidate(entryName);
+
+      Program::getApp()->getLeaseStore()->revokeLeases(entry.getID() );
    }
    safeLock.unlock();
 
@@ -772,6 +1057,12 @@ void DirEntryStore::setParentID(std::string parentID)
 {
    this->parentID = parentID;
    this->dirEntryPath = getDirEntryStoreDynamicEntryPath(parentID);
+
+   SAFE_DELETE(dentryIndex);
+   dentryIndex = createDentryIndex(dirEntryPath);
+
+   if(dentryCache)
+      dentryCache->clear();
 }
 
 /**
@@ -781,7 +1072,7 @@ void DirEntryStore::setParentID(std::string parentID)
  */
 FhgfsOpsErr DirEntryStore::unlinkDirEntryName(std::string entryName)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
 
    FhgfsOpsErr retVal = unlinkDirEntryNameUnlocked(entryName);
 
@@ -796,6 +1087,11 @@ FhgfsOpsErr DirEntryStore::unlinkDirEntryNameUnlocked(std::string entryName)
 
    FhgfsOpsErr retVal;
 
+   std::string entryID = getLeasedEntryIDUnlocked(entryName);
+
+   if(dentryIndex)
+      dentryIndex->prepareUpdate();
+
    int unlinkRes = unlink(filepath.c_str() );
    if(unlinkRes)
    {
@@ -805,8 +1101,19 @@ FhgfsOpsErr DirEntryStore::unlinkDirEntryNameUnlocked(std::string entryName)
          retVal = FhgfsOpsErr_INTERNAL;
    }
    else
+   {
       retVal = FhgfsOpsErr_SUCCESS;
 
+      if(dentryIndex)
+         dentryIndex->removeEntry(entryName);
+   }
+
+   if(dentryCache)
+      dentryCache->invalidate(entryName);
+
+   if(!entryID.empty() )
+      Program::getApp()->getLeaseStore()->revokeLeases(entryID);
+
    return retVal;
 }
 
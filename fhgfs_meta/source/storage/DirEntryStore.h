@@ -4,8 +4,11 @@
 #include <common/Common.h>
 #include <common/threading/Mutex.h>
 #include <common/toolkit/MetadataTk.h>
+#include <common/storage/StatData.h>
 #include <common/storage/StorageDefinitions.h>
 #include <common/storage/StorageErrors.h>
+#include "DentryCache.h"
+#include "DentryIndex.h"
 #include "DirEntry.h"
 
 
@@ -14,7 +17,8 @@ struct ListIncExOutArgs
    ListIncExOutArgs(StringList* outNames, UInt8List* outEntryTypes, StringList* outEntryIDs,
       Int64List* outServerOffsets, int64_t* outNewServerOffset) :
          outNames(outNames), outEntryTypes(outEntryTypes), outEntryIDs(outEntryIDs),
-         outServerOffsets(outServerOffsets), outNewServerOffset(outNewServerOffset)
+         outServerOffsets(outServerOffsets), outNewServerOffset(outNewServerOffset),
+         outOwnerNodeIDs(NULL), outEntryFlags(NULL), outInlinedStatData(NULL)
    {
       // see initializer list
    }
@@ -27,6 +31,10 @@ struct ListIncExOutArgs
    Int64List* outServerOffsets;    /* optional (may be NULL if caller is not interested) */
    int64_t* outNewServerOffset;    /* optional (may be NULL), equals last value from
                                       outServerOffsets */
+   UInt16List* outOwnerNodeIDs;    /* optional (may be NULL), 0 for dots and invalid dentries */
+   IntList* outEntryFlags;         /* optional (may be NULL), ENTRYINFO_FEATURE_... flags */
+   StatDataList* outInlinedStatData; /* optional (may be NULL), stat data of inlined inodes as
+                                        stored in the dentry (fake values for non-inlined) */
 };
 
 
@@ -38,7 +46,8 @@ class DirEntryStore
    public:
       DirEntryStore();
       DirEntryStore(std::string parentID);
-      
+      ~DirEntryStore();
+
       FhgfsOpsErr makeEntry(DirEntry* entry);
 
       FhgfsOpsErr linkEntryInDir(std::string fromEntryName, std::string toEntryName);
@@ -76,7 +85,10 @@ class DirEntryStore
                                  * depends on parentID, so changes when parentID is set */
 
       RWLock rwlock;
-      
+
+      DentryIndex* dentryIndex; // NULL if storeUseDentryIndex is disabled
+      DentryCache* dentryCache; // NULL if tuneDirEntryCacheLimit is 0
+
       FhgfsOpsErr makeEntryUnlocked(DirEntry* entry);
       FhgfsOpsErr linkInodeToDirUnlocked(std::string& inodePath, std::string &fileName);
 
@@ -86,7 +98,13 @@ class DirEntryStore
          unsigned unlinkTypeFlags);
       FhgfsOpsErr unlinkDirEntryNameUnlocked(std::string entryName);
 
+      bool listIncrementalIndexedUnlocked(int64_t serverOffset, unsigned maxOutNames,
+         bool filterDots, ListIncExOutArgs& outArgs);
+
       bool existsUnlocked(std::string entryName);
+
+      bool loadDentryUnlocked(const std::string& entryName, DirEntry& outEntry);
+      std::string getLeasedEntryIDUnlocked(const std::string& entryName);
       
       const std::string& getDirEntryPathUnlocked();
 
@@ -106,7 +124,7 @@ class DirEntryStore
          
          SafeRWLock safeLock(&rwlock, SafeRWLock_READ);
          
-         exists = outEntry.loadFromFileName(getDirEntryPathUnlocked(), entryName);
+         exists = loadDentryUnlocked(entryName, outEntry);
          
          safeLock.unlock();
          
@@ -173,6 +191,35 @@ class DirEntryStore
          return dirEntryPath;
       }
 
+      /**
+       * Drop cached data of the given name, e.g. after the dentry was modified without going
+       * through this store.
+       *
+       * Note: No lock required.
+       */
+      void invalidateCachedDentry(const std::string& entryName)
+      {
+         if(dentryCache)
+            dentryCache->invalidate(entryName);
+      }
+
+      /**
+       * Drop cached data of all names that refer to the given entryID, e.g. after an update of an
+       * inlined inode.
+       *
+       * Note: No lock required.
+       */
+      void invalidateCachedDentryByID(const std::string& entryID)
+      {
+         if(dentryCache)
+            dentryCache->invalidateByID(entryID);
+      }
+
+      size_t getNumCachedDentries()
+      {
+         return dentryCache ? dentryCache->getSize() : 0;
+      }
+
       // getters & setters
       
       void setParentID(std::string parentID);
@@ -187,9 +234,22 @@ class DirEntryStore
       {
          SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // Lock
 
+         if(dentryIndex)
+            dentryIndex->prepareUpdate();
+
          FhgfsOpsErr retVal = dentry->removeBusyFile(getDirEntryPathUnlocked(), dentry->getID(),
             entryName, unlinkTypeFlags);
 
+         if(dentryIndex && (retVal == FhgfsOpsErr_SUCCESS) &&
+            (unlinkTypeFlags & DirEntry_UNLINK_FILENAME) )
+            dentryIndex->removeEntry(entryName);
+
+         if(dentryCache)
+         { // (the inlined inode might still be referenced by other names)
+            dentryCache->invalidate(entryName);
+            dentryCache->invalidateByID(dentry->getID() );
+         }
+
          safeLock.unlock();
 
          return retVal;
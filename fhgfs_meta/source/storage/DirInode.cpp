@@ -2,6 +2,7 @@
 #include <common/storage/striping/Raid0Pattern.h>
 #include <common/storage/striping/Raid10Pattern.h>
 #include <common/toolkit/TimeAbs.h>
+#include <components/metajournal/MetaJournal.h>
 #include <program/Program.h>
 #include <storage/PosixACL.h>
 
@@ -26,6 +27,7 @@ DirInode::DirInode(std::string id, int mode, unsigned userID, unsigned groupID,
    this->featureFlags       = DIRINODE_FEATURE_EARLY_SUBDIRS | DIRINODE_FEATURE_STATFLAGS;
    this->mirrorNodeID       = 0;
    this->exclusive          = false;
+   this->cacheAccessed      = false;
    int64_t currentTimeSecs  = TimeAbs().getTimeval()->tv_sec;
    this->numSubdirs         = 0;
    this->numFiles           = 0;
@@ -934,7 +936,7 @@ bool DirInode::storeUpdatedMetaDataBufAsXAttr(char* buf, unsigned bufLen)
 
    // write data to file
 
-   int setRes = setxattr(metaFilename.c_str(), META_XATTR_NAME, buf, bufLen, 0);
+   int setRes = MetaJournal::setMetaXAttrStatic(metaFilename, buf, bufLen);
 
    if(unlikely(setRes == -1) )
    { // error
@@ -1168,6 +1170,7 @@ bool DirInode::storeUpdatedMetaDataUnlocked()
 
    bool saveRes = storeUpdatedMetaDataBuf(buf, bufLen);
 
+   Program::getApp()->getLeaseStore()->revokeLeases(this->id);
 
    // add entry to mirror queue
    if( (getFeatureFlags() & DIRINODE_FEATURE_MIRRORED) && saveRes)
@@ -1200,6 +1203,8 @@ bool DirInode::removeStoredMetaDataFile(std::string& id)
    std::string metaFilename = MetaStorageTk::getMetaInodePath(
       app->getInodesPath()->getPathAsStrConst(), id);
 
+   MetaJournal::forgetFileStatic(metaFilename);
+
    // delete metadata file
 
    int unlinkRes = unlink(metaFilename.c_str() );
@@ -1288,6 +1293,8 @@ bool DirInode::loadFromFileXAttr()
 
    char buf[META_SERBUF_SIZE];
 
+   MetaJournal::flushFileStatic(inodePath);
+
    ssize_t getRes = getxattr(inodePath.c_str(), META_XATTR_NAME, buf, META_SERBUF_SIZE);
    if(getRes > 0)
    { // we got something => deserialize it
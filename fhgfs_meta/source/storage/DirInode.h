@@ -43,6 +43,7 @@ class DirInode
       {
          this->stripePattern = NULL;
          this->exclusive = false;
+         this->cacheAccessed = false;
          this->isLoaded = false;
          this->featureFlags = 0;
          this->mirrorNodeID = 0;
@@ -118,6 +119,8 @@ class DirInode
       uint16_t mirrorNodeID; // node ID of dir mirror if DIRINODE_FEATURE_MIRRORED is set
 
       bool exclusive; // if set, we do not allow other references
+      bool cacheAccessed; /* set on every reference, cleared by the InodeDirStore cache sweeper
+                             (just a hint for cache replacement, so we don't lock for it) */
 
       // StatData
       StatData statData;
@@ -236,6 +239,15 @@ class DirInode
       {
          return this->entries.dirEntryCreateFromFile(entryName);
       }
+
+      /**
+       * Drop cached data of the given dentry after it was modified without going through this
+       * dir (e.g. by fsck).
+       */
+      void invalidateCachedDentry(const std::string& entryName)
+      {
+         this->entries.invalidateCachedDentry(entryName);
+      }
       
 
       /**
@@ -2,6 +2,7 @@
 #include <common/toolkit/MathTk.h>
 #include <common/storage/striping/Raid0Pattern.h>
 #include <common/storage/StorageDefinitions.h>
+#include <components/metajournal/MetaJournal.h>
 #include <program/Program.h>
 #include <toolkit/LockingTk.h>
 #include "FileInode.h"
@@ -32,6 +33,10 @@ FileInode::FileInode(std::string entryID, FileInodeStoreData* inodeDiskData,
    this->numSessionsRead  = 0;
    this->numSessionsWrite = 0;
 
+   this->dynAttribsVersion        = 0;
+   this->dynAttribsRefreshVersion = 0;
+   this->dynAttribsRefreshed      = false;
+
    initFileInfoVec();
 
    this->dentryCompatData.entryType    = entryType;
@@ -50,6 +55,10 @@ FileInode::FileInode()
    this->numSessionsRead  = 0;
    this->numSessionsWrite = 0;
 
+   this->dynAttribsVersion        = 0;
+   this->dynAttribsRefreshVersion = 0;
+   this->dynAttribsRefreshed      = false;
+
    this->dentryCompatData.entryType    = DirEntryType_INVALID;
    this->dentryCompatData.featureFlags = 0;
 }
@@ -259,7 +268,7 @@ bool FileInode::storeUpdatedMetaDataBufAsXAttr(char* buf, unsigned bufLen, std::
 
    // write data to file
 
-   int setRes = setxattr(metaFilename.c_str(), META_XATTR_NAME, buf, bufLen, 0);
+   int setRes = MetaJournal::setMetaXAttrStatic(metaFilename, buf, bufLen);
 
    if(unlikely(setRes == -1) )
    { // error
@@ -534,6 +543,8 @@ bool FileInode::storeUpdatedInodeUnlocked(EntryInfo* entryInfo, StripePattern* u
 
    }
 
+   Program::getApp()->getLeaseStore()->revokeLeases(entryInfo->getEntryID() );
+
    return saveRes;
 }
 
@@ -576,6 +587,12 @@ FhgfsOpsErr FileInode::storeUpdatedInlinedInodeUnlocked(EntryInfo* entryInfo,
 
    FhgfsOpsErr retVal = dirEntry.storeUpdatedInode(dirEntryPath);
 
+   // (also if the update failed, as we don't know what's on disk now)
+   Program::getApp()->getMetaStore()->invalidateCachedDentryByID(parentEntryID,
+      entryInfo->getEntryID() );
+
+   Program::getApp()->getLeaseStore()->revokeLeases(entryInfo->getEntryID() );
+
    return retVal;
 }
 
@@ -588,6 +605,8 @@ bool FileInode::removeStoredMetaData(std::string id)
    std::string inodeFilename = MetaStorageTk::getMetaInodePath(
       app->getInodesPath()->getPathAsStrConst(), id);
 
+   MetaJournal::forgetFileStatic(inodeFilename);
+
    // delete metadata file
    int unlinkRes = unlink(inodeFilename.c_str() );
 
@@ -639,6 +658,8 @@ bool FileInode::loadFromFileXAttr(const std::string& id)
 
    char buf[META_SERBUF_SIZE];
 
+   MetaJournal::flushFileStatic(metaFilename);
+
    ssize_t getRes = getxattr(metaFilename.c_str(), META_XATTR_NAME, buf, META_SERBUF_SIZE);
    if(getRes > 0)
    { // we got something => deserialize it
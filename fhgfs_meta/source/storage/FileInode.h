@@ -12,6 +12,7 @@
 #include <common/threading/SafeRWLock.h>
 #include <common/threading/Condition.h>
 #include <common/threading/PThread.h>
+#include <common/toolkit/Time.h>
 #include <common/toolkit/TimeAbs.h>
 #include <common/app/log/LogContext.h>
 #include <common/Common.h>
@@ -131,6 +132,11 @@ class FileInode
       unsigned numSessionsRead; // open read-only
       unsigned numSessionsWrite; // open for writing or read-write
 
+      unsigned dynAttribsVersion; // incremented on each update of the dyn attribs in fileInfoVec
+      unsigned dynAttribsRefreshVersion; // dynAttribsVersion of the last refresh from storage
+      Time dynAttribsRefreshT; // time of the last refresh from storage
+      bool dynAttribsRefreshed; // true if the dyn attribs have been refreshed from storage
+
 
       bool isInlined; // boolean if the inode inlined into the Dentry or a separate file
 
@@ -395,10 +401,11 @@ class FileInode
        * @param erroneousVec if errors occurred during vector retrieval from storage nodes
        *       (this parameter was used to set dynAttribsUptodate to false, but we do not have
        *        this value anymore since the switch to (post-)DB metadata format)
+       * @param isRefresh true if newAttribsVec has just been retrieved from the storage targets.
        * @return false if error during save occurred (but we don't save dynAttribs currently)
        *
        */
-      bool setDynAttribs(DynamicFileAttribsVec& newAttribsVec)
+      bool setDynAttribs(DynamicFileAttribsVec& newAttribsVec, bool isRefresh = false)
       {
          /* note: we cannot afford to make a disk write each time this is updated, so
             we only update metadata on close currrently */
@@ -426,12 +433,40 @@ class FileInode
 
          IGNORE_UNUSED_VARIABLE(anyAttribUpdated);
 
+         this->dynAttribsVersion++;
+
+         if(isRefresh)
+         { // remember version and time of the refresh for getDynAttribsRefreshValid()
+            this->dynAttribsRefreshVersion = this->dynAttribsVersion;
+            this->dynAttribsRefreshT.setToNow();
+            this->dynAttribsRefreshed = true;
+         }
+
       unlock_and_exit:
          safeLock.unlock();
 
          return retVal;
       }
 
+      /**
+       * Check whether the dyn attribs were refreshed from the storage targets recently and have not
+       * been updated (e.g. by close or truncate) since then.
+       *
+       * @param maxAgeMS max time since the last refresh.
+       */
+      bool getDynAttribsRefreshValid(unsigned maxAgeMS)
+      {
+         SafeRWLock safeLock(&rwlock, SafeRWLock_READ);
+
+         bool retVal = dynAttribsRefreshed &&
+            (dynAttribsRefreshVersion == dynAttribsVersion) &&
+            (dynAttribsRefreshT.elapsedMS() < maxAgeMS);
+
+         safeLock.unlock();
+
+         return retVal;
+      }
+
       /**
        * Note: Use this only if the file is not loaded already (because otherwise the dyn attribs
        * will be outdated)
@@ -5,8 +5,7 @@
 #include "InodeDirStore.h"
 
 
-#define DIRSTORE_REFCACHE_REMOVE_SKIP_SYNC     (4) /* n-th elements to be removed on sync sweep */
-#define DIRSTORE_REFCACHE_REMOVE_SKIP_ASYNC    (3) /* n-th elements to be removed on async sweep */
+#define DIRSTORE_REFCACHE_SYNC_SWEEP_SHIFT     (4) /* sync sweep frees 1/(2^n) of the limit */
 
 /**
   * not inlined as we need to include <program/Program.h>
@@ -15,8 +14,18 @@ InodeDirStore::InodeDirStore()
 {
    Config* cfg = Program::getApp()->getConfig();
 
-   this->refCacheSyncLimit = cfg->getTuneDirMetadataCacheLimit();
+   // the configured limit is for the whole store, so we split it among the shards
+
+   size_t cacheLimit = cfg->getTuneDirMetadataCacheLimit();
+
+   this->refCacheSyncLimit = cacheLimit / INODEDIRSTORE_NUM_SHARDS;
+   if(cacheLimit && !refCacheSyncLimit)
+      refCacheSyncLimit = 1;
+
    this->refCacheAsyncLimit = refCacheSyncLimit - (refCacheSyncLimit/2);
+
+   for(unsigned i=0; i < INODEDIRSTORE_NUM_SHARDS; i++)
+      shards[i].cacheClockHand = shards[i].refCache.end();
 }
 
 /**
@@ -25,7 +34,9 @@ InodeDirStore::InodeDirStore()
  */
 FhgfsOpsErr InodeDirStore::makeDirInode(DirInode* dir)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
+   InodeDirStoreShard* shard = getShard(dir->getID() );
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
 
    FhgfsOpsErr mkRes = makeDirInodeUnlocked(dir);
 
@@ -43,10 +54,12 @@ FhgfsOpsErr InodeDirStore::makeDirInode(DirInode* dir)
 FhgfsOpsErr InodeDirStore::makeDirInode(DirInode* dir,
    const CharVector& defaultACLXAttr, const CharVector& accessACLXAttr)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
-
    const std::string dirID(dir->getID() );
 
+   InodeDirStoreShard* shard = getShard(dirID);
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
+
    FhgfsOpsErr mkRes = makeDirInodeUnlocked(dir, defaultACLXAttr, accessACLXAttr);
 
    safeLock.unlock(); // U N L O C K
@@ -81,10 +94,15 @@ FhgfsOpsErr InodeDirStore::makeDirInodeUnlocked(DirInode* dir)
    return retVal;
 }
 
+/**
+ * Note: The shard of the dirID (see getShard() ) must be locked.
+ */
 bool InodeDirStore::dirInodeInStoreUnlocked(std::string dirID)
 {
-   DirectoryMapIter iter = this->dirs.find(dirID);
-   if(iter != this->dirs.end() )
+   InodeDirStoreShard* shard = getShard(dirID);
+
+   DirectoryMapIter iter = shard->dirs.find(dirID);
+   if(iter != shard->dirs.end() )
       return true;
 
    return false;
@@ -106,15 +124,17 @@ DirInode* InodeDirStore::referenceDirInode(std::string dirID, bool forceLoad)
                                * Any attempt to add it to the cache causes a cache sweep, which is
                                * rather expensive.
                                * Note: when set to false we also need a write-lock! */
-   
-   SafeRWLock safeLock(&this->rwlock, SafeRWLock_READ); // L O C K
+
+   InodeDirStoreShard* shard = getShard(dirID);
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_READ); // L O C K
 
    DirectoryMapIter iter;
    int retries = 0; // 0 -> read-locked
    while (retries < RWLOCK_LOCK_UPGRADE_RACY_RETRIES) // one as read-lock and one as write-lock
    {
-      iter = this->dirs.find(dirID);
-      if (iter == this->dirs.end() && retries == 0)
+      iter = shard->dirs.find(dirID);
+      if (iter == shard->dirs.end() && retries == 0)
       {
          safeLock.unlock();
          safeLock.lock(SafeRWLock_WRITE);
@@ -122,13 +142,13 @@ DirInode* InodeDirStore::referenceDirInode(std::string dirID, bool forceLoad)
       retries++;
    }
 
-   if(iter == this->dirs.end() )
+   if(iter == shard->dirs.end() )
    { // Not in map yet => try to load it. We must be write-locked here!
-      InsertDirInodeUnlocked(dirID, iter, forceLoad); // (will set "iter != end" if loaded)
+      InsertDirInodeUnlocked(shard, dirID, iter, forceLoad); // (will set "iter != end" if loaded)
       wasReferenced = false;
    }
 
-   if(iter != dirs.end() )
+   if(iter != shard->dirs.end() )
    { // exists in map
       DirectoryReferencer* dirRefer = iter->second;
       DirInode* dirNonRef = dirRefer->getReferencedObject();
@@ -141,7 +161,9 @@ DirInode* InodeDirStore::referenceDirInode(std::string dirID, bool forceLoad)
          IGNORE_UNUSED_VARIABLE(logContext);
 
          if (wasReferenced == false)
-            cacheAddUnlocked(dirID, dirRefer);
+            cacheAddUnlocked(shard, dirID, dirRefer);
+         else
+            dirNonRef->cacheAccessed = true; // (might be a read-lock only, but it's just a hint)
 
       }
       else
@@ -170,21 +192,26 @@ DirInode* InodeDirStore::referenceDirInode(std::string dirID, bool forceLoad)
  */
 void InodeDirStore::releaseDir(std::string dirID)
 {
-   SafeRWLock safeLock(&this->rwlock, SafeRWLock_WRITE); // L O C K
+   InodeDirStoreShard* shard = getShard(dirID);
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
 
-   releaseDirUnlocked(dirID);
+   releaseDirUnlocked(shard, dirID);
 
    safeLock.unlock(); // U N L O C K
 }
 
-void InodeDirStore::releaseDirUnlocked(std::string dirID)
+/**
+ * @param shard the shard of the dirID (must be write-locked)
+ */
+void InodeDirStore::releaseDirUnlocked(InodeDirStoreShard* shard, std::string dirID)
 {
    const char* logContext = "InodeDirStore releaseDirInode";
 
    App* app = Program::getApp();
 
-   DirectoryMapIter iter = this->dirs.find(dirID);
-   if(likely(iter != this->dirs.end() ) )
+   DirectoryMapIter iter = shard->dirs.find(dirID);
+   if(likely(iter != shard->dirs.end() ) )
    { // dir exists => decrease refCount
       DirectoryReferencer* dirRefer = iter->second;
 
@@ -210,7 +237,7 @@ void InodeDirStore::releaseDirUnlocked(std::string dirID)
             else
             { // as expected, fileStore is empty
                delete(dirRefer);
-               this->dirs.erase(iter);
+               shard->dirs.erase(iter);
             }
          }
       }
@@ -219,7 +246,7 @@ void InodeDirStore::releaseDirUnlocked(std::string dirID)
          std::string logMsg = std::string("Bug: Refusing to release dir with a zero refCount") +
             std::string("dirID: ") + dirID;
          LogContext(logContext).logErr(logMsg);
-         this->dirs.erase(iter);
+         shard->dirs.erase(iter);
       }
    }
    else
@@ -232,9 +259,11 @@ void InodeDirStore::releaseDirUnlocked(std::string dirID)
 
 FhgfsOpsErr InodeDirStore::removeDirInode(std::string dirID)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
+   InodeDirStoreShard* shard = getShard(dirID);
 
-   FhgfsOpsErr delErr = removeDirInodeUnlocked(dirID, NULL);
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
+
+   FhgfsOpsErr delErr = removeDirInodeUnlocked(shard, dirID, NULL);
 
    safeLock.unlock(); // U N L O C K
 
@@ -252,14 +281,15 @@ FhgfsOpsErr InodeDirStore::removeDirInode(std::string dirID)
  * check, but we have it here because this method already loads the dir inode, so that we can avoid
  * another inode load in removeDirInodeUnlocked() for mirror checking.)
  */
-FhgfsOpsErr InodeDirStore::isRemovableUnlocked(std::string dirID, uint16_t* outMirrorNodeID)
+FhgfsOpsErr InodeDirStore::isRemovableUnlocked(InodeDirStoreShard* shard, std::string dirID,
+   uint16_t* outMirrorNodeID)
 {
    const char* logContext = "InodeDirStore check if dir is removable";
-   DirectoryMapCIter iter = dirs.find(dirID);
+   DirectoryMapCIter iter = shard->dirs.find(dirID);
 
    *outMirrorNodeID = 0;
 
-   if(iter != dirs.end() )
+   if(iter != shard->dirs.end() )
    { // dir currently loaded, refuse to let it rmdir'ed
       DirectoryReferencer* dirRefer = iter->second;
       DirInode* dir = dirRefer->getReferencedObject();
@@ -307,21 +337,23 @@ FhgfsOpsErr InodeDirStore::isRemovableUnlocked(std::string dirID, uint16_t* outM
 
 /**
  * Note: This method does not lock the mutex, so it must already be locked when calling this
- * 
+ *
+ * @param shard the shard of the dirID (must be write-locked)
  * @param outRemovedDir will be set to the removed dir which must then be deleted by the caller
  * (can be NULL if the caller is not interested in the dir)
  */
-FhgfsOpsErr InodeDirStore::removeDirInodeUnlocked(std::string dirID, DirInode** outRemovedDir)
+FhgfsOpsErr InodeDirStore::removeDirInodeUnlocked(InodeDirStoreShard* shard, std::string dirID,
+   DirInode** outRemovedDir)
 {
    if(outRemovedDir)
       *outRemovedDir = NULL;
    
-   cacheRemoveUnlocked(dirID); /* we should move this after isRemovable()-check as soon as we can
+   cacheRemoveUnlocked(shard, dirID); /* we should move this after isRemovable()-check as soon as we can
       remove referenced dirs */
 
    uint16_t mirrorNodeID; // will be set if dir mirrored and isRemovableUnlocked() returns success
 
-   FhgfsOpsErr removableRes = isRemovableUnlocked(dirID, &mirrorNodeID);
+   FhgfsOpsErr removableRes = isRemovableUnlocked(shard, dirID, &mirrorNodeID);
    if(removableRes != FhgfsOpsErr_SUCCESS)
       return removableRes;
 
@@ -357,15 +389,64 @@ FhgfsOpsErr InodeDirStore::removeDirInodeUnlocked(std::string dirID, DirInode**
  */
 size_t InodeDirStore::getSize()
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
-   
-   size_t dirsSize = dirs.size();
+   size_t dirsSize = 0;
 
-   safeLock.unlock(); // U N L O C K
+   for(unsigned i=0; i < INODEDIRSTORE_NUM_SHARDS; i++)
+   {
+      InodeDirStoreShard* shard = &shards[i];
+
+      SafeRWLock safeLock(&shard->rwlock, SafeRWLock_READ); // L O C K
+
+      dirsSize += shard->dirs.size();
+
+      safeLock.unlock(); // U N L O C K
+   }
 
    return dirsSize;
 }
 
+/**
+ * Note: Only counts dentries of dirs that are in memory. (Only useful for statistics.)
+ */
+size_t InodeDirStore::getNumCachedDentries()
+{
+   size_t numDentries = 0;
+
+   for(unsigned i=0; i < INODEDIRSTORE_NUM_SHARDS; i++)
+   {
+      InodeDirStoreShard* shard = &shards[i];
+
+      SafeRWLock safeLock(&shard->rwlock, SafeRWLock_READ); // L O C K
+
+      for(DirectoryMapIter iter = shard->dirs.begin(); iter != shard->dirs.end(); iter++)
+         numDentries += iter->second->getReferencedObject()->entries.getNumCachedDentries();
+
+      safeLock.unlock(); // U N L O C K
+   }
+
+   return numDentries;
+}
+
+/**
+ * Drop cached dentry data of the given entryID in the given dir (e.g. after an update of an
+ * inlined inode).
+ *
+ * Note: Does nothing if the dir is not in memory (and especially doesn't load it).
+ */
+void InodeDirStore::invalidateCachedDentryByID(const std::string& dirID,
+   const std::string& entryID)
+{
+   InodeDirStoreShard* shard = getShard(dirID);
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_READ); // L O C K
+
+   DirectoryMapIter iter = shard->dirs.find(dirID);
+   if(iter != shard->dirs.end() )
+      iter->second->getReferencedObject()->entries.invalidateCachedDentryByID(entryID);
+
+   safeLock.unlock(); // U N L O C K
+}
+
 /**
  * @param outParentNodeID may be NULL
  * @param outParentEntryID may be NULL (if outParentNodeID is NULL)
@@ -378,11 +459,13 @@ FhgfsOpsErr InodeDirStore::stat(std::string dirID, StatData& outStatData,
    FhgfsOpsErr statRes = FhgfsOpsErr_PATHNOTEXISTS;
 
    uint16_t localNodeID = Program::getApp()->getLocalNode()->getNumID();
-   
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
-   
-   DirectoryMapIter iter = dirs.find(dirID);
-   if(iter != dirs.end() )
+
+   InodeDirStoreShard* shard = getShard(dirID);
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_READ); // L O C K
+
+   DirectoryMapIter iter = shard->dirs.find(dirID);
+   if(iter != shard->dirs.end() )
    { // dir loaded
       DirectoryReferencer* dirRefer = iter->second;
       DirInode* dir = dirRefer->getReferencedObject();
@@ -434,11 +517,13 @@ FhgfsOpsErr InodeDirStore::setAttr(std::string dirID, int validAttribs,
    SettableFileAttribs* attribs)
 {
    FhgfsOpsErr retVal = FhgfsOpsErr_PATHNOTEXISTS;
-   
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
-   
-   DirectoryMapIter iter = dirs.find(dirID);
-   if(iter == dirs.end() )
+
+   InodeDirStoreShard* shard = getShard(dirID);
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
+
+   DirectoryMapIter iter = shard->dirs.find(dirID);
+   if(iter == shard->dirs.end() )
    { // not loaded => load, apply, destroy
       DirInode dir(dirID);
 
@@ -473,10 +558,11 @@ FhgfsOpsErr InodeDirStore::setAttr(std::string dirID, int validAttribs,
  * Note: We only need to hold a read-lock here, as we check if inserting an entry into the map
  *       succeeded.
  *
+ * @param shard the shard of the dirID
  * @return newElemIter only valid if true is returned, untouched otherwise
  */
-bool InodeDirStore::InsertDirInodeUnlocked(std::string dirID, DirectoryMapIter& newElemIter,
-   bool forceLoad)
+bool InodeDirStore::InsertDirInodeUnlocked(InodeDirStoreShard* shard, std::string dirID,
+   DirectoryMapIter& newElemIter, bool forceLoad)
 {
    bool retVal = false;
 
@@ -494,15 +580,15 @@ bool InodeDirStore::InsertDirInodeUnlocked(std::string dirID, DirectoryMapIter&
    }
 
    std::pair<DirectoryMapIter, bool> pairRes =
-      this->dirs.insert(DirectoryMapVal(dirID, new DirectoryReferencer(inode) ) );
+      shard->dirs.insert(DirectoryMapVal(dirID, new DirectoryReferencer(inode) ) );
 
    if (pairRes.second == false)
    {
       // element already exists in the map, we raced with another thread
       delete inode;
 
-      newElemIter = this->dirs.find(dirID);
-      if (likely (newElemIter != this->dirs.end() ) )
+      newElemIter = shard->dirs.find(dirID);
+      if (likely (newElemIter != shard->dirs.end() ) )
          retVal = true;
    }
    else
@@ -516,45 +602,54 @@ bool InodeDirStore::InsertDirInodeUnlocked(std::string dirID, DirectoryMapIter&
 
 void InodeDirStore::clearStoreUnlocked()
 {
-   LOG_DEBUG("DirectoryStore::clearStoreUnlocked", Log_DEBUG,
-      std::string("# of loaded entries to be cleared: ") + StringTk::intToStr(dirs.size() ) );
+   for(unsigned i=0; i < INODEDIRSTORE_NUM_SHARDS; i++)
+   {
+      InodeDirStoreShard* shard = &shards[i];
 
-   cacheRemoveAllUnlocked();
+      LOG_DEBUG("DirectoryStore::clearStoreUnlocked", Log_DEBUG,
+         std::string("# of loaded entries to be cleared: ") +
+         StringTk::intToStr(shard->dirs.size() ) );
 
-   for(DirectoryMapIter iter = dirs.begin(); iter != dirs.end(); iter++)
-   {
-      DirectoryReferencer* dirRef = iter->second;
+      cacheRemoveAllUnlocked(shard);
 
-      // will also call destructor for dirInode and sub-objects as dirInode->fileStore
-      delete(dirRef);
+      for(DirectoryMapIter iter = shard->dirs.begin(); iter != shard->dirs.end(); iter++)
+      {
+         DirectoryReferencer* dirRef = iter->second;
+
+         // will also call destructor for dirInode and sub-objects as dirInode->fileStore
+         delete(dirRef);
+      }
+
+      shard->dirs.clear();
    }
-   
-   dirs.clear();
 }
 
 /**
  * Note: Make sure to call this only after the new reference has been taken by the caller
  * (otherwise it might happen that the new element is deleted during sweep if it was cached
  * before and appears to be unneeded now).
+ *
+ * @param shard the shard of the dirID (must be write-locked)
  */
-void InodeDirStore::cacheAddUnlocked(std::string& dirID, DirectoryReferencer* dirRefer)
+void InodeDirStore::cacheAddUnlocked(InodeDirStoreShard* shard, std::string& dirID,
+   DirectoryReferencer* dirRefer)
 {
    const char* logContext = "InodeDirStore cache add DirInode";
 
-   Config* cfg = Program::getApp()->getConfig();
-
-   unsigned cacheLimit = cfg->getTuneDirMetadataCacheLimit();
-
-   if (unlikely(cacheLimit == 0) )
+   if (unlikely(refCacheSyncLimit == 0) )
       return; // cache disabled by user config
 
    // (we do cache sweeping before insertion to make sure we don't sweep the new entry)
-   cacheSweepUnlocked(true);
+   cacheSweepUnlocked(shard, true);
 
-   if(refCache.insert(DirCacheMapVal(dirID, dirRefer) ).second)
+   if(shard->refCache.insert(DirCacheMapVal(dirID, dirRefer) ).second)
    { // new insert => inc refcount
       dirRefer->reference();
 
+      /* new entries start without the accessed flag, so that dirs which are only referenced once
+         (e.g. by a big "find") don't push out the dirs that are really in use */
+      dirRefer->getReferencedObject()->cacheAccessed = false;
+
       LOG_DEBUG(logContext, Log_SPAM,  std::string("DirID: ") + dirID +
          " Refcount: " + StringTk::intToStr(dirRefer->getRefCount() ) );
       IGNORE_UNUSED_VARIABLE(logContext);
@@ -562,21 +657,32 @@ void InodeDirStore::cacheAddUnlocked(std::string& dirID, DirectoryReferencer* di
 
 }
 
-void InodeDirStore::cacheRemoveUnlocked(std::string& dirID)
+/**
+ * @param shard the shard of the dirID (must be write-locked)
+ */
+void InodeDirStore::cacheRemoveUnlocked(InodeDirStoreShard* shard, std::string& dirID)
 {
-   DirCacheMapIter iter = refCache.find(dirID);
-   if(iter == refCache.end() )
+   DirCacheMapIter iter = shard->refCache.find(dirID);
+   if(iter == shard->refCache.end() )
       return;
 
-   releaseDirUnlocked(dirID);
-   refCache.erase(iter);
+   if(shard->cacheClockHand == iter)
+      shard->cacheClockHand++;
+
+   releaseDirUnlocked(shard, dirID);
+   shard->refCache.erase(iter);
 }
 
-void InodeDirStore::cacheRemoveAllUnlocked()
+/**
+ * @param shard must be write-locked
+ */
+void InodeDirStore::cacheRemoveAllUnlocked(InodeDirStoreShard* shard)
 {
+   DirCacheMap& refCache = shard->refCache;
+
    for(DirCacheMapIter iter = refCache.begin(); iter != refCache.end(); /* iter inc inside loop */)
    {
-      releaseDirUnlocked(iter->first);
+      releaseDirUnlocked(shard, iter->first);
 
       DirCacheMapIter iterNext(iter);
       iterNext++;
@@ -586,71 +692,72 @@ void InodeDirStore::cacheRemoveAllUnlocked()
 
       iter = iterNext;
    }
+
+   shard->cacheClockHand = refCache.end();
 }
 
 /**
+ * Drop cached dirs of the given shard with CLOCK replacement until the shard is below the limit:
+ * The clock hand walks round the cache, dirs that were accessed since the last pass get their
+ * accessed flag cleared (second chance), dirs that were not accessed are dropped.
+ *
+ * @param shard must be write-locked
  * @param isSyncSweep true if this is a synchronous sweep (e.g. we need to free a few elements to
  * allow quick insertion of a new element), false is this is an asynchronous sweep (that might take
  * a bit longer).
  * @return true if a cache flush was triggered, false otherwise
  */
-bool InodeDirStore::cacheSweepUnlocked(bool isSyncSweep)
+bool InodeDirStore::cacheSweepUnlocked(InodeDirStoreShard* shard, bool isSyncSweep)
 {
-   // sweeping means we remove every n-th element from the cache, starting with a random element
-      // in the range 0 to n
+   DirCacheMap& refCache = shard->refCache;
+   DirCacheMapIter& hand = shard->cacheClockHand;
+
    size_t cacheLimit;
-   size_t removeSkipNum;
+   size_t targetSize;
 
    // check type of sweep and set removal parameters accordingly
 
    if(isSyncSweep)
-   { // sync sweep settings
+   { /* sync sweep settings (free a few more elements than necessary, so that we don't need to
+        sweep again for the next insertions) */
       cacheLimit = refCacheSyncLimit;
-      removeSkipNum = DIRSTORE_REFCACHE_REMOVE_SKIP_SYNC;
+      targetSize = cacheLimit - (cacheLimit >> DIRSTORE_REFCACHE_SYNC_SWEEP_SHIFT);
    }
    else
    { // async sweep settings
       cacheLimit = refCacheAsyncLimit;
-      removeSkipNum = DIRSTORE_REFCACHE_REMOVE_SKIP_ASYNC;
+      targetSize = cacheLimit;
    }
 
    if(refCache.size() <= cacheLimit)
       return false;
 
+   if(targetSize && (targetSize == cacheLimit) && isSyncSweep)
+      targetSize--; // make room for (at least) the new element
 
-   // pick a random start element (note: the element will be removed in first loop pass below)
-
-   unsigned randStart = randGen.getNextInRange(0, removeSkipNum - 1);
-   DirCacheMapIter iter = refCache.begin();
-
-   while(randStart--)
-      iter++;
-
+   /* note: this terminates after at most two rounds of the hand, because accessed flags are only
+      set with (at least) a read-lock, so nobody can set them while we're walking here */
 
-   // walk over all cached elements and remove every n-th element
-
-   unsigned i = removeSkipNum-1; /* counts to every n-th element ("remoteSkipNum-1" to remove the
-      random start element in the first loop pass) */
-
-   while(iter != refCache.end() )
+   while(refCache.size() > targetSize)
    {
-      i++;
+      if(hand == refCache.end() )
+         hand = refCache.begin();
 
-      if(i == removeSkipNum)
-      {
-         releaseDirUnlocked(iter->first);
+      DirInode* dir = hand->second->getReferencedObject();
 
-         DirCacheMapIter iterNext(iter);
-         iterNext++;
+      if(dir->cacheAccessed)
+      { // second chance
+         dir->cacheAccessed = false;
+         hand++;
+         continue;
+      }
 
-         refCache.erase(iter);
+      DirCacheMapIter victimIter(hand);
+      hand++;
 
-         iter = iterNext;
+      releaseDirUnlocked(shard, victimIter->first);
 
-         i = 0;
-      }
-      else
-         iter++;
+      refCache.erase(victimIter);
    }
 
    return true;
@@ -666,11 +773,19 @@ bool InodeDirStore::cacheSweepAsync()
    //LOG_DEBUG(logContext, Log_SPAM, "Start cache sweep."); // debug in
    IGNORE_UNUSED_VARIABLE(logContext);
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
+   bool retVal = false;
 
-   bool retVal = cacheSweepUnlocked(false);
+   for(unsigned i=0; i < INODEDIRSTORE_NUM_SHARDS; i++)
+   {
+      InodeDirStoreShard* shard = &shards[i];
 
-   safeLock.unlock(); // U N L O C K
+      SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
+
+      if(cacheSweepUnlocked(shard, false) )
+         retVal = true;
+
+      safeLock.unlock(); // U N L O C K
+   }
 
    // LOG_DEBUG(logContext, Log_SPAM, "Stop cache sweep."); // debug in
 
@@ -682,11 +797,18 @@ bool InodeDirStore::cacheSweepAsync()
  */
 size_t InodeDirStore::getCacheSize()
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   size_t dirsSize = 0;
 
-   size_t dirsSize = refCache.size();
+   for(unsigned i=0; i < INODEDIRSTORE_NUM_SHARDS; i++)
+   {
+      InodeDirStoreShard* shard = &shards[i];
 
-   safeLock.unlock(); // U N L O C K
+      SafeRWLock safeLock(&shard->rwlock, SafeRWLock_READ); // L O C K
+
+      dirsSize += shard->refCache.size();
+
+      safeLock.unlock(); // U N L O C K
+   }
 
    return dirsSize;
 }
@@ -4,8 +4,8 @@
 #include <common/Common.h>
 #include <common/threading/Mutex.h>
 #include <common/toolkit/AtomicObjectReferencer.h>
+#include <common/toolkit/BufferTk.h>
 #include <common/toolkit/MetadataTk.h>
-#include <common/toolkit/Random.h>
 #include <common/storage/StorageDefinitions.h>
 #include <common/storage/StorageErrors.h>
 
@@ -22,10 +22,32 @@ typedef DirCacheMap::iterator DirCacheMapIter;
 typedef DirCacheMap::const_iterator DirCacheMapCIter;
 typedef DirCacheMap::value_type DirCacheMapVal;
 
+
+#define INODEDIRSTORE_NUM_SHARDS    (16) /* number of independently locked parts of the store */
+
+
+/**
+ * A part of the InodeDirStore with its own lock and its own part of the reference cache.
+ */
+struct InodeDirStoreShard
+{
+   DirectoryMap dirs;
+
+   DirCacheMap refCache;
+   DirCacheMapIter cacheClockHand; // next cache replacement candidate (or refCache.end() )
+
+   RWLock rwlock;
+};
+
 /**
  * Layer in between our inodes and the data on the underlying file system. So we read/write from/to
  * underlying files and this class is to do this corresponding data access.
  * This object is used for for _directories_ only.
+ *
+ * The store is split into shards (by hash of the dirID), so that references to different dirs
+ * don't contend for a single lock. Each shard has its own part of the reference cache, which uses
+ * CLOCK replacement: A reference sets the cacheAccessed flag of the dir and the sweeper only drops
+ * cached dirs that were not accessed since the last time the clock hand passed them.
  */
 class InodeDirStore
 {
@@ -49,6 +71,9 @@ class InodeDirStore
 
       size_t getSize();
       size_t getCacheSize();
+      size_t getNumCachedDentries();
+
+      void invalidateCachedDentryByID(const std::string& dirID, const std::string& entryID);
 
       FhgfsOpsErr stat(std::string dirID, StatData& outStatData,
          uint16_t* outParentNodeID, std::string* outParentEntryID);
@@ -58,16 +83,12 @@ class InodeDirStore
 
 
    private:
-      DirectoryMap dirs;
+      InodeDirStoreShard shards[INODEDIRSTORE_NUM_SHARDS];
 
-      size_t refCacheSyncLimit; // synchronous access limit (=> async limit plus some grace size)
-      size_t refCacheAsyncLimit; // asynchronous cleanup limit (this is what the user configures)
-      Random randGen; // for random cache removal
-      DirCacheMap refCache;
-      
-      RWLock rwlock;
+      size_t refCacheSyncLimit; // per shard synchronous access limit (=> async limit plus grace)
+      size_t refCacheAsyncLimit; // per shard asynchronous cleanup limit
 
-      void releaseDirUnlocked(std::string dirID);
+      void releaseDirUnlocked(InodeDirStoreShard* shard, std::string dirID);
 
       FhgfsOpsErr makeDirInode(DirInode* dir);
       FhgfsOpsErr makeDirInode(DirInode* dir, const CharVector& defaultACLXAttr,
@@ -75,19 +96,36 @@ class InodeDirStore
       FhgfsOpsErr makeDirInodeUnlocked(DirInode* dir);
       FhgfsOpsErr makeDirInodeUnlocked(DirInode* dir, const CharVector& defaultACLXAttr,
          const CharVector& accessACLXAttr);
-      FhgfsOpsErr isRemovableUnlocked(std::string dirID, uint16_t* outMirrorNodeID);
-      FhgfsOpsErr removeDirInodeUnlocked(std::string dirID, DirInode** outRemovedDir);
-      
-      bool InsertDirInodeUnlocked(std::string id, DirectoryMapIter& newElemIter, bool forceLoad);
+      FhgfsOpsErr isRemovableUnlocked(InodeDirStoreShard* shard, std::string dirID,
+         uint16_t* outMirrorNodeID);
+      FhgfsOpsErr removeDirInodeUnlocked(InodeDirStoreShard* shard, std::string dirID,
+         DirInode** outRemovedDir);
+
+      bool InsertDirInodeUnlocked(InodeDirStoreShard* shard, std::string id,
+         DirectoryMapIter& newElemIter, bool forceLoad);
       
       FhgfsOpsErr setDirParent(EntryInfo* entryInfo, uint16_t parentNodeID);
 
       void clearStoreUnlocked();
 
-      void cacheAddUnlocked(std::string& dirID, DirectoryReferencer* dirRefer);
-      void cacheRemoveUnlocked(std::string& dirID);
-      void cacheRemoveAllUnlocked();
-      bool cacheSweepUnlocked(bool isSyncSweep);
+      void cacheAddUnlocked(InodeDirStoreShard* shard, std::string& dirID,
+         DirectoryReferencer* dirRefer);
+      void cacheRemoveUnlocked(InodeDirStoreShard* shard, std::string& dirID);
+      void cacheRemoveAllUnlocked(InodeDirStoreShard* shard);
+      bool cacheSweepUnlocked(InodeDirStoreShard* shard, bool isSyncSweep);
+
+
+      // inliners
+
+      /**
+       * Get the shard that is responsible for the given dirID.
+       */
+      InodeDirStoreShard* getShard(const std::string& dirID)
+      {
+         unsigned hash = BufferTk::hash32(dirID.c_str(), dirID.length() );
+
+         return &shards[hash % INODEDIRSTORE_NUM_SHARDS];
+      }
 };
 
 #endif /*INODEDIRSTORE_H_*/
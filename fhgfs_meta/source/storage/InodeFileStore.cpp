@@ -11,10 +11,12 @@ bool InodeFileStore::isInStore(std::string fileID)
 {
    bool inStore = false;
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   InodeFileStoreShard* shard = getShard(fileID);
 
-   InodeMapIter iter = inodes.find(fileID);
-   if(iter != inodes.end() )
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_READ); // L O C K
+
+   InodeMapIter iter = shard->inodes.find(fileID);
+   if(iter != shard->inodes.end() )
       inStore = true;
 
    safeLock.unlock(); // U N L O C K
@@ -30,15 +32,17 @@ FileInodeReferencer* InodeFileStore::getReferencerAndDeleteFromMap(std::string f
 {
    FileInodeReferencer* fileRefer = NULL;
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   InodeFileStoreShard* shard = getShard(fileID);
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
 
-   InodeMapIter iter = this->inodes.find(fileID);
+   InodeMapIter iter = shard->inodes.find(fileID);
 
-   if(iter != inodes.end() )
+   if(iter != shard->inodes.end() )
    { // exists in map
       fileRefer = iter->second;
 
-      this->inodes.erase(iter);
+      shard->inodes.erase(iter);
    }
 
    safeLock.unlock(); // U N L O C K
@@ -61,13 +65,15 @@ FileInode* InodeFileStore::referenceLoadedFile(std::string entryID)
 {
    FileInode* inode = NULL;
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   InodeFileStoreShard* shard = getShard(entryID);
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_READ); // L O C K
 
-   InodeMapIter iter = this->inodes.find(entryID);
+   InodeMapIter iter = shard->inodes.find(entryID);
 
-   if(iter != this->inodes.end() )
+   if(iter != shard->inodes.end() )
    {
-      inode = referenceFileInodeMapIterUnlocked(iter, &this->inodes);
+      inode = referenceFileInodeMapIterUnlocked(iter, &shard->inodes);
    }
 
    safeLock.unlock(); // U N L O C K
@@ -87,9 +93,11 @@ FileInode* InodeFileStore::referenceLoadedFile(std::string entryID)
  */
 FileInode* InodeFileStore::referenceFileInode(EntryInfo* entryInfo, bool loadFromDisk)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
+   InodeFileStoreShard* shard = getShard(entryInfo->getEntryID() );
 
-   FileInode* inode = referenceFileInodeUnlocked(entryInfo, loadFromDisk);
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
+
+   FileInode* inode = referenceFileInodeUnlocked(shard, entryInfo, loadFromDisk);
 
    safeLock.unlock(); // U N L O C K
 
@@ -97,24 +105,27 @@ FileInode* InodeFileStore::referenceFileInode(EntryInfo* entryInfo, bool loadFro
 }
 
 /**
- * Note: this->rwlock needs to be write locked
+ * Note: shard->rwlock needs to be write locked
  * Note: We do not add a reference if isRename == true, but we set an exclusive flag and just
  *       return an unreferenced inode, which can be deleted anytime.
+ *
+ * @param shard the shard of the entryID
  */
-FileInode* InodeFileStore::referenceFileInodeUnlocked(EntryInfo* entryInfo, bool loadFromDisk)
+FileInode* InodeFileStore::referenceFileInodeUnlocked(InodeFileStoreShard* shard,
+   EntryInfo* entryInfo, bool loadFromDisk)
 {
    FileInode* inode = NULL;
 
-   InodeMapIter iter =  this->inodes.find(entryInfo->getEntryID() );
+   InodeMapIter iter =  shard->inodes.find(entryInfo->getEntryID() );
 
-   if(iter == this->inodes.end() && loadFromDisk)
+   if(iter == shard->inodes.end() && loadFromDisk)
    { // not in map yet => try to load it
-      loadAndInsertFileInodeUnlocked(entryInfo, iter);
+      loadAndInsertFileInodeUnlocked(shard, entryInfo, iter);
    }
 
-   if(iter != this->inodes.end() )
+   if(iter != shard->inodes.end() )
    { // outInode exists
-      inode = referenceFileInodeMapIterUnlocked(iter, &this->inodes);
+      inode = referenceFileInodeMapIterUnlocked(iter, &shard->inodes);
    }
 
    return inode;
@@ -122,20 +133,23 @@ FileInode* InodeFileStore::referenceFileInodeUnlocked(EntryInfo* entryInfo, bool
 
 /**
  * Return an unreferenced inode object. The inode is also not exclusively locked.
+ *
+ * @param shard the shard of the entryID (must be write-locked)
  */
-FhgfsOpsErr InodeFileStore::getUnreferencedInodeUnlocked(EntryInfo* entryInfo, FileInode** outInode)
+FhgfsOpsErr InodeFileStore::getUnreferencedInodeUnlocked(InodeFileStoreShard* shard,
+   EntryInfo* entryInfo, FileInode** outInode)
 {
    FileInode* inode = NULL;
    FhgfsOpsErr retVal = FhgfsOpsErr_PATHNOTEXISTS;
 
-   InodeMapIter iter =  this->inodes.find(entryInfo->getEntryID() );
+   InodeMapIter iter =  shard->inodes.find(entryInfo->getEntryID() );
 
-   if(iter == this->inodes.end() )
+   if(iter == shard->inodes.end() )
    { // not in map yet => try to load it.
-      loadAndInsertFileInodeUnlocked(entryInfo, iter);
+      loadAndInsertFileInodeUnlocked(shard, entryInfo, iter);
    }
 
-   if(iter != this->inodes.end() )
+   if(iter != shard->inodes.end() )
    { // outInode exists => check whether no references etc. exist
       FileInodeReferencer* inodeRefer = iter->second;
       inode = inodeRefer->getReferencedObject();
@@ -157,7 +171,7 @@ FhgfsOpsErr InodeFileStore::getUnreferencedInodeUnlocked(EntryInfo* entryInfo, F
    if (inode && inode->getNumHardlinks() > 1)
    {  /* So the inode is not referenced and we set our exclusive lock. However, there are several
        * hardlinks for this file. Currently only rename with a linkCount == 1 is supported! */
-      deleteUnreferencedInodeUnlocked(entryInfo->getEntryID() );
+      deleteUnreferencedInodeUnlocked(shard, entryInfo->getEntryID() );
       inode = NULL;
       retVal = FhgfsOpsErr_INUSE;
    }
@@ -200,11 +214,13 @@ FileInode* InodeFileStore::referenceFileInodeMapIterUnlocked(InodeMapIter& iter,
 /**
  * Decrease the inode reference counter using the given iter.
  *
- * Note: InodeFileStore needs to be write-locked.
+ * Note: The shard of the inode needs to be write-locked.
  *
+ * @param shard the shard that contains iter
  * @return number of inode references after release()
  */
-unsigned InodeFileStore::decreaseInodeRefCountUnlocked(InodeMapIter& iter)
+unsigned InodeFileStore::decreaseInodeRefCountUnlocked(InodeFileStoreShard* shard,
+   InodeMapIter& iter)
 {
    const char* logContext = "Release File Inode";
 
@@ -220,7 +236,7 @@ unsigned InodeFileStore::decreaseInodeRefCountUnlocked(InodeMapIter& iter)
    if(!refCount)
    { // dropped last reference => unload outInode
       delete(inodeRefer);
-      this->inodes.erase(iter);
+      shard->inodes.erase(iter);
    }
 
 
@@ -235,13 +251,15 @@ bool InodeFileStore::closeFile(EntryInfo* entryInfo, FileInode* inode, unsigned
 {
    // TODO: Test with a read-lock if the file is in the store at all?
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
+   InodeFileStoreShard* shard = getShard(inode->getEntryID() );
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
 
    bool inStore = false;
    *outNumHardlinks = 1; // (we're careful here about inodes that are not currently open)
 
-   InodeMapIter iter = this->inodes.find(inode->getEntryID() );
-   if(iter != this->inodes.end() )
+   InodeMapIter iter = shard->inodes.find(inode->getEntryID() );
+   if(iter != shard->inodes.end() )
    { // outInode exists
 
       *outNumHardlinks = inode->getNumHardlinks();
@@ -250,7 +268,7 @@ bool InodeFileStore::closeFile(EntryInfo* entryInfo, FileInode* inode, unsigned
       entryInfo->setInodeInlinedFlag(inode->getIsInlined() );
       inode->decNumSessionsAndStore(entryInfo, accessFlags);
 
-      *outNumRefs = decreaseInodeRefCountUnlocked(iter);
+      *outNumRefs = decreaseInodeRefCountUnlocked(shard, iter);
 
       inStore = true;
    }
@@ -268,12 +286,14 @@ bool InodeFileStore::releaseFileInode(FileInode* inode)
 {
    bool inStore = false;
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
+   InodeFileStoreShard* shard = getShard(inode->getEntryID() );
 
-   InodeMapIter iter = this->inodes.find(inode->getEntryID() );
-   if(iter != this->inodes.end() )
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
+
+   InodeMapIter iter = shard->inodes.find(inode->getEntryID() );
+   if(iter != shard->inodes.end() )
    { // outInode exists => decrease refCount
-      decreaseInodeRefCountUnlocked(iter);
+      decreaseInodeRefCountUnlocked(shard, iter);
       inStore = true;
    }
 
@@ -288,8 +308,11 @@ bool InodeFileStore::releaseFileInode(FileInode* inode)
  *
  * @return FhgfsOpsErr_SUCCESS when not in use, FhgfsOpsErr_INUSE when the inode is referenced and
  *    FhgfsOpsErr_PATHNOTEXISTS when it is exclusively locked.
+ *
+ * @param shard the shard of the entryID (must be locked)
  */
-FhgfsOpsErr InodeFileStore::isUnlinkableUnlocked(EntryInfo* entryInfo)
+FhgfsOpsErr InodeFileStore::isUnlinkableUnlocked(InodeFileStoreShard* shard,
+   EntryInfo* entryInfo)
 {
    FileInode* inode;
 
@@ -297,8 +320,8 @@ FhgfsOpsErr InodeFileStore::isUnlinkableUnlocked(EntryInfo* entryInfo)
 
    FhgfsOpsErr delErr = FhgfsOpsErr_SUCCESS;
 
-   InodeMapCIter iter = inodes.find(entryID);
-   if(iter != inodes.end() )
+   InodeMapCIter iter = shard->inodes.find(entryID);
+   if(iter != shard->inodes.end() )
    {
       FileInodeReferencer* fileRefer = iter->second;
       inode = fileRefer->getReferencedObject();
@@ -316,9 +339,11 @@ FhgfsOpsErr InodeFileStore::isUnlinkableUnlocked(EntryInfo* entryInfo)
 
 FhgfsOpsErr InodeFileStore::isUnlinkable(EntryInfo* entryInfo)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   InodeFileStoreShard* shard = getShard(entryInfo->getEntryID() );
 
-   FhgfsOpsErr retVal = this->isUnlinkableUnlocked(entryInfo);
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_READ); // L O C K
+
+   FhgfsOpsErr retVal = this->isUnlinkableUnlocked(shard, entryInfo);
 
    safeLock.unlock();
 
@@ -333,15 +358,18 @@ FhgfsOpsErr InodeFileStore::isUnlinkable(EntryInfo* entryInfo)
  *              continue. If there are storage objects, we cannot delete them one way or the
  *              other. So no need to return an error here. Update all code path to handle
  *              *outInode = NULL, even is the return code is FhgfsOpsErr_SUCCESS
+ *
+ * @param shard the shard of the entryID (must be write-locked)
  */
-FhgfsOpsErr InodeFileStore::unlinkFileInodeUnlocked(EntryInfo* entryInfo, FileInode** outInode)
+FhgfsOpsErr InodeFileStore::unlinkFileInodeUnlocked(InodeFileStoreShard* shard,
+   EntryInfo* entryInfo, FileInode** outInode)
 {
    if(outInode)
       *outInode = NULL;
 
    std::string entryID = entryInfo->getEntryID();
 
-   FhgfsOpsErr unlinkableRes = isUnlinkableUnlocked(entryInfo);
+   FhgfsOpsErr unlinkableRes = isUnlinkableUnlocked(shard, entryInfo);
    if(unlinkableRes != FhgfsOpsErr_SUCCESS)
       return unlinkableRes;
 
@@ -373,9 +401,11 @@ FhgfsOpsErr InodeFileStore::unlinkFileInodeUnlocked(EntryInfo* entryInfo, FileIn
  */
 FhgfsOpsErr InodeFileStore::unlinkFileInode(EntryInfo* entryInfo, FileInode** outInode)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
+   InodeFileStoreShard* shard = getShard(entryInfo->getEntryID() );
 
-   FhgfsOpsErr delErr = unlinkFileInodeUnlocked(entryInfo, outInode);
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
+
+   FhgfsOpsErr delErr = unlinkFileInodeUnlocked(shard, entryInfo, outInode);
 
    safeLock.unlock(); // U N L O C K
 
@@ -402,10 +432,12 @@ FhgfsOpsErr InodeFileStore::moveRemoteBegin(EntryInfo* entryInfo, char* buf, siz
       return FhgfsOpsErr_INTERNAL;
    }
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
+   InodeFileStoreShard* shard = getShard(entryInfo->getEntryID() );
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
 
    FileInode* inode;
-   retVal = getUnreferencedInodeUnlocked(entryInfo, &inode); // does not set refCount
+   retVal = getUnreferencedInodeUnlocked(shard, entryInfo, &inode); // does not set refCount
    if (retVal == FhgfsOpsErr_SUCCESS)
    {
       /* We got an inode, which is in the map, but is unreferenced. Now we are going to exclusively
@@ -434,25 +466,30 @@ void InodeFileStore::moveRemoteComplete(std::string entryID)
 {
    // moving succeeded => delete original
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
+   InodeFileStoreShard* shard = getShard(entryID);
 
-   deleteUnreferencedInodeUnlocked(entryID);
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
+
+   deleteUnreferencedInodeUnlocked(shard, entryID);
 
    safeLock.unlock(); // U N L O C K
 }
 
 /**
  * Finish the rename/move operation by deleting the inode object.
+ *
+ * @param shard the shard of the entryID (must be write-locked)
  */
-void InodeFileStore::deleteUnreferencedInodeUnlocked(std::string entryID)
+void InodeFileStore::deleteUnreferencedInodeUnlocked(InodeFileStoreShard* shard,
+   std::string entryID)
 {
-   InodeMapIter iter = inodes.find(entryID);
-   if(iter != inodes.end() )
+   InodeMapIter iter = shard->inodes.find(entryID);
+   if(iter != shard->inodes.end() )
    { // file exists
       FileInodeReferencer* fileRefer = iter->second;
 
       delete fileRefer;
-      inodes.erase(entryID);
+      shard->inodes.erase(iter);
    }
 }
 
@@ -462,11 +499,18 @@ void InodeFileStore::deleteUnreferencedInodeUnlocked(std::string entryID)
  */
 size_t InodeFileStore::getSize()
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   size_t filesSize = 0;
 
-   size_t filesSize = inodes.size();
+   for(unsigned i=0; i < numShards; i++)
+   {
+      InodeFileStoreShard* shard = &shards[i];
 
-   safeLock.unlock(); // U N L O C K
+      SafeRWLock safeLock(&shard->rwlock, SafeRWLock_READ); // L O C K
+
+      filesSize += shard->inodes.size();
+
+      safeLock.unlock(); // U N L O C K
+   }
 
    return filesSize;
 }
@@ -491,7 +535,9 @@ FhgfsOpsErr InodeFileStore::openFile(EntryInfo* entryInfo, unsigned accessFlags,
 
 bool InodeFileStore::exists(std::string fileID)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   InodeFileStoreShard* shard = getShard(fileID);
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_READ); // L O C K
 
    bool existsRes = existsUnlocked(fileID);
 
@@ -527,10 +573,12 @@ FhgfsOpsErr InodeFileStore::stat(EntryInfo* entryInfo, bool loadFromDisk, StatDa
    std::string entryID = entryInfo->getEntryID();
    FhgfsOpsErr statRes = FhgfsOpsErr_PATHNOTEXISTS;
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
+   InodeFileStoreShard* shard = getShard(entryID);
 
-   InodeMapIter iter = inodes.find(entryID);
-   if(iter != inodes.end() )
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_READ); // L O C K
+
+   InodeMapIter iter = shard->inodes.find(entryID);
+   if(iter != shard->inodes.end() )
    { // inode loaded
       FileInodeReferencer* fileRefer = iter->second;
       FileInode* inode = fileRefer->getReferencedObject();
@@ -564,10 +612,12 @@ FhgfsOpsErr InodeFileStore::setAttr(EntryInfo* entryInfo, int validAttribs,
    std::string entryID = entryInfo->getEntryID();
    FhgfsOpsErr retVal = FhgfsOpsErr_PATHNOTEXISTS;
 
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
+   InodeFileStoreShard* shard = getShard(entryID);
+
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
 
-   InodeMapIter iter = inodes.find(entryID);
-   if(iter == inodes.end() )
+   InodeMapIter iter = shard->inodes.find(entryID);
+   if(iter == shard->inodes.end() )
    { // not loaded => load, apply, destroy
 
       // Note: A very uncommon code path, as SetAttrMsgEx::setAttr() references the inode first.
@@ -636,16 +686,19 @@ FhgfsOpsErr InodeFileStore::setAttr(EntryInfo* entryInfo, int validAttribs,
  *
  * Note: Caller must make sure that the element wasn't in the map before.
  *
+ * @param shard the shard of the entryID (must be write-locked)
  * @return newElemIter only valid if true is returned, untouched otherwise
  */
-bool InodeFileStore::loadAndInsertFileInodeUnlocked(EntryInfo* entryInfo, InodeMapIter& newElemIter)
+bool InodeFileStore::loadAndInsertFileInodeUnlocked(InodeFileStoreShard* shard,
+   EntryInfo* entryInfo, InodeMapIter& newElemIter)
 {
    FileInode* inode = FileInode::createFromEntryInfo(entryInfo);
    if(!inode)
       return false;
 
    std::string entryID = entryInfo->getEntryID();
-   newElemIter = inodes.insert(InodeMapVal(entryID, new FileInodeReferencer(inode) ) ).first;
+   newElemIter =
+      shard->inodes.insert(InodeMapVal(entryID, new FileInodeReferencer(inode) ) ).first;
 
    return true;
 }
@@ -657,9 +710,11 @@ bool InodeFileStore::loadAndInsertFileInodeUnlocked(EntryInfo* entryInfo, InodeM
  */
 bool InodeFileStore::insertReferencer(std::string entryID, FileInodeReferencer* fileRefer)
 {
-   SafeRWLock safeLock(&rwlock, SafeRWLock_WRITE); // L O C K
+   InodeFileStoreShard* shard = getShard(entryID);
 
-   bool retVal = this->inodes.insert(InodeMapVal(entryID, fileRefer) ).second;
+   SafeRWLock safeLock(&shard->rwlock, SafeRWLock_WRITE); // L O C K
+
+   bool retVal = shard->inodes.insert(InodeMapVal(entryID, fileRefer) ).second;
 
    safeLock.unlock(); // U N L O C K
 
@@ -672,29 +727,34 @@ void InodeFileStore::clearStoreUnlocked()
    const char* logContext = "FileStore::clearStoreUnlocked";
    App* app = Program::getApp();
 
-   LOG_DEBUG(logContext, Log_DEBUG,
-      std::string("# of loaded entries to be cleared: ") + StringTk::intToStr(inodes.size() ) );
-   IGNORE_UNUSED_VARIABLE(logContext);
-
-   for(InodeMapIter iter = inodes.begin(); iter != inodes.end(); iter++)
+   for(unsigned i=0; i < numShards; i++)
    {
-      FileInode* file = iter->second->getReferencedObject();
+      InodeMap& inodes = shards[i].inodes;
+
+      LOG_DEBUG(logContext, Log_DEBUG,
+         std::string("# of loaded entries to be cleared: ") + StringTk::intToStr(inodes.size() ) );
+      IGNORE_UNUSED_VARIABLE(logContext);
+
+      for(InodeMapIter iter = inodes.begin(); iter != inodes.end(); iter++)
+      {
+         FileInode* file = iter->second->getReferencedObject();
+
+         if(unlikely(file->getNumSessionsAll() ) )
+         { // check whether file was still open
+            LOG_DEBUG(logContext, Log_DEBUG,
+               std::string("File was still open during shutdown: ") +
+               file->getEntryID() + "; # of sessions: " +
+               StringTk::intToStr(file->getNumSessionsAll() ) );
 
-      if(unlikely(file->getNumSessionsAll() ) )
-      { // check whether file was still open
-         LOG_DEBUG(logContext, Log_DEBUG,
-            std::string("File was still open during shutdown: ") +
-            file->getEntryID() + "; # of sessions: " +
-            StringTk::intToStr(file->getNumSessionsAll() ) );
+            if (!app->getSelfTerminate() )
+               LogContext(logContext).logBacktrace();
+         }
 
-         if (!app->getSelfTerminate() )
-            LogContext(logContext).logBacktrace();
+         delete(iter->second);
       }
 
-      delete(iter->second);
+      inodes.clear();
    }
-
-   inodes.clear();
 }
 
 /**
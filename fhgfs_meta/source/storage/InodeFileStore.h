@@ -4,6 +4,7 @@
 #include <common/toolkit/ObjectReferencer.h>
 #include <common/Common.h>
 #include <common/threading/Mutex.h>
+#include <common/toolkit/BufferTk.h>
 #include <common/toolkit/MetadataTk.h>
 #include <common/storage/StorageDefinitions.h>
 #include <common/storage/StorageErrors.h>
@@ -16,10 +17,29 @@ typedef InodeMap::iterator InodeMapIter;
 typedef InodeMap::const_iterator InodeMapCIter;
 typedef InodeMap::value_type InodeMapVal;
 
+
+#define INODEFILESTORE_DIR_NUM_SHARDS     (4) /* shards of a per-directory store */
+#define INODEFILESTORE_GLOBAL_NUM_SHARDS  (64) /* shards of the global store in MetaStore */
+
+
+/**
+ * A part of the InodeFileStore with its own map and lock.
+ */
+struct InodeFileStoreShard
+{
+   InodeMap inodes;
+   RWLock rwlock;
+};
+
+
 /**
  * Layer in between our inodes and the data on the underlying file system. So we read/write from/to
  * underlying inodes and this class is to do this corresponding data access.
  * This object is used for all file types, for example regular files, but NOT directories.
+ *
+ * The inodes are distributed over a fixed number of independently locked shards based on a hash of
+ * the entryID, so that operations on different files don't block each other. All operations only
+ * concern a single entryID and hence only lock a single shard.
  */
 class InodeFileStore
 {
@@ -27,10 +47,17 @@ class InodeFileStore
    friend class MetaStore;
 
    public:
-      InodeFileStore() {}
+      InodeFileStore(unsigned numShards = INODEFILESTORE_DIR_NUM_SHARDS) :
+         numShards(numShards ? numShards : 1)
+      {
+         this->shards = new InodeFileStoreShard[this->numShards];
+      }
+
       ~InodeFileStore()
       {
          this->clearStoreUnlocked();
+
+         delete[](shards);
       };
 
       bool isInStore(std::string fileID);
@@ -59,23 +86,26 @@ class InodeFileStore
       FhgfsOpsErr isUnlinkable(EntryInfo* entryInfo);
 
    private:
-      InodeMap inodes;
+      InodeFileStoreShard* shards; // (array of numShards elements)
+      unsigned numShards;
 
-      RWLock rwlock;
+      unsigned decreaseInodeRefCountUnlocked(InodeFileStoreShard* shard, InodeMapIter& iter);
+      FileInode* referenceFileInodeUnlocked(InodeFileStoreShard* shard, EntryInfo* entryInfo,
+         bool loadFromDisk);
+      FhgfsOpsErr getUnreferencedInodeUnlocked(InodeFileStoreShard* shard, EntryInfo* entryInfo,
+         FileInode** outInode);
+      void deleteUnreferencedInodeUnlocked(InodeFileStoreShard* shard, std::string entryID);
 
-      unsigned decreaseInodeRefCountUnlocked(InodeMapIter& iter);
-      FileInode* referenceFileInodeUnlocked(EntryInfo* entryInfo, bool loadFromDisk);
-      FhgfsOpsErr getUnreferencedInodeUnlocked(EntryInfo* entryInfo, FileInode** outInode);
-      void deleteUnreferencedInodeUnlocked(std::string entryID);
-
-      FhgfsOpsErr isUnlinkableUnlocked(EntryInfo* entryInfo);
+      FhgfsOpsErr isUnlinkableUnlocked(InodeFileStoreShard* shard, EntryInfo* entryInfo);
 
       FhgfsOpsErr makeFileInode(FileInode* file);
       FhgfsOpsErr makeFileInodeUnlocked(FileInode* file);
-      FhgfsOpsErr unlinkFileInodeUnlocked(EntryInfo* entryInfo, FileInode** outFile);
+      FhgfsOpsErr unlinkFileInodeUnlocked(InodeFileStoreShard* shard, EntryInfo* entryInfo,
+         FileInode** outFile);
       bool existsUnlocked(std::string fileID);
 
-      bool loadAndInsertFileInodeUnlocked(EntryInfo* entryInfo, InodeMapIter& newElemIter);
+      bool loadAndInsertFileInodeUnlocked(InodeFileStoreShard* shard, EntryInfo* entryInfo,
+         InodeMapIter& newElemIter);
       bool insertReferencer(std::string entryID, FileInodeReferencer* fileRefer);
 
       FileInodeReferencer* getReferencerAndDeleteFromMap(std::string fileID);
@@ -107,6 +137,17 @@ class InodeFileStore
 
       // inliners
 
+      /**
+       * Get the shard that is responsible for the given entryID.
+       */
+      InodeFileStoreShard* getShard(const std::string& entryID)
+      {
+         if(numShards == 1)
+            return shards;
+
+         return &shards[BufferTk::hash32(entryID.c_str(), entryID.length() ) % numShards];
+      }
+
       /**
        * Create an unreferenced file inode from an existing inode on disk disk.
        */
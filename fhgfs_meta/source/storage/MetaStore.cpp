@@ -96,7 +96,7 @@ void MetaStore::unlockAndReleaseDirUnlocked(std::string dirID, DirInode* dir)
     * (1st DirStore and then DirInode, but DirInode is already locked here), we need to be very
     * careful and only do that in debug mode. */
    #ifdef BEEGFS_DEBUG_RELEASE_DIR
-      SafeRWLock safeLock(&dirStore.rwlock);
+      SafeRWLock safeLock(&dirStore.getShard(dirID)->rwlock);
 
       const char* logContext = "MetaStore Unlock and Release Dir";
       bool lockRes;
@@ -1655,15 +1655,29 @@ void MetaStore::getReferenceStats(size_t* numReferencedDirs, size_t* numReferenc
    safeLock.unlock(); // U N L O C K
 }
 
-void MetaStore::getCacheStats(size_t* numCachedDirs)
+void MetaStore::getCacheStats(size_t* numCachedDirs, size_t* numCachedDentries)
 {
    SafeRWLock safeLock(&rwlock, SafeRWLock_READ); // L O C K
 
    *numCachedDirs = dirStore.getCacheSize();
+   *numCachedDentries = dirStore.getNumCachedDentries();
 
    safeLock.unlock(); // U N L O C K
 }
 
+/**
+ * Drop cached dentry data of the given entryID in the given parent dir, e.g. after an update of an
+ * inlined inode (which doesn't go through the DirEntryStore of the parent).
+ *
+ * Note: Doesn't take the MetaStore lock, as this is called from inode updates, for which the
+ * caller might already hold the MetaStore write lock.
+ */
+void MetaStore::invalidateCachedDentryByID(const std::string& parentID,
+   const std::string& entryID)
+{
+   dirStore.invalidateCachedDentryByID(parentID, entryID);
+}
+
 /**
  * Asynchronous cache sweep.
  *
@@ -41,7 +41,7 @@ typedef RmDirMap::value_type RmDirMapVal;
 class MetaStore
 {
    public:
-      MetaStore() {};
+      MetaStore() : fileStore(INODEFILESTORE_GLOBAL_NUM_SHARDS) {};
       ~MetaStore() {};
 
       DirInode* referenceDir(const std::string dirID, const bool forceLoad);
@@ -96,7 +96,8 @@ class MetaStore
          StringList* outEntryIDFiles, int64_t* outNewOffset);
 
       void getReferenceStats(size_t* numReferencedDirs, size_t* numReferencedFiles);
-      void getCacheStats(size_t* numCachedDirs);
+      void getCacheStats(size_t* numCachedDirs, size_t* numCachedDentries);
+      void invalidateCachedDentryByID(const std::string& parentID, const std::string& entryID);
 
       bool cacheSweepAsync();
 
@@ -115,7 +116,8 @@ class MetaStore
       InodeDirStore dirStore;
 
       /* We need to avoid to use that one, as it is a global store, with possible lots of entries.
-       * So access to the map is slow and inserting entries blocks the entire MetaStore */
+       * So access to the map is slow (it uses more shards than the per-directory stores to keep
+       * inserting entries from blocking each other) */
       InodeFileStore fileStore;
 
       RWLock rwlock; /* note: this is mostly not used as a read/write-lock but rather a shared/excl
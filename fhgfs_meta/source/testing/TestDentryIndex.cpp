@@ -0,0 +1,347 @@
+#include "TestDentryIndex.h"
+
+#include <common/toolkit/serialization/Serialization.h>
+#include <common/toolkit/StorageTk.h>
+#include <storage/DirEntry.h>
+
+#include <climits>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+
+TestDentryIndex::TestDentryIndex()
+{
+   log.setContext("TestDentryIndex");
+}
+
+TestDentryIndex::~TestDentryIndex()
+{
+}
+
+void TestDentryIndex::setUp()
+{
+   char dirTemplate[] = TESTDENTRYINDEX_DIR_TEMPLATE;
+
+   if(!mkdtemp(dirTemplate) )
+      CPPUNIT_FAIL("Unable to create test dir: " + System::getErrString() );
+
+   dentriesPath = dirTemplate;
+
+   std::string idsPath = dentriesPath + "/" META_DIRENTRYID_SUB_STR;
+
+   if(mkdir(idsPath.c_str(), 0755) )
+      CPPUNIT_FAIL("Unable to create test dir: " + System::getErrString() );
+}
+
+void TestDentryIndex::tearDown()
+{
+   StorageTk::removeDirRecursive(dentriesPath);
+}
+
+void TestDentryIndex::testRecordFormat()
+{
+   log.log(Log_DEBUG, "testRecordFormat started");
+
+   const std::string name("entryName");
+   const std::string entryID("1A-2B-3C");
+
+   char buf[DENTRYINDEX_RECORD_HEADER_LEN + 64];
+
+   unsigned recLen = DentryIndex::serializeRecord(buf, name, entryID, DirEntryType_REGULARFILE,
+      0x1234);
+
+   // recLen, flags, entryType, ownerNodeID, nameLen, idLen, name, entryID (little endian)
+
+   CPPUNIT_ASSERT(recLen == DENTRYINDEX_RECORD_HEADER_LEN + name.length() + entryID.length() );
+   CPPUNIT_ASSERT(Serialization::loadLE<unsigned>(&buf[0]) == recLen);
+   CPPUNIT_ASSERT( (uint8_t)buf[4] == DENTRYINDEX_RECORD_FLAG_LIVE);
+   CPPUNIT_ASSERT( (uint8_t)buf[5] == DirEntryType_REGULARFILE);
+   CPPUNIT_ASSERT(Serialization::loadLE<uint16_t>(&buf[6]) == 0x1234);
+   CPPUNIT_ASSERT(Serialization::loadLE<uint16_t>(&buf[8]) == name.length() );
+   CPPUNIT_ASSERT(Serialization::loadLE<uint16_t>(&buf[10]) == entryID.length() );
+   CPPUNIT_ASSERT(!memcmp(&buf[12], name.c_str(), name.length() ) );
+   CPPUNIT_ASSERT(!memcmp(&buf[12 + name.length()], entryID.c_str(), entryID.length() ) );
+
+   DentryIndexEntry entry;
+   bool isLive = false;
+   unsigned deserLen = 0;
+
+   CPPUNIT_ASSERT(DentryIndex::deserializeRecord(buf, recLen, &entry, &isLive, &deserLen) );
+   CPPUNIT_ASSERT(deserLen == recLen);
+   CPPUNIT_ASSERT(isLive);
+   CPPUNIT_ASSERT(entry.name == name);
+   CPPUNIT_ASSERT(entry.entryID == entryID);
+   CPPUNIT_ASSERT(entry.entryType == DirEntryType_REGULARFILE);
+   CPPUNIT_ASSERT(entry.ownerNodeID == 0x1234);
+
+   // incomplete record (e.g. at the end of a read buffer)
+   CPPUNIT_ASSERT(!DentryIndex::deserializeRecord(buf, recLen - 1, &entry, &isLive, &deserLen) );
+
+   // removed records are only marked in the flags field
+   buf[4] = 0;
+
+   CPPUNIT_ASSERT(DentryIndex::deserializeRecord(buf, recLen, &entry, &isLive, &deserLen) );
+   CPPUNIT_ASSERT(!isLive);
+
+   // inconsistent length fields
+   buf[8]++;
+
+   CPPUNIT_ASSERT(!DentryIndex::deserializeRecord(buf, recLen, &entry, &isLive, &deserLen) );
+
+   // header: magic, version, generation, reserved, numLiveRecords, fileSize, mtime secs/nsecs
+
+   char headerBuf[DENTRYINDEX_HEADER_LEN];
+   struct timespec mtime = { 1234567, 890 };
+
+   CPPUNIT_ASSERT(DentryIndex::serializeHeader(headerBuf, 7, 42, 4096, &mtime) ==
+      DENTRYINDEX_HEADER_LEN);
+   CPPUNIT_ASSERT(Serialization::loadLE<unsigned>(&headerBuf[0]) == DENTRYINDEX_MAGIC);
+   CPPUNIT_ASSERT(Serialization::loadLE<unsigned>(&headerBuf[4]) == DENTRYINDEX_VERSION);
+   CPPUNIT_ASSERT(Serialization::loadLE<unsigned>(&headerBuf[8]) == 7);
+   CPPUNIT_ASSERT(Serialization::loadLE<uint64_t>(&headerBuf[16]) == 42);
+   CPPUNIT_ASSERT(Serialization::loadLE<int64_t>(&headerBuf[24]) == 4096);
+   CPPUNIT_ASSERT(Serialization::loadLE<int64_t>(&headerBuf[32]) == 1234567);
+   CPPUNIT_ASSERT(Serialization::loadLE<int64_t>(&headerBuf[40]) == 890);
+
+   log.log(Log_DEBUG, "testRecordFormat finished");
+}
+
+/**
+ * The index file is compacted once there are at least DENTRYINDEX_COMPACT_MIN_DEAD records of
+ * removed dentries and more of them than live records.
+ */
+void TestDentryIndex::testCompaction()
+{
+   log.log(Log_DEBUG, "testCompaction started");
+
+   const unsigned numEntries = 2 * DENTRYINDEX_COMPACT_MIN_DEAD;
+   const unsigned recLen = DENTRYINDEX_RECORD_HEADER_LEN + 2 * 8; // name and ID have 8 chars
+
+   DentryIndex index(dentriesPath);
+   struct stat statBuf;
+
+   // note: the index only records the updates, so we don't need the dentry files here
+
+   for(unsigned i = 0; i < numEntries; i++)
+   {
+      std::string hexNum = StringTk::uintToHexStr(0x1000 + i);
+
+      index.prepareUpdate();
+      index.addEntry("name" + hexNum, "ID--" + hexNum, DirEntryType_REGULARFILE, 1);
+   }
+
+   CPPUNIT_ASSERT(index.numLiveRecords == numEntries);
+   CPPUNIT_ASSERT(index.fileSize == DENTRYINDEX_HEADER_LEN + numEntries * recLen);
+
+   // as many dead as live records => not compacted yet
+
+   for(unsigned i = 0; i < numEntries / 2; i++)
+   {
+      index.prepareUpdate();
+      index.removeEntry("name" + StringTk::uintToHexStr(0x1000 + i) );
+   }
+
+   unsigned oldGeneration = index.generation;
+
+   CPPUNIT_ASSERT(index.numDeadRecords == numEntries / 2);
+   CPPUNIT_ASSERT(index.fileSize == DENTRYINDEX_HEADER_LEN + numEntries * recLen);
+
+   // one more dead record => compacted
+
+   index.prepareUpdate();
+   index.removeEntry("name" + StringTk::uintToHexStr(0x1000 + numEntries / 2) );
+
+   const unsigned numLeft = numEntries / 2 - 1;
+
+   CPPUNIT_ASSERT(index.numDeadRecords == 0);
+   CPPUNIT_ASSERT(index.numLiveRecords == numLeft);
+   CPPUNIT_ASSERT(index.fileSize == DENTRYINDEX_HEADER_LEN + numLeft * recLen);
+   CPPUNIT_ASSERT(index.generation != oldGeneration);
+
+   CPPUNIT_ASSERT(!stat(index.indexPath.c_str(), &statBuf) );
+   CPPUNIT_ASSERT(statBuf.st_size == index.fileSize);
+
+   StringList names = listNames(index);
+
+   CPPUNIT_ASSERT(names.size() == numLeft);
+   CPPUNIT_ASSERT(names.front() ==
+      "name" + StringTk::uintToHexStr(0x1000 + numEntries - numLeft) );
+   CPPUNIT_ASSERT(names.back() == "name" + StringTk::uintToHexStr(0x1000 + numEntries - 1) );
+
+   // the compacted file is consistent, so it is loaded as is (a rebuild would bump the generation)
+
+   DentryIndex reloadedIndex(dentriesPath);
+
+   reloadedIndex.prepareUpdate();
+
+   CPPUNIT_ASSERT(reloadedIndex.generation == index.generation);
+   CPPUNIT_ASSERT(reloadedIndex.numLiveRecords == numLeft);
+   CPPUNIT_ASSERT(listNames(reloadedIndex) == names);
+
+   log.log(Log_DEBUG, "testCompaction finished");
+}
+
+/**
+ * The dentries dir was modified, but the index was not updated (e.g. crash between the two
+ * updates or modification by an older version), so the index must be rebuilt from the dentries.
+ */
+void TestDentryIndex::testRebuildAfterUnindexedChange()
+{
+   log.log(Log_DEBUG, "testRebuildAfterUnindexedChange started");
+
+   DentryIndex index(dentriesPath);
+
+   index.prepareUpdate();
+   createDentry("a");
+   index.addEntry("a", "ID-a", DirEntryType_DIRECTORY, 1);
+
+   index.prepareUpdate();
+   createDentry("b");
+   index.addEntry("b", "ID-b", DirEntryType_DIRECTORY, 1);
+
+   unsigned oldGeneration = index.generation;
+
+   StringList names = listNames(index);
+   names.sort();
+
+   CPPUNIT_ASSERT(names.size() == 2);
+   CPPUNIT_ASSERT(names.front() == "a");
+   CPPUNIT_ASSERT(names.back() == "b");
+   CPPUNIT_ASSERT(index.generation == oldGeneration);
+
+   // dentry updates without index updates
+
+   usleep(10000); // (make sure the dir mtime changes with coarse timestamps)
+
+   removeDentry("a");
+   createDentry("c");
+
+   // after a restart
+
+   DentryIndex reloadedIndex(dentriesPath);
+
+   names = listNames(reloadedIndex);
+   names.sort();
+
+   CPPUNIT_ASSERT(names.size() == 2);
+   CPPUNIT_ASSERT(names.front() == "b");
+   CPPUNIT_ASSERT(names.back() == "c");
+   CPPUNIT_ASSERT(reloadedIndex.generation != oldGeneration);
+
+   // in the running instance (detected by the dir mtime on next use)
+
+   names = listNames(index);
+   names.sort();
+
+   CPPUNIT_ASSERT(names.size() == 2);
+   CPPUNIT_ASSERT(names.front() == "b");
+   CPPUNIT_ASSERT(names.back() == "c");
+   CPPUNIT_ASSERT(index.generation != oldGeneration);
+
+   log.log(Log_DEBUG, "testRebuildAfterUnindexedChange finished");
+}
+
+/**
+ * The index file does not match its header (e.g. crash in the middle of an append or a
+ * compaction), so the index must be rebuilt from the dentries.
+ */
+void TestDentryIndex::testRebuildAfterIncompleteUpdate()
+{
+   log.log(Log_DEBUG, "testRebuildAfterIncompleteUpdate started");
+
+   createDentry("a");
+   createDentry("b");
+
+   std::string indexPath;
+   unsigned oldGeneration;
+
+   {
+      DentryIndex index(dentriesPath);
+
+      CPPUNIT_ASSERT(listNames(index).size() == 2);
+
+      indexPath = index.indexPath;
+      oldGeneration = index.generation;
+   }
+
+   // partial record at the end of the file (header not updated)
+
+   const char partialRecord[] = { 42, 0, 0, 0, DENTRYINDEX_RECORD_FLAG_LIVE };
+
+   int fd = open(indexPath.c_str(), O_WRONLY | O_APPEND);
+   CPPUNIT_ASSERT(fd != -1);
+   CPPUNIT_ASSERT(
+      write(fd, partialRecord, sizeof(partialRecord) ) == (ssize_t)sizeof(partialRecord) );
+   close(fd);
+
+   {
+      DentryIndex index(dentriesPath);
+
+      StringList names = listNames(index);
+      names.sort();
+
+      CPPUNIT_ASSERT(names.size() == 2);
+      CPPUNIT_ASSERT(names.front() == "a");
+      CPPUNIT_ASSERT(names.back() == "b");
+      CPPUNIT_ASSERT(index.generation != oldGeneration);
+      CPPUNIT_ASSERT(index.fileSize == DENTRYINDEX_HEADER_LEN +
+         2 * (DENTRYINDEX_RECORD_HEADER_LEN + 1 + strlen("ID-a") ) );
+
+      oldGeneration = index.generation;
+   }
+
+   // invalidated header (interrupted compaction or rebuild)
+
+   char headerBuf[DENTRYINDEX_HEADER_LEN];
+   struct timespec invalidMTime = { 0, 0 };
+
+   DentryIndex::serializeHeader(headerBuf, oldGeneration, 2, DENTRYINDEX_HEADER_LEN,
+      &invalidMTime);
+
+   fd = open(indexPath.c_str(), O_WRONLY);
+   CPPUNIT_ASSERT(fd != -1);
+   CPPUNIT_ASSERT(pwrite(fd, headerBuf, sizeof(headerBuf), 0) == (ssize_t)sizeof(headerBuf) );
+   close(fd);
+
+   {
+      DentryIndex index(dentriesPath);
+
+      CPPUNIT_ASSERT(listNames(index).size() == 2);
+      CPPUNIT_ASSERT(index.generation != oldGeneration);
+   }
+
+   log.log(Log_DEBUG, "testRebuildAfterIncompleteUpdate finished");
+}
+
+/**
+ * Create a (directory) dentry file in the dentries dir, as the DirEntryStore would.
+ */
+void TestDentryIndex::createDentry(const std::string& name)
+{
+   DirEntry entry(DirEntryType_DIRECTORY, name, "ID-" + name, 1);
+
+   CPPUNIT_ASSERT(entry.storeInitialDirEntry(dentriesPath) == FhgfsOpsErr_SUCCESS);
+}
+
+void TestDentryIndex::removeDentry(const std::string& name)
+{
+   std::string namePath = dentriesPath + "/" + name;
+
+   CPPUNIT_ASSERT(!unlink(namePath.c_str() ) );
+}
+
+/**
+ * @return names of all entries in the index in listing order (without the dots)
+ */
+StringList TestDentryIndex::listNames(DentryIndex& index)
+{
+   DentryIndexEntryList entries;
+   StringList names;
+
+   CPPUNIT_ASSERT(index.list(0, UINT_MAX, true, entries) );
+
+   for(DentryIndexEntryListIter iter = entries.begin(); iter != entries.end(); iter++)
+      names.push_back(iter->name);
+
+   return names;
+}
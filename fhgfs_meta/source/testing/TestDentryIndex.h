@@ -0,0 +1,43 @@
+#ifndef TESTDENTRYINDEX_H_
+#define TESTDENTRYINDEX_H_
+
+#include <common/app/log/LogContext.h>
+#include <storage/DentryIndex.h>
+#include <cppunit/TestAssert.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#define TESTDENTRYINDEX_DIR_TEMPLATE   "/tmp/beegfs-meta-test-dentryindex.XXXXXX"
+
+class TestDentryIndex: public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE( TestDentryIndex );
+   CPPUNIT_TEST( testRecordFormat );
+   CPPUNIT_TEST( testCompaction );
+   CPPUNIT_TEST( testRebuildAfterUnindexedChange );
+   CPPUNIT_TEST( testRebuildAfterIncompleteUpdate );
+   CPPUNIT_TEST_SUITE_END();
+
+   public:
+      TestDentryIndex();
+      virtual ~TestDentryIndex();
+
+      void setUp();
+      void tearDown();
+
+      void testRecordFormat();
+      void testCompaction();
+      void testRebuildAfterUnindexedChange();
+      void testRebuildAfterIncompleteUpdate();
+
+   private:
+      LogContext log;
+
+      std::string dentriesPath;
+
+      void createDentry(const std::string& name);
+      void removeDentry(const std::string& name);
+      StringList listNames(DentryIndex& index);
+};
+
+#endif /* TESTDENTRYINDEX_H_ */
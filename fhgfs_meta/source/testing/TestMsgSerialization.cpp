@@ -3,9 +3,14 @@
 #include <common/net/message/fsck/FsckModificationEventMsg.h>
 #include <common/net/message/nodes/HeartbeatRequestMsg.h>
 #include <common/net/message/nodes/HeartbeatMsg.h>
+#include <common/net/message/storage/attribs/GetChunkFileAttribsMultiMsg.h>
+#include <common/net/message/storage/attribs/GetChunkFileAttribsMultiRespMsg.h>
 #include <common/net/message/storage/creating/HardlinkMsg.h>
 #include <common/net/message/storage/creating/MkDirMsg.h>
+#include <common/net/message/storage/listing/ListDirPlusMsg.h>
+#include <common/net/message/storage/listing/ListDirPlusRespMsg.h>
 #include <common/net/message/session/opening/CloseChunkFileMsg.h>
+#include <common/net/message/session/LeaseRevokedMsg.h>
 
 TestMsgSerialization::TestMsgSerialization()
 {
@@ -188,3 +193,156 @@ void TestMsgSerialization::testHardlinkMsgSerialization()
 
 }
 
+
+void TestMsgSerialization::testLeaseRevokedMsgSerialization()
+{
+   log.log(Log_DEBUG, "testLeaseRevokedMsgSerialization started");
+
+   std::string entryID = "1A-2B-3C";
+   std::string ackID   = "1A-2B-3C-revoke";
+   uint16_t revokerNodeID = 42;
+
+   LeaseRevokedMsg msg(entryID, ackID, revokerNodeID);
+   LeaseRevokedMsg msgClone;
+
+   bool testRes = this->testMsgSerialization(msg, msgClone);
+
+   if (!testRes)
+      CPPUNIT_FAIL("Failed to serialize/deserialize LeaseRevokedMsg");
+
+   log.log(Log_DEBUG, "testLeaseRevokedMsgSerialization finished");
+}
+
+void TestMsgSerialization::testListDirPlusMsgSerialization()
+{
+   log.log(Log_DEBUG, "testListDirPlusMsgSerialization started");
+
+   EntryInfo dirInfo(123, "parentID", "dirID", "dirName", DirEntryType_DIRECTORY, 0);
+   int64_t serverOffset = 0x123456789LL;
+   unsigned maxOutNames = 50;
+
+   ListDirPlusMsg msg(&dirInfo, serverOffset, maxOutNames);
+   ListDirPlusMsg msgClone;
+
+   bool testRes = this->testMsgSerialization(msg, msgClone);
+
+   if (!testRes)
+      CPPUNIT_FAIL("Failed to serialize/deserialize ListDirPlusMsg");
+
+   log.log(Log_DEBUG, "testListDirPlusMsgSerialization finished");
+}
+
+void TestMsgSerialization::testListDirPlusRespMsgSerialization()
+{
+   log.log(Log_DEBUG, "testListDirPlusRespMsgSerialization started");
+
+   StringList names;
+   UInt8List entryTypes;
+   StringList entryIDs;
+   Int64List serverOffsets;
+   UInt16List ownerNodeIDs;
+   IntList entryFlags;
+   IntList statResults;
+   StatDataList statDatas;
+
+   for (unsigned i=0; i<9; i++)
+   {
+      SettableFileAttribs settableAttribs;
+
+      settableAttribs.mode = 0100644 + i;
+      settableAttribs.userID = 1000 + i;
+      settableAttribs.groupID = 2000 + i;
+      settableAttribs.modificationTimeSecs = 1400000000 + i;
+      settableAttribs.lastAccessTimeSecs = 1400000100 + i;
+
+      names.push_back("name" + StringTk::uintToStr(i) );
+      entryTypes.push_back(DirEntryType_REGULARFILE);
+      entryIDs.push_back("entryID" + StringTk::uintToStr(i) );
+      serverOffsets.push_back(100 + i);
+      ownerNodeIDs.push_back(1 + (i % 2) );
+      entryFlags.push_back(ENTRYINFO_FEATURE_INLINED);
+
+      // entries owned by another node are sent without valid stat data
+      statResults.push_back( (i % 2) ? FhgfsOpsErr_NOTOWNER : FhgfsOpsErr_SUCCESS);
+      statDatas.push_back(StatData(4096 * i, &settableAttribs, 1300000000, 1400000200 + i, 1,
+         0) );
+   }
+
+   ListDirPlusRespMsg msg(FhgfsOpsErr_SUCCESS, &names, &entryTypes, &entryIDs, &serverOffsets,
+      109, &ownerNodeIDs, &entryFlags, &statResults, &statDatas);
+   ListDirPlusRespMsg msgClone;
+
+   bool testRes = this->testMsgSerialization(msg, msgClone);
+
+   if (!testRes)
+      CPPUNIT_FAIL("Failed to serialize/deserialize ListDirPlusRespMsg");
+
+   log.log(Log_DEBUG, "testListDirPlusRespMsgSerialization finished");
+}
+
+void TestMsgSerialization::testGetChunkFileAttribsMultiMsgSerialization()
+{
+   log.log(Log_DEBUG, "testGetChunkFileAttribsMultiMsgSerialization started");
+
+   uint16_t targetID = 101;
+   StringList entryIDs;
+   PathInfoList pathInfos;
+
+   for (unsigned i=0; i<5; i++)
+   {
+      entryIDs.push_back("1A-2B-" + StringTk::uintToStr(i) );
+
+      // chunks with and without origParentUID/origParentEntryID path info
+      if (i % 2)
+         pathInfos.push_back(PathInfo(1000 + i, "origParent" + StringTk::uintToStr(i),
+            PATHINFO_FEATURE_ORIG) );
+      else
+         pathInfos.push_back(PathInfo(0, "", 0) );
+   }
+
+   GetChunkFileAttribsMultiMsg msg(targetID, &entryIDs, &pathInfos);
+   GetChunkFileAttribsMultiMsg msgClone;
+
+   msg.addMsgHeaderFeatureFlag(GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR);
+
+   bool testRes = this->testMsgSerialization(msg, msgClone);
+
+   if (!testRes)
+      CPPUNIT_FAIL("Failed to serialize/deserialize GetChunkFileAttribsMultiMsg");
+
+   log.log(Log_DEBUG, "testGetChunkFileAttribsMultiMsgSerialization finished");
+}
+
+void TestMsgSerialization::testGetChunkFileAttribsMultiRespMsgSerialization()
+{
+   log.log(Log_DEBUG, "testGetChunkFileAttribsMultiRespMsgSerialization started");
+
+   IntList results;
+   DynamicFileAttribsVec dynAttribsVec;
+
+   for (unsigned i=0; i<5; i++)
+   {
+      // failed entries are sent with invalid attribs
+      if (i == 3)
+      {
+         results.push_back(FhgfsOpsErr_PATHNOTEXISTS);
+         dynAttribsVec.push_back(DynamicFileAttribs(0, 0, 0, 0, 0) );
+      }
+      else
+      {
+         results.push_back(FhgfsOpsErr_SUCCESS);
+         dynAttribsVec.push_back(DynamicFileAttribs(i + 1, 0x100000000LL * i, 8 * i,
+            1400000000 + i, 1400000100 + i) );
+      }
+   }
+
+   GetChunkFileAttribsMultiRespMsg msg(&results, &dynAttribsVec);
+   GetChunkFileAttribsMultiRespMsg msgClone;
+
+   bool testRes = this->testMsgSerialization(msg, msgClone);
+
+   if (!testRes)
+      CPPUNIT_FAIL("Failed to serialize/deserialize GetChunkFileAttribsMultiRespMsg");
+
+   log.log(Log_DEBUG, "testGetChunkFileAttribsMultiRespMsgSerialization finished");
+}
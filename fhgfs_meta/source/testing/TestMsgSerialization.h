@@ -20,6 +20,11 @@ class TestMsgSerialization: public TestMsgSerializationBase
    CPPUNIT_TEST( testCloseChunkFileMsgSerialization );
    CPPUNIT_TEST( testCloseChunkFileMsgSerializationHsm );
    CPPUNIT_TEST( testHardlinkMsgSerialization );
+   CPPUNIT_TEST( testLeaseRevokedMsgSerialization );
+   CPPUNIT_TEST( testListDirPlusMsgSerialization );
+   CPPUNIT_TEST( testListDirPlusRespMsgSerialization );
+   CPPUNIT_TEST( testGetChunkFileAttribsMultiMsgSerialization );
+   CPPUNIT_TEST( testGetChunkFileAttribsMultiRespMsgSerialization );
    CPPUNIT_TEST_SUITE_END();
 
    public:
@@ -34,6 +39,11 @@ class TestMsgSerialization: public TestMsgSerializationBase
       void testCloseChunkFileMsgSerialization();
       void testCloseChunkFileMsgSerializationHsm();
       void testHardlinkMsgSerialization();
+      void testLeaseRevokedMsgSerialization();
+      void testListDirPlusMsgSerialization();
+      void testListDirPlusRespMsgSerialization();
+      void testGetChunkFileAttribsMultiMsgSerialization();
+      void testGetChunkFileAttribsMultiRespMsgSerialization();
 
    private:
       LogContext log;
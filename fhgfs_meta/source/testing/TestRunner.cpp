@@ -2,6 +2,7 @@
 
 #include "TestCommunication.h"
 #include "TestConfig.h"
+#include "TestDentryIndex.h"
 #include "TestSerialization.h"
 #include "TestMsgSerialization.h"
 
@@ -44,6 +45,7 @@ bool TestRunner::addTests()
       this->testRunner.addTest(TestConfig::suite());
       this->testRunner.addTest(TestSerialization::suite());
       this->testRunner.addTest(TestMsgSerialization::suite());
+      this->testRunner.addTest(TestDentryIndex::suite());
       //this->testRunner.addTest(TestCommunication::suite()); // test not working
       // this->testRunner.addTest(TestRWLock::suite()); // commented out because of long runtime
       this->testRunner.addTest(TestUnitTk::suite());
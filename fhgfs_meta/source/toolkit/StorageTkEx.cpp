@@ -1,3 +1,4 @@
+#include <components/metajournal/MetaJournal.h>
 #include <program/Program.h>
 #include "StorageTkEx.h"
 
@@ -192,6 +193,8 @@ DirEntryType StorageTkEx::readInodeFromFileXAttrUnlocked(std::string& metaFilena
 
    char *buf = (char*) malloc(META_SERBUF_SIZE);
 
+   MetaJournal::flushFileStatic(metaFilename);
+
    ssize_t getRes = getxattr(metaFilename.c_str(), META_XATTR_NAME, buf, META_SERBUF_SIZE);
 
    if ( getRes > 0 )
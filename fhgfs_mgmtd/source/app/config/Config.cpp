@@ -89,6 +89,7 @@ void Config::loadDefaults(bool addDashes)
    configMapRedefine("quotaNotfificationIntervalMin",   "360");
    configMapRedefine("quotaAdminEmailAddress",          "");
    configMapRedefine("quotaUpdateIntervalMin",          "10");
+   configMapRedefine("quotaFullUpdateIntervalMin",      "0");
    configMapRedefine("quotaStoreIntervalMin",           "10");
    configMapRedefine("quotaQueryType",                  MGMT_QUOTA_QUERY_TYPE_SYSTEM_STR);
    configMapRedefine("quotaQueryUIDFile",               "");
@@ -265,6 +266,9 @@ void Config::applyConfigMap(bool enableException, bool addDashes) throw(InvalidC
       if(iter->first == std::string("quotaUpdateIntervalMin") )
          quotaUpdateIntervalMin = StringTk::strToUInt(iter->second);
       else
+      if(iter->first == std::string("quotaFullUpdateIntervalMin") )
+         quotaFullUpdateIntervalMin = StringTk::strToUInt(iter->second);
+      else
       if(iter->first == std::string("quotaStoreIntervalMin") )
          quotaStoreIntervalMin = StringTk::strToUInt(iter->second);
       else
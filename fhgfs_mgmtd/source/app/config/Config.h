@@ -107,6 +107,7 @@ class Config : public AbstractConfig
       unsigned             quotaNotfificationIntervalMin;
       std::string          quotaAdminEmailAddress;
       unsigned             quotaUpdateIntervalMin;
+      unsigned             quotaFullUpdateIntervalMin;
       unsigned             quotaStoreIntervalMin;
       std::string          quotaQueryType;
       MgmtQuotaQueryType   quotaQueryTypeNum;       // auto-generated based on quotaQueryType
@@ -382,6 +383,11 @@ class Config : public AbstractConfig
          return quotaUpdateIntervalMin;
       }
 
+      unsigned getQuotaFullUpdateIntervalMin() const
+      {
+         return quotaFullUpdateIntervalMin;
+      }
+
       unsigned getQuotaStoreIntervalMin() const
       {
          return quotaStoreIntervalMin;
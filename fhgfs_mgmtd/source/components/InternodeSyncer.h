@@ -93,6 +93,18 @@ class InternodeSyncer : public PThread
          return retVal;
       }
 
+      /**
+       * Get a copy of the latest capacity reports of the storage targets.
+       */
+      void getTargetCapacityReports(TargetCapacityReportMap& outReports)
+      {
+         SafeRWLock safeLock(&targetCapacityReportMapLock, SafeRWLock_READ); // L O C K
+
+         outReports = targetCapacityReportMap;
+
+         safeLock.unlock(); // U N L O C K
+      }
+
       /**
        * Take the elements of a StorageTargetInfoList and stores them in the local
        * target/nodeCapacityReportsMap as TargetCapacityReport objects.
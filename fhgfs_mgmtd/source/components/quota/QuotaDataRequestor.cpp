@@ -10,11 +10,13 @@
  * @param outQuotaResultsRWLock the lock for outQuotaData
  * @param isStoreDirty is set to true if some data are changed in the given map and the quota data
  *                     needs to be stored on the hard-drives
+ * @param outUpdatedTargetNumIDs may be NULL, the targets with successfully updated quota data will
+ *                     be added to this set
  *
  * @return true if the quota data successful collected from the storage servers
  */
 bool QuotaDataRequestor::requestQuota(QuotaDataMapForTarget* outQuotaData,
-   RWLock* outQuotaResultsRWLock, bool* isStoreDirty)
+   RWLock* outQuotaResultsRWLock, bool* isStoreDirty, UInt16Set* outUpdatedTargetNumIDs)
 {
    App* app = Program::getApp();
    NodeStoreServers* mgmtNodes = app->getMgmtNodes();
@@ -50,6 +52,13 @@ bool QuotaDataRequestor::requestQuota(QuotaDataMapForTarget* outQuotaData,
 
    mgmtNodes->releaseNode(&mgmtNode);
 
+   // (targets with errors were removed from the results)
+   if(outUpdatedTargetNumIDs)
+   {
+      for(QuotaDataMapForTargetIter iter = tmpQuotaData.begin(); iter != tmpQuotaData.end(); iter++)
+         outUpdatedTargetNumIDs->insert(iter->first);
+   }
+
    SafeRWLock lock(outQuotaResultsRWLock, SafeRWLock_WRITE);                  // W R I T E L O C K
 
    updateQuotaDataWithResponse(&tmpQuotaData, outQuotaData, mapper);
@@ -80,7 +80,7 @@ class QuotaDataRequestor : public GetQuotaInfo
       }
 
       bool requestQuota(QuotaDataMapForTarget* outQuotaData, RWLock* outQuotaResultsRWLock,
-         bool* isStoreDirty);
+         bool* isStoreDirty, UInt16Set* outUpdatedTargetNumIDs = NULL);
 
       /**
        * Updates the the targetID of the target to query. In this case only this target will be
@@ -94,6 +94,17 @@ class QuotaDataRequestor : public GetQuotaInfo
          this->cfg.cfgTargetNumID = targetNumID;
       }
 
+      /**
+       * Restricts the query to the given targets, the quota data of all other targets will be
+       * kept unchanged.
+       *
+       * @param targetNumIDs The targetNumIDs to query, must not be empty.
+       */
+      void setTargetNumIDs(const UInt16Set& targetNumIDs)
+      {
+         this->cfg.cfgTargetNumIDs = targetNumIDs;
+      }
+
    private:
       MultiWorkQueue& workQueue;
 
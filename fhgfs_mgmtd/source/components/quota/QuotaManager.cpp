@@ -114,11 +114,14 @@ void QuotaManager::requestLoop()
    const int sleepIntervalMS = 5*1000; // 5sec
 
    const unsigned updateQuotaUsageMS = cfg->getQuotaUpdateIntervalMin()*60*1000; // min to millisec
+   const unsigned fullUpdateQuotaUsageMS =
+      cfg->getQuotaFullUpdateIntervalMin()*60*1000; // min to millisec
    const unsigned saveQuotaDataMS = cfg->getQuotaStoreIntervalMin()*60*1000; // min to millisec
 
    bool firstUpdate = true;
 
    Time lastQuotaUsageUpdateT;
+   Time lastQuotaUsageFullUpdateT;
    Time lastQuotaDataSaveT;
 
    while(!waitForSelfTerminateOrder(sleepIntervalMS) )
@@ -139,11 +142,18 @@ void QuotaManager::requestLoop()
 
          if(doUpdate)
          {
-            updateUsedQuota(uidList, gidList);
+            // (if full updates are not enabled, every update is a full update)
+            bool fullUpdate = firstUpdate || !fullUpdateQuotaUsageMS ||
+               (lastQuotaUsageFullUpdateT.elapsedMS() > fullUpdateQuotaUsageMS);
+
+            updateUsedQuota(uidList, gidList, fullUpdate);
             calculateExceededQuota(uidList, gidList);
             limitChanged.compareAndSet(0, 1); // reset flag for updated limits
             pushExceededQuotaIDs();
             lastQuotaUsageUpdateT.setToNow();
+
+            if(fullUpdate)
+               lastQuotaUsageFullUpdateT.setToNow();
          }
       }
       else if(limitChanged.compareAndSet(0, 1) )
@@ -196,6 +206,8 @@ void QuotaManager::removeTargetFromQuotaDataStores(uint16_t targetNumID)
       this->usedQuotaUserStoreDirty = true;
    }
 
+   this->usedQuotaUserCapacities.erase(targetNumID);
+
    lockUser.unlock();                                                            // U N L O C K
 
 
@@ -208,6 +220,8 @@ void QuotaManager::removeTargetFromQuotaDataStores(uint16_t targetNumID)
       this->usedQuotaGroupStoreDirty = true;
    }
 
+   this->usedQuotaGroupCapacities.erase(targetNumID);
+
    lockGroup.unlock();                                                           // U N L O C K
 }
 
@@ -239,13 +253,23 @@ bool QuotaManager::updateQuotaLimits(QuotaDataList* list)
  *
  * @param uidList A list with the UIDs to update, contains values if the IDs are provided by a file.
  * @param gidList A list with the GIDs to update, contains values if the IDs are provided by a file.
+ * @param fullUpdate False to query only the targets with changed capacity since their last
+ *        update.
  */
-bool QuotaManager::updateUsedQuota(UIntList& uidList, UIntList& gidList)
+bool QuotaManager::updateUsedQuota(UIntList& uidList, UIntList& gidList, bool fullUpdate)
 {
    bool retValUser = false;
    bool retValGroup = false;
 
-   Config* cfg = Program::getApp()->getConfig();
+   App* app = Program::getApp();
+   Config* cfg = app->getConfig();
+
+   // (must be taken before the requests to notice changes during the requests at the next update)
+   TargetCapacityReportMap currentCapacities;
+   app->getInternodeSyncer()->getTargetCapacityReports(currentCapacities);
+
+   UInt16Set updatedTargetsUser;
+   UInt16Set updatedTargetsGroup;
 
    QuotaDataRequestor* requestorUser;
    QuotaDataRequestor* requestorGroup;
@@ -273,15 +297,57 @@ bool QuotaManager::updateUsedQuota(UIntList& uidList, UIntList& gidList)
    }
 
 
-   retValUser = requestorUser->requestQuota(this->usedQuotaUser, &this->usedQuotaUserRWLock,
-      &this->usedQuotaUserStoreDirty);
+   if(fullUpdate)
+   {
+      retValUser = requestorUser->requestQuota(this->usedQuotaUser, &this->usedQuotaUserRWLock,
+         &this->usedQuotaUserStoreDirty, &updatedTargetsUser);
+   }
+   else
+   { // incremental update => only query the targets with changed capacity
+      UInt16Set changedTargets;
+      getChangedTargets(currentCapacities, &this->usedQuotaUserCapacities,
+         &this->usedQuotaUserRWLock, changedTargets);
+
+      requestorUser->setTargetNumIDs(changedTargets);
+
+      retValUser = changedTargets.empty() ||
+         requestorUser->requestQuota(this->usedQuotaUser, &this->usedQuotaUserRWLock,
+            &this->usedQuotaUserStoreDirty, &updatedTargetsUser);
+
+      LOG_DEBUG_CONTEXT(log, Log_DEBUG, "Incremental user quota update. Changed targets: " +
+         StringTk::uintToStr(changedTargets.size() ) );
+   }
+
+   updateTargetCapacities(currentCapacities, updatedTargetsUser, &this->usedQuotaUserCapacities,
+      &this->usedQuotaUserRWLock);
 
    if (!retValUser)
       log.log(Log_ERR, "Could not update user quota data.");
 
 
-   retValGroup = requestorGroup->requestQuota(this->usedQuotaGroup, &this->usedQuotaGroupRWLock,
-      &this->usedQuotaGroupStoreDirty);
+   if(fullUpdate)
+   {
+      retValGroup = requestorGroup->requestQuota(this->usedQuotaGroup, &this->usedQuotaGroupRWLock,
+         &this->usedQuotaGroupStoreDirty, &updatedTargetsGroup);
+   }
+   else
+   { // incremental update => only query the targets with changed capacity
+      UInt16Set changedTargets;
+      getChangedTargets(currentCapacities, &this->usedQuotaGroupCapacities,
+         &this->usedQuotaGroupRWLock, changedTargets);
+
+      requestorGroup->setTargetNumIDs(changedTargets);
+
+      retValGroup = changedTargets.empty() ||
+         requestorGroup->requestQuota(this->usedQuotaGroup, &this->usedQuotaGroupRWLock,
+            &this->usedQuotaGroupStoreDirty, &updatedTargetsGroup);
+
+      LOG_DEBUG_CONTEXT(log, Log_DEBUG, "Incremental group quota update. Changed targets: " +
+         StringTk::uintToStr(changedTargets.size() ) );
+   }
+
+   updateTargetCapacities(currentCapacities, updatedTargetsGroup, &this->usedQuotaGroupCapacities,
+      &this->usedQuotaGroupRWLock);
 
    if (!retValGroup)
       log.log(Log_ERR, "Could not update group quota data.");
@@ -292,6 +358,67 @@ bool QuotaManager::updateUsedQuota(UIntList& uidList, UIntList& gidList)
    return (retValUser && retValGroup);
 }
 
+/**
+ * Finds the targets, which need a quota update because their used disk space or inodes changed
+ * since their last quota update (or because they were never updated).
+ *
+ * @param currentCapacities The current capacity reports of the targets.
+ * @param lastCapacities The capacity reports of the targets at their last quota update.
+ * @param lastCapacitiesRWLock The lock for lastCapacities.
+ * @param outTargetNumIDs The targets which need a quota update.
+ */
+void QuotaManager::getChangedTargets(TargetCapacityReportMap& currentCapacities,
+   TargetCapacityReportMap* lastCapacities, RWLock* lastCapacitiesRWLock,
+   UInt16Set& outTargetNumIDs)
+{
+   UInt16List targetNumIDs;
+   UInt16List nodeNumIDs;
+   Program::getApp()->getTargetMapper()->getMappingAsLists(targetNumIDs, nodeNumIDs);
+
+   SafeRWLock lock(lastCapacitiesRWLock, SafeRWLock_READ);                    // R E A D L O C K
+
+   for(UInt16ListIter iter = targetNumIDs.begin(); iter != targetNumIDs.end(); iter++)
+   {
+      TargetCapacityReportMapIter currentIter = currentCapacities.find(*iter);
+      TargetCapacityReportMapIter lastIter = lastCapacities->find(*iter);
+
+      if( (currentIter == currentCapacities.end() ) || (lastIter == lastCapacities->end() ) ||
+         (currentIter->second.diskSpaceFree != lastIter->second.diskSpaceFree) ||
+         (currentIter->second.inodesFree != lastIter->second.inodesFree) )
+         outTargetNumIDs.insert(*iter);
+   }
+
+   lock.unlock();                                                             // U N L O C K
+}
+
+/**
+ * Remembers the capacity reports of the targets with successfully updated quota data, so that
+ * the next incremental update can skip them if their capacity didn't change.
+ *
+ * @param currentCapacities The capacity reports of the targets before the quota update.
+ * @param updatedTargetNumIDs The targets with successfully updated quota data.
+ * @param outLastCapacities The capacity reports of the targets at their last quota update.
+ * @param lastCapacitiesRWLock The lock for outLastCapacities.
+ */
+void QuotaManager::updateTargetCapacities(TargetCapacityReportMap& currentCapacities,
+   UInt16Set& updatedTargetNumIDs, TargetCapacityReportMap* outLastCapacities,
+   RWLock* lastCapacitiesRWLock)
+{
+   SafeRWLock lock(lastCapacitiesRWLock, SafeRWLock_WRITE);                   // W R I T E L O C K
+
+   for(UInt16SetIter iter = updatedTargetNumIDs.begin(); iter != updatedTargetNumIDs.end(); iter++)
+   {
+      TargetCapacityReportMapIter currentIter = currentCapacities.find(*iter);
+
+      if(currentIter != currentCapacities.end() )
+         (*outLastCapacities)[*iter] = currentIter->second;
+      else
+         outLastCapacities->erase(*iter); // no capacity report => always query this target
+   }
+
+   lock.unlock();                                                             // U N L O C K
+}
+
 /**
  * Calculates the IDs with exceeded quota and stores the IDs in the exceeded quota store.
  *
@@ -10,6 +10,7 @@
 #include <common/Common.h>
 #include <components/quota/QuotaDataRequestor.h>
 #include <components/quota/QuotaStoreLimits.h>
+#include <nodes/TargetCapacityReport.h>
 
 
 /**
@@ -43,6 +44,10 @@ class QuotaManager : public PThread
       bool usedQuotaUserStoreDirty;
       bool usedQuotaGroupStoreDirty;
 
+      // capacity reports of the targets at their last quota update (protected by the RWLocks above)
+      TargetCapacityReportMap usedQuotaUserCapacities;
+      TargetCapacityReportMap usedQuotaGroupCapacities;
+
       QuotaStoreLimits* quotaUserLimits;
       QuotaStoreLimits* quotaGroupLimits;
 
@@ -58,7 +63,13 @@ class QuotaManager : public PThread
 
       void requestLoop();
 
-      bool updateUsedQuota(UIntList& uidList, UIntList& gidList);
+      bool updateUsedQuota(UIntList& uidList, UIntList& gidList, bool fullUpdate);
+      void getChangedTargets(TargetCapacityReportMap& currentCapacities,
+         TargetCapacityReportMap* lastCapacities, RWLock* lastCapacitiesRWLock,
+         UInt16Set& outTargetNumIDs);
+      void updateTargetCapacities(TargetCapacityReportMap& currentCapacities,
+         UInt16Set& updatedTargetNumIDs, TargetCapacityReportMap* outLastCapacities,
+         RWLock* lastCapacitiesRWLock);
       bool collectQuotaDataFromServer();
       void calculateExceededQuota(UIntList& uidList, UIntList& gidList);
       bool isQuotaExceededForIDunlocked(unsigned id, QuotaLimitType limitType,
@@ -58,6 +58,8 @@ void MgmtdTargetStateStore::setConsistencyStatesFromLists(const UInt16List& targ
       if (setOnline)
          targetState.lastChangedTime.setToNow();
       // Note: If setOnline is false, we let the timer run out so the target can be POFFLINEd.
+
+      publishStateUnlocked(targetID);
    }
 
    lock.unlock(); // U N L O C K
@@ -139,6 +141,8 @@ FhgfsOpsErr MgmtdTargetStateStore::changeConsistencyStatesFromLists(const UInt16
 
             targetsToResyncUpdate(newConsistencyState, targetID);
 
+            publishStateUnlocked(targetID);
+
             statesChanged = true;
          }
 
@@ -250,6 +254,7 @@ bool MgmtdTargetStateStore::autoOfflineTargets(const unsigned pofflineTimeoutMS,
             offlinedTargets.push_back(targetID);
 
             targetStateInfo.reachabilityState = TargetReachabilityState_OFFLINE;
+            publishStateUnlocked(targetID);
             retVal = true;
          }
       }
@@ -265,6 +270,7 @@ bool MgmtdTargetStateStore::autoOfflineTargets(const unsigned pofflineTimeoutMS,
                nodeTypeStr(true) + " ID: " + StringTk::uintToStr(targetID) );
 
             targetStateInfo.reachabilityState = TargetReachabilityState_POFFLINE;
+            publishStateUnlocked(targetID);
             retVal = true;
          }
       }
@@ -576,6 +582,7 @@ bool MgmtdTargetStateStore::loadStates()
    SafeRWLock lock(&rwlock, SafeRWLock_WRITE);
    tmpMap.swap(statesMap);
    setAllStatesUnlocked(TargetReachabilityState_POFFLINE);
+   publishStatesUnlocked(tmpMap); // (tmpMap contains the old states now)
    lock.unlock();
 
    return true;
@@ -102,6 +102,7 @@ class MgmtdTargetStateStore : public TargetStateStore
          else
          {
             iter->second.consistencyState = state;
+            publishStateUnlocked(targetID);
             res = true;
          }
 
@@ -188,7 +188,6 @@ bool ModeDisposeUnusedFiles::getAndHandleFiles(Node* node)
 
    FhgfsOpsErr listRes = FhgfsOpsErr_SUCCESS;
    unsigned maxOutNames = 50;
-   StringList entryNames;
    uint64_t currentServerOffset = 0;
 
    do
@@ -225,13 +224,11 @@ bool ModeDisposeUnusedFiles::getAndHandleFiles(Node* node)
          goto err_cleanup;
       }
 
-      entryNames.clear();
-      respMsgCast->parseNames(&entryNames);
-
-      numEntriesThisRound = entryNames.size();
+      numEntriesThisRound = respMsgCast->getNumEntries();
       currentServerOffset = respMsgCast->getNewServerOffset();
 
-      handleEntries(node, entryNames);
+      // (the names point into respBuf, so they are handled before it is freed below)
+      handleEntries(node, respMsgCast->getNamesView() );
 
       numEntriesReceived += numEntriesThisRound;
 
@@ -259,22 +256,23 @@ bool ModeDisposeUnusedFiles::getAndHandleFiles(Node* node)
 /**
  * Handle received entries (e.g. print, unlink)
  */
-void ModeDisposeUnusedFiles::handleEntries(Node* node, StringList& entryNames)
+void ModeDisposeUnusedFiles::handleEntries(Node* node, const SerializedStrList& entryNames)
 {
-   for(StringListIter iter = entryNames.begin(); iter != entryNames.end(); iter++)
-   {
-      std::string entry = *iter;
+   SerializedStrList::Iter iter = entryNames.begin();
+   SerializedStr entry;
 
+   while(iter.next(&entry) )
+   {
       if(cfgPrintFiles)
       {
          if(cfgPrintNodes) // indent
-            std::cout << NODEINFO_INDENTATION_STR << entry << std::endl;
+            std::cout << NODEINFO_INDENTATION_STR << entry.c_str() << std::endl;
          else
-            std::cout << entry << std::endl;
+            std::cout << entry.c_str() << std::endl;
       }
 
       if(cfgUnlinkFiles)
-         unlinkEntry(node, entry);
+         unlinkEntry(node, entry.str() );
    }
 }
 
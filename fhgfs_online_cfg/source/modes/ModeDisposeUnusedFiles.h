@@ -4,6 +4,7 @@
 
 #include <common/Common.h>
 #include <common/nodes/NodeStoreServers.h>
+#include <common/toolkit/serialization/SerializedStr.h>
 #include "Mode.h"
 
 
@@ -39,7 +40,7 @@ class ModeDisposeUnusedFiles : public Mode
       bool readConfig();
       void handleNodes(NodeStoreServers* metaNodes);
       bool getAndHandleFiles(Node* ownerNode);
-      void handleEntries(Node* node, StringList& entryNames);
+      void handleEntries(Node* node, const SerializedStrList& entryNames);
       bool unlinkEntry(Node* node, std::string entryName);
 };
 
@@ -11,6 +11,12 @@
 
 
 #define STORAGEBENCH_PERFORMANCE_UNIT                " KiB/s"
+#define STORAGEBENCH_PERFORMANCE_UNIT_CREATE         " files/s"
+#define STORAGEBENCH_LATENCY_UNIT                    " us"
+
+#define MODESTORAGEBENCH_ONLY_ONE_ACTION_STR \
+   "Only one of --read, --write, --randread, --randwrite, --randmixed, --create, --stop, " \
+   "--status or --cleanup is allowed."
 
 //the arguments of the storage benchmark
 #define MODESTORAGEBENCH_ARG_TARGET_IDS              "--targetids"
@@ -18,6 +24,11 @@
 #define MODESTORAGEBENCH_ARG_SERVER                  "--servers"
 #define MODESTORAGEBENCH_ARG_TYPE_READ               "--read"
 #define MODESTORAGEBENCH_ARG_TYPE_WRITE              "--write"
+#define MODESTORAGEBENCH_ARG_TYPE_RANDREAD           "--randread"
+#define MODESTORAGEBENCH_ARG_TYPE_RANDWRITE          "--randwrite"
+#define MODESTORAGEBENCH_ARG_TYPE_RANDMIXED          "--randmixed"
+#define MODESTORAGEBENCH_ARG_TYPE_CREATE             "--create"
+#define MODESTORAGEBENCH_ARG_READ_PERCENT            "--readpercent"
 #define MODESTORAGEBENCH_ARG_BLOCK_SIZE              "--blocksize"
 #define MODESTORAGEBENCH_ARG_SIZE                    "--size"
 #define MODESTORAGEBENCH_ARG_ACTION_STOP             "--stop"
@@ -201,8 +212,7 @@ int ModeStorageBench::checkConfig(Node* mgmtNode, NodeStoreServers* storageNodes
       }
       else
       {
-         std::cerr << "Invalid configuration. Only one of --read, --write, --stop, --status or "
-            "--cleanup is allowed." << std::endl;
+         std::cerr << "Invalid configuration. " MODESTORAGEBENCH_ONLY_ONE_ACTION_STR << std::endl;
          return APPCODE_INVALID_CONFIG;
       }
    }
@@ -218,8 +228,7 @@ int ModeStorageBench::checkConfig(Node* mgmtNode, NodeStoreServers* storageNodes
       }
       else
       {
-         std::cerr << "Invalid configuration. Only one of --read, --write, --stop, --status or "
-            "--cleanup is allowed." << std::endl;
+         std::cerr << "Invalid configuration. " MODESTORAGEBENCH_ONLY_ONE_ACTION_STR << std::endl;
          return APPCODE_INVALID_CONFIG;
       }
    }
@@ -235,53 +244,31 @@ int ModeStorageBench::checkConfig(Node* mgmtNode, NodeStoreServers* storageNodes
       }
       else
       {
-         std::cerr << "Invalid configuration. Only one of --read, --write, --stop, --status or "
-            "--cleanup is allowed." << std::endl;
-         return APPCODE_INVALID_CONFIG;
-      }
-   }
-
-   // parse type argument read
-   iter = cfg->find(MODESTORAGEBENCH_ARG_TYPE_READ);
-   if(iter != cfg->end() )
-   {
-      if (this->cfgType == StorageBenchType_NONE && this->cfgAction == StorageBenchAction_NONE)
-      {
-         this->cfgType = StorageBenchType_READ;
-         this->cfgAction = StorageBenchAction_START;
-         cfg->erase(iter);
-      }
-      else
-      {
-         std::cerr << "Invalid configuration. Only one of --read, --write, --stop, --status or "
-            "--cleanup is allowed." << std::endl;
+         std::cerr << "Invalid configuration. " MODESTORAGEBENCH_ONLY_ONE_ACTION_STR << std::endl;
          return APPCODE_INVALID_CONFIG;
       }
    }
 
-   // parse type argument write
-   iter = cfg->find(MODESTORAGEBENCH_ARG_TYPE_WRITE);
-   if(iter != cfg->end() )
-   {
-      if (this->cfgType == StorageBenchType_NONE && this->cfgAction == StorageBenchAction_NONE)
-      {
-         this->cfgType = StorageBenchType_WRITE;
-         this->cfgAction = StorageBenchAction_START;
-         cfg->erase(iter);
-      }
-      else
-      {
-         std::cerr << "Invalid configuration. Only one of --read, --write, --stop, --status or "
-            "--cleanup is allowed." << std::endl;
-         return APPCODE_INVALID_CONFIG;
-      }
-   }
+   // parse type arguments
+   if( (parseTypeArg(cfg, MODESTORAGEBENCH_ARG_TYPE_READ, StorageBenchType_READ) !=
+         APPCODE_NO_ERROR) ||
+       (parseTypeArg(cfg, MODESTORAGEBENCH_ARG_TYPE_WRITE, StorageBenchType_WRITE) !=
+         APPCODE_NO_ERROR) ||
+       (parseTypeArg(cfg, MODESTORAGEBENCH_ARG_TYPE_RANDREAD, StorageBenchType_RANDREAD) !=
+         APPCODE_NO_ERROR) ||
+       (parseTypeArg(cfg, MODESTORAGEBENCH_ARG_TYPE_RANDWRITE, StorageBenchType_RANDWRITE) !=
+         APPCODE_NO_ERROR) ||
+       (parseTypeArg(cfg, MODESTORAGEBENCH_ARG_TYPE_RANDMIXED, StorageBenchType_RANDMIXED) !=
+         APPCODE_NO_ERROR) ||
+       (parseTypeArg(cfg, MODESTORAGEBENCH_ARG_TYPE_CREATE, StorageBenchType_CREATE) !=
+         APPCODE_NO_ERROR) )
+      return APPCODE_INVALID_CONFIG;
 
    // check if one action argument was set
    if (this->cfgAction == StorageBenchAction_NONE || this->cfgAction == StorageBenchAction_NONE)
    {
-      std::cerr << "Invalid configuration. One of --read, --write, --stop, --status or "
-         "--cleanup is required." << std::endl;
+      std::cerr << "Invalid configuration. One of --read, --write, --randread, --randwrite, "
+         "--randmixed, --create, --stop, --status or --cleanup is required." << std::endl;
       return APPCODE_INVALID_CONFIG;
    }
 
@@ -447,6 +434,28 @@ int ModeStorageBench::checkConfig(Node* mgmtNode, NodeStoreServers* storageNodes
       cfg->erase(iter);
    }
 
+   // parse read percentage argument
+   iter = cfg->find(MODESTORAGEBENCH_ARG_READ_PERCENT);
+   if( (iter != cfg->end()) && (!iter->second.empty()) )
+   {
+      if(this->cfgType != StorageBenchType_RANDMIXED)
+      {
+         std::cerr << "Invalid configuration. The --readpercent option is only allowed with "
+            "--randmixed." << std::endl;
+         return APPCODE_INVALID_CONFIG;
+      }
+
+      this->cfgReadPercent = StringTk::strToInt(iter->second);
+      cfg->erase(iter);
+
+      if( (this->cfgReadPercent < 0) || (this->cfgReadPercent > 100) )
+      {
+         std::cerr << "Invalid configuration. The --readpercent option must be between 0 and "
+            "100." << std::endl;
+         return APPCODE_INVALID_CONFIG;
+      }
+   }
+
    // check if the required arguments are given or default values available
    if( (this->cfgAction == StorageBenchAction_START) &&
       ((this->cfgBlocksize == 0) || (this->cfgSize == 0) || (this->cfgThreads == 0)) )
@@ -491,6 +500,36 @@ int ModeStorageBench::checkConfig(Node* mgmtNode, NodeStoreServers* storageNodes
    return retVal;
 }
 
+/*
+ * checks if the given benchmark type argument is set and sets the type and the start action
+ *
+ * @param cfg a string map with all arguments from the command line
+ * @param argName the name of the type argument
+ * @param type the benchmark type that belongs to the argument
+ * @return the error code (APPCODE_...)
+ *
+ */
+int ModeStorageBench::parseTypeArg(StringMap* cfg, const char* argName, StorageBenchType type)
+{
+   StringMapIter iter = cfg->find(argName);
+   if(iter == cfg->end() )
+      return APPCODE_NO_ERROR;
+
+   if (this->cfgType == StorageBenchType_NONE && this->cfgAction == StorageBenchAction_NONE)
+   {
+      this->cfgType = type;
+      this->cfgAction = StorageBenchAction_START;
+      cfg->erase(iter);
+   }
+   else
+   {
+      std::cerr << "Invalid configuration. " MODESTORAGEBENCH_ONLY_ONE_ACTION_STR << std::endl;
+      return APPCODE_INVALID_CONFIG;
+   }
+
+   return APPCODE_NO_ERROR;
+}
+
 /*
  * prints some results: fastest and slowest target, average throughput, throughput over all targets
  *
@@ -517,6 +556,10 @@ void ModeStorageBench::printShortResults(StorageBenchResponseInfoList* responses
    int64_t maxPerformance = 0;
    int64_t storageTargetCount = 0;
 
+   StorageBenchLatencyResult maxLatencies; // the highest percentiles of all targets
+
+   const char* unit = getPerformanceUnit(responses->front().type);
+
    for (StorageBenchResponseInfoListIter iter = responses->begin(); iter != responses->end();
       iter++)
    {
@@ -546,6 +589,17 @@ void ModeStorageBench::printShortResults(StorageBenchResponseInfoList* responses
                slowestNodeIDStr = storageNodes->getTypedNodeID(slowestNodeID);
                slowestTargetID = resultIter->first;
             }
+
+            StorageBenchLatencyResultsMapIter latencyIter =
+               iter->latencyResults.find(resultIter->first);
+            if(latencyIter == iter->latencyResults.end() )
+               continue; // older server without latency results
+
+            StorageBenchLatencyResult& latencies = latencyIter->second;
+
+            maxLatencies.p50 = BEEGFS_MAX(maxLatencies.p50, latencies.p50);
+            maxLatencies.p99 = BEEGFS_MAX(maxLatencies.p99, latencies.p99);
+            maxLatencies.p999 = BEEGFS_MAX(maxLatencies.p999, latencies.p999);
          }
       }
    }
@@ -553,28 +607,40 @@ void ModeStorageBench::printShortResults(StorageBenchResponseInfoList* responses
    if (slowestPerformance != 0)
    {
       printf("%-23s %10" PRId64 " %-8s nodeID: %s, targetID: %u\n", "Min throughput:",
-         slowestPerformance, STORAGEBENCH_PERFORMANCE_UNIT, slowestNodeIDStr.c_str(),
+         slowestPerformance, unit, slowestNodeIDStr.c_str(),
          slowestTargetID);
    }
 
    if (fastestPerformance != 0)
    {
       printf("%-23s %10" PRId64 " %-8s nodeID: %s, targetID: %u\n", "Max throughput:",
-         fastestPerformance, STORAGEBENCH_PERFORMANCE_UNIT, fastestNodeIDStr.c_str(),
+         fastestPerformance, unit, fastestNodeIDStr.c_str(),
          fastestTargetID);
    }
 
    if ( (storageTargetCount != 0) && (maxPerformance != 0) )
    {
       printf("%-23s %10" PRId64 " %-8s\n", "Avg throughput:", maxPerformance / storageTargetCount,
-         STORAGEBENCH_PERFORMANCE_UNIT);
+         unit);
    }
 
    if (maxPerformance != 0)
    {
-      printf("%-23s %10" PRId64 " %-8s\n\n", "Aggregate throughput:", maxPerformance,
-         STORAGEBENCH_PERFORMANCE_UNIT);
+      printf("%-23s %10" PRId64 " %-8s\n", "Aggregate throughput:", maxPerformance,
+         unit);
    }
+
+   if (maxLatencies.p999 != 0)
+   {
+      printf("%-23s %10" PRId64 " %-8s\n", "Max latency p50:", maxLatencies.p50,
+         STORAGEBENCH_LATENCY_UNIT);
+      printf("%-23s %10" PRId64 " %-8s\n", "Max latency p99:", maxLatencies.p99,
+         STORAGEBENCH_LATENCY_UNIT);
+      printf("%-23s %10" PRId64 " %-8s\n", "Max latency p99.9:", maxLatencies.p999,
+         STORAGEBENCH_LATENCY_UNIT);
+   }
+
+   std::cout << std::endl;
 }
 
 /*
@@ -588,7 +654,9 @@ void ModeStorageBench::printVerboseResults(StorageBenchResponseInfoList* respons
    App* app = Program::getApp();
    NodeStoreServers* storageNodes = app->getStorageNodes();
 
-   std::cout << "List of all targets:" << std::endl;
+   const char* unit = getPerformanceUnit(responses->front().type);
+
+   std::cout << "List of all targets (throughput, latency p50/p99/p99.9):" << std::endl;
 
    for (StorageBenchResponseInfoListIter iter = responses->begin(); iter != responses->end();
       iter++)
@@ -602,14 +670,54 @@ void ModeStorageBench::printVerboseResults(StorageBenchResponseInfoList* respons
              resultIter++)
          {
             std::string nodeIDStr = storageNodes->getTypedNodeID(iter->nodeID);
+            StorageBenchLatencyResultsMapIter latencyIter =
+               iter->latencyResults.find(resultIter->first);
+
+            if(latencyIter == iter->latencyResults.end() )
+            { // older server without latency results
+               printf("%-23hu %10" PRId64 " %-8s %-24s nodeID: %s\n", resultIter->first,
+                  resultIter->second, unit, "n/a", nodeIDStr.c_str() );
+               continue;
+            }
 
-            printf("%-23hu %10" PRId64 " %-8s nodeID: %s\n", resultIter->first, resultIter->second,
-               STORAGEBENCH_PERFORMANCE_UNIT, nodeIDStr.c_str());
+            StorageBenchLatencyResult& latencies = latencyIter->second;
+
+            printf("%-23hu %10" PRId64 " %-8s %" PRId64 "/%" PRId64 "/%" PRId64 "%s "
+               "nodeID: %s\n", resultIter->first, resultIter->second, unit, latencies.p50,
+               latencies.p99, latencies.p999, STORAGEBENCH_LATENCY_UNIT, nodeIDStr.c_str());
          }
       }
    }
 }
 
+/*
+ * @return the human-readable name of the given benchmark type
+ */
+std::string ModeStorageBench::getTypeName(StorageBenchType type)
+{
+   switch(type)
+   {
+      case StorageBenchType_READ: return "Read";
+      case StorageBenchType_WRITE: return "Write";
+      case StorageBenchType_RANDREAD: return "Random read";
+      case StorageBenchType_RANDWRITE: return "Random write";
+      case StorageBenchType_RANDMIXED: return "Mixed random read/write";
+      case StorageBenchType_CREATE: return "File create";
+      default: return "Unknown";
+   }
+}
+
+/*
+ * @return the unit of the throughput results of the given benchmark type
+ */
+const char* ModeStorageBench::getPerformanceUnit(StorageBenchType type)
+{
+   if (type == StorageBenchType_CREATE)
+      return STORAGEBENCH_PERFORMANCE_UNIT_CREATE;
+
+   return STORAGEBENCH_PERFORMANCE_UNIT;
+}
+
 /*
  * analyze the responses from the storage servers and prints the given informations
  *
@@ -646,14 +754,7 @@ void ModeStorageBench::printResults(StorageBenchResponseInfoList* responses)
       {
          case StorageBenchAction_START:
          {
-            if (type == StorageBenchType_READ)
-            {
-               std::cout << "Read storage benchmark was started." << std::endl;
-            }
-            if (type == StorageBenchType_WRITE)
-            {
-               std::cout << "Write storage benchmark was started." << std::endl;
-            }
+            std::cout << getTypeName(type) << " storage benchmark was started." << std::endl;
 
             std::cout << "You can query the status with the --status argument of beegfs-ctl.";
             std::cout << std::endl;
@@ -677,14 +778,9 @@ void ModeStorageBench::printResults(StorageBenchResponseInfoList* responses)
             checkAndPrintCurrentStatus(responses, true);
             std::cout << std::endl;
 
-            if (type == StorageBenchType_READ)
+            if (type != StorageBenchType_NONE)
             {
-               std::cout << "Read benchmark results:" << std::endl;
-            }
-            else
-            if (type == StorageBenchType_WRITE)
-            {
-               std::cout << "Write benchmark results:" << std::endl;
+               std::cout << getTypeName(type) << " benchmark results:" << std::endl;
             }
 
             printShortResults(responses);
@@ -917,6 +1013,15 @@ void ModeStorageBench::printHelp()
    std::cout << "  One of these arguments is mandatory:" << std::endl;
    std::cout << "    --write    Start a write benchmark." << std::endl;
    std::cout << "    --read     Start a read benchmark (requires previous write benchmark)." << std::endl;
+   std::cout << "    --randread Start a random read benchmark (requires previous write" << std::endl;
+   std::cout << "               benchmark)." << std::endl;
+   std::cout << "    --randwrite" << std::endl;
+   std::cout << "               Start a random write benchmark." << std::endl;
+   std::cout << "    --randmixed" << std::endl;
+   std::cout << "               Start a benchmark with random reads and writes (requires" << std::endl;
+   std::cout << "               previous write benchmark)." << std::endl;
+   std::cout << "    --create   Start a benchmark that creates, writes and deletes small files." << std::endl;
+   std::cout << "               The file size is the given blocksize." << std::endl;
    std::cout << "    --stop     Stop a running benchmark." << std::endl;
    std::cout << "    --status   Print status/results of a benchmark." << std::endl;
    std::cout << "    --cleanup  Delete the benchmark files from the storage targets." << std::endl;
@@ -928,6 +1033,8 @@ void ModeStorageBench::printHelp()
    std::cout << "                              (Default: 1G)" << std::endl;
    std::cout << "    --threads=<threadcount>   The number of client streams (files) per target to" << std::endl;
    std::cout << "                              be used in the benchmark. (Default: 1)" << std::endl;
+   std::cout << "    --readpercent=<percent>   The percentage of reads for --randmixed." << std::endl;
+   std::cout << "                              (Default: 50)" << std::endl;
    std::cout << std::endl;
    std::cout << " Optional:" << std::endl;
    std::cout << "    --verbose  Print result of every target." << std::endl;
@@ -937,6 +1044,9 @@ void ModeStorageBench::printHelp()
    std::cout << " This mode runs a streaming benchmark on the storage targets without any extra" << std::endl;
    std::cout << " network communication for file data transfer. Thus, it allows to measure" << std::endl;
    std::cout << " storage performance independent of network performance." << std::endl;
+   std::cout << " The random benchmarks read/write single blocks at random offsets within the" << std::endl;
+   std::cout << " first <size> bytes of the benchmark files. The results include the latency" << std::endl;
+   std::cout << " percentiles of the single blocks (or files for --create) of each target." << std::endl;
    std::cout << std::endl;
    std::cout << " Note:" << std::endl;
    std::cout << "  Benchmark files will not be deleted automatically. Use --cleanup to delete the" << std::endl;
@@ -949,6 +1059,11 @@ void ModeStorageBench::printHelp()
    std::cout << std::endl;
    std::cout << " Example: Query benchmark status/result of all targets" << std::endl;
    std::cout << "  $ beegfs-ctl --storagebench --alltargets --status" << std::endl;
+   std::cout << std::endl;
+   std::cout << " Example: Start a random benchmark with 70% reads and 30% writes of 4 KiB" << std::endl;
+   std::cout << "  blocks on all storage targets (after a write benchmark with the same size)" << std::endl;
+   std::cout << "  $ beegfs-ctl --storagebench --alltargets --randmixed --readpercent=70 \\" << std::endl;
+   std::cout << "     --blocksize=4K --size=20G --threads=16" << std::endl;
 }
 
 /*
@@ -974,7 +1089,8 @@ bool ModeStorageBench::sendCmdAndCollectResult(uint16_t nodeID,
    this->cfgTargetIDs.getTargetsByNode(nodeID, targets);
 
    StorageBenchControlMsg msg(this->cfgAction, this->cfgType, this->cfgBlocksize, this->cfgSize,
-      this->cfgThreads, &targets);
+      this->cfgThreads, this->cfgReadPercent, &targets);
+   msg.addLatencyRequest();
 
    Node* node = nodes->referenceNode(nodeID);
    if(!node)
@@ -996,6 +1112,7 @@ bool ModeStorageBench::sendCmdAndCollectResult(uint16_t nodeID,
 
    respMsgCast = (StorageBenchControlMsgResp*)respMsg;
    respMsgCast->parseResults(&response.results);
+   respMsgCast->parseLatencyResults(&response.latencyResults);
 
    response.nodeID = nodeID;
    response.targetIDs = targets;
@@ -23,6 +23,7 @@ struct StorageBenchResponseInfo
    StorageBenchAction action;
    StorageBenchType type;
    StorageBenchResultsMap results;
+   StorageBenchLatencyResultsMap latencyResults;
 };
 
 typedef std::list<StorageBenchResponseInfo> StorageBenchResponseInfoList;
@@ -43,6 +44,7 @@ class ModeStorageBench: public Mode
          this->cfgSize = STORAGEBENCH_DEFAULT_SIZE;
          this->cfgAction = StorageBenchAction_NONE;
          this->cfgThreads = STORAGEBENCH_DEFAULT_THREAD_COUNT;
+         this->cfgReadPercent = STORAGEBENCH_DEFAULT_READ_PERCENT;
          this->cfgVerbose = false;
          this->cfgWait = false;
       }
@@ -66,14 +68,19 @@ class ModeStorageBench: public Mode
       int64_t cfgBlocksize;
       int64_t cfgSize;
       int cfgThreads;
+      int cfgReadPercent;
 
       int checkConfig(Node* mgmtNode, NodeStoreServers* storageNodes, StringMap* cfg);
+      int parseTypeArg(StringMap* cfg, const char* argName, StorageBenchType type);
       bool sendCmdAndCollectResult(uint16_t nodeID, StorageBenchResponseInfo& response);
 
       void printResults(StorageBenchResponseInfoList* responses);
       void printShortResults(StorageBenchResponseInfoList* responses);
       void printVerboseResults(StorageBenchResponseInfoList* responses);
       void printError(StorageBenchResponseInfoList* responses);
+
+      static std::string getTypeName(StorageBenchType type);
+      static const char* getPerformanceUnit(StorageBenchType type);
       bool checkAndPrintCurrentStatus(StorageBenchResponseInfoList* responses,
          bool printStatus);
 };
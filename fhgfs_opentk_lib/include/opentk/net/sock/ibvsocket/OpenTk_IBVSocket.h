@@ -17,6 +17,9 @@ typedef struct IBVSocket IBVSocket;
 struct IBVCommConfig;
 typedef struct IBVCommConfig IBVCommConfig;
 
+struct IBVBufRegion;
+typedef struct IBVBufRegion IBVBufRegion;
+
 
 enum IBVSocket_AcceptRes
    {ACCEPTRES_ERR=0, ACCEPTRES_IGNORE=1, ACCEPTRES_SUCCESS=2};
@@ -54,12 +57,24 @@ extern int IBVSocket_checkConnection(IBVSocket* _this);
 extern ssize_t IBVSocket_nonblockingRecvCheck(IBVSocket* _this);
 extern bool IBVSocket_checkDelayedEvents(IBVSocket* _this);
 
+extern IBVBufRegion* IBVSocket_registerBuf(IBVSocket* _this, void* buf, size_t bufLen);
+extern void IBVSocket_deregisterBuf(IBVBufRegion* region);
+extern bool IBVSocket_rdmaWrite(IBVSocket* _this, IBVBufRegion* localRegion,
+   const char* localBuf, size_t bufLen, uint64_t remoteVAddr, unsigned remoteRKey);
+extern bool IBVSocket_rdmaRead(IBVSocket* _this, IBVBufRegion* localRegion,
+   char* localBuf, size_t bufLen, uint64_t remoteVAddr, unsigned remoteRKey);
+
 
 // getters & setters
 extern bool IBVSocket_getSockValid(IBVSocket* _this);
 extern int IBVSocket_getRecvCompletionFD(IBVSocket* _this);
 extern int IBVSocket_getConnManagerFD(IBVSocket* _this);
 extern void IBVSocket_setTypeOfService(IBVSocket* _this, uint8_t typeOfService);
+extern void IBVSocket_setSharedRecvConfig(IBVSocket* _this, unsigned bufNum, unsigned bufSize);
+extern bool IBVSocket_getUsesSharedRecv(IBVSocket* _this);
+extern bool IBVSocket_isRegionUsable(IBVSocket* _this, IBVBufRegion* region);
+
+extern unsigned IBVBufRegion_getRKey(IBVBufRegion* region);
 
 
 
@@ -4,6 +4,8 @@
 
 #include <opentk/logging/SyslogLogger.h>
 
+#include <fcntl.h>
+#include <limits.h>
 #include <syslog.h>
 #include <sys/epoll.h>
 
@@ -18,6 +20,9 @@
 #define IBVSOCKET_MIN_BUF_SIZE                        4096   // 4kiB
 #define IBVSOCKET_MAX_BUF_SIZE_NUM                    131072 // num * size <= 128MiB
 
+#define IBVSOCKET_MIN_CREDITS                         2 // (flow control acks after credits-1 msgs)
+#define IBVSOCKET_SHAREDRECV_LIMIT_DIV                8 // srq limit event at 1/8 of shared bufs
+
 void IBVSocket_init(IBVSocket* _this)
 {
    memset(_this, 0, sizeof(*_this) );
@@ -249,7 +254,7 @@ bool IBVSocket_connectByIP(IBVSocket* _this, struct in_addr* ipaddress, unsigned
 
    // create comm context...
 
-   createContextRes = __IBVSocket_createCommContext(_this, _this->cm_id, commCfg,
+   createContextRes = __IBVSocket_createCommContext(_this, _this->cm_id, commCfg, NULL,
       &_this->commContext);
    if(!createContextRes)
    {
@@ -299,6 +304,14 @@ bool IBVSocket_connectByIP(IBVSocket* _this, struct in_addr* ipaddress, unsigned
       goto err_ack_and_invalidateSock;
    }
 
+   // the peer might accept less unacked msgs than we have bufs (e.g. if it uses shared recv bufs)
+   if( (_this->remoteDest->recvBufNum >= IBVSOCKET_MIN_CREDITS) &&
+       (_this->remoteDest->recvBufNum < _this->commContext->sendCredits) )
+   {
+      _this->commContext->sendCredits = _this->remoteDest->recvBufNum;
+      _this->commContext->numSendBufsLeft = _this->commContext->sendCredits - 1;
+   }
+
    rdma_ack_cm_event(event);
 
    epollInitRes = __IBVSocket_initEpollFD(_this);
@@ -426,6 +439,7 @@ IBVSocket_AcceptRes IBVSocket_accept(IBVSocket* _this, IBVSocket** outAcceptedSo
          struct rdma_conn_param conn_param;
          bool parseCommDestRes;
          IBVCommConfig commCfg;
+         IBVSharedRecvContext* sharedRecv = NULL;
 
          struct rdma_cm_id* child_cm_id = event->id;
 
@@ -456,8 +470,12 @@ IBVSocket_AcceptRes IBVSocket_accept(IBVSocket* _this, IBVSocket** outAcceptedSo
          commCfg.bufNum = childRemoteDest->recvBufNum;
          commCfg.bufSize = childRemoteDest->recvBufSize;
 
+         // (peer msgs must fit into the shared bufs, so peers with larger bufs get private bufs)
+         if(_this->sharedRecvCfg.bufNum && (commCfg.bufSize <= _this->sharedRecvCfg.bufSize) )
+            sharedRecv = __IBVSocket_getSharedRecvContext(_this, child_cm_id->verbs);
+
          createContextRes = __IBVSocket_createCommContext(_this, child_cm_id, &commCfg,
-            &childCommContext);
+            sharedRecv, &childCommContext);
          if(!createContextRes)
          {
             SyslogLogger::log(LOG_WARNING, "%d:%s: creation of CommContext failed\n",
@@ -658,7 +676,7 @@ ssize_t __IBVSocket_recvContinueIncomplete(IBVSocket* _this, char* buf, size_t b
 
    if(availableLen <= bufLen)
    { // old data fits completely into buf
-      memcpy(buf, &(commContext->recvBufs)[bufIndex][completedOffset], availableLen);
+      memcpy(buf, &__IBVSocket_getRecvBuf(commContext, bufIndex)[completedOffset], availableLen);
 
       commContext->incompleteRecv.isAvailable = 0;
 
@@ -670,7 +688,7 @@ ssize_t __IBVSocket_recvContinueIncomplete(IBVSocket* _this, char* buf, size_t b
    }
    else
    { // still too much data for the buf => copy partially
-      memcpy(buf, &(commContext->recvBufs)[bufIndex][completedOffset], bufLen);
+      memcpy(buf, &__IBVSocket_getRecvBuf(commContext, bufIndex)[completedOffset], bufLen);
 
       commContext->incompleteRecv.completedOffset += bufLen;
 
@@ -812,7 +830,7 @@ err_invalidateSock:
 }
 
 
-int __IBVSocket_registerBuf(IBVCommContext* commContext, void* buf, size_t bufLen,
+int __IBVSocket_registerBuf(struct ibv_pd* pd, void* buf, size_t bufLen,
    struct ibv_mr** outMR)
 {
    /* note: IB spec says:
@@ -821,7 +839,7 @@ int __IBVSocket_registerBuf(IBVCommContext* commContext, void* buf, size_t bufLe
    enum ibv_access_flags accessFlags = (enum ibv_access_flags)
       (IBV_ACCESS_REMOTE_READ | IBV_ACCESS_REMOTE_WRITE | IBV_ACCESS_LOCAL_WRITE);
 
-   *outMR = ibv_reg_mr(commContext->pd, buf, bufLen, accessFlags);
+   *outMR = ibv_reg_mr(pd, buf, bufLen, accessFlags);
    if(!*outMR)
    {
       SyslogLogger::log(LOG_WARNING, "%s:%d: Couldn't allocate MR\n", __func__, __LINE__);
@@ -832,7 +850,7 @@ int __IBVSocket_registerBuf(IBVCommContext* commContext, void* buf, size_t bufLe
 }
 
 
-char* __IBVSocket_allocAndRegisterBuf(IBVCommContext* commContext, size_t bufLen,
+char* __IBVSocket_allocAndRegisterBuf(struct ibv_pd* pd, size_t bufLen,
    struct ibv_mr** outMR)
 {
    void* buf;
@@ -847,7 +865,7 @@ char* __IBVSocket_allocAndRegisterBuf(IBVCommContext* commContext, size_t bufLen
 
    memset(buf, 0, bufLen);
 
-   registerRes = __IBVSocket_registerBuf(commContext, buf, bufLen, outMR);
+   registerRes = __IBVSocket_registerBuf(pd, buf, bufLen, outMR);
    if(registerRes < 0)
    {
       free(buf);
@@ -857,8 +875,13 @@ char* __IBVSocket_allocAndRegisterBuf(IBVCommContext* commContext, size_t bufLen
    return (char*)buf;
 }
 
+/**
+ * @param sharedRecv may be NULL to create private recv bufs for this conn; otherwise the conn will
+ *    receive into the shared bufs and use the protection domain of sharedRecv (a reference will be
+ *    taken).
+ */
 bool __IBVSocket_createCommContext(IBVSocket* _this, struct rdma_cm_id* cm_id,
-   IBVCommConfig* commCfg, IBVCommContext** outCommContext)
+   IBVCommConfig* commCfg, IBVSharedRecvContext* sharedRecv, IBVCommContext** outCommContext)
 {
    IBVCommContext* commContext = NULL;
    int registerControlRes;
@@ -903,33 +926,46 @@ bool __IBVSocket_createCommContext(IBVSocket* _this, struct rdma_cm_id* cm_id,
       goto err_cleanup;
    }
 
-   commContext->pd = ibv_alloc_pd(commContext->context);
-   if(!commContext->pd)
+   if(sharedRecv)
+   { // recv into shared bufs (and use the shared protection domain)
+      __sync_add_and_fetch(&sharedRecv->refCount, 1); // gcc extension
+      commContext->sharedRecv = sharedRecv;
+
+      commContext->pd = sharedRecv->pd;
+   }
+   else
    {
-      SyslogLogger::log(LOG_WARNING, "%s:%d: Couldn't allocate PD\n", __func__, __LINE__);
-      goto err_cleanup;
+      commContext->pd = ibv_alloc_pd(commContext->context);
+      if(!commContext->pd)
+      {
+         SyslogLogger::log(LOG_WARNING, "%s:%d: Couldn't allocate PD\n", __func__, __LINE__);
+         goto err_cleanup;
+      }
    }
 
    // alloc and register buffers...
 
    commContext->commCfg = *commCfg;
 
-   commContext->recvBuf = __IBVSocket_allocAndRegisterBuf(
-         commContext, commCfg->bufSize * commCfg->bufNum, &commContext->recvMR);
-   if(!commContext->recvBuf)
+   if(!sharedRecv)
    {
-      SyslogLogger::log(LOG_WARNING, "%s:%d: Couldn't prepare recvBuf\n", __func__, __LINE__);
-      goto err_cleanup;
-   }
+      commContext->recvBuf = __IBVSocket_allocAndRegisterBuf(
+            commContext->pd, commCfg->bufSize * commCfg->bufNum, &commContext->recvMR);
+      if(!commContext->recvBuf)
+      {
+         SyslogLogger::log(LOG_WARNING, "%s:%d: Couldn't prepare recvBuf\n", __func__, __LINE__);
+         goto err_cleanup;
+      }
 
-   commContext->recvBufs = (char**)calloc(1, commCfg->bufNum * sizeof(char*) );
+      commContext->recvBufs = (char**)calloc(1, commCfg->bufNum * sizeof(char*) );
 
-   for(i=0; i < commCfg->bufNum; i++)
-      commContext->recvBufs[i] = &commContext->recvBuf[i * commCfg->bufSize];
+      for(i=0; i < commCfg->bufNum; i++)
+         commContext->recvBufs[i] = &commContext->recvBuf[i * commCfg->bufSize];
+   }
 
 
    commContext->sendBuf = __IBVSocket_allocAndRegisterBuf(
-         commContext, commCfg->bufSize * commCfg->bufNum, &commContext->sendMR);
+         commContext->pd, commCfg->bufSize * commCfg->bufNum, &commContext->sendMR);
    if(!commContext->sendBuf)
    {
       SyslogLogger::log(LOG_WARNING, "%s:%d: Couldn't prepare sendBuf\n", __func__, __LINE__);
@@ -943,7 +979,7 @@ bool __IBVSocket_createCommContext(IBVSocket* _this, struct rdma_cm_id* cm_id,
 
 
    registerControlRes = __IBVSocket_registerBuf(
-      commContext, (char*)&commContext->numUsedSendBufs,
+      commContext->pd, (char*)&commContext->numUsedSendBufs,
       sizeof(commContext->numUsedSendBufs), &commContext->controlMR);
    if(registerControlRes < 0)
    {
@@ -953,7 +989,7 @@ bool __IBVSocket_createCommContext(IBVSocket* _this, struct rdma_cm_id* cm_id,
    }
 
    registerControlResReset = __IBVSocket_registerBuf(
-      commContext, (char*)&commContext->numUsedSendBufsReset,
+      commContext->pd, (char*)&commContext->numUsedSendBufsReset,
       sizeof(commContext->numUsedSendBufsReset), &commContext->controlResetMR);
    if(registerControlResReset < 0)
    {
@@ -964,10 +1000,14 @@ bool __IBVSocket_createCommContext(IBVSocket* _this, struct rdma_cm_id* cm_id,
 
    // init flow control v2 (to avoid long receiver-not-ready timeouts)
 
+   commContext->recvCredits = sharedRecv ?
+      __IBVSocket_getSharedRecvCredits(sharedRecv, commCfg->bufNum) : commCfg->bufNum;
+   commContext->sendCredits = commCfg->bufNum; // (might be reduced by the peer during connect)
+
    /* note: we use -1 because the last buf might not be read by the user (eg during
       nonblockingRecvCheck) and so it might not be immediately available again. */
-   commContext->numReceivedBufsLeft = commCfg->bufNum - 1;
-   commContext->numSendBufsLeft = commCfg->bufNum - 1;
+   commContext->numReceivedBufsLeft = commContext->recvCredits - 1;
+   commContext->numSendBufsLeft = commContext->sendCredits - 1;
 
    // create completion channel and queues...
 
@@ -1003,10 +1043,11 @@ bool __IBVSocket_createCommContext(IBVSocket* _this, struct rdma_cm_id* cm_id,
    qpInitAttr.qp_type = IBV_QPT_RC;
    qpInitAttr.sq_sig_all = 1;
    qpInitAttr.cap.max_send_wr = 1+commCfg->bufNum;
-   qpInitAttr.cap.max_recv_wr = commCfg->bufNum;
+   qpInitAttr.cap.max_recv_wr = sharedRecv ? 0 : commCfg->bufNum;
    qpInitAttr.cap.max_send_sge = 1;
-   qpInitAttr.cap.max_recv_sge = 1;
+   qpInitAttr.cap.max_recv_sge = sharedRecv ? 0 : 1;
    qpInitAttr.cap.max_inline_data = 0;
+   qpInitAttr.srq = sharedRecv ? sharedRecv->srq : NULL;
 
    createQPRes = rdma_create_qp(cm_id, commContext->pd, &qpInitAttr);
    if(createQPRes)
@@ -1018,9 +1059,9 @@ bool __IBVSocket_createCommContext(IBVSocket* _this, struct rdma_cm_id* cm_id,
 
    commContext->qp = cm_id->qp;
 
-   // post initial recv buffers...
+   // post initial recv buffers (shared bufs were already posted to the srq)...
 
-   for(i=0; i < commCfg->bufNum; i++)
+   for(i=0; !sharedRecv && (i < commCfg->bufNum); i++)
    {
       if(__IBVSocket_postRecv(_this, commContext, i) )
       {
@@ -1066,6 +1107,20 @@ void __IBVSocket_cleanupCommContext(struct rdma_cm_id* cm_id, IBVCommContext* co
       rdma_destroy_qp(cm_id);
    }
 
+   if(commContext->sharedRecv && commContext->recvCQ)
+   { // give shared bufs that we received into (but didn't consume) back to the srq
+      struct ibv_wc wc;
+
+      if(commContext->incompleteRecv.isAvailable)
+         __IBVSocket_recycleSharedRecvWC(commContext, &commContext->incompleteRecv.wc);
+
+      while(ibv_poll_cq(commContext->recvCQ, 1, &wc) > 0)
+      {
+         __IBVSocket_onSharedRecvCompletion(commContext);
+         __IBVSocket_recycleSharedRecvWC(commContext, &wc);
+      }
+   }
+
    if(commContext->sendCQ)
    {
       if(ibv_destroy_cq(commContext->sendCQ) )
@@ -1113,6 +1168,9 @@ void __IBVSocket_cleanupCommContext(struct rdma_cm_id* cm_id, IBVCommContext* co
    SAFE_FREE(commContext->recvBufs);
    SAFE_FREE(commContext->sendBufs);
 
+   if(commContext->sharedRecv)
+      __IBVSocket_releaseSharedRecvContext(commContext->sharedRecv); // (also owns the pd)
+   else
    if(commContext->pd)
    {
       if(ibv_dealloc_pd(commContext->pd) )
@@ -1122,6 +1180,304 @@ void __IBVSocket_cleanupCommContext(struct rdma_cm_id* cm_id, IBVCommContext* co
    free(commContext);
 }
 
+/**
+ * Find the shared recv context of this listen socket for the given device or create it if it
+ * doesn't exist yet.
+ *
+ * Note: Only called by the thread that accepts the incoming conns of this listen socket.
+ *
+ * @return NULL if shared recv bufs are disabled or could not be created (in which case the conn
+ *    should fall back to private recv bufs); the listener holds the returned reference, so callers
+ *    need to take their own reference if they keep it.
+ */
+IBVSharedRecvContext* __IBVSocket_getSharedRecvContext(IBVSocket* _this,
+   struct ibv_context* context)
+{
+   IBVSharedRecvContext* sharedRecv;
+
+   if(!_this->sharedRecvCfg.bufNum || !context)
+      return NULL;
+
+   for(sharedRecv = _this->sharedRecvContexts; sharedRecv; sharedRecv = sharedRecv->next)
+   {
+      if(sharedRecv->context == context)
+         return sharedRecv;
+   }
+
+   sharedRecv = __IBVSocket_createSharedRecvContext(context, &_this->sharedRecvCfg);
+   if(!sharedRecv)
+   {
+      SyslogLogger::log(LOG_WARNING, "%s: Couldn't create shared recv bufs for device. "
+         "Falling back to recv bufs per connection.\n", __func__);
+      return NULL;
+   }
+
+   sharedRecv->next = _this->sharedRecvContexts;
+   _this->sharedRecvContexts = sharedRecv;
+
+   return sharedRecv;
+}
+
+/**
+ * Create a protection domain and a shared receive queue for the given device and post all shared
+ * recv bufs to it.
+ *
+ * @return NULL on error; the returned context has a refCount of 1 (for the creator)
+ */
+IBVSharedRecvContext* __IBVSocket_createSharedRecvContext(struct ibv_context* context,
+   IBVCommConfig* commCfg)
+{
+   IBVSharedRecvContext* sharedRecv;
+   struct ibv_srq_init_attr srqInitAttr;
+   unsigned i;
+
+   if(unlikely( (commCfg->bufNum < IBVSOCKET_MIN_BUF_NUM) ||
+      (commCfg->bufSize < IBVSOCKET_MIN_BUF_SIZE) ) )
+   {
+      SyslogLogger::log(LOG_WARNING, "%s: Invalid shared buffer config (num: %u; size: %u)\n",
+         __func__, commCfg->bufNum, commCfg->bufSize);
+      return NULL;
+   }
+
+   sharedRecv = (IBVSharedRecvContext*)calloc(1, sizeof(*sharedRecv) );
+   if(!sharedRecv)
+      return NULL;
+
+   sharedRecv->context = context;
+   sharedRecv->commCfg = *commCfg;
+   sharedRecv->refCount = 1;
+   sharedRecv->limit = commCfg->bufNum / IBVSOCKET_SHAREDRECV_LIMIT_DIV;
+
+   sharedRecv->pd = ibv_alloc_pd(context);
+   if(!sharedRecv->pd)
+   {
+      SyslogLogger::log(LOG_WARNING, "%s:%d: Couldn't allocate PD\n", __func__, __LINE__);
+      goto err_cleanup;
+   }
+
+   sharedRecv->recvBuf = __IBVSocket_allocAndRegisterBuf(sharedRecv->pd,
+      (size_t)commCfg->bufSize * commCfg->bufNum, &sharedRecv->recvMR);
+   if(!sharedRecv->recvBuf)
+   {
+      SyslogLogger::log(LOG_WARNING, "%s:%d: Couldn't prepare recvBuf\n", __func__, __LINE__);
+      goto err_cleanup;
+   }
+
+   memset(&srqInitAttr, 0, sizeof(srqInitAttr) );
+
+   srqInitAttr.srq_context = sharedRecv;
+   srqInitAttr.attr.max_wr = commCfg->bufNum;
+   srqInitAttr.attr.max_sge = 1;
+
+   sharedRecv->srq = ibv_create_srq(sharedRecv->pd, &srqInitAttr);
+   if(!sharedRecv->srq)
+   {
+      SyslogLogger::log(LOG_WARNING, "%s:%d: Couldn't create SRQ (Errno: %d)\n",
+         __func__, __LINE__, errno);
+      goto err_cleanup;
+   }
+
+   // async events are only read when needed (see __IBVSocket_onSharedRecvCompletion() )
+   if(sharedRecv->limit &&
+      fcntl(context->async_fd, F_SETFL, fcntl(context->async_fd, F_GETFL) | O_NONBLOCK) )
+   {
+      SyslogLogger::log(LOG_WARNING, "%s: Couldn't make async event fd non-blocking. "
+         "Shared recv buf usage will not be monitored.\n", __func__);
+      sharedRecv->limit = 0;
+   }
+
+   // (the limit event gets armed while posting, see __IBVSocket_postSharedRecv() )
+   for(i=0; i < commCfg->bufNum; i++)
+   {
+      if(__IBVSocket_postSharedRecv(sharedRecv, i) )
+      {
+         SyslogLogger::log(LOG_WARNING, "%s: Couldn't post shared recv buffer with index %d\n",
+            __func__, i);
+         goto err_cleanup;
+      }
+   }
+
+   return sharedRecv;
+
+
+err_cleanup:
+   __IBVSocket_releaseSharedRecvContext(sharedRecv);
+
+   return NULL;
+}
+
+/**
+ * Drop a reference and destroy the context when the last reference is gone.
+ *
+ * Note: Conns need to be cleaned up before they release their reference, because the pd of their
+ * memory regions and queue pairs is owned by this context.
+ */
+void __IBVSocket_releaseSharedRecvContext(IBVSharedRecvContext* sharedRecv)
+{
+   if(__sync_sub_and_fetch(&sharedRecv->refCount, 1) ) // gcc extension
+      return; // still referenced by others
+
+   if(sharedRecv->srq)
+   {
+      if(ibv_destroy_srq(sharedRecv->srq) )
+         SyslogLogger::log(LOG_WARNING, "%s: Failed to destroy srq\n", __func__);
+   }
+
+   if(sharedRecv->recvMR)
+   {
+      if(ibv_dereg_mr(sharedRecv->recvMR) )
+         SyslogLogger::log(LOG_WARNING, "%s: Failed to deregister recvMR\n", __func__);
+   }
+
+   SAFE_FREE(sharedRecv->recvBuf);
+
+   if(sharedRecv->pd)
+   {
+      if(ibv_dealloc_pd(sharedRecv->pd) )
+         SyslogLogger::log(LOG_WARNING, "%s: Failed to dealloc pd\n", __func__);
+   }
+
+   free(sharedRecv);
+}
+
+/**
+ * Give the shared buf of a recv completion back to the srq. Used when a conn is done with a
+ * completion without going through the normal recv path (e.g. on errors and during cleanup),
+ * because the buf would otherwise be lost for all other conns.
+ *
+ * Note: Does nothing for conns with private recv bufs.
+ */
+void __IBVSocket_recycleSharedRecvWC(IBVCommContext* commContext, struct ibv_wc* wc)
+{
+   IBVSharedRecvContext* sharedRecv = commContext->sharedRecv;
+   size_t bufIndex = wc->wr_id - IBVSOCKET_RECV_WORK_ID_OFFSET;
+
+   if(!sharedRecv || (bufIndex >= sharedRecv->commCfg.bufNum) )
+      return;
+
+   __IBVSocket_postSharedRecv(sharedRecv, bufIndex);
+}
+
+/**
+ * Flow control credits of a new conn that receives into the shared bufs. The shared bufs are
+ * split evenly between the conns that use them when the conn is accepted, so that senders get
+ * throttled by flow control instead of IB rnr retries as long as most conns keep their share.
+ *
+ * Note: Credits of existing conns are not reduced when more conns are accepted, so the srq can
+ * still run low under load (see __IBVSocket_handleAsyncEvents() ).
+ *
+ * @param maxCredits number of recv bufs that the peer asked for.
+ */
+unsigned __IBVSocket_getSharedRecvCredits(IBVSharedRecvContext* sharedRecv, unsigned maxCredits)
+{
+   int numConns = sharedRecv->refCount - 1; // (-1 for the reference of the listener)
+   unsigned credits = sharedRecv->commCfg.bufNum / BEEGFS_MAX(numConns, 1);
+
+   credits = BEEGFS_MAX(credits, IBVSOCKET_MIN_CREDITS);
+
+   return BEEGFS_MIN(credits, maxCredits);
+}
+
+/**
+ * Arm the srq limit, so that the device generates IBV_EVENT_SRQ_LIMIT_REACHED when the number of
+ * posted shared bufs drops below sharedRecv->limit. (The limit is disarmed when the event fires.)
+ *
+ * Note: Does nothing if the limit is disabled or already armed.
+ */
+void __IBVSocket_armSharedRecvLimit(IBVSharedRecvContext* sharedRecv)
+{
+   struct ibv_srq_attr srqAttr;
+
+   if(!sharedRecv->limit || !__sync_bool_compare_and_swap(&sharedRecv->limitArmed, 0, 1) )
+      return;
+
+   memset(&srqAttr, 0, sizeof(srqAttr) );
+
+   srqAttr.srq_limit = sharedRecv->limit;
+
+   if(ibv_modify_srq(sharedRecv->srq, &srqAttr, IBV_SRQ_LIMIT) )
+   {
+      SyslogLogger::log(LOG_WARNING, "%s: Device doesn't support srq limit. "
+         "Shared recv buf usage will not be monitored.\n", __func__);
+
+      sharedRecv->limit = 0;
+   }
+}
+
+/**
+ * Called for each work completion that was retrieved from the recv CQ of a conn (to keep track
+ * of the bufs that are left in the srq).
+ *
+ * Note: Does nothing for conns with private recv bufs.
+ */
+void __IBVSocket_onSharedRecvCompletion(IBVCommContext* commContext)
+{
+   IBVSharedRecvContext* sharedRecv = commContext->sharedRecv;
+   int numPostedBufs;
+
+   if(!sharedRecv)
+      return;
+
+   numPostedBufs = __sync_sub_and_fetch(&sharedRecv->numPostedBufs, 1); // gcc extension
+
+   // the limit event should be pending now (checking earlier would cost a syscall per recv)
+   if(sharedRecv->limitArmed && (numPostedBufs < (int)sharedRecv->limit) )
+      __IBVSocket_handleAsyncEvents(sharedRecv);
+}
+
+/**
+ * Retrieve and ack all pending async events of the device of sharedRecv (without waiting).
+ *
+ * Note: Nobody else reads the async events of our devices, so the events of other listeners'
+ * srqs are also handled here (via srq_context) and all other events are just acked.
+ */
+void __IBVSocket_handleAsyncEvents(IBVSharedRecvContext* sharedRecv)
+{
+   struct ibv_async_event event;
+
+   while(!ibv_get_async_event(sharedRecv->context, &event) )
+   {
+      if(event.event_type == IBV_EVENT_SRQ_LIMIT_REACHED)
+      {
+         IBVSharedRecvContext* eventSharedRecv =
+            (IBVSharedRecvContext*)event.element.srq->srq_context;
+
+         SyslogLogger::log(LOG_WARNING, "%s: Shared recv bufs almost used up "
+            "(left: %d; total: %u). Senders might be throttled by the device; consider "
+            "increasing connRDMASharedRecvBufNum.\n", __func__,
+            (int)eventSharedRecv->numPostedBufs, eventSharedRecv->commCfg.bufNum);
+
+         // re-armed when enough bufs are back (see __IBVSocket_postSharedRecv() )
+         eventSharedRecv->limitArmed = 0;
+      }
+
+      ibv_ack_async_event(&event);
+   }
+}
+
+/**
+ * @return pointer to the recv buf with the given index (either private or shared)
+ */
+char* __IBVSocket_getRecvBuf(IBVCommContext* commContext, size_t bufIndex)
+{
+   IBVSharedRecvContext* sharedRecv = commContext->sharedRecv;
+
+   if(sharedRecv)
+      return &sharedRecv->recvBuf[bufIndex * sharedRecv->commCfg.bufSize];
+
+   return commContext->recvBufs[bufIndex];
+}
+
+/**
+ * @return number of recv bufs that work completion IDs may refer to (either private or shared)
+ */
+unsigned __IBVSocket_getRecvBufNum(IBVCommContext* commContext)
+{
+   IBVSharedRecvContext* sharedRecv = commContext->sharedRecv;
+
+   return sharedRecv ? sharedRecv->commCfg.bufNum : commContext->commCfg.bufNum;
+}
+
 /**
  * Initializes a (local) IBVCommDest.
  */
@@ -1140,8 +1496,8 @@ void __IBVSocket_initCommDest(IBVCommContext* commContext, IBVCommDest* outDest)
    Serialization::serializeUInt64( (char*)&outDest->vaddr,
       (uintptr_t)&commContext->numUsedSendBufs);
 
-   //outDest->recvBufNum = commContext->commCfg.bufNum;
-   Serialization::serializeUInt( (char*)&outDest->recvBufNum, commContext->commCfg.bufNum);
+   // (the peer uses this as its send credits, which might be less than our number of bufs)
+   Serialization::serializeUInt( (char*)&outDest->recvBufNum, commContext->recvCredits);
 
    //outDest->recvBufSize = commContext->commCfg.bufSize;
    Serialization::serializeUInt( (char*)&outDest->recvBufSize, commContext->commCfg.bufSize);
@@ -1245,6 +1601,9 @@ int __IBVSocket_postRecv(IBVSocket* _this, IBVCommContext* commContext, size_t b
    struct ibv_recv_wr* bad_wr;
    int postRes;
 
+   if(commContext->sharedRecv)
+      return __IBVSocket_postSharedRecv(commContext->sharedRecv, bufIndex);
+
    list.addr = (uint64_t)commContext->recvBufs[bufIndex];
    list.length = commContext->commCfg.bufSize;
    list.lkey = commContext->recvMR->lkey;
@@ -1266,12 +1625,54 @@ int __IBVSocket_postRecv(IBVSocket* _this, IBVCommContext* commContext, size_t b
    return 0;
 }
 
+/**
+ * Note: Shared bufs may be posted by different threads concurrently (which is fine for verbs).
+ *
+ * @return 0 on success, -1 on error
+ */
+int __IBVSocket_postSharedRecv(IBVSharedRecvContext* sharedRecv, size_t bufIndex)
+{
+   struct ibv_sge list;
+   struct ibv_recv_wr wr;
+   struct ibv_recv_wr* bad_wr;
+   int postRes;
+   int numPostedBufs;
+
+   list.addr = (uint64_t)&sharedRecv->recvBuf[bufIndex * sharedRecv->commCfg.bufSize];
+   list.length = sharedRecv->commCfg.bufSize;
+   list.lkey = sharedRecv->recvMR->lkey;
+
+   wr.next = NULL;
+   wr.wr_id = bufIndex + IBVSOCKET_RECV_WORK_ID_OFFSET;
+   wr.sg_list = &list;
+   wr.num_sge = 1;
+
+   postRes = ibv_post_srq_recv(sharedRecv->srq, &wr, &bad_wr);
+   if(unlikely(postRes) )
+   {
+      SyslogLogger::log(LOG_WARNING,
+         "%d:%s: ibv_post_srq_recv failed. ErrCode: %d (SysErr: %s)\n",
+         __LINE__, __func__, postRes, strerror(errno) );
+
+      return -1;
+   }
+
+   numPostedBufs = __sync_add_and_fetch(&sharedRecv->numPostedBufs, 1); // gcc extension
+
+   /* re-arm the limit event only when the srq is well above the limit again (so that a srq that
+      is hovering around the limit doesn't generate an event for each buf) */
+   if(!sharedRecv->limitArmed && (numPostedBufs >= 2 * (int)sharedRecv->limit) )
+      __IBVSocket_armSharedRecvLimit(sharedRecv);
+
+   return 0;
+}
+
 /**
  * Synchronous RDMA write (waits for completion)
  *
  * @return 0 on success, -1 on error
  */
-int __IBVSocket_postWrite(IBVSocket* _this, IBVCommDest* remoteDest,
+int __IBVSocket_postWrite(IBVSocket* _this, uint64_t remoteVAddr, unsigned remoteRKey,
    struct ibv_mr* localMR, char* localBuf, int bufLen)
 {
    IBVCommContext* commContext = _this->commContext;
@@ -1285,8 +1686,8 @@ int __IBVSocket_postWrite(IBVSocket* _this, IBVCommDest* remoteDest,
    list.length = bufLen;
    list.lkey = localMR->lkey;
 
-   wr.wr.rdma.remote_addr = remoteDest->vaddr;
-   wr.wr.rdma.rkey = remoteDest->rkey;
+   wr.wr.rdma.remote_addr = remoteVAddr;
+   wr.wr.rdma.rkey = remoteRKey;
 
    wr.wr_id      = IBVSOCKET_WRITE_WORK_ID;
    wr.sg_list    = &list;
@@ -1319,7 +1720,7 @@ int __IBVSocket_postWrite(IBVSocket* _this, IBVCommDest* remoteDest,
  *
  * @return 0 on success, -1 on error
  */
-int __IBVSocket_postRead(IBVSocket* _this, IBVCommDest* remoteDest,
+int __IBVSocket_postRead(IBVSocket* _this, uint64_t remoteVAddr, unsigned remoteRKey,
    struct ibv_mr* localMR, char* localBuf, int bufLen)
 {
    IBVCommContext* commContext = _this->commContext;
@@ -1333,8 +1734,8 @@ int __IBVSocket_postRead(IBVSocket* _this, IBVCommDest* remoteDest,
    list.length = bufLen;
    list.lkey = localMR->lkey;
 
-   wr.wr.rdma.remote_addr = remoteDest->vaddr;
-   wr.wr.rdma.rkey = remoteDest->rkey;
+   wr.wr.rdma.remote_addr = remoteVAddr;
+   wr.wr.rdma.rkey = remoteRKey;
 
    wr.wr_id      = IBVSOCKET_READ_WORK_ID;
    wr.sg_list    = &list;
@@ -1430,17 +1831,20 @@ int __IBVSocket_recvWC(IBVSocket* _this, int timeoutMS, struct ibv_wc* outWC)
 
    // we got something...
 
+   __IBVSocket_onSharedRecvCompletion(commContext);
+
    if(unlikely(outWC->status != IBV_WC_SUCCESS) )
    {
       syslog_fhgfs_connerr(stderr, "%s: Connection error (wc_status: %d; msg: %s)\n",
          "IBVSocket (recv work completion)", (int)outWC->status,
          __IBVSocket_wcStatusStr(outWC->status) );
+      __IBVSocket_recycleSharedRecvWC(commContext, outWC);
       return -1;
    }
 
    bufIndex = outWC->wr_id - IBVSOCKET_RECV_WORK_ID_OFFSET;
 
-   if(unlikely(bufIndex >= commContext->commCfg.bufNum) )
+   if(unlikely(bufIndex >= __IBVSocket_getRecvBufNum(commContext) ) )
    {
       SyslogLogger::log(LOG_WARNING, "%s: Completion for unknown/invalid wr_id %d\n",
          __func__, (int)outWC->wr_id);
@@ -1454,7 +1858,10 @@ int __IBVSocket_recvWC(IBVSocket* _this, int timeoutMS, struct ibv_wc* outWC)
    // flow control
 
    if(unlikely(__IBVSocket_flowControlOnRecv(_this, timeoutMS) ) )
+   {
+      __IBVSocket_recycleSharedRecvWC(commContext, outWC);
       return -1;
+   }
 
    return 1;
 }
@@ -1470,7 +1877,7 @@ int __IBVSocket_flowControlOnRecv(IBVSocket* _this, int timeoutMS)
    IBVCommContext* commContext = _this->commContext;
 
    // we received a packet, so peer has received all of our currently pending data => reset counter
-   commContext->numSendBufsLeft = commContext->commCfg.bufNum - 1; /* (see
+   commContext->numSendBufsLeft = commContext->sendCredits - 1; /* (see
       createCommContext() for "-1" reason) */
 
    // send control packet if recv counter expires...
@@ -1533,7 +1940,7 @@ void __IBVSocket_flowControlOnSendUpdateCounters(IBVSocket* _this)
    IBVCommContext* commContext = _this->commContext;
 
    // we sent a packet, so we received all currently pending data from the peer => reset counter
-   commContext->numReceivedBufsLeft = commContext->commCfg.bufNum - 1; /* (see
+   commContext->numReceivedBufsLeft = commContext->recvCredits - 1; /* (see
       createCommContext() for "-1" reason) */
 
    #ifdef BEEGFS_DEBUG
@@ -1575,6 +1982,7 @@ int __IBVSocket_flowControlOnSendWait(IBVSocket* _this, int timeoutMS)
    { // error (bad length)
       SyslogLogger::log(LOG_WARNING, "%s: received flow control packet length mismatch %d\n",
          __func__, (int)wc.byte_len);
+      __IBVSocket_recycleSharedRecvWC(commContext, &wc);
       return -1;
    }
 
@@ -1889,7 +2297,8 @@ int IBVSocket_checkConnection(IBVSocket* _this)
 
    //printf("%d:%s: post rdma_read to check connection...\n", __LINE__, __func__); // debug in
 
-   postRes = __IBVSocket_postRead(_this, _this->remoteDest, commContext->controlResetMR,
+   postRes = __IBVSocket_postRead(_this, _this->remoteDest->vaddr, _this->remoteDest->rkey,
+      commContext->controlResetMR,
       (char*)&commContext->numUsedSendBufsReset, sizeof(commContext->numUsedSendBufsReset) );
    if(postRes)
    {
@@ -2078,6 +2487,15 @@ void __IBVSocket_close(IBVSocket* _this)
    if(_this->commContext)
       __IBVSocket_cleanupCommContext(_this->cm_id, _this->commContext);
 
+   while(_this->sharedRecvContexts)
+   { // (accepted conns might still hold references, so this won't necessarily destroy them)
+      IBVSharedRecvContext* sharedRecv = _this->sharedRecvContexts;
+
+      _this->sharedRecvContexts = sharedRecv->next;
+
+      __IBVSocket_releaseSharedRecvContext(sharedRecv);
+   }
+
    if(_this->cm_id)
       rdma_destroy_id(_this->cm_id);
    if(_this->cm_channel)
@@ -2189,5 +2607,145 @@ void IBVSocket_setTypeOfService(IBVSocket* _this, uint8_t typeOfService)
    _this->typeOfService = typeOfService;
 }
 
+/**
+ * Let incoming conns of this listen socket receive into a pool of bufs that is shared by all
+ * conns on the same device instead of allocating bufNum*bufSize recv bufs for each conn.
+ *
+ * Note: Call this before listen(). Peers that announce a larger buf size than bufSize still get
+ * private recv bufs.
+ *
+ * @param bufNum 0 to disable shared recv bufs.
+ */
+void IBVSocket_setSharedRecvConfig(IBVSocket* _this, unsigned bufNum, unsigned bufSize)
+{
+   _this->sharedRecvCfg.bufNum = bufNum;
+   _this->sharedRecvCfg.bufSize = bufSize;
+}
+
+/**
+ * @return true if this conn receives into shared bufs
+ */
+bool IBVSocket_getUsesSharedRecv(IBVSocket* _this)
+{
+   return _this->commContext && _this->commContext->sharedRecv;
+}
+
+/**
+ * Register a buffer for one-sided RDMA transfers over this conn. The peer can access the buffer
+ * by its virtual address and IBVBufRegion_getRKey().
+ *
+ * Note: Conns that receive into shared bufs of the same listen socket and device share their
+ * protection domain, so the returned region can be used for all of them (see
+ * IBVSocket_isRegionUsable() ).
+ *
+ * @return NULL on error; deregister via IBVSocket_deregisterBuf() before the conn is destroyed.
+ */
+IBVBufRegion* IBVSocket_registerBuf(IBVSocket* _this, void* buf, size_t bufLen)
+{
+   IBVCommContext* commContext = _this->commContext;
+   IBVBufRegion* region;
+
+   if(unlikely(!commContext || _this->errState) )
+      return NULL;
+
+   region = (IBVBufRegion*)malloc(sizeof(*region) );
+   if(!region)
+      return NULL;
+
+   if(__IBVSocket_registerBuf(commContext->pd, buf, bufLen, &region->mr) )
+   {
+      free(region);
+      return NULL;
+   }
+
+   return region;
+}
+
+void IBVSocket_deregisterBuf(IBVBufRegion* region)
+{
+   if(ibv_dereg_mr(region->mr) )
+      SyslogLogger::log(LOG_WARNING, "%s: Failed to deregister MR\n", __func__);
+
+   free(region);
+}
+
+/**
+ * @return true if the region was registered in the protection domain of this conn.
+ */
+bool IBVSocket_isRegionUsable(IBVSocket* _this, IBVBufRegion* region)
+{
+   return _this->commContext && (region->mr->pd == _this->commContext->pd);
+}
+
+unsigned IBVBufRegion_getRKey(IBVBufRegion* region)
+{
+   return region->mr->rkey;
+}
+
+/**
+ * Synchronous one-sided RDMA write of a local buffer (which must be inside localRegion) into
+ * remote memory that was registered by the peer.
+ *
+ * Note: The peer's CPU is not involved and doesn't get notified, so the transfer needs to be
+ * announced by a normal msg afterwards.
+ *
+ * @return false on error (in which case the conn is invalidated).
+ */
+bool IBVSocket_rdmaWrite(IBVSocket* _this, IBVBufRegion* localRegion,
+   const char* localBuf, size_t bufLen, uint64_t remoteVAddr, unsigned remoteRKey)
+{
+   struct ibv_mr* mr = localRegion->mr;
+
+   if(unlikely(_this->errState) )
+      return false;
+
+   if(unlikely(!IBVSocket_isRegionUsable(_this, localRegion) || (bufLen > INT_MAX) ||
+      (localBuf < (char*)mr->addr) || (localBuf + bufLen > (char*)mr->addr + mr->length) ) )
+   {
+      SyslogLogger::log(LOG_WARNING, "%s: Local buffer not usable for this connection\n",
+         __func__);
+      return false;
+   }
+
+   if(__IBVSocket_postWrite(_this, remoteVAddr, remoteRKey, mr, (char*)localBuf, bufLen) )
+   {
+      _this->errState = -1;
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * Synchronous one-sided RDMA read of remote memory that was registered by the peer into a local
+ * buffer (which must be inside localRegion).
+ *
+ * @return false on error (in which case the conn is invalidated).
+ */
+bool IBVSocket_rdmaRead(IBVSocket* _this, IBVBufRegion* localRegion,
+   char* localBuf, size_t bufLen, uint64_t remoteVAddr, unsigned remoteRKey)
+{
+   struct ibv_mr* mr = localRegion->mr;
+
+   if(unlikely(_this->errState) )
+      return false;
+
+   if(unlikely(!IBVSocket_isRegionUsable(_this, localRegion) || (bufLen > INT_MAX) ||
+      (localBuf < (char*)mr->addr) || (localBuf + bufLen > (char*)mr->addr + mr->length) ) )
+   {
+      SyslogLogger::log(LOG_WARNING, "%s: Local buffer not usable for this connection\n",
+         __func__);
+      return false;
+   }
+
+   if(__IBVSocket_postRead(_this, remoteVAddr, remoteRKey, mr, localBuf, bufLen) )
+   {
+      _this->errState = -1;
+      return false;
+   }
+
+   return true;
+}
+
 #endif // BEEGFS_OPENTK_IBVERBS
 
@@ -41,6 +41,9 @@ typedef struct IBVIncompleteSend IBVIncompleteSend;
 struct IBVCommContext;
 typedef struct IBVCommContext IBVCommContext;
 
+struct IBVSharedRecvContext;
+typedef struct IBVSharedRecvContext IBVSharedRecvContext;
+
 struct IBVCommDest;
 typedef struct IBVCommDest IBVCommDest;
 
@@ -56,22 +59,38 @@ extern IBVSocket* __IBVSocket_constructFromCommContext(struct rdma_cm_id* cm_id,
    IBVCommContext* commContext);
 
 
-extern int __IBVSocket_registerBuf(IBVCommContext* commContext, void* buf, size_t bufLen,
+extern int __IBVSocket_registerBuf(struct ibv_pd* pd, void* buf, size_t bufLen,
    struct ibv_mr **outMR);
-extern char* __IBVSocket_allocAndRegisterBuf(IBVCommContext* commContext, size_t bufLen,
+extern char* __IBVSocket_allocAndRegisterBuf(struct ibv_pd* pd, size_t bufLen,
    struct ibv_mr **outMR);
 
 extern bool __IBVSocket_createCommContext(IBVSocket* _this, struct rdma_cm_id* cm_id,
-   IBVCommConfig* commCfg, IBVCommContext** outCommContext);
+   IBVCommConfig* commCfg, IBVSharedRecvContext* sharedRecv, IBVCommContext** outCommContext);
 extern void __IBVSocket_cleanupCommContext(struct rdma_cm_id* cm_id, IBVCommContext* commContext);
 
+extern IBVSharedRecvContext* __IBVSocket_getSharedRecvContext(IBVSocket* _this,
+   struct ibv_context* context);
+extern IBVSharedRecvContext* __IBVSocket_createSharedRecvContext(struct ibv_context* context,
+   IBVCommConfig* commCfg);
+extern void __IBVSocket_releaseSharedRecvContext(IBVSharedRecvContext* sharedRecv);
+extern int __IBVSocket_postSharedRecv(IBVSharedRecvContext* sharedRecv, size_t bufIndex);
+extern void __IBVSocket_recycleSharedRecvWC(IBVCommContext* commContext, struct ibv_wc* wc);
+extern unsigned __IBVSocket_getSharedRecvCredits(IBVSharedRecvContext* sharedRecv,
+   unsigned maxCredits);
+extern void __IBVSocket_armSharedRecvLimit(IBVSharedRecvContext* sharedRecv);
+extern void __IBVSocket_onSharedRecvCompletion(IBVCommContext* commContext);
+extern void __IBVSocket_handleAsyncEvents(IBVSharedRecvContext* sharedRecv);
+
+extern char* __IBVSocket_getRecvBuf(IBVCommContext* commContext, size_t bufIndex);
+extern unsigned __IBVSocket_getRecvBufNum(IBVCommContext* commContext);
+
 extern void __IBVSocket_initCommDest(IBVCommContext* commContext, IBVCommDest* outDest);
 extern bool __IBVSocket_parseCommDest(const void* buf, size_t bufLen, IBVCommDest** outDest);
 
 extern int __IBVSocket_postRecv(IBVSocket* _this, IBVCommContext* commContext, size_t bufIndex);
-extern int __IBVSocket_postWrite(IBVSocket* _this, IBVCommDest* remoteDest,
+extern int __IBVSocket_postWrite(IBVSocket* _this, uint64_t remoteVAddr, unsigned remoteRKey,
    struct ibv_mr* localMR, char* localBuf, int bufLen);
-extern int __IBVSocket_postRead(IBVSocket* _this, IBVCommDest* remoteDest,
+extern int __IBVSocket_postRead(IBVSocket* _this, uint64_t remoteVAddr, unsigned remoteRKey,
    struct ibv_mr* localMR, char* localBuf, int bufLen);
 extern int __IBVSocket_postSend(IBVSocket* _this, size_t bufIndex, int bufLen);
 extern int __IBVSocket_recvWC(IBVSocket* _this, int timeoutMS, struct ibv_wc* outWC);
@@ -111,7 +130,8 @@ struct IBVIncompleteSend
 struct IBVCommContext
 {
    struct ibv_context*        context;
-   struct ibv_pd*             pd; // protection domain
+   struct ibv_pd*             pd; // protection domain (owned by sharedRecv if that is set)
+   IBVSharedRecvContext*      sharedRecv; // NULL if we have our own recvBufs (we hold a ref)
    struct ibv_mr*             recvMR; // recvBuf mem region
    struct ibv_mr*             sendMR; // sendBuf mem region
    struct ibv_mr*             controlMR; // flow/flood control mem region
@@ -126,7 +146,7 @@ struct IBVCommContext
 
    IBVCommConfig              commCfg;
    char*                      recvBuf; // large alloc'ed and reg'ed buffer for recvBufs
-   char**                     recvBufs; // points to chunks inside recvBuf
+   char**                     recvBufs; // points to chunks inside recvBuf (NULL if sharedRecv)
    char*                      sendBuf; // large alloc'ed and reg'ed buffer for sendBufs
    char**                     sendBufs; // points to chunks inside sendBuf
    volatile uint64_t          numUsedSendBufs; // sender's flow/flood control counter (volatile!!)
@@ -134,11 +154,44 @@ struct IBVCommContext
    uint64_t                   numUsedRecvBufs; // receiver's flow/flood control (reset) counter
    unsigned                   numReceivedBufsLeft; // flow control v2 to avoid IB rnr timeout
    unsigned                   numSendBufsLeft; // flow control v2 to avoid IB rnr timeout
+   unsigned                   recvCredits; // msgs the peer may send before we ack
+   unsigned                   sendCredits; // msgs we may send before the peer acks
 
    IBVIncompleteRecv          incompleteRecv;
    IBVIncompleteSend          incompleteSend;
 };
 
+/**
+ * Receive buffers that are shared by all incoming conns of a listen socket on the same device
+ * (via a shared receive queue), so that the memory for receive buffers doesn't grow with the
+ * number of connected clients.
+ *
+ * Note: All conns that use this also use its protection domain, so memory regions registered
+ * through one of them can be used for RDMA transfers on all of them.
+ */
+struct IBVSharedRecvContext
+{
+   struct ibv_context*        context; // (not owned)
+   struct ibv_pd*             pd; // protection domain for all conns using this context
+   struct ibv_srq*            srq; // shared receive queue
+   struct ibv_mr*             recvMR; // recvBuf mem region
+   char*                      recvBuf; // large alloc'ed and reg'ed buffer for the shared bufs
+
+   IBVCommConfig              commCfg; // number and size of shared bufs
+   volatile int               refCount; // listener + each conn (modified via atomic ops)
+
+   volatile int               numPostedBufs; // bufs currently in the srq (modified via atomic ops)
+   unsigned                   limit; // srq limit event threshold (0 if unsupported by the device)
+   volatile int               limitArmed; // 1 while the limit event is armed (atomic ops)
+
+   IBVSharedRecvContext*      next; // context of the next device of the same listener
+};
+
+struct IBVBufRegion
+{
+   struct ibv_mr*             mr;
+};
+
 #pragma pack(push, 1)
 // Note: Make sure this struct has the same size on all architectures (because we use
 //    sizeof(IBVCommDest) for private_data during handshake)
@@ -170,6 +223,9 @@ struct IBVSocket
    CmEventQueue*                 delayedCmEventsQ;
 
    uint8_t                       typeOfService;
+
+   IBVCommConfig                 sharedRecvCfg; // bufNum 0 means disabled (listeners only)
+   IBVSharedRecvContext*         sharedRecvContexts; // list, one per device (listeners only)
 };
 
 
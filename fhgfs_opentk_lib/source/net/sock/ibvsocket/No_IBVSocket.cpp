@@ -135,5 +135,45 @@ void IBVSocket_setTypeOfService(IBVSocket* _this, uint8_t typeOfService)
 {
 }
 
+void IBVSocket_setSharedRecvConfig(IBVSocket* _this, unsigned bufNum, unsigned bufSize)
+{
+}
+
+bool IBVSocket_getUsesSharedRecv(IBVSocket* _this)
+{
+   return false;
+}
+
+IBVBufRegion* IBVSocket_registerBuf(IBVSocket* _this, void* buf, size_t bufLen)
+{
+   return NULL;
+}
+
+void IBVSocket_deregisterBuf(IBVBufRegion* region)
+{
+}
+
+bool IBVSocket_isRegionUsable(IBVSocket* _this, IBVBufRegion* region)
+{
+   return false;
+}
+
+unsigned IBVBufRegion_getRKey(IBVBufRegion* region)
+{
+   return 0;
+}
+
+bool IBVSocket_rdmaWrite(IBVSocket* _this, IBVBufRegion* localRegion,
+   const char* localBuf, size_t bufLen, uint64_t remoteVAddr, unsigned remoteRKey)
+{
+   return false;
+}
+
+bool IBVSocket_rdmaRead(IBVSocket* _this, IBVBufRegion* localRegion,
+   char* localBuf, size_t bufLen, uint64_t remoteVAddr, unsigned remoteRKey)
+{
+   return false;
+}
+
 #endif // BEEGFS_OPENTK_IBVERBS
 
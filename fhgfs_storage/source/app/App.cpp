@@ -44,6 +44,7 @@ unsigned const APP_FEATURES[] =
 {
    STORAGE_FEATURE_DUMMY,
    STORAGE_FEATURE_REMOVEBUDDYGROUP,
+   STORAGE_FEATURE_CHUNKATTRIBSMULTI,
 };
 
 
@@ -94,6 +95,9 @@ App::App(int argc, char** argv)
 
    this->workersRunning = false;
 
+   this->writeSlaveQueue = NULL;
+   this->ioUringEngine = NULL;
+
    this->exceededQuotaStore = NULL;
    this->buddyResyncer = NULL;
    this->chunkLockStore = NULL;
@@ -108,6 +112,7 @@ App::~App()
    // from class Program (so the thread-specific app-pointer isn't set in this context).
 
    workersDelete();
+   writeSlavesDelete();
 
    SAFE_DELETE(this->buddySyncer);
    SAFE_DELETE(this->internodeSyncer);
@@ -131,6 +136,9 @@ App::~App()
    for(MultiWorkQueueMapIter iter = workQueueMap.begin(); iter != workQueueMap.end(); iter++)
       delete(iter->second);
 
+   SAFE_DELETE(this->writeSlaveQueue);
+   SAFE_DELETE(this->ioUringEngine);
+
    SAFE_DELETE(this->hsmNodes);
    SAFE_DELETE(this->storageNodes);
    SAFE_DELETE(this->metaNodes);
@@ -681,6 +689,27 @@ void App::initPostTargetRegistration() throw(InvalidConfigException)
       if(cfg->getTuneUsePerUserMsgQueues() )
          workQueueMap[*iter]->setIndirectWorkList(new UserWorkContainer() );
    }
+
+   // io_uring engine (falls back to regular syscalls if the kernel doesn't support it)
+
+   if(cfg->getTuneUseIoUring() )
+   {
+      try
+      {
+         this->ioUringEngine = new IoUringEngine(cfg->getTuneIoUringQueueDepth() );
+      }
+      catch(ComponentInitException& e)
+      {
+         log->log(Log_WARNING, std::string("Unable to use io_uring, falling back to regular IO. ") +
+            "(" + e.what() + ")");
+      }
+   }
+
+   // pipelined writes need a separate queue for the disk write slaves (unless done via io_uring)
+
+   if( (cfg->getTuneFileWritePipelineDepth() > 1) && cfg->getTuneNumWriteSlaves() &&
+       !this->ioUringEngine)
+      this->writeSlaveQueue = new MultiWorkQueue();
 }
 
 void App::initComponents() throw(ComponentInitException)
@@ -714,6 +743,7 @@ void App::initComponents() throw(ComponentInitException)
    this->buddyResyncer = new BuddyResyncer();
 
    workersInit();
+   writeSlavesInit();
 
    this->log->log(Log_DEBUG, "Components initialized.");
 }
@@ -738,6 +768,10 @@ void App::startComponents()
 
    this->buddySyncer->start();
 
+   if(ioUringEngine)
+      ioUringEngine->start();
+
+   writeSlavesStart();
    workersStart();
 
    PThread::unblockInterruptSignals(); // main app thread may receive SIGINT/SIGTERM
@@ -817,6 +851,11 @@ void App::joinComponents()
 
    workersJoin();
 
+   /* (write slaves are stopped only after the workers terminated, because a worker might still be
+      waiting for a pipelined disk write to complete) */
+   writeSlavesStop();
+   writeSlavesJoin();
+
    // (the ChunkFetcher is not a normal component, so it gets special treatment here)
    if(chunkFetcher)
       chunkFetcher->waitForStopFetching();
@@ -838,6 +877,14 @@ void App::joinComponents()
    if(storageBenchOperator)
       storageBenchOperator->waitForShutdownBenchmark();
 
+   /* (the io_uring engine is stopped last, because every component above might still be waiting
+      for a submitted request, e.g. resyncer read-ahead or workers with pipelined writes) */
+   if(ioUringEngine)
+   {
+      ioUringEngine->stopReaping();
+      ioUringEngine->join();
+   }
+
    closeLibZfs();
 }
 
@@ -856,6 +903,9 @@ void App::streamListenersInit() throw(ComponentInitException)
       if(cfg->getTuneUseAggressiveStreamPoll() )
          listener->setUseAggressivePoll();
 
+      if(cfg->getTuneDrainPipelinedMsgs() )
+         listener->setDrainPipelinedMsgs();
+
       streamLisVec.push_back(listener);
    }
 }
@@ -990,6 +1040,74 @@ void App::workersJoin()
    lock.unlock(); // U N L O C K
 }
 
+/**
+ * Note: Does nothing if pipelined writes are disabled (i.e. writeSlaveQueue is NULL).
+ */
+void App::writeSlavesInit() throw(ComponentInitException)
+{
+   if(!writeSlaveQueue)
+      return;
+
+   unsigned numWriteSlaves = cfg->getTuneNumWriteSlaves();
+
+   for(unsigned i=0; i < numWriteSlaves; i++)
+   {
+      Worker* worker = new Worker(
+         std::string("WriteSlave") + StringTk::uintToStr(i+1), writeSlaveQueue,
+         QueueWorkType_DIRECT);
+
+      worker->setBufLens(0, 0); // write slaves work on the buffers of the calling worker
+
+      writeSlaveList.push_back(worker);
+   }
+}
+
+void App::writeSlavesStart()
+{
+   unsigned numNumaNodes = System::getNumNumaNodes();
+
+   for(WorkerListIter iter = writeSlaveList.begin(); iter != writeSlaveList.end(); iter++)
+   {
+      if(cfg->getTuneWorkerNumaAffinity() )
+         (*iter)->startOnNumaNode( (++nextNumaBindTarget) % numNumaNodes);
+      else
+         (*iter)->start();
+   }
+}
+
+void App::writeSlavesStop()
+{
+   // need two loops because we don't know if the worker that handles the work will be the same that
+   // received the self-terminate-request
+   for(WorkerListIter iter = writeSlaveList.begin(); iter != writeSlaveList.end(); iter++)
+   {
+      (*iter)->selfTerminate();
+   }
+
+   for(WorkerListIter iter = writeSlaveList.begin(); iter != writeSlaveList.end(); iter++)
+   {
+      writeSlaveQueue->addDirectWork(new DummyWork() );
+   }
+}
+
+void App::writeSlavesDelete()
+{
+   for(WorkerListIter iter = writeSlaveList.begin(); iter != writeSlaveList.end(); iter++)
+   {
+      delete(*iter);
+   }
+
+   writeSlaveList.clear();
+}
+
+void App::writeSlavesJoin()
+{
+   for(WorkerListIter iter = writeSlaveList.begin(); iter != writeSlaveList.end(); iter++)
+   {
+      waitForComponentTermination(*iter);
+   }
+}
+
 void App::logInfos()
 {
    // print software version (BEEGFS_VERSION)
@@ -1101,6 +1219,10 @@ void App::registerSignalHandler()
 {
    signal(SIGINT, App::signalHandler);
    signal(SIGTERM, App::signalHandler);
+
+   /* sendfile() has no MSG_NOSIGNAL equivalent, so a client that disconnects during a zero-copy
+      read would kill us with SIGPIPE (we get EPIPE instead when the signal is ignored) */
+   signal(SIGPIPE, SIG_IGN);
 }
 
 void App::signalHandler(int sig)
@@ -20,6 +20,7 @@
 #include <components/benchmarker/StorageBenchOperator.h>
 #include <components/buddyresyncer/BuddyResyncer.h>
 #include <components/chunkfetcher/ChunkFetcher.h>
+#include <components/iouring/IoUringEngine.h>
 #include <components/BuddySyncer.h>
 #include <components/DatagramListener.h>
 #include <components/HeartbeatManager.h>
@@ -105,6 +106,8 @@ class App : public AbstractApp
       TargetStateStore* targetStateStore; // map storage targets to a state
 
       MultiWorkQueueMap workQueueMap; // maps targetIDs to WorkQueues
+      MultiWorkQueue* writeSlaveQueue; // NULL if pipelined writes are disabled or use io_uring
+      IoUringEngine* ioUringEngine; // NULL if io_uring is disabled or not supported
       SessionStore* sessions;
       StorageNodeOpStats* nodeOperationStats; // file system operation statistics
       AcknowledgmentStore* ackStore;
@@ -127,6 +130,7 @@ class App : public AbstractApp
       StreamLisVec streamLisVec;
 
       WorkerList workerList;
+      WorkerList writeSlaveList; // used by workers for pipelined disk writes
       bool workersRunning;
       Mutex mutexWorkersRunning;
 
@@ -163,6 +167,12 @@ class App : public AbstractApp
       void workersDelete();
       void workersJoin();
 
+      void writeSlavesInit() throw(ComponentInitException);
+      void writeSlavesStart();
+      void writeSlavesStop();
+      void writeSlavesDelete();
+      void writeSlavesJoin();
+
       void initLogging() throw(InvalidConfigException);
       void initDataObjects() throw(InvalidConfigException);
       void initBasicNetwork();
@@ -321,6 +331,22 @@ class App : public AbstractApp
          return &workQueueMap;
       }
 
+      /**
+       * @return NULL if pipelined writes are disabled or done via io_uring
+       */
+      MultiWorkQueue* getWriteSlaveQueue() const
+      {
+         return writeSlaveQueue;
+      }
+
+      /**
+       * @return NULL if chunk file IO uses the regular syscalls
+       */
+      IoUringEngine* getIoUringEngine() const
+      {
+         return ioUringEngine;
+      }
+
       SessionStore* getSessions() const
       {
          return sessions;
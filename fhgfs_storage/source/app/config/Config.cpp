@@ -46,14 +46,22 @@ void Config::loadDefaults(bool addDashes)
    configMapRedefine("tuneFileReadSize",              "32k");
    configMapRedefine("tuneFileReadAheadTriggerSize",  "4m");
    configMapRedefine("tuneFileReadAheadSize",         "0");
+   configMapRedefine("tuneFileReadZeroCopy",          "false");
    configMapRedefine("tuneFileWriteSize",             "64k");
    configMapRedefine("tuneFileWriteSyncSize",         "0");
+   configMapRedefine("tuneFileWritePipelineDepth",    "1");
+   configMapRedefine("tuneNumWriteSlaves",            "8");
+   configMapRedefine("tuneUseIoUring",                "false");
+   configMapRedefine("tuneIoUringQueueDepth",         "256");
    configMapRedefine("tuneUsePerUserMsgQueues",       "false");
    configMapRedefine("tuneDirCacheLimit",             "1024");
    configMapRedefine("tuneEarlyStat",                 "false");
    configMapRedefine("tuneNumResyncSlaves",           "12");
+   configMapRedefine("tuneResyncDeltaSync",           "false");
+   configMapRedefine("tuneResyncStreamWindowSize",    "0");
    configMapRedefine("tuneNumResyncGatherSlaves",     "6");
    configMapRedefine("tuneUseAggressiveStreamPoll",   "false");
+   configMapRedefine("tuneDrainPipelinedMsgs",        "false");
    configMapRedefine("tuneUsePerTargetWorkers",       "true");
 
    configMapRedefine("quotaEnableEnforcement",        "false");
@@ -143,12 +151,27 @@ void Config::applyConfigMap(bool enableException, bool addDashes) throw(InvalidC
       if(iter->first == std::string("tuneFileReadAheadSize") )
          tuneFileReadAheadSize = UnitTk::strHumanToInt64(iter->second);
       else
+      if(iter->first == std::string("tuneFileReadZeroCopy") )
+         tuneFileReadZeroCopy = StringTk::strToBool(iter->second);
+      else
       if(iter->first == std::string("tuneFileWriteSize") )
          tuneFileWriteSize = UnitTk::strHumanToInt64(iter->second);
       else
       if(iter->first == std::string("tuneFileWriteSyncSize") )
          tuneFileWriteSyncSize = UnitTk::strHumanToInt64(iter->second);
       else
+      if(iter->first == std::string("tuneFileWritePipelineDepth") )
+         tuneFileWritePipelineDepth = StringTk::strToUInt(iter->second);
+      else
+      if(iter->first == std::string("tuneNumWriteSlaves") )
+         tuneNumWriteSlaves = StringTk::strToUInt(iter->second);
+      else
+      if(iter->first == std::string("tuneUseIoUring") )
+         tuneUseIoUring = StringTk::strToBool(iter->second);
+      else
+      if(iter->first == std::string("tuneIoUringQueueDepth") )
+         tuneIoUringQueueDepth = StringTk::strToUInt(iter->second);
+      else
       if(iter->first == std::string("tuneUsePerUserMsgQueues") )
          tuneUsePerUserMsgQueues = StringTk::strToBool(iter->second);
       else
@@ -164,9 +187,18 @@ void Config::applyConfigMap(bool enableException, bool addDashes) throw(InvalidC
       if (iter->first == std::string("tuneNumResyncSlaves") )
          this->tuneNumResyncSlaves = StringTk::strToUInt(iter->second);
       else
+      if (iter->first == std::string("tuneResyncDeltaSync") )
+         this->tuneResyncDeltaSync = StringTk::strToBool(iter->second);
+      else
+      if (iter->first == std::string("tuneResyncStreamWindowSize") )
+         this->tuneResyncStreamWindowSize = UnitTk::strHumanToInt64(iter->second);
+      else
       if(iter->first == std::string("tuneUseAggressiveStreamPoll") )
          tuneUseAggressiveStreamPoll = StringTk::strToBool(iter->second);
       else
+      if(iter->first == std::string("tuneDrainPipelinedMsgs") )
+         tuneDrainPipelinedMsgs = StringTk::strToBool(iter->second);
+      else
       if(iter->first == std::string("tuneUsePerTargetWorkers") )
          tuneUsePerTargetWorkers = StringTk::strToBool(iter->second);
       else
@@ -215,6 +247,21 @@ void Config::initImplicitVals() throw(InvalidConfigException)
    if(tuneFileReadAheadTriggerSize < tuneFileReadAheadSize)
       tuneFileReadAheadTriggerSize = tuneFileReadAheadSize;
 
+   // tuneFileWritePipelineDepth (0 makes no sense, so treat it like 1 => disabled)
+   if(!tuneFileWritePipelineDepth)
+      tuneFileWritePipelineDepth = 1;
+
+   // tuneIoUringQueueDepth (io_uring doesn't accept empty rings)
+   if(!tuneIoUringQueueDepth)
+      tuneIoUringQueueDepth = 1;
+
+   // tuneResyncStreamWindowSize (the data length of a resync msg is a 32bit value)
+   if(tuneResyncStreamWindowSize < 0)
+      tuneResyncStreamWindowSize = 0;
+   else
+   if(tuneResyncStreamWindowSize > (1024*1024*1024) )
+      tuneResyncStreamWindowSize = 1024*1024*1024;
+
    // connInterfacesList(/File)
    AbstractConfig::initInterfacesList(connInterfacesFile, connInterfacesList);
 
@@ -49,14 +49,22 @@ class Config : public AbstractConfig
       ssize_t     tuneFileReadSize;
       ssize_t     tuneFileReadAheadTriggerSize; // after how much seq read to start read-ahead
       ssize_t     tuneFileReadAheadSize; // read-ahead with posix_fadvise(..., POSIX_FADV_WILLNEED)
+      bool        tuneFileReadZeroCopy; // true to sendfile() chunk data to TCP sockets
       ssize_t     tuneFileWriteSize;
       ssize_t     tuneFileWriteSyncSize; // after how many of per session data to sync_file_range()
+      unsigned    tuneFileWritePipelineDepth; // number of write buffers per worker (1 disables)
+      unsigned    tuneNumWriteSlaves; // threads for disk writes of pipelined worker writes
+      bool        tuneUseIoUring; // true to do chunk file IO through the IoUringEngine
+      unsigned    tuneIoUringQueueDepth; // max number of io_uring requests in flight
       bool        tuneUsePerUserMsgQueues; // true to use UserWorkContainer for MultiWorkQueue
       unsigned    tuneDirCacheLimit;
       bool        tuneEarlyStat;          // stat the chunk file before closing it
       unsigned    tuneNumResyncGatherSlaves;
       unsigned    tuneNumResyncSlaves;
+      bool        tuneResyncDeltaSync; // true to only transfer changed blocks of chunks in resync
+      int64_t     tuneResyncStreamWindowSize; // max unacked resync bytes per slave (0 disables)
       bool        tuneUseAggressiveStreamPoll; // true to not sleep on epoll in streamlisv2
+      bool        tuneDrainPipelinedMsgs; // true to dispatch pipelined msgs of a conn directly
       bool        tuneUsePerTargetWorkers; // true to have tuneNumWorkers separate for each target
 
       bool        quotaEnableEnforcement;
@@ -178,6 +186,11 @@ class Config : public AbstractConfig
          return tuneFileReadAheadSize;
       }
 
+      bool getTuneFileReadZeroCopy() const
+      {
+         return tuneFileReadZeroCopy;
+      }
+
       ssize_t getTuneFileWriteSize() const
       {
          return tuneFileWriteSize;
@@ -188,6 +201,26 @@ class Config : public AbstractConfig
          return this->tuneFileWriteSyncSize;
       }
 
+      unsigned getTuneFileWritePipelineDepth() const
+      {
+         return tuneFileWritePipelineDepth;
+      }
+
+      unsigned getTuneNumWriteSlaves() const
+      {
+         return tuneNumWriteSlaves;
+      }
+
+      bool getTuneUseIoUring() const
+      {
+         return tuneUseIoUring;
+      }
+
+      unsigned getTuneIoUringQueueDepth() const
+      {
+         return tuneIoUringQueueDepth;
+      }
+
       bool getTuneUsePerUserMsgQueues() const
       {
          return tuneUsePerUserMsgQueues;
@@ -238,11 +271,26 @@ class Config : public AbstractConfig
          return tuneNumResyncSlaves;
       }
 
+      bool getTuneResyncDeltaSync() const
+      {
+         return tuneResyncDeltaSync;
+      }
+
+      int64_t getTuneResyncStreamWindowSize() const
+      {
+         return tuneResyncStreamWindowSize;
+      }
+
       bool getTuneUseAggressiveStreamPoll() const
       {
          return tuneUseAggressiveStreamPoll;
       }
 
+      bool getTuneDrainPipelinedMsgs() const
+      {
+         return tuneDrainPipelinedMsgs;
+      }
+
       bool getTuneUsePerTargetWorkers() const
       {
          return tuneUsePerTargetWorkers;
@@ -0,0 +1,122 @@
+#ifndef STORAGEBENCHLATENCYHISTOGRAM_H_
+#define STORAGEBENCHLATENCYHISTOGRAM_H_
+
+#include <common/Common.h>
+
+
+#define STORAGEBENCHLATENCYHISTOGRAM_SUB_BITS      3 // log2 of number of buckets per power of two
+#define STORAGEBENCHLATENCYHISTOGRAM_SUB_BUCKETS   (1 << STORAGEBENCHLATENCYHISTOGRAM_SUB_BITS)
+#define STORAGEBENCHLATENCYHISTOGRAM_NUM_BUCKETS \
+   ( (64 - STORAGEBENCHLATENCYHISTOGRAM_SUB_BITS + 1) * STORAGEBENCHLATENCYHISTOGRAM_SUB_BUCKETS)
+
+
+/**
+ * Log-linear histogram of operation latencies (in microseconds) for percentile calculation.
+ *
+ * Each power of two range is split into a fixed number of linear sub-buckets, so that the
+ * relative error of a percentile is at most 1/STORAGEBENCHLATENCYHISTOGRAM_SUB_BUCKETS while
+ * adding a value is only a few instructions without any allocation.
+ *
+ * Note: Not thread-safe; each benchmark thread has its own histogram and the histograms are
+ * merged for the results.
+ */
+class StorageBenchLatencyHistogram
+{
+   public:
+      StorageBenchLatencyHistogram()
+      {
+         reset();
+      }
+
+
+   private:
+      uint64_t buckets[STORAGEBENCHLATENCYHISTOGRAM_NUM_BUCKETS];
+      uint64_t numValues;
+
+
+      static unsigned valueToBucketIndex(uint64_t value)
+      {
+         if(value < STORAGEBENCHLATENCYHISTOGRAM_SUB_BUCKETS)
+            return value; // small values have their own bucket
+
+         unsigned log2Value = 63 - __builtin_clzll(value);
+         unsigned shift = log2Value - STORAGEBENCHLATENCYHISTOGRAM_SUB_BITS;
+         unsigned subBucket = (value >> shift) & (STORAGEBENCHLATENCYHISTOGRAM_SUB_BUCKETS - 1);
+
+         return ( (shift + 1) << STORAGEBENCHLATENCYHISTOGRAM_SUB_BITS) + subBucket;
+      }
+
+      /**
+       * @return the largest value that belongs to the given bucket.
+       */
+      static uint64_t bucketIndexToMaxValue(unsigned index)
+      {
+         if(index < STORAGEBENCHLATENCYHISTOGRAM_SUB_BUCKETS)
+            return index;
+
+         unsigned shift = (index >> STORAGEBENCHLATENCYHISTOGRAM_SUB_BITS) - 1;
+         uint64_t subBucket = index & (STORAGEBENCHLATENCYHISTOGRAM_SUB_BUCKETS - 1);
+         uint64_t minValue = (STORAGEBENCHLATENCYHISTOGRAM_SUB_BUCKETS + subBucket) << shift;
+
+         return minValue + ( (1ULL << shift) - 1);
+      }
+
+
+   public:
+      // inliners
+
+      void reset()
+      {
+         memset(buckets, 0, sizeof(buckets) );
+         numValues = 0;
+      }
+
+      void addValue(uint64_t valueMicro)
+      {
+         buckets[valueToBucketIndex(valueMicro)]++;
+         numValues++;
+      }
+
+      void merge(const StorageBenchLatencyHistogram& other)
+      {
+         for(unsigned i=0; i < STORAGEBENCHLATENCYHISTOGRAM_NUM_BUCKETS; i++)
+            buckets[i] += other.buckets[i];
+
+         numValues += other.numValues;
+      }
+
+      /**
+       * @param permille e.g. 500 for the median or 999 for the 99.9th percentile.
+       * @return upper bound of the latency (in microseconds) of the bucket that contains the
+       *    requested percentile; 0 if the histogram is empty.
+       */
+      uint64_t getPercentile(unsigned permille) const
+      {
+         if(!numValues)
+            return 0;
+
+         // number of values that are less than or equal to the requested percentile (rounded up)
+         uint64_t rank = (numValues * permille + 999) / 1000;
+         uint64_t count = 0;
+
+         if(!rank)
+            rank = 1;
+
+         for(unsigned i=0; i < STORAGEBENCHLATENCYHISTOGRAM_NUM_BUCKETS; i++)
+         {
+            count += buckets[i];
+
+            if(count >= rank)
+               return bucketIndexToMaxValue(i);
+         }
+
+         return bucketIndexToMaxValue(STORAGEBENCHLATENCYHISTOGRAM_NUM_BUCKETS - 1);
+      }
+
+      uint64_t getNumValues() const
+      {
+         return numValues;
+      }
+};
+
+#endif /* STORAGEBENCHLATENCYHISTOGRAM_H_ */
@@ -2,9 +2,10 @@
 
 
 int StorageBenchOperator::initAndStartStorageBench(UInt16List* targetIDs, int64_t blocksize,
-   int64_t size, int threads, StorageBenchType type)
+   int64_t size, int threads, int readPercent, StorageBenchType type)
 {
-   return this->slave.initAndStartStorageBench(targetIDs, blocksize, size, threads, type);
+   return this->slave.initAndStartStorageBench(targetIDs, blocksize, size, threads, readPercent,
+      type);
 }
 
 int StorageBenchOperator::cleanup(UInt16List* targetIDs)
@@ -18,9 +19,9 @@ int StorageBenchOperator::stopBenchmark()
 }
 
 StorageBenchStatus StorageBenchOperator::getStatusWithResults(UInt16List* targetIDs,
-   StorageBenchResultsMap* outResults)
+   StorageBenchResultsMap* outResults, StorageBenchLatencyResultsMap* outLatencyResults)
 {
-   return this->slave.getStatusWithResults(targetIDs, outResults);
+   return this->slave.getStatusWithResults(targetIDs, outResults, outLatencyResults);
 }
 
 void StorageBenchOperator::shutdownBenchmark()
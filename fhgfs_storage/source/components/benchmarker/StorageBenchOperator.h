@@ -11,12 +11,12 @@ class StorageBenchOperator
       StorageBenchOperator() {}
 
       int initAndStartStorageBench(UInt16List* targetIDs, int64_t blocksize, int64_t size,
-         int threads, StorageBenchType type);
+         int threads, int readPercent, StorageBenchType type);
 
       int cleanup(UInt16List* targetIDs);
       int stopBenchmark();
       StorageBenchStatus getStatusWithResults(UInt16List* targetIDs,
-         StorageBenchResultsMap* outResults);
+         StorageBenchResultsMap* outResults, StorageBenchLatencyResultsMap* outLatencyResults);
       void shutdownBenchmark();
       void waitForShutdownBenchmark();
 
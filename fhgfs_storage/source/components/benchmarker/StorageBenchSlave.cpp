@@ -18,12 +18,13 @@
  * @param blocksize the blocksize for the benchmark
  * @param size the size for the benchmark
  * @param threads the number (simulated clients) of threads for the benchmark
+ * @param readPercent the percentage of reads for the mixed random benchmark
  * @param type the type of the benchmark
  * @return the error code, 0 if the benchmark was initialize successful (STORAGEBENCH_ERROR..)
  *
  */
 int StorageBenchSlave::initAndStartStorageBench(UInt16List* targetIDs, int64_t blocksize,
-   int64_t size, int threads, StorageBenchType type)
+   int64_t size, int threads, int readPercent, StorageBenchType type)
 {
    const char* logContext = "Storage Benchmark (init)";
 
@@ -44,7 +45,7 @@ int StorageBenchSlave::initAndStartStorageBench(UInt16List* targetIDs, int64_t b
    }
    else
    {
-      retVal = initStorageBench(targetIDs, blocksize, size, threads, type);
+      retVal = initStorageBench(targetIDs, blocksize, size, threads, readPercent, type);
    }
 
    if(retVal == STORAGEBENCH_ERROR_NO_ERROR)
@@ -92,21 +93,40 @@ int StorageBenchSlave::initAndStartStorageBench(UInt16List* targetIDs, int64_t b
  * @param blocksize the blocksize for the benchmark
  * @param size the size for the benchmark
  * @param threads the number (simulated clients) of threads for the benchmark
+ * @param readPercent the percentage of reads for the mixed random benchmark
  * @param type the type of the benchmark
  * @return the error code, 0 if the benchmark was initialize successful (STORAGEBENCH_ERROR..)
  *
  */
 int StorageBenchSlave::initStorageBench(UInt16List* targetIDs, int64_t blocksize,
-   int64_t size, int threads, StorageBenchType type)
+   int64_t size, int threads, int readPercent, StorageBenchType type)
 {
    const char* logContext = "Storage Benchmark (init)";
    LogContext(logContext).log(Log_DEBUG, "Initializing benchmark ...");
 
+   if( (blocksize <= 0) || (size <= 0) || (threads <= 0) ||
+       (readPercent < 0) || (readPercent > 100) )
+   {
+      LogContext(logContext).logErr("Invalid benchmark parameters. "
+         "Blocksize: " + StringTk::int64ToStr(blocksize) + "; "
+         "Size: " + StringTk::int64ToStr(size) + "; "
+         "Threads: " + StringTk::intToStr(threads) + "; "
+         "Read percentage: " + StringTk::intToStr(readPercent) );
+
+      this->lastRunErrorCode = STORAGEBENCH_ERROR_INITIALIZATION_ERROR;
+      this->status = StorageBenchStatus_ERROR;
+      return STORAGEBENCH_ERROR_INITIALIZATION_ERROR;
+   }
+
+   // note: targetIDs belongs to the caller, so we need our own copy
+   SAFE_DELETE(this->targetIDs);
+
    this->benchType = type;
-   this->targetIDs = targetIDs;
+   this->targetIDs = new UInt16List(*targetIDs);
    this->blocksize = blocksize;
    this->size = size;
    this->numThreads = threads;
+   this->readPercent = readPercent;
    this->numThreadsDone = 0;
 
    initThreadData();
@@ -118,7 +138,7 @@ int StorageBenchSlave::initStorageBench(UInt16List* targetIDs, int64_t blocksize
       return STORAGEBENCH_ERROR_INIT_TRANSFER_DATA;
    }
 
-   if (this->benchType == StorageBenchType_READ)
+   if (STORAGEBENCHTYPE_NEEDS_DATA(this->benchType) )
    {
       if (!checkReadData())
       {
@@ -132,7 +152,9 @@ int StorageBenchSlave::initStorageBench(UInt16List* targetIDs, int64_t blocksize
       }
    }
    else
-   if (this->benchType == StorageBenchType_WRITE)
+   if ( (this->benchType == StorageBenchType_WRITE) ||
+        (this->benchType == StorageBenchType_RANDWRITE) ||
+        (this->benchType == StorageBenchType_CREATE) )
    {
       if (!createBenchmarkFolder() )
       {
@@ -215,7 +237,7 @@ void StorageBenchSlave::initThreadData()
          data.targetID = *iter;
          data.targetThreadID = threadCount;
          data.engagedSize = 0;
-         data.fileDescriptor = 0;
+         data.fileDescriptor = -1;
          data.neededTime = 0;
 
 
@@ -255,9 +277,7 @@ void StorageBenchSlave::run()
          LOG_DEBUG(logContext, Log_DEBUG, std::string("- type: ") +
             StringTk::intToStr(this->benchType) );
 
-         StorageBenchWork* work = new StorageBenchWork(iter->second.targetID, iter->first,
-            iter->second.fileDescriptor, this->benchType, getNextPackageSize(iter->first),
-            this->threadCommunication, this->transferData);
+         StorageBenchWork* work = createWork(iter->first, getNextPackageSize(iter->first) );
 
          app->getWorkQueue(iter->second.targetID)->addIndirectWork(work);
       }
@@ -333,9 +353,7 @@ void StorageBenchSlave::run()
          // data size for the thread is bigger then 0
          if (workSize != 0)
          {
-            StorageBenchWork* work = new StorageBenchWork(currentData->targetID, threadID,
-               currentData->fileDescriptor, this->benchType, workSize, this->threadCommunication,
-               this->transferData);
+            StorageBenchWork* work = createWork(threadID, workSize);
             app->getWorkQueue(currentData->targetID)->addIndirectWork(work);
          }
          else
@@ -502,6 +520,9 @@ bool StorageBenchSlave::openFiles(void)
    StorageTargets* storageTargets = Program::getApp()->getStorageTargets();
    mode_t openMode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
 
+   if(this->benchType == StorageBenchType_CREATE)
+      return true; // each work creates its own file
+
    for(StorageBenchThreadDataMapIter iter = threadData.begin();
       iter != threadData.end();
       iter++)
@@ -523,8 +544,15 @@ bool StorageBenchSlave::openFiles(void)
 
       // open file
 
-      if(this->benchType == StorageBenchType_READ)
+      if( (this->benchType == StorageBenchType_READ) ||
+          (this->benchType == StorageBenchType_RANDREAD) )
          fileDescriptor = open(path.c_str(), O_RDONLY);
+      else
+      if(this->benchType == StorageBenchType_RANDMIXED)
+         fileDescriptor = open(path.c_str(), O_RDWR);
+      else
+      if(this->benchType == StorageBenchType_RANDWRITE)
+         fileDescriptor = open(path.c_str(), O_CREAT | O_WRONLY, openMode); // (no truncate)
       else
          fileDescriptor = open(path.c_str(), O_CREAT | O_WRONLY | O_TRUNC, openMode);
 
@@ -552,7 +580,11 @@ bool StorageBenchSlave::closeFiles(void)
       iter != threadData.end();
       iter++)
    {
+      if(iter->second.fileDescriptor == -1)
+         continue; // not open
+
       int tmpRetVal = close(iter->second.fileDescriptor);
+      iter->second.fileDescriptor = -1;
 
       if (tmpRetVal != 0)
       {
@@ -598,6 +630,73 @@ int64_t StorageBenchSlave::getNextPackageSize(int threadID)
    return retVal;
 }
 
+/*
+ * creates the work package for the next operation of the given thread, for the random types
+ * with a random block offset (and a random operation type for the mixed type)
+ *
+ * note: must be called after getNextPackageSize() for the same operation
+ *
+ * @param threadID the threadID
+ * @param workSize the size of the data for the work package (from getNextPackageSize() )
+ * @return the new work package
+ *
+ */
+StorageBenchWork* StorageBenchSlave::createWork(int threadID, int64_t workSize)
+{
+   StorageBenchThreadData* currentData = &this->threadData[threadID];
+
+   StorageBenchType workType = this->benchType;
+   int64_t offset = -1; // sequential
+   std::string filePath;
+
+   if(STORAGEBENCHTYPE_IS_RANDOM(this->benchType) )
+   {
+      uint64_t numBlocks = BEEGFS_MAX(this->size / this->blocksize, 1);
+      uint64_t randomVal = ( ( (uint64_t)randomizer.getNextInt() ) << 31) |
+         randomizer.getNextInt();
+
+      offset = (randomVal % numBlocks) * this->blocksize;
+
+      if(this->benchType == StorageBenchType_RANDREAD)
+         workType = StorageBenchType_READ;
+      else
+      if(this->benchType == StorageBenchType_RANDWRITE)
+         workType = StorageBenchType_WRITE;
+      else
+      if(randomizer.getNextInRange(0, 99) < this->readPercent)
+         workType = StorageBenchType_READ;
+      else
+         workType = StorageBenchType_WRITE;
+   }
+   else
+   if(this->benchType == StorageBenchType_CREATE)
+   { // unique name per file: the number of the file within this thread
+      int64_t fileNum = (currentData->engagedSize - 1) / this->blocksize;
+
+      filePath = getBenchmarkFilePath(currentData->targetID,
+         "create." + StringTk::intToStr(currentData->targetThreadID) + "." +
+         StringTk::int64ToStr(fileNum) );
+   }
+
+   return new StorageBenchWork(currentData->targetID, threadID, currentData->fileDescriptor,
+      workType, workSize, this->threadCommunication, this->transferData, offset, filePath,
+      &currentData->latencies);
+}
+
+/*
+ * @return path of a file in the benchmark folder of the given target (empty string if the target
+ *         is unknown)
+ */
+std::string StorageBenchSlave::getBenchmarkFilePath(uint16_t targetID, std::string fileName)
+{
+   std::string path;
+
+   if(!Program::getApp()->getStorageTargets()->getPath(targetID, &path) )
+      return "";
+
+   return path + "/" STORAGEBENCH_STORAGE_SUBDIR_NAME "/" + fileName;
+}
+
 
 /*
  * calculates the throughput (kB/s) of the given target
@@ -635,24 +734,67 @@ int64_t StorageBenchSlave::getResult(uint16_t targetID)
    if ( (size == 0) || (time == 0) )
       return 0;
 
+   if (this->benchType == StorageBenchType_CREATE)
+   { // output: in files per second
+      int64_t numFiles = (size + this->blocksize - 1) / this->blocksize;
+
+      return ( (numFiles * 1000) / time);
+   }
+
    // input: size in bytes, time in milliseconds,
    // output: in kilobytes per second
    return ( (size * 1000) / (time * 1024) );
 }
 
 /*
- * calculates the throughput (kB/s) of the given targets
+ * calculates the latency percentiles of the single operations of all threads of the given target
+ *
+ * note: the histograms of the threads are merged before the percentiles are calculated, because
+ *       results are reported per target (like the throughput) and percentiles of the single
+ *       threads can't be combined into percentiles of the target afterwards.
+ *
+ * note: values of running threads might be slightly inaccurate (no locking for the histograms)
+ *
+ * @param targetID the targetID
+ * @return the latency percentiles in microseconds
+ *
+ */
+StorageBenchLatencyResult StorageBenchSlave::getLatencyResult(uint16_t targetID)
+{
+   StorageBenchLatencyHistogram targetLatencies;
+   StorageBenchLatencyResult retVal;
+
+   for(StorageBenchThreadDataMapIter iter = this->threadData.begin();
+      iter != this->threadData.end();
+      iter++)
+   {
+      if (iter->second.targetID == targetID)
+         targetLatencies.merge(iter->second.latencies);
+   }
+
+   retVal.p50 = targetLatencies.getPercentile(500);
+   retVal.p99 = targetLatencies.getPercentile(990);
+   retVal.p999 = targetLatencies.getPercentile(999);
+
+   return retVal;
+}
+
+/*
+ * calculates the throughput (kB/s) and the latency percentiles of the given targets
  *
  * @param targetIDs the list of targetIDs
  * @param outResults a initialized map for the results, which contains the results after
  *        execution of the method
+ * @param outLatencyResults a initialized map for the latency results
  *
  */
-void StorageBenchSlave::getResults(UInt16List* targetIDs, StorageBenchResultsMap* outResults)
+void StorageBenchSlave::getResults(UInt16List* targetIDs, StorageBenchResultsMap* outResults,
+   StorageBenchLatencyResultsMap* outLatencyResults)
 {
    for (UInt16ListIter iter = targetIDs->begin(); iter != targetIDs->end(); iter++)
    {
       (*outResults)[*iter] = getResult(*iter);
+      (*outLatencyResults)[*iter] = getLatencyResult(*iter);
    }
 }
 
@@ -672,18 +814,20 @@ void StorageBenchSlave::getAllResults(StorageBenchResultsMap* outResults)
 }
 
 /*
- * calculates the throughput (kB/s) of the given targets and returns the status of the benchmark
+ * calculates the throughput (kB/s) and the latency percentiles of the given targets and returns
+ * the status of the benchmark
  *
  * @param targetIDs the list of targetIDs
  * @param outResults a initialized map for the results, which contains the results after
  *        execution of the method
+ * @param outLatencyResults a initialized map for the latency results
  * @return the status of the benchmark
  *
  */
 StorageBenchStatus StorageBenchSlave::getStatusWithResults(UInt16List* targetIDs,
-   StorageBenchResultsMap* outResults)
+   StorageBenchResultsMap* outResults, StorageBenchLatencyResultsMap* outLatencyResults)
 {
-   getResults(targetIDs, outResults);
+   getResults(targetIDs, outResults, outLatencyResults);
    return getStatus();
 }
 
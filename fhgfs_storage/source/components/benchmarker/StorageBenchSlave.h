@@ -6,8 +6,13 @@
 #include <common/threading/Condition.h>
 #include <common/threading/PThread.h>
 #include <common/toolkit/Pipe.h>
+#include <common/toolkit/Random.h>
 #include <common/toolkit/TimeFine.h>
 #include <common/Common.h>
+#include "StorageBenchLatencyHistogram.h"
+
+
+class StorageBenchWork; // forward declaration
 
 
 // struct for the informations about a thread which simulates a client
@@ -16,8 +21,9 @@ struct StorageBenchThreadData
    uint16_t targetID;
    int targetThreadID;
    int64_t engagedSize; // amount of data which was submitted for write/read
-   int fileDescriptor;
+   int fileDescriptor; // -1 if not open (and for CREATE)
    int64_t neededTime;
+   StorageBenchLatencyHistogram latencies; // latencies of the single operations of this thread
 };
 
 
@@ -42,6 +48,7 @@ class StorageBenchSlave : public PThread
          this->blocksize = 1;    //useless defaults
          this->size = 1;         //useless defaults
          this->numThreads = 1;      //useless defaults
+         this->readPercent = STORAGEBENCH_DEFAULT_READ_PERCENT;
          this->numThreadsDone = 0;
 
          this->status = StorageBenchStatus_UNINITIALIZED;
@@ -59,12 +66,12 @@ class StorageBenchSlave : public PThread
       }
 
       int initAndStartStorageBench(UInt16List* targetIDs, int64_t blocksize, int64_t size,
-         int threads, StorageBenchType type);
+         int threads, int readPercent, StorageBenchType type);
 
       int cleanup(UInt16List* targetIDs);
       int stopBenchmark();
       StorageBenchStatus getStatusWithResults(UInt16List* targetIDs,
-         StorageBenchResultsMap* outResults);
+         StorageBenchResultsMap* outResults, StorageBenchLatencyResultsMap* outLatencyResults);
       void shutdownBenchmark();
       void waitForShutdownBenchmark();
 
@@ -83,6 +90,7 @@ class StorageBenchSlave : public PThread
       int64_t blocksize;
       int64_t size;
       int numThreads;
+      int readPercent; // percentage of reads for RANDMIXED
       unsigned int numThreadsDone;
 
       UInt16List* targetIDs;
@@ -91,11 +99,13 @@ class StorageBenchSlave : public PThread
 
       TimeFine startTime;
 
+      Random randomizer; // for offsets and operation types of the random types (run() only)
+
 
       virtual void run();
 
       int initStorageBench(UInt16List* targetIDs, int64_t blocksize, int64_t size,
-         int threads, StorageBenchType type);
+         int threads, int readPercent, StorageBenchType type);
       bool initTransferData(void);
       void initThreadData();
       void freeTransferData();
@@ -106,8 +116,12 @@ class StorageBenchSlave : public PThread
       bool closeFiles(void);
 
       int64_t getNextPackageSize(int threadID);
+      StorageBenchWork* createWork(int threadID, int64_t workSize);
+      std::string getBenchmarkFilePath(uint16_t targetID, std::string fileName);
       int64_t getResult(uint16_t targetId);
-      void getResults(UInt16List* targetIds, StorageBenchResultsMap* results);
+      StorageBenchLatencyResult getLatencyResult(uint16_t targetID);
+      void getResults(UInt16List* targetIds, StorageBenchResultsMap* results,
+         StorageBenchLatencyResultsMap* latencyResults);
       void getAllResults(StorageBenchResultsMap* results);
 
       void setStatus(StorageBenchStatus newStatus)
@@ -1,8 +1,12 @@
 #include <app/App.h>
 #include <common/net/message/storage/creating/RmChunkPathsMsg.h>
 #include <common/net/message/storage/creating/RmChunkPathsRespMsg.h>
+#include <common/net/message/storage/mirroring/GetChunkBlockChecksumsMsg.h>
+#include <common/net/message/storage/mirroring/GetChunkBlockChecksumsRespMsg.h>
 #include <common/net/message/storage/mirroring/ResyncLocalFileMsg.h>
 #include <common/net/message/storage/mirroring/ResyncLocalFileRespMsg.h>
+#include <common/toolkit/BufferTk.h>
+#include <net/msghelpers/MsgHelperIO.h>
 #include <toolkit/StorageTkEx.h>
 #include <program/Program.h>
 
@@ -102,6 +106,12 @@ FhgfsOpsErr BuddyResyncerFileSyncSlave::doResync(std::string& chunkPathStr, uint
 
    std::string entryID = StorageTk::getPathBasename(chunkPathStr);
 
+   if(!onlyAttribs && app->getConfig()->getTuneResyncDeltaSync() )
+      return doDeltaResync(chunkPathStr, localTargetID, buddyTargetID);
+
+   if(!onlyAttribs && app->getConfig()->getTuneResyncStreamWindowSize() )
+      return doStreamResync(chunkPathStr, localTargetID, buddyTargetID);
+
    // try to find the node with the buddyTargetID
    uint16_t buddyNodeID = targetMapper->getNodeID(buddyTargetID);
 
@@ -197,6 +207,17 @@ FhgfsOpsErr BuddyResyncerFileSyncSlave::doResync(std::string& chunkPathStr, uint
          goto cleanup;
       }
 
+      if(offset && maxCount && StorageTkEx::isHoleRange(fd, offset, maxCount) )
+      { // this block is a hole => no need to read and transfer it if it's not the end of the file
+         struct stat statBuf;
+
+         if( (fstat(fd, &statBuf) == 0) && (statBuf.st_size >= (offset + maxCount) ) )
+         {
+            readRes = maxCount;
+            goto end_of_loop;
+         }
+      }
+
       readRes = read(fd, data, maxCount);
 
       if( readRes == -1)
@@ -215,8 +236,6 @@ FhgfsOpsErr BuddyResyncerFileSyncSlave::doResync(std::string& chunkPathStr, uint
 
       if(readRes > 0)
       {
-         const char zeroBuf[RESYNCER_SPARSE_BLOCK_SIZE] = { 0 };
-
          // check if sparse blocks are in the buffer
          ssize_t bufPos = 0;
          bool dataFound = false;
@@ -224,8 +243,7 @@ FhgfsOpsErr BuddyResyncerFileSyncSlave::doResync(std::string& chunkPathStr, uint
          {
             size_t cmpLen = BEEGFS_MIN(readRes-bufPos, RESYNCER_SPARSE_BLOCK_SIZE);
 
-            int cmpRes = memcmp(data + bufPos, zeroBuf, cmpLen);
-            if(cmpRes != 0)
+            if(!BufferTk::isZero(data + bufPos, cmpLen) )
                dataFound = true;
             else // sparse area detected
             {
@@ -412,6 +430,649 @@ cleanup:
    return retVal;
 }
 
+/**
+ * Delta resync of a chunk file: Fetches checksums of the blocks of the buddy's copy of the chunk
+ * and only sends the blocks that differ from the local chunk. Afterwards, the buddy chunk is
+ * truncated to the local size and the attribs are updated.
+ *
+ * Blocks are compared at the same (block aligned) offsets on both sides, i.e. there is no rolling
+ * checksum search for shifted data, because chunk files are only modified in place.
+ *
+ * The chunk is locked per window of GETCHUNKBLOCKCHECKSUMSMSG_MAX_BLOCKS blocks, like the
+ * complete resync locks it per SYNC_BLOCK_SIZE block.
+ */
+FhgfsOpsErr BuddyResyncerFileSyncSlave::doDeltaResync(std::string& chunkPathStr,
+   uint16_t localTargetID, uint16_t buddyTargetID)
+{
+   FhgfsOpsErr retVal = FhgfsOpsErr_SUCCESS;
+
+   App* app = Program::getApp();
+   TargetMapper* targetMapper = app->getTargetMapper();
+   NodeStoreServers* storageNodes = app->getStorageNodes();
+   ChunkLockStore* chunkLockStore = app->getChunkLockStore();
+
+   const unsigned blockSize = RESYNCER_DELTA_BLOCK_SIZE;
+   const unsigned maxBlocksPerMsg = SYNC_BLOCK_SIZE / blockSize;
+   const size_t windowSize = (size_t)blockSize * GETCHUNKBLOCKCHECKSUMSMSG_MAX_BLOCKS;
+
+   std::string entryID = StorageTk::getPathBasename(chunkPathStr);
+
+   // try to find the node with the buddyTargetID
+   uint16_t buddyNodeID = targetMapper->getNodeID(buddyTargetID);
+
+   Node* node = storageNodes->referenceNode(buddyNodeID);
+
+   if(!node)
+   {
+      LogContext(__func__).log(Log_WARNING,
+         "Storage node does not exist; nodeID " + StringTk::uintToStr(buddyNodeID));
+
+      return FhgfsOpsErr_UNKNOWNNODE;
+   }
+
+   LogContext(__func__).log(Log_DEBUG,
+      "Delta file sync started. chunkPath: " + chunkPathStr + "; localTargetID: "
+         + StringTk::uintToStr(localTargetID) + "; buddyTargetID"
+         + StringTk::uintToStr(buddyTargetID));
+
+   char* data = (char*)malloc(windowSize);
+
+   if(unlikely(!data) ) // malloc failed
+   {
+      LogContext(__func__).logErr("Could not allocate memory for data buf");
+      throw std::bad_alloc();
+   }
+
+   int64_t offset = 0;
+   uint64_t numBytesSent = 0;
+
+   for( ; ; )
+   {
+      UIntVector localWeakChecksums;
+      UInt64Vector localStrongChecksums;
+      UIntVector buddyWeakChecksums;
+      UInt64Vector buddyStrongChecksums;
+      int64_t localFileSize;
+      int64_t buddyFileSize = 0;
+      bool isLastWindow = false;
+
+      // lock the chunk
+      chunkLockStore->lockChunk(localTargetID, entryID);
+
+      int fd = openat(app->getTargetFD(localTargetID, true), chunkPathStr.c_str(),
+         O_RDONLY | O_NOATIME);
+
+      if (fd == -1)
+      {
+         int errCode = errno;
+
+         if(errCode == ENOENT)
+         { // chunk was deleted => no error, but delete the buddy chunk
+            if(!removeBuddyChunkUnlocked(node, buddyTargetID, chunkPathStr) )
+               retVal = FhgfsOpsErr_INTERNAL;
+         }
+         else
+         {
+            LogContext(__func__).logErr(
+               "Open of chunk failed. chunkPath: " + chunkPathStr + "; targetID: "
+                  + StringTk::uintToStr(localTargetID) + "; Error: "
+                  + System::getErrString(errCode));
+
+            retVal = FhgfsOpsErr_INTERNAL;
+         }
+
+         chunkLockStore->unlockChunk(localTargetID, entryID);
+
+         break;
+      }
+
+      // read local blocks of this window (also tells us the current file size)
+
+      if(!StorageTkEx::getBlockChecksums(fd, offset, blockSize,
+         GETCHUNKBLOCKCHECKSUMSMSG_MAX_BLOCKS, data, true, &localWeakChecksums,
+         &localStrongChecksums, &localFileSize) )
+      {
+         LogContext(__func__).logErr("Error during read; "
+            "chunkPath: " + chunkPathStr + "; "
+            "targetID: " + StringTk::uintToStr(localTargetID) + "; "
+            "Error: " + System::getErrString(errno));
+
+         retVal = FhgfsOpsErr_INTERNAL;
+         goto end_of_loop;
+      }
+
+      if(localWeakChecksums.empty() )
+      { // end of file reached (or file was truncated concurrently) => set final size and attribs
+         retVal = sendDeltaFinish(node, fd, chunkPathStr, buddyTargetID, localFileSize);
+         isLastWindow = true;
+         goto end_of_loop;
+      }
+
+      { // get checksums of the buddy blocks of this window
+         GetChunkBlockChecksumsMsg checksumsMsg(chunkPathStr, buddyTargetID, offset, blockSize,
+            localWeakChecksums.size() );
+         checksumsMsg.setMsgHeaderTargetID(buddyTargetID);
+
+         char* respBuf;
+         NetMessage* respMsg;
+
+         retVal = requestResponseBuddy(node, buddyTargetID, &checksumsMsg,
+            NETMSGTYPE_GetChunkBlockChecksumsResp, &respBuf, &respMsg);
+         if(retVal != FhgfsOpsErr_SUCCESS)
+            goto end_of_loop;
+
+         GetChunkBlockChecksumsRespMsg* respMsgCast = (GetChunkBlockChecksumsRespMsg*)respMsg;
+         FhgfsOpsErr checksumsRes = respMsgCast->getResult();
+
+         if(checksumsRes == FhgfsOpsErr_SUCCESS)
+         {
+            buddyFileSize = respMsgCast->getFileSize();
+
+            if(!respMsgCast->parseWeakChecksums(&buddyWeakChecksums) ||
+               !respMsgCast->parseStrongChecksums(&buddyStrongChecksums) )
+               checksumsRes = FhgfsOpsErr_INTERNAL;
+         }
+         else
+         if(checksumsRes == FhgfsOpsErr_PATHNOTEXISTS)
+            checksumsRes = FhgfsOpsErr_SUCCESS; // buddy chunk doesn't exist => send all blocks
+
+         delete(respMsg);
+         free(respBuf);
+
+         if(checksumsRes != FhgfsOpsErr_SUCCESS)
+         {
+            LogContext(__func__).log(Log_WARNING, "Unable to get checksums of buddy chunk; "
+               "chunkPath: " + chunkPathStr + "; "
+               "BuddyNode: " + node->getTypedNodeID() + "; "
+               "buddyTargetID: " + StringTk::uintToStr(buddyTargetID) + "; "
+               "Error: " + FhgfsOpsErrTk::toErrString(checksumsRes));
+
+            retVal = checksumsRes;
+            goto end_of_loop;
+         }
+      }
+
+      { // send runs of differing blocks
+         size_t numBlocks = localWeakChecksums.size();
+         size_t runStart = 0;
+         size_t runLen = 0;
+
+         for(size_t i = 0; i <= numBlocks; i++)
+         {
+            bool blockDiffers = false;
+
+            if(i < numBlocks)
+            {
+               int64_t blockOffset = offset + (int64_t)i * blockSize;
+
+               if(i >= buddyWeakChecksums.size() )
+               { /* buddy block doesn't exist => only send it if it's not all zeros (the final
+                    truncate will fill the buddy file with zeros up to the local file size) */
+                  size_t blockLen = BEEGFS_MIN(localFileSize - blockOffset, (int64_t)blockSize);
+
+                  blockDiffers = (blockOffset < buddyFileSize) ||
+                     !BufferTk::isZero(data + i * blockSize, blockLen);
+               }
+               else
+                  blockDiffers = (localWeakChecksums[i] != buddyWeakChecksums[i]) ||
+                     (localStrongChecksums[i] != buddyStrongChecksums[i]);
+            }
+
+            if(blockDiffers)
+            {
+               if(!runLen)
+                  runStart = i;
+
+               runLen++;
+
+               if(runLen < maxBlocksPerMsg)
+                  continue;
+            }
+
+            if(!runLen)
+               continue;
+
+            // send the current run
+
+            int64_t runOffset = offset + (int64_t)runStart * blockSize;
+            int64_t runEnd = BEEGFS_MIN(runOffset + (int64_t)runLen * blockSize, localFileSize);
+
+            ResyncLocalFileMsg resyncMsg(data + runStart * blockSize, chunkPathStr,
+               buddyTargetID, runOffset, (int) (runEnd - runOffset) );
+            resyncMsg.setMsgHeaderFeatureFlags(RESYNCLOCALFILEMSG_FLAG_DELTA);
+            resyncMsg.setMsgHeaderTargetID(buddyTargetID);
+
+            retVal = sendResyncLocalFileMsg(node, buddyTargetID, &resyncMsg, chunkPathStr);
+            if(retVal != FhgfsOpsErr_SUCCESS)
+               goto end_of_loop;
+
+            numBytesSent += runEnd - runOffset;
+            runLen = 0;
+         }
+
+         offset += (int64_t)numBlocks * blockSize;
+      }
+
+   end_of_loop:
+      if(close(fd) == -1)
+      {
+         LogContext(__func__).log(Log_WARNING, "Error closing file descriptor; "
+            "chunkPath: " + chunkPathStr + "; "
+            "targetID: " + StringTk::uintToStr(localTargetID) + "; "
+            "Error: " + System::getErrString(errno));
+      }
+
+      // unlock the chunk
+      chunkLockStore->unlockChunk(localTargetID, entryID);
+
+      if( (retVal != FhgfsOpsErr_SUCCESS) || isLastWindow)
+         break;
+
+      if ( getSelfTerminateNotIdle() )
+      {
+         retVal = FhgfsOpsErr_INTERRUPTED;
+         break;
+      }
+   }
+
+   SAFE_FREE(data);
+
+   storageNodes->releaseNode(&node);
+
+   LogContext(__func__).log(Log_DEBUG, "Delta file sync finished. chunkPath: " + chunkPathStr +
+      "; sent bytes: " + StringTk::uint64ToStr(numBytesSent) );
+
+   return retVal;
+}
+
+/**
+ * Streaming resync of a chunk file: The chunk is transferred in windows of up to
+ * tuneResyncStreamWindowSize bytes. Each window is a single ResyncLocalFileMsg, which is followed
+ * by the raw window data on the same connection and acknowledged by a single response, so the data
+ * of a window is transferred without waiting for a round trip per block.
+ *
+ * The chunk is locked while a window is transferred, so that concurrent client writes (which are
+ * mirrored to the buddy) can't be overwritten by older data of the window.
+ *
+ * Holes of the local chunk (except at the beginning of the file, where the buddy chunk is
+ * truncated) are skipped; zero blocks within a window are transferred, but not written by the
+ * buddy.
+ */
+FhgfsOpsErr BuddyResyncerFileSyncSlave::doStreamResync(std::string& chunkPathStr,
+   uint16_t localTargetID, uint16_t buddyTargetID)
+{
+   FhgfsOpsErr retVal = FhgfsOpsErr_SUCCESS;
+
+   App* app = Program::getApp();
+   TargetMapper* targetMapper = app->getTargetMapper();
+   NodeStoreServers* storageNodes = app->getStorageNodes();
+   ChunkLockStore* chunkLockStore = app->getChunkLockStore();
+
+   const int64_t windowSize = app->getConfig()->getTuneResyncStreamWindowSize();
+
+   std::string entryID = StorageTk::getPathBasename(chunkPathStr);
+
+   // try to find the node with the buddyTargetID
+   uint16_t buddyNodeID = targetMapper->getNodeID(buddyTargetID);
+
+   Node* node = storageNodes->referenceNode(buddyNodeID);
+
+   if(!node)
+   {
+      LogContext(__func__).log(Log_WARNING,
+         "Storage node does not exist; nodeID " + StringTk::uintToStr(buddyNodeID));
+
+      return FhgfsOpsErr_UNKNOWNNODE;
+   }
+
+   LogContext(__func__).log(Log_DEBUG,
+      "Streaming file sync started. chunkPath: " + chunkPathStr + "; localTargetID: "
+         + StringTk::uintToStr(localTargetID) + "; buddyTargetID"
+         + StringTk::uintToStr(buddyTargetID));
+
+   char* data = (char*)malloc(SYNC_BLOCK_SIZE);
+
+   if(unlikely(!data) ) // malloc failed
+   {
+      LogContext(__func__).logErr("Could not allocate memory for data buf");
+      throw std::bad_alloc();
+   }
+
+   int64_t offset = 0;
+
+   for( ; ; )
+   {
+      struct stat statBuf;
+      bool isLastWindow = false;
+
+      // lock the chunk
+      chunkLockStore->lockChunk(localTargetID, entryID);
+
+      int fd = openat(app->getTargetFD(localTargetID, true), chunkPathStr.c_str(),
+         O_RDONLY | O_NOATIME);
+
+      if (fd == -1)
+      {
+         int errCode = errno;
+
+         if(errCode == ENOENT)
+         { // chunk was deleted => no error, but delete the buddy chunk
+            if(!removeBuddyChunkUnlocked(node, buddyTargetID, chunkPathStr) )
+               retVal = FhgfsOpsErr_INTERNAL;
+         }
+         else
+         {
+            LogContext(__func__).logErr(
+               "Open of chunk failed. chunkPath: " + chunkPathStr + "; targetID: "
+                  + StringTk::uintToStr(localTargetID) + "; Error: "
+                  + System::getErrString(errCode));
+
+            retVal = FhgfsOpsErr_INTERNAL;
+         }
+
+         chunkLockStore->unlockChunk(localTargetID, entryID);
+
+         break;
+      }
+
+      if(fstat(fd, &statBuf) == -1)
+      {
+         LogContext(__func__).logErr("Error getting chunk attributes; "
+            "chunkPath: " + chunkPathStr + "; "
+            "targetID: " + StringTk::uintToStr(localTargetID) + "; "
+            "Error: " + System::getErrString(errno));
+
+         retVal = FhgfsOpsErr_INTERNAL;
+         goto end_of_loop;
+      }
+
+      if(offset > statBuf.st_size)
+         offset = statBuf.st_size; // chunk was truncated since the last window
+      else
+      if(offset)
+      { // skip holes (the first window at offset 0 truncated the buddy chunk)
+         off_t dataOffset = lseek(fd, offset, SEEK_DATA);
+
+         if( (dataOffset == -1) && (errno == ENXIO) )
+            offset = statBuf.st_size; // no more data up to the end of the file
+         else
+         if(dataOffset > offset)
+            offset = dataOffset - (dataOffset % RESYNCER_SPARSE_BLOCK_SIZE);
+      }
+
+      {
+         int64_t count = BEEGFS_MIN(statBuf.st_size - offset, windowSize);
+         unsigned resyncMsgFlags =
+            RESYNCLOCALFILEMSG_FLAG_STREAM | RESYNCLOCALFILEMSG_CHECK_SPARSE;
+
+         isLastWindow = ( (offset + count) == statBuf.st_size);
+
+         ResyncLocalFileMsg resyncMsg(NULL, chunkPathStr, buddyTargetID, offset, (int)count);
+
+         if(isLastWindow)
+         { // set attribs and truncate buddy chunk to the local size
+            int mode = statBuf.st_mode;
+            unsigned userID = statBuf.st_uid;
+            unsigned groupID = statBuf.st_gid;
+            int64_t mtimeSecs = statBuf.st_mtim.tv_sec;
+            int64_t atimeSecs = statBuf.st_atim.tv_sec;
+            SettableFileAttribs chunkAttribs = {mode, userID,groupID, mtimeSecs, atimeSecs};
+            resyncMsg.setChunkAttribs(chunkAttribs);
+            resyncMsgFlags |= RESYNCLOCALFILEMSG_FLAG_SETATTRIBS | RESYNCLOCALFILEMSG_FLAG_TRUNC;
+         }
+
+         resyncMsg.setMsgHeaderFeatureFlags(resyncMsgFlags);
+         resyncMsg.setMsgHeaderTargetID(buddyTargetID);
+
+         ResyncStreamContext streamContext = { fd, offset, (size_t)count, data, SYNC_BLOCK_SIZE,
+            0 };
+
+         retVal = sendResyncLocalFileMsg(node, buddyTargetID, &resyncMsg, chunkPathStr,
+            &streamContext);
+
+         if( (retVal == FhgfsOpsErr_SUCCESS) && streamContext.readErrno)
+         { // buddy got zeros instead of the data that we couldn't read
+            LogContext(__func__).logErr("Error during read; "
+               "chunkPath: " + chunkPathStr + "; "
+               "targetID: " + StringTk::uintToStr(localTargetID) + "; "
+               "Error: " + System::getErrString(streamContext.readErrno) );
+
+            retVal = FhgfsOpsErr_INTERNAL;
+         }
+
+         offset += count;
+      }
+
+   end_of_loop:
+      if(close(fd) == -1)
+      {
+         LogContext(__func__).log(Log_WARNING, "Error closing file descriptor; "
+            "chunkPath: " + chunkPathStr + "; "
+            "targetID: " + StringTk::uintToStr(localTargetID) + "; "
+            "Error: " + System::getErrString(errno));
+      }
+
+      // unlock the chunk
+      chunkLockStore->unlockChunk(localTargetID, entryID);
+
+      if( (retVal != FhgfsOpsErr_SUCCESS) || isLastWindow)
+         break;
+
+      if ( getSelfTerminateNotIdle() )
+      {
+         retVal = FhgfsOpsErr_INTERRUPTED;
+         break;
+      }
+   }
+
+   SAFE_FREE(data);
+
+   storageNodes->releaseNode(&node);
+
+   LogContext(__func__).log(Log_DEBUG, "Streaming file sync finished. chunkPath: " +
+      chunkPathStr);
+
+   return retVal;
+}
+
+/**
+ * Hook for RequestResponseArgs::sendExtraData to stream a chunk file range (ResyncStreamContext)
+ * after a ResyncLocalFileMsg with RESYNCLOCALFILEMSG_FLAG_STREAM.
+ *
+ * If the chunk can't be read, zeros are sent instead (the buddy expects the announced amount of
+ * data) and the error is returned in the readErrno of the context.
+ */
+FhgfsOpsErr BuddyResyncerFileSyncSlave::streamChunkData(Socket* sock, void* context)
+{
+   ResyncStreamContext* streamContext = (ResyncStreamContext*)context;
+
+   size_t numSent = 0;
+
+   streamContext->readErrno = 0; // (this might be a retry)
+
+   while(numSent < streamContext->count)
+   {
+      size_t readLen = BEEGFS_MIN(streamContext->bufLen, streamContext->count - numSent);
+      ssize_t readRes = 0;
+
+      if(!streamContext->readErrno)
+         readRes = MsgHelperIO::pread(streamContext->fd, streamContext->buf, readLen,
+            streamContext->offset + numSent);
+
+      if(readRes == -1)
+         streamContext->readErrno = errno;
+
+      if(readRes <= 0)
+      { // read error or chunk is shorter than expected => send zeros
+         memset(streamContext->buf, 0, readLen);
+         readRes = readLen;
+      }
+
+      sock->send(streamContext->buf, readRes, 0);
+
+      numSent += readRes;
+   }
+
+   return FhgfsOpsErr_SUCCESS;
+}
+
+/**
+ * Send the final message of a delta resync, which truncates the buddy chunk to the local file size
+ * and sets the attribs of the local chunk.
+ *
+ * Note: Chunk has to be locked by caller.
+ */
+FhgfsOpsErr BuddyResyncerFileSyncSlave::sendDeltaFinish(Node* node, int fd,
+   std::string& chunkPathStr, uint16_t buddyTargetID, int64_t localFileSize)
+{
+   unsigned resyncMsgFlags = RESYNCLOCALFILEMSG_FLAG_DELTA | RESYNCLOCALFILEMSG_FLAG_TRUNC;
+
+   ResyncLocalFileMsg resyncMsg(NULL, chunkPathStr, buddyTargetID, localFileSize, 0);
+
+   struct stat statBuf;
+   int statRes = fstat(fd, &statBuf);
+
+   if (statRes == 0)
+   {
+      int mode = statBuf.st_mode;
+      unsigned userID = statBuf.st_uid;
+      unsigned groupID = statBuf.st_gid;
+      int64_t mtimeSecs = statBuf.st_mtim.tv_sec;
+      int64_t atimeSecs = statBuf.st_atim.tv_sec;
+      SettableFileAttribs chunkAttribs = {mode, userID,groupID, mtimeSecs, atimeSecs};
+      resyncMsg.setChunkAttribs(chunkAttribs);
+      resyncMsgFlags |= RESYNCLOCALFILEMSG_FLAG_SETATTRIBS;
+   }
+   else
+   {
+      LogContext(__func__).logErr("Error getting chunk attributes; "
+         "chunkPath: " + chunkPathStr + "; "
+         "BuddyNode: " + node->getTypedNodeID() + "; "
+         "buddyTargetID: " + StringTk::uintToStr(buddyTargetID) + "; "
+         "Error: " + System::getErrString(errno));
+   }
+
+   resyncMsg.setMsgHeaderFeatureFlags(resyncMsgFlags);
+   resyncMsg.setMsgHeaderTargetID(buddyTargetID);
+
+   return sendResyncLocalFileMsg(node, buddyTargetID, &resyncMsg, chunkPathStr);
+}
+
+/**
+ * Send a ResyncLocalFileMsg to the buddy and check the result.
+ *
+ * @param streamContext see requestResponseBuddy().
+ */
+FhgfsOpsErr BuddyResyncerFileSyncSlave::sendResyncLocalFileMsg(Node* node,
+   uint16_t buddyTargetID, ResyncLocalFileMsg* resyncMsg, std::string& chunkPathStr,
+   ResyncStreamContext* streamContext)
+{
+   char* respBuf;
+   NetMessage* respMsg;
+
+   FhgfsOpsErr commRes = requestResponseBuddy(node, buddyTargetID, resyncMsg,
+      NETMSGTYPE_ResyncLocalFileResp, &respBuf, &respMsg, streamContext);
+   if(commRes != FhgfsOpsErr_SUCCESS)
+      return commRes;
+
+   // correct response type received
+   ResyncLocalFileRespMsg* respMsgCast = (ResyncLocalFileRespMsg*) respMsg;
+
+   FhgfsOpsErr syncRes = respMsgCast->getResult();
+
+   if(syncRes != FhgfsOpsErr_SUCCESS)
+   {
+      LogContext(__func__).log(Log_WARNING, "Error during resync; "
+         "chunkPath: " + chunkPathStr + "; "
+         "BuddyNode: " + node->getTypedNodeID() + "; "
+         "buddyTargetID: " + StringTk::uintToStr(buddyTargetID) + "; "
+         "Error: " + FhgfsOpsErrTk::toErrString(syncRes));
+   }
+
+   delete (respMsg);
+   free(respBuf);
+
+   return syncRes;
+}
+
+/**
+ * Send a request to the buddy and receive the response; retries until communication succeeds,
+ * the buddy target becomes offline or this thread shall terminate.
+ *
+ * @param outRespBuf must be freed by the caller on success.
+ * @param outRespMsg must be deleted by the caller on success.
+ * @param streamContext if not NULL, the data of the context is streamed after the request msg
+ *    (for msgs with RESYNCLOCALFILEMSG_FLAG_STREAM).
+ * @return FhgfsOpsErr_SUCCESS if the response was received, FhgfsOpsErr_COMMUNICATION or
+ *    FhgfsOpsErr_INTERNAL (no target state) otherwise.
+ */
+FhgfsOpsErr BuddyResyncerFileSyncSlave::requestResponseBuddy(Node* node, uint16_t buddyTargetID,
+   NetMessage* requestMsg, unsigned respMsgType, char** outRespBuf, NetMessage** outRespMsg,
+   ResyncStreamContext* streamContext)
+{
+   unsigned msgRetryIntervalMS = 5000;
+
+   bool commRes = false;
+   CombinedTargetState state;
+   bool getStateRes = Program::getApp()->getTargetStateStore()->getState(buddyTargetID, state);
+
+   while ( (!commRes) && (getStateRes)
+      && (state.reachabilityState != TargetReachabilityState_OFFLINE) )
+   {
+      RequestResponseArgs rrArgs(node, requestMsg, respMsgType);
+
+      if(streamContext)
+      {
+         rrArgs.sendExtraData = &streamChunkData;
+         rrArgs.extraDataContext = streamContext;
+      }
+
+      commRes = MessagingTk::requestResponse(&rrArgs);
+
+      if(commRes)
+      {
+         *outRespBuf = rrArgs.outRespBuf;
+         *outRespMsg = rrArgs.outRespMsg;
+
+         rrArgs.outRespBuf = NULL; // to avoid deletion in RequestResponseArgs destructor
+         rrArgs.outRespMsg = NULL; // to avoid deletion in RequestResponseArgs destructor
+      }
+      else
+      {
+         LOG_DEBUG(__func__, Log_NOTICE,
+            "Unable to communicate, but target is not offline; sleeping "
+            + StringTk::uintToStr(msgRetryIntervalMS) + "ms before retry. targetID: "
+            + StringTk::uintToStr(targetID));
+
+         PThread::sleepMS(msgRetryIntervalMS);
+
+         // if thread shall terminate, break loop here
+         if ( getSelfTerminateNotIdle() )
+            break;
+
+         getStateRes = Program::getApp()->getTargetStateStore()->getState(buddyTargetID, state);
+      }
+   }
+
+   if(!commRes)
+   { // communication error
+      LogContext(__func__).log(Log_WARNING,
+         "Communication with storage node failed: " + node->getTypedNodeID());
+
+      return FhgfsOpsErr_COMMUNICATION;
+   }
+   else
+   if(!getStateRes)
+   {
+      LogContext(__func__).log(Log_WARNING,
+         "No valid state for node ID: " + node->getTypedNodeID());
+
+      return FhgfsOpsErr_INTERNAL;
+   }
+
+   return FhgfsOpsErr_SUCCESS;
+}
+
 /**
  * Note: Chunk has to be locked by caller.
  */
@@ -2,10 +2,28 @@
 #define BUDDYRESYNCERFILESYNCSLAVE_H_
 
 #include <components/buddyresyncer/ChunkSyncCandidateStore.h>
+#include <common/net/message/storage/mirroring/ResyncLocalFileMsg.h>
 #include <common/storage/StorageErrors.h>
 #include <common/threading/PThread.h>
 #include <common/threading/SafeMutexLock.h>
 
+/**
+ * Chunk file range that is streamed to the buddy after a ResyncLocalFileMsg with
+ * RESYNCLOCALFILEMSG_FLAG_STREAM.
+ */
+struct ResyncStreamContext
+{
+   int fd;
+   int64_t offset;
+   size_t count;
+
+   char* buf; // read buffer
+   size_t bufLen;
+
+   int readErrno; // set if the chunk could not be read (zeros were streamed instead)
+};
+
+
 class BuddyResyncerFileSyncSlave : public PThread
 {
    friend class BuddyResyncer; // (to grant access to internal mutex)
@@ -35,6 +53,20 @@ class BuddyResyncerFileSyncSlave : public PThread
       void syncLoop();
       FhgfsOpsErr doResync(std::string& chunkPathStr, uint16_t localTargetID,
          uint16_t buddyTargetID, bool onlyAttribs);
+      FhgfsOpsErr doDeltaResync(std::string& chunkPathStr, uint16_t localTargetID,
+         uint16_t buddyTargetID);
+      FhgfsOpsErr sendDeltaFinish(Node* node, int fd, std::string& chunkPathStr,
+         uint16_t buddyTargetID, int64_t localFileSize);
+      FhgfsOpsErr doStreamResync(std::string& chunkPathStr, uint16_t localTargetID,
+         uint16_t buddyTargetID);
+      FhgfsOpsErr sendResyncLocalFileMsg(Node* node, uint16_t buddyTargetID,
+         ResyncLocalFileMsg* resyncMsg, std::string& chunkPathStr,
+         ResyncStreamContext* streamContext = NULL);
+      FhgfsOpsErr requestResponseBuddy(Node* node, uint16_t buddyTargetID, NetMessage* requestMsg,
+         unsigned respMsgType, char** outRespBuf, NetMessage** outRespMsg,
+         ResyncStreamContext* streamContext = NULL);
+
+      static FhgfsOpsErr streamChunkData(Socket* sock, void* context);
       bool removeBuddyChunkUnlocked(Node* node, uint16_t buddyTargetID, std::string& pathStr);
 
    public:
@@ -0,0 +1,593 @@
+#include <common/toolkit/StringTk.h>
+#include "IoUringEngine.h"
+
+#ifdef CONFIG_SYSTEM_HAS_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+
+#define IOURINGENGINE_USERDATA_STOP       0 /* user_data of the NOP that stops the reaper */
+#define IOURINGENGINE_MAX_RW_LEN          (1 << 30) /* max len of a single read/write (u32 field) */
+#define IOURINGENGINE_PROBE_NUM_OPS       256
+#define IOURINGENGINE_RETRY_WAIT_MS       1
+
+
+static inline int ioUringSetup(unsigned entries, struct io_uring_params* params)
+{
+   return syscall(__NR_io_uring_setup, entries, params);
+}
+
+static inline int ioUringEnter(int ringFD, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+   return syscall(__NR_io_uring_enter, ringFD, toSubmit, minComplete, flags, NULL, 0);
+}
+
+static inline int ioUringRegister(int ringFD, unsigned opcode, void* arg, unsigned numArgs)
+{
+   return syscall(__NR_io_uring_register, ringFD, opcode, arg, numArgs);
+}
+
+
+/**
+ * @param queueDepth number of submission ring entries (will be rounded up to a power of 2 by the
+ * kernel), which is also the max number of requests in flight.
+ * @throw ComponentInitException if the kernel doesn't support io_uring or the required ops.
+ */
+IoUringEngine::IoUringEngine(unsigned queueDepth) throw(ComponentInitException) :
+   PThread("IoUring"), log("IoUring"), ringFD(-1), sqEntries(queueDepth), cqEntries(0),
+   sqRingPtr(NULL), sqRingSize(0), cqRingPtr(NULL), cqRingSize(0), sqes(NULL), sqesSize(0),
+   numInFlight(0), numUnsubmitted(0), submitInProgress(false)
+{
+   initRing();
+
+   try
+   {
+      probeOps();
+   }
+   catch(ComponentInitException& e)
+   {
+      uninitRing();
+      throw;
+   }
+
+   log.log(Log_DEBUG, "Initialized io_uring. "
+      "Submission entries: " + StringTk::uintToStr(sqEntries) + "; "
+      "completion entries: " + StringTk::uintToStr(cqEntries) );
+}
+
+IoUringEngine::~IoUringEngine()
+{
+   uninitRing();
+}
+
+void IoUringEngine::initRing() throw(ComponentInitException)
+{
+   struct io_uring_params params;
+   memset(&params, 0, sizeof(params) );
+
+   ringFD = ioUringSetup(sqEntries, &params);
+   if(ringFD == -1)
+      throw ComponentInitException("io_uring setup failed: " + System::getErrString() );
+
+   sqEntries = params.sq_entries;
+   cqEntries = params.cq_entries;
+
+   sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+   cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+   sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+   const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP);
+   if(singleMmap)
+      sqRingSize = cqRingSize = BEEGFS_MAX(sqRingSize, cqRingSize);
+
+   sqRingPtr = mmap(NULL, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+      ringFD, IORING_OFF_SQ_RING);
+   if(sqRingPtr == MAP_FAILED)
+   {
+      sqRingPtr = NULL;
+      uninitRing();
+      throw ComponentInitException("io_uring mmap of submission ring failed: " +
+         System::getErrString() );
+   }
+
+   if(singleMmap)
+      cqRingPtr = sqRingPtr;
+   else
+   {
+      cqRingPtr = mmap(NULL, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+         ringFD, IORING_OFF_CQ_RING);
+      if(cqRingPtr == MAP_FAILED)
+      {
+         cqRingPtr = NULL;
+         uninitRing();
+         throw ComponentInitException("io_uring mmap of completion ring failed: " +
+            System::getErrString() );
+      }
+   }
+
+   void* sqesPtr = mmap(NULL, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+      ringFD, IORING_OFF_SQES);
+   if(sqesPtr == MAP_FAILED)
+   {
+      uninitRing();
+      throw ComponentInitException("io_uring mmap of submission entries failed: " +
+         System::getErrString() );
+   }
+
+   sqes = (struct io_uring_sqe*)sqesPtr;
+
+   char* sqRing = (char*)sqRingPtr;
+   sqHead = (unsigned*)(sqRing + params.sq_off.head);
+   sqTail = (unsigned*)(sqRing + params.sq_off.tail);
+   sqMask = (unsigned*)(sqRing + params.sq_off.ring_mask);
+   sqArray = (unsigned*)(sqRing + params.sq_off.array);
+
+   char* cqRing = (char*)cqRingPtr;
+   cqHead = (unsigned*)(cqRing + params.cq_off.head);
+   cqTail = (unsigned*)(cqRing + params.cq_off.tail);
+   cqMask = (unsigned*)(cqRing + params.cq_off.ring_mask);
+   cqes = (struct io_uring_cqe*)(cqRing + params.cq_off.cqes);
+}
+
+/**
+ * Check whether the kernel supports all ops that we need.
+ */
+void IoUringEngine::probeOps()
+{
+   const size_t probeSize = sizeof(struct io_uring_probe) +
+      IOURINGENGINE_PROBE_NUM_OPS * sizeof(struct io_uring_probe_op);
+
+   struct io_uring_probe* probe = (struct io_uring_probe*)calloc(1, probeSize);
+   if(!probe)
+      throw ComponentInitException("Unable to allocate io_uring probe buffer");
+
+   int probeRes = ioUringRegister(ringFD, IORING_REGISTER_PROBE, probe,
+      IOURINGENGINE_PROBE_NUM_OPS);
+   if(probeRes == -1)
+   {
+      free(probe);
+      throw ComponentInitException("io_uring probe failed: " + System::getErrString() );
+   }
+
+   const uint8_t requiredOps[] =
+      { IORING_OP_NOP, IORING_OP_WRITE, IORING_OP_FADVISE, IORING_OP_SYNC_FILE_RANGE };
+
+   for(unsigned i=0; i < sizeof(requiredOps) / sizeof(requiredOps[0]); i++)
+   {
+      uint8_t op = requiredOps[i];
+
+      if( (op > probe->last_op) || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED) )
+      {
+         free(probe);
+         throw ComponentInitException("io_uring op not supported by kernel: " +
+            StringTk::uintToStr(op) );
+      }
+   }
+
+   free(probe);
+}
+
+void IoUringEngine::uninitRing()
+{
+   if(sqes)
+   {
+      munmap(sqes, sqesSize);
+      sqes = NULL;
+   }
+
+   if(cqRingPtr && (cqRingPtr != sqRingPtr) )
+      munmap(cqRingPtr, cqRingSize);
+
+   cqRingPtr = NULL;
+
+   if(sqRingPtr)
+   {
+      munmap(sqRingPtr, sqRingSize);
+      sqRingPtr = NULL;
+   }
+
+   if(ringFD != -1)
+   {
+      close(ringFD);
+      ringFD = -1;
+   }
+}
+
+void IoUringEngine::run()
+{
+   try
+   {
+      registerSignalHandler();
+
+      reapLoop();
+
+      log.log(Log_DEBUG, "Component stopped.");
+   }
+   catch(std::exception& e)
+   {
+      PThread::getCurrentThreadApp()->handleComponentException(e);
+   }
+}
+
+/**
+ * Tell the reaper thread to terminate after all requests in flight have completed.
+ *
+ * Note: Only call this when no other threads submit requests anymore.
+ */
+void IoUringEngine::stopReaping()
+{
+   submit(NULL);
+}
+
+void IoUringEngine::reapLoop()
+{
+   bool stopReceived = false;
+
+   for( ; ; )
+   {
+      int waitRes = ioUringEnter(ringFD, 0, 1, IORING_ENTER_GETEVENTS);
+      if(unlikely(waitRes == -1) && (errno != EINTR) )
+      {
+         log.logErr("Waiting for io_uring completions failed: " + System::getErrString() );
+         PThread::sleepMS(IOURINGENGINE_RETRY_WAIT_MS);
+      }
+
+      unsigned numCompleted = reapCompletions(&stopReceived);
+      if(!numCompleted)
+         continue;
+
+      SafeMutexLock mutexLock(&mutex);
+
+      numInFlight -= numCompleted;
+      inFlightCond.broadcast();
+
+      bool allDone = stopReceived && !numInFlight;
+
+      mutexLock.unlock();
+
+      if(allDone)
+         break;
+   }
+}
+
+/**
+ * Hand over the results of all available completion entries to the submitters.
+ *
+ * @return number of requests that are completely done (i.e. not resubmitted)
+ */
+unsigned IoUringEngine::reapCompletions(bool* outStopReceived)
+{
+   std::vector<IoUringCompletion*> resubmitVec;
+   unsigned numCompleted = 0;
+
+   unsigned head = *cqHead; // (only we modify the head)
+   unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+
+   for( ; head != tail; head++)
+   {
+      struct io_uring_cqe* cqe = &cqes[head & *cqMask];
+
+      if(cqe->user_data == IOURINGENGINE_USERDATA_STOP)
+      {
+         *outStopReceived = true;
+         numCompleted++;
+         continue;
+      }
+
+      IoUringCompletion* completion = (IoUringCompletion*)(uintptr_t)cqe->user_data;
+
+      if(handleCompletion(completion, cqe->res) )
+         numCompleted++;
+      else
+         resubmitVec.push_back(completion);
+   }
+
+   __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+   if(resubmitVec.empty() )
+      return numCompleted;
+
+   /* note: resubmitted requests keep their place in the numInFlight count, so we don't need to
+      wait for free slots here (which would deadlock, because we are the ones freeing slots) */
+
+   SafeMutexLock mutexLock(&mutex);
+
+   for(std::vector<IoUringCompletion*>::iterator iter = resubmitVec.begin();
+       iter != resubmitVec.end();
+       iter++)
+      queueSQEUnlocked(*iter, (uintptr_t)*iter);
+
+   if(!submitInProgress)
+      flushSubmissionsUnlocked(&mutexLock);
+
+   mutexLock.unlock();
+
+   return numCompleted;
+}
+
+/**
+ * @param res result from the completion entry (bytes or negative errno)
+ * @return false if the request was not completely done (short write) and needs to be resubmitted
+ * for the remaining data; true if the submitter was notified and the completion was deleted.
+ */
+bool IoUringEngine::handleCompletion(IoUringCompletion* completion, int32_t res)
+{
+   if( (completion->opcode == IORING_OP_WRITE) &&
+       (res > 0) && (completion->numDone + res < completion->count) )
+   { // short write => continue with the remaining data
+      completion->numDone += res;
+      return false;
+   }
+
+   if(completion->outRes)
+   {
+      if(res >= 0)
+         *completion->outRes = completion->numDone + res;
+      else
+      {
+         *completion->outRes = completion->numDone ? (ssize_t)completion->numDone : -1;
+         *completion->outErrno = -res;
+      }
+   }
+
+   SynchronizedCounter* counter = completion->counter;
+
+   if(completion->ownsFD)
+      close(completion->fd);
+
+   delete(completion);
+
+   if(counter)
+      counter->incCount();
+
+   return true;
+}
+
+/**
+ * Queue a request (waits if the max number of requests is in flight already).
+ *
+ * @param completion NULL to queue the stop NOP for the reaper thread.
+ */
+void IoUringEngine::submit(IoUringCompletion* completion)
+{
+   SafeMutexLock mutexLock(&mutex);
+
+   while(numInFlight >= sqEntries)
+      inFlightCond.wait(&mutex);
+
+   numInFlight++;
+
+   queueSQEUnlocked(completion, completion ?
+      (uintptr_t)completion : IOURINGENGINE_USERDATA_STOP);
+
+   /* if another thread is inside io_uring_enter() right now, it will pick up our entry after
+      its current call, so that requests arriving at the same time get batched */
+   if(!submitInProgress)
+      flushSubmissionsUnlocked(&mutexLock);
+
+   mutexLock.unlock();
+}
+
+/**
+ * Fill the next submission entry and make it visible to the kernel (without io_uring_enter).
+ *
+ * Note: Caller must hold the mutex.
+ */
+void IoUringEngine::queueSQEUnlocked(IoUringCompletion* completion, uint64_t userData)
+{
+   unsigned tail = *sqTail; // (only we modify the tail)
+   unsigned index = tail & *sqMask;
+   struct io_uring_sqe* sqe = &sqes[index];
+
+   memset(sqe, 0, sizeof(*sqe) );
+
+   sqe->user_data = userData;
+
+   if(!completion)
+      sqe->opcode = IORING_OP_NOP;
+   else
+   {
+      sqe->opcode = completion->opcode;
+      sqe->fd = completion->fd;
+
+      switch(completion->opcode)
+      {
+         case IORING_OP_WRITE:
+         {
+            sqe->addr = (uintptr_t)(completion->buf + completion->numDone);
+            sqe->len = BEEGFS_MIN(completion->count - completion->numDone,
+               (size_t)IOURINGENGINE_MAX_RW_LEN);
+            sqe->off = completion->offset + completion->numDone;
+         } break;
+
+         case IORING_OP_FADVISE:
+         {
+            sqe->off = completion->offset;
+            sqe->len = completion->count;
+            sqe->fadvise_advice = POSIX_FADV_WILLNEED;
+         } break;
+
+         case IORING_OP_SYNC_FILE_RANGE:
+         {
+            sqe->off = completion->offset;
+            sqe->len = completion->count;
+            sqe->sync_range_flags = SYNC_FILE_RANGE_WRITE;
+         } break;
+
+         default:
+            break;
+      }
+   }
+
+   sqArray[index] = index;
+
+   __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+
+   numUnsubmitted++;
+}
+
+/**
+ * Pass all queued entries to the kernel, including those that are queued by other threads while
+ * we are inside io_uring_enter().
+ *
+ * Note: Caller must hold the mutex, which will be temporarily released.
+ */
+void IoUringEngine::flushSubmissionsUnlocked(SafeMutexLock* mutexLock)
+{
+   submitInProgress = true;
+
+   while(numUnsubmitted)
+   {
+      unsigned numToSubmit = numUnsubmitted;
+
+      mutexLock->unlock();
+
+      int submitRes = ioUringEnter(ringFD, numToSubmit, 0, 0);
+      int submitErrno = errno;
+
+      mutexLock->relock();
+
+      if(unlikely(submitRes == -1) )
+      {
+         if(submitErrno == EINTR)
+            continue;
+
+         // (EAGAIN means the kernel is temporarily out of memory for requests)
+         if(submitErrno != EAGAIN)
+            log.logErr("io_uring submission failed: " + System::getErrString(submitErrno) );
+
+         mutexLock->unlock();
+         PThread::sleepMS(IOURINGENGINE_RETRY_WAIT_MS);
+         mutexLock->relock();
+
+         continue;
+      }
+
+      numUnsubmitted -= submitRes;
+   }
+
+   submitInProgress = false;
+}
+
+/**
+ * Write all of the given data (short writes are resubmitted internally). Results have the same
+ * semantics as MsgHelperIO::pwriteAll().
+ */
+void IoUringEngine::submitWrite(int fd, const void* buf, size_t count, off_t offset,
+   ssize_t* outRes, int* outErrno, SynchronizedCounter* counter)
+{
+   IoUringCompletion* completion = new IoUringCompletion();
+
+   completion->opcode = IORING_OP_WRITE;
+   completion->fd = fd;
+   completion->ownsFD = false;
+   completion->buf = (char*)buf;
+   completion->count = count;
+   completion->offset = offset;
+   completion->numDone = 0;
+   completion->outRes = outRes;
+   completion->outErrno = outErrno;
+   completion->counter = counter;
+
+   submit(completion);
+}
+
+/**
+ * Asynchronous posix_fadvise(POSIX_FADV_WILLNEED); caller doesn't wait for the result.
+ *
+ * The request uses a dup() of fd, because the caller might close fd (e.g. on session close) before
+ * the request is done and the fd number might be reused for another file by then.
+ *
+ * @param len must fit into 32 bits
+ */
+void IoUringEngine::submitFAdviseWillNeed(int fd, off_t offset, off_t len)
+{
+   int requestFD = dup(fd);
+   if(unlikely(requestFD == -1) )
+   { // out of fds => do it synchronously
+      posix_fadvise(fd, offset, len, POSIX_FADV_WILLNEED);
+      return;
+   }
+
+   IoUringCompletion* completion = new IoUringCompletion();
+
+   completion->opcode = IORING_OP_FADVISE;
+   completion->fd = requestFD;
+   completion->ownsFD = true;
+   completion->buf = NULL;
+   completion->count = len;
+   completion->offset = offset;
+   completion->numDone = 0;
+   completion->outRes = NULL;
+   completion->outErrno = NULL;
+   completion->counter = NULL;
+
+   submit(completion);
+}
+
+/**
+ * Asynchronous sync_file_range(SYNC_FILE_RANGE_WRITE); caller doesn't wait for the result.
+ *
+ * Like submitFAdviseWillNeed(), each request uses its own dup() of fd.
+ */
+void IoUringEngine::submitSyncFileRange(int fd, off64_t offset, off64_t nbytes)
+{
+   // the length field of the submission entry has only 32 bits => split large ranges
+
+   do
+   {
+      off64_t currentLen = BEEGFS_MIN(nbytes, IOURINGENGINE_MAX_RW_LEN);
+
+      int requestFD = dup(fd);
+      if(unlikely(requestFD == -1) )
+      { // out of fds => do the rest synchronously
+         sync_file_range(fd, offset, nbytes, SYNC_FILE_RANGE_WRITE);
+         return;
+      }
+
+      IoUringCompletion* completion = new IoUringCompletion();
+
+      completion->opcode = IORING_OP_SYNC_FILE_RANGE;
+      completion->fd = requestFD;
+      completion->ownsFD = true;
+      completion->buf = NULL;
+      completion->count = currentLen;
+      completion->offset = offset;
+      completion->numDone = 0;
+      completion->outRes = NULL;
+      completion->outErrno = NULL;
+      completion->counter = NULL;
+
+      submit(completion);
+
+      offset += currentLen;
+      nbytes -= currentLen;
+
+   } while(nbytes > 0);
+}
+
+#else // CONFIG_SYSTEM_HAS_IO_URING
+
+
+/* without io_uring support at compile time, the engine can never be instantiated, so the methods
+   below only exist to satisfy the linker */
+
+IoUringEngine::IoUringEngine(unsigned queueDepth) throw(ComponentInitException) :
+   PThread("IoUring"), log("IoUring")
+{
+   throw ComponentInitException("This binary was built without io_uring support");
+}
+
+IoUringEngine::~IoUringEngine() {}
+
+void IoUringEngine::run() {}
+void IoUringEngine::stopReaping() {}
+
+void IoUringEngine::submitWrite(int fd, const void* buf, size_t count, off_t offset,
+   ssize_t* outRes, int* outErrno, SynchronizedCounter* counter) {}
+void IoUringEngine::submitFAdviseWillNeed(int fd, off_t offset, off_t len) {}
+void IoUringEngine::submitSyncFileRange(int fd, off64_t offset, off64_t nbytes) {}
+
+#endif // CONFIG_SYSTEM_HAS_IO_URING
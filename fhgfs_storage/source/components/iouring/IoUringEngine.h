@@ -0,0 +1,107 @@
+#ifndef IOURINGENGINE_H_
+#define IOURINGENGINE_H_
+
+#include <common/app/log/LogContext.h>
+#include <common/components/ComponentInitException.h>
+#include <common/threading/Condition.h>
+#include <common/threading/Mutex.h>
+#include <common/threading/PThread.h>
+#include <common/threading/SafeMutexLock.h>
+#include <common/toolkit/SynchronizedCounter.h>
+#include <common/Common.h>
+
+
+/**
+ * Completion record of a submitted request. Allocated at submission and deleted by the reaper
+ * thread after the result has been handed over to the submitter.
+ */
+struct IoUringCompletion
+{
+   uint8_t opcode;
+   int fd;
+   bool ownsFD; // fd is a dup() that is closed on completion (for fire-and-forget requests)
+   char* buf;
+   size_t count; // total number of bytes for write
+   off_t offset;
+   size_t numDone; // number of bytes already done (for resubmission of short writes)
+
+   ssize_t* outRes; // may be NULL for fire-and-forget requests
+   int* outErrno; // may be NULL for fire-and-forget requests
+   SynchronizedCounter* counter; // may be NULL for fire-and-forget requests
+};
+
+
+/**
+ * Asynchronous chunk file IO based on the linux io_uring interface.
+ *
+ * Workers put their requests into a single submission ring that is shared among all sessions and
+ * targets. Submission is done by whichever worker finds no other submission in progress, so
+ * requests that arrive while the kernel is busy with an io_uring_enter() call get batched into the
+ * next call. A separate thread reaps the completions and wakes up the waiting workers.
+ *
+ * The number of requests in flight is limited by the ring size (tuneIoUringQueueDepth), so that
+ * the completion ring can never overflow.
+ *
+ * Note: We use the raw syscalls here to avoid a dependency on liburing.
+ */
+class IoUringEngine : public PThread
+{
+   public:
+      IoUringEngine(unsigned queueDepth) throw(ComponentInitException);
+      virtual ~IoUringEngine();
+
+      void stopReaping();
+
+      void submitWrite(int fd, const void* buf, size_t count, off_t offset,
+         ssize_t* outRes, int* outErrno, SynchronizedCounter* counter);
+      void submitFAdviseWillNeed(int fd, off_t offset, off_t len);
+      void submitSyncFileRange(int fd, off64_t offset, off64_t nbytes);
+
+
+   private:
+      LogContext log;
+
+      int ringFD;
+      unsigned sqEntries;
+      unsigned cqEntries;
+
+      void* sqRingPtr;
+      size_t sqRingSize;
+      void* cqRingPtr;
+      size_t cqRingSize;
+      struct io_uring_sqe* sqes;
+      size_t sqesSize;
+
+      // pointers into the mmapped rings
+      unsigned* sqHead;
+      unsigned* sqTail;
+      unsigned* sqMask;
+      unsigned* sqArray;
+      unsigned* cqHead;
+      unsigned* cqTail;
+      unsigned* cqMask;
+      struct io_uring_cqe* cqes;
+
+      Mutex mutex; // protects the fields below
+      Condition inFlightCond; // signaled when requests completed
+      unsigned numInFlight; // number of requests that were queued and not reaped yet
+      unsigned numUnsubmitted; // queued in the submission ring, but not passed to the kernel
+      bool submitInProgress; // true while a thread is inside io_uring_enter() for submission
+
+
+      virtual void run();
+
+      void initRing() throw(ComponentInitException);
+      void probeOps();
+      void uninitRing();
+
+      void reapLoop();
+      unsigned reapCompletions(bool* outStopReceived);
+      bool handleCompletion(IoUringCompletion* completion, int32_t res);
+
+      void submit(IoUringCompletion* completion);
+      void queueSQEUnlocked(IoUringCompletion* completion, uint64_t userData);
+      void flushSubmissionsUnlocked(SafeMutexLock* mutexLock);
+};
+
+#endif /* IOURINGENGINE_H_ */
@@ -0,0 +1,12 @@
+#include <net/msghelpers/MsgHelperIO.h>
+#include "ChunkWriteWork.h"
+
+void ChunkWriteWork::process(char* bufIn, unsigned bufInLen, char* bufOut, unsigned bufOutLen)
+{
+   int errCode = 0;
+
+   *outWriteRes = MsgHelperIO::pwriteAll(fd, buf, count, offset, errCode);
+   *outErrno = errCode;
+
+   counter->incCount();
+}
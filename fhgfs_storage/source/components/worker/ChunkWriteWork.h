@@ -0,0 +1,51 @@
+#ifndef CHUNKWRITEWORK_H_
+#define CHUNKWRITEWORK_H_
+
+#include <common/components/worker/Work.h>
+#include <common/toolkit/SynchronizedCounter.h>
+#include <common/Common.h>
+
+
+/**
+ * Writes a buffer to a chunk file on behalf of a worker, so that the worker can already receive
+ * the next part of the incoming data while this write is running (see WriteLocalFileMsgEx
+ * pipelined write mode).
+ *
+ * Note: The buffer is owned by the caller and must not be modified before the counter was
+ * increased.
+ */
+class ChunkWriteWork : public Work
+{
+   public:
+      /**
+       * @param outWriteRes number of bytes written or -1 if nothing could be written.
+       * @param outErrno errno of the failed write (only valid if outWriteRes is not count).
+       * @param counter will be increased when the write is complete.
+       */
+      ChunkWriteWork(int fd, const char* buf, size_t count, off_t offset, ssize_t* outWriteRes,
+         int* outErrno, SynchronizedCounter* counter) : fd(fd), buf(buf), count(count),
+         offset(offset), outWriteRes(outWriteRes), outErrno(outErrno), counter(counter)
+      {
+         // all assignments done in initializer list
+      }
+
+      virtual ~ChunkWriteWork()
+      {
+      }
+
+
+      virtual void process(char* bufIn, unsigned bufInLen, char* bufOut, unsigned bufOutLen);
+
+
+   private:
+      int fd;
+      const char* buf; // not owned by this object
+      size_t count;
+      off_t offset;
+
+      ssize_t* outWriteRes;
+      int* outErrno;
+      SynchronizedCounter* counter;
+};
+
+#endif /* CHUNKWRITEWORK_H_ */
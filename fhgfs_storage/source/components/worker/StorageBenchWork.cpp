@@ -1,6 +1,7 @@
 #include <common/app/log/LogContext.h>
 #include <common/benchmark/StorageBench.h>
 #include <common/toolkit/StringTk.h>
+#include <common/toolkit/TimeFine.h>
 #include <program/Program.h>
 #include "StorageBenchWork.h"
 
@@ -15,23 +16,11 @@ void StorageBenchWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
    int workRes = 0; // return value for benchmark operator
    ssize_t ioRes = 0; // read/write result
 
+   TimeFine startTime;
+
    if (this->type == StorageBenchType_READ)
    {
-      size_t readSize = cfg->getTuneFileReadSize();
-      size_t toBeRead = this->bufLen;
-      size_t bufOffset = 0;
-
-      while(toBeRead)
-      {
-         size_t currentReadSize = BEEGFS_MIN(readSize, toBeRead);
-
-         ioRes = read(this->fileDescriptor, &this->buf[bufOffset], currentReadSize);
-         if (ioRes <= 0)
-            break;
-
-         toBeRead -= currentReadSize;
-         bufOffset += currentReadSize;
-      }
+      ioRes = doRead(cfg->getTuneFileReadSize() );
 
       app->getNodeOpStats()->updateNodeOp(0, StorageOpCounter_READOPS,
          this->bufLen, NETMSG_DEFAULT_USERID);
@@ -39,21 +28,15 @@ void StorageBenchWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
    else
    if (this->type == StorageBenchType_WRITE)
    {
-      size_t writeSize = cfg->getTuneFileWriteSize();
-      size_t toBeWritten = this->bufLen;
-      size_t bufOffset = 0;
+      ioRes = doWrite(this->fileDescriptor, cfg->getTuneFileWriteSize() );
 
-      while(toBeWritten)
-      {
-         size_t currentWriteSize = BEEGFS_MIN(writeSize, toBeWritten);
-
-         ioRes = write(this->fileDescriptor, &this->buf[bufOffset], currentWriteSize);
-         if (ioRes <= 0)
-            break;
-
-         toBeWritten -= currentWriteSize;
-         bufOffset += currentWriteSize;
-      }
+      app->getNodeOpStats()->updateNodeOp(0, StorageOpCounter_WRITEOPS,
+         this->bufLen, NETMSG_DEFAULT_USERID);
+   }
+   else
+   if (this->type == StorageBenchType_CREATE)
+   {
+      ioRes = doCreate(cfg->getTuneFileWriteSize() );
 
       app->getNodeOpStats()->updateNodeOp(0, StorageOpCounter_WRITEOPS,
          this->bufLen, NETMSG_DEFAULT_USERID);
@@ -64,6 +47,8 @@ void StorageBenchWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
       LogContext(logContext).logErr("Error: unknown benchmark type");
    }
 
+   this->latencies->addValue(TimeFine().elapsedSinceMicro(&startTime) );
+
    if(unlikely(workRes < 0) || unlikely(ioRes == -1) )
    { // error occurred
       if (ioRes == -1)
@@ -82,3 +67,94 @@ void StorageBenchWork::process(char* bufIn, unsigned bufInLen, char* bufOut,
    }
 }
 
+/**
+ * Read bufLen bytes from the benchmark file (at the given offset for random reads).
+ *
+ * @return result of the last read call (-1 on error)
+ */
+ssize_t StorageBenchWork::doRead(size_t readSize)
+{
+   ssize_t ioRes = 0;
+   size_t toBeRead = this->bufLen;
+   size_t bufOffset = 0;
+
+   while(toBeRead)
+   {
+      size_t currentReadSize = BEEGFS_MIN(readSize, toBeRead);
+
+      if(this->offset < 0)
+         ioRes = read(this->fileDescriptor, &this->buf[bufOffset], currentReadSize);
+      else
+         ioRes = pread(this->fileDescriptor, &this->buf[bufOffset], currentReadSize,
+            this->offset + bufOffset);
+
+      if (ioRes <= 0)
+         break;
+
+      toBeRead -= currentReadSize;
+      bufOffset += currentReadSize;
+   }
+
+   return ioRes;
+}
+
+/**
+ * Write bufLen bytes to the given file (at the given offset for random writes).
+ *
+ * @return result of the last write call (-1 on error)
+ */
+ssize_t StorageBenchWork::doWrite(int fd, size_t writeSize)
+{
+   ssize_t ioRes = 0;
+   size_t toBeWritten = this->bufLen;
+   size_t bufOffset = 0;
+
+   while(toBeWritten)
+   {
+      size_t currentWriteSize = BEEGFS_MIN(writeSize, toBeWritten);
+
+      if(this->offset < 0)
+         ioRes = write(fd, &this->buf[bufOffset], currentWriteSize);
+      else
+         ioRes = pwrite(fd, &this->buf[bufOffset], currentWriteSize, this->offset + bufOffset);
+
+      if (ioRes <= 0)
+         break;
+
+      toBeWritten -= currentWriteSize;
+      bufOffset += currentWriteSize;
+   }
+
+   return ioRes;
+}
+
+/**
+ * Create a file, write bufLen bytes to it, close and unlink it.
+ *
+ * @return -1 on error
+ */
+ssize_t StorageBenchWork::doCreate(size_t writeSize)
+{
+   const char* logContext = "Storage Benchmark (create)";
+   mode_t openMode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+
+   int fd = open(this->filePath.c_str(), O_CREAT | O_EXCL | O_WRONLY, openMode);
+   if(fd == -1)
+   {
+      LogContext(logContext).logErr("Unable to create file: " + this->filePath);
+      return -1;
+   }
+
+   ssize_t ioRes = doWrite(fd, writeSize);
+
+   int closeRes = close(fd);
+   int unlinkRes = unlink(this->filePath.c_str() );
+
+   if( (closeRes == -1) || (unlinkRes == -1) )
+   {
+      LogContext(logContext).logErr("Unable to close/unlink file: " + this->filePath);
+      return -1;
+   }
+
+   return ioRes;
+}
@@ -4,6 +4,7 @@
 #include <common/benchmark/StorageBench.h>
 #include <common/components/worker/Work.h>
 #include <common/toolkit/Pipe.h>
+#include <components/benchmarker/StorageBenchLatencyHistogram.h>
 #include <common/Common.h>
 
 
@@ -11,8 +12,18 @@
 class StorageBenchWork: public Work
 {
    public:
+      /**
+       * @param type READ or WRITE for the block based benchmark types (i.e. the type of this
+       *    single operation) or CREATE.
+       * @param offset file offset for the random types, -1 to read/write at the current file
+       *    position.
+       * @param filePath path of the file to be created and unlinked (CREATE only).
+       * @param latencies the histogram of the benchmark thread (may not be used by other works at
+       *    the same time).
+       */
       StorageBenchWork(uint16_t targetID, int threadID, int fileDescriptor,
-         StorageBenchType type, int64_t bufLen, Pipe* operatorCommunication, char* buf)
+         StorageBenchType type, int64_t bufLen, Pipe* operatorCommunication, char* buf,
+         int64_t offset, std::string filePath, StorageBenchLatencyHistogram* latencies)
       {
          this->targetID = targetID;
          this->threadID = threadID;
@@ -22,6 +33,10 @@ class StorageBenchWork: public Work
          this->bufLen = bufLen;
          this->operatorCommunication = operatorCommunication;
          this->buf = buf;
+
+         this->offset = offset;
+         this->filePath = filePath;
+         this->latencies = latencies;
       }
 
       virtual ~StorageBenchWork()
@@ -40,6 +55,14 @@ class StorageBenchWork: public Work
       int64_t bufLen;
       char* buf;
       Pipe* operatorCommunication;
+
+      int64_t offset; // -1 for sequential I/O
+      std::string filePath; // only for CREATE
+      StorageBenchLatencyHistogram* latencies;
+
+      ssize_t doRead(size_t readSize);
+      ssize_t doWrite(int fd, size_t writeSize);
+      ssize_t doCreate(size_t writeSize);
 };
 
 #endif /* STORAGEBENCHWORK_H_ */
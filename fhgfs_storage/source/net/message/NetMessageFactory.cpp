@@ -34,6 +34,7 @@
 #include <common/net/message/storage/creating/UnlinkLocalFileRespMsg.h>
 #include <common/net/message/storage/listing/ListChunkDirIncrementalRespMsg.h>
 #include <common/net/message/storage/lookup/FindOwnerRespMsg.h>
+#include <common/net/message/storage/mirroring/GetChunkBlockChecksumsRespMsg.h>
 #include <common/net/message/storage/mirroring/ResyncLocalFileRespMsg.h>
 #include <common/net/message/storage/mirroring/StorageResyncStartedRespMsg.h>
 #include <common/net/message/storage/quota/GetQuotaInfoMsg.h>
@@ -42,6 +43,7 @@
 #include <common/net/message/storage/GetStorageTargetInfoRespMsg.h>
 #include <common/net/message/storage/SetStorageTargetInfoRespMsg.h>
 #include <net/message/storage/attribs/GetChunkFileAttribsMsgEx.h>
+#include <net/message/storage/attribs/GetChunkFileAttribsMultiMsgEx.h>
 #include <net/message/storage/attribs/SetLocalAttrMsgEx.h>
 #include <net/message/storage/attribs/UpdateBacklinkMsgEx.h>
 #include <net/message/storage/creating/MkLocalFileMsgEx.h>
@@ -49,6 +51,7 @@
 #include <net/message/storage/creating/UnlinkLocalFileMsgEx.h>
 #include <net/message/storage/listing/ListChunkDirIncrementalMsgEx.h>
 #include <net/message/storage/mirroring/GetStorageResyncStatsMsgEx.h>
+#include <net/message/storage/mirroring/GetChunkBlockChecksumsMsgEx.h>
 #include <net/message/storage/mirroring/ResyncLocalFileMsgEx.h>
 #include <net/message/storage/mirroring/SetLastBuddyCommOverrideMsgEx.h>
 #include <net/message/storage/mirroring/StorageResyncStartedMsgEx.h>
@@ -132,7 +135,10 @@ NetMessage* NetMessageFactory::createFromMsgType(unsigned short msgType)
 
       // storage messages
       case NETMSGTYPE_FindOwnerResp: { msg = new FindOwnerRespMsg(); } break;
+      case NETMSGTYPE_GetChunkBlockChecksums: { msg = new GetChunkBlockChecksumsMsgEx(); } break;
+      case NETMSGTYPE_GetChunkBlockChecksumsResp: { msg = new GetChunkBlockChecksumsRespMsg(); } break;
       case NETMSGTYPE_GetChunkFileAttribs: { msg = new GetChunkFileAttribsMsgEx(); } break;
+      case NETMSGTYPE_GetChunkFileAttribsMulti: { msg = new GetChunkFileAttribsMultiMsgEx(); } break;
       case NETMSGTYPE_GetHighResStats: { msg = new GetHighResStatsMsgEx(); } break;
       case NETMSGTYPE_GetQuotaInfo: {msg = new GetQuotaInfoMsgEx(); } break;
       case NETMSGTYPE_GetStorageResyncStats: { msg = new GetStorageResyncStatsMsgEx(); } break;
@@ -14,6 +14,7 @@ bool StorageBenchControlMsgEx::processIncoming(struct sockaddr_in* fromAddr, Soc
       peer);
 
    StorageBenchResultsMap results;
+   StorageBenchLatencyResultsMap latencyResults;
    int cmdErrorCode = STORAGEBENCH_ERROR_NO_ERROR;
 
    App* app = Program::getApp();
@@ -27,7 +28,7 @@ bool StorageBenchControlMsgEx::processIncoming(struct sockaddr_in* fromAddr, Soc
       case StorageBenchAction_START:
       {
          cmdErrorCode = storageBench->initAndStartStorageBench(&targetIDs, getBlocksize(),
-            getSize(), getThreads(), getType() );
+            getSize(), getThreads(), getReadPercent(), getType() );
       } break;
 
       case StorageBenchAction_STOP:
@@ -37,7 +38,7 @@ bool StorageBenchControlMsgEx::processIncoming(struct sockaddr_in* fromAddr, Soc
 
       case StorageBenchAction_STATUS:
       {
-         storageBench->getStatusWithResults(&targetIDs, &results);
+         storageBench->getStatusWithResults(&targetIDs, &results, &latencyResults);
          cmdErrorCode = STORAGEBENCH_ERROR_NO_ERROR;
       } break;
 
@@ -69,6 +70,9 @@ bool StorageBenchControlMsgEx::processIncoming(struct sockaddr_in* fromAddr, Soc
    // send response
    StorageBenchControlMsgResp respMsg(storageBench->getStatus(), getAction(),
       storageBench->getType(), errorCode, results);
+
+   if(isMsgHeaderCompatFeatureFlagSet(STORAGEBENCHCONTROLMSG_COMPAT_FLAG_LATENCIES) )
+      respMsg.addLatencyResults(latencyResults);
    respMsg.serialize(respBuf, bufLen);
 
    sock->sendto(respBuf, respMsg.getMsgLength(), 0,
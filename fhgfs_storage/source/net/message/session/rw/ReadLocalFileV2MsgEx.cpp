@@ -149,9 +149,15 @@ bool ReadLocalFileV2MsgEx::processIncoming(struct sockaddr_in* fromAddr, Socket*
       }
 
       // the actual read workhorse...
-      
-      readRes = incrementalReadStatefulAndSendV2(
-         sock, respBuf, bufLen, sessionLocalFile, stats);
+
+      StandardSocket* zeroCopySock = getZeroCopyReadSock(sock, sessionLocalFile);
+
+      if(zeroCopySock)
+         readRes = incrementalReadStatefulAndSendfileV2(
+            zeroCopySock, bufLen, sessionLocalFile, stats);
+      else
+         readRes = incrementalReadStatefulAndSendV2(
+            sock, respBuf, bufLen, sessionLocalFile, stats);
 
       LOG_DEBUG(logContext, Log_SPAM, "sending completed. "
          "readRes: " + StringTk::int64ToStr(readRes) );
@@ -358,6 +364,162 @@ int64_t ReadLocalFileV2MsgEx::incrementalReadStatefulAndSendV2(Socket* sock,
    return(getCount() - toBeRead);
 }
 
+/**
+ * Zero-copy variant of incrementalReadStatefulAndSendV2(), which moves the file data directly from
+ * the chunk file to the socket via sendfile() instead of reading it into the worker buffer first.
+ *
+ * Note: As the length info must be sent before the corresponding data, we take the current file
+ * size as a snapshot and send only data up to this size. If the file is truncated concurrently
+ * while we're sending, we cannot correct the length info anymore and thus throw a SocketException
+ * to make the caller drop the connection (which will make the client retry).
+ *
+ * @param bufLen worker buffer length, only used to keep the same chunk size as the buffered path
+ * @return number of bytes read or some arbitrary negative value otherwise
+ * @throw SocketException
+ */
+int64_t ReadLocalFileV2MsgEx::incrementalReadStatefulAndSendfileV2(StandardSocket* sock,
+   size_t bufLen, SessionLocalFile* sessionLocalFile, HighResolutionStats* stats)
+{
+   // note: see incrementalReadStatefulAndSendV2() for notes on protocol and session offset
+
+   const char* logContext = "ReadChunkFileV2Msg (sendfile incremental)";
+   Config* cfg = Program::getApp()->getConfig();
+
+   const ssize_t dataBufLen = bufLen - READ_BUF_LEN_PROTOCOL_CUTOFF; /* same chunk size as for
+      the buffered path */
+
+   int fd = sessionLocalFile->getFD();
+   int64_t oldOffset = sessionLocalFile->getOffset();
+   int64_t newOffset = getOffset();
+
+   ssize_t readAheadSize = cfg->getTuneFileReadAheadSize();
+   ssize_t readAheadTriggerSize = cfg->getTuneFileReadAheadTriggerSize();
+
+   if( (oldOffset < 0) || (oldOffset != newOffset) )
+   {
+      sessionLocalFile->resetReadCounter(); // reset sequential read counter
+      sessionLocalFile->resetLastReadAheadTrigger();
+   }
+
+   struct stat statBuf;
+
+   int statRes = fstat(fd, &statBuf);
+   if(statRes == -1)
+   { // stat error occurred
+      LogContext(logContext).log(Log_WARNING, "Unable to stat file. "
+         "FileID: " + sessionLocalFile->getFileID() + "; "
+         "SysErr: " + System::getErrString() );
+
+      sessionLocalFile->setOffset(-1);
+      releaseFile();
+      sendLengthInfo(sock, -FhgfsOpsErr_INTERNAL);
+      return -1;
+   }
+
+   uint64_t toBeRead = getCount();
+   size_t maxReadAtOnceLen = dataBufLen;
+
+   // reduce maxReadAtOnceLen to achieve better read/send async overlap
+   if(sessionLocalFile->getReadCounter() >= READ_USE_TUNEFILEREAD_TRIGGER)
+      maxReadAtOnceLen = BEEGFS_MIN(dataBufLen, cfg->getTuneFileReadSize() );
+
+   off_t readOffset = getOffset();
+
+   for( ; ; )
+   {
+      off_t fileRemaining = BEEGFS_MAX( (off_t)0, statBuf.st_size - readOffset);
+      ssize_t wantedLength = BEEGFS_MIN(maxReadAtOnceLen, toBeRead);
+      ssize_t readLength = BEEGFS_MIN(wantedLength, fileRemaining);
+
+      bool isEOF = (readLength < wantedLength);
+
+      LOG_DEBUG(logContext, Log_SPAM,
+         "toBeRead: " + StringTk::int64ToStr(toBeRead) + "; "
+         "readLength: " + StringTk::int64ToStr(readLength) + "; "
+         "fileSize: " + StringTk::int64ToStr(statBuf.st_size) );
+
+      if(readLength)
+      {
+         toBeRead -= readLength;
+
+         sessionLocalFile->setOffset(getOffset() + getCount() - toBeRead); // update offset
+
+         sessionLocalFile->incReadCounter(readLength); // update sequential read length
+
+         stats->incVals.diskReadBytes += readLength; // update stats
+
+         // MSG_MORE: length info and data should go out in the same segment if possible
+         sendLengthInfo(sock, readLength, MSG_MORE);
+
+         ssize_t sendRes = sock->sendfile(fd, readOffset, readLength);
+         if(unlikely(sendRes != readLength) )
+         { // file was truncated concurrently => client expects more data than we can deliver
+            throw SocketException(
+               "File shrunk during sendfile(). "
+               "FileID: " + sessionLocalFile->getFileID() + "; "
+               "Expected: " + StringTk::int64ToStr(readLength) + "; "
+               "Sent: " + StringTk::int64ToStr(sendRes) );
+         }
+
+         readOffset += readLength;
+
+         checkAndStartReadAhead(sessionLocalFile, readAheadTriggerSize, readOffset,
+            readAheadSize);
+      }
+
+      if(!toBeRead || isEOF)
+      { // we reached the end of the requested data (or end of file)
+         if(isEOF)
+            LOG_DEBUG(logContext, Log_DEBUG,
+               "Unable to read all of the requested data (=> end of file). "
+               "offset: " + StringTk::int64ToStr(getOffset() ) + "; "
+               "count: " + StringTk::int64ToStr(getCount() ) + "; "
+               "toBeRead: " + StringTk::int64ToStr(toBeRead) );
+
+         releaseFile();
+
+         sendLengthInfo(sock, 0);
+
+         return(getCount() - toBeRead);
+      }
+
+   } // end of for-loop
+
+   return(getCount() - toBeRead);
+}
+
+/**
+ * Decide whether the zero-copy read path can be used for this request.
+ *
+ * Note: The zero-copy path is only available for plain TCP sockets, because sendfile() can't
+ * write to RDMA (or SDP) connections, and for sessions without direct IO, because sendfile()
+ * always reads through the page cache.
+ *
+ * Note: The sock type alone is not enough, because wrappers like MuxReplySocket report the type of
+ * the underlying socket.
+ *
+ * @return the socket to use for the zero-copy path or NULL to use the copying path.
+ */
+StandardSocket* ReadLocalFileV2MsgEx::getZeroCopyReadSock(Socket* sock,
+   SessionLocalFile* sessionLocalFile)
+{
+   Config* cfg = Program::getApp()->getConfig();
+
+   if(!cfg->getTuneFileReadZeroCopy() )
+      return NULL;
+
+   if(sock->getSockType() != NICADDRTYPE_STANDARD)
+      return NULL;
+
+   if(sessionLocalFile->getIsDirectIO() )
+      return NULL;
+
+   if(isMsgHeaderFeatureFlagSet(READLOCALFILEMSG_FLAG_DISABLE_IO) )
+      return NULL; // benchmark mode without disk access => no file data to send
+
+   return dynamic_cast<StandardSocket*>(sock);
+}
+
 /**
  * Starts read-ahead if enough sequential data has been read.
  *
@@ -2,6 +2,7 @@
 #define READLOCALFILEV2MSGEX_H_
 
 #include <common/net/message/session/rw/ReadLocalFileV2Msg.h>
+#include <common/net/sock/StandardSocket.h>
 #include <common/storage/StorageErrors.h>
 #include <session/SessionLocalFileStore.h>
 
@@ -26,6 +27,10 @@ class ReadLocalFileV2MsgEx : public ReadLocalFileV2Msg
 
       int64_t incrementalReadStatefulAndSendV2(Socket* sock,
          char* buf, size_t bufLen, SessionLocalFile* sessionLocalFile, HighResolutionStats* stats);
+      int64_t incrementalReadStatefulAndSendfileV2(StandardSocket* sock,
+         size_t bufLen, SessionLocalFile* sessionLocalFile, HighResolutionStats* stats);
+
+      StandardSocket* getZeroCopyReadSock(Socket* sock, SessionLocalFile* sessionLocalFile);
 
       void checkAndStartReadAhead(SessionLocalFile* sessionLocalFile, ssize_t readAheadTriggerSize,
          off_t currentOffset, off_t readAheadSize);
@@ -39,12 +44,12 @@ class ReadLocalFileV2MsgEx : public ReadLocalFileV2Msg
        * Send only length information without a data packet. Typically used for the final length
        * info at the end of the requested data.
        */
-      inline void sendLengthInfo(Socket* sock, int64_t lengthInfo)
+      inline void sendLengthInfo(Socket* sock, int64_t lengthInfo, int flags=0)
       {
          char lengthInfoBuf[sizeof(int64_t)];
          Serialization::serializeInt64(lengthInfoBuf, lengthInfo);
 
-         sock->send(&lengthInfoBuf, sizeof(int64_t), 0);   
+         sock->send(&lengthInfoBuf, sizeof(int64_t), flags);
       }
 
       /**
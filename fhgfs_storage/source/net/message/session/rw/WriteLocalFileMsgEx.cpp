@@ -4,6 +4,7 @@
 #include <common/toolkit/SessionTk.h>
 #include <common/toolkit/StorageTk.h>
 #include <common/toolkit/VersionTk.h>
+#include <components/worker/ChunkWriteWork.h>
 #include <net/msghelpers/MsgHelperIO.h>
 #include <storage/StorageTargets.h>
 #include <toolkit/StorageTkEx.h>
@@ -254,11 +255,6 @@ int64_t WriteLocalFileMsgEx::incrementalRecvAndWriteStateful(Socket* sock,
    const char* logContext = "WriteChunkFileMsg (write incremental)";
    Config* cfg = Program::getApp()->getConfig();
 
-   const int timeoutMS = CONN_MEDIUM_TIMEOUT;
-
-   const ssize_t exactStaticRecvSize = sessionLocalFile->getIsDirectIO() ?
-      bufLen : BEEGFS_MIN(bufLen, cfg->getTuneFileWriteSize() );
-
    int fd = sessionLocalFile->getFD();
 
    int64_t oldOffset = sessionLocalFile->getOffset();
@@ -282,10 +278,58 @@ int64_t WriteLocalFileMsgEx::incrementalRecvAndWriteStateful(Socket* sock,
 
    // incrementally receive file contents...
 
+   int64_t recvAndWriteRes = usePipelinedWrite(sessionLocalFile) ?
+      recvAndWritePipelined(sock, buf, bufLen, sessionLocalFile) :
+      recvAndWriteSequential(sock, buf, bufLen, sessionLocalFile);
+
+   if(recvAndWriteRes != getCount() )
+      return recvAndWriteRes; // error or not all data written
+
+   LOG_DEBUG(logContext, Log_SPAM,
+      std::string("Received and wrote all the data") );
+   IGNORE_UNUSED_VARIABLE(logContext);
+
+   // commit to storage device queue...
+
+   if (useSyncRange)
+   {
+      // advise kernel to commit written data to storage device in max_sectors_kb chunks.
+
+      /* note: this is async if there are free slots in the request queue
+         /sys/block/<...>/nr_requests. (optimal_io_size is not honoured as of linux-3.4) */
+
+      off64_t syncSize = sessionLocalFile->getWriteCounter();
+      off64_t syncOffset = getOffset() + getCount() - syncSize;
+
+      MsgHelperIO::syncFileRange(fd, syncOffset, syncSize);
+      sessionLocalFile->resetWriteCounter();
+   }
+
+   return getCount();
+}
+
+/**
+ * The classic receive/write loop of incrementalRecvAndWriteStateful(): receive a part of the data,
+ * forward it to the mirror and write it to the chunk file before receiving the next part.
+ *
+ * @return number of written bytes or negative fhgfs error code
+ */
+int64_t WriteLocalFileMsgEx::recvAndWriteSequential(Socket* sock, char* buf, ssize_t bufLen,
+   SessionLocalFile* sessionLocalFile)
+{
+   const char* logContext = "WriteChunkFileMsg (write incremental)";
+   Config* cfg = Program::getApp()->getConfig();
+
+   const int timeoutMS = CONN_MEDIUM_TIMEOUT;
+
+   const ssize_t exactStaticRecvSize = sessionLocalFile->getIsDirectIO() ?
+      bufLen : BEEGFS_MIN(bufLen, cfg->getTuneFileWriteSize() );
+
+   int fd = sessionLocalFile->getFD();
+
    int64_t toBeReceived = getCount();
    off_t writeOffset = getOffset();
 
-
    do
    {
       // receive some bytes...
@@ -311,7 +355,7 @@ int64_t WriteLocalFileMsgEx::incrementalRecvAndWriteStateful(Socket* sock,
 
       int errCode = 0;
       ssize_t writeRes = unlikely(isMsgHeaderFeatureFlagSet(WRITELOCALFILEMSG_FLAG_DISABLE_IO) ) ?
-         recvRes : doWrite(fd, buf, recvRes, writeOffset, errCode);
+         recvRes : MsgHelperIO::pwriteAll(fd, buf, recvRes, writeOffset, errCode);
 
       toBeReceived -= recvRes;
 
@@ -356,52 +400,226 @@ int64_t WriteLocalFileMsgEx::incrementalRecvAndWriteStateful(Socket* sock,
 
    } while(toBeReceived);
 
-   LOG_DEBUG(logContext, Log_SPAM,
-      std::string("Received and wrote all the data") );
+   return getCount();
+}
 
-   // commit to storage device queue...
+/**
+ * Pipelined version of recvAndWriteSequential().
+ *
+ * The buffer is split into multiple slots. While the disk write of a slot is done by one of the
+ * write slaves (or is in flight in the io_uring engine), the worker already receives the next data
+ * into the next slot and forwards it to the mirror, so that network transfer and disk writes
+ * overlap.
+ *
+ * Note: Forwarding to the mirror is still done by the calling worker thread in the original order
+ * of the data, because the mirror expects to receive the data in one continuous stream.
+ *
+ * @return number of written bytes or negative fhgfs error code
+ */
+int64_t WriteLocalFileMsgEx::recvAndWritePipelined(Socket* sock, char* buf, ssize_t bufLen,
+   SessionLocalFile* sessionLocalFile)
+{
+   const char* logContext = "WriteChunkFileMsg (write pipelined)";
+   App* app = Program::getApp();
+   Config* cfg = app->getConfig();
+   MultiWorkQueue* writeSlaveQueue = app->getWriteSlaveQueue();
+   IoUringEngine* ioUringEngine = app->getIoUringEngine(); // used instead of slaves if set
 
-   if (useSyncRange)
+   const int timeoutMS = CONN_MEDIUM_TIMEOUT;
+   const long pageSize = sysconf(_SC_PAGESIZE);
+
+   const unsigned numSlots = cfg->getTuneFileWritePipelineDepth();
+
+   // slot size must be a multiple of the page size to keep buffers aligned for direct IO
+   ssize_t slotLen = ( (bufLen / numSlots) / pageSize) * pageSize;
+   if(!sessionLocalFile->getIsDirectIO() )
+      slotLen = BEEGFS_MIN(slotLen, cfg->getTuneFileWriteSize() );
+
+   if(unlikely(!slotLen) ) // buffer too small for the given number of slots
+      return recvAndWriteSequential(sock, buf, bufLen, sessionLocalFile);
+
+   int fd = sessionLocalFile->getFD();
+
+   WritePipelineSlot* slots = new WritePipelineSlot[numSlots];
+
+   for(unsigned i=0; i < numSlots; i++)
    {
-      // advise kernel to commit written data to storage device in max_sectors_kb chunks.
+      slots[i].buf = &buf[i * slotLen];
+      slots[i].isPending = false;
+   }
 
-      /* note: this is async if there are free slots in the request queue
-         /sys/block/<...>/nr_requests. (optimal_io_size is not honoured as of linux-3.4) */
+   int64_t toBeReceived = getCount();
+   off_t writeOffset = getOffset();
 
-      off64_t syncSize = sessionLocalFile->getWriteCounter();
-      off64_t syncOffset = getOffset() + getCount() - syncSize;
+   int64_t numWritten = 0; // contiguous number of successfully written bytes from msg offset
+   bool writeFailed = false;
+   ssize_t failedWriteRes = 0; // result of the first failed write
+   int failedWriteErrno = 0;
+   bool mirrorFailed = false;
 
-      MsgHelperIO::syncFileRange(fd, syncOffset, syncSize);
-      sessionLocalFile->resetWriteCounter();
+   unsigned currentSlotIndex = 0; // the next slot to receive to (also the oldest pending slot)
+
+   try
+   {
+   while(toBeReceived)
+   {
+      WritePipelineSlot* slot = &slots[currentSlotIndex];
+
+      // wait for completion of the previous write from this slot...
+
+      if(slot->isPending)
+      {
+         slot->counter.waitForCount(1);
+         slot->counter.resetUnsynced();
+         slot->isPending = false;
+
+         if(likely(slot->writeRes == slot->len) )
+            numWritten += slot->len;
+         else
+         { // write error => stop here
+            writeFailed = true;
+            failedWriteRes = slot->writeRes;
+            failedWriteErrno = slot->writeErrno;
+            break;
+         }
+      }
+
+      // receive some bytes...
+
+      LOG_DEBUG(logContext, Log_SPAM,
+         "receiving... (remaining: " + StringTk::int64ToStr(toBeReceived) + ")");
+
+      ssize_t recvLength = BEEGFS_MIN(slotLen, toBeReceived);
+      ssize_t recvRes = sock->recvExactT(slot->buf, recvLength, 0, timeoutMS);
+
+      // hand over to write slave...
+
+      slot->len = recvRes;
+      slot->offset = writeOffset;
+      slot->writeRes = -1;
+      slot->writeErrno = 0;
+      slot->isPending = true;
+
+      if(ioUringEngine)
+         ioUringEngine->submitWrite(fd, slot->buf, slot->len, slot->offset,
+            &slot->writeRes, &slot->writeErrno, &slot->counter);
+      else
+         writeSlaveQueue->addDirectWork(new ChunkWriteWork(fd, slot->buf, slot->len, slot->offset,
+            &slot->writeRes, &slot->writeErrno, &slot->counter) );
+
+      // forward to mirror (while the disk write is running)...
+
+      FhgfsOpsErr mirrorRes = sendToMirror(slot->buf, recvRes, writeOffset, toBeReceived,
+         sessionLocalFile);
+
+      toBeReceived -= recvRes;
+      writeOffset += recvRes;
+
+      currentSlotIndex = (currentSlotIndex + 1) % numSlots;
+
+      if(unlikely(mirrorRes != FhgfsOpsErr_SUCCESS) )
+      { // mirroring failed
+         mirrorFailed = true;
+         break;
+      }
    }
+   }
+   catch(SocketException& e)
+   { /* the write slaves might still be using our buffer, so we have to wait for them before we
+        can return (and before the buffer is used for the next request) */
+      for(unsigned i=0; i < numSlots; i++)
+      {
+         if(slots[i].isPending)
+            slots[i].counter.waitForCount(1);
+      }
 
-   return getCount();
+      delete[] slots;
+
+      throw;
+   }
+
+   // wait for remaining writes (in the order in which they were submitted)...
+
+   for(unsigned i=0; i < numSlots; i++)
+   {
+      WritePipelineSlot* slot = &slots[(currentSlotIndex + i) % numSlots];
+
+      if(!slot->isPending)
+         continue;
+
+      slot->counter.waitForCount(1);
+      slot->isPending = false;
+
+      if(writeFailed)
+         continue; // data after a failed write doesn't count
+
+      if(likely(slot->writeRes == slot->len) )
+         numWritten += slot->len;
+      else
+      {
+         writeFailed = true;
+         failedWriteRes = slot->writeRes;
+         failedWriteErrno = slot->writeErrno;
+      }
+   }
+
+   delete[] slots;
+
+   // all slots are free now, so we can use the whole buffer to receive the rest of the data
+
+   if(unlikely(writeFailed || mirrorFailed) && toBeReceived)
+      incrementalRecvPadding(sock, buf, bufLen, toBeReceived, sessionLocalFile);
+
+   if(unlikely(mirrorFailed) )
+      return -FhgfsOpsErr_COMMUNICATION;
+
+   if(unlikely(writeFailed) )
+   {
+      if(failedWriteRes == -1)
+      { // write error occurred
+         LogContext(logContext).log(Log_WARNING, "Write error occurred. "
+            "FileHandleID: " + sessionLocalFile->getFileHandleID() + "."
+            "Target: " + StringTk::uintToStr(sessionLocalFile->getTargetID() ) + ". "
+            "File: " + sessionLocalFile->getFileID() + ". "
+            "SysErr: " + System::getErrString(failedWriteErrno) );
+
+         return -fhgfsErrFromSysErr(failedWriteErrno);
+      }
+
+      // wrote only a part of the data, not all of it
+      LogContext(logContext).log(Log_WARNING,
+         "Unable to write all of the received data. "
+         "target: " + StringTk::uintToStr(sessionLocalFile->getTargetID() ) + "; "
+         "file: " + sessionLocalFile->getFileID() + "; "
+         "sysErr: " + System::getErrString(failedWriteErrno) );
+
+      return numWritten + failedWriteRes;
+   }
+
+   return numWritten;
 }
 
 /**
- * Write until everything was written (handle short-writes) or an error occured
+ * @return true if the data of this request should be received and written with
+ *    recvAndWritePipelined()
  */
-ssize_t WriteLocalFileMsgEx::doWrite(int fd, char* buf, size_t count, off_t offset, int& outErrno)
+bool WriteLocalFileMsgEx::usePipelinedWrite(SessionLocalFile* sessionLocalFile)
 {
-   size_t sumWriteRes = 0;
+   App* app = Program::getApp();
 
-   do
-   {
-      ssize_t writeRes =
-         MsgHelperIO::pwrite(fd, buf + sumWriteRes, count - sumWriteRes, offset + sumWriteRes);
+   if(app->getConfig()->getTuneFileWritePipelineDepth() <= 1)
+      return false; // pipelining disabled
 
-      if (unlikely(writeRes == -1) )
-      {
-         sumWriteRes = (sumWriteRes > 0) ? sumWriteRes : writeRes;
-         outErrno = errno;
-         break;
-      }
+   if(!app->getWriteSlaveQueue() && !app->getIoUringEngine() )
+      return false; // nobody to do the disk writes for us
 
-      sumWriteRes += writeRes;
+   if(unlikely(isMsgHeaderFeatureFlagSet(WRITELOCALFILEMSG_FLAG_DISABLE_IO) ) )
+      return false; // no disk writes => nothing to overlap
 
-   } while (sumWriteRes != count);
+   if(getCount() <= app->getConfig()->getTuneFileWriteSize() )
+      return false; // small write => no benefit from pipelining
 
-   return sumWriteRes;
+   return true;
 }
 
 /**
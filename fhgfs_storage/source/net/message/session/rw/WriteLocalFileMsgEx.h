@@ -2,6 +2,7 @@
 #define WRITELOCALFILEMSGEX_H_
 
 #include <common/net/message/session/rw/WriteLocalFileMsg.h>
+#include <common/toolkit/SynchronizedCounter.h>
 #include <session/SessionLocalFile.h>
 #include <common/storage/StorageErrors.h>
 
@@ -9,6 +10,22 @@
 #define WRITEMSG_MIRROR_RETRIES_NUM    1
 
 
+/**
+ * A part of the worker buffer for pipelined writes (see recvAndWritePipelined() ).
+ */
+struct WritePipelineSlot
+{
+   char* buf;
+   ssize_t len; // number of received bytes in buf
+   off_t offset; // chunk file offset for buf
+   bool isPending; // true while a disk write for this slot is in progress
+
+   ssize_t writeRes;
+   int writeErrno;
+   SynchronizedCounter counter;
+};
+
+
 class WriteLocalFileMsgEx : public WriteLocalFileMsg
 {
    public:
@@ -29,10 +46,14 @@ class WriteLocalFileMsgEx : public WriteLocalFileMsg
 
       int64_t incrementalRecvAndWriteStateful(Socket* sock, char* buf, ssize_t bufLen,
          SessionLocalFile* sessionLocalFile);
+      int64_t recvAndWriteSequential(Socket* sock, char* buf, ssize_t bufLen,
+         SessionLocalFile* sessionLocalFile);
+      int64_t recvAndWritePipelined(Socket* sock, char* buf, ssize_t bufLen,
+         SessionLocalFile* sessionLocalFile);
       void incrementalRecvPadding(Socket* sock, char* buf, size_t bufLen, int64_t padLen,
          SessionLocalFile* sessionLocalFile);
 
-      ssize_t doWrite(int fd, char* buf, size_t count, off_t offset, int& outErrno);
+      bool usePipelinedWrite(SessionLocalFile* sessionLocalFile);
 
       FhgfsOpsErr openFile(SessionLocalFile* sessionLocalFile);
 
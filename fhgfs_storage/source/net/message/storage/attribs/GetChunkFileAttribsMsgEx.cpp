@@ -14,7 +14,9 @@ bool GetChunkFileAttribsMsgEx::processIncoming(struct sockaddr_in* fromAddr, Soc
       std::string peer = fromAddr ? Socket::ipaddrToStr(&fromAddr->sin_addr) : sock->getPeername();
       LOG_DEBUG(logContext, Log_DEBUG, "Received a GetChunkFileAttribsMsg from: " + peer);
    #endif // BEEGFS_DEBUG
-   
+
+   IGNORE_UNUSED_VARIABLE(logContext);
+
    App* app = Program::getApp();
 
    std::string entryID(getEntryID() );
@@ -26,26 +28,12 @@ bool GetChunkFileAttribsMsgEx::processIncoming(struct sockaddr_in* fromAddr, Soc
 
    // select the right targetID
 
-   uint16_t targetID = getTargetID();
-
-   if(isMsgHeaderFeatureFlagSet(GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR) )
-   { // given targetID refers to a buddy mirror group
-      MirrorBuddyGroupMapper* mirrorBuddies = app->getMirrorBuddyGroupMapper();
-
-      targetID = isMsgHeaderFeatureFlagSet(GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR_SECOND) ?
-         mirrorBuddies->getSecondaryTargetID(targetID) :
-         mirrorBuddies->getPrimaryTargetID(targetID);
-
-      // note: only log message here, error handling will happen below through invalid targetFD
-      if(unlikely(!targetID) )
-         LogContext(logContext).logErr("Invalid mirror buddy group ID: " +
-            StringTk::uintToStr(getTargetID() ) );
-   }
+   uint16_t targetID = getActualTargetID(this, getTargetID() );
 
    { // get targetFD and check consistency state
       bool skipResponse = false;
 
-      targetFD = getTargetFD(fromAddr, sock, respBuf, bufLen, targetID, &skipResponse);
+      targetFD = getTargetFD(this, fromAddr, sock, respBuf, bufLen, targetID, &skipResponse);
       if(unlikely(targetFD == -1) )
       { // failed => either unknown targetID or consistency state not good
          memset(&statbuf, 0, sizeof(statbuf) ); // (just to mute clang warning)
@@ -58,65 +46,9 @@ bool GetChunkFileAttribsMsgEx::processIncoming(struct sockaddr_in* fromAddr, Soc
       }
    }
 
-   { // valid targetID
-      SyncedStoragePaths* syncedPaths = app->getSyncedStoragePaths();
-
-      int statErrCode = 0;
-
-      std::string chunkPath = StorageTk::getFileChunkPath(getPathInfo(), entryID);
-
-      uint64_t newStorageVersion = syncedPaths->lockPath(entryID, targetID); // L O C K path
-
-      int statRes = fstatat(targetFD, chunkPath.c_str(), &statbuf, 0);
-      if(statRes)
-      { // file not exists or error
-         statErrCode = errno;
-      }
-      else
-      {
-         storageVersion = newStorageVersion;
-
-         #ifdef BEEGFS_HSM
-            // Grau HSM system might return a 0 size, if a file release was just issued, we can
-            // prevent this by holding the file open; so if we got 0 size, we open the file and
-            // double-check
-            if ( statbuf.st_size == 0)
-            {
-               int openFlags = O_RDONLY | O_LARGEFILE | O_NOATIME;
-
-               int fd = openat(targetFD, chunkPath.c_str(), openFlags);
-
-               if ( fd >= 0 )
-               {
-
-                  int statRes = fstatat(targetFD, chunkPath.c_str(), &statbuf, 0);
-                  if(statRes)
-                  { // file not exists or error
-                     statErrCode = errno;
-                  }
-
-                  close(fd);
-               }
-               else
-                  statErrCode = errno;
-            }
-         #endif
-      }
-
-      syncedPaths->unlockPath(entryID, targetID); // U N L O C K path
-
-      // note: non-existing file is not an error (storage version is 0, so nothing will be
-      //    updated at the metadata node)
-
-      if((statRes == -1) && (statErrCode != ENOENT))
-      { // error
-         clientErrRes = FhgfsOpsErr_INTERNAL;
-
-         LogContext(logContext).logErr(
-            "Unable to stat file: " + chunkPath + ". " + "SysErr: "
-               + System::getErrString(statErrCode));
-      }
-   }
+   // valid targetID
+   clientErrRes = statChunkFile(targetFD, targetID, getPathInfo(), entryID, &statbuf,
+      &storageVersion);
 
 send_response:
 
@@ -144,14 +76,14 @@ skip_response:
  * response is sent within this method), otherwise the file descriptor to chunks dir (or mirror
  * dir).
  */
-int GetChunkFileAttribsMsgEx::getTargetFD(struct sockaddr_in* fromAddr, Socket* sock,
-   char* respBuf, size_t bufLen, uint16_t actualTargetID, bool* outResponseSent)
+int GetChunkFileAttribsMsgEx::getTargetFD(NetMessage* msg, struct sockaddr_in* fromAddr,
+   Socket* sock, char* respBuf, size_t bufLen, uint16_t actualTargetID, bool* outResponseSent)
 {
-   const char* logContext = "TruncChunkFileMsg (get target FD)";
+   const char* logContext = "GetChunkFileAttribsMsg (get target FD)";
 
    App* app = Program::getApp();
 
-   bool isBuddyMirrorChunk = isMsgHeaderFeatureFlagSet(GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR);
+   bool isBuddyMirrorChunk = msg->isMsgHeaderFeatureFlagSet(GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR);
    TargetConsistencyState consistencyState = TargetConsistencyState_BAD; // silence warning
 
    *outResponseSent = false;
@@ -185,7 +117,7 @@ int GetChunkFileAttribsMsgEx::getTargetFD(struct sockaddr_in* fromAddr, Socket*
 
    if(unlikely(consistencyState != TargetConsistencyState_GOOD) &&
       isBuddyMirrorChunk &&
-      !isMsgHeaderFeatureFlagSet(GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR_SECOND) )
+      !msg->isMsgHeaderFeatureFlagSet(GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR_SECOND) )
    { // this is a msg to a non-good primary
       std::string respMsgLogStr = "Refusing request. Target consistency is not good. "
          "targetID: " + StringTk::uintToStr(actualTargetID);
@@ -201,3 +133,112 @@ int GetChunkFileAttribsMsgEx::getTargetFD(struct sockaddr_in* fromAddr, Socket*
 
    return targetFD;
 }
+
+/**
+ * @return the given targetID or the primary/secondary target of the given buddy group (depending
+ * on msg header feature flags); 0 for invalid buddy group IDs.
+ */
+uint16_t GetChunkFileAttribsMsgEx::getActualTargetID(NetMessage* msg, uint16_t targetID)
+{
+   const char* logContext = "GetChunkFileAttribsMsg (get target ID)";
+
+   if(!msg->isMsgHeaderFeatureFlagSet(GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR) )
+      return targetID;
+
+   // given targetID refers to a buddy mirror group
+
+   MirrorBuddyGroupMapper* mirrorBuddies = Program::getApp()->getMirrorBuddyGroupMapper();
+
+   uint16_t actualTargetID =
+      msg->isMsgHeaderFeatureFlagSet(GETCHUNKFILEATTRSMSG_FLAG_BUDDYMIRROR_SECOND) ?
+      mirrorBuddies->getSecondaryTargetID(targetID) :
+      mirrorBuddies->getPrimaryTargetID(targetID);
+
+   // note: only log message here, error handling will happen through invalid targetFD
+   if(unlikely(!actualTargetID) )
+      LogContext(logContext).logErr("Invalid mirror buddy group ID: " +
+         StringTk::uintToStr(targetID) );
+
+   return actualTargetID;
+}
+
+/**
+ * Stat a chunk file.
+ *
+ * Note: A non-existing chunk file is not an error (storage version is 0 in this case, so nothing
+ * will be updated at the metadata node).
+ *
+ * @param outStatbuf zeroed if the chunk file doesn't exist
+ * @param outStorageVersion 0 if the chunk file doesn't exist
+ */
+FhgfsOpsErr GetChunkFileAttribsMsgEx::statChunkFile(int targetFD, uint16_t targetID,
+   PathInfo* pathInfo, std::string& entryID, struct stat* outStatbuf,
+   uint64_t* outStorageVersion)
+{
+   const char* logContext = "GetChunkFileAttribsMsg (stat chunk file)";
+
+   SyncedStoragePaths* syncedPaths = Program::getApp()->getSyncedStoragePaths();
+
+   FhgfsOpsErr retVal = FhgfsOpsErr_SUCCESS;
+   int statErrCode = 0;
+
+   *outStorageVersion = 0;
+
+   std::string chunkPath = StorageTk::getFileChunkPath(pathInfo, entryID);
+
+   uint64_t newStorageVersion = syncedPaths->lockPath(entryID, targetID); // L O C K path
+
+   int statRes = fstatat(targetFD, chunkPath.c_str(), outStatbuf, 0);
+   if(statRes)
+   { // file not exists or error
+      statErrCode = errno;
+   }
+   else
+   {
+      *outStorageVersion = newStorageVersion;
+
+      #ifdef BEEGFS_HSM
+         // Grau HSM system might return a 0 size, if a file release was just issued, we can
+         // prevent this by holding the file open; so if we got 0 size, we open the file and
+         // double-check
+         if ( outStatbuf->st_size == 0)
+         {
+            int openFlags = O_RDONLY | O_LARGEFILE | O_NOATIME;
+
+            int fd = openat(targetFD, chunkPath.c_str(), openFlags);
+
+            if ( fd >= 0 )
+            {
+
+               int statRes = fstatat(targetFD, chunkPath.c_str(), outStatbuf, 0);
+               if(statRes)
+               { // file not exists or error
+                  statErrCode = errno;
+               }
+
+               close(fd);
+            }
+            else
+               statErrCode = errno;
+         }
+      #endif
+   }
+
+   syncedPaths->unlockPath(entryID, targetID); // U N L O C K path
+
+   if(statRes == -1)
+   {
+      memset(outStatbuf, 0, sizeof(*outStatbuf) );
+
+      if(statErrCode != ENOENT)
+      { // error
+         retVal = FhgfsOpsErr_INTERNAL;
+
+         LogContext(logContext).logErr(
+            "Unable to stat file: " + chunkPath + ". " + "SysErr: "
+               + System::getErrString(statErrCode));
+      }
+   }
+
+   return retVal;
+}
@@ -13,12 +13,12 @@ class GetChunkFileAttribsMsgEx : public GetChunkFileAttribsMsg
       virtual bool processIncoming(struct sockaddr_in* fromAddr, Socket* sock,
          char* respBuf, size_t bufLen, HighResolutionStats* stats);
    
-   protected:
-   
-   private:
-      int getTargetFD(struct sockaddr_in* fromAddr, Socket* sock, char* respBuf, size_t bufLen,
-         uint16_t actualTargetID, bool* outResponseSent);
-   
+      static uint16_t getActualTargetID(NetMessage* msg, uint16_t targetID);
+      static int getTargetFD(NetMessage* msg, struct sockaddr_in* fromAddr, Socket* sock,
+         char* respBuf, size_t bufLen, uint16_t actualTargetID, bool* outResponseSent);
+      static FhgfsOpsErr statChunkFile(int targetFD, uint16_t targetID, PathInfo* pathInfo,
+         std::string& entryID, struct stat* outStatbuf, uint64_t* outStorageVersion);
+
 };
 
 #endif /*GETCHUNKFILEATTRIBSMSGEX_H_*/
@@ -0,0 +1,88 @@
+#include <common/net/message/storage/attribs/GetChunkFileAttribsMultiRespMsg.h>
+#include <program/Program.h>
+#include "GetChunkFileAttribsMsgEx.h"
+#include "GetChunkFileAttribsMultiMsgEx.h"
+
+
+bool GetChunkFileAttribsMultiMsgEx::processIncoming(struct sockaddr_in* fromAddr, Socket* sock,
+   char* respBuf, size_t bufLen, HighResolutionStats* stats)
+{
+   const char* logContext = "GetChunkFileAttribsMultiMsg incoming";
+
+   #ifdef BEEGFS_DEBUG
+      std::string peer = fromAddr ? Socket::ipaddrToStr(&fromAddr->sin_addr) : sock->getPeername();
+      LOG_DEBUG(logContext, Log_DEBUG, "Received a GetChunkFileAttribsMultiMsg from: " + peer);
+   #endif // BEEGFS_DEBUG
+
+   App* app = Program::getApp();
+
+   StringList entryIDs;
+   PathInfoList pathInfos;
+
+   IntList results;
+   DynamicFileAttribsVec dynAttribsVec;
+
+   if(!parseEntryIDs(&entryIDs) )
+   {
+      LogContext(logContext).logErr("Unable to parse entryIDs");
+      return false;
+   }
+
+   parsePathInfos(&pathInfos);
+
+   // select the right targetID
+
+   uint16_t targetID = GetChunkFileAttribsMsgEx::getActualTargetID(this, getTargetID() );
+
+   // get targetFD and check consistency state
+
+   bool skipResponse = false;
+
+   int targetFD = GetChunkFileAttribsMsgEx::getTargetFD(this, fromAddr, sock, respBuf, bufLen,
+      targetID, &skipResponse);
+
+   if(unlikely(targetFD == -1) )
+   { // failed => either unknown targetID or consistency state not good
+      if(skipResponse)
+         goto skip_response; // GenericResponseMsg sent
+
+      results.resize(entryIDs.size(), FhgfsOpsErr_UNKNOWNTARGET);
+      dynAttribsVec.resize(entryIDs.size() );
+
+      goto send_response;
+   }
+
+   { // valid targetID => stat all chunks
+      StringListIter entryIDIter = entryIDs.begin();
+      PathInfoListIter pathInfoIter = pathInfos.begin();
+
+      for( ; entryIDIter != entryIDs.end(); entryIDIter++, pathInfoIter++)
+      {
+         struct stat statbuf;
+         uint64_t storageVersion;
+
+         FhgfsOpsErr statRes = GetChunkFileAttribsMsgEx::statChunkFile(targetFD, targetID,
+            &(*pathInfoIter), *entryIDIter, &statbuf, &storageVersion);
+
+         results.push_back(statRes);
+         dynAttribsVec.push_back(DynamicFileAttribs(storageVersion, statbuf.st_size,
+            statbuf.st_blocks, statbuf.st_mtime, statbuf.st_atime) );
+      }
+   }
+
+send_response:
+
+   { // send response
+      GetChunkFileAttribsMultiRespMsg respMsg(&results, &dynAttribsVec);
+      respMsg.serialize(respBuf, bufLen);
+      sock->sendto(respBuf, respMsg.getMsgLength(), 0,
+         (struct sockaddr*)fromAddr, sizeof(struct sockaddr_in) );
+   }
+
+skip_response:
+
+   app->getNodeOpStats()->updateNodeOp(
+      sock->getPeerIP(), StorageOpCounter_GETLOCALFILESIZE, getMsgHeaderUserID() );
+
+   return true;
+}
@@ -0,0 +1,17 @@
+#ifndef GETCHUNKFILEATTRIBSMULTIMSGEX_H_
+#define GETCHUNKFILEATTRIBSMULTIMSGEX_H_
+
+#include <common/net/message/storage/attribs/GetChunkFileAttribsMultiMsg.h>
+
+class GetChunkFileAttribsMultiMsgEx : public GetChunkFileAttribsMultiMsg
+{
+   public:
+      GetChunkFileAttribsMultiMsgEx() : GetChunkFileAttribsMultiMsg()
+      {
+      }
+
+      virtual bool processIncoming(struct sockaddr_in* fromAddr, Socket* sock,
+         char* respBuf, size_t bufLen, HighResolutionStats* stats);
+};
+
+#endif /*GETCHUNKFILEATTRIBSMULTIMSGEX_H_*/
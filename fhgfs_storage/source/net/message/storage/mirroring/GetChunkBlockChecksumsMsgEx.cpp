@@ -0,0 +1,100 @@
+#include <common/net/message/storage/mirroring/GetChunkBlockChecksumsRespMsg.h>
+#include <common/net/message/storage/mirroring/ResyncLocalFileMsg.h>
+#include <toolkit/StorageTkEx.h>
+
+#include <program/Program.h>
+
+#include "GetChunkBlockChecksumsMsgEx.h"
+
+bool GetChunkBlockChecksumsMsgEx::processIncoming(struct sockaddr_in* fromAddr, Socket* sock,
+   char* respBuf, size_t bufLen, HighResolutionStats* stats)
+{
+   #ifdef BEEGFS_DEBUG
+      const char* logContext = "GetChunkBlockChecksumsMsg incoming";
+      std::string peer = fromAddr ? Socket::ipaddrToStr(&fromAddr->sin_addr) : sock->getPeername();
+      LOG_DEBUG(logContext, Log_DEBUG,
+         std::string("Received a GetChunkBlockChecksumsMsg from: ") + peer);
+   #endif // BEEGFS_DEBUG
+
+   App* app = Program::getApp();
+   FhgfsOpsErr retVal = FhgfsOpsErr_SUCCESS;
+
+   uint16_t targetID = getTargetID();
+   std::string relativeChunkPathStr = getRelativePathStr();
+   unsigned blockSize = getBlockSize();
+   unsigned numBlocks = BEEGFS_MIN(getNumBlocks(), GETCHUNKBLOCKCHECKSUMSMSG_MAX_BLOCKS);
+
+   int64_t fileSize = 0;
+   UIntVector weakChecksums;
+   UInt64Vector strongChecksums;
+
+   char* blockBuf = NULL;
+   int fd;
+
+   int targetFD = app->getTargetFD(targetID, true);
+
+   if(unlikely(targetFD == -1) )
+   {
+      LogContext(__func__).logErr("Unknown targetID: " + StringTk::uintToStr(targetID) );
+      retVal = FhgfsOpsErr_UNKNOWNTARGET;
+      goto send_response;
+   }
+
+   if(unlikely(!blockSize || (blockSize > GETCHUNKBLOCKCHECKSUMSMSG_MAX_BLOCKSIZE) ) )
+   {
+      LogContext(__func__).logErr("Invalid block size: " + StringTk::uintToStr(blockSize) );
+      retVal = FhgfsOpsErr_INVAL;
+      goto send_response;
+   }
+
+   fd = openat(targetFD, relativeChunkPathStr.c_str(), O_RDONLY | O_NOATIME);
+   if(fd == -1)
+   {
+      int errCode = errno;
+
+      if(errCode == ENOENT)
+      { // chunk doesn't exist (yet) => no error, primary will send the complete chunk
+         retVal = FhgfsOpsErr_PATHNOTEXISTS;
+         goto send_response;
+      }
+
+      LogContext(__func__).logErr("Unable to open chunk file: " + relativeChunkPathStr + ". "
+         "targetID: " + StringTk::uintToStr(targetID) + "; "
+         "SysErr: " + System::getErrString(errCode) );
+
+      retVal = FhgfsOpsErr_INTERNAL;
+      goto send_response;
+   }
+
+   blockBuf = (char*)malloc(blockSize);
+   if(unlikely(!blockBuf) )
+   {
+      LogContext(__func__).logErr("Could not allocate memory for block buf");
+      retVal = FhgfsOpsErr_OUTOFMEM;
+   }
+   else
+   if(!StorageTkEx::getBlockChecksums(fd, getOffset(), blockSize, numBlocks, blockBuf, false,
+      &weakChecksums, &strongChecksums, &fileSize) )
+   {
+      LogContext(__func__).logErr("Unable to read chunk file: " + relativeChunkPathStr + ". "
+         "targetID: " + StringTk::uintToStr(targetID) + "; "
+         "SysErr: " + System::getErrString() );
+
+      weakChecksums.clear();
+      strongChecksums.clear();
+
+      retVal = FhgfsOpsErr_INTERNAL;
+   }
+
+   SAFE_FREE(blockBuf);
+   close(fd);
+
+
+send_response:
+
+   GetChunkBlockChecksumsRespMsg respMsg(retVal, fileSize, &weakChecksums, &strongChecksums);
+   respMsg.serialize(respBuf, bufLen);
+   sock->send(respBuf, respMsg.getMsgLength(), 0);
+
+   return true;
+}
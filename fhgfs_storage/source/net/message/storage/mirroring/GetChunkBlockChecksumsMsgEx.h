@@ -0,0 +1,18 @@
+#ifndef GETCHUNKBLOCKCHECKSUMSMSGEX_H_
+#define GETCHUNKBLOCKCHECKSUMSMSGEX_H_
+
+#include <common/net/message/storage/mirroring/GetChunkBlockChecksumsMsg.h>
+#include <common/storage/StorageErrors.h>
+
+class GetChunkBlockChecksumsMsgEx : public GetChunkBlockChecksumsMsg
+{
+   public:
+      GetChunkBlockChecksumsMsgEx() : GetChunkBlockChecksumsMsg()
+      {
+      }
+
+      virtual bool processIncoming(struct sockaddr_in* fromAddr, Socket* sock,
+         char* respBuf, size_t bufLen, HighResolutionStats* stats);
+};
+
+#endif /*GETCHUNKBLOCKCHECKSUMSMSGEX_H_*/
@@ -1,4 +1,5 @@
 #include <common/net/message/storage/mirroring/ResyncLocalFileRespMsg.h>
+#include <common/toolkit/BufferTk.h>
 #include <common/toolkit/MessagingTk.h>
 #include <net/msghelpers/MsgHelperIO.h>
 #include <toolkit/StorageTkEx.h>
@@ -37,8 +38,10 @@ bool ResyncLocalFileMsgEx::processIncoming(struct sockaddr_in* fromAddr, Socket*
    int targetFD = app->getTargetFD(targetID, true);
    int fd;
 
-   // always truncate when we write the very first block of a file
-   if(!offset && !isMsgHeaderFeatureFlagSet (RESYNCLOCALFILEMSG_FLAG_NODATA) )
+   /* always truncate when we write the very first block of a file (except for delta resync, where
+      only changed ranges of the existing chunk are sent) */
+   if(!offset && !isMsgHeaderFeatureFlagSet (RESYNCLOCALFILEMSG_FLAG_NODATA) &&
+      !isMsgHeaderFeatureFlagSet(RESYNCLOCALFILEMSG_FLAG_DELTA) )
       openFlags |= O_TRUNC;
 
    FhgfsOpsErr openRes = chunkStore->openChunkFile(targetFD, NULL, relativeChunkPathStr, true,
@@ -53,12 +56,31 @@ bool ResyncLocalFileMsgEx::processIncoming(struct sockaddr_in* fromAddr, Socket*
 
       storageTargets->setState(targetID, TargetConsistencyState_BAD);
 
+      // streamed data must be received anyways to keep the connection usable
+      if(isMsgHeaderFeatureFlagSet(RESYNCLOCALFILEMSG_FLAG_STREAM) &&
+         !recvAndWriteStream(sock, respBuf, bufLen, -1, count, offset, false, writeErrno) )
+         return false;
+
       goto send_response;
    }
 
    if(isMsgHeaderFeatureFlagSet (RESYNCLOCALFILEMSG_FLAG_NODATA)) // do not sync actual data
       goto set_attribs;
 
+   if(isMsgHeaderFeatureFlagSet(RESYNCLOCALFILEMSG_FLAG_STREAM) )
+   {
+      writeErrno = 0;
+
+      if(!recvAndWriteStream(sock, respBuf, bufLen, fd, count, offset,
+         isMsgHeaderFeatureFlagSet(RESYNCLOCALFILEMSG_CHECK_SPARSE), writeErrno) )
+      { // communication error => no response possible
+         close(fd);
+         return false;
+      }
+
+      writeRes = !writeErrno;
+   }
+   else
    if(isMsgHeaderFeatureFlagSet (RESYNCLOCALFILEMSG_CHECK_SPARSE))
       writeRes = doWriteSparse(fd, dataBuf, count, offset, writeErrno);
    else
@@ -178,14 +200,12 @@ bool ResyncLocalFileMsgEx::doWriteSparse(int fd, const char* buf, size_t count,
    int& outErrno)
 {
    size_t sumWriteRes = 0;
-   const char zeroBuf[ RESYNCER_SPARSE_BLOCK_SIZE ] = { 0 };
 
    do
    {
       size_t cmpLen = BEEGFS_MIN(count - sumWriteRes, RESYNCER_SPARSE_BLOCK_SIZE);
-      int cmpRes = memcmp(buf + sumWriteRes, zeroBuf, cmpLen);
 
-      if(!cmpRes)
+      if(BufferTk::isZero(buf + sumWriteRes, cmpLen) )
       { // sparse area
          sumWriteRes += cmpLen;
 
@@ -220,6 +240,96 @@ bool ResyncLocalFileMsgEx::doWriteSparse(int fd, const char* buf, size_t count,
    return true;
 }
 
+/**
+ * Receive the raw data that follows a msg with RESYNCLOCALFILEMSG_FLAG_STREAM and write it.
+ *
+ * If a write error occurs, the remaining data is still received (but not written), so that the
+ * connection stays usable for the response.
+ *
+ * Note: Unlike doWriteSparse(), this doesn't truncate the file at the end of the data if the data
+ * ends with zeros, because the sender sets RESYNCLOCALFILEMSG_FLAG_TRUNC with the last window of
+ * a file.
+ *
+ * @param fd may be -1 to just receive and discard the data.
+ * @param skipZeroBlocks true to not write blocks of RESYNCER_SPARSE_BLOCK_SIZE that contain only
+ *    zeros.
+ * @param outErrno errno of the first failed write (left unchanged if no write failed).
+ * @return false on communication error.
+ */
+bool ResyncLocalFileMsgEx::recvAndWriteStream(Socket* sock, char* buf, size_t bufLen, int fd,
+   size_t count, off_t offset, bool skipZeroBlocks, int& outErrno)
+{
+   const int timeoutMS = CONN_MEDIUM_TIMEOUT;
+
+   size_t toBeReceived = count;
+   bool writeFailed = (fd == -1);
+
+   try
+   {
+      while(toBeReceived)
+      {
+         size_t recvLen = BEEGFS_MIN(bufLen, toBeReceived);
+
+         ssize_t recvRes = sock->recvExactT(buf, recvLen, 0, timeoutMS);
+
+         size_t bufPos = 0;
+
+         while(!writeFailed && (bufPos < (size_t)recvRes) )
+         {
+            size_t writeLen = 0;
+
+            if(skipZeroBlocks)
+            { // find the next non-zero area in the buffer
+               size_t cmpLen = BEEGFS_MIN(recvRes - bufPos, RESYNCER_SPARSE_BLOCK_SIZE);
+
+               if(BufferTk::isZero(buf + bufPos, cmpLen) )
+               {
+                  bufPos += cmpLen;
+                  continue;
+               }
+
+               // coalesce consecutive non-zero blocks to a single write
+
+               writeLen = cmpLen;
+
+               while(bufPos + writeLen < (size_t)recvRes)
+               {
+                  cmpLen = BEEGFS_MIN(recvRes - bufPos - writeLen, RESYNCER_SPARSE_BLOCK_SIZE);
+
+                  if(BufferTk::isZero(buf + bufPos + writeLen, cmpLen) )
+                     break;
+
+                  writeLen += cmpLen;
+               }
+            }
+            else
+               writeLen = recvRes;
+
+            ssize_t writeRes = MsgHelperIO::pwriteAll(fd, buf + bufPos, writeLen,
+               offset + (count - toBeReceived) + bufPos, outErrno);
+
+            if(unlikely(writeRes != (ssize_t)writeLen) )
+            { // (outErrno was set by pwriteAll)
+               writeFailed = true;
+               break;
+            }
+
+            bufPos += writeLen;
+         }
+
+         toBeReceived -= recvRes;
+      }
+   }
+   catch(SocketException& e)
+   {
+      LogContext(__func__).logErr(std::string("Communication error while receiving resync data: ") +
+         e.what() );
+      return false;
+   }
+
+   return true;
+}
+
 bool ResyncLocalFileMsgEx::doTrunc(int fd, off_t length, int& outErrno)
 {
    int truncRes = ftruncate(fd, length);
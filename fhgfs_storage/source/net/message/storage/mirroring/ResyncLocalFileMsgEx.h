@@ -20,6 +20,8 @@ class ResyncLocalFileMsgEx : public ResyncLocalFileMsg
       bool doWrite(int fd, const char* buf, size_t count, off_t offset, int& outErrno);
       bool doWriteSparse(int fd, const char* buf, size_t count, off_t offset, int& outErrno);
       bool doTrunc(int fd, off_t offset, int& outErrno);
+      bool recvAndWriteStream(Socket* sock, char* buf, size_t bufLen, int fd, size_t count,
+         off_t offset, bool skipZeroBlocks, int& outErrno);
       FhgfsOpsErr fhgfsErrFromSysErr(int64_t errCode);
 
 };
@@ -32,6 +32,12 @@
  * which was based on not directly calling the syscalls from the current thread.
  * However, it's still nice to have this central place for IO routines and since it doesn't impose
  * any overhead, we just keep it for now.
+ *
+ * If tuneUseIoUring is enabled, the write-back syncs and read-ahead advices are routed through the
+ * IoUringEngine, because the caller doesn't need to wait for them. The synchronous calls (pread,
+ * pwrite, truncate) stay plain syscalls: a round trip through the engine would only add a thread
+ * hop per call without batching anything. Callers that can keep several requests in flight (like
+ * the pipelined WriteLocalFileMsgEx) use the engine directly.
  */
 class MsgHelperIO
 {
@@ -79,6 +85,34 @@ class MsgHelperIO
          return ::pwrite(fd, buf, count, offset);
       }
 
+      /**
+       * Write until everything was written (handle short-writes) or an error occured.
+       *
+       * @param outErrno errno of the failed write (only set if not all data could be written)
+       * @return number of written bytes or -1 if an error occurred before anything was written
+       */
+      static ssize_t pwriteAll(int fd, const void* buf, size_t count, off_t offset, int& outErrno)
+      {
+         size_t sumWriteRes = 0;
+
+         do
+         {
+            ssize_t writeRes = ::pwrite(fd, (const char*)buf + sumWriteRes, count - sumWriteRes,
+               offset + sumWriteRes);
+
+            if (unlikely(writeRes == -1) )
+            {
+               outErrno = errno;
+               return (sumWriteRes > 0) ? (ssize_t)sumWriteRes : -1;
+            }
+
+            sumWriteRes += writeRes;
+
+         } while (sumWriteRes != count);
+
+         return sumWriteRes;
+      }
+
 
       static off_t lseek(int fd, off_t offset, int whence)
       {
@@ -95,9 +129,18 @@ class MsgHelperIO
        *
        * Note: This is a linux specific call, which appeared in linux-2.6.17 and glibc 2.6
        * (so it is not available in SLES10/RHEL5).
+       *
+       * Note: With io_uring, this returns immediately without waiting for the submission result.
        */
       static int syncFileRange(int fd, off64_t offset, off64_t nbytes)
       {
+         IoUringEngine* ioUringEngine = Program::getApp()->getIoUringEngine();
+         if(ioUringEngine)
+         {
+            ioUringEngine->submitSyncFileRange(fd, offset, nbytes);
+            return 0;
+         }
+
          #ifdef CONFIG_DISTRO_HAS_SYNC_FILE_RANGE
             return sync_file_range(fd, offset, nbytes, SYNC_FILE_RANGE_WRITE);
          #else
@@ -108,16 +151,24 @@ class MsgHelperIO
       /**
        * Advise the kernel to read-ahead the given amount of data. Especially for block based
        * file systems this is an asynchronous call one the IO has reached the bio layer.
+       *
+       * With io_uring, the advice calls are also submitted asynchronously, so that the caller
+       * doesn't have to wait until the kernel has queued the read-ahead IO.
        */
       static int readAhead(int fd, off_t offset, off_t remainingLen)
       {
+         IoUringEngine* ioUringEngine = Program::getApp()->getIoUringEngine();
          int raRes = 0;
 
          while (remainingLen > 0)
          {
             size_t readSize = BEEGFS_MIN(MAX_KERNEL_READAHEAD, remainingLen);
 
-            raRes = posix_fadvise(fd, offset, readSize, POSIX_FADV_WILLNEED);
+            if(ioUringEngine)
+               ioUringEngine->submitFAdviseWillNeed(fd, offset, readSize);
+            else
+               raRes = posix_fadvise(fd, offset, readSize, POSIX_FADV_WILLNEED);
+
             if (unlikely(raRes) )
                break;
 
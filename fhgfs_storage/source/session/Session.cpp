@@ -42,6 +42,7 @@ bool Session::deserializeForTarget(const char* buf, size_t bufLen, unsigned* out
       return false;
 
    this->sessionID.assign(sessionIDChar, sessionIDLen);
+   this->sessionIDHash = hashSessionID(this->sessionID);
    bufPos += sessionIDBufLen;
 
    // localFiles
@@ -1,6 +1,7 @@
 #ifndef SESSION_H_
 #define SESSION_H_
 
+#include <common/toolkit/BufferTk.h>
 #include <common/Common.h>
 #include "SessionLocalFileStore.h"
 
@@ -8,12 +9,13 @@
 class Session
 {
    public:
-      Session(std::string sessionID) : sessionID(sessionID) {}
+      Session(std::string sessionID) : sessionID(sessionID),
+         sessionIDHash(hashSessionID(sessionID) ) {}
 
       /*
        * For deserialization only
        */
-      Session() {};
+      Session() : sessionIDHash(0) {};
 
       void mergeSessionLocalFiles(Session* session);
 
@@ -23,17 +25,34 @@ class Session
       unsigned serialLenForTarget(uint16_t targetID);
 
    private:
-      std::string sessionID;
+      std::string sessionID; // immutable after construction/deserialization
+      uint32_t sessionIDHash; // (see hashSessionID() )
 
       SessionLocalFileStore localFiles;
 
    public:
       // getters & setters
-      std::string getSessionID()
+      /**
+       * Note: no locking needed, the ID does not change while the session is in the store.
+       */
+      const std::string& getSessionID() const
       {
          return sessionID;
       }
 
+      uint32_t getSessionIDHash() const
+      {
+         return sessionIDHash;
+      }
+
+      /**
+       * Hash that the SessionStore uses to find sessions.
+       */
+      static uint32_t hashSessionID(const std::string& sessionID)
+      {
+         return BufferTk::hash32(sessionID.c_str(), sessionID.length() );
+      }
+
       SessionLocalFileStore* getLocalFiles()
       {
          return &localFiles;
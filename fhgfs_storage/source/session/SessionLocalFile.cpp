@@ -79,6 +79,7 @@ bool SessionLocalFile::deserialize(const char* buf, size_t bufLen, unsigned* out
          return false;
 
       this->fileHandleID = fileHandleID;
+      this->fileHandleIDHash = hashFileHandleID(this->fileHandleID);
       bufPos += fileHandleIDBufLen;
    }
 
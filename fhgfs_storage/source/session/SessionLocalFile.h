@@ -4,6 +4,7 @@
 #include <common/storage/Path.h>
 #include <common/threading/Mutex.h>
 #include <common/threading/SafeRWLock.h>
+#include <common/toolkit/BufferTk.h>
 #include <common/Common.h>
 
 
@@ -20,8 +21,8 @@ class SessionLocalFile
        * dirty
        */
       SessionLocalFile(std::string fileHandleID, uint16_t targetID, std::string fileID,
-         int openFlags, bool serverCrashed) : fileHandleID(fileHandleID), targetID(targetID),
-         fileID(fileID)
+         int openFlags, bool serverCrashed) : fileHandleID(fileHandleID),
+         fileHandleIDHash(hashFileHandleID(fileHandleID) ), targetID(targetID), fileID(fileID)
       {
          this->fileDescriptor = -1; // initialize as invalid file descriptor
          this->openFlags = openFlags;
@@ -46,6 +47,7 @@ class SessionLocalFile
        */
       SessionLocalFile()
       {
+         this->fileHandleIDHash = 0;
          this->fileDescriptor = -1; // initialize as invalid file descriptor
          this->offset = -1; // initialize as invalid offset (will be set on file open)
          this->mirrorNode = NULL;
@@ -64,7 +66,8 @@ class SessionLocalFile
    private:
       bool removeOnRelease; // remove on last ref drop (for internal use by the sessionstore only!)
 
-      std::string fileHandleID;
+      std::string fileHandleID; // immutable after construction/deserialization
+      uint32_t fileHandleIDHash; // (see hashFileHandleID() )
       uint16_t targetID;
       std::string fileID;
       int openFlags; // system flags for open()
@@ -102,11 +105,27 @@ class SessionLocalFile
          this->removeOnRelease = removeOnRelease;
       }
 
-      std::string getFileHandleID() const
+      /**
+       * Note: no locking needed, the ID does not change while the session is in the store.
+       */
+      const std::string& getFileHandleID() const
       {
          return fileHandleID;
       }
 
+      uint32_t getFileHandleIDHash() const
+      {
+         return fileHandleIDHash;
+      }
+
+      /**
+       * Hash that the SessionLocalFileStore uses to find sessions.
+       */
+      static uint32_t hashFileHandleID(const std::string& fileHandleID)
+      {
+         return BufferTk::hash32(fileHandleID.c_str(), fileHandleID.length() );
+      }
+
       uint16_t getTargetID() const
       {
          return targetID;
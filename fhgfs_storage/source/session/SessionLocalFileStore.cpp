@@ -16,26 +16,27 @@
  */
 SessionLocalFile* SessionLocalFileStore::addAndReferenceSession(SessionLocalFile* session)
 {
-   std::string fileHandleID(session->getFileHandleID() );
-   uint16_t targetID = session->getTargetID();
-   bool isMirrorSession = session->getIsMirrorSession();
+   uint32_t sessionKeyHash = keyHash(session);
+   Shard& shard = getShard(sessionKeyHash);
 
-   std::string key(generateMapKey(fileHandleID, targetID, isMirrorSession) );
+   SafeMutexLock mutexLock(&shard.mutex); // L O C K
 
-   SafeMutexLock mutexLock(&mutex); // L O C K
-   
-   // try to insert the new session
-   std::pair<SessionLocalFileMapIter, bool> insertRes =
-      sessions.insert(SessionLocalFileMapVal(key, new SessionLocalFileReferencer(session) ) );
+   SessionLocalFileMapIter iter = findSessionUnlocked(shard, sessionKeyHash,
+      session->getFileHandleID(), session->getTargetID(), session->getIsMirrorSession() );
 
    // was a session with this ID in the store already?
-   if(!insertRes.second)
+   if(iter != shard.sessions.end() )
    { // session exists => discard new session
       delete(session);
    }
+   else
+   { // add the new session
+      iter = shard.sessions.insert(SessionLocalFileMapVal(sessionKeyHash,
+         new SessionLocalFileReferencer(session) ) );
+   }
 
-   // reference session (note: insertRes.first is an iterator to the inserted/existing session)
-   SessionLocalFileReferencer* sessionRefer = insertRes.first->second;
+   // reference session (note: iter points to the inserted/existing session)
+   SessionLocalFileReferencer* sessionRefer = iter->second;
    SessionLocalFile* retVal = sessionRefer->reference();
 
    mutexLock.unlock(); // U N L O C K
@@ -51,17 +52,20 @@ SessionLocalFile* SessionLocalFileStore::addAndReferenceSession(SessionLocalFile
  * @param isMirrorSession true if this is a session for a mirrored chunk file.
  * @return NULL if no such session exists.
  */
-SessionLocalFile* SessionLocalFileStore::referenceSession(const std::string fileHandleID,
+SessionLocalFile* SessionLocalFileStore::referenceSession(const std::string& fileHandleID,
    uint16_t targetID, bool isMirrorSession)
 {
    SessionLocalFile* session;
    
-   std::string key(generateMapKey(fileHandleID, targetID, isMirrorSession) );
+   uint32_t sessionKeyHash = keyHash(SessionLocalFile::hashFileHandleID(fileHandleID), targetID,
+      isMirrorSession);
+   Shard& shard = getShard(sessionKeyHash);
 
-   SafeMutexLock mutexLock(&mutex);
+   SafeMutexLock mutexLock(&shard.mutex);
 
-   SessionLocalFileMapIter iter = sessions.find(key);
-   if(iter == sessions.end() )
+   SessionLocalFileMapIter iter = findSessionUnlocked(shard, sessionKeyHash, fileHandleID,
+      targetID, isMirrorSession);
+   if(iter == shard.sessions.end() )
    { // not found
       session = NULL;
    }
@@ -78,24 +82,27 @@ SessionLocalFile* SessionLocalFileStore::referenceSession(const std::string file
 
 void SessionLocalFileStore::releaseSession(SessionLocalFile* session)
 {
-   std::string fileHandleID(session->getFileHandleID() );
-   uint16_t targetID = session->getTargetID();
-   bool isMirrorSession = session->getIsMirrorSession();
-
-   std::string key(generateMapKey(fileHandleID, targetID, isMirrorSession) );
-
-   SafeMutexLock mutexLock(&mutex); // L O C K
+   uint32_t sessionKeyHash = keyHash(session);
+   Shard& shard = getShard(sessionKeyHash);
 
    App* app = Program::getApp();
    NodeStoreServers* storageNodes = app->getStorageNodes();
 
-   
-   SessionLocalFileMapIter iter = sessions.find(key);
-   if(iter != sessions.end() )
-   { // session exists => decrease refCount
+   SafeMutexLock mutexLock(&shard.mutex); // L O C K
+
+   // the caller holds a reference, so the session is still in the store => match by address
+   std::pair<SessionLocalFileMapIter, SessionLocalFileMapIter> range =
+      shard.sessions.equal_range(sessionKeyHash);
+
+   for(SessionLocalFileMapIter iter = range.first; iter != range.second; iter++)
+   {
       SessionLocalFileReferencer* sessionRefer = iter->second;
       SessionLocalFile* fileNonRef = sessionRefer->getReferencedObject();
 
+      if(fileNonRef != session)
+         continue;
+
+      // session exists => decrease refCount
       sessionRefer->release();
 
       // check delayed removal
@@ -115,9 +122,11 @@ void SessionLocalFileStore::releaseSession(SessionLocalFile* session)
             storageNodes->releaseNode(&mirrorNode);
          }
 
-         sessions.erase(iter);
+         shard.sessions.erase(iter);
          delete(sessionRefer);
       }
+
+      break;
    }
    
    mutexLock.unlock(); // U N L O C K
@@ -130,20 +139,23 @@ void SessionLocalFileStore::releaseSession(SessionLocalFile* session)
  * @return true if session was successfully removed or didn't exist, false if session was still in
  * use (and thus was marked for delayed removal internally).
  */
-bool SessionLocalFileStore::removeSession(const std::string fileHandleID,
+bool SessionLocalFileStore::removeSession(const std::string& fileHandleID,
    uint16_t targetID, bool isMirrorSession, SessionLocalFile** outSessionLocalFile)
 {
    bool sessionWasReferenced = false; // non-existing session doesn't indicate an error
    
    *outSessionLocalFile = NULL;
 
-   std::string key(generateMapKey(fileHandleID, targetID, isMirrorSession) );
+   uint32_t sessionKeyHash = keyHash(SessionLocalFile::hashFileHandleID(fileHandleID), targetID,
+      isMirrorSession);
+   Shard& shard = getShard(sessionKeyHash);
 
 
-   SafeMutexLock mutexLock(&mutex); // L O C K
+   SafeMutexLock mutexLock(&shard.mutex); // L O C K
    
-   SessionLocalFileMapIter iter = sessions.find(key);
-   if(iter != sessions.end() )
+   SessionLocalFileMapIter iter = findSessionUnlocked(shard, sessionKeyHash, fileHandleID,
+      targetID, isMirrorSession);
+   if(iter != shard.sessions.end() )
    { // session found
 
       SessionLocalFileReferencer* sessionRefer = iter->second;
@@ -158,7 +170,7 @@ bool SessionLocalFileStore::removeSession(const std::string fileHandleID,
       { // no references => remove from store
          *outSessionLocalFile = fileNonRef;
          
-         sessions.erase(iter);
+         shard.sessions.erase(iter);
 
          sessionRefer->setOwnReferencedObject(false);
          delete(sessionRefer);
@@ -174,29 +186,37 @@ bool SessionLocalFileStore::removeSession(const std::string fileHandleID,
  * Removes all sessions and additionally adds those that had a reference count to the StringList.
  * 
  * @param outRemovedSessions caller is responsible for clean up of contained objects
+ * @param outReferencedSessions keys (see generateMapKey() ) of sessions that were still referenced
  */
 void SessionLocalFileStore::removeAllSessions(SessionLocalFileList* outRemovedSessions,
    StringList* outReferencedSessions)
 {
-   SafeMutexLock mutexLock(&mutex);
-   
-   for(SessionLocalFileMapIter iter = sessions.begin(); iter != sessions.end(); iter++)
+   for(unsigned i = 0; i < SESSIONLOCALFILESTORE_NUM_SHARDS; i++)
    {
-      SessionLocalFileReferencer* sessionRefer = iter->second;
-      SessionLocalFile* session = sessionRefer->getReferencedObject();
-      
-      outRemovedSessions->push_back(session);
+      Shard& shard = shards[i];
 
-      if(unlikely(sessionRefer->getRefCount() ) )
-         outReferencedSessions->push_back(iter->first);
+      SafeMutexLock mutexLock(&shard.mutex);
 
-      sessionRefer->setOwnReferencedObject(false);
-      delete(sessionRefer);
-   }
-   
-   sessions.clear();
+      for(SessionLocalFileMapIter iter = shard.sessions.begin(); iter != shard.sessions.end();
+          iter++)
+      {
+         SessionLocalFileReferencer* sessionRefer = iter->second;
+         SessionLocalFile* session = sessionRefer->getReferencedObject();
 
-   mutexLock.unlock();
+         outRemovedSessions->push_back(session);
+
+         if(unlikely(sessionRefer->getRefCount() ) )
+            outReferencedSessions->push_back(generateMapKey(session->getFileHandleID(),
+               session->getTargetID(), session->getIsMirrorSession() ) );
+
+         sessionRefer->setOwnReferencedObject(false);
+         delete(sessionRefer);
+      }
+
+      shard.sessions.clear();
+
+      mutexLock.unlock();
+   }
 }
 
 /**
@@ -204,35 +224,38 @@ void SessionLocalFileStore::removeAllSessions(SessionLocalFileList* outRemovedSe
  */
 void SessionLocalFileStore::removeAllMirrorSessions(uint16_t targetID)
 {
-   SafeMutexLock mutexLock(&mutex);
-
-   StringList fileHandleIDs;
-
-   SessionLocalFileMapIter iter = sessions.begin();
-   while(iter != sessions.end())
+   for(unsigned i = 0; i < SESSIONLOCALFILESTORE_NUM_SHARDS; i++)
    {
-      SessionLocalFileReferencer* sessionRefer = iter->second;
-      SessionLocalFile* session = sessionRefer->getReferencedObject();
+      Shard& shard = shards[i];
+
+      SafeMutexLock mutexLock(&shard.mutex);
 
-      if ( (session->getTargetID() == targetID) && (session->getIsMirrorSession()) )
+      SessionLocalFileMapIter iter = shard.sessions.begin();
+      while(iter != shard.sessions.end())
       {
-         if(sessionRefer->getRefCount())
-         { // unable to remove now => mark for delayed removal on last reference drop
-            session->setRemoveOnRelease(true);
-         }
-         else
-         { // no references => remove from store
-            sessions.erase(iter++);
-            sessionRefer->setOwnReferencedObject(true);
-            delete(sessionRefer);
-            continue;
+         SessionLocalFileReferencer* sessionRefer = iter->second;
+         SessionLocalFile* session = sessionRefer->getReferencedObject();
+
+         if ( (session->getTargetID() == targetID) && (session->getIsMirrorSession()) )
+         {
+            if(sessionRefer->getRefCount())
+            { // unable to remove now => mark for delayed removal on last reference drop
+               session->setRemoveOnRelease(true);
+            }
+            else
+            { // no references => remove from store
+               shard.sessions.erase(iter++);
+               sessionRefer->setOwnReferencedObject(true);
+               delete(sessionRefer);
+               continue;
+            }
          }
+
+         ++iter;
       }
 
-      ++iter;
+      mutexLock.unlock();
    }
-
-   mutexLock.unlock();
 }
 
 /*
@@ -242,30 +265,40 @@ void SessionLocalFileStore::deleteAllSessions()
 {
    App* app = Program::getApp();
 
-   for(SessionLocalFileMapIter iter = sessions.begin(); iter != sessions.end(); iter++)
+   for(unsigned i = 0; i < SESSIONLOCALFILESTORE_NUM_SHARDS; i++)
    {
-      SessionLocalFileReferencer* sessionRefer = iter->second;
-      SessionLocalFile* session = sessionRefer->getReferencedObject();
+      SessionLocalFileMap& sessions = shards[i].sessions;
 
-      Node* mirrorNode = session->getMirrorNode();
-      if(mirrorNode)
+      for(SessionLocalFileMapIter iter = sessions.begin(); iter != sessions.end(); iter++)
       {
-         app->getStorageNodes()->releaseNode(&mirrorNode);
+         SessionLocalFileReferencer* sessionRefer = iter->second;
+         SessionLocalFile* session = sessionRefer->getReferencedObject();
+
+         Node* mirrorNode = session->getMirrorNode();
+         if(mirrorNode)
+         {
+            app->getStorageNodes()->releaseNode(&mirrorNode);
+         }
+
+         delete(sessionRefer);
       }
 
-      delete(sessionRefer);
+      sessions.clear();
    }
-
-   sessions.clear();
 }
 
 size_t SessionLocalFileStore::getSize()
 {
-   SafeMutexLock mutexLock(&mutex);
-   
-   size_t sessionsSize = sessions.size();
+   size_t sessionsSize = 0;
 
-   mutexLock.unlock();
+   for(unsigned i = 0; i < SESSIONLOCALFILESTORE_NUM_SHARDS; i++)
+   {
+      SafeMutexLock mutexLock(&shards[i].mutex);
+
+      sessionsSize += shards[i].sessions.size();
+
+      mutexLock.unlock();
+   }
 
    return sessionsSize;
 }
@@ -306,78 +339,77 @@ uint16_t SessionLocalFileStore::getTargetIDFromKey(std::string key)
    return 0;
 }
 
-SessionLocalFileMap* SessionLocalFileStore::getSessionMap()
-{
-   return &this->sessions;
-}
-
 /* Merges the SessionLocalFiles of the given SessionLocalFileStore into this SessionLocalFileStore.
  * Only not existing SessionLocalFiles will be added to the existing SessionLocalFileStore
  *
+ * Note: no locking of the given store is used, it must not be accessed by other threads.
+ *
  * @param sessionLocalFileStore the sessionLocalFileStore which will be merged with this
- * sessionLocalFileStore
+ * sessionLocalFileStore; it will be empty afterwards.
  */
 void SessionLocalFileStore::mergeSessionLocalFiles(SessionLocalFileStore* sessionLocalFileStore)
 {
    App* app = Program::getApp();
    Logger* log = app->getLogger();
 
-   SessionLocalFileMapIter sessionIter = sessionLocalFileStore->getSessionMap()->begin();
-
-   while(sessionIter != sessionLocalFileStore->getSessionMap()->end() )
+   for(unsigned i = 0; i < SESSIONLOCALFILESTORE_NUM_SHARDS; i++)
    {
-      bool sessionFound = false;
-      SessionLocalFileMapIter destSessionIter = this->sessions.find(sessionIter->first);
-      SessionLocalFile* currentSession = sessionIter->second->getReferencedObject();
+      SessionLocalFileMap& srcSessions = sessionLocalFileStore->shards[i].sessions;
 
-      if (destSessionIter != this->sessions.end())
+      for(SessionLocalFileMapIter sessionIter = srcSessions.begin();
+          sessionIter != srcSessions.end();
+          sessionIter++)
       {
-            sessionFound = true;
-            log->log(Log_WARNING, "SessionLocalFileStore merge", "found SessionLocalFile with same "
-               "ID: " + sessionIter->first + " , merge not possible, may be a bug?");
-      }
+         SessionLocalFile* currentSession = sessionIter->second->getReferencedObject();
 
-      if (!sessionFound)
-      {
-         bool success = this->sessions.insert(SessionLocalFileMapVal(sessionIter->first,
-            sessionIter->second)).second;
+         uint32_t sessionKeyHash = sessionIter->first;
+         Shard& shard = getShard(sessionKeyHash);
 
-         if (!success)
-         {
-            log->log(Log_WARNING, "SessionLocalFileStore merge", "could not merge: " +
-               std::string(sessionIter->first));
+         SafeMutexLock mutexLock(&shard.mutex); // L O C K
 
-            Node* mirrorNode = currentSession->getMirrorNode();
-            if(mirrorNode)
-            {
-               app->getStorageNodes()->releaseNode(&mirrorNode);
-            }
+         SessionLocalFileMapIter destSessionIter = findSessionUnlocked(shard, sessionKeyHash,
+            currentSession->getFileHandleID(), currentSession->getTargetID(),
+            currentSession->getIsMirrorSession() );
+
+         if (destSessionIter == shard.sessions.end() )
+            shard.sessions.insert(SessionLocalFileMapVal(sessionKeyHash, sessionIter->second) );
+
+         mutexLock.unlock(); // U N L O C K
+
+         if (destSessionIter != shard.sessions.end() )
+         {
+            log->log(Log_WARNING, "SessionLocalFileStore merge", "found SessionLocalFile with same "
+               "ID: " + generateMapKey(currentSession->getFileHandleID(),
+               currentSession->getTargetID(), currentSession->getIsMirrorSession() ) +
+               " , merge not possible, may be a bug?");
 
             delete(sessionIter->second);
          }
       }
-      else
-      {
-         delete(sessionIter->second);
-      }
 
-      sessionIter++;
+      srcSessions.clear();
    }
 }
 
+/**
+ * Note: no locking is used, the store must not be accessed by other threads.
+ */
 unsigned SessionLocalFileStore::serializeForTarget(char* buf, uint16_t targetID)
 {
-   unsigned elementCount = this->sessions.size();
+   unsigned elementCount = 0;
    unsigned serializedElementCount = 0;
 
    // count the elements to serialize, serialize the values only for the given targetID
-   SessionLocalFileMapIter iter = this->sessions.begin();
-
-   for ( unsigned i = 0; i < elementCount; i++, iter++ )
+   for(unsigned i = 0; i < SESSIONLOCALFILESTORE_NUM_SHARDS; i++)
    {
-      if (getTargetIDFromKey(iter->first) == targetID)
+      SessionLocalFileMap& sessions = shards[i].sessions;
+
+      elementCount += sessions.size();
+
+      for(SessionLocalFileMapIter iter = sessions.begin(); iter != sessions.end(); iter++)
       {
-         serializedElementCount++;
+         if(iter->second->getReferencedObject()->getTargetID() == targetID)
+            serializedElementCount++;
       }
    }
 
@@ -387,15 +419,22 @@ unsigned SessionLocalFileStore::serializeForTarget(char* buf, uint16_t targetID)
    bufPos += Serialization::serializeUInt(&buf[bufPos], serializedElementCount);
 
    // serialize each element
-   iter = this->sessions.begin();
-
-   for ( unsigned i = 0; i < elementCount; i++, iter++ )
+   for(unsigned i = 0; i < SESSIONLOCALFILESTORE_NUM_SHARDS; i++)
    {
-      if (getTargetIDFromKey(iter->first) == targetID)
+      SessionLocalFileMap& sessions = shards[i].sessions;
+
+      for(SessionLocalFileMapIter iter = sessions.begin(); iter != sessions.end(); iter++)
       {
-         bufPos += Serialization::serializeStr(&buf[bufPos], iter->first.length(),
-            iter->first.c_str());
-         bufPos += iter->second->getReferencedObject()->serialize(&buf[bufPos]);
+         SessionLocalFile* session = iter->second->getReferencedObject();
+
+         if(session->getTargetID() != targetID)
+            continue;
+
+         std::string key(generateMapKey(session->getFileHandleID(), session->getTargetID(),
+            session->getIsMirrorSession() ) );
+
+         bufPos += Serialization::serializeStr(&buf[bufPos], key.length(), key.c_str() );
+         bufPos += session->serialize(&buf[bufPos]);
       }
    }
 
@@ -459,8 +498,12 @@ bool SessionLocalFileStore::deserializeForTarget(const char* buf, size_t bufLen,
          }
 
          if(getTargetIDFromKey(key) == targetID)
-            this->sessions.insert(SessionLocalFileMapVal(key,
-               new SessionLocalFileReferencer(sessionLocalFile)));
+         {
+            uint32_t sessionKeyHash = keyHash(sessionLocalFile);
+
+            getShard(sessionKeyHash).sessions.insert(SessionLocalFileMapVal(sessionKeyHash,
+               new SessionLocalFileReferencer(sessionLocalFile) ) );
+         }
          else
          { // should never happen
             Node* mirrorNode = sessionLocalFile->getMirrorNode();
@@ -485,23 +528,30 @@ bool SessionLocalFileStore::deserializeForTarget(const char* buf, size_t bufLen,
    return true;
 }
 
+/**
+ * Note: no locking is used, the store must not be accessed by other threads.
+ */
 unsigned SessionLocalFileStore::serialLenForTarget(uint16_t targetID)
 {
-   unsigned sessionLocalFileStoreSize = this->sessions.size();
-
    size_t bufPos = 0;
 
    // elem count info field
    bufPos += Serialization::serialLenUInt();
 
-   SessionLocalFileMapIter iter = this->sessions.begin();
-
-   for (unsigned i = 0; i < sessionLocalFileStoreSize; i++, iter++)
+   for(unsigned i = 0; i < SESSIONLOCALFILESTORE_NUM_SHARDS; i++)
    {
-      if (getTargetIDFromKey(iter->first) == targetID)
+      SessionLocalFileMap& sessions = shards[i].sessions;
+
+      for(SessionLocalFileMapIter iter = sessions.begin(); iter != sessions.end(); iter++)
       {
-         bufPos += Serialization::serialLenStr(iter->first.length());
-         bufPos += iter->second->getReferencedObject()->serialLen();
+         SessionLocalFile* session = iter->second->getReferencedObject();
+
+         if(session->getTargetID() != targetID)
+            continue;
+
+         bufPos += Serialization::serialLenStr(generateMapKey(session->getFileHandleID(),
+            session->getTargetID(), session->getIsMirrorSession() ).length() );
+         bufPos += session->serialLen();
       }
    }
 
@@ -8,10 +8,15 @@
 
 
 
+/* number of independently locked parts of each store; file sessions are distributed by the hash of
+   their handle ID, so that concurrent I/O of one client to different files doesn't serialize on a
+   single mutex */
+#define SESSIONLOCALFILESTORE_NUM_SHARDS     8
+
 typedef std::list<SessionLocalFile*> SessionLocalFileList;
 typedef SessionLocalFileList::iterator SessionLocalFileListIter;
 typedef ObjectReferencer<SessionLocalFile*> SessionLocalFileReferencer;
-typedef std::map<std::string, SessionLocalFileReferencer*> SessionLocalFileMap;
+typedef std::multimap<uint32_t, SessionLocalFileReferencer*> SessionLocalFileMap; // key: keyHash()
 typedef SessionLocalFileMap::iterator SessionLocalFileMapIter;
 typedef SessionLocalFileMap::value_type SessionLocalFileMapVal;
 
@@ -22,10 +27,10 @@ class SessionLocalFileStore
       SessionLocalFileStore() {}
 
       SessionLocalFile* addAndReferenceSession(SessionLocalFile* session);
-      SessionLocalFile* referenceSession(std::string fileHandleID, uint16_t targetID,
+      SessionLocalFile* referenceSession(const std::string& fileHandleID, uint16_t targetID,
          bool isMirrorSession);
       void releaseSession(SessionLocalFile* session);
-      bool removeSession(std::string fileHandleID, uint16_t targetID, bool isMirrorSession,
+      bool removeSession(const std::string& fileHandleID, uint16_t targetID, bool isMirrorSession,
          SessionLocalFile** outSessionLocalFile);
       void removeAllSessions(SessionLocalFileList* outRemovedSessions,
          StringList* outReferencedSessions);
@@ -41,18 +46,66 @@ class SessionLocalFileStore
          uint16_t targetID);
       unsigned serialLenForTarget(uint16_t targetID);
 
-   protected:
-      SessionLocalFileMap* getSessionMap();
-
    private:
-      SessionLocalFileMap sessions; // key: <fileHandleID><...>@<targetID>, value: <session_ref>
+      struct Shard
+      {
+         SessionLocalFileMap sessions;
+         Mutex mutex;
+      };
 
-      Mutex mutex;
+      Shard shards[SESSIONLOCALFILESTORE_NUM_SHARDS];
 
       std::string generateMapKey(const std::string fileHandleID, uint16_t targetID,
          bool isMirrorSession);
 
       uint16_t getTargetIDFromKey(std::string key);
+
+
+      // inliners
+
+      /**
+       * Combines the (precomputed) hash of the file handle ID with the other parts of a session's
+       * identity.
+       */
+      static uint32_t keyHash(uint32_t fileHandleIDHash, uint16_t targetID, bool isMirrorSession)
+      {
+         return fileHandleIDHash ^ ( ( (uint32_t)targetID << 1 | isMirrorSession) * 2654435761U);
+      }
+
+      static uint32_t keyHash(SessionLocalFile* session)
+      {
+         return keyHash(session->getFileHandleIDHash(), session->getTargetID(),
+            session->getIsMirrorSession() );
+      }
+
+      Shard& getShard(uint32_t keyHash)
+      {
+         return shards[keyHash % SESSIONLOCALFILESTORE_NUM_SHARDS];
+      }
+
+      /**
+       * Note: caller must hold the shard lock.
+       *
+       * @return end() of the shard map if the session is not in the store
+       */
+      static SessionLocalFileMapIter findSessionUnlocked(Shard& shard, uint32_t keyHash,
+         const std::string& fileHandleID, uint16_t targetID, bool isMirrorSession)
+      {
+         std::pair<SessionLocalFileMapIter, SessionLocalFileMapIter> range =
+            shard.sessions.equal_range(keyHash);
+
+         for(SessionLocalFileMapIter iter = range.first; iter != range.second; iter++)
+         {
+            SessionLocalFile* session = iter->second->getReferencedObject();
+
+            if( (session->getTargetID() == targetID) &&
+                (session->getIsMirrorSession() == isMirrorSession) &&
+                (session->getFileHandleID() == fileHandleID) )
+               return iter;
+         }
+
+         return shard.sessions.end();
+      }
 };
 
 #endif /*SESSIONLOCALFILESTORE_H_*/
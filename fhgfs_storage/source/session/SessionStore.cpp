@@ -8,20 +8,22 @@
  */
 void SessionStore::addSession(Session* session)
 {
-   std::string sessionID = session->getSessionID();
+   const std::string& sessionID = session->getSessionID();
+   Shard& shard = getShard(session->getSessionIDHash() );
 
-   SafeMutexLock mutexLock(&mutex);
+   SafeMutexLock mutexLock(&shard.mutex);
    
    // is session in the store already?
    
-   SessionMapIter iter = sessions.find(sessionID);
-   if(iter != sessions.end() )
+   SessionMapIter iter = findSessionUnlocked(shard, session->getSessionIDHash(), sessionID);
+   if(iter != shard.sessions.end() )
    {
       delete(session);
    }
    else
    { // session not in the store yet
-      sessions.insert(SessionMapVal(sessionID, new SessionReferencer(session) ) );
+      shard.sessions.insert(SessionMapVal(session->getSessionIDHash(),
+         new SessionReferencer(session) ) );
    }
 
    mutexLock.unlock();
@@ -33,14 +35,17 @@ void SessionStore::addSession(Session* session)
  * 
  * @return NULL if no such session exists
  */
-Session* SessionStore::referenceSession(std::string sessionID, bool addIfNotExists)
+Session* SessionStore::referenceSession(const std::string& sessionID, bool addIfNotExists)
 {
    Session* session;
    
-   SafeMutexLock mutexLock(&mutex);
+   const uint32_t sessionIDHash = Session::hashSessionID(sessionID);
+   Shard& shard = getShard(sessionIDHash);
+
+   SafeMutexLock mutexLock(&shard.mutex);
    
-   SessionMapIter iter = sessions.find(sessionID);
-   if(iter == sessions.end() )
+   SessionMapIter iter = findSessionUnlocked(shard, sessionIDHash, sessionID);
+   if(iter == shard.sessions.end() )
    { // not found
       if(!addIfNotExists)
          session = NULL;
@@ -51,7 +56,7 @@ Session* SessionStore::referenceSession(std::string sessionID, bool addIfNotExis
          
          Session* newSession = new Session(sessionID);
          SessionReferencer* sessionRefer = new SessionReferencer(newSession);
-         sessions.insert(SessionMapVal(sessionID, sessionRefer) );
+         shard.sessions.insert(SessionMapVal(sessionIDHash, sessionRefer) );
          session = sessionRefer->reference();
       }
    }
@@ -68,28 +73,39 @@ Session* SessionStore::referenceSession(std::string sessionID, bool addIfNotExis
 
 void SessionStore::releaseSession(Session* session)
 {
-   std::string sessionID = session->getSessionID();
+   Shard& shard = getShard(session->getSessionIDHash() );
 
-   SafeMutexLock mutexLock(&mutex);
+   SafeMutexLock mutexLock(&shard.mutex);
    
-   SessionMapIter iter = sessions.find(sessionID);
-   if(iter != sessions.end() )
-   { // session exists => decrease refCount
+   // (the session is referenced, so it is still in the store and we can just match the pointer)
+   std::pair<SessionMapIter, SessionMapIter> range =
+      shard.sessions.equal_range(session->getSessionIDHash() );
+
+   for(SessionMapIter iter = range.first; iter != range.second; iter++)
+   {
       SessionReferencer* sessionRefer = iter->second;
-      sessionRefer->release();
+
+      if(sessionRefer->getReferencedObject() == session)
+      { // session exists => decrease refCount
+         sessionRefer->release();
+         break;
+      }
    }
    
    mutexLock.unlock();
 }
 
-bool SessionStore::removeSession(std::string sessionID)
+bool SessionStore::removeSession(const std::string& sessionID)
 {
    bool delErr = true;
    
-   SafeMutexLock mutexLock(&mutex);
+   const uint32_t sessionIDHash = Session::hashSessionID(sessionID);
+   Shard& shard = getShard(sessionIDHash);
+
+   SafeMutexLock mutexLock(&shard.mutex);
    
-   SessionMapIter iter = sessions.find(sessionID);
-   if(iter != sessions.end() )
+   SessionMapIter iter = findSessionUnlocked(shard, sessionIDHash, sessionID);
+   if(iter != shard.sessions.end() )
    {
       SessionReferencer* sessionRefer = iter->second;
       
@@ -97,7 +113,7 @@ bool SessionStore::removeSession(std::string sessionID)
          delErr = true;
       else
       { // no references => delete
-         sessions.erase(sessionID);
+         shard.sessions.erase(iter);
          delete(sessionRefer);
          delErr = false;
       }
@@ -109,14 +125,16 @@ bool SessionStore::removeSession(std::string sessionID)
 }
 
 /**
+ * Note: caller must hold the shard lock.
+ *
  * @return NULL if session is referenced, otherwise the sesion must be cleaned up by the caller
  */
-Session* SessionStore::removeSessionUnlocked(std::string sessionID)
+Session* SessionStore::removeSessionUnlocked(Shard& shard, const std::string& sessionID)
 {
    Session* retVal = NULL;
 
-   SessionMapIter iter = sessions.find(sessionID);
-   if(iter != sessions.end() )
+   SessionMapIter iter = findSessionUnlocked(shard, Session::hashSessionID(sessionID), sessionID);
+   if(iter != shard.sessions.end() )
    {
       SessionReferencer* sessionRefer = iter->second;
       
@@ -126,7 +144,7 @@ Session* SessionStore::removeSessionUnlocked(std::string sessionID)
          
          sessionRefer->setOwnReferencedObject(false);
          delete(sessionRefer);
-         sessions.erase(sessionID);
+         shard.sessions.erase(iter);
       }
    }
    
@@ -134,8 +152,8 @@ Session* SessionStore::removeSessionUnlocked(std::string sessionID)
 }
 
 /**
- * @param masterList must be ordered; contained nodes will be removed and may no longer be
- * accessed after calling this method.
+ * @param masterList contained nodes will be removed and may no longer be accessed after calling
+ * this method.
  * @param outRemovedSessions contained sessions must be cleaned up by the caller
  * @param outUnremovableSesssions contains sessions that would have been removed but are currently
  * referenced
@@ -143,72 +161,44 @@ Session* SessionStore::removeSessionUnlocked(std::string sessionID)
 void SessionStore::syncSessions(NodeList* masterList, SessionList* outRemovedSessions,
    StringList* outUnremovableSesssions)
 {
-   SafeMutexLock mutexLock(&mutex);
-   
-   SessionMapIter sessionIter = sessions.begin();
-   NodeListIter masterIter = masterList->begin();
-   
-   while( (sessionIter != sessions.end() ) && (masterIter != masterList->end() ) )
+   StringSet masterIDs;
+
+   // note: we add sessions only on demand, so we just delete the node objects (i.e. the clients)
+   while(!masterList->empty() )
    {
-      std::string currentSession(sessionIter->first);
-      std::string currentMaster( (*masterIter)->getID() );
-
-      if(currentMaster < currentSession)
-      { // session doesn't exist locally
-         // note: we add sessions only on demand, so we just delete the node object (i.e. the
-         //       client) here
-         delete(*masterIter);
-         
-         masterList->pop_front();
-         masterIter = masterList->begin();
+      masterIDs.insert(masterList->front()->getID() );
+
+      delete(masterList->front() );
+      masterList->pop_front();
+   }
+
+   for(unsigned shardIndex = 0; shardIndex < SESSIONSTORE_NUM_SHARDS; shardIndex++)
+   {
+      Shard& shard = shards[shardIndex];
+
+      SafeMutexLock mutexLock(&shard.mutex); // L O C K
+
+      StringList removedIDs;
+
+      for(SessionMapIter iter = shard.sessions.begin(); iter != shard.sessions.end(); iter++)
+      {
+         const std::string& sessionID = iter->second->getReferencedObject()->getSessionID();
+
+         if(!masterIDs.count(sessionID) )
+            removedIDs.push_back(sessionID); // (removal invalidates iterator)
       }
-      else
-      if(currentSession < currentMaster)
-      { // session is removed
-         sessionIter++; // (removal invalidates iterator)
 
-         Session* session = removeSessionUnlocked(currentSession);
+      for(StringListIter iter = removedIDs.begin(); iter != removedIDs.end(); iter++)
+      {
+         Session* session = removeSessionUnlocked(shard, *iter);
          if(session)
             outRemovedSessions->push_back(session);
          else
-            outUnremovableSesssions->push_back(currentSession); // session was referenced
+            outUnremovableSesssions->push_back(*iter); // session was referenced
       }
-      else
-      { // session unchanged
-         delete(*masterIter);
 
-         masterList->pop_front();
-         masterIter = masterList->begin();
-
-         sessionIter++;
-      }
-   }
-   
-   // remaining masterList entries are new
-   while(masterIter != masterList->end() )
-   {
-      // note: we add sessions only on demand, so we just delete the node object here
-      delete(*masterIter);
-      
-      masterList->pop_front();
-      masterIter = masterList->begin();
+      mutexLock.unlock(); // U N L O C K
    }
-
-   // remaining sessions are removed
-   while(sessionIter != sessions.end() )
-   {
-      std::string currentSession(sessionIter->first);
-      sessionIter++; // (removal invalidates iterator)
-      
-      Session* session = removeSessionUnlocked(currentSession);
-      if(session)
-         outRemovedSessions->push_back(session);
-      else
-         outUnremovableSesssions->push_back(currentSession); // session was referenced
-   }
-   
-   
-   mutexLock.unlock();
 }
 
 /**
@@ -216,32 +206,65 @@ void SessionStore::syncSessions(NodeList* masterList, SessionList* outRemovedSes
  */
 size_t SessionStore::getAllSessionIDs(StringList* outSessionIDs)
 {
-   SafeMutexLock mutexLock(&mutex);
+   size_t retVal = 0;
 
-   size_t retVal = sessions.size();
+   for(unsigned shardIndex = 0; shardIndex < SESSIONSTORE_NUM_SHARDS; shardIndex++)
+   {
+      Shard& shard = shards[shardIndex];
 
-   for(SessionMapIter iter = sessions.begin(); iter != sessions.end(); iter++)
-      outSessionIDs->push_back(iter->first);
+      SafeMutexLock mutexLock(&shard.mutex);
 
-   mutexLock.unlock();
+      retVal += shard.sessions.size();
+
+      for(SessionMapIter iter = shard.sessions.begin(); iter != shard.sessions.end(); iter++)
+         outSessionIDs->push_back(iter->second->getReferencedObject()->getSessionID() );
+
+      mutexLock.unlock();
+   }
 
    return retVal;
 }
 
 size_t SessionStore::getSize()
 {
-   SafeMutexLock mutexLock(&mutex);
-   
-   size_t sessionsSize = sessions.size();
+   size_t sessionsSize = 0;
 
-   mutexLock.unlock();
+   for(unsigned shardIndex = 0; shardIndex < SESSIONSTORE_NUM_SHARDS; shardIndex++)
+   {
+      SafeMutexLock mutexLock(&shards[shardIndex].mutex);
+
+      sessionsSize += shards[shardIndex].sessions.size();
+
+      mutexLock.unlock();
+   }
 
    return sessionsSize;
 }
 
+/**
+ * Locks all shards (always in the same order) for operations on the whole store.
+ */
+void SessionStore::lockAllShards()
+{
+   for(unsigned shardIndex = 0; shardIndex < SESSIONSTORE_NUM_SHARDS; shardIndex++)
+      shards[shardIndex].mutex.lock();
+}
+
+void SessionStore::unlockAllShards()
+{
+   for(unsigned shardIndex = 0; shardIndex < SESSIONSTORE_NUM_SHARDS; shardIndex++)
+      shards[shardIndex].mutex.unlock();
+}
+
+/**
+ * Note: caller must hold all shard locks.
+ */
 unsigned SessionStore::serializeForTarget(char* buf, uint16_t targetID)
 {
-   unsigned elementCount = this->sessions.size();
+   unsigned elementCount = 0;
+
+   for(unsigned shardIndex = 0; shardIndex < SESSIONSTORE_NUM_SHARDS; shardIndex++)
+      elementCount += this->shards[shardIndex].sessions.size();
 
    size_t bufPos = 0;
 
@@ -249,13 +272,18 @@ unsigned SessionStore::serializeForTarget(char* buf, uint16_t targetID)
    bufPos += Serialization::serializeUInt(&buf[bufPos], elementCount);
 
    // serialize each element
-   SessionMapIter iter = this->sessions.begin();
-
-   for ( unsigned i = 0; i < elementCount; i++, iter++ )
+   for(unsigned shardIndex = 0; shardIndex < SESSIONSTORE_NUM_SHARDS; shardIndex++)
    {
-      bufPos += Serialization::serializeStr(&buf[bufPos], iter->first.length(),
-         iter->first.c_str()); // serialize the key
-      bufPos += iter->second->getReferencedObject()->serializeForTarget(&buf[bufPos], targetID);
+      SessionMap& sessions = this->shards[shardIndex].sessions;
+
+      for(SessionMapIter iter = sessions.begin(); iter != sessions.end(); iter++)
+      {
+         Session* session = iter->second->getReferencedObject();
+
+         bufPos += Serialization::serializeStr(&buf[bufPos], session->getSessionID().length(),
+            session->getSessionID().c_str() ); // serialize the key
+         bufPos += session->serializeForTarget(&buf[bufPos], targetID);
+      }
    }
 
    LOG_DEBUG("SessionStore serialize", Log_DEBUG, "count of serialized Sessions: " +
@@ -264,6 +292,9 @@ unsigned SessionStore::serializeForTarget(char* buf, uint16_t targetID)
    return bufPos;
 }
 
+/**
+ * Note: caller must hold all shard locks.
+ */
 bool SessionStore::deserializeForTarget(const char* buf, size_t bufLen, unsigned* outLen,
    uint16_t targetID)
 {
@@ -309,10 +340,15 @@ bool SessionStore::deserializeForTarget(const char* buf, size_t bufLen, unsigned
             return false;
          }
 
-         SessionMapIter searchResult = this->sessions.find(std::string(key));
-         if (searchResult == this->sessions.end() )
+         // (the key is the ID that the session deserialized itself, so we use the session's hash)
+         Shard& shard = getShard(session->getSessionIDHash() );
+
+         SessionMapIter searchResult = findSessionUnlocked(shard, session->getSessionIDHash(),
+            session->getSessionID() );
+         if (searchResult == shard.sessions.end() )
          {
-            this->sessions.insert(SessionMapVal(std::string(key), new SessionReferencer(session)));
+            shard.sessions.insert(SessionMapVal(session->getSessionIDHash(),
+               new SessionReferencer(session) ) );
          }
          else
          { // exist so local files will merged
@@ -332,20 +368,26 @@ bool SessionStore::deserializeForTarget(const char* buf, size_t bufLen, unsigned
    return true;
 }
 
+/**
+ * Note: caller must hold all shard locks.
+ */
 unsigned SessionStore::serialLenForTarget(uint16_t targetID)
 {
-   unsigned sessionStoreSize = this->sessions.size();
-
    size_t bufPos = 0;
 
    bufPos += Serialization::serialLenUInt(); // elem count
 
-   SessionMapIter iter = this->sessions.begin();
-
-   for ( unsigned i = 0; i < sessionStoreSize; i++, iter++)
+   for(unsigned shardIndex = 0; shardIndex < SESSIONSTORE_NUM_SHARDS; shardIndex++)
    {
-      bufPos += Serialization::serialLenStr(iter->first.length());                     // key
-      bufPos += iter->second->getReferencedObject()->serialLenForTarget(targetID);
+      SessionMap& sessions = this->shards[shardIndex].sessions;
+
+      for(SessionMapIter iter = sessions.begin(); iter != sessions.end(); iter++)
+      {
+         Session* session = iter->second->getReferencedObject();
+
+         bufPos += Serialization::serialLenStr(session->getSessionID().length() );     // key
+         bufPos += session->serialLenForTarget(targetID);
+      }
    }
 
    return bufPos;
@@ -366,7 +408,7 @@ bool SessionStore::loadFromFile(std::string filePath, uint16_t targetID)
    if(!filePath.length() )
       return false;
 
-   SafeMutexLock mutexLock(&mutex);
+   lockAllShards(); // L O C K
 
    int fd = open(filePath.c_str(), O_RDONLY, 0);
    if(fd == -1)
@@ -408,7 +450,7 @@ err_stat:
    close(fd);
 
 err_unlock:
-   mutexLock.unlock();
+   unlockAllShards(); // U N L O C K
 
    return retVal;
 }
@@ -430,7 +472,7 @@ bool SessionStore::saveToFile(std::string filePath, uint16_t targetID)
    if(!filePath.length() )
       return false;
 
-   SafeMutexLock mutexLock(&mutex); // L O C K
+   lockAllShards(); // L O C K
 
    // create/trunc file
    int openFlags = O_CREAT|O_TRUNC|O_WRONLY;
@@ -467,7 +509,7 @@ err_closefile:
    close(fd);
 
 err_unlock:
-   mutexLock.unlock(); // U N L O C K
+   unlockAllShards(); // U N L O C K
 
    return retVal;
 }
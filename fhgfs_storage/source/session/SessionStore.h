@@ -7,8 +7,12 @@
 #include <common/Common.h>
 #include "Session.h"
 
+/* number of independently locked parts of the store; sessions are distributed by the hash of their
+   ID, so that concurrent I/O of different clients doesn't serialize on a single mutex */
+#define SESSIONSTORE_NUM_SHARDS     32
+
 typedef ObjectReferencer<Session*> SessionReferencer;
-typedef std::map<std::string, SessionReferencer*> SessionMap;
+typedef std::multimap<uint32_t, SessionReferencer*> SessionMap; // key: hash of sessionID
 typedef SessionMap::iterator SessionMapIter;
 typedef SessionMap::value_type SessionMapVal;
 
@@ -21,7 +25,7 @@ class SessionStore
    public:
       SessionStore() {}
 
-      Session* referenceSession(std::string sessionID, bool addIfNotExists=true);
+      Session* referenceSession(const std::string& sessionID, bool addIfNotExists=true);
       void releaseSession(Session* session);
       void syncSessions(NodeList* masterList, SessionList* outRemovedSessions,
          StringList* outUnremovableSesssions);
@@ -38,13 +42,47 @@ class SessionStore
       bool saveToFile(std::string filePath, uint16_t targetID);
 
    private:
-      SessionMap sessions;
+      struct Shard
+      {
+         SessionMap sessions;
+         Mutex mutex;
+      };
 
-      Mutex mutex;
+      Shard shards[SESSIONSTORE_NUM_SHARDS];
 
       void addSession(Session* session); // actually not needed (maybe later one day...)
-      bool removeSession(std::string sessionID); // actually not needed (maybe later one day...)
-      Session* removeSessionUnlocked(std::string sessionID);
+      bool removeSession(const std::string& sessionID); // actually not needed (maybe later...)
+      Session* removeSessionUnlocked(Shard& shard, const std::string& sessionID);
+      void lockAllShards();
+      void unlockAllShards();
+
+
+      // inliners
+
+      Shard& getShard(uint32_t sessionIDHash)
+      {
+         return shards[sessionIDHash % SESSIONSTORE_NUM_SHARDS];
+      }
+
+      /**
+       * Note: caller must hold the shard lock.
+       *
+       * @return end() of the shard map if the session is not in the store
+       */
+      static SessionMapIter findSessionUnlocked(Shard& shard, uint32_t sessionIDHash,
+         const std::string& sessionID)
+      {
+         std::pair<SessionMapIter, SessionMapIter> range =
+            shard.sessions.equal_range(sessionIDHash);
+
+         for(SessionMapIter iter = range.first; iter != range.second; iter++)
+         {
+            if(iter->second->getReferencedObject()->getSessionID() == sessionID)
+               return iter;
+         }
+
+         return shard.sessions.end();
+      }
 };
 
 #endif /*SESSIONSTORE_H_*/
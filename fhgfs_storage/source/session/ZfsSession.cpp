@@ -17,6 +17,7 @@ ZfsSession::ZfsSession()
    this->libZfsHandle = NULL;
    this->zfs_open = NULL;
    this->zfs_prop_get_userquota_int = NULL;
+   this->zfs_userspace = NULL;
    this->libzfs_error_description = NULL;
    this->libzfs_error_action = NULL;
 
@@ -87,6 +88,17 @@ bool ZfsSession::initZfsSession(void* dlOpenHandleLib)
    }
 
 
+   // optional, QuotaTk falls back to zfs_prop_get_userquota_int for each ID if not available
+   this->zfs_userspace = (int (*)(void*, int, int (*)(void*, const char*, uid_t, uint64_t),
+      void*))dlsym(this->dlOpenHandleLibZfs, "zfs_userspace");
+   if ( (dlErrorString = dlerror() ) != NULL)
+   {
+      LOG_DEBUG("ZfsSession", Log_DEBUG, "libzfs doesn't provide zfs_userspace: " +
+         std::string(dlErrorString) );
+      this->zfs_userspace = NULL;
+   }
+
+
    this->libzfs_error_description = (char* (*)(void*))dlsym(this->dlOpenHandleLibZfs,
       "libzfs_error_description");
    if ( (dlErrorString = dlerror() ) != NULL)
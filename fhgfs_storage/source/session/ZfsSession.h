@@ -7,6 +7,8 @@
 
 
 #define ZFSSESSION_ZFS_TYPE            1 // must be same as ZFS_TYPE_FILESYSTEM from libzfs
+#define ZFSSESSION_ZFS_PROP_USERUSED   0 // must be same as ZFS_PROP_USERUSED from libzfs
+#define ZFSSESSION_ZFS_PROP_GROUPUSED  2 // must be same as ZFS_PROP_GROUPUSED from libzfs
 
 typedef std::map<uint16_t, void*> ZfsPoolHandleMap; // targetNumID => zfs_handle_t*
 typedef ZfsPoolHandleMap::iterator ZfsPoolHandleMapIter;
@@ -23,6 +25,8 @@ class ZfsSession
       void* getZfsDeviceHandle(uint16_t targetNumID, std::string path);
 
       int (*zfs_prop_get_userquota_int)(void*, const char*, uint64_t*); // fp to get quota data
+      // fp to iterate over the used quota of all IDs, NULL if not provided by the installed libzfs
+      int (*zfs_userspace)(void*, int, int (*)(void*, const char*, uid_t, uint64_t), void*);
       char* (*libzfs_error_description)(void*); // fp to get error description
       char* (*libzfs_error_action)(void*); // fp to get action during the error occurs
 
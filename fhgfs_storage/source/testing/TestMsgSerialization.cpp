@@ -2,10 +2,15 @@
 
 #include <common/net/message/nodes/HeartbeatRequestMsg.h>
 #include <common/net/message/nodes/HeartbeatMsg.h>
+#include <common/net/message/nodes/StorageBenchControlMsg.h>
+#include <common/net/message/nodes/StorageBenchControlMsgResp.h>
+#include <common/net/message/storage/mirroring/GetChunkBlockChecksumsMsg.h>
+#include <common/net/message/storage/mirroring/GetChunkBlockChecksumsRespMsg.h>
 #include <net/message/NetMessageFactory.h>
 
 TestMsgSerialization::TestMsgSerialization()
 {
+   log.setContext("TestMsgSerialization");
 }
 
 TestMsgSerialization::~TestMsgSerialization()
@@ -19,3 +24,122 @@ void TestMsgSerialization::setUp()
 void TestMsgSerialization::tearDown()
 {
 }
+
+void TestMsgSerialization::testGetChunkBlockChecksumsMsgSerialization()
+{
+   log.log(Log_DEBUG, "testGetChunkBlockChecksumsMsgSerialization started");
+
+   std::string relativePathStr = "u0/5A2B/1/7-5A2B3C4D-1/1A-5A2B3C4D-1";
+   uint16_t targetID = 11;
+   int64_t offset = 0x100000000LL; // (beyond 4GiB to check that all bits are transferred)
+
+   GetChunkBlockChecksumsMsg msg(relativePathStr, targetID, offset, RESYNCER_DELTA_BLOCK_SIZE,
+      GETCHUNKBLOCKCHECKSUMSMSG_MAX_BLOCKS);
+   GetChunkBlockChecksumsMsg msgClone;
+
+   bool testRes = this->testMsgSerialization(msg, msgClone);
+
+   if (!testRes)
+      CPPUNIT_FAIL("Failed to serialize/deserialize GetChunkBlockChecksumsMsg");
+
+   log.log(Log_DEBUG, "testGetChunkBlockChecksumsMsgSerialization finished");
+}
+
+void TestMsgSerialization::testGetChunkBlockChecksumsRespMsgSerialization()
+{
+   log.log(Log_DEBUG, "testGetChunkBlockChecksumsRespMsgSerialization started");
+
+   UIntVector weakChecksums;
+   UInt64Vector strongChecksums;
+
+   // file ends within the requested range => fewer blocks than requested
+   for (unsigned i=0; i<7; i++)
+   {
+      weakChecksums.push_back(0xF0000000 + i);
+      strongChecksums.push_back(0xF000000000000000ULL + i);
+   }
+
+   GetChunkBlockChecksumsRespMsg msg(FhgfsOpsErr_SUCCESS, 6 * RESYNCER_DELTA_BLOCK_SIZE + 123,
+      &weakChecksums, &strongChecksums);
+   GetChunkBlockChecksumsRespMsg msgClone;
+
+   bool testRes = this->testMsgSerialization(msg, msgClone);
+
+   if (!testRes)
+      CPPUNIT_FAIL("Failed to serialize/deserialize GetChunkBlockChecksumsRespMsg");
+
+   log.log(Log_DEBUG, "testGetChunkBlockChecksumsRespMsgSerialization finished");
+}
+
+void TestMsgSerialization::testStorageBenchControlMsgSerialization()
+{
+   log.log(Log_DEBUG, "testStorageBenchControlMsgSerialization started");
+
+   UInt16List targetIDs;
+   targetIDs.push_back(1);
+   targetIDs.push_back(2);
+
+   // readPercent is only transferred for the mixed benchmark
+   StorageBenchControlMsg mixedMsg(StorageBenchAction_START, StorageBenchType_RANDMIXED, 4096,
+      1024*1024*1024, 8, 70, &targetIDs);
+   StorageBenchControlMsg mixedMsgClone;
+
+   mixedMsg.addLatencyRequest();
+
+   bool testRes = this->testMsgSerialization(mixedMsg, mixedMsgClone);
+
+   if (!testRes)
+      CPPUNIT_FAIL("Failed to serialize/deserialize StorageBenchControlMsg (mixed)");
+
+   StorageBenchControlMsg writeMsg(StorageBenchAction_START, StorageBenchType_WRITE, 512*1024,
+      1024*1024*1024, 8, 70, &targetIDs);
+   StorageBenchControlMsg writeMsgClone;
+
+   testRes = this->testMsgSerialization(writeMsg, writeMsgClone);
+
+   if (!testRes)
+      CPPUNIT_FAIL("Failed to serialize/deserialize StorageBenchControlMsg (write)");
+
+   log.log(Log_DEBUG, "testStorageBenchControlMsgSerialization finished");
+}
+
+void TestMsgSerialization::testStorageBenchControlMsgRespSerialization()
+{
+   log.log(Log_DEBUG, "testStorageBenchControlMsgRespSerialization started");
+
+   StorageBenchResultsMap results;
+   StorageBenchLatencyResultsMap latencyResults;
+
+   for (uint16_t targetID=1; targetID<=3; targetID++)
+   {
+      results[targetID] = 100000 * targetID;
+
+      latencyResults[targetID].p50 = 100 * targetID;
+      latencyResults[targetID].p99 = 1000 * targetID;
+      latencyResults[targetID].p999 = 10000 * targetID;
+   }
+
+   // response for a caller that asked for latencies
+   StorageBenchControlMsgResp latencyMsg(StorageBenchStatus_FINISHED, StorageBenchAction_STATUS,
+      StorageBenchType_RANDMIXED, STORAGEBENCH_ERROR_NO_ERROR, results);
+   StorageBenchControlMsgResp latencyMsgClone;
+
+   latencyMsg.addLatencyResults(latencyResults);
+
+   bool testRes = this->testMsgSerialization(latencyMsg, latencyMsgClone);
+
+   if (!testRes)
+      CPPUNIT_FAIL("Failed to serialize/deserialize StorageBenchControlMsgResp (latencies)");
+
+   // response for an older caller
+   StorageBenchControlMsgResp plainMsg(StorageBenchStatus_FINISHED, StorageBenchAction_STATUS,
+      StorageBenchType_READ, STORAGEBENCH_ERROR_NO_ERROR, results);
+   StorageBenchControlMsgResp plainMsgClone;
+
+   testRes = this->testMsgSerialization(plainMsg, plainMsgClone);
+
+   if (!testRes)
+      CPPUNIT_FAIL("Failed to serialize/deserialize StorageBenchControlMsgResp (no latencies)");
+
+   log.log(Log_DEBUG, "testStorageBenchControlMsgRespSerialization finished");
+}
@@ -1,6 +1,7 @@
 #ifndef TESTMSGSERIALIZATION_H_
 #define TESTMSGSERIALIZATION_H_
 
+#include <common/app/log/LogContext.h>
 #include <common/net/message/NetMessage.h>
 #include <common/testing/TestMsgSerializationBase.h>
 #include <cppunit/TestFixture.h>
@@ -9,6 +10,10 @@
 class TestMsgSerialization: public TestMsgSerializationBase
 {
    CPPUNIT_TEST_SUITE( TestMsgSerialization );
+   CPPUNIT_TEST( testGetChunkBlockChecksumsMsgSerialization );
+   CPPUNIT_TEST( testGetChunkBlockChecksumsRespMsgSerialization );
+   CPPUNIT_TEST( testStorageBenchControlMsgSerialization );
+   CPPUNIT_TEST( testStorageBenchControlMsgRespSerialization );
    CPPUNIT_TEST_SUITE_END();
 
    public:
@@ -17,6 +22,14 @@ class TestMsgSerialization: public TestMsgSerializationBase
 
       void setUp();
       void tearDown();
+
+      void testGetChunkBlockChecksumsMsgSerialization();
+      void testGetChunkBlockChecksumsRespMsgSerialization();
+      void testStorageBenchControlMsgSerialization();
+      void testStorageBenchControlMsgRespSerialization();
+
+   private:
+      LogContext log;
 };
 
 #endif /* TESTMSGSERIALIZATION_H_ */
@@ -7,6 +7,7 @@
 
 #include <common/testing/TestUnitTk.h>
 #include <common/testing/TestBitStore.h>
+#include <common/testing/TestRDMASocket.h>
 #include <program/Program.h>
 
 /*
@@ -46,6 +47,7 @@ bool TestRunner::addTests()
       this->testRunner.addTest(TestUnitTk::suite());
       this->testRunner.addTest(TestUnitTk::suite());
       this->testRunner.addTest(TestBitStore::suite());
+      this->testRunner.addTest(TestRDMASocket::suite());
       return true;
    }
    else
@@ -1,6 +1,7 @@
 #include "TestSerialization.h"
 
 #include <common/storage/StorageTargetInfo.h>
+#include <common/toolkit/serialization/SerializedStr.h>
       void testStorageTargetInfoSerialization();
       void testStorageTargetInfoListSerialization();
 TestSerialization::TestSerialization()
@@ -90,3 +91,106 @@ void TestSerialization::testStorageTargetInfoListSerialization()
 
    log.log(Log_DEBUG, "testStorageTargetInfoListSerialization finished");
 }
+
+void TestSerialization::testIntContainerSerialization()
+{
+   log.log(Log_DEBUG, "testIntContainerSerialization started");
+
+   UInt16Vector vecIn;
+   Int64List listIn;
+
+   for (unsigned i = 0; i < 1000; i++)
+   {
+      vecIn.push_back(i * 65);
+      listIn.push_back( (int64_t)i * -4294967311LL);
+   }
+
+   size_t vecBufLen = Serialization::serialLenUInt16Vector(&vecIn);
+   size_t listBufLen = Serialization::serialLenInt64List(&listIn);
+   size_t bufLen = vecBufLen + listBufLen;
+   char* buf = (char*) malloc(bufLen);
+
+   CPPUNIT_ASSERT(Serialization::serializeUInt16Vector(buf, &vecIn) == vecBufLen);
+   CPPUNIT_ASSERT(Serialization::serializeInt64List(&buf[vecBufLen], &listIn) == listBufLen);
+
+   unsigned elemNum = 0;
+   const char* start = NULL;
+   unsigned len = 0;
+
+   // vector (deserialized elements are appended)
+   UInt16Vector vecOut(1, 42);
+
+   CPPUNIT_ASSERT(Serialization::deserializeUInt16VectorPreprocess(buf, bufLen, &elemNum, &start,
+      &len) );
+   CPPUNIT_ASSERT(len == vecBufLen);
+   CPPUNIT_ASSERT(Serialization::deserializeUInt16Vector(len, elemNum, start, &vecOut) );
+
+   CPPUNIT_ASSERT(vecOut.size() == vecIn.size() + 1);
+   CPPUNIT_ASSERT(vecOut[0] == 42);
+   CPPUNIT_ASSERT(std::equal(vecIn.begin(), vecIn.end(), vecOut.begin() + 1) );
+
+   // list
+   Int64List listOut;
+
+   CPPUNIT_ASSERT(Serialization::deserializeInt64ListPreprocess(&buf[vecBufLen], listBufLen,
+      &elemNum, &start, &len) );
+   CPPUNIT_ASSERT(Serialization::deserializeInt64List(len, elemNum, start, &listOut) );
+
+   CPPUNIT_ASSERT(listOut == listIn);
+
+   // truncated buffer must be rejected
+   CPPUNIT_ASSERT(!Serialization::deserializeInt64ListPreprocess(&buf[vecBufLen], listBufLen - 1,
+      &elemNum, &start, &len) );
+
+   free(buf);
+
+   log.log(Log_DEBUG, "testIntContainerSerialization finished");
+}
+
+void TestSerialization::testSerializedStrList()
+{
+   log.log(Log_DEBUG, "testSerializedStrList started");
+
+   StringList listIn;
+
+   listIn.push_back("");
+   for (unsigned i = 0; i < 100; i++)
+      listIn.push_back("entry" + StringTk::uintToStr(i) );
+
+   size_t bufLen = Serialization::serialLenStringList(&listIn);
+   char* buf = (char*) malloc(bufLen);
+
+   Serialization::serializeStringList(buf, &listIn);
+
+   unsigned elemNum = 0;
+   const char* start = NULL;
+   unsigned len = 0;
+
+   CPPUNIT_ASSERT(Serialization::deserializeStringListPreprocess(buf, bufLen, &elemNum, &start,
+      &len) );
+
+   SerializedStrList view(len, elemNum, start);
+   SerializedStrList::Iter iter = view.begin();
+   SerializedStr str;
+
+   CPPUNIT_ASSERT(view.size() == listIn.size() );
+
+   for (StringListIter iterIn = listIn.begin(); iterIn != listIn.end(); iterIn++)
+   {
+      CPPUNIT_ASSERT(iter.next(&str) );
+      CPPUNIT_ASSERT(str == *iterIn);
+      CPPUNIT_ASSERT(str.length() == iterIn->length() );
+   }
+
+   CPPUNIT_ASSERT(!iter.next(&str) );
+
+   // copying version must return the same strings
+   StringList listOut;
+
+   CPPUNIT_ASSERT(Serialization::deserializeStringList(len, elemNum, start, &listOut) );
+   CPPUNIT_ASSERT(listOut == listIn);
+
+   free(buf);
+
+   log.log(Log_DEBUG, "testSerializedStrList finished");
+}
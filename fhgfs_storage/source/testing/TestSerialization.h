@@ -17,6 +17,8 @@ class TestSerialization: public CppUnit::TestFixture
    CPPUNIT_TEST_SUITE( TestSerialization );
    CPPUNIT_TEST( testStorageTargetInfoSerialization );
    CPPUNIT_TEST( testStorageTargetInfoListSerialization );
+   CPPUNIT_TEST( testIntContainerSerialization );
+   CPPUNIT_TEST( testSerializedStrList );
    CPPUNIT_TEST_SUITE_END();
 
    public:
@@ -28,6 +30,8 @@ class TestSerialization: public CppUnit::TestFixture
 
       void testStorageTargetInfoSerialization();
       void testStorageTargetInfoListSerialization();
+      void testIntContainerSerialization();
+      void testSerializedStrList();
    private:
       LogContext log;
 };
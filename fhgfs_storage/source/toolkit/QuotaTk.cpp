@@ -13,6 +13,47 @@
 #define QUOTATK_ZFS_GROUP_QUOTA         "groupused@"
 
 
+// the quotactl commands to get the next ID with quota data (since linux 4.6), might be missing in
+// older headers
+#ifndef Q_GETNEXTQUOTA
+   #define Q_GETNEXTQUOTA               0x800009
+#endif
+
+#ifndef Q_XGETNEXTQUOTA
+   #define Q_XGETNEXTQUOTA              XQM_CMD(9)
+#endif
+
+
+/**
+ * The result of Q_GETNEXTQUOTA, must be same as struct if_nextdqblk from linux/quota.h (which
+ * can't be included together with sys/quota.h).
+ */
+struct QuotaTkNextDqblk
+{
+   uint64_t dqb_bhardlimit;
+   uint64_t dqb_bsoftlimit;
+   uint64_t dqb_curspace;
+   uint64_t dqb_ihardlimit;
+   uint64_t dqb_isoftlimit;
+   uint64_t dqb_curinodes;
+   uint64_t dqb_btime;
+   uint64_t dqb_itime;
+   uint32_t dqb_valid;
+   uint32_t dqb_id;
+};
+
+/**
+ * The context for enumerateQuotaFromZFSCallback().
+ */
+struct QuotaTkZfsEnumContext
+{
+   unsigned rangeStart;
+   unsigned rangeEnd;
+   QuotaDataType type;
+   QuotaDataMap* outQuotaDataMap;
+};
+
+
 /**
  * get quota data for a single ID
  *
@@ -55,12 +96,37 @@ bool QuotaTk::requestQuotaForRange(QuotaBlockDeviceMap* blockDevices, unsigned r
 {
    bool retVal = true;
 
+   /* ask the quota system only for the IDs which have quota data (that's one request per used ID
+      instead of one request for every ID of the range, which makes a big difference for sparse
+      ranges) */
+
+   QuotaDataMap usedQuotaDataMap;
+   bool enumSupported = true;
+
+   bool enumRes = enumerateQuotaForRange(blockDevices, rangeStart, rangeEnd, type,
+      &usedQuotaDataMap, session, &enumSupported);
+   if(enumSupported)
+   {
+      for(QuotaDataMapIter iter = usedQuotaDataMap.begin(); iter != usedQuotaDataMap.end(); iter++)
+      {
+         if(iter->second.getSize() != 0 || iter->second.getInodes() != 0)
+            outQuotaDataList->push_back(iter->second);
+      }
+
+      return enumRes;
+   }
+
+   // enumeration not supported by kernel or libzfs => check every ID of the range
+
    for(unsigned id = rangeStart; id <= rangeEnd; id++)
    {
       bool errorVal = requestQuotaForID(id, type, blockDevices, outQuotaDataList, session);
 
       if(!errorVal)
          retVal = false;
+
+      if(id == UINT_MAX)
+         break; // avoid endless loop for a range that ends with the highest possible ID
    }
 
    return retVal;
@@ -263,6 +329,260 @@ error_finish:
    return retVal;
 }
 
+/**
+ * get the used quota of all IDs of a range, which have quota data on at least one of the given
+ * block devices
+ *
+ * @param blockDevices the QuotaBlockDevices to check
+ * @param rangeStart the first ID of the ID range
+ * @param rangeEnd the last ID of the ID range
+ * @param type the quota data ID type user/group, QuotaDataType_...
+ * @param outQuotaDataMap the quota data of the found IDs, merged over all block devices
+ * @param session a session for all required lib handles if zfs is used, it can be an uninitialized
+ *        session, the initialization can be done by this function
+ * @param outIsSupported false if the enumeration is not supported for one of the block devices, in
+ *        which case the caller needs to check every single ID of the range
+ *
+ * @return false on error
+ */
+bool QuotaTk::enumerateQuotaForRange(QuotaBlockDeviceMap* blockDevices, unsigned rangeStart,
+   unsigned rangeEnd, QuotaDataType type, QuotaDataMap* outQuotaDataMap, ZfsSession* session,
+   bool* outIsSupported)
+{
+   const char* logContext = "GetQuotaInfo (enumerate quota)";
+
+   bool retVal = true;
+
+   *outIsSupported = true;
+
+   if( (type != QuotaDataType_USER) && (type != QuotaDataType_GROUP) )
+   {
+      LogContext(logContext).logErr("Error: Quota request - useless quota type. Type: " +
+         QuotaData::QuotaDataTypeToString(type) );
+
+      return false;
+   }
+
+   for(QuotaBlockDeviceMapIter iter = blockDevices->begin(); iter != blockDevices->end(); iter++)
+   {
+      bool enumRes;
+
+      if(iter->second.getFsType() == QuotaBlockDeviceFsType_ZFS)
+         enumRes = enumerateQuotaFromZFS(&iter->second, iter->first, rangeStart, rangeEnd, type,
+            outQuotaDataMap, session, outIsSupported);
+      else
+         enumRes = enumerateQuotaFromQuotactl(&iter->second, rangeStart, rangeEnd, type,
+            outQuotaDataMap, outIsSupported);
+
+      if(!*outIsSupported)
+         return false;
+
+      if(!enumRes)
+         retVal = false;
+   }
+
+   return retVal;
+}
+
+/**
+ * get the used quota of all IDs of a range from an extX or XFS block device by iterating with
+ * Q_GETNEXTQUOTA/Q_XGETNEXTQUOTA over the IDs which have quota data
+ *
+ * @param blockDevice the QuotaBlockDevice to check
+ * @param rangeStart the first ID of the ID range
+ * @param rangeEnd the last ID of the ID range
+ * @param type the quota data ID type user/group, QuotaDataType_...
+ * @param outQuotaDataMap the found quota data will be merged into this map
+ * @param outIsSupported set to false if the kernel doesn't support Q_GETNEXTQUOTA
+ *
+ * @return false on error
+ */
+bool QuotaTk::enumerateQuotaFromQuotactl(QuotaBlockDevice* blockDevice, unsigned rangeStart,
+   unsigned rangeEnd, QuotaDataType type, QuotaDataMap* outQuotaDataMap, bool* outIsSupported)
+{
+   const char* logContext = "GetQuotaInfo (enumerate quota)";
+
+   QuotaBlockDeviceFsType fstype = blockDevice->getFsType();
+   int quotaType = (type == QuotaDataType_USER) ? USRQUOTA : GRPQUOTA;
+
+   unsigned nextID = rangeStart;
+
+   for( ; ; )
+   {
+      int errorCode;
+      unsigned foundID;
+      uint64_t usedBlocks;
+      uint64_t usedInodes;
+
+      if(fstype == QuotaBlockDeviceFsType_XFS)
+      {
+         fs_disk_quota xfsQuotaData;
+
+         errorCode = quotactl(QCMD(Q_XGETNEXTQUOTA, quotaType),
+            blockDevice->getBlockDevicePath().c_str(), nextID, (caddr_t)&xfsQuotaData);
+
+         foundID = xfsQuotaData.d_id;
+         usedBlocks = xfsQuotaData.d_bcount;
+         usedInodes = xfsQuotaData.d_icount;
+      }
+      else
+      {
+         QuotaTkNextDqblk quotaData;
+
+         errorCode = quotactl(QCMD(Q_GETNEXTQUOTA, quotaType),
+            blockDevice->getBlockDevicePath().c_str(), nextID, (caddr_t)&quotaData);
+
+         if( (errorCode == 0) && !(quotaData.dqb_valid & QIF_USAGE) )
+         {
+            LogContext(logContext).logErr("Error: Quota request - values not valid. Type: " +
+               QuotaData::QuotaDataTypeToString(type) + "; ID: " +
+               StringTk::uintToStr(quotaData.dqb_id) );
+
+            return false;
+         }
+
+         foundID = quotaData.dqb_id;
+         usedBlocks = quotaData.dqb_curspace;
+         usedInodes = quotaData.dqb_curinodes;
+      }
+
+      if(errorCode != 0)
+      {
+         errorCode = errno;
+
+         // no more IDs with quota data (ESRCH), especially for XFS (ENOENT)
+         if( (errorCode == ESRCH) ||
+            ( (fstype == QuotaBlockDeviceFsType_XFS) && (errorCode == ENOENT) ) )
+            return true;
+
+         // kernel doesn't know the command (older than 4.6)
+         if( (errorCode == EINVAL) || (errorCode == ENOSYS) )
+         {
+            *outIsSupported = false;
+            return false;
+         }
+
+         LogContext(logContext).logErr("Error: Quota request - quotactl failed. Type: " +
+            QuotaData::QuotaDataTypeToString(type) + "; ID: " + StringTk::uintToStr(nextID) +
+            "; SysErr: " + System::getErrString(errorCode) );
+
+         return false;
+      }
+
+      if( (foundID > rangeEnd) || (foundID < nextID) )
+         return true; // end of range
+
+      addUsedQuotaToMap(outQuotaDataMap, foundID, type,
+         UnitTk::quotaBlockCountToByte(usedBlocks, fstype), usedInodes);
+
+      if(foundID == rangeEnd)
+         return true; // (also avoids an overflow of nextID)
+
+      nextID = foundID + 1;
+   }
+}
+
+/**
+ * get the used quota of all IDs of a range from a ZFS block device by iterating with
+ * zfs_userspace over the IDs which have quota data
+ *
+ * @param blockDevice the QuotaBlockDevice to check
+ * @param targetNumID the targetNumID of the storage target
+ * @param rangeStart the first ID of the ID range
+ * @param rangeEnd the last ID of the ID range
+ * @param type the quota data ID type user/group, QuotaDataType_...
+ * @param outQuotaDataMap the found quota data will be merged into this map
+ * @param session a session for all required lib handles, it can be an uninitialized session, the
+ *        initialization can be done by this function
+ * @param outIsSupported set to false if the installed libzfs doesn't provide zfs_userspace
+ *
+ * @return false on error
+ */
+bool QuotaTk::enumerateQuotaFromZFS(QuotaBlockDevice* blockDevice, uint16_t targetNumID,
+   unsigned rangeStart, unsigned rangeEnd, QuotaDataType type, QuotaDataMap* outQuotaDataMap,
+   ZfsSession* session, bool* outIsSupported)
+{
+   const char* logContext = "GetQuotaInfo (enumerate quota)";
+
+   if(!session->isSessionValid() )
+   {
+      if(!session->initZfsSession(Program::getApp()->getDlOpenHandleLibZfs() ) )
+         return false;
+   }
+
+   if(!session->zfs_userspace)
+   {
+      *outIsSupported = false;
+      return false;
+   }
+
+   void* zfsHandle = session->getZfsDeviceHandle(targetNumID, blockDevice->getBlockDevicePath() );
+   if(!zfsHandle)
+      return false;
+
+   QuotaTkZfsEnumContext context;
+   context.rangeStart = rangeStart;
+   context.rangeEnd = rangeEnd;
+   context.type = type;
+   context.outQuotaDataMap = outQuotaDataMap;
+
+   int property = (type == QuotaDataType_USER) ?
+      ZFSSESSION_ZFS_PROP_USERUSED : ZFSSESSION_ZFS_PROP_GROUPUSED;
+
+   int error = (*session->zfs_userspace)(zfsHandle, property,
+      QuotaTk::enumerateQuotaFromZFSCallback, &context);
+
+   if(error)
+   {
+      std::string errorDec( (*session->libzfs_error_description)(session->getlibZfsHandle() ) );
+      std::string errorAct( (*session->libzfs_error_action)(session->getlibZfsHandle() ) );
+      LogContext(logContext).logErr("error during request quota data. " + errorAct + "; " +
+         errorDec);
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * callback for zfs_userspace, called for every ID with quota data
+ *
+ * @param context a QuotaTkZfsEnumContext
+ * @param domain empty for POSIX IDs, the SMB domain otherwise
+ * @return 0 to continue the iteration
+ */
+int QuotaTk::enumerateQuotaFromZFSCallback(void* context, const char* domain, uid_t id,
+   uint64_t usedSize)
+{
+   QuotaTkZfsEnumContext* enumContext = (QuotaTkZfsEnumContext*)context;
+
+   if(domain && domain[0])
+      return 0; // not a POSIX ID
+
+   if( (id < enumContext->rangeStart) || (id > enumContext->rangeEnd) )
+      return 0;
+
+   // inode value is every time 0, because zfs doesn't support inode quota
+   addUsedQuotaToMap(enumContext->outQuotaDataMap, id, enumContext->type,
+      UnitTk::quotaBlockCountToByte(usedSize, QuotaBlockDeviceFsType_ZFS), 0);
+
+   return 0;
+}
+
+/**
+ * add the used quota of an ID to the quota data of that ID in the given map (or insert new quota
+ * data for that ID)
+ */
+void QuotaTk::addUsedQuotaToMap(QuotaDataMap* outQuotaDataMap, unsigned id, QuotaDataType type,
+   uint64_t usedSize, uint64_t usedInodes)
+{
+   QuotaDataMapIter iter = outQuotaDataMap->find(id);
+   if(iter == outQuotaDataMap->end() )
+      iter = outQuotaDataMap->insert(QuotaDataMapVal(id, QuotaData(id, type) ) ).first;
+
+   iter->second.forceMergeQuotaDataCounter(usedSize, usedInodes);
+}
+
 /**
  * initialize the lib zfs
  *
@@ -40,6 +40,21 @@ class QuotaTk
    private:
       QuotaTk() {};
 
+      static bool enumerateQuotaForRange(QuotaBlockDeviceMap* blockDevices, unsigned rangeStart,
+         unsigned rangeEnd, QuotaDataType type, QuotaDataMap* outQuotaDataMap,
+         ZfsSession* session, bool* outIsSupported);
+      static bool enumerateQuotaFromQuotactl(QuotaBlockDevice* blockDevice, unsigned rangeStart,
+         unsigned rangeEnd, QuotaDataType type, QuotaDataMap* outQuotaDataMap,
+         bool* outIsSupported);
+      static bool enumerateQuotaFromZFS(QuotaBlockDevice* blockDevice, uint16_t targetNumID,
+         unsigned rangeStart, unsigned rangeEnd, QuotaDataType type, QuotaDataMap* outQuotaDataMap,
+         ZfsSession* session, bool* outIsSupported);
+      static int enumerateQuotaFromZFSCallback(void* context, const char* domain, uid_t id,
+         uint64_t usedSize);
+
+      static void addUsedQuotaToMap(QuotaDataMap* outQuotaDataMap, unsigned id,
+         QuotaDataType type, uint64_t usedSize, uint64_t usedInodes);
+
 };
 
 #endif /* TOOLKIT_QUOTATK_H_ */
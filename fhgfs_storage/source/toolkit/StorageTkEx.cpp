@@ -1,4 +1,5 @@
 #include <common/fsck/FsckChunk.h>
+#include <common/toolkit/BufferTk.h>
 #include <common/toolkit/Time.h>
 #include <net/msghelpers/MsgHelperIO.h>
 #include <program/Program.h>
@@ -115,3 +116,116 @@ bool StorageTkEx::readEntryInfoFromChunk(uint16_t targetID, PathInfo* pathInfo,
    }
 }
 
+
+/**
+ * Check via SEEK_DATA whether a file range contains only holes, so that it doesn't need to be
+ * read.
+ *
+ * Note: This is only a hint. A range might contain only zeros without being a hole and file
+ * systems without SEEK_DATA support (or preallocated extents) will always report data.
+ *
+ * @return true if the range [offset, offset+len) contains no data.
+ */
+bool StorageTkEx::isHoleRange(int fd, int64_t offset, int64_t len)
+{
+   off_t dataOffset = lseek(fd, offset, SEEK_DATA);
+
+   if(dataOffset == -1)
+      return (errno == ENXIO); // ENXIO: no more data after offset
+
+   return (dataOffset >= (offset + len) );
+}
+
+/**
+ * Read consecutive blocks of a file and calculate a weak (BufferTk::hash32) and a strong
+ * (BufferTk::hash64) checksum per block, as needed for a delta resync.
+ *
+ * Blocks that are holes in the file are not read and zero blocks reuse the checksums of the first
+ * zero block. Reading stops at the end of the file; the last block might be shorter than
+ * blockSize, in which case its checksums are calculated over the existing bytes only.
+ *
+ * @param buf the read buffer; must be numBlocks*blockSize large if keepData is true, blockSize
+ *    large otherwise.
+ * @param keepData true to keep the data of all blocks in buf (block i at buf+i*blockSize), e.g.
+ *    to send differing blocks afterwards without reading them again.
+ * @param outWeakChecksums one element per existing block will be appended.
+ * @param outStrongChecksums one element per existing block will be appended.
+ * @param outFileSize current size of the file.
+ * @return false on error (errno will be set).
+ */
+bool StorageTkEx::getBlockChecksums(int fd, int64_t offset, unsigned blockSize,
+   unsigned numBlocks, char* buf, bool keepData, UIntVector* outWeakChecksums,
+   UInt64Vector* outStrongChecksums, int64_t* outFileSize)
+{
+   struct stat statBuf;
+
+   bool haveZeroChecksums = false;
+   uint32_t zeroWeakChecksum = 0;
+   uint64_t zeroStrongChecksum = 0;
+
+   int statRes = fstat(fd, &statBuf);
+   if(statRes == -1)
+      return false;
+
+   *outFileSize = statBuf.st_size;
+
+   for(unsigned i = 0; i < numBlocks; i++)
+   {
+      int64_t blockOffset = offset + (int64_t)i * blockSize;
+      char* blockBuf = keepData ? (buf + (size_t)i * blockSize) : buf;
+
+      if(blockOffset >= statBuf.st_size)
+         break; // end of file
+
+      size_t blockLen = BEEGFS_MIN(statBuf.st_size - blockOffset, (int64_t)blockSize);
+      bool isZeroBlock;
+
+      if(isHoleRange(fd, blockOffset, blockLen) )
+      { // nothing to read
+         memset(blockBuf, 0, blockLen);
+         isZeroBlock = true;
+      }
+      else
+      {
+         size_t readLen = 0;
+
+         while(readLen < blockLen)
+         {
+            ssize_t readRes = MsgHelperIO::pread(fd, blockBuf + readLen, blockLen - readLen,
+               blockOffset + readLen);
+
+            if(readRes == -1)
+               return false;
+
+            if(!readRes)
+            { // file was truncated concurrently => treat the rest as zeros
+               memset(blockBuf + readLen, 0, blockLen - readLen);
+               break;
+            }
+
+            readLen += readRes;
+         }
+
+         isZeroBlock = BufferTk::isZero(blockBuf, blockLen);
+      }
+
+      if(isZeroBlock && (blockLen == blockSize) )
+      { // full zero block => calculate checksums only once
+         if(!haveZeroChecksums)
+         {
+            zeroWeakChecksum = BufferTk::hash32(blockBuf, blockLen);
+            zeroStrongChecksum = BufferTk::hash64(blockBuf, blockLen);
+            haveZeroChecksums = true;
+         }
+
+         outWeakChecksums->push_back(zeroWeakChecksum);
+         outStrongChecksums->push_back(zeroStrongChecksum);
+         continue;
+      }
+
+      outWeakChecksums->push_back(BufferTk::hash32(blockBuf, blockLen) );
+      outStrongChecksums->push_back(BufferTk::hash64(blockBuf, blockLen) );
+   }
+
+   return true;
+}
@@ -33,6 +33,10 @@ class StorageTkEx
          bool overwriteExisting = false);
       static bool readEntryInfoFromChunk(uint16_t targetID, PathInfo* pathInfo, std::string chunkID,
          EntryInfo* outEntryInfo);
+      static bool isHoleRange(int fd, int64_t offset, int64_t len);
+      static bool getBlockChecksums(int fd, int64_t offset, unsigned blockSize,
+         unsigned numBlocks, char* buf, bool keepData, UIntVector* outWeakChecksums,
+         UInt64Vector* outStrongChecksums, int64_t* outFileSize);
    private:
       StorageTkEx() {}
 